@@ -59,25 +59,27 @@ Constellation::Config BuildConstellationConfig(Settings const &settings)
   Constellation::Config cfg;
 
   BuildManifest(settings, cfg.manifest);
-  cfg.log2_num_lanes        = platform::ToLog2(settings.num_lanes.value());
-  cfg.num_slices            = settings.num_slices.value();
-  cfg.num_executors         = settings.num_executors.value();
-  cfg.db_prefix             = settings.db_prefix.value();
-  cfg.processor_threads     = settings.num_processor_threads.value();
-  cfg.verification_threads  = settings.num_verifier_threads.value();
-  cfg.max_peers             = settings.max_peers.value();
-  cfg.transient_peers       = settings.transient_peers.value();
-  cfg.block_interval_ms     = settings.block_interval.value();
-  cfg.peers_update_cycle_ms = settings.peer_update_interval.value();
-  cfg.disable_signing       = settings.disable_signing.value();
-  cfg.sign_broadcasts       = false;
-  cfg.dump_state_file       = settings.dump_state.value();
-  cfg.load_state_file       = settings.load_state.value();
-  cfg.stakefile_location    = settings.stakefile_location.value();
-  cfg.proof_of_stake        = settings.proof_of_stake.value();
-  cfg.network_mode          = GetNetworkMode(settings);
-  cfg.beacon_address        = settings.beacon_address.value();
-  cfg.features              = settings.experimental_features.value();
+  cfg.log2_num_lanes            = platform::ToLog2(settings.num_lanes.value());
+  cfg.num_slices                = settings.num_slices.value();
+  cfg.num_executors             = settings.num_executors.value();
+  cfg.db_prefix                 = settings.db_prefix.value();
+  cfg.processor_threads         = settings.num_processor_threads.value();
+  cfg.verification_threads      = settings.num_verifier_threads.value();
+  cfg.http_threads              = settings.num_http_threads.value();
+  cfg.state_checkpoint_interval = settings.state_checkpoints.value();
+  cfg.max_peers                 = settings.max_peers.value();
+  cfg.transient_peers           = settings.transient_peers.value();
+  cfg.block_interval_ms         = settings.block_interval.value();
+  cfg.peers_update_cycle_ms     = settings.peer_update_interval.value();
+  cfg.disable_signing           = settings.disable_signing.value();
+  cfg.sign_broadcasts           = false;
+  cfg.dump_state_file           = settings.dump_state.value();
+  cfg.load_state_file           = settings.load_state.value();
+  cfg.stakefile_location        = settings.stakefile_location.value();
+  cfg.proof_of_stake            = settings.proof_of_stake.value();
+  cfg.network_mode              = GetNetworkMode(settings);
+  cfg.beacon_address            = settings.beacon_address.value();
+  cfg.features                  = settings.experimental_features.value();
 
   return cfg;
 }
@@ -25,6 +25,7 @@
 #include "ledger/chain/consensus/bad_miner.hpp"
 #include "ledger/chain/consensus/dummy_miner.hpp"
 #include "ledger/chaincode/contract_http_interface.hpp"
+#include "ledger/chaincode/executable_cache.hpp"
 #include "ledger/consensus/naive_entropy_generator.hpp"
 #include "ledger/consensus/stake_snapshot.hpp"
 #include "ledger/dag/dag_interface.hpp"
@@ -136,10 +137,11 @@ ledger::ShardConfigs GenerateShardsConfig(Config const &cfg, uint16_t start_port
     shard.external_port     = start_port++;
     shard.external_network_id =
         muddle::NetworkId{(static_cast<uint32_t>(i) & 0xFFFFFFu) | (uint32_t{'L'} << 24u)};
-    shard.internal_identity    = std::make_shared<crypto::ECDSASigner>();
-    shard.internal_port        = start_port++;
-    shard.internal_network_id  = muddle::NetworkId{"ISRD"};
-    shard.verification_threads = cfg.verification_threads;
+    shard.internal_identity         = std::make_shared<crypto::ECDSASigner>();
+    shard.internal_port             = start_port++;
+    shard.internal_network_id       = muddle::NetworkId{"ISRD"};
+    shard.verification_threads      = cfg.verification_threads;
+    shard.state_checkpoint_interval = cfg.state_checkpoint_interval;
 
     auto const ext_identity = shard.external_identity->identity().identifier();
     auto const int_identity = shard.internal_identity->identity().identifier();
@@ -239,11 +241,17 @@ Constellation::Constellation(CertificatePtr certificate, Config config)
                        *this,           cfg_.features,
                        certificate,     cfg_.num_lanes(),
                        cfg_.num_slices, cfg_.block_difficulty}
-  , main_chain_service_{std::make_shared<MainChainRpcService>(p2p_.AsEndpoint(), chain_, trust_,
-                                                              cfg_.network_mode)}
-  , tx_processor_{dag_, *storage_, block_packer_, tx_status_cache_, cfg_.processor_threads}
+  , recent_txs_{cfg_.features.IsEnabled(FeatureFlags::COMPACT_BLOCK_RELAY)
+                    ? std::make_shared<ledger::RecentTransactionIndex>(cfg_.log2_num_lanes)
+                    : nullptr}
+  , main_chain_service_{std::make_shared<MainChainRpcService>(
+        p2p_.AsEndpoint(), chain_, trust_, cfg_.network_mode, recent_txs_,
+        cfg_.features.IsEnabled(FeatureFlags::COMPACT_BLOCK_BROADCAST))}
+  , tx_processor_{dag_, *storage_, block_packer_, tx_status_cache_, cfg_.processor_threads,
+                  recent_txs_}
+  , tx_stream_service_{muddle_.AsEndpoint(), tx_processor_}
   , http_open_api_module_{std::make_shared<OpenAPIHttpModule>()}
-  , http_{http_network_manager_}
+  , http_{http_network_manager_, cfg_.http_threads}
   , http_modules_{http_open_api_module_,
                   std::make_shared<p2p::P2PHttpInterface>(
                       cfg_.log2_num_lanes, chain_, muddle_, p2p_, trust_, block_packer_,
@@ -269,6 +277,9 @@ Constellation::Constellation(CertificatePtr certificate, Config config)
   FETCH_LOG_INFO(LOGGING_NAME, "              :: ", ToBase64(p2p_.identity().identifier()));
   FETCH_LOG_INFO(LOGGING_NAME, "");
 
+  // persist compiled contracts so that they do not need to be recompiled after a restart
+  ledger::ExecutableCache::Instance().Load(cfg_.db_prefix + "_executables");
+
   // Enable experimental features
   if (cfg_.features.IsEnabled("synergetic"))
   {
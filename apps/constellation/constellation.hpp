@@ -32,6 +32,7 @@
 #include "ledger/genesis_loading/genesis_file_creator.hpp"
 #include "ledger/protocols/dag_service.hpp"
 #include "ledger/protocols/main_chain_rpc_service.hpp"
+#include "ledger/protocols/transaction_stream_service.hpp"
 #include "ledger/storage_unit/lane_remote_control.hpp"
 #include "ledger/storage_unit/storage_unit_bundled_service.hpp"
 #include "ledger/storage_unit/storage_unit_client.hpp"
@@ -83,6 +84,8 @@ public:
     std::string    db_prefix{};
     uint32_t       processor_threads{0};
     uint32_t       verification_threads{0};
+    uint32_t       http_threads{0};
+    uint32_t       state_checkpoint_interval{0};
     uint32_t       max_peers{0};
     uint32_t       transient_peers{0};
     uint32_t       block_interval_ms{0};
@@ -143,6 +146,8 @@ private:
   using HttpModulePtr          = std::shared_ptr<HttpModule>;
   using HttpModules            = std::vector<HttpModulePtr>;
   using TransactionProcessor   = ledger::TransactionProcessor;
+  using TxStreamService        = ledger::TransactionStreamService;
+  using RecentTxIndexPtr       = ledger::RecentTransactionIndexPtr;
   using TrustSystem            = p2p::P2PTrustBayRank<Muddle::Address>;
   using DAGPtr                 = std::shared_ptr<ledger::DAGInterface>;
   using DAGServicePtr          = std::shared_ptr<ledger::DAGService>;
@@ -207,12 +212,14 @@ private:
   MainChain             chain_;              ///< The main block chain component
   BlockPackingAlgorithm block_packer_;       ///< The block packing / mining algorithm
   BlockCoordinator      block_coordinator_;  ///< The block execution coordinator
+  RecentTxIndexPtr      recent_txs_;         ///< Recent transactions for compact block relay
   /// @}
 
   /// @name Top Level Services
   /// @{
   MainChainRpcServicePtr main_chain_service_;  ///< Service for block transmission over the network
   TransactionProcessor   tx_processor_;        ///< The transaction entrypoint
+  TxStreamService        tx_stream_service_;   ///< Binary transaction streams from the network
   /// @}
 
   /// @name HTTP Server
@@ -210,6 +210,11 @@ int main(int argc, char **argv)
     {
       FETCH_LOG_INFO(LOGGING_NAME, "Input Configuration:\n", settings);
 
+      if (settings.async_logging.value())
+      {
+        fetch::EnableAsyncLogging(settings.log_buffer_size.value());
+      }
+
       // create and load the main certificate for the bootstrapper
       auto p2p_key = fetch::GenerateP2PKey();
 
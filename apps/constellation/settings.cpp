@@ -37,6 +37,8 @@ static const uint16_t DEFAULT_PORT            = 8000;
 static const uint32_t DEFAULT_BLOCK_INTERVAL  = 0;  // milliseconds - zero means no mining
 static const uint32_t DEFAULT_MAX_PEERS       = 3;
 static const uint32_t DEFAULT_TRANSIENT_PEERS = 1;
+static const uint32_t DEFAULT_HTTP_THREADS    = 4;
+static const uint32_t DEFAULT_LOG_BUFFER_SIZE = 8192;
 static const uint32_t NUM_SYSTEM_THREADS =
     static_cast<uint32_t>(std::thread::hardware_concurrency());
 
@@ -69,12 +71,16 @@ Settings::Settings()
   , num_processor_threads {*this, "processor-threads",       NUM_SYSTEM_THREADS,       "The number of processor threads"}
   , num_verifier_threads  {*this, "verifier-threads",        NUM_SYSTEM_THREADS,       "The number of verifier threads"}
   , num_executors         {*this, "executors",               DEFAULT_NUM_EXECUTORS,    "The number of transaction executors"}
+  , num_http_threads      {*this, "http-threads",            DEFAULT_HTTP_THREADS,     "The number of threads evaluating HTTP requests"}
   , dump_state            {*this, "dump-state",              false,                    "Trigger the state file dump on shutdown"}
   , load_state            {*this, "load-state",              false,                    "Trigger the state file to be loaded on startup"}
   , stakefile_location    {*this, "stakefile-location",      "",                       "Path to the stakefile (usually snapshot.json)"}
+  , state_checkpoints     {*this, "state-checkpoints",       0,                        "The number of blocks between full copies of the state database, which speed up long reverts (0 disables)"}
   , experimental_features {*this, "experimental",            {},                       "The comma separated set of experimental features to enable"}
   , proof_of_stake        {*this, "pos",                     false,                    "Enable Proof of Stake consensus"}
   , beacon_address        {*this, "beacon",                  "",                       "The address of the dealer node"}
+  , async_logging         {*this, "async-logging",           false,                    "Write log messages from a background thread"}
+  , log_buffer_size       {*this, "log-buffer-size",         DEFAULT_LOG_BUFFER_SIZE,  "The number of pending log messages buffered per thread"}
 {}
 // clang-format on
 
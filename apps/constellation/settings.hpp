@@ -88,6 +88,7 @@ public:
   settings::Setting<uint32_t> num_processor_threads;
   settings::Setting<uint32_t> num_verifier_threads;
   settings::Setting<uint32_t> num_executors;
+  settings::Setting<uint32_t> num_http_threads;
   /// @}
 
   /// @name State File
@@ -95,6 +96,7 @@ public:
   settings::Setting<bool>        dump_state;
   settings::Setting<bool>        load_state;
   settings::Setting<std::string> stakefile_location;
+  settings::Setting<uint32_t>    state_checkpoints;
   /// @}
 
   /// @name Experimental
@@ -108,6 +110,12 @@ public:
   settings::Setting<std::string> beacon_address;
   /// @}
 
+  /// @name Logging
+  /// @{
+  settings::Setting<bool>     async_logging;
+  settings::Setting<uint32_t> log_buffer_size;
+  /// @}
+
   // Operators
   Settings &operator=(Settings const &) = delete;
   Settings &operator=(Settings &&) = delete;
@@ -0,0 +1,79 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/logging.hpp"
+
+#include "benchmark/benchmark.h"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace {
+
+using fetch::LogOverflowPolicy;
+
+constexpr char const *LOGGING_NAME = "LoggingBench";
+constexpr std::size_t BUFFER_SIZE  = 1u << 16u;
+
+void Logging_Disabled(benchmark::State &state)
+{
+  std::size_t value{0};
+  for (auto _ : state)
+  {
+    FETCH_LOG_DEBUG(LOGGING_NAME, "Disabled message: ", value++, " of ", state.iterations());
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+
+void Logging_Enabled(benchmark::State &state, bool async)
+{
+  if (state.thread_index == 0 && async)
+  {
+    fetch::EnableAsyncLogging(BUFFER_SIZE, LogOverflowPolicy::BLOCK);
+  }
+
+  std::size_t value{0};
+  for (auto _ : state)
+  {
+    FETCH_LOG_WARN(LOGGING_NAME, "Enabled message: ", value++, " of ", state.iterations());
+  }
+
+  if (state.thread_index == 0 && async)
+  {
+    fetch::DisableAsyncLogging();
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+
+void Logging_Sync(benchmark::State &state)
+{
+  Logging_Enabled(state, false);
+}
+
+void Logging_Async(benchmark::State &state)
+{
+  Logging_Enabled(state, true);
+}
+
+}  // namespace
+
+BENCHMARK(Logging_Disabled)->ThreadRange(1, 8)->UseRealTime();
+BENCHMARK(Logging_Sync)->ThreadRange(1, 8)->UseRealTime();
+BENCHMARK(Logging_Async)->ThreadRange(1, 8)->UseRealTime();
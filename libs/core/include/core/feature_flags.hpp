@@ -32,6 +32,10 @@ class FeatureFlags
 {
 public:
   constexpr static char const *MAIN_CHAIN_BLOOM_FILTER = "main_chain_bloom_filter";
+  /// Accept new blocks in compact form
+  constexpr static char const *COMPACT_BLOCK_RELAY     = "compact_block_relay";
+  /// Broadcast new blocks in compact form only. Requires compact_block_relay on every node.
+  constexpr static char const *COMPACT_BLOCK_BROADCAST = "compact_block_broadcast";
 
   using ConstByteArray = byte_array::ConstByteArray;
   using FlagSet        = std::unordered_set<ConstByteArray>;
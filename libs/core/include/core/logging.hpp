@@ -17,6 +17,9 @@
 //
 //------------------------------------------------------------------------------
 
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
 #include <ostream>
 #include <sstream>
 #include <string>
@@ -74,6 +77,23 @@ enum class LogLevel
 
 using LogLevelMap = std::unordered_map<std::string, LogLevel>;
 
+enum class LogOverflowPolicy
+{
+  DROP,  ///< Discard the message if the thread's buffer is full
+  BLOCK  ///< Wait for the sink thread to make space in the thread's buffer
+};
+
+namespace detail {
+
+// The range of levels configured across all of the loggers. Messages below the floor are not
+// enabled for any logger, messages at or above the ceiling are enabled for every logger
+extern std::atomic<LogLevel> log_level_floor;
+extern std::atomic<LogLevel> log_level_ceiling;
+
+bool IsLogLevelEnabledForName(LogLevel level, char const *name);
+
+}  // namespace detail
+
 /// @name Log Library Functions
 /// @{
 
@@ -101,6 +121,59 @@ void Log(LogLevel level, char const *name, std::string &&message);
  */
 LogLevelMap GetLogLevelMap();
 
+/**
+ * Determine if a message of the specified level would be output by the named logger. This is
+ * checked before a message is formatted, so it is kept cheap for the common cases where the level
+ * is enabled or disabled for every logger.
+ *
+ * @param level The level of log message
+ * @param name The name of the origin
+ * @return true if the message should be formatted and logged, otherwise false
+ */
+inline bool IsLogLevelEnabled(LogLevel level, char const *name)
+{
+  if (level < detail::log_level_floor.load(std::memory_order_relaxed))
+  {
+    return false;
+  }
+
+  if (level >= detail::log_level_ceiling.load(std::memory_order_relaxed))
+  {
+    return true;
+  }
+
+  return detail::IsLogLevelEnabledForName(level, name);
+}
+
+/**
+ * Switch to asynchronous logging. Messages are still formatted on the calling thread, but are then
+ * queued on a lock free, per thread ring buffer which is drained by a background sink thread.
+ *
+ * @param buffer_size The number of messages each thread can have pending
+ * @param policy The action taken when a thread's buffer is full
+ */
+void EnableAsyncLogging(std::size_t       buffer_size = 8192,
+                        LogOverflowPolicy policy      = LogOverflowPolicy::DROP);
+
+/**
+ * Switch back to synchronous logging, once all of the pending messages have been output
+ */
+void DisableAsyncLogging();
+
+/**
+ * Determine if asynchronous logging is enabled
+ *
+ * @return true if enabled, otherwise false
+ */
+bool IsAsyncLoggingEnabled();
+
+/**
+ * Retrieve the total number of messages dropped because a thread's buffer was full
+ *
+ * @return The number of dropped messages
+ */
+uint64_t GetDroppedLogMessageCount();
+
 /// @}
 
 /// @name Helper Wrappers
@@ -147,10 +220,16 @@ void LogCriticalV2(char const *name, Args &&... args)
 /// @name Logging Macros
 /// @{
 
+// The level is checked before the arguments are evaluated, so disabled messages are never
+// formatted
+
 // Trace
 #if FETCH_COMPILE_LOGGING_LEVEL >= 6
 #define FETCH_LOG_TRACE_ENABLED
-#define FETCH_LOG_TRACE(name, ...) fetch::LogTraceV2(name, __VA_ARGS__)
+#define FETCH_LOG_TRACE(name, ...)                                                                 \
+  (fetch::IsLogLevelEnabled(fetch::LogLevel::TRACE, name)                                          \
+       ? fetch::LogTraceV2(name, __VA_ARGS__)                                                      \
+       : (void)0)
 #else
 #define FETCH_LOG_TRACE(name, ...) (void)name
 #endif
@@ -158,7 +237,10 @@ void LogCriticalV2(char const *name, Args &&... args)
 // Debug
 #if FETCH_COMPILE_LOGGING_LEVEL >= 5
 #define FETCH_LOG_DEBUG_ENABLED
-#define FETCH_LOG_DEBUG(name, ...) fetch::LogDebugV2(name, __VA_ARGS__)
+#define FETCH_LOG_DEBUG(name, ...)                                                                 \
+  (fetch::IsLogLevelEnabled(fetch::LogLevel::DEBUG, name)                                          \
+       ? fetch::LogDebugV2(name, __VA_ARGS__)                                                      \
+       : (void)0)
 #else
 #define FETCH_LOG_DEBUG(name, ...) (void)name
 #endif
@@ -166,7 +248,10 @@ void LogCriticalV2(char const *name, Args &&... args)
 // Info
 #if FETCH_COMPILE_LOGGING_LEVEL >= 4
 #define FETCH_LOG_INFO_ENABLED
-#define FETCH_LOG_INFO(name, ...) fetch::LogInfoV2(name, __VA_ARGS__)
+#define FETCH_LOG_INFO(name, ...)                                                                  \
+  (fetch::IsLogLevelEnabled(fetch::LogLevel::INFO, name)                                           \
+       ? fetch::LogInfoV2(name, __VA_ARGS__)                                                       \
+       : (void)0)
 #else
 #define FETCH_LOG_INFO(name, ...) (void)name
 #endif
@@ -174,7 +259,10 @@ void LogCriticalV2(char const *name, Args &&... args)
 // Warn
 #if FETCH_COMPILE_LOGGING_LEVEL >= 3
 #define FETCH_LOG_WARN_ENABLED
-#define FETCH_LOG_WARN(name, ...) fetch::LogWarningV2(name, __VA_ARGS__)
+#define FETCH_LOG_WARN(name, ...)                                                                  \
+  (fetch::IsLogLevelEnabled(fetch::LogLevel::WARNING, name)                                        \
+       ? fetch::LogWarningV2(name, __VA_ARGS__)                                                    \
+       : (void)0)
 #else
 #define FETCH_LOG_WARN(name, ...) (void)name
 #endif
@@ -182,7 +270,10 @@ void LogCriticalV2(char const *name, Args &&... args)
 // Error
 #if FETCH_COMPILE_LOGGING_LEVEL >= 2
 #define FETCH_LOG_ERROR_ENABLED
-#define FETCH_LOG_ERROR(name, ...) fetch::LogErrorV2(name, __VA_ARGS__)
+#define FETCH_LOG_ERROR(name, ...)                                                                 \
+  (fetch::IsLogLevelEnabled(fetch::LogLevel::ERROR, name)                                          \
+       ? fetch::LogErrorV2(name, __VA_ARGS__)                                                      \
+       : (void)0)
 #else
 #define FETCH_LOG_ERROR(name, ...) (void)name
 #endif
@@ -190,7 +281,10 @@ void LogCriticalV2(char const *name, Args &&... args)
 // Critical
 #if FETCH_COMPILE_LOGGING_LEVEL >= 1
 #define FETCH_LOG_CRITICAL_ENABLED
-#define FETCH_LOG_CRITICAL(name, ...) fetch::LogCriticalV2(name, __VA_ARGS__)
+#define FETCH_LOG_CRITICAL(name, ...)                                                              \
+  (fetch::IsLogLevelEnabled(fetch::LogLevel::CRITICAL, name)                                       \
+       ? fetch::LogCriticalV2(name, __VA_ARGS__)                                                   \
+       : (void)0)
 #else
 #define FETCH_LOG_CRITICAL(name, ...) (void)name
 #endif
@@ -28,6 +28,7 @@ static constexpr uint16_t SERVICE_LANE       = 3003;
 static constexpr uint16_t SERVICE_LANE_CTRL  = 3004;
 static constexpr uint16_t SERVICE_EXECUTOR   = 4004;
 static constexpr uint16_t SERVICE_DAG        = 4005;
+static constexpr uint16_t SERVICE_TX_STREAM  = 4006;
 static constexpr uint16_t SERVICE_DKG        = 5001;
 
 // Common Service Channels
@@ -42,12 +43,16 @@ static constexpr uint16_t CHANNEL_ROUTING = 1;
 // P2P Service Channels
 
 // Main Chain Service Channels
-static constexpr uint16_t CHANNEL_BLOCKS = 2;
+static constexpr uint16_t CHANNEL_BLOCKS         = 2;
+static constexpr uint16_t CHANNEL_COMPACT_BLOCKS = 3;
 
 // DAG Service Channels
 static constexpr uint16_t CHANNEL_NODES         = 300;
 static constexpr uint64_t CHANNEL_RPC_BROADCAST = 301;
 
+// Transaction Stream Service Channels
+static constexpr uint16_t CHANNEL_TX_FRAMES = 500;
+
 // DKG Service Channels
 static constexpr uint16_t CHANNEL_SECRET_KEY    = 400;
 static constexpr uint16_t CHANNEL_CONTRIBUTIONS = 401;
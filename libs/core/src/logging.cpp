@@ -18,17 +18,211 @@
 
 #include "core/logging.hpp"
 #include "core/mutex.hpp"
+#include "core/set_thread_name.hpp"
 #include "telemetry/counter.hpp"
 #include "telemetry/registry.hpp"
 
 #include "spdlog/sinks/stdout_color_sinks.h"
 #include "spdlog/spdlog.h"
 
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <memory>
+#include <thread>
 #include <unordered_map>
+#include <vector>
 
 namespace fetch {
 namespace {
 
+constexpr LogLevel DEFAULT_LEVEL = LogLevel::INFO;
+
+}  // namespace
+
+namespace detail {
+
+std::atomic<LogLevel> log_level_floor{DEFAULT_LEVEL};
+std::atomic<LogLevel> log_level_ceiling{DEFAULT_LEVEL};
+
+}  // namespace detail
+
+namespace {
+
+constexpr std::size_t CACHE_LINE_SIZE        = 64;
+constexpr std::size_t MAX_CACHED_LOGGERS     = 1024;
+constexpr std::size_t MIN_LOG_BUFFER_SIZE    = 2;
+constexpr std::size_t MAX_RECORDS_PER_DRAIN  = 256;
+constexpr auto        SINK_IDLE_WAIT_TIMEOUT = std::chrono::milliseconds{100};
+
+using Logger = spdlog::logger;
+
+/**
+ * Single producer, single consumer ring buffer of formatted log messages. Each producing thread
+ * owns one of these and the sink thread is the only consumer.
+ */
+class LogBuffer
+{
+public:
+  explicit LogBuffer(std::size_t size);
+  LogBuffer(LogBuffer const &) = delete;
+  LogBuffer(LogBuffer &&)      = delete;
+  ~LogBuffer()                 = default;
+
+  bool TryPush(Logger &logger, LogLevel level, std::string &&message);
+
+  template <typename Handler>
+  std::size_t Drain(Handler &&handler);
+
+  bool empty() const;
+
+  LogBuffer &operator=(LogBuffer const &) = delete;
+  LogBuffer &operator=(LogBuffer &&) = delete;
+
+  /// Set while the owning thread is pushing a message
+  std::atomic<bool> busy{false};
+  /// Set once the owning thread has exited, no more messages will be pushed
+  std::atomic<bool> orphaned{false};
+
+private:
+  struct Record
+  {
+    Logger *    logger{nullptr};
+    LogLevel    level{LogLevel::INFO};
+    std::string message{};
+  };
+
+  using Records = std::vector<Record>;
+  using Index   = std::atomic<std::size_t>;
+
+  Records           records_;
+  std::size_t const mask_;
+
+  // the producer and consumer indices are kept on separate cache lines
+  char  padding0_[CACHE_LINE_SIZE]{};
+  Index head_{0};  ///< The next record to be consumed
+  char  padding1_[CACHE_LINE_SIZE - sizeof(Index)]{};
+  Index tail_{0};  ///< The next record to be produced
+  char  padding2_[CACHE_LINE_SIZE - sizeof(Index)]{};
+};
+
+using LogBufferPtr = std::shared_ptr<LogBuffer>;
+
+std::size_t RoundUpToPowerOfTwo(std::size_t value)
+{
+  std::size_t result{1};
+  while (result < value)
+  {
+    result <<= 1u;
+  }
+
+  return result;
+}
+
+LogBuffer::LogBuffer(std::size_t size)
+  : records_(RoundUpToPowerOfTwo(std::max(size, MIN_LOG_BUFFER_SIZE)))
+  , mask_{records_.size() - 1u}
+{}
+
+bool LogBuffer::TryPush(Logger &logger, LogLevel level, std::string &&message)
+{
+  std::size_t const tail = tail_.load(std::memory_order_relaxed);
+  if ((tail - head_.load(std::memory_order_acquire)) > mask_)
+  {
+    return false;
+  }
+
+  auto &record   = records_[tail & mask_];
+  record.logger  = &logger;
+  record.level   = level;
+  record.message = std::move(message);
+
+  tail_.store(tail + 1u, std::memory_order_release);
+
+  return true;
+}
+
+template <typename Handler>
+std::size_t LogBuffer::Drain(Handler &&handler)
+{
+  std::size_t const tail = tail_.load(std::memory_order_acquire);
+  std::size_t       head = head_.load(std::memory_order_relaxed);
+
+  std::size_t count{0};
+  while ((head != tail) && (count < MAX_RECORDS_PER_DRAIN))
+  {
+    auto &record = records_[head & mask_];
+    handler(*record.logger, record.level, record.message);
+    record.message.clear();
+
+    head_.store(++head, std::memory_order_release);
+    ++count;
+  }
+
+  return count;
+}
+
+bool LogBuffer::empty() const
+{
+  return head_.load(std::memory_order_acquire) == tail_.load(std::memory_order_acquire);
+}
+
+/**
+ * The per thread state of the logging system, a cache of the loggers that the thread has used and
+ * the thread's buffer when logging asynchronously
+ */
+struct ThreadLogState
+{
+  struct CachedLogger
+  {
+    std::string name;
+    Logger *    logger;
+    LogLevel    level;
+    uint64_t    generation;
+  };
+
+  using LoggerCache = std::unordered_map<char const *, CachedLogger>;
+
+  ThreadLogState() = default;
+  ThreadLogState(ThreadLogState const &) = delete;
+  ThreadLogState(ThreadLogState &&)      = delete;
+  ~ThreadLogState();
+
+  ThreadLogState &operator=(ThreadLogState const &) = delete;
+  ThreadLogState &operator=(ThreadLogState &&) = delete;
+
+  static ThreadLogState *Get();
+
+  LoggerCache  loggers{};
+  LogBufferPtr buffer{};
+  uint64_t     buffer_epoch{0};
+};
+
+// Trivially destructible, so it is still valid to check during thread (or process) teardown
+thread_local bool thread_log_state_destroyed{false};
+
+ThreadLogState::~ThreadLogState()
+{
+  if (buffer)
+  {
+    buffer->orphaned.store(true, std::memory_order_release);
+  }
+
+  thread_log_state_destroyed = true;
+}
+
+ThreadLogState *ThreadLogState::Get()
+{
+  if (thread_log_state_destroyed)
+  {
+    return nullptr;
+  }
+
+  thread_local ThreadLogState state;
+  return &state;
+}
+
 class LogRegistry
 {
 public:
@@ -36,27 +230,75 @@ public:
   LogRegistry();
   LogRegistry(LogRegistry const &) = delete;
   LogRegistry(LogRegistry &&)      = delete;
-  ~LogRegistry()                   = default;
+  ~LogRegistry();
 
   void        Log(LogLevel level, char const *name, std::string &&message);
   void        SetLevel(char const *name, LogLevel level);
   LogLevelMap GetLogLevelMap();
+  bool        IsEnabled(LogLevel level, char const *name);
+
+  /// @name Asynchronous Logging
+  /// @{
+  void     EnableAsync(std::size_t buffer_size, LogOverflowPolicy policy);
+  void     DisableAsync();
+  bool     IsAsync() const;
+  uint64_t dropped() const;
+  /// @}
 
   // Operators
   LogRegistry &operator=(LogRegistry const &) = delete;
   LogRegistry &operator=(LogRegistry &&) = delete;
 
 private:
-  using Logger     = spdlog::logger;
-  using LoggerPtr  = std::shared_ptr<Logger>;
-  using Registry   = std::unordered_map<std::string, LoggerPtr>;
-  using Mutex      = std::mutex;
-  using CounterPtr = telemetry::CounterPtr;
-
-  Logger &GetLogger(char const *name);
-
-  Mutex    lock_;
-  Registry registry_;
+  using LoggerPtr     = std::shared_ptr<Logger>;
+  using Registry      = std::unordered_map<std::string, LoggerPtr>;
+  using Mutex         = std::mutex;
+  using CounterPtr    = telemetry::CounterPtr;
+  using LogBuffers    = std::vector<LogBufferPtr>;
+  using Condition     = std::condition_variable;
+  using ThreadPtr     = std::unique_ptr<std::thread>;
+  using Flag          = std::atomic<bool>;
+  using AtomicCounter = std::atomic<uint64_t>;
+
+  struct LoggerEntry
+  {
+    Logger * logger;
+    LogLevel level;
+  };
+
+  LoggerEntry LookupLogger(char const *name);
+  Logger &    GetLogger(char const *name);
+  void        UpdateLevelBounds();
+
+  /// @name Asynchronous Logging
+  /// @{
+  bool        Enqueue(Logger &logger, LogLevel level, std::string &message);
+  LogBuffer * LocalBuffer();
+  void        StopSink();
+  void        RunSink();
+  std::size_t DrainBuffers();
+  bool        HasPendingMessages();
+  void        WakeSink();
+  /// @}
+
+  Mutex         lock_;
+  Registry      registry_;
+  AtomicCounter generation_{1};  ///< Incremented when any logger level changes
+
+  // Asynchronous logging
+  Mutex             control_lock_;  ///< Serialises enabling and disabling
+  Mutex             buffers_lock_;
+  LogBuffers        buffers_;
+  std::size_t       buffer_size_{0};
+  LogOverflowPolicy policy_{LogOverflowPolicy::DROP};
+  AtomicCounter     epoch_{0};  ///< Incremented each time asynchronous logging is enabled
+  Flag              async_{false};
+  Flag              sink_running_{false};
+  Flag              sink_sleeping_{false};
+  Mutex             sink_lock_;
+  Condition         sink_wakeup_;
+  ThreadPtr         sink_thread_;
+  AtomicCounter     dropped_{0};
 
   // Telemetry
   CounterPtr log_messages_{telemetry::Registry::Instance().CreateCounter(
@@ -73,10 +315,11 @@ private:
       "ledger_log_error_messages_total", "The number of error log messages printed")};
   CounterPtr log_critical_messages_{telemetry::Registry::Instance().CreateCounter(
       "ledger_log_critical_messages_total", "The number of critical log messages printed")};
+  CounterPtr log_dropped_messages_{telemetry::Registry::Instance().CreateCounter(
+      "ledger_log_dropped_messages_total",
+      "The number of log messages dropped because the thread's log buffer was full")};
 };
 
-constexpr LogLevel DEFAULT_LEVEL = LogLevel::INFO;
-
 LogRegistry registry_;
 
 LogLevel ConvertToLevel(spdlog::level::level_enum level)
@@ -146,11 +389,18 @@ LogRegistry::LogRegistry()
   spdlog::set_pattern("%^[%L]%$ %Y/%m/%d %T | %-30n : %v");
 }
 
+LogRegistry::~LogRegistry()
+{
+  DisableAsync();
+}
+
 void LogRegistry::Log(LogLevel level, char const *name, std::string &&message)
 {
+  auto const entry = LookupLogger(name);
+
+  if (!(async_.load() && Enqueue(*entry.logger, level, message)))
   {
-    FETCH_LOCK(lock_);
-    GetLogger(name).log(ConvertFromLevel(level), message);
+    entry.logger->log(ConvertFromLevel(level), message);
   }
 
   // telemetry
@@ -186,6 +436,11 @@ void LogRegistry::SetLevel(char const *name, LogLevel level)
   if (it != registry_.end())
   {
     it->second->set_level(ConvertFromLevel(level));
+
+    UpdateLevelBounds();
+
+    // invalidate the per thread logger caches
+    generation_.fetch_add(1u);
   }
 }
 
@@ -204,7 +459,51 @@ LogLevelMap LogRegistry::GetLogLevelMap()
   return level_map;
 }
 
-LogRegistry::Logger &LogRegistry::GetLogger(char const *name)
+bool LogRegistry::IsEnabled(LogLevel level, char const *name)
+{
+  return level >= LookupLogger(name).level;
+}
+
+LogRegistry::LoggerEntry LogRegistry::LookupLogger(char const *name)
+{
+  uint64_t const generation = generation_.load();
+
+  // fast path: the logger has been used by this thread and no levels have changed since
+  auto *state = ThreadLogState::Get();
+  if (state)
+  {
+    auto it = state->loggers.find(name);
+    if ((it != state->loggers.end()) && (it->second.generation == generation) &&
+        (it->second.name == name))
+    {
+      return {it->second.logger, it->second.level};
+    }
+  }
+
+  LoggerEntry entry{};
+  {
+    FETCH_LOCK(lock_);
+
+    entry.logger = &GetLogger(name);
+    entry.level  = ConvertToLevel(entry.logger->level());
+  }
+
+  if (state)
+  {
+    // the names are normally string literals, so this only limits the growth from dynamic names
+    if (state->loggers.size() >= MAX_CACHED_LOGGERS)
+    {
+      state->loggers.clear();
+    }
+
+    state->loggers[name] =
+        ThreadLogState::CachedLogger{name, entry.logger, entry.level, generation};
+  }
+
+  return entry;
+}
+
+Logger &LogRegistry::GetLogger(char const *name)
 {
   auto it = registry_.find(name);
   if (it == registry_.end())
@@ -224,6 +523,256 @@ LogRegistry::Logger &LogRegistry::GetLogger(char const *name)
   }
 }
 
+void LogRegistry::UpdateLevelBounds()
+{
+  LogLevel floor{DEFAULT_LEVEL};
+  LogLevel ceiling{DEFAULT_LEVEL};
+
+  for (auto const &element : registry_)
+  {
+    auto const level = ConvertToLevel(element.second->level());
+
+    floor   = std::min(floor, level);
+    ceiling = std::max(ceiling, level);
+  }
+
+  detail::log_level_floor.store(floor);
+  detail::log_level_ceiling.store(ceiling);
+}
+
+void LogRegistry::EnableAsync(std::size_t buffer_size, LogOverflowPolicy policy)
+{
+  FETCH_LOCK(control_lock_);
+
+  // flush any previous configuration
+  StopSink();
+
+  {
+    FETCH_LOCK(buffers_lock_);
+
+    buffer_size_ = buffer_size;
+    policy_      = policy;
+
+    // threads will create a new buffer on their next message
+    epoch_.fetch_add(1u);
+    async_.store(true);
+  }
+
+  sink_running_.store(true);
+  sink_thread_ = std::make_unique<std::thread>([this]() { RunSink(); });
+}
+
+void LogRegistry::DisableAsync()
+{
+  FETCH_LOCK(control_lock_);
+  StopSink();
+}
+
+bool LogRegistry::IsAsync() const
+{
+  return async_.load();
+}
+
+uint64_t LogRegistry::dropped() const
+{
+  return dropped_.load();
+}
+
+/**
+ * Queue a formatted message on the calling thread's buffer
+ *
+ * @return true if the message was queued (or dropped), false if it should be logged directly
+ */
+bool LogRegistry::Enqueue(Logger &logger, LogLevel level, std::string &message)
+{
+  LogBuffer *buffer = LocalBuffer();
+  if (buffer == nullptr)
+  {
+    return false;
+  }
+
+  // announce the push before checking that the sink is still running, StopSink() waits for this
+  // to be cleared once it has disabled asynchronous logging
+  buffer->busy.store(true);
+
+  bool queued{false};
+  while (async_.load())
+  {
+    if (buffer->TryPush(logger, level, std::move(message)))
+    {
+      queued = true;
+      break;
+    }
+
+    if (policy_ == LogOverflowPolicy::DROP)
+    {
+      dropped_.fetch_add(1u, std::memory_order_relaxed);
+      log_dropped_messages_->increment();
+
+      queued = true;
+      break;
+    }
+
+    // blocking: give the sink thread the chance to catch up
+    WakeSink();
+    std::this_thread::yield();
+  }
+
+  buffer->busy.store(false);
+
+  if (queued && sink_sleeping_.load())
+  {
+    WakeSink();
+  }
+
+  return queued;
+}
+
+LogBuffer *LogRegistry::LocalBuffer()
+{
+  auto *state = ThreadLogState::Get();
+  if (state == nullptr)
+  {
+    return nullptr;
+  }
+
+  if (state->buffer && (state->buffer_epoch == epoch_.load()))
+  {
+    return state->buffer.get();
+  }
+
+  // register a new buffer for this thread
+  FETCH_LOCK(buffers_lock_);
+
+  if (!async_.load())
+  {
+    return nullptr;
+  }
+
+  if (state->buffer)
+  {
+    state->buffer->orphaned.store(true);
+  }
+
+  state->buffer       = std::make_shared<LogBuffer>(buffer_size_);
+  state->buffer_epoch = epoch_.load();
+  buffers_.push_back(state->buffer);
+
+  return state->buffer.get();
+}
+
+void LogRegistry::StopSink()
+{
+  LogBuffers buffers{};
+  {
+    FETCH_LOCK(buffers_lock_);
+
+    if (!async_.load())
+    {
+      return;
+    }
+
+    async_.store(false);
+    buffers = buffers_;
+  }
+
+  // wait for any producers which had already seen asynchronous logging as enabled
+  for (auto const &buffer : buffers)
+  {
+    while (buffer->busy.load())
+    {
+      std::this_thread::yield();
+    }
+  }
+
+  // the sink drains all the remaining messages before exiting
+  sink_running_.store(false);
+  WakeSink();
+
+  if (sink_thread_)
+  {
+    sink_thread_->join();
+    sink_thread_.reset();
+  }
+
+  FETCH_LOCK(buffers_lock_);
+  buffers_.clear();
+}
+
+void LogRegistry::RunSink()
+{
+  SetThreadName("LogSink");
+
+  for (;;)
+  {
+    bool const stopping = !sink_running_.load();
+
+    if (DrainBuffers() > 0)
+    {
+      continue;
+    }
+
+    if (stopping)
+    {
+      break;
+    }
+
+    std::unique_lock<Mutex> lock(sink_lock_);
+    sink_sleeping_.store(true);
+
+    if (sink_running_.load() && !HasPendingMessages())
+    {
+      sink_wakeup_.wait_for(lock, SINK_IDLE_WAIT_TIMEOUT);
+    }
+
+    sink_sleeping_.store(false);
+  }
+}
+
+std::size_t LogRegistry::DrainBuffers()
+{
+  FETCH_LOCK(buffers_lock_);
+
+  std::size_t count{0};
+  for (auto it = buffers_.begin(); it != buffers_.end();)
+  {
+    auto &buffer = **it;
+
+    // must be checked before draining, the buffer can only be removed once it is known that no
+    // more messages will be pushed
+    bool const orphaned = buffer.orphaned.load();
+
+    count += buffer.Drain([](Logger &logger, LogLevel level, std::string const &message) {
+      logger.log(ConvertFromLevel(level), message);
+    });
+
+    if (orphaned && buffer.empty())
+    {
+      it = buffers_.erase(it);
+    }
+    else
+    {
+      ++it;
+    }
+  }
+
+  return count;
+}
+
+bool LogRegistry::HasPendingMessages()
+{
+  FETCH_LOCK(buffers_lock_);
+
+  return std::any_of(buffers_.begin(), buffers_.end(),
+                     [](LogBufferPtr const &buffer) { return !buffer->empty(); });
+}
+
+void LogRegistry::WakeSink()
+{
+  FETCH_LOCK(sink_lock_);
+  sink_wakeup_.notify_one();
+}
+
 }  // namespace
 
 void SetLogLevel(char const *name, LogLevel level)
@@ -241,4 +790,33 @@ LogLevelMap GetLogLevelMap()
   return registry_.GetLogLevelMap();
 }
 
+void EnableAsyncLogging(std::size_t buffer_size, LogOverflowPolicy policy)
+{
+  registry_.EnableAsync(buffer_size, policy);
+}
+
+void DisableAsyncLogging()
+{
+  registry_.DisableAsync();
+}
+
+bool IsAsyncLoggingEnabled()
+{
+  return registry_.IsAsync();
+}
+
+uint64_t GetDroppedLogMessageCount()
+{
+  return registry_.dropped();
+}
+
+namespace detail {
+
+bool IsLogLevelEnabledForName(LogLevel level, char const *name)
+{
+  return registry_.IsEnabled(level, name);
+}
+
+}  // namespace detail
+
 }  // namespace fetch
@@ -0,0 +1,168 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/logging.hpp"
+
+#include "gtest/gtest.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using namespace fetch;
+using testing::internal::CaptureStdout;
+using testing::internal::GetCapturedStdout;
+
+constexpr char const *LOGGING_NAME = "LoggingTests";
+
+class FormatCounter
+{
+public:
+  explicit FormatCounter(std::size_t &count)
+    : count_{count}
+  {}
+
+  friend std::ostream &operator<<(std::ostream &stream, FormatCounter const &counter)
+  {
+    ++counter.count_;
+    return stream << "counter";
+  }
+
+private:
+  std::size_t &count_;
+};
+
+std::size_t CountOccurrences(std::string const &text, std::string const &pattern)
+{
+  std::size_t count{0};
+  for (auto pos = text.find(pattern); pos != std::string::npos;
+       pos      = text.find(pattern, pos + pattern.size()))
+  {
+    ++count;
+  }
+
+  return count;
+}
+
+TEST(LoggingTests, CheckDisabledMessagesAreNotFormatted)
+{
+  std::size_t count{0};
+
+  SetLogLevel(LOGGING_NAME, LogLevel::INFO);
+
+  FETCH_LOG_DEBUG(LOGGING_NAME, "Value: ", FormatCounter{count});
+  FETCH_LOG_TRACE(LOGGING_NAME, "Value: ", FormatCounter{count});
+  EXPECT_EQ(count, 0u);
+
+#ifdef FETCH_LOG_WARN_ENABLED
+  CaptureStdout();
+  FETCH_LOG_WARN(LOGGING_NAME, "Value: ", FormatCounter{count});
+  GetCapturedStdout();
+  EXPECT_EQ(count, 1u);
+#endif  // FETCH_LOG_WARN_ENABLED
+}
+
+TEST(LoggingTests, CheckLevelChangesAreObserved)
+{
+  static constexpr char const *NAME = "LoggingTestsLevels";
+
+#ifdef FETCH_LOG_WARN_ENABLED
+  // create the logger
+  CaptureStdout();
+  FETCH_LOG_WARN(NAME, "Creating logger");
+  GetCapturedStdout();
+#endif  // FETCH_LOG_WARN_ENABLED
+
+  SetLogLevel(NAME, LogLevel::DEBUG);
+  EXPECT_TRUE(IsLogLevelEnabled(LogLevel::DEBUG, NAME));
+  EXPECT_FALSE(IsLogLevelEnabled(LogLevel::TRACE, NAME));
+
+  SetLogLevel(NAME, LogLevel::ERROR);
+  EXPECT_FALSE(IsLogLevelEnabled(LogLevel::WARNING, NAME));
+  EXPECT_TRUE(IsLogLevelEnabled(LogLevel::ERROR, NAME));
+
+  SetLogLevel(NAME, LogLevel::INFO);
+  EXPECT_TRUE(IsLogLevelEnabled(LogLevel::INFO, NAME));
+}
+
+#ifdef FETCH_LOG_WARN_ENABLED
+
+TEST(LoggingTests, CheckAsyncMessagesAreAllDelivered)
+{
+  static constexpr std::size_t NUM_THREADS         = 4;
+  static constexpr std::size_t MESSAGES_PER_THREAD = 500;
+
+  CaptureStdout();
+
+  // large enough buffers to guarantee that nothing is dropped
+  EnableAsyncLogging(MESSAGES_PER_THREAD, LogOverflowPolicy::DROP);
+  EXPECT_TRUE(IsAsyncLoggingEnabled());
+
+  std::vector<std::thread> threads;
+  for (std::size_t i = 0; i < NUM_THREADS; ++i)
+  {
+    threads.emplace_back([]() {
+      for (std::size_t j = 0; j < MESSAGES_PER_THREAD; ++j)
+      {
+        FETCH_LOG_WARN(LOGGING_NAME, "async-message ", j);
+      }
+    });
+  }
+
+  for (auto &thread : threads)
+  {
+    thread.join();
+  }
+
+  DisableAsyncLogging();
+  EXPECT_FALSE(IsAsyncLoggingEnabled());
+
+  auto const output = GetCapturedStdout();
+  EXPECT_EQ(CountOccurrences(output, "async-message "), NUM_THREADS * MESSAGES_PER_THREAD);
+}
+
+TEST(LoggingTests, CheckBlockingPolicyNeverDropsMessages)
+{
+  static constexpr std::size_t NUM_MESSAGES = 1000;
+
+  uint64_t const dropped = GetDroppedLogMessageCount();
+
+  CaptureStdout();
+
+  EnableAsyncLogging(4, LogOverflowPolicy::BLOCK);
+
+  for (std::size_t i = 0; i < NUM_MESSAGES; ++i)
+  {
+    FETCH_LOG_WARN(LOGGING_NAME, "blocking-message ", i);
+  }
+
+  DisableAsyncLogging();
+
+  auto const output = GetCapturedStdout();
+  EXPECT_EQ(CountOccurrences(output, "blocking-message "), NUM_MESSAGES);
+  EXPECT_EQ(GetDroppedLogMessageCount(), dropped);
+}
+
+#endif  // FETCH_LOG_WARN_ENABLED
+
+}  // namespace
@@ -0,0 +1,148 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/byte_array/const_byte_array.hpp"
+#include "crypto/mcl_dkg.hpp"
+
+#include "benchmark/benchmark.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+using fetch::byte_array::ConstByteArray;
+using namespace fetch::dkg;
+
+namespace {
+
+/**
+ * A cabinet where every member has signed the round message with its share of the group secret
+ */
+struct Cabinet
+{
+  explicit Cabinet(uint32_t size)
+    : threshold{size / 2}
+  {
+    bn::initPairing();
+
+    bn::Fp2 const g(
+        "1380305877306098957770911920312855400078250832364663138573638818396353623780",
+        "14633108267626422569982187812838828838622813723380760182609272619611213638781");
+    bn::mapToG2(group_g, g);
+    group_g_coefficients = PrecomputePairing(group_g);
+
+    std::vector<bn::Fr> coefficients(threshold + 1);
+    for (auto &coefficient : coefficients)
+    {
+      coefficient.setByCSPRNG();
+    }
+
+    for (uint32_t i = 0; i < size; ++i)
+    {
+      bn::Fr share, unused;
+      ComputeShares(share, unused, coefficients, coefficients, i);
+
+      bn::G2 public_key;
+      bn::G2::mul(public_key, group_g, share);
+
+      public_keys.push_back(public_key);
+      signs.push_back(SignShare(message, share));
+    }
+  }
+
+  uint32_t             threshold;
+  ConstByteArray const message{"beacon round payload"};
+  bn::G2               group_g;
+  PrecomputedG2        group_g_coefficients;
+  std::vector<bn::G2>  public_keys;
+  std::vector<bn::G1>  signs;
+};
+
+/**
+ * One share at a time: a full pairing check per share, then interpolation from scratch
+ */
+void BeaconRound_Individual(benchmark::State &state)
+{
+  Cabinet const cabinet{static_cast<uint32_t>(state.range(0))};
+
+  for (auto _ : state)
+  {
+    std::unordered_map<uint32_t, bn::G1> shares;
+    for (uint32_t i = 0; i < cabinet.signs.size(); ++i)
+    {
+      if (VerifySign(cabinet.public_keys[i], cabinet.message, cabinet.signs[i], cabinet.group_g) &&
+          (shares.size() <= cabinet.threshold))
+      {
+        shares.emplace(i, cabinet.signs[i]);
+      }
+    }
+
+    benchmark::DoNotOptimize(LagrangeInterpolation(shares));
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+
+/**
+ * Batched pairing check over the whole cabinet, then combination with cached coefficients
+ */
+void BeaconRound_Batched(benchmark::State &state)
+{
+  Cabinet const            cabinet{static_cast<uint32_t>(state.range(0))};
+  LagrangeCoefficientCache cache;
+
+  for (auto _ : state)
+  {
+    auto const valid = BatchVerifySigns(cabinet.public_keys, cabinet.message, cabinet.signs,
+                                        cabinet.group_g_coefficients);
+
+    std::vector<uint32_t> parties;
+    std::vector<bn::G1>   shares;
+    for (uint32_t i = 0; (i < valid.size()) && (parties.size() <= cabinet.threshold); ++i)
+    {
+      if (valid[i])
+      {
+        parties.push_back(i);
+        shares.push_back(cabinet.signs[i]);
+      }
+    }
+
+    benchmark::DoNotOptimize(CombineSignShares(shares, cache.Lookup(parties)));
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+
+}  // namespace
+
+BENCHMARK(BeaconRound_Individual)
+    ->Arg(10)
+    ->Arg(25)
+    ->Arg(50)
+    ->Arg(100)
+    ->Arg(200)
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK(BeaconRound_Batched)
+    ->Arg(10)
+    ->Arg(25)
+    ->Arg(50)
+    ->Arg(100)
+    ->Arg(200)
+    ->Unit(benchmark::kMillisecond);
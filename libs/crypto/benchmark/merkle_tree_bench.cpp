@@ -0,0 +1,131 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/byte_array/byte_array.hpp"
+#include "core/random/lcg.hpp"
+#include "crypto/hash.hpp"
+#include "crypto/merkle_tree.hpp"
+#include "crypto/sha256.hpp"
+
+#include "benchmark/benchmark.h"
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+using fetch::byte_array::ByteArray;
+using fetch::byte_array::ConstByteArray;
+using fetch::crypto::Hash;
+using fetch::crypto::MerkleTree;
+using fetch::crypto::SHA256;
+using fetch::random::LinearCongruentialGenerator;
+
+namespace {
+
+using RNG = LinearCongruentialGenerator;
+
+constexpr std::size_t DIGEST_SIZE = SHA256::size_in_bytes;
+
+MerkleTree GenerateTree(std::size_t num_leaves)
+{
+  static constexpr std::size_t NUM_WORDS = DIGEST_SIZE / sizeof(RNG::RandomType);
+
+  RNG        rng;
+  MerkleTree tree{num_leaves};
+
+  for (std::size_t i = 0; i < num_leaves; ++i)
+  {
+    ByteArray leaf;
+    leaf.Resize(DIGEST_SIZE);
+
+    auto *words = reinterpret_cast<RNG::RandomType *>(leaf.pointer());
+    for (std::size_t j = 0; j < NUM_WORDS; ++j)
+    {
+      words[j] = rng();
+    }
+
+    tree[i] = leaf;
+  }
+
+  return tree;
+}
+
+/**
+ * The original implementation, one SHA256 per interior node, used as a reference
+ */
+ConstByteArray ReferenceRoot(MerkleTree const &tree)
+{
+  std::vector<ConstByteArray> level(tree.leaf_nodes().begin(), tree.leaf_nodes().end());
+
+  while (level.size() & (level.size() - 1))
+  {
+    level.emplace_back();
+  }
+
+  while (level.size() > 1)
+  {
+    std::vector<ConstByteArray> next(level.size() / 2);
+    for (std::size_t i = 0; i < next.size(); ++i)
+    {
+      next[i] = Hash<SHA256>(level[2 * i] + level[(2 * i) + 1]);
+    }
+
+    level = std::move(next);
+  }
+
+  return level.front();
+}
+
+void MerkleTree_CalculateRoot(benchmark::State &state)
+{
+  auto const tree = GenerateTree(static_cast<std::size_t>(state.range(0)));
+
+  for (auto _ : state)
+  {
+    tree.CalculateRoot();
+    benchmark::DoNotOptimize(tree.root());
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+
+void MerkleTree_ReferenceRoot(benchmark::State &state)
+{
+  auto const tree = GenerateTree(static_cast<std::size_t>(state.range(0)));
+
+  for (auto _ : state)
+  {
+    benchmark::DoNotOptimize(ReferenceRoot(tree));
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+
+}  // namespace
+
+BENCHMARK(MerkleTree_CalculateRoot)
+    ->Arg(1000)
+    ->Arg(100000)
+    ->Arg(1000000)
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK(MerkleTree_ReferenceRoot)
+    ->Arg(1000)
+    ->Arg(100000)
+    ->Arg(1000000)
+    ->Unit(benchmark::kMillisecond);
@@ -55,6 +55,25 @@ public:
     return sig.Verify(public_key_, data);
   }
 
+  /**
+   * Verify a signature against a precomputed digest of the signed data. Allows callers verifying
+   * many signatures to reuse a single hasher and a decoded public key.
+   *
+   * @param hash The SHA256 digest of the signed data
+   * @param signature The signature to verify
+   * @return true if the signature is valid, otherwise false
+   */
+  bool VerifyHash(ConstByteArray const &hash, ConstByteArray const &signature) const
+  {
+    if (!identity_ || signature.empty())
+    {
+      return false;
+    }
+
+    Signature sig{signature};
+    return sig.VerifyHash(public_key_, hash);
+  }
+
   Identity identity() override
   {
     return identity_;
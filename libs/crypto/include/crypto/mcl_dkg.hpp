@@ -24,9 +24,11 @@
 #include <cstddef>
 #include <cstdint>
 #include <iomanip>
+#include <map>
 #include <set>
 #include <sstream>
 #include <unordered_map>
+#include <vector>
 
 namespace bn = mcl::bn256;
 
@@ -50,6 +52,38 @@ bool   VerifySign(bn::G2 const &y, byte_array::ConstByteArray const &message, bn
                   bn::G2 const &G);
 bn::G1 LagrangeInterpolation(std::unordered_map<uint32_t, bn::G1> const &shares);
 
+/**
+ * Batched verification and combination of signature shares
+ */
+using PrecomputedG2 = std::vector<bn::Fp6>;
+
+PrecomputedG2       PrecomputePairing(bn::G2 const &G);
+bool                VerifySign(bn::G2 const &y, byte_array::ConstByteArray const &message,
+                               bn::G1 const &sign, PrecomputedG2 const &G);
+std::vector<bool>   BatchVerifySigns(std::vector<bn::G2> const &       public_keys,
+                                     byte_array::ConstByteArray const &message,
+                                     std::vector<bn::G1> const &       signs,
+                                     PrecomputedG2 const &             G);
+std::vector<bn::Fr> ComputeLagrangeCoefficients(std::vector<uint32_t> const &parties);
+bn::G1              CombineSignShares(std::vector<bn::G1> const &shares,
+                                      std::vector<bn::Fr> const &coefficients);
+
+/**
+ * Cache of the Lagrange coefficients for the sets of signers seen during a cabinet's lifetime.
+ * When shares are combined from the lowest indexed signers the same few sets come up every round.
+ */
+class LagrangeCoefficientCache
+{
+public:
+  static constexpr std::size_t MAX_ENTRIES = 16;
+
+  std::vector<bn::Fr> const &Lookup(std::vector<uint32_t> const &parties);
+  void                       Clear();
+
+private:
+  std::map<std::vector<uint32_t>, std::vector<bn::Fr>> coefficients_;
+};
+
 /**
  * Vector initialisation for mcl data structures
  *
@@ -0,0 +1,46 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include <cstddef>
+#include <cstdint>
+
+namespace fetch {
+namespace crypto {
+
+/**
+ * Multi-buffer SHA256 for batches of independent 64 byte messages, the shape of every interior
+ * node of a binary merkle tree (the concatenation of two 32 byte child digests).
+ *
+ * The messages are hashed several at a time, one per vector lane: 8 lanes with AVX2, 4 lanes
+ * with SSE2 and a portable scalar fallback otherwise. The digests are identical to those
+ * produced by `SHA256`.
+ */
+struct SHA256Batch
+{
+  static constexpr std::size_t MESSAGE_SIZE = 64;
+  static constexpr std::size_t DIGEST_SIZE  = 32;
+
+  static std::size_t NumLanes();
+  static char const *Implementation();
+
+  static void Hash64(uint8_t const *messages, std::size_t count, uint8_t *digests);
+};
+
+}  // namespace crypto
+}  // namespace fetch
@@ -17,18 +17,176 @@
 //------------------------------------------------------------------------------
 
 #include "crypto/mcl_dkg.hpp"
+#include "vectorise/threading/pool.hpp"
 
 #include <mcl/bn256.hpp>
 
+#include <algorithm>
 #include <cassert>
 #include <cstddef>
+#include <exception>
+#include <future>
 #include <stdexcept>
+#include <thread>
 #include <unordered_map>
 
 namespace bn = mcl::bn256;
 
 namespace fetch {
 namespace dkg {
+namespace {
+
+// The minimum amount of work (curve multiplications or field products) worth a separate thread
+constexpr std::size_t MIN_ITEMS_PER_THREAD = 16;
+
+/**
+ * Split the range [0, count) into contiguous chunks and evaluate them on the shared DKG pool, the
+ * calling thread evaluating the first chunk. Ranges too small to give every chunk
+ * MIN_ITEMS_PER_THREAD items are evaluated on the calling thread alone
+ *
+ * @param count The number of items
+ * @param handler The callable invoked with the (chunk index, begin, end) of each chunk
+ * @return The number of chunks
+ */
+threading::Pool &DkgPool()
+{
+  static threading::Pool pool{std::max<std::size_t>(std::thread::hardware_concurrency(), 1),
+                              "Dkg"};
+  return pool;
+}
+
+template <typename Handler>
+std::size_t ParallelFor(std::size_t count, Handler &&handler)
+{
+  std::size_t const num_chunks =
+      std::max<std::size_t>(1, std::min(DkgPool().concurrency(), count / MIN_ITEMS_PER_THREAD));
+  std::size_t const chunk = (count + num_chunks - 1) / num_chunks;
+
+  std::vector<std::future<void>> pending;
+  pending.reserve(num_chunks - 1);
+
+  for (std::size_t i = 1; i < num_chunks; ++i)
+  {
+    pending.emplace_back(
+        DkgPool().Dispatch(handler, i, i * chunk, std::min((i + 1) * chunk, count)));
+  }
+
+  // the other chunks refer to the caller's frame, so they must finish before it unwinds
+  std::exception_ptr error;
+  try
+  {
+    handler(std::size_t{0}, std::size_t{0}, std::min(chunk, count));
+  }
+  catch (...)
+  {
+    error = std::current_exception();
+  }
+
+  for (auto &result : pending)
+  {
+    result.wait();
+  }
+
+  if (error)
+  {
+    std::rethrow_exception(error);
+  }
+
+  for (auto &result : pending)
+  {
+    result.get();
+  }
+
+  return num_chunks;
+}
+
+bn::G1 HashToG1(byte_array::ConstByteArray const &message)
+{
+  bn::Fp Hm;
+  bn::G1 PH;
+  Hm.setHashOf(message.pointer(), message.size());
+  bn::mapToG1(PH, Hm);
+
+  return PH;
+}
+
+/**
+ * Check a random linear combination of the signature shares in the range [begin, end):
+ *
+ *   e(sum r_i sign_i, G) == e(H(m), sum r_i y_i)
+ *
+ * evaluated as a single multi-pairing with one final exponentiation. A forged share only passes
+ * with negligible probability since the r_i are not known in advance.
+ */
+bool VerifyCombination(std::vector<bn::G2> const &public_keys, std::vector<bn::G1> const &signs,
+                       std::vector<bn::Fr> const &randoms, bn::G1 const &neg_PH,
+                       PrecomputedG2 const &G, std::size_t begin, std::size_t end)
+{
+  std::size_t const count = end - begin;
+
+  std::vector<bn::G1> sign_sums(count);
+  std::vector<bn::G2> key_sums(count);
+
+  std::size_t const num_chunks =
+      ParallelFor(count, [&](std::size_t chunk, std::size_t chunk_begin, std::size_t chunk_end) {
+        bn::G1 sign_sum, sign_tmp;
+        bn::G2 key_sum, key_tmp;
+        sign_sum.clear();
+        key_sum.clear();
+
+        for (std::size_t i = begin + chunk_begin; i < begin + chunk_end; ++i)
+        {
+          bn::G1::mul(sign_tmp, signs[i], randoms[i]);
+          bn::G1::add(sign_sum, sign_sum, sign_tmp);
+          bn::G2::mul(key_tmp, public_keys[i], randoms[i]);
+          bn::G2::add(key_sum, key_sum, key_tmp);
+        }
+
+        sign_sums[chunk] = sign_sum;
+        key_sums[chunk]  = key_sum;
+      });
+
+  bn::G1 sign_sum = sign_sums[0];
+  bn::G2 key_sum  = key_sums[0];
+  for (std::size_t i = 1; i < num_chunks; ++i)
+  {
+    bn::G1::add(sign_sum, sign_sum, sign_sums[i]);
+    bn::G2::add(key_sum, key_sum, key_sums[i]);
+  }
+
+  bn::Fp12 e1, e2;
+  bn::precomputedMillerLoop(e1, sign_sum, G);
+  bn::millerLoop(e2, neg_PH, key_sum);
+  bn::Fp12::mul(e1, e1, e2);
+  bn::finalExp(e1, e1);
+
+  return e1.isOne();
+}
+
+/**
+ * Verify the shares in the range [begin, end), bisecting the range whenever the combined check
+ * fails so that the invalid shares can be identified
+ */
+void BatchVerifyRange(std::vector<bn::G2> const &public_keys, std::vector<bn::G1> const &signs,
+                      std::vector<bn::Fr> const &randoms, bn::G1 const &neg_PH,
+                      PrecomputedG2 const &G, std::size_t begin, std::size_t end,
+                      std::vector<bool> &valid)
+{
+  if (VerifyCombination(public_keys, signs, randoms, neg_PH, G, begin, end))
+  {
+    std::fill(valid.begin() + static_cast<std::ptrdiff_t>(begin),
+              valid.begin() + static_cast<std::ptrdiff_t>(end), true);
+  }
+  else if ((end - begin) > 1)
+  {
+    std::size_t const middle = begin + ((end - begin) / 2);
+
+    BatchVerifyRange(public_keys, signs, randoms, neg_PH, G, begin, middle, valid);
+    BatchVerifyRange(public_keys, signs, randoms, neg_PH, G, middle, end, valid);
+  }
+}
+
+}  // namespace
 
 /**
  * LHS and RHS functions are used for checking consistency between publicly broadcasted coefficients
@@ -245,10 +403,7 @@ bool VerifySign(bn::G2 const &y, byte_array::ConstByteArray const &message, bn::
                 bn::G2 const &G)
 {
   bn::Fp12 e1, e2;
-  bn::Fp   Hm;
-  bn::G1   PH;
-  Hm.setHashOf(message.pointer(), message.size());
-  bn::mapToG1(PH, Hm);
+  bn::G1   PH{HashToG1(message)};
 
   bn::pairing(e1, sign, G);
   bn::pairing(e2, PH, y);
@@ -256,6 +411,200 @@ bool VerifySign(bn::G2 const &y, byte_array::ConstByteArray const &message, bn::
   return e1 == e2;
 }
 
+/**
+ * Precompute the Miller loop coefficients for a fixed G2 point, typically the group generator
+ * which is used for the lifetime of a cabinet
+ *
+ * @param G Group used in DKG
+ * @return The precomputed coefficients
+ */
+PrecomputedG2 PrecomputePairing(bn::G2 const &G)
+{
+  PrecomputedG2 coefficients;
+  bn::precomputeG2(coefficients, G);
+
+  return coefficients;
+}
+
+/**
+ * Verifies a signature as a single multi-pairing, e(sign, G) * e(-H(m), y) == 1
+ *
+ * @param y The public key (can be the group public key, or public key share)
+ * @param message Message that was signed
+ * @param sign Signature to be verified
+ * @param G Precomputed group used in DKG
+ * @return true if the signature is valid, otherwise false
+ */
+bool VerifySign(bn::G2 const &y, byte_array::ConstByteArray const &message, bn::G1 const &sign,
+                PrecomputedG2 const &G)
+{
+  bn::G1 neg_PH{HashToG1(message)};
+  bn::G1::neg(neg_PH, neg_PH);
+
+  bn::Fp12 e1, e2;
+  bn::precomputedMillerLoop(e1, sign, G);
+  bn::millerLoop(e2, neg_PH, y);
+  bn::Fp12::mul(e1, e1, e2);
+  bn::finalExp(e1, e1);
+
+  return e1.isOne();
+}
+
+/**
+ * Verifies a set of signature shares of the same message. All of the shares are checked with a
+ * single random linear combination (two Miller loops) and only if that fails is the set bisected
+ * to find the invalid shares.
+ *
+ * @param public_keys The public key shares of the signers
+ * @param message Message that was signed
+ * @param signs Signature shares to be verified, in the same order as public_keys
+ * @param G Precomputed group used in DKG
+ * @return The validity of each of the signature shares
+ */
+std::vector<bool> BatchVerifySigns(std::vector<bn::G2> const &       public_keys,
+                                   byte_array::ConstByteArray const &message,
+                                   std::vector<bn::G1> const &       signs,
+                                   PrecomputedG2 const &             G)
+{
+  assert(public_keys.size() == signs.size());
+
+  std::vector<bool> valid(signs.size(), false);
+  if (signs.empty())
+  {
+    return valid;
+  }
+
+  bn::G1 neg_PH{HashToG1(message)};
+  bn::G1::neg(neg_PH, neg_PH);
+
+  std::vector<bn::Fr> randoms(signs.size());
+  for (auto &random : randoms)
+  {
+    random.setByCSPRNG();
+  }
+
+  BatchVerifyRange(public_keys, signs, randoms, neg_PH, G, 0, signs.size(), valid);
+
+  return valid;
+}
+
+/**
+ * Computes the Lagrange coefficients for evaluating, at 0, the polynomial through the points
+ * owned by the specified parties. The products are evaluated in parallel and all of the divisions
+ * are replaced by a single field inversion.
+ *
+ * @param parties The (distinct) indices of the parties
+ * @return The coefficient for each party, in the same order
+ */
+std::vector<bn::Fr> ComputeLagrangeCoefficients(std::vector<uint32_t> const &parties)
+{
+  std::size_t const count = parties.size();
+
+  // lambda_j = prod_{m != j} x_m / (x_m - x_j) = (prod_m x_m) / (x_j * prod_{m != j} (x_m - x_j))
+  std::vector<bn::Fr> denominators(count);
+  ParallelFor(count, [&parties, &denominators](std::size_t, std::size_t begin, std::size_t end) {
+    bn::Fr tmpF;
+    for (std::size_t j = begin; j < end; ++j)
+    {
+      bn::Fr x_j{parties[j] + 1};  // adjust index in computation
+      bn::Fr denominator{x_j};
+      for (std::size_t m = 0; m < parties.size(); ++m)
+      {
+        if (m != j)
+        {
+          tmpF = parties[m] + 1;
+          bn::Fr::sub(tmpF, tmpF, x_j);
+          bn::Fr::mul(denominator, denominator, tmpF);
+        }
+      }
+      denominators[j] = denominator;
+    }
+  });
+
+  bn::Fr numerator{1};
+  for (auto const &party : parties)
+  {
+    bn::Fr::mul(numerator, numerator, party + 1);
+  }
+
+  // batch inversion of the denominators
+  std::vector<bn::Fr> prefix(count);
+  bn::Fr              running{1};
+  for (std::size_t j = 0; j < count; ++j)
+  {
+    prefix[j] = running;
+    bn::Fr::mul(running, running, denominators[j]);
+  }
+
+  bn::Fr inverse;
+  bn::Fr::inv(inverse, running);
+  bn::Fr::mul(inverse, inverse, numerator);
+
+  std::vector<bn::Fr> coefficients(count);
+  for (std::size_t j = count; j > 0; --j)
+  {
+    bn::Fr::mul(coefficients[j - 1], inverse, prefix[j - 1]);
+    bn::Fr::mul(inverse, inverse, denominators[j - 1]);
+  }
+
+  return coefficients;
+}
+
+/**
+ * Combines signature shares with the specified Lagrange coefficients, in parallel
+ *
+ * @param shares The signature shares
+ * @param coefficients The coefficients of the signers, in the same order as the shares
+ * @return The group signature
+ */
+bn::G1 CombineSignShares(std::vector<bn::G1> const &shares, std::vector<bn::Fr> const &coefficients)
+{
+  assert(shares.size() == coefficients.size());
+
+  std::vector<bn::G1> partial_sums(shares.size() + 1);
+  std::size_t const   num_chunks = ParallelFor(
+      shares.size(), [&](std::size_t chunk, std::size_t begin, std::size_t end) {
+        bn::G1 sum, tmp;
+        sum.clear();
+        for (std::size_t i = begin; i < end; ++i)
+        {
+          bn::G1::mul(tmp, shares[i], coefficients[i]);
+          bn::G1::add(sum, sum, tmp);
+        }
+        partial_sums[chunk] = sum;
+      });
+
+  bn::G1 res = partial_sums[0];
+  for (std::size_t i = 1; i < num_chunks; ++i)
+  {
+    bn::G1::add(res, res, partial_sums[i]);
+  }
+
+  return res;
+}
+
+std::vector<bn::Fr> const &LagrangeCoefficientCache::Lookup(std::vector<uint32_t> const &parties)
+{
+  auto it = coefficients_.find(parties);
+  if (it == coefficients_.end())
+  {
+    // signer sets rarely repeat once the cabinet membership has churned, start again
+    if (coefficients_.size() >= MAX_ENTRIES)
+    {
+      coefficients_.clear();
+    }
+
+    it = coefficients_.emplace(parties, ComputeLagrangeCoefficients(parties)).first;
+  }
+
+  return it->second;
+}
+
+void LagrangeCoefficientCache::Clear()
+{
+  coefficients_.clear();
+}
+
 /**
  * Computes the group signature using the indices and signature shares of threshold_ + 1
  * parties
@@ -270,30 +619,19 @@ bn::G1 LagrangeInterpolation(std::unordered_map<uint32_t, bn::G1> const &shares)
   {
     return shares.begin()->second;
   }
-  bn::G1 res;
-  res.clear();
 
-  bn::Fr a = 1;
-  for (auto &p : shares)
-  {
-    a *= bn::Fr(p.first + 1);
-  }
+  std::vector<uint32_t> parties;
+  std::vector<bn::G1>   signs;
+  parties.reserve(shares.size());
+  signs.reserve(shares.size());
 
-  for (auto &p1 : shares)
+  for (auto const &share : shares)
   {
-    auto b = static_cast<bn::Fr>(p1.first + 1);
-    for (auto &p2 : shares)
-    {
-      if (p2.first != p1.first)
-      {
-        b *= static_cast<bn::Fr>(p2.first) - static_cast<bn::Fr>(p1.first);
-      }
-    }
-    bn::G1 t;
-    bn::G1::mul(t, p1.second, a / b);
-    res += t;
+    parties.push_back(share.first);
+    signs.push_back(share.second);
   }
-  return res;
+
+  return CombineSignShares(signs, ComputeLagrangeCoefficients(parties));
 }
 
 }  // namespace dkg
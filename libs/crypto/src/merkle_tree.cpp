@@ -19,11 +19,14 @@
 #include "crypto/hash.hpp"
 #include "crypto/merkle_tree.hpp"
 #include "crypto/sha256.hpp"
+#include "crypto/sha256_batch.hpp"
 #include "vectorise/platform.hpp"
 
-#include <cassert>
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
+#include <utility>
+#include <vector>
 
 namespace fetch {
 namespace crypto {
@@ -43,6 +46,9 @@ HashArray &MerkleTree::operator[](std::size_t n)
 
 void MerkleTree::CalculateRoot() const
 {
+  static constexpr std::size_t DIGEST_SIZE  = SHA256Batch::DIGEST_SIZE;
+  static constexpr std::size_t MESSAGE_SIZE = SHA256Batch::MESSAGE_SIZE;
+
   if (leaf_nodes_.empty())
   {
     root_ = Hash<crypto::SHA256>(Digest{});
@@ -55,30 +61,63 @@ void MerkleTree::CalculateRoot() const
     return;
   }
 
-  // make a copy of the leaf nodes which are then condensed
-  std::vector<Digest> hashes = leaf_nodes_;
+  // If necessary bump the 'leaves' up to a power of 2 (with empty digests)
+  std::size_t num_leaves = leaf_nodes_.size();
+  while (!platform::IsLog2(uint64_t(num_leaves)))
+  {
+    ++num_leaves;
+  }
+
+  std::size_t num_nodes = num_leaves / 2;
 
-  // If necessary bump the 'leaves' up to a power of 2
-  while (!platform::IsLog2(uint64_t(hashes.size())))
+  // Calculate the first level of parents. The leaves (or the padding) might not be digest sized
+  // so these are packed into contiguous pairs where possible and otherwise hashed individually
+  std::vector<uint8_t> messages(num_nodes * MESSAGE_SIZE);
+  std::vector<uint8_t> digests(num_nodes * DIGEST_SIZE);
+  std::vector<bool>    irregular(num_nodes, false);
+
+  Digest const empty{};
+  auto const   leaf = [this, &empty](std::size_t index) -> Digest const & {
+    return (index < leaf_nodes_.size()) ? leaf_nodes_[index] : empty;
+  };
+
+  for (std::size_t i = 0; i < num_nodes; ++i)
   {
-    hashes.push_back(Digest{});
+    Digest const &left  = leaf(2 * i);
+    Digest const &right = leaf((2 * i) + 1);
+
+    if ((left.size() == DIGEST_SIZE) && (right.size() == DIGEST_SIZE))
+    {
+      std::memcpy(&messages[i * MESSAGE_SIZE], left.pointer(), DIGEST_SIZE);
+      std::memcpy(&messages[(i * MESSAGE_SIZE) + DIGEST_SIZE], right.pointer(), DIGEST_SIZE);
+    }
+    else
+    {
+      irregular[i] = true;
+    }
   }
 
-  // Now, repeatedly condense the vector by calculating the parents of each of the roots
-  while (hashes.size() > 1)
+  SHA256Batch::Hash64(messages.data(), num_nodes, digests.data());
+
+  for (std::size_t i = 0; i < num_nodes; ++i)
   {
-    for (std::size_t i = 0, j = 0; i < hashes.size(); i += 2, ++j)
+    if (irregular[i])
     {
-      Digest concantenated_hash = hashes[i] + hashes[i + 1];
-      concantenated_hash        = Hash<crypto::SHA256>(concantenated_hash);
-      hashes[j]                 = concantenated_hash;
+      Digest const concatenated = leaf(2 * i) + leaf((2 * i) + 1);
+      Hash<crypto::SHA256>(concatenated.pointer(), concatenated.size(), &digests[i * DIGEST_SIZE]);
     }
+  }
+
+  // Now, repeatedly condense the level by hashing each contiguous pair of digests
+  while (num_nodes > 1)
+  {
+    num_nodes /= 2;
 
-    hashes.resize(hashes.size() / 2);
+    SHA256Batch::Hash64(digests.data(), num_nodes, messages.data());
+    std::swap(digests, messages);
   }
 
-  assert(hashes.size() == 1);
-  root_ = hashes[0];
+  root_ = Digest{digests.data(), DIGEST_SIZE};
 }
 
 }  // namespace crypto
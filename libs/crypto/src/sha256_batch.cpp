@@ -0,0 +1,522 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "crypto/sha256_batch.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+namespace fetch {
+namespace crypto {
+namespace {
+
+constexpr std::size_t NUM_ROUNDS     = 64;
+constexpr std::size_t NUM_WORDS      = 16;
+constexpr std::size_t NUM_STATE      = 8;
+constexpr std::size_t MESSAGE_SIZE   = SHA256Batch::MESSAGE_SIZE;
+constexpr std::size_t DIGEST_SIZE    = SHA256Batch::DIGEST_SIZE;
+constexpr uint32_t    MESSAGE_LENGTH = MESSAGE_SIZE * 8u;  // in bits
+
+constexpr uint32_t IV[NUM_STATE] = {0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+                                    0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19};
+
+constexpr uint32_t K[NUM_ROUNDS] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4,
+    0xab1c5ed5, 0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe,
+    0x9bdc06a7, 0xc19bf174, 0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f,
+    0x4a7484aa, 0x5cb0a9dc, 0x76f988da, 0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7,
+    0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967, 0x27b70a85, 0x2e1b2138, 0x4d2c6dfc,
+    0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85, 0xa2bfe8a1, 0xa81a664b,
+    0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070, 0x19a4c116,
+    0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7,
+    0xc67178f2};
+
+using RoundConstants = std::array<uint32_t, NUM_ROUNDS>;
+
+/**
+ * Every message is exactly one block long, so the second (padding) block is the same for all of
+ * them. Its message schedule is therefore constant and can be folded into the round constants.
+ *
+ * @return The sum of the round constants and the padding block schedule
+ */
+RoundConstants CalculatePaddingConstants()
+{
+  uint32_t w[NUM_ROUNDS] = {0x80000000u};
+  w[NUM_WORDS - 1] = MESSAGE_LENGTH;
+
+  auto const rotr = [](uint32_t x, uint32_t n) { return (x >> n) | (x << (32u - n)); };
+
+  for (std::size_t i = NUM_WORDS; i < NUM_ROUNDS; ++i)
+  {
+    uint32_t const s0 = rotr(w[i - 15], 7) ^ rotr(w[i - 15], 18) ^ (w[i - 15] >> 3u);
+    uint32_t const s1 = rotr(w[i - 2], 17) ^ rotr(w[i - 2], 19) ^ (w[i - 2] >> 10u);
+
+    w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+  }
+
+  RoundConstants constants{};
+  for (std::size_t i = 0; i < NUM_ROUNDS; ++i)
+  {
+    constants[i] = K[i] + w[i];
+  }
+
+  return constants;
+}
+
+RoundConstants const &PaddingConstants()
+{
+  static RoundConstants const constants = CalculatePaddingConstants();
+  return constants;
+}
+
+uint32_t LoadBigEndian(uint8_t const *data)
+{
+  uint32_t value{0};
+  std::memcpy(&value, data, sizeof(value));
+  return __builtin_bswap32(value);
+}
+
+void StoreBigEndian(uint32_t value, uint8_t *data)
+{
+  value = __builtin_bswap32(value);
+  std::memcpy(data, &value, sizeof(value));
+}
+
+/**
+ * Portable single lane operations
+ */
+struct ScalarOps
+{
+  using Word = uint32_t;
+
+  static constexpr std::size_t LANES = 1;
+  static constexpr char const *NAME  = "scalar";
+
+  static Word Add(Word a, Word b)
+  {
+    return a + b;
+  }
+
+  static Word Xor(Word a, Word b)
+  {
+    return a ^ b;
+  }
+
+  static Word And(Word a, Word b)
+  {
+    return a & b;
+  }
+
+  static Word AndNot(Word a, Word b)
+  {
+    return ~a & b;
+  }
+
+  template <int N>
+  static Word Rotr(Word x)
+  {
+    return (x >> N) | (x << (32 - N));
+  }
+
+  template <int N>
+  static Word Shr(Word x)
+  {
+    return x >> N;
+  }
+
+  static Word Broadcast(uint32_t value)
+  {
+    return value;
+  }
+
+  static Word Gather(uint8_t const *messages, std::size_t word)
+  {
+    return LoadBigEndian(messages + (word * 4u));
+  }
+
+  static void Scatter(Word const *state, uint8_t *digests)
+  {
+    for (std::size_t i = 0; i < NUM_STATE; ++i)
+    {
+      StoreBigEndian(state[i], digests + (i * 4u));
+    }
+  }
+};
+
+#if defined(__SSE2__)
+
+/**
+ * Four lane SSE2 operations
+ */
+struct Sse2Ops
+{
+  using Word = __m128i;
+
+  static constexpr std::size_t LANES = 4;
+  static constexpr char const *NAME  = "sse2";
+
+  static Word Add(Word a, Word b)
+  {
+    return _mm_add_epi32(a, b);
+  }
+
+  static Word Xor(Word a, Word b)
+  {
+    return _mm_xor_si128(a, b);
+  }
+
+  static Word And(Word a, Word b)
+  {
+    return _mm_and_si128(a, b);
+  }
+
+  static Word AndNot(Word a, Word b)
+  {
+    return _mm_andnot_si128(a, b);
+  }
+
+  template <int N>
+  static Word Rotr(Word x)
+  {
+    return _mm_or_si128(_mm_srli_epi32(x, N), _mm_slli_epi32(x, 32 - N));
+  }
+
+  template <int N>
+  static Word Shr(Word x)
+  {
+    return _mm_srli_epi32(x, N);
+  }
+
+  static Word Broadcast(uint32_t value)
+  {
+    return _mm_set1_epi32(static_cast<int>(value));
+  }
+
+  static Word Gather(uint8_t const *messages, std::size_t word)
+  {
+    uint8_t const *data = messages + (word * 4u);
+
+    return _mm_set_epi32(static_cast<int>(LoadBigEndian(data + (3u * MESSAGE_SIZE))),
+                         static_cast<int>(LoadBigEndian(data + (2u * MESSAGE_SIZE))),
+                         static_cast<int>(LoadBigEndian(data + MESSAGE_SIZE)),
+                         static_cast<int>(LoadBigEndian(data)));
+  }
+
+  static void Scatter(Word const *state, uint8_t *digests)
+  {
+    uint32_t words[LANES];
+
+    for (std::size_t i = 0; i < NUM_STATE; ++i)
+    {
+      _mm_storeu_si128(reinterpret_cast<__m128i *>(words), state[i]);
+
+      for (std::size_t lane = 0; lane < LANES; ++lane)
+      {
+        StoreBigEndian(words[lane], digests + (lane * DIGEST_SIZE) + (i * 4u));
+      }
+    }
+  }
+};
+
+#endif  // __SSE2__
+
+#if defined(__AVX2__)
+
+/**
+ * Eight lane AVX2 operations
+ */
+struct Avx2Ops
+{
+  using Word = __m256i;
+
+  static constexpr std::size_t LANES = 8;
+  static constexpr char const *NAME  = "avx2";
+
+  static Word Add(Word a, Word b)
+  {
+    return _mm256_add_epi32(a, b);
+  }
+
+  static Word Xor(Word a, Word b)
+  {
+    return _mm256_xor_si256(a, b);
+  }
+
+  static Word And(Word a, Word b)
+  {
+    return _mm256_and_si256(a, b);
+  }
+
+  static Word AndNot(Word a, Word b)
+  {
+    return _mm256_andnot_si256(a, b);
+  }
+
+  template <int N>
+  static Word Rotr(Word x)
+  {
+    return _mm256_or_si256(_mm256_srli_epi32(x, N), _mm256_slli_epi32(x, 32 - N));
+  }
+
+  template <int N>
+  static Word Shr(Word x)
+  {
+    return _mm256_srli_epi32(x, N);
+  }
+
+  static Word Broadcast(uint32_t value)
+  {
+    return _mm256_set1_epi32(static_cast<int>(value));
+  }
+
+  static Word Gather(uint8_t const *messages, std::size_t word)
+  {
+    uint8_t const *data = messages + (word * 4u);
+
+    return _mm256_set_epi32(static_cast<int>(LoadBigEndian(data + (7u * MESSAGE_SIZE))),
+                            static_cast<int>(LoadBigEndian(data + (6u * MESSAGE_SIZE))),
+                            static_cast<int>(LoadBigEndian(data + (5u * MESSAGE_SIZE))),
+                            static_cast<int>(LoadBigEndian(data + (4u * MESSAGE_SIZE))),
+                            static_cast<int>(LoadBigEndian(data + (3u * MESSAGE_SIZE))),
+                            static_cast<int>(LoadBigEndian(data + (2u * MESSAGE_SIZE))),
+                            static_cast<int>(LoadBigEndian(data + MESSAGE_SIZE)),
+                            static_cast<int>(LoadBigEndian(data)));
+  }
+
+  static void Scatter(Word const *state, uint8_t *digests)
+  {
+    uint32_t words[LANES];
+
+    for (std::size_t i = 0; i < NUM_STATE; ++i)
+    {
+      _mm256_storeu_si256(reinterpret_cast<__m256i *>(words), state[i]);
+
+      for (std::size_t lane = 0; lane < LANES; ++lane)
+      {
+        StoreBigEndian(words[lane], digests + (lane * DIGEST_SIZE) + (i * 4u));
+      }
+    }
+  }
+};
+
+using BatchOps = Avx2Ops;
+
+#elif defined(__SSE2__)
+
+using BatchOps = Sse2Ops;
+
+#else
+
+using BatchOps = ScalarOps;
+
+#endif
+
+/**
+ * Run a single SHA256 round
+ *
+ * @param s The working state (a..h)
+ * @param kw The sum of the round constant and the message schedule word
+ */
+template <typename Ops>
+void Round(typename Ops::Word *s, typename Ops::Word const &kw)
+{
+  using Word = typename Ops::Word;
+
+  Word const &a = s[0];
+  Word const &e = s[4];
+
+  Word const sigma1 = Ops::Xor(Ops::Xor(Ops::template Rotr<6>(e), Ops::template Rotr<11>(e)),
+                               Ops::template Rotr<25>(e));
+  Word const ch     = Ops::Xor(Ops::And(e, s[5]), Ops::AndNot(e, s[6]));
+  Word const t1     = Ops::Add(Ops::Add(s[7], sigma1), Ops::Add(ch, kw));
+
+  Word const sigma0 = Ops::Xor(Ops::Xor(Ops::template Rotr<2>(a), Ops::template Rotr<13>(a)),
+                               Ops::template Rotr<22>(a));
+  Word const maj = Ops::Xor(Ops::And(a, Ops::Xor(s[1], s[2])), Ops::And(s[1], s[2]));
+  Word const t2  = Ops::Add(sigma0, maj);
+
+  s[7] = s[6];
+  s[6] = s[5];
+  s[5] = s[4];
+  s[4] = Ops::Add(s[3], t1);
+  s[3] = s[2];
+  s[2] = s[1];
+  s[1] = s[0];
+  s[0] = Ops::Add(t1, t2);
+}
+
+/**
+ * Compress the message block held in the (lane interleaved) schedule into the state
+ *
+ * @param state The hash state to be updated
+ * @param w The first 16 words of the message schedule, used as a rolling window
+ */
+template <typename Ops>
+void Compress(typename Ops::Word *state, typename Ops::Word *w)
+{
+  using Word = typename Ops::Word;
+
+  Word s[NUM_STATE];
+  std::copy(state, state + NUM_STATE, s);
+
+  for (std::size_t i = 0; i < NUM_ROUNDS; ++i)
+  {
+    Word &wi = w[i & 15u];
+
+    if (i >= NUM_WORDS)
+    {
+      Word const &w2  = w[(i - 2u) & 15u];
+      Word const &w15 = w[(i - 15u) & 15u];
+
+      Word const s0 = Ops::Xor(Ops::Xor(Ops::template Rotr<7>(w15), Ops::template Rotr<18>(w15)),
+                               Ops::template Shr<3>(w15));
+      Word const s1 = Ops::Xor(Ops::Xor(Ops::template Rotr<17>(w2), Ops::template Rotr<19>(w2)),
+                               Ops::template Shr<10>(w2));
+
+      wi = Ops::Add(Ops::Add(wi, s0), Ops::Add(w[(i - 7u) & 15u], s1));
+    }
+
+    Round<Ops>(s, Ops::Add(Ops::Broadcast(K[i]), wi));
+  }
+
+  for (std::size_t i = 0; i < NUM_STATE; ++i)
+  {
+    state[i] = Ops::Add(state[i], s[i]);
+  }
+}
+
+/**
+ * Compress the constant padding block into the state
+ *
+ * @param state The hash state to be updated
+ */
+template <typename Ops>
+void CompressPadding(typename Ops::Word *state)
+{
+  using Word = typename Ops::Word;
+
+  RoundConstants const &constants = PaddingConstants();
+
+  Word s[NUM_STATE];
+  std::copy(state, state + NUM_STATE, s);
+
+  for (std::size_t i = 0; i < NUM_ROUNDS; ++i)
+  {
+    Round<Ops>(s, Ops::Broadcast(constants[i]));
+  }
+
+  for (std::size_t i = 0; i < NUM_STATE; ++i)
+  {
+    state[i] = Ops::Add(state[i], s[i]);
+  }
+}
+
+/**
+ * Hash one message per lane. All of the messages are read before any digest is written.
+ *
+ * @param messages The contiguous messages, one per lane
+ * @param digests The output buffer for the digests, one per lane
+ */
+template <typename Ops>
+void HashLanes(uint8_t const *messages, uint8_t *digests)
+{
+  using Word = typename Ops::Word;
+
+  Word w[NUM_WORDS];
+  for (std::size_t i = 0; i < NUM_WORDS; ++i)
+  {
+    w[i] = Ops::Gather(messages, i);
+  }
+
+  Word state[NUM_STATE];
+  for (std::size_t i = 0; i < NUM_STATE; ++i)
+  {
+    state[i] = Ops::Broadcast(IV[i]);
+  }
+
+  Compress<Ops>(state, w);
+  CompressPadding<Ops>(state);
+
+  Ops::Scatter(state, digests);
+}
+
+}  // namespace
+
+constexpr std::size_t SHA256Batch::MESSAGE_SIZE;
+constexpr std::size_t SHA256Batch::DIGEST_SIZE;
+
+/**
+ * Get the number of messages which are hashed in parallel
+ *
+ * @return The number of lanes
+ */
+std::size_t SHA256Batch::NumLanes()
+{
+  return BatchOps::LANES;
+}
+
+/**
+ * Get the name of the implementation selected for the target architecture
+ *
+ * @return The name of the implementation
+ */
+char const *SHA256Batch::Implementation()
+{
+  return BatchOps::NAME;
+}
+
+/**
+ * Hash a batch of 64 byte messages. The digests may be written over the start of the messages
+ * buffer, i.e. a level of a merkle tree can be condensed in place.
+ *
+ * @param messages The contiguous input messages (count * 64 bytes)
+ * @param count The number of messages to be hashed
+ * @param digests The output buffer for the contiguous digests (count * 32 bytes)
+ */
+void SHA256Batch::Hash64(uint8_t const *messages, std::size_t count, uint8_t *digests)
+{
+  static constexpr std::size_t LANES = BatchOps::LANES;
+
+  std::size_t i = 0;
+  for (; (i + LANES) <= count; i += LANES)
+  {
+    HashLanes<BatchOps>(messages + (i * MESSAGE_SIZE), digests + (i * DIGEST_SIZE));
+  }
+
+  // fill the unused lanes of the last group with zeros
+  if (i < count)
+  {
+    std::size_t const remaining = count - i;
+
+    uint8_t input[LANES * MESSAGE_SIZE] = {};
+    uint8_t output[LANES * DIGEST_SIZE];
+
+    std::memcpy(input, messages + (i * MESSAGE_SIZE), remaining * MESSAGE_SIZE);
+    HashLanes<BatchOps>(input, output);
+    std::memcpy(digests + (i * DIGEST_SIZE), output, remaining * DIGEST_SIZE);
+  }
+}
+
+}  // namespace crypto
+}  // namespace fetch
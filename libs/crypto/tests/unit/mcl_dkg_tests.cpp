@@ -0,0 +1,150 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/byte_array/const_byte_array.hpp"
+#include "crypto/mcl_dkg.hpp"
+
+#include "gtest/gtest.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+using fetch::byte_array::ConstByteArray;
+using namespace fetch::dkg;
+
+/**
+ * A cabinet with a shared secret, where every member has signed the same message
+ */
+class MclDkgTests : public ::testing::Test
+{
+protected:
+  static constexpr uint32_t CABINET_SIZE = 20;
+  static constexpr uint32_t THRESHOLD    = 9;
+
+  void SetUp() override
+  {
+    bn::initPairing();
+
+    bn::Fp2 const g(
+        "1380305877306098957770911920312855400078250832364663138573638818396353623780",
+        "14633108267626422569982187812838828838622813723380760182609272619611213638781");
+    bn::mapToG2(group_g_, g);
+
+    std::vector<bn::Fr> coefficients(THRESHOLD + 1);
+    for (auto &coefficient : coefficients)
+    {
+      coefficient.setByCSPRNG();
+    }
+
+    bn::G2::mul(group_public_key_, group_g_, coefficients[0]);
+    group_signature_ = SignShare(message_, coefficients[0]);
+
+    for (uint32_t i = 0; i < CABINET_SIZE; ++i)
+    {
+      bn::Fr share, unused;
+      ComputeShares(share, unused, coefficients, coefficients, i);
+
+      bn::G2 public_key;
+      bn::G2::mul(public_key, group_g_, share);
+
+      public_keys_.push_back(public_key);
+      signs_.push_back(SignShare(message_, share));
+    }
+  }
+
+  ConstByteArray const message_{"beacon round payload"};
+  bn::G2               group_g_;
+  bn::G2               group_public_key_;
+  bn::G1               group_signature_;
+  std::vector<bn::G2>  public_keys_;
+  std::vector<bn::G1>  signs_;
+};
+
+TEST_F(MclDkgTests, CheckBatchVerificationOfValidShares)
+{
+  auto const precomputed = PrecomputePairing(group_g_);
+
+  for (std::size_t i = 0; i < CABINET_SIZE; ++i)
+  {
+    EXPECT_TRUE(VerifySign(public_keys_[i], message_, signs_[i], group_g_));
+    EXPECT_TRUE(VerifySign(public_keys_[i], message_, signs_[i], precomputed));
+  }
+
+  auto const valid = BatchVerifySigns(public_keys_, message_, signs_, precomputed);
+  ASSERT_EQ(valid.size(), std::size_t{CABINET_SIZE});
+  for (bool share_valid : valid)
+  {
+    EXPECT_TRUE(share_valid);
+  }
+
+  EXPECT_TRUE(BatchVerifySigns({}, message_, {}, precomputed).empty());
+}
+
+TEST_F(MclDkgTests, CheckBatchVerificationFindsInvalidShares)
+{
+  auto const precomputed = PrecomputePairing(group_g_);
+
+  // a share signed by someone else and a share of a different message
+  signs_[3]  = signs_[4];
+  signs_[17] = SignShare("another message", bn::Fr{17});
+
+  EXPECT_FALSE(VerifySign(public_keys_[3], message_, signs_[3], precomputed));
+
+  auto const valid = BatchVerifySigns(public_keys_, message_, signs_, precomputed);
+  ASSERT_EQ(valid.size(), std::size_t{CABINET_SIZE});
+  for (std::size_t i = 0; i < CABINET_SIZE; ++i)
+  {
+    EXPECT_EQ(valid[i], (i != 3) && (i != 17)) << "share " << i;
+  }
+}
+
+TEST_F(MclDkgTests, CheckSignatureRecoveryFromAnyQualifiedSubset)
+{
+  auto const precomputed = PrecomputePairing(group_g_);
+
+  LagrangeCoefficientCache cache;
+
+  for (uint32_t offset = 0; offset <= (CABINET_SIZE - THRESHOLD - 1); ++offset)
+  {
+    std::vector<uint32_t>                parties;
+    std::vector<bn::G1>                  signs;
+    std::unordered_map<uint32_t, bn::G1> shares;
+
+    for (uint32_t i = offset; i < offset + THRESHOLD + 1; ++i)
+    {
+      parties.push_back(i);
+      signs.push_back(signs_[i]);
+      shares.emplace(i, signs_[i]);
+    }
+
+    auto const &coefficients = cache.Lookup(parties);
+    EXPECT_EQ(coefficients, ComputeLagrangeCoefficients(parties));
+
+    auto const signature = CombineSignShares(signs, coefficients);
+    EXPECT_EQ(signature, group_signature_);
+    EXPECT_EQ(LagrangeInterpolation(shares), group_signature_);
+  }
+
+  EXPECT_TRUE(VerifySign(group_public_key_, message_, group_signature_, precomputed));
+}
+
+}  // namespace
@@ -0,0 +1,91 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/byte_array/byte_array.hpp"
+#include "core/random/lcg.hpp"
+#include "crypto/hash.hpp"
+#include "crypto/sha256.hpp"
+#include "crypto/sha256_batch.hpp"
+
+#include "gtest/gtest.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace {
+
+using fetch::byte_array::ByteArray;
+using fetch::crypto::Hash;
+using fetch::crypto::SHA256;
+using fetch::crypto::SHA256Batch;
+
+using Rng = fetch::random::LinearCongruentialGenerator;
+
+class SHA256BatchTests : public ::testing::TestWithParam<std::size_t>
+{
+};
+
+TEST_P(SHA256BatchTests, DigestsMatchSHA256)
+{
+  std::size_t const count = GetParam();
+
+  Rng                  rng{};
+  std::vector<uint8_t> messages(count * SHA256Batch::MESSAGE_SIZE);
+  for (auto &byte : messages)
+  {
+    byte = static_cast<uint8_t>(rng());
+  }
+
+  std::vector<uint8_t> digests(count * SHA256Batch::DIGEST_SIZE);
+  SHA256Batch::Hash64(messages.data(), count, digests.data());
+
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    ByteArray message{};
+    message.Resize(SHA256Batch::MESSAGE_SIZE);
+    std::copy(&messages[i * SHA256Batch::MESSAGE_SIZE],
+              &messages[(i + 1) * SHA256Batch::MESSAGE_SIZE], message.pointer());
+
+    ByteArray const digest{&digests[i * SHA256Batch::DIGEST_SIZE], SHA256Batch::DIGEST_SIZE};
+
+    EXPECT_EQ(Hash<SHA256>(message), digest) << "message " << i << " of " << count << " ("
+                                             << SHA256Batch::Implementation() << ")";
+  }
+}
+
+TEST_P(SHA256BatchTests, DigestsCanOverwriteMessages)
+{
+  std::size_t const count = GetParam();
+
+  std::vector<uint8_t> messages(count * SHA256Batch::MESSAGE_SIZE, 0xA5);
+  std::vector<uint8_t> expected(count * SHA256Batch::DIGEST_SIZE);
+  SHA256Batch::Hash64(messages.data(), count, expected.data());
+
+  // hash in place, as used when condensing a level of a merkle tree
+  SHA256Batch::Hash64(messages.data(), count, messages.data());
+
+  messages.resize(expected.size());
+  EXPECT_EQ(expected, messages);
+}
+
+// cover the empty batch, partial lane groups and several full groups for every implementation
+INSTANTIATE_TEST_CASE_P(ParamBased, SHA256BatchTests,
+                        ::testing::Values(0u, 1u, 3u, 4u, 5u, 8u, 9u, 17u, 100u), );
+
+}  // namespace
@@ -215,6 +215,7 @@ private:
   using PrivateKey      = bn::Fr;
   using PublicKey       = bn::G2;
   using PublicKeyList   = std::vector<bn::G2>;
+  using LagrangeCache   = LagrangeCoefficientCache;
 
   struct Submission
   {
@@ -253,8 +254,9 @@ private:
   /// @name State Machine Data
   /// @{
   static bn::G2 group_g_;
-  PrivateKey    aeon_secret_share_;  ///< The current secret share for the aeon
-  PublicKey     aeon_public_key_;    ///< The public key for our secret share
+  PrecomputedG2 group_g_coefficients_;  ///< Pairing precomputation for group_g_
+  PrivateKey    aeon_secret_share_;     ///< The current secret share for the aeon
+  PublicKey     aeon_public_key_;       ///< The public key for our secret share
   CabinetMembers
                 aeon_qual_set_;  ///< The set of muddle addresses which successfully completed the DKG
   PublicKeyList aeon_public_key_shares_;  ///< The public keys for DKG qualified set
@@ -274,6 +276,7 @@ private:
   std::atomic<uint64_t> earliest_completed_round_{0};  ///< The round idx for the next entropy req
   std::atomic<uint64_t> current_round_{0};             ///< The current round being generated
   RoundMap              rounds_{};                     ///< The map of round data
+  LagrangeCache         lagrange_coefficients_{};      ///< Coefficients for the aeon's signers
                                                        /// @}
   std::atomic<bool> is_synced_{false};
 };
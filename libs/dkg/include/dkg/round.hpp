@@ -20,6 +20,7 @@
 #include "core/byte_array/const_byte_array.hpp"
 #include "core/mutex.hpp"
 #include "crypto/fetch_mcl.hpp"
+#include "crypto/mcl_dkg.hpp"
 
 #include <atomic>
 #include <cstddef>
@@ -58,7 +59,7 @@ public:
   uint64_t       GetEntropy() const;
   void           SetSignature(bn::G1 const &sig);
   ConstByteArray GetRoundEntropy() const;
-  void           RecoverSignature();
+  void           RecoverSignature(uint32_t threshold, LagrangeCoefficientCache &coefficients);
 
   // Operators
   Round &operator=(Round const &) = delete;
@@ -26,6 +26,7 @@
 #include "network/muddle/subscription.hpp"
 
 #include <chrono>
+#include <cstddef>
 #include <cstdint>
 
 namespace fetch {
@@ -103,7 +104,8 @@ DkgService::DkgService(Endpoint &endpoint, ConstByteArray address)
              -> void { SendShares(destination, shares); }}
 {
   group_g_.clear();
-  group_g_ = dkg_.group();
+  group_g_              = dkg_.group();
+  group_g_coefficients_ = PrecomputePairing(group_g_);
 
   // RPC server registration
   rpc_proto_ = std::make_unique<DkgRpcProtocol>(*this);
@@ -253,6 +255,10 @@ State DkgService::OnWaitForDkgCompletionState()
     aeon_public_key_.clear();
     dkg_.SetDkgOutput(aeon_public_key_, aeon_secret_share_, aeon_public_key_shares_,
                       aeon_qual_set_);
+
+    // the signer indices now refer to the new cabinet
+    FETCH_LOCK(round_lock_);
+    lagrange_coefficients_.Clear();
     return State::BROADCAST_SIGNATURE;
   }
 }
@@ -297,7 +303,7 @@ State DkgService::OnBroadcastSignatureState()
 
   // Sanity check: verify own signature
 
-  if (!VerifySign(aeon_public_key_shares_[id_], payload, signature, group_g_))
+  if (!VerifySign(aeon_public_key_shares_[id_], payload, signature, group_g_coefficients_))
   {
     FETCH_LOG_ERROR("Node ", id_, " computed bad share for payload ", payload.ToBase64());
     state_machine_->Delay(500ms);
@@ -369,7 +375,11 @@ State DkgService::OnCollectSignaturesState()
 
   bool updates{false};
 
-  // process the pending signature submissions
+  // extract the pending signature submissions for this round, discarding any expired ones
+  SubmissionList      submissions;
+  PublicKeyList       public_keys;
+  std::vector<bn::G1> signatures;
+
   auto it = pending_signatures_.begin();
   while (it != pending_signatures_.end())
   {
@@ -377,20 +387,9 @@ State DkgService::OnCollectSignaturesState()
     {
       if (it->round == this_round)
       {
-        // verify the signature
-        if (!VerifySign(aeon_public_key_shares_[it->id], payload, it->signature, group_g_))
-        {
-          FETCH_LOG_ERROR(LOGGING_NAME, "Node ", id_, " failed to verify signature from node ",
-                          it->id, " for round ", it->round, ". Discarding");
-        }
-        else
-        {
-          // successful verified this signature share - add it to the round
-          FETCH_LOG_INFO(LOGGING_NAME, "Node ", id_, " add share from node ", it->id, " for round ",
-                         it->round);
-          round->AddShare(it->id, it->signature);
-          updates = true;
-        }
+        public_keys.push_back(aeon_public_key_shares_[it->id]);
+        signatures.push_back(it->signature);
+        submissions.push_back(*it);
       }
 
       // this message has expired so we no longer
@@ -403,15 +402,37 @@ State DkgService::OnCollectSignaturesState()
     }
   }
 
+  // verify all of the signature shares together
+  auto const valid = BatchVerifySigns(public_keys, payload, signatures, group_g_coefficients_);
+
+  for (std::size_t i = 0; i < submissions.size(); ++i)
+  {
+    auto const &submission = submissions[i];
+
+    if (!valid[i])
+    {
+      FETCH_LOG_ERROR(LOGGING_NAME, "Node ", id_, " failed to verify signature from node ",
+                      submission.id, " for round ", submission.round, ". Discarding");
+    }
+    else
+    {
+      // successful verified this signature share - add it to the round
+      FETCH_LOG_INFO(LOGGING_NAME, "Node ", id_, " add share from node ", submission.id,
+                     " for round ", submission.round);
+      round->AddShare(submission.id, submission.signature);
+      updates = true;
+    }
+  }
+
   // TODO(HUT): looks like a bug here
   // Step 2. Determine if we have completed any signatures
   if (!round->HasSignature() && round->GetNumShares() >= current_threshold_ + 1)
   {
     // recover the complete signature
-    round->RecoverSignature();
+    round->RecoverSignature(current_threshold_, lagrange_coefficients_);
 
     // verify that the signature is correct
-    if (!VerifySign(aeon_public_key_, payload, round->round_signature(), group_g_))
+    if (!VerifySign(aeon_public_key_, payload, round->round_signature(), group_g_coefficients_))
     {
       FETCH_LOG_CRITICAL(LOGGING_NAME, "Node ", id_,
                          " failed to lookup verify signature for payload ", payload.ToBase64());
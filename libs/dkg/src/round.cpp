@@ -23,8 +23,10 @@
 #include "dkg/round.hpp"
 
 #include <algorithm>
+#include <cstddef>
 #include <cstdint>
 #include <cstring>
+#include <vector>
 
 namespace fetch {
 namespace dkg {
@@ -59,10 +61,36 @@ byte_array::ConstByteArray Round::GetRoundEntropy() const
   return round_entropy_;
 }
 
-void Round::RecoverSignature()
+/**
+ * Recover the group signature from the threshold + 1 lowest indexed shares. Any threshold + 1
+ * valid shares give the same signature, choosing the lowest indices keeps the set of signers (and
+ * so their Lagrange coefficients) stable from round to round.
+ *
+ * @param threshold The threshold of the cabinet
+ * @param coefficients The cabinet's cache of Lagrange coefficients
+ */
+void Round::RecoverSignature(uint32_t threshold, LagrangeCoefficientCache &coefficients)
 {
   FETCH_LOCK(lock_);
-  round_signature_ = LagrangeInterpolation(round_sig_shares_);
+
+  std::vector<uint32_t> parties;
+  parties.reserve(round_sig_shares_.size());
+  for (auto const &share : round_sig_shares_)
+  {
+    parties.push_back(share.first);
+  }
+
+  std::sort(parties.begin(), parties.end());
+  parties.resize(std::min<std::size_t>(parties.size(), std::size_t{threshold} + 1));
+
+  std::vector<bn::G1> signs;
+  signs.reserve(parties.size());
+  for (auto const &party : parties)
+  {
+    signs.push_back(round_sig_shares_.at(party));
+  }
+
+  round_signature_ = CombineSignShares(signs, coefficients.Lookup(parties));
   has_signature_   = true;
   round_entropy_   = crypto::Hash<crypto::SHA256>(round_signature_.getStr());
 }
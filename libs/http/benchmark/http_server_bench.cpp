@@ -0,0 +1,188 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "http/http_client.hpp"
+#include "http/json_response.hpp"
+#include "http/module.hpp"
+#include "http/request.hpp"
+#include "http/response.hpp"
+#include "http/server.hpp"
+#include "http/validators.hpp"
+#include "network/management/network_manager.hpp"
+
+#include "benchmark/benchmark.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+using fetch::http::CreateJsonResponse;
+using fetch::http::HttpClient;
+using fetch::http::HTTPModule;
+using fetch::http::HTTPRequest;
+using fetch::http::HTTPResponse;
+using fetch::http::HTTPServer;
+using fetch::http::Method;
+using fetch::http::Status;
+using fetch::http::ViewParameters;
+using fetch::network::NetworkManager;
+
+namespace {
+
+using Clock     = std::chrono::steady_clock;
+using Durations = std::vector<double>;
+
+constexpr uint16_t    PORT                = 8585;
+constexpr std::size_t NUM_NETWORK_THREADS = 4;
+constexpr std::size_t NUM_FILLER_VIEWS    = 50;
+constexpr auto        SLOW_VIEW_DURATION  = std::chrono::milliseconds{1};
+
+/**
+ * The views of the example server, plus a number of other views so that the route table is of a
+ * similar size to that of a node, and a view which blocks like a slow contract query
+ */
+struct BenchmarkModule : HTTPModule
+{
+  BenchmarkModule()
+  {
+    for (std::size_t i = 0; i < NUM_FILLER_VIEWS; ++i)
+    {
+      Get("/api/filler/" + std::to_string(i) + "/(address=[a-zA-Z0-9]+)", "Filler view",
+          [](ViewParameters const &, HTTPRequest const &) {
+            return CreateJsonResponse("{}", Status::SUCCESS_OK);
+          });
+    }
+
+    Get("/pages", "Gets the pages", [](ViewParameters const &, HTTPRequest const &) {
+      return CreateJsonResponse("{}", Status::SUCCESS_OK);
+    });
+
+    Get("/pages/(id=\\d+)", "Get a specific page",
+        {{"id", "The page id.", fetch::http::validators::StringValue()}},
+        [](ViewParameters const &, HTTPRequest const &) {
+          return CreateJsonResponse(R"({"error": "It's all good!"})", Status::SUCCESS_OK);
+        });
+
+    Get("/slow", "Blocks the handling thread", [](ViewParameters const &, HTTPRequest const &) {
+      std::this_thread::sleep_for(SLOW_VIEW_DURATION);
+      return CreateJsonResponse("{}", Status::SUCCESS_OK);
+    });
+  }
+};
+
+/**
+ * A server which is shared by all the benchmarks (and benchmark threads) and runs until exit
+ */
+struct LocalServer
+{
+  LocalServer()
+  {
+    server.AddModule(module);
+    server.Start(PORT);
+    network_manager.Start();
+
+    // wait for the server to start listening
+    HTTPRequest request;
+    request.SetMethod(Method::GET);
+    request.SetURI("/pages");
+
+    for (;;)
+    {
+      HttpClient   client{"127.0.0.1", PORT};
+      HTTPResponse response;
+
+      if (client.Request(request, response))
+      {
+        break;
+      }
+
+      std::this_thread::sleep_for(std::chrono::milliseconds{10});
+    }
+  }
+
+  NetworkManager  network_manager{"HttpBench", NUM_NETWORK_THREADS};
+  BenchmarkModule module;
+  HTTPServer      server{network_manager};
+};
+
+double Percentile(Durations &durations, double percentile)
+{
+  if (durations.empty())
+  {
+    return 0.0;
+  }
+
+  auto const index =
+      static_cast<std::size_t>(percentile * static_cast<double>(durations.size() - 1));
+  std::nth_element(durations.begin(), durations.begin() + static_cast<std::ptrdiff_t>(index),
+                   durations.end());
+
+  return durations[index];
+}
+
+void RunClient(benchmark::State &state, char const *uri)
+{
+  static LocalServer server{};
+
+  HttpClient  client{"127.0.0.1", PORT};
+  HTTPRequest request;
+  request.SetMethod(Method::GET);
+  request.SetURI(uri);
+
+  Durations   latencies;
+  std::size_t failures{0};
+
+  for (auto _ : state)
+  {
+    HTTPResponse response;
+
+    auto const start = Clock::now();
+    if (!client.Request(request, response))
+    {
+      ++failures;
+    }
+    auto const stop = Clock::now();
+
+    latencies.push_back(std::chrono::duration<double, std::micro>(stop - start).count());
+  }
+
+  // requests/sec is summed and the latencies averaged over the client threads
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+  state.counters["p99_us"] =
+      benchmark::Counter(Percentile(latencies, 0.99), benchmark::Counter::kAvgThreads);
+  state.counters["failures"] = static_cast<double>(failures);
+}
+
+void HttpServer_RouteLookup(benchmark::State &state)
+{
+  RunClient(state, "/pages/12");
+}
+
+void HttpServer_SlowView(benchmark::State &state)
+{
+  RunClient(state, "/slow");
+}
+
+}  // namespace
+
+BENCHMARK(HttpServer_RouteLookup)->ThreadRange(1, 64)->UseRealTime();
+BENCHMARK(HttpServer_SlowView)->ThreadRange(1, 64)->UseRealTime();
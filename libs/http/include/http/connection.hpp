@@ -20,7 +20,6 @@
 #include "core/assert.hpp"
 #include "core/byte_array/byte_array.hpp"
 #include "core/logging.hpp"
-#include "core/mutex.hpp"
 #include "http/abstract_connection.hpp"
 #include "http/http_connection_manager.hpp"
 #include "http/request.hpp"
@@ -42,13 +41,15 @@ public:
   using handle_type         = HTTPConnectionManager::handle_type;
   using shared_request_type = std::shared_ptr<HTTPRequest>;
   using buffer_ptr_type     = std::shared_ptr<asio::streambuf>;
+  using socket_type         = asio::ip::tcp::tcp::socket;
+  using strand_type         = asio::strand<socket_type::executor_type>;
 
   static constexpr char const *LOGGING_NAME = "HTTPConnection";
 
   HTTPConnection(asio::ip::tcp::tcp::socket socket, HTTPConnectionManager &manager)
     : socket_(std::move(socket))
+    , strand_(socket_.get_executor())
     , manager_(manager)
-    , write_mutex_(__LINE__, __FILE__)
   {
     FETCH_LOG_DEBUG(LOGGING_NAME, "HTTP connection from ",
                     socket_.remote_endpoint().address().to_string());
@@ -71,17 +72,30 @@ public:
 
   void Send(HTTPResponse const &response) override
   {
-    bool write_in_progress = false;
-    {
-      FETCH_LOCK(write_mutex_);
-      write_in_progress = !write_queue_.empty();
+    // responses can be sent from any thread, the socket is only ever used from the strand
+    auto self = shared_from_this();
+    asio::post(strand_, [this, self, response]() {
+      bool const write_in_progress = !write_queue_.empty();
       write_queue_.push_back(response);
-    }
 
-    if (!write_in_progress)
-    {
-      Write();
-    }
+      if (!write_in_progress)
+      {
+        Write();
+      }
+
+      // the response to the outstanding request has been queued, so the next pipelined request
+      // can be read without its response overtaking this one
+      if (pending_buffer_)
+      {
+        buffer_ptr_type buffer_ptr = std::move(pending_buffer_);
+        pending_buffer_.reset();
+
+        if (is_open_)
+        {
+          ReadHeader(buffer_ptr);
+        }
+      }
+    });
   }
 
   std::string Address() override
@@ -89,7 +103,7 @@ public:
     return socket_.remote_endpoint().address().to_string();
   }
 
-  asio::ip::tcp::tcp::socket &socket()
+  socket_type &socket()
   {
     return socket_;
   }
@@ -125,14 +139,21 @@ public:
           {
             if (is_open_)
             {
-              ReadBody(buffer_ptr, request);
+              if (request->is_chunked())
+              {
+                ReadChunkHeader(buffer_ptr, request);
+              }
+              else
+              {
+                ReadBody(buffer_ptr, request);
+              }
             }
           }
         }
       }
     };
 
-    asio::async_read_until(socket_, *buffer_ptr, "\r\n\r\n", cb);
+    asio::async_read_until(socket_, *buffer_ptr, "\r\n\r\n", asio::bind_executor(strand_, cb));
   }
 
   void ReadBody(buffer_ptr_type buffer_ptr, shared_request_type request)
@@ -142,44 +163,160 @@ public:
     if (request->content_length() <= buffer_ptr->size())
     {
       request->ParseBody(*buffer_ptr);
+      CompleteRequest(buffer_ptr, request);
+      return;
+    }
+
+    // Reading remaining bits if not all was read.
+    auto self = shared_from_this();
+    auto cb   = [this, buffer_ptr, request, self](std::error_code const &ec, std::size_t len) {
+      FETCH_UNUSED(len);
+
+      FETCH_LOG_DEBUG(LOGGING_NAME, "Read HTTP body cb");
+      if (ec)
+      {
+        this->HandleError(ec, request);
+        return;
+      }
+      else
+      {
+        if (is_open_)
+        {
+          ReadBody(buffer_ptr, request);
+        }
+      }
+    };
+
+    asio::async_read(socket_, *buffer_ptr,
+                     asio::transfer_exactly(request->content_length() - buffer_ptr->size()),
+                     asio::bind_executor(strand_, cb));
+  }
+
+  void ReadChunkHeader(buffer_ptr_type buffer_ptr, shared_request_type request)
+  {
+    FETCH_LOG_DEBUG(LOGGING_NAME, "Read HTTP chunk header");
+
+    auto self = shared_from_this();
+    auto cb   = [this, buffer_ptr, request, self](std::error_code const &ec, std::size_t len) {
+      if (ec)
+      {
+        this->HandleError(ec, request);
+        return;
+      }
+
+      std::size_t chunk_size{0};
+      if (!request->ParseChunkHeader(*buffer_ptr, len, chunk_size))
+      {
+        FETCH_LOG_DEBUG(LOGGING_NAME, "Invalid HTTP chunk header");
+        Close();
+        return;
+      }
 
-      // at this point if the read has been successful populate the remote address information
-      // inside the request
-      auto const &remote_endpoint = socket_.remote_endpoint();
-      request->SetOriginatingAddress(remote_endpoint.address().to_string(), remote_endpoint.port());
+      if (is_open_)
+      {
+        // the last chunk is always empty and is followed by the (optional) trailer
+        if (chunk_size == 0)
+        {
+          ReadChunkTrailer(buffer_ptr, request);
+        }
+        else
+        {
+          ReadChunk(buffer_ptr, request, chunk_size);
+        }
+      }
+    };
+
+    asio::async_read_until(socket_, *buffer_ptr, "\r\n", asio::bind_executor(strand_, cb));
+  }
 
-      // push the request to the main server
-      manager_.PushRequest(handle_, *request);
+  void ReadChunk(buffer_ptr_type buffer_ptr, shared_request_type request, std::size_t chunk_size)
+  {
+    FETCH_LOG_DEBUG(LOGGING_NAME, "Read HTTP chunk");
+
+    // the chunk is followed by a CRLF
+    std::size_t const required = chunk_size + 2;
+
+    // Check if we got all the chunk
+    if (required <= buffer_ptr->size())
+    {
+      if (!request->ParseChunk(*buffer_ptr, chunk_size))
+      {
+        FETCH_LOG_DEBUG(LOGGING_NAME, "Invalid HTTP chunk");
+        Close();
+        return;
+      }
 
       if (is_open_)
       {
-        ReadHeader(buffer_ptr);
+        ReadChunkHeader(buffer_ptr, request);
       }
       return;
     }
 
     // Reading remaining bits if not all was read.
     auto self = shared_from_this();
-    auto cb   = [this, buffer_ptr, request, self](std::error_code const &ec, std::size_t len) {
+    auto cb   = [this, buffer_ptr, request, self, chunk_size](std::error_code const &ec,
+                                                            std::size_t            len) {
       FETCH_UNUSED(len);
 
-      FETCH_LOG_DEBUG(LOGGING_NAME, "Read HTTP body cb");
       if (ec)
       {
         this->HandleError(ec, request);
         return;
       }
-      else
+
+      if (is_open_)
+      {
+        ReadChunk(buffer_ptr, request, chunk_size);
+      }
+    };
+
+    asio::async_read(socket_, *buffer_ptr, asio::transfer_exactly(required - buffer_ptr->size()),
+                     asio::bind_executor(strand_, cb));
+  }
+
+  void ReadChunkTrailer(buffer_ptr_type buffer_ptr, shared_request_type request)
+  {
+    auto self = shared_from_this();
+    auto cb   = [this, buffer_ptr, request, self](std::error_code const &ec, std::size_t len) {
+      if (ec)
+      {
+        this->HandleError(ec, request);
+        return;
+      }
+
+      // trailer fields are not used, the body is complete once the empty line has been read
+      buffer_ptr->consume(len);
+
+      if (len > 2)
       {
         if (is_open_)
         {
-          ReadBody(buffer_ptr, request);
+          ReadChunkTrailer(buffer_ptr, request);
         }
+        return;
       }
+
+      CompleteRequest(buffer_ptr, request);
     };
 
-    asio::async_read(socket_, *buffer_ptr,
-                     asio::transfer_exactly(request->content_length() - buffer_ptr->size()), cb);
+    asio::async_read_until(socket_, *buffer_ptr, "\r\n", asio::bind_executor(strand_, cb));
+  }
+
+  void CompleteRequest(buffer_ptr_type buffer_ptr, shared_request_type request)
+  {
+    // at this point if the read has been successful populate the remote address information
+    // inside the request
+    auto const &remote_endpoint = socket_.remote_endpoint();
+    request->SetOriginatingAddress(remote_endpoint.address().to_string(), remote_endpoint.port());
+
+    // requests are evaluated concurrently by the server, so the next request on this connection
+    // is not read until the response to this one has been queued. This keeps the responses to
+    // pipelined requests in order.
+    pending_buffer_ = std::move(buffer_ptr);
+
+    // push the request to the main server
+    manager_.PushRequest(handle_, *request);
   }
 
   void HandleError(std::error_code const &ec, shared_request_type /*req*/)
@@ -195,24 +332,16 @@ public:
   {
     buffer_ptr_type buffer_ptr =
         std::make_shared<asio::streambuf>(std::numeric_limits<std::size_t>::max());
-    {
-      FETCH_LOCK(write_mutex_);
-      HTTPResponse res = write_queue_.front();
-      write_queue_.pop_front();
-      res.ToStream(*buffer_ptr);
-    }
+    write_queue_.front().ToStream(*buffer_ptr);
 
     auto self = shared_from_this();
     auto cb   = [this, self, buffer_ptr](std::error_code ec, std::size_t) {
+      // the response is only removed once written so that concurrent sends are queued behind it
+      write_queue_.pop_front();
+
       if (!ec)
       {
-        bool write_more = false;
-        {
-          FETCH_LOCK(write_mutex_);
-          write_more = !write_queue_.empty();
-        }
-
-        if (is_open_ && write_more)
+        if (is_open_ && !write_queue_.empty())
         {
           Write();
         }
@@ -223,7 +352,7 @@ public:
       }
     };
 
-    asio::async_write(socket_, *buffer_ptr, cb);
+    asio::async_write(socket_, *buffer_ptr, asio::bind_executor(strand_, cb));
   }
 
   void Close()
@@ -233,10 +362,11 @@ public:
   }
 
 private:
-  asio::ip::tcp::tcp::socket socket_;
-  HTTPConnectionManager &    manager_;
-  response_queue_type        write_queue_;
-  Mutex                      write_mutex_;
+  socket_type            socket_;
+  strand_type            strand_;  ///< Serialises all operations on the socket
+  HTTPConnectionManager &manager_;
+  response_queue_type    write_queue_;     ///< Only accessed from the strand
+  buffer_ptr_type        pending_buffer_;  ///< Read buffer held while a request is outstanding
 
   handle_type handle_;
   bool        is_open_ = false;
@@ -44,13 +44,20 @@ public:
   using Timepoint       = Clock::time_point;
   using Duration        = Clock::duration;
 
-  static constexpr char const *LOGGING_NAME = "HTTPRequest";
+  static constexpr char const *LOGGING_NAME          = "HTTPRequest";
+  static constexpr std::size_t DEFAULT_MAX_BODY_SIZE = 64u << 20u;  // 64MB
 
   HTTPRequest() = default;
 
   bool ParseBody(asio::streambuf &buffer);
   bool ParseHeader(asio::streambuf &buffer, std::size_t end);
 
+  /// @name Chunked Transfer Encoding
+  /// @{
+  bool ParseChunkHeader(asio::streambuf &buffer, std::size_t end, std::size_t &chunk_size);
+  bool ParseChunk(asio::streambuf &buffer, std::size_t chunk_size);
+  /// @}
+
   Method const &method() const
   {
     return method_;
@@ -91,6 +98,27 @@ public:
     return content_length_;
   }
 
+  bool is_chunked() const
+  {
+    return is_chunked_;
+  }
+
+  std::size_t max_body_size() const
+  {
+    return max_body_size_;
+  }
+
+  /**
+   * Set the limit on the size of a chunked body. Since the size of a chunked body is not known
+   * up front the request is rejected as soon as its chunks exceed the limit.
+   *
+   * @param max_body_size The maximum size of the body in bytes
+   */
+  void SetMaxBodySize(std::size_t max_body_size)
+  {
+    max_body_size_ = max_body_size;
+  }
+
   byte_array::ConstByteArray body() const
   {
     return body_data_;
@@ -193,6 +221,8 @@ private:
   bool is_valid_ = true;
 
   std::size_t content_length_ = 0;
+  bool        is_chunked_     = false;
+  std::size_t max_body_size_  = DEFAULT_MAX_BODY_SIZE;
 
   /// @name Metadata
   /// @{
@@ -23,8 +23,12 @@
 #include "http/validators.hpp"
 #include "http/view_parameters.hpp"
 
-#include <functional>
+#include <cstddef>
+#include <memory>
 #include <regex>
+#include <string>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 namespace fetch {
@@ -36,23 +40,46 @@ class Route
 {
 public:
   static constexpr char const *LOGGING_NAME = "HttpRoute";
-  using MatchFunction =
-      std::function<bool(std::size_t &, byte_array::ByteArray const &, ViewParameters &)>;
-  using MatchingVector = std::vector<MatchFunction>;
-  using ParameterList  = std::vector<byte_array::ConstByteArray>;
-  using ValidatorMap   = std::unordered_map<byte_array::ConstByteArray, validators::Validator>;
 
-  bool Match(byte_array::ConstByteArray const &path, ViewParameters &params)
+  /**
+   * A section of the route, either literal text or a named parameter described by a regex
+   */
+  struct Segment
+  {
+    using RegexPtr = std::shared_ptr<std::regex const>;
+
+    bool                       is_parameter{false};
+    byte_array::ConstByteArray text;     ///< The literal text or the name of the parameter
+    std::string                pattern;  ///< The regex pattern of the parameter
+    RegexPtr                   regex;
+
+    bool Match(byte_array::ConstByteArray const &path, std::size_t offset,
+               std::size_t &length) const;
+  };
+
+  using SegmentList   = std::vector<Segment>;
+  using ParameterList = std::vector<byte_array::ConstByteArray>;
+  using ValidatorMap  = std::unordered_map<byte_array::ConstByteArray, validators::Validator>;
+
+  bool Match(byte_array::ConstByteArray const &path, ViewParameters &params) const
   {
     std::size_t i = 0;
     params.Clear();
 
-    for (auto &m : match_)
+    for (auto const &segment : segments_)
     {
-      if (!m(i, path, params))
+      std::size_t length{0};
+      if (!segment.Match(path, i, length))
       {
         return false;
       }
+
+      if (segment.is_parameter)
+      {
+        params[segment.text] = path.SubArray(i, length);
+      }
+
+      i += length;
       // TODO(issue 1371): Add validators
     }
 
@@ -142,17 +169,18 @@ public:
     return it->second.description;
   }
 
+  SegmentList const &segments() const
+  {
+    return segments_;
+  }
+
 private:
   void AddMatch(byte_array::ByteArray const &value)
   {
-    match_.push_back([value](std::size_t &i, byte_array::ByteArray const &path, ViewParameters &) {
-      bool ret = path.Match(value, i);
-      if (ret)
-      {
-        i += value.size();
-      }
-      return ret;
-    });
+    Segment segment;
+    segment.text = value;
+
+    segments_.push_back(std::move(segment));
   }
 
   byte_array::ByteArray AddParameter(byte_array::ByteArray const &value)
@@ -170,40 +198,56 @@ private:
     byte_array::ByteArray var = value.SubArray(0, i);
     ++i;
 
-    std::string reg = "^" + std::string(value.SubArray(i, value.size() - i));
-
-    std::regex rgx(reg);
-    match_.push_back(
-        [rgx, var](std::size_t &i, byte_array::ByteArray const &path, ViewParameters &params) {
-          std::string s = std::string(path.SubArray(i));
-          std::smatch matches;
-          bool        ret = std::regex_search(s, matches, rgx);
+    Segment segment;
+    segment.is_parameter = true;
+    segment.text         = var;
+    segment.pattern      = "^" + std::string(value.SubArray(i, value.size() - i));
+    segment.regex        = std::make_shared<std::regex const>(segment.pattern);
 
-          if (ret)
-          {
-            if (matches.size() != 1)
-            {
-              // Ambiguous matches are treated as non-matches.
-              return false;
-            }
-
-            std::string m = matches[0];
-
-            params[var] = path.SubArray(i, m.size());
-
-            i += m.size();
-          }
-
-          return ret;
-        });
+    segments_.push_back(std::move(segment));
     return var;
   }
 
   byte_array::ByteArray original_;
   byte_array::ByteArray path_;
-  MatchingVector        match_;
+  SegmentList           segments_;
   ParameterList         path_parameters_;
   ValidatorMap          validators_;
 };
+
+/**
+ * Determine the length of the section of the path (starting at the offset) matched by the segment
+ *
+ * @param path The path being matched
+ * @param offset The offset into the path at which the segment starts
+ * @param length The length of the match (output)
+ * @return true if the segment matches, otherwise false
+ */
+inline bool Route::Segment::Match(byte_array::ConstByteArray const &path, std::size_t offset,
+                                  std::size_t &length) const
+{
+  if (!is_parameter)
+  {
+    length = text.size();
+    return path.Match(text, offset);
+  }
+
+  std::string const s = std::string(path.SubArray(offset));
+  std::smatch       matches;
+
+  if (!std::regex_search(s, matches, *regex))
+  {
+    return false;
+  }
+
+  // Ambiguous matches are treated as non-matches.
+  if (matches.size() != 1)
+  {
+    return false;
+  }
+
+  length = static_cast<std::size_t>(matches[0].length());
+  return true;
+}
 }  // namespace http
 }  // namespace fetch
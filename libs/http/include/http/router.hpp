@@ -0,0 +1,111 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+
+#include "core/byte_array/const_byte_array.hpp"
+#include "http/method.hpp"
+#include "http/route.hpp"
+#include "http/view_parameters.hpp"
+
+#include <cstddef>
+#include <limits>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace fetch {
+namespace http {
+
+/**
+ * Dispatches request paths to views using a radix (compressed prefix) tree per method.
+ *
+ * The literal text of each route is merged into the tree so that a lookup only visits the
+ * branches which share a prefix with the requested path. Parameter segments are edges which are
+ * tested with their regex. When more than one route matches a path the route that was added
+ * first is selected, the same result as testing each route in turn.
+ */
+class Router
+{
+public:
+  using Index = std::size_t;
+
+  static constexpr Index INVALID_INDEX = std::numeric_limits<Index>::max();
+
+  // Construction / Destruction
+  Router()                   = default;
+  Router(Router const &)     = delete;
+  Router(Router &&) noexcept = default;
+  ~Router()                  = default;
+
+  /// @name Routing
+  /// @{
+  void Add(Method method, Route const &route, Index index);
+  bool Match(Method method, byte_array::ConstByteArray const &path, ViewParameters &params,
+             Index &index) const;
+  /// @}
+
+  // Operators
+  Router &operator=(Router const &) = delete;
+  Router &operator=(Router &&) noexcept = default;
+
+private:
+  struct Node;
+
+  using NodePtr   = std::unique_ptr<Node>;
+  using Parameter = std::pair<byte_array::ConstByteArray, byte_array::ConstByteArray>;
+
+  struct LiteralEdge
+  {
+    byte_array::ConstByteArray label;
+    NodePtr                    child;
+  };
+
+  struct ParameterEdge
+  {
+    Route::Segment segment;
+    NodePtr        child;
+  };
+
+  struct Node
+  {
+    std::vector<LiteralEdge>   literals;    ///< Children keyed by (a distinct) first character
+    std::vector<ParameterEdge> parameters;  ///< Children matched by regex, in insertion order
+    Index                      view{INVALID_INDEX};    ///< The route ending at this node
+    Index                      lowest{INVALID_INDEX};  ///< The first route in this subtree
+  };
+
+  struct Search
+  {
+    byte_array::ConstByteArray const &path;
+    std::vector<Parameter>            stack;
+    std::vector<Parameter>            best_params;
+    Index                             best{INVALID_INDEX};
+  };
+
+  static Node &InsertLiteral(Node &node, byte_array::ConstByteArray const &text, Index index);
+  static Node &InsertParameter(Node &node, Route::Segment const &segment, Index index);
+  static void  Visit(Node const &node, std::size_t offset, Search &search);
+
+  std::map<Method, Node> roots_;
+};
+
+}  // namespace http
+}  // namespace fetch
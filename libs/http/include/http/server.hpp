@@ -28,10 +28,13 @@
 #include "http/request.hpp"
 #include "http/response.hpp"
 #include "http/route.hpp"
+#include "http/router.hpp"
 #include "http/status.hpp"
 #include "network/fetch_asio.hpp"
+#include "network/details/thread_pool.hpp"
 #include "network/management/network_manager.hpp"
 
+#include <cstddef>
 #include <cstdint>
 #include <deque>
 #include <functional>
@@ -60,7 +63,8 @@ public:
   using Authenticator      = typename HTTPModule::Authenticator;
   using ResponseMiddleware = std::function<void(HTTPResponse &, HTTPRequest const &)>;
 
-  static constexpr char const *LOGGING_NAME = "HTTPServer";
+  static constexpr char const *LOGGING_NAME        = "HTTPServer";
+  static constexpr std::size_t DEFAULT_NUM_WORKERS = 4;
 
   struct MountedView
   {
@@ -71,12 +75,16 @@ public:
     Authenticator              authenticator;
   };
 
-  explicit HTTPServer(NetworkManager const &network_manager)
+  explicit HTTPServer(NetworkManager const &network_manager,
+                      std::size_t           num_workers = DEFAULT_NUM_WORKERS)
     : networkManager_(network_manager)
+    , workers_{network::MakeThreadPool(num_workers, "HTTP")}
   {}
 
   virtual ~HTTPServer()
   {
+    workers_->Stop();
+
     auto socketWeak = socket_;
     auto accepWeak  = acceptor_;
 
@@ -121,10 +129,14 @@ public:
       FETCH_LOG_DEBUG(LOGGING_NAME, "Starting HTTPServer Accept");
       HTTPServer::Accept(soc, accep, manager);
     });
+
+    workers_->Start();
   }
 
   void Stop()
-  {}
+  {
+    workers_->Stop();
+  }
 
   void PushRequest(handle_type client, HTTPRequest req) override
   {
@@ -143,75 +155,9 @@ public:
       return;
     }
 
-    // TODO(issue 28): improve such that it works for multiple threads.
-    FETCH_LOCK(eval_mutex_);
-    HTTPResponse res("page not found", mime_types::GetMimeTypeFromExtension(".html"),
-                     Status::CLIENT_ERROR_NOT_FOUND);
-
-    // Ensure that the HTTP server remains operational
-    // even if exceptions are thrown
-    try
-    {
-      // applying pre-process middleware
-      for (auto &m : pre_view_middleware_)
-      {
-        m(req);
-      }
-
-      // finding the view that matches the URL
-      ViewParameters params;
-      for (auto &v : views_)
-      {
-        // skip all views that don't match the required method
-        if (v.method != req.method())
-        {
-          continue;
-        }
-
-        if (v.route.Match(req.uri(), params))
-        {
-          // checking that the correct level of authentication is present
-          if (!v.authenticator(req))
-          {
-            res = HTTPResponse("authentication required",
-                               fetch::http::mime_types::GetMimeTypeFromExtension(".html"),
-                               Status::SERVER_ERROR_NETWORK_AUTHENTICATION_REQUIRED);
-            manager_->Send(client, res);
-            return;
-          }
-
-          // generating result
-          res = v.view(params, req);
-          break;
-        }
-      }
-
-      // signal that the request has been processed
-      req.SetProcessed();
-
-      for (auto &m : post_view_middleware_)
-      {
-        m(res, req);
-      }
-    }
-    catch (std::exception const &e)
-    {
-      HTTPResponse res("internal error: " + std::string(e.what()),
-                       fetch::http::mime_types::GetMimeTypeFromExtension(".html"),
-                       Status::SERVER_ERROR_INTERNAL_SERVER_ERROR);
-      manager_->Send(client, res);
-      return;
-    }
-    catch (...)
-    {
-      HTTPResponse res("unknown internal error",
-                       fetch::http::mime_types::GetMimeTypeFromExtension(".html"),
-                       Status::SERVER_ERROR_INTERNAL_SERVER_ERROR);
-      manager_->Send(client, res);
-      return;
-    }
-
-    manager_->Send(client, res);
+    // requests are evaluated concurrently on the worker pool, each connection only has one
+    // request outstanding at a time so its responses are sent in order
+    workers_->Post([this, client, req]() mutable { Evaluate(client, std::move(req)); });
   }
 
   // Accept static void to avoid having to create shared ptr to this class
@@ -242,12 +188,16 @@ public:
 
   void AddMiddleware(RequestMiddleware const &middleware)
   {
-    pre_view_middleware_.push_back(middleware);
+    Reconfigure([&middleware](Configuration &config) {
+      config.pre_view_middleware.push_back(middleware);
+    });
   }
 
   void AddMiddleware(ResponseMiddleware const &middleware)
   {
-    post_view_middleware_.push_back(middleware);
+    Reconfigure([&middleware](Configuration &config) {
+      config.post_view_middleware.push_back(middleware);
+    });
   }
 
   void AddView(byte_array::ConstByteArray description, Method method,
@@ -263,7 +213,10 @@ public:
       route.AddValidator(param.name, std::move(v));
     }
 
-    views_.push_back({std::move(description), method, std::move(route), view, authenticator});
+    Reconfigure([&](Configuration &config) {
+      config.views.push_back(
+          {std::move(description), method, std::move(route), view, std::move(authenticator)});
+    });
   }
 
   void AddModule(HTTPModule const &module)
@@ -277,27 +230,127 @@ public:
 
   std::vector<MountedView> views()
   {
-    FETCH_LOCK(eval_mutex_);
-    return views_;
+    return std::atomic_load(&config_)->views;
   }
 
   std::vector<MountedView> views_unsafe()
   {
-    return views_;
+    return views();
   }
 
 private:
-  std::mutex eval_mutex_;
+  /**
+   * The middleware and views of the server. Requests are evaluated against an immutable snapshot
+   * which is replaced whenever the server is reconfigured, so evaluation does not need a lock.
+   */
+  struct Configuration
+  {
+    std::vector<RequestMiddleware>  pre_view_middleware;
+    std::vector<MountedView>        views;
+    Router                          router;
+    std::vector<ResponseMiddleware> post_view_middleware;
+  };
+
+  using ConfigurationPtr = std::shared_ptr<Configuration const>;
+
+  void Evaluate(handle_type client, HTTPRequest req)
+  {
+    auto const config = std::atomic_load(&config_);
+
+    HTTPResponse res("page not found", mime_types::GetMimeTypeFromExtension(".html"),
+                     Status::CLIENT_ERROR_NOT_FOUND);
+
+    // Ensure that the HTTP server remains operational
+    // even if exceptions are thrown
+    try
+    {
+      // applying pre-process middleware
+      for (auto const &m : config->pre_view_middleware)
+      {
+        m(req);
+      }
+
+      // finding the view that matches the URL
+      ViewParameters params;
+      Router::Index  index{Router::INVALID_INDEX};
+      if (config->router.Match(req.method(), req.uri(), params, index))
+      {
+        auto const &v = config->views[index];
+
+        // checking that the correct level of authentication is present
+        if (!v.authenticator(req))
+        {
+          res = HTTPResponse("authentication required",
+                             fetch::http::mime_types::GetMimeTypeFromExtension(".html"),
+                             Status::SERVER_ERROR_NETWORK_AUTHENTICATION_REQUIRED);
+          manager_->Send(client, res);
+          return;
+        }
+
+        // generating result
+        res = v.view(params, req);
+      }
+
+      // signal that the request has been processed
+      req.SetProcessed();
+
+      for (auto const &m : config->post_view_middleware)
+      {
+        m(res, req);
+      }
+    }
+    catch (std::exception const &e)
+    {
+      HTTPResponse res("internal error: " + std::string(e.what()),
+                       fetch::http::mime_types::GetMimeTypeFromExtension(".html"),
+                       Status::SERVER_ERROR_INTERNAL_SERVER_ERROR);
+      manager_->Send(client, res);
+      return;
+    }
+    catch (...)
+    {
+      HTTPResponse res("unknown internal error",
+                       fetch::http::mime_types::GetMimeTypeFromExtension(".html"),
+                       Status::SERVER_ERROR_INTERNAL_SERVER_ERROR);
+      manager_->Send(client, res);
+      return;
+    }
+
+    manager_->Send(client, res);
+  }
+
+  template <typename Modifier>
+  void Reconfigure(Modifier &&modifier)
+  {
+    FETCH_LOCK(config_mutex_);
+
+    auto const current = std::atomic_load(&config_);
+    auto       next    = std::make_shared<Configuration>();
+
+    next->pre_view_middleware  = current->pre_view_middleware;
+    next->views                = current->views;
+    next->post_view_middleware = current->post_view_middleware;
+
+    modifier(*next);
+
+    // the routes are compiled in registration order so that the earliest matching view is used
+    for (std::size_t i = 0; i < next->views.size(); ++i)
+    {
+      next->router.Add(next->views[i].method, next->views[i].route, i);
+    }
+
+    std::atomic_store(&config_, ConfigurationPtr{std::move(next)});
+  }
 
-  std::vector<RequestMiddleware>  pre_view_middleware_;
-  std::vector<MountedView>        views_;
-  std::vector<ResponseMiddleware> post_view_middleware_;
+  std::mutex       config_mutex_;  ///< Serialises reconfiguration
+  ConfigurationPtr config_{std::make_shared<Configuration>()};
 
   NetworkManager                     networkManager_;
   std::deque<HTTPRequest>            requests_;
   std::weak_ptr<Acceptor>            acceptor_;
   std::weak_ptr<Socket>              socket_;
   std::shared_ptr<ConnectionManager> manager_{std::make_shared<ConnectionManager>(*this)};
+  network::ThreadPool                workers_;
 };
 }  // namespace http
 }  // namespace fetch
@@ -56,24 +56,27 @@ void HTTPConnectionManager::Leave(handle_type handle)
 
 bool HTTPConnectionManager::Send(handle_type client, HTTPResponse const &res)
 {
-  bool ret = true;
-  clients_mutex_.lock();
+  connection_type connection;
 
-  if (clients_.find(client) != clients_.end())
-  {
-    auto c = clients_[client];
-    clients_mutex_.unlock();
-    c->Send(res);
-    FETCH_LOG_DEBUG(LOGGING_NAME, "Client manager did send message to ", client);
-    clients_mutex_.lock();
-  }
-  else
   {
-    FETCH_LOG_DEBUG(LOGGING_NAME, "Client not found.");
-    ret = false;
+    FETCH_LOCK(clients_mutex_);
+
+    auto const it = clients_.find(client);
+    if (it == clients_.end())
+    {
+      FETCH_LOG_DEBUG(LOGGING_NAME, "Client not found.");
+      return false;
+    }
+
+    connection = it->second;
   }
-  clients_mutex_.unlock();
-  return ret;
+
+  // the lock must not be held here, if this is the last reference to the connection its
+  // destruction will leave the manager
+  connection->Send(res);
+  FETCH_LOG_DEBUG(LOGGING_NAME, "Client manager did send message to ", client);
+
+  return true;
 }
 
 void HTTPConnectionManager::PushRequest(handle_type client, HTTPRequest const &req)
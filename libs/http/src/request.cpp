@@ -17,14 +17,18 @@
 //------------------------------------------------------------------------------
 
 #include "core/assert.hpp"
+#include "core/string/ends_with.hpp"
 #include "http/request.hpp"
 
 #include <algorithm>
 #include <iostream>
+#include <string>
 
 namespace fetch {
 namespace http {
 
+constexpr std::size_t HTTPRequest::DEFAULT_MAX_BODY_SIZE;
+
 bool HTTPRequest::ParseBody(asio::streambuf &buffer)
 {
   // TODO(issue 35): Handle encoding
@@ -125,6 +129,13 @@ bool HTTPRequest::ParseHeader(asio::streambuf &buffer, std::size_t end)
             content_length_ = uint64_t(value.AsInt());
           }
 
+          // special case: the body is sent as a series of chunks (always the final encoding)
+          if ((key == "transfer-encoding") &&
+              core::EndsWith(static_cast<std::string>(value), "chunked"))
+          {
+            is_chunked_ = true;
+          }
+
           // TODO(issue 413): Compliance to HTTP Standard - `value` can be structured.
           if (key == "content-type")
           {
@@ -160,6 +171,122 @@ bool HTTPRequest::ParseHeader(asio::streambuf &buffer, std::size_t end)
   return success;
 }
 
+/**
+ * Parse the size line which precedes each chunk of a chunked body
+ *
+ * @param buffer The input buffer
+ * @param end The length of the size line, including the trailing CRLF
+ * @param chunk_size The output size of the chunk that follows
+ * @return true if successful, otherwise false
+ */
+bool HTTPRequest::ParseChunkHeader(asio::streambuf &buffer, std::size_t end,
+                                   std::size_t &chunk_size)
+{
+  static constexpr std::size_t MAX_SIZE_DIGITS = 2 * sizeof(uint32_t);
+
+  if (buffer.size() < end)
+  {
+    is_valid_ = false;
+    return false;
+  }
+
+  std::string line(end, '\0');
+  buffer.sgetn(&line[0], static_cast<std::streamsize>(end));
+
+  // the chunk size is hex encoded and can be followed by extensions which are ignored
+  chunk_size = 0;
+
+  std::size_t num_digits{0};
+  for (char c : line)
+  {
+    uint8_t digit{0};
+    if (('0' <= c) && (c <= '9'))
+    {
+      digit = static_cast<uint8_t>(c - '0');
+    }
+    else if (('a' <= c) && (c <= 'f'))
+    {
+      digit = static_cast<uint8_t>(c - 'a' + 10);
+    }
+    else if (('A' <= c) && (c <= 'F'))
+    {
+      digit = static_cast<uint8_t>(c - 'A' + 10);
+    }
+    else
+    {
+      break;
+    }
+
+    chunk_size = (chunk_size << 4u) | digit;
+    ++num_digits;
+  }
+
+  if ((num_digits == 0) || (num_digits > MAX_SIZE_DIGITS))
+  {
+    is_valid_ = false;
+    return false;
+  }
+
+  // reject the request before the chunk is read if it would take the body over the limit
+  if (chunk_size > (max_body_size_ - std::min(body_data_.size(), max_body_size_)))
+  {
+    FETCH_LOG_WARN(LOGGING_NAME, "Rejecting chunked body larger than ", max_body_size_,
+                   " bytes");
+    is_valid_ = false;
+    return false;
+  }
+
+  return true;
+}
+
+/**
+ * Append the next chunk of a chunked body. The buffer must contain the whole of the chunk and the
+ * CRLF which terminates it.
+ *
+ * @param buffer The input buffer
+ * @param chunk_size The size of the chunk as given by its size line
+ * @return true if successful, otherwise false
+ */
+bool HTTPRequest::ParseChunk(asio::streambuf &buffer, std::size_t chunk_size)
+{
+  if ((buffer.size() < (chunk_size + 2)) ||
+      (chunk_size > (max_body_size_ - std::min(body_data_.size(), max_body_size_))))
+  {
+    is_valid_ = false;
+    return false;
+  }
+
+  if (chunk_size > 0)
+  {
+    std::size_t const offset   = body_data_.size();
+    std::size_t const required = offset + chunk_size;
+
+    // grow geometrically so that a body made up of many small chunks is not copied repeatedly
+    if (required > body_data_.capacity())
+    {
+      body_data_.Reserve(std::max(required, 2 * body_data_.capacity()), ResizeParadigm::ABSOLUTE,
+                         false);
+    }
+
+    body_data_.Resize(required);
+    buffer.sgetn(body_data_.char_pointer() + offset, static_cast<std::streamsize>(chunk_size));
+  }
+
+  // every chunk is terminated with a CRLF
+  char terminator[2] = {0};
+  buffer.sgetn(terminator, 2);
+
+  if ((terminator[0] != '\r') || (terminator[1] != '\n'))
+  {
+    is_valid_ = false;
+    return false;
+  }
+
+  content_length_ = body_data_.size();
+
+  return true;
+}
+
 bool HTTPRequest::ToStream(asio::streambuf &buffer, std::string const &host, uint16_t port) const
 {
   static char const *NEW_LINE = "\r\n";
@@ -0,0 +1,229 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "http/router.hpp"
+
+#include <algorithm>
+
+namespace fetch {
+namespace http {
+
+constexpr Router::Index Router::INVALID_INDEX;
+
+/**
+ * Add a route to the router
+ *
+ * @param method The method of the route
+ * @param route The route to be added
+ * @param index The index of the view, routes with lower indices take precedence
+ */
+void Router::Add(Method method, Route const &route, Index index)
+{
+  Node *node = &roots_[method];
+  node->lowest = std::min(node->lowest, index);
+
+  for (auto const &segment : route.segments())
+  {
+    if (segment.is_parameter)
+    {
+      node = &InsertParameter(*node, segment, index);
+    }
+    else
+    {
+      node = &InsertLiteral(*node, segment.text, index);
+    }
+  }
+
+  node->view = std::min(node->view, index);
+}
+
+/**
+ * Find the view which should handle the specified path
+ *
+ * @param method The method of the request
+ * @param path The path of the request
+ * @param params The parameters extracted from the path (output)
+ * @param index The index of the matched view (output)
+ * @return true if a route matches, otherwise false
+ */
+bool Router::Match(Method method, byte_array::ConstByteArray const &path, ViewParameters &params,
+                   Index &index) const
+{
+  auto const it = roots_.find(method);
+  if (it == roots_.end())
+  {
+    return false;
+  }
+
+  Search search{path, {}, {}, INVALID_INDEX};
+  Visit(it->second, 0, search);
+
+  if (search.best == INVALID_INDEX)
+  {
+    return false;
+  }
+
+  params.Clear();
+  for (auto const &param : search.best_params)
+  {
+    params[param.first] = param.second;
+  }
+
+  index = search.best;
+  return true;
+}
+
+/**
+ * Internal: Merge literal text into the tree, splitting edges where they partially overlap
+ *
+ * @param node The node to insert the text from
+ * @param text The text to be inserted
+ * @param index The index of the route being added
+ * @return The node at the end of the text
+ */
+Router::Node &Router::InsertLiteral(Node &node, byte_array::ConstByteArray const &text,
+                                    Index index)
+{
+  Node *      current = &node;
+  std::size_t offset  = 0;
+
+  while (offset < text.size())
+  {
+    auto it = std::find_if(current->literals.begin(), current->literals.end(),
+                           [&](LiteralEdge const &edge) { return edge.label[0] == text[offset]; });
+
+    if (it == current->literals.end())
+    {
+      auto child    = std::make_unique<Node>();
+      child->lowest = index;
+
+      Node *next = child.get();
+      current->literals.push_back({text.SubArray(offset), std::move(child)});
+
+      return *next;
+    }
+
+    // determine the length of the common prefix
+    byte_array::ConstByteArray const &label  = it->label;
+    std::size_t                       common = 1;
+    while ((common < label.size()) && ((offset + common) < text.size()) &&
+           (label[common] == text[offset + common]))
+    {
+      ++common;
+    }
+
+    if (common < label.size())
+    {
+      auto split    = std::make_unique<Node>();
+      split->lowest = it->child->lowest;
+      split->literals.push_back({label.SubArray(common), std::move(it->child)});
+
+      it->label = label.SubArray(0, common);
+      it->child = std::move(split);
+    }
+
+    current         = it->child.get();
+    current->lowest = std::min(current->lowest, index);
+    offset += common;
+  }
+
+  return *current;
+}
+
+/**
+ * Internal: Add a parameter edge to the tree, sharing an existing edge if it is identical
+ *
+ * @param node The node to insert the parameter from
+ * @param segment The parameter segment
+ * @param index The index of the route being added
+ * @return The node at the end of the parameter
+ */
+Router::Node &Router::InsertParameter(Node &node, Route::Segment const &segment, Index index)
+{
+  auto it = std::find_if(node.parameters.begin(), node.parameters.end(),
+                         [&segment](ParameterEdge const &edge) {
+                           return (edge.segment.text == segment.text) &&
+                                  (edge.segment.pattern == segment.pattern);
+                         });
+
+  if (it == node.parameters.end())
+  {
+    node.parameters.push_back({segment, std::make_unique<Node>()});
+    it = std::prev(node.parameters.end());
+  }
+
+  Node &child  = *it->child;
+  child.lowest = std::min(child.lowest, index);
+
+  return child;
+}
+
+/**
+ * Internal: Depth first search for the lowest index route matching the remainder of the path
+ *
+ * @param node The current node
+ * @param offset The offset into the path that has been matched so far
+ * @param search The search state
+ */
+void Router::Visit(Node const &node, std::size_t offset, Search &search)
+{
+  // no route in this subtree could improve on the current match
+  if (node.lowest >= search.best)
+  {
+    return;
+  }
+
+  auto const &path = search.path;
+
+  if ((offset == path.size()) && (node.view < search.best))
+  {
+    search.best        = node.view;
+    search.best_params = search.stack;
+  }
+
+  // literal edges start with distinct characters so at most one needs to be followed
+  if (offset < path.size())
+  {
+    for (auto const &edge : node.literals)
+    {
+      if (edge.label[0] == path[offset])
+      {
+        if (path.Match(edge.label, offset))
+        {
+          Visit(*edge.child, offset + edge.label.size(), search);
+        }
+
+        break;
+      }
+    }
+  }
+
+  for (auto const &edge : node.parameters)
+  {
+    std::size_t length{0};
+    if (edge.segment.Match(path, offset, length))
+    {
+      search.stack.emplace_back(edge.segment.text, path.SubArray(offset, length));
+      Visit(*edge.child, offset + length, search);
+      search.stack.pop_back();
+    }
+  }
+}
+
+}  // namespace http
+}  // namespace fetch
@@ -20,6 +20,10 @@
 
 #include "gmock/gmock.h"
 
+#include <cstddef>
+#include <cstring>
+#include <ostream>
+
 namespace {
 
 using namespace ::testing;
@@ -40,4 +44,71 @@ TEST_F(RequestTests, no_error_when_reading_zero_bytes_from_empty_buffer)
   ASSERT_NO_THROW(req.ParseHeader(buffer, BYTES_REQUESTED));
 }
 
+TEST_F(RequestTests, parses_chunked_body)
+{
+  static char const *HEADER =
+      "POST /api/contract/submit HTTP/1.1\r\n"
+      "Transfer-Encoding: chunked\r\n"
+      "\r\n";
+
+  asio::streambuf buffer;
+  std::ostream    stream(&buffer);
+  stream << HEADER << "5\r\nhello\r\n" << "7;ext=1\r\n, world\r\n" << "0\r\n\r\n";
+
+  Request req;
+  ASSERT_TRUE(req.ParseHeader(buffer, std::strlen(HEADER)));
+  EXPECT_TRUE(req.is_chunked());
+
+  std::size_t const chunk_lines[] = {3, 9};
+  std::size_t const chunk_sizes[] = {5, 7};
+  for (std::size_t i = 0; i < 2; ++i)
+  {
+    std::size_t chunk_size{0};
+    ASSERT_TRUE(req.ParseChunkHeader(buffer, chunk_lines[i], chunk_size));
+    EXPECT_EQ(chunk_sizes[i], chunk_size);
+    ASSERT_TRUE(req.ParseChunk(buffer, chunk_size));
+  }
+
+  // the last chunk is empty
+  std::size_t chunk_size{1};
+  ASSERT_TRUE(req.ParseChunkHeader(buffer, 3, chunk_size));
+  EXPECT_EQ(0, chunk_size);
+
+  EXPECT_EQ(req.body(), "hello, world");
+  EXPECT_EQ(12, req.content_length());
+}
+
+TEST_F(RequestTests, rejects_invalid_chunks)
+{
+  asio::streambuf buffer;
+  std::ostream    stream(&buffer);
+  stream << "zz\r\n" << "3\r\nabcXX";
+
+  Request     req;
+  std::size_t chunk_size{0};
+  EXPECT_FALSE(req.ParseChunkHeader(buffer, 4, chunk_size));
+  ASSERT_TRUE(req.ParseChunkHeader(buffer, 3, chunk_size));
+  EXPECT_FALSE(req.ParseChunk(buffer, chunk_size));
+  EXPECT_FALSE(req.is_valid());
+}
+
+TEST_F(RequestTests, rejects_chunked_body_over_the_size_limit)
+{
+  asio::streambuf buffer;
+  std::ostream    stream(&buffer);
+  stream << "5\r\nhello\r\n" << "6\r\n, worl";
+
+  Request req;
+  req.SetMaxBodySize(8);
+
+  std::size_t chunk_size{0};
+  ASSERT_TRUE(req.ParseChunkHeader(buffer, 3, chunk_size));
+  ASSERT_TRUE(req.ParseChunk(buffer, chunk_size));
+
+  // the second chunk is rejected from its size line, before any of it has been read
+  EXPECT_FALSE(req.ParseChunkHeader(buffer, 3, chunk_size));
+  EXPECT_FALSE(req.is_valid());
+  EXPECT_EQ(req.body(), "hello");
+}
+
 }  // namespace
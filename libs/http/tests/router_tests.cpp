@@ -0,0 +1,174 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/byte_array/const_byte_array.hpp"
+#include "http/method.hpp"
+#include "http/route.hpp"
+#include "http/router.hpp"
+#include "http/view_parameters.hpp"
+
+#include "gtest/gtest.h"
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace {
+
+using fetch::byte_array::ConstByteArray;
+using fetch::http::Method;
+using fetch::http::Route;
+using fetch::http::Router;
+using fetch::http::ViewParameters;
+
+class RouterTests : public ::testing::Test
+{
+protected:
+  void Add(Method method, char const *path)
+  {
+    routes_.emplace_back(method, Route::FromString(path));
+    router_.Add(method, routes_.back().second, routes_.size() - 1);
+  }
+
+  /**
+   * Find the first route which matches the path by testing each route in turn
+   */
+  bool ReferenceMatch(Method method, ConstByteArray const &path, ViewParameters &params,
+                      std::size_t &index) const
+  {
+    for (std::size_t i = 0; i < routes_.size(); ++i)
+    {
+      if ((routes_[i].first == method) && routes_[i].second.Match(path, params))
+      {
+        index = i;
+        return true;
+      }
+    }
+
+    return false;
+  }
+
+  void ExpectSameAsReference(Method method, ConstByteArray const &path)
+  {
+    ViewParameters expected_params;
+    std::size_t    expected_index{Router::INVALID_INDEX};
+    bool const     expected = ReferenceMatch(method, path, expected_params, expected_index);
+
+    ViewParameters params;
+    std::size_t    index{Router::INVALID_INDEX};
+    ASSERT_EQ(expected, router_.Match(method, path, params, index)) << path;
+
+    if (expected)
+    {
+      EXPECT_EQ(expected_index, index) << path;
+
+      for (auto const &param : expected_params)
+      {
+        EXPECT_EQ(param.second, params[param.first]) << path;
+      }
+    }
+  }
+
+  std::vector<std::pair<Method, Route>> routes_;
+  Router                                router_;
+};
+
+TEST_F(RouterTests, MatchesLiteralRoutes)
+{
+  Add(Method::GET, "/api/status");
+  Add(Method::GET, "/api/status/chain");
+  Add(Method::GET, "/api/state");
+
+  ViewParameters params;
+  std::size_t    index{Router::INVALID_INDEX};
+
+  ASSERT_TRUE(router_.Match(Method::GET, "/api/status", params, index));
+  EXPECT_EQ(0u, index);
+  ASSERT_TRUE(router_.Match(Method::GET, "/api/status/chain", params, index));
+  EXPECT_EQ(1u, index);
+  ASSERT_TRUE(router_.Match(Method::GET, "/api/state", params, index));
+  EXPECT_EQ(2u, index);
+
+  EXPECT_FALSE(router_.Match(Method::GET, "/api/stat", params, index));
+  EXPECT_FALSE(router_.Match(Method::GET, "/api/status/", params, index));
+  EXPECT_FALSE(router_.Match(Method::POST, "/api/status", params, index));
+}
+
+TEST_F(RouterTests, ExtractsParameters)
+{
+  Add(Method::GET, "/api/contract/(digest=[a-fA-F0-9]{64})/(identity=[a-zA-Z0-9+]+)/query");
+
+  ConstByteArray const digest{std::string(64, 'a')};
+
+  ViewParameters params;
+  std::size_t    index{Router::INVALID_INDEX};
+  ASSERT_TRUE(
+      router_.Match(Method::GET, "/api/contract/" + digest + "/abc+def/query", params, index));
+
+  EXPECT_EQ(0u, index);
+  EXPECT_EQ(digest, params["digest"]);
+  EXPECT_EQ(ConstByteArray{"abc+def"}, params["identity"]);
+}
+
+TEST_F(RouterTests, FirstAddedRouteTakesPrecedence)
+{
+  Add(Method::GET, "/pages/(id=[a-z0-9]+)");
+  Add(Method::GET, "/pages/latest");
+  Add(Method::POST, "/pages/latest");
+
+  ViewParameters params;
+  std::size_t    index{Router::INVALID_INDEX};
+
+  ASSERT_TRUE(router_.Match(Method::GET, "/pages/latest", params, index));
+  EXPECT_EQ(0u, index);
+  EXPECT_EQ(ConstByteArray{"latest"}, params["id"]);
+
+  ASSERT_TRUE(router_.Match(Method::POST, "/pages/latest", params, index));
+  EXPECT_EQ(2u, index);
+}
+
+TEST_F(RouterTests, MatchesTheSameRoutesAsLinearSearch)
+{
+  Add(Method::GET, "/");
+  Add(Method::GET, "/api/status");
+  Add(Method::GET, "/api/status/muddle");
+  Add(Method::POST, "/api/contract/submit");
+  Add(Method::POST, "/api/contract/(name=[a-z]+)/(action=[a-z_]+)");
+  Add(Method::POST, "/api/contract/fetch/token/transfer");
+  Add(Method::GET, "/api/tx/(digest=[a-f0-9]+)");
+  Add(Method::GET, "/api/tx/(digest=[a-f0-9]+)/status");
+  Add(Method::GET, "/api/(section=[a-z]+)/info");
+  Add(Method::GET, "/pages/(id=\\d+)");
+  Add(Method::GET, "/pages/(id=\\d+)(suffix=[a-z]*)");
+  Add(Method::GET, "/api/status");
+
+  for (auto const method : {Method::GET, Method::POST, Method::PUT})
+  {
+    for (auto const path :
+         {"", "/", "/api", "/api/status", "/api/status/", "/api/status/muddle",
+          "/api/contract/submit", "/api/contract/fetch/token/transfer", "/api/contract/foo/bar",
+          "/api/contract/foo/bar/baz", "/api/tx/abc123", "/api/tx/abc123/status",
+          "/api/tx/xyz/status", "/api/tx/info", "/api/status/info", "/pages/42", "/pages/42abc",
+          "/pages/", "/pages/x"})
+    {
+      ExpectSameAsReference(method, path);
+    }
+  }
+}
+
+}  // namespace
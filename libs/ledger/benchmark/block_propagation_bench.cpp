@@ -0,0 +1,300 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/bitvector.hpp"
+#include "core/byte_array/byte_array.hpp"
+#include "core/random/lcg.hpp"
+#include "core/serializers/counter.hpp"
+#include "core/serializers/main_serializer.hpp"
+#include "crypto/ecdsa.hpp"
+#include "ledger/chain/block.hpp"
+#include "ledger/chain/compact_block.hpp"
+#include "ledger/chain/main_chain.hpp"
+#include "ledger/chain/recent_transaction_index.hpp"
+#include "ledger/chain/transaction_layout.hpp"
+#include "ledger/protocols/main_chain_rpc_service.hpp"
+#include "ledger/testing/block_generator.hpp"
+#include "network/management/network_manager.hpp"
+#include "network/muddle/muddle.hpp"
+#include "network/p2pservice/p2ptrust_bayrank.hpp"
+#include "network/uri.hpp"
+
+#include "benchmark/benchmark.h"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using fetch::BitVector;
+using fetch::byte_array::ByteArray;
+using fetch::crypto::ECDSASigner;
+using fetch::ledger::CompactBlock;
+using fetch::ledger::MainChain;
+using fetch::ledger::MainChainRpcService;
+using fetch::ledger::RecentTransactionIndex;
+using fetch::ledger::TransactionLayout;
+using fetch::ledger::testing::BlockGenerator;
+using fetch::muddle::Muddle;
+using fetch::muddle::NetworkId;
+using fetch::network::NetworkManager;
+using fetch::network::Peer;
+using fetch::network::Uri;
+using fetch::random::LinearCongruentialGenerator;
+using fetch::serializers::SizeCounter;
+
+using BlockPtr    = BlockGenerator::BlockPtr;
+using Clock       = std::chrono::steady_clock;
+using Mode        = MainChainRpcService::Mode;
+using TrustSystem = fetch::p2p::P2PTrustBayRank<Muddle::Address>;
+using ServicePtr  = std::shared_ptr<MainChainRpcService>;
+using IndexPtr    = std::shared_ptr<RecentTransactionIndex>;
+using Layouts     = std::vector<TransactionLayout>;
+
+constexpr uint16_t BASE_PORT      = 9700;
+constexpr uint32_t LOG2_NUM_LANES = 0;
+constexpr uint32_t NUM_LANES      = 1u << LOG2_NUM_LANES;
+constexpr uint32_t NUM_SLICES     = 16;
+
+/**
+ * Generate a set of transaction layouts with random digests
+ */
+Layouts GenerateLayouts(std::size_t count)
+{
+  static LinearCongruentialGenerator rng;
+
+  Layouts layouts{};
+  layouts.reserve(count);
+
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    ByteArray digest;
+    digest.Resize(32);
+
+    for (std::size_t j = 0; j < digest.size(); j += sizeof(uint64_t))
+    {
+      auto const value = rng();
+      for (std::size_t k = 0; k < sizeof(uint64_t); ++k)
+      {
+        digest[j + k] = static_cast<uint8_t>(value >> (8u * k));
+      }
+    }
+
+    BitVector mask{NUM_LANES};
+    mask.set(0, 1);
+
+    layouts.emplace_back(digest, mask, 1, 0, 1000);
+  }
+
+  return layouts;
+}
+
+/**
+ * Build the next block of the chain, packing the transactions evenly over the slices
+ */
+BlockPtr GenerateBlock(BlockGenerator &generator, BlockPtr const &previous,
+                       Layouts const &layouts)
+{
+  auto block = generator(previous);
+
+  for (std::size_t i = 0; i < layouts.size(); ++i)
+  {
+    block->body.slices[i % NUM_SLICES].push_back(layouts[i]);
+  }
+
+  // the target is low so only a few attempts are needed to satisfy the proof
+  do
+  {
+    ++block->nonce;
+    block->UpdateDigest();
+    block->proof.SetTarget(std::size_t{0});
+  } while (!block->proof());
+
+  return block;
+}
+
+/**
+ * A minimal node, with a main chain which receives blocks over a local muddle network
+ */
+class Node
+{
+public:
+  Node(NetworkManager const &network_manager, uint16_t port, Muddle::UriList const &peers,
+       bool compact)
+    : recent_txs_{compact ? std::make_shared<RecentTransactionIndex>(LOG2_NUM_LANES) : nullptr}
+    , muddle_{NetworkId{"PROP"}, std::make_shared<ECDSASigner>(), network_manager}
+    , service_{std::make_shared<MainChainRpcService>(muddle_.AsEndpoint(), chain_, trust_,
+                                                     Mode::PRIVATE_NETWORK, recent_txs_, compact)}
+  {
+    muddle_.Start({port}, peers);
+  }
+
+  ~Node()
+  {
+    muddle_.Stop();
+  }
+
+  void WaitForPeers(std::size_t num_peers)
+  {
+    while (muddle_.AsEndpoint().GetDirectlyConnectedPeers().size() < num_peers)
+    {
+      std::this_thread::sleep_for(std::chrono::milliseconds{10});
+    }
+  }
+
+  MainChain &chain()
+  {
+    return chain_;
+  }
+
+  RecentTransactionIndex *recent_txs()
+  {
+    return recent_txs_.get();
+  }
+
+  MainChainRpcService &service()
+  {
+    return *service_;
+  }
+
+private:
+  MainChain   chain_{false, MainChain::Mode::IN_MEMORY_DB};
+  TrustSystem trust_{};
+  IndexPtr    recent_txs_;
+  Muddle      muddle_;
+  ServicePtr  service_;
+};
+
+using NodePtr  = std::unique_ptr<Node>;
+using NodeList = std::vector<NodePtr>;
+
+/**
+ * Measure the time taken for a newly mined block to reach every node of a local network. The
+ * nodes are connected in a line so that the block is relayed over several hops. When compact
+ * relay is enabled the nodes have already seen the specified percentage of the transactions.
+ */
+void Block_Propagation(benchmark::State &state)
+{
+  static uint16_t next_port{BASE_PORT};
+
+  bool const compact       = state.range(0) != 0;
+  auto const num_nodes     = static_cast<std::size_t>(state.range(1));
+  auto const num_txs       = static_cast<std::size_t>(state.range(2));
+  auto const known_percent = static_cast<std::size_t>(state.range(3));
+  auto const num_known     = (num_txs * known_percent) / 100;
+
+  NetworkManager network_manager{"block_propagation_bench", 4};
+  network_manager.Start();
+
+  // build the line of nodes, the first node being the miner
+  NodeList nodes{};
+  for (std::size_t i = 0; i < num_nodes; ++i)
+  {
+    uint16_t const  port = next_port++;
+    Muddle::UriList peers{};
+
+    if (i > 0)
+    {
+      peers.emplace_back(Uri{Peer{"127.0.0.1", static_cast<uint16_t>(port - 1)}});
+    }
+
+    nodes.emplace_back(std::make_unique<Node>(network_manager, port, peers, compact));
+  }
+
+  for (std::size_t i = 1; i < num_nodes; ++i)
+  {
+    nodes[i]->WaitForPeers(1);
+  }
+
+  BlockGenerator generator{NUM_LANES, NUM_SLICES};
+  BlockPtr       tip = generator();
+  std::size_t    block_bytes{0};
+
+  for (auto _ : state)
+  {
+    auto const layouts = GenerateLayouts(num_txs);
+    tip                = GenerateBlock(generator, tip, layouts);
+
+    // the transactions which have already been synchronised to the other nodes
+    for (std::size_t i = 1; compact && (i < num_nodes); ++i)
+    {
+      for (std::size_t j = 0; j < num_known; ++j)
+      {
+        nodes[i]->recent_txs()->Add(layouts[j]);
+      }
+    }
+
+    nodes[0]->chain().AddBlock(*tip);
+
+    // the size of the message relayed between each of the nodes
+    SizeCounter counter;
+    if (compact)
+    {
+      counter << CompactBlock{*tip};
+    }
+    else
+    {
+      counter << *tip;
+    }
+    block_bytes += counter.size();
+
+    auto const start = Clock::now();
+    nodes[0]->service().BroadcastBlock(*tip);
+
+    for (auto const &node : nodes)
+    {
+      while (!node->chain().GetBlock(tip->body.hash))
+      {
+        std::this_thread::sleep_for(std::chrono::microseconds{100});
+      }
+    }
+
+    auto const elapsed = std::chrono::duration<double>(Clock::now() - start);
+    state.SetIterationTime(elapsed.count());
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(2));
+  state.counters["block_bytes"] =
+      benchmark::Counter(static_cast<double>(block_bytes), benchmark::Counter::kAvgIterations);
+
+  nodes.clear();
+  network_manager.Stop();
+}
+
+void CreateRanges(benchmark::internal::Benchmark *b)
+{
+  for (int num_txs : {1000, 10000})
+  {
+    // full block relay
+    b->Args({0, 4, num_txs, 0});
+
+    // compact block relay with varying numbers of missing transactions
+    for (int known_percent : {100, 90, 0})
+    {
+      b->Args({1, 4, num_txs, known_percent});
+    }
+  }
+}
+
+}  // namespace
+
+BENCHMARK(Block_Propagation)->Apply(CreateRanges)->UseManualTime()->Unit(benchmark::kMillisecond);
@@ -0,0 +1,190 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/bitvector.hpp"
+#include "core/byte_array/byte_array.hpp"
+#include "core/macros.hpp"
+#include "core/random/lcg.hpp"
+#include "in_memory_storage.hpp"
+#include "ledger/chain/block.hpp"
+#include "ledger/chain/transaction_layout.hpp"
+#include "ledger/execution_manager.hpp"
+#include "ledger/executor_interface.hpp"
+
+#include "benchmark/benchmark.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using fetch::BitVector;
+using fetch::byte_array::ByteArray;
+using fetch::ledger::Address;
+using fetch::ledger::Block;
+using fetch::ledger::Digest;
+using fetch::ledger::ExecutionManager;
+using fetch::ledger::ExecutorInterface;
+using fetch::ledger::TransactionLayout;
+
+using Clock = std::chrono::steady_clock;
+using Rng   = fetch::random::LinearCongruentialGenerator;
+
+constexpr uint32_t    LOG2_NUM_LANES   = 4;
+constexpr std::size_t NUM_LANES        = 1u << LOG2_NUM_LANES;
+constexpr std::size_t NUM_SLICES       = 16;
+constexpr uint64_t    LIGHT_TX_COST_US = 10;
+constexpr uint64_t    HEAVY_TX_COST_US = 1000;
+
+/**
+ * Executor which simulates the execution cost of a transaction by spinning. Whether a transaction
+ * is light or heavy is encoded in the first byte of its digest.
+ */
+class SpinningExecutor : public ExecutorInterface
+{
+public:
+  Result Execute(Digest const &digest, BlockIndex block, SliceIndex slice,
+                 BitVector const &shards) override
+  {
+    FETCH_UNUSED(block);
+    FETCH_UNUSED(slice);
+    FETCH_UNUSED(shards);
+
+    auto const cost_us  = (digest[0] != 0) ? LIGHT_TX_COST_US : HEAVY_TX_COST_US;
+    auto const deadline = Clock::now() + std::chrono::microseconds{cost_us};
+    while (Clock::now() < deadline)
+    {
+      // spin
+    }
+
+    return {Status::SUCCESS};
+  }
+
+  void SettleFees(Address const &miner, TokenAmount amount, uint32_t log2_num_lanes) override
+  {
+    FETCH_UNUSED(miner);
+    FETCH_UNUSED(amount);
+    FETCH_UNUSED(log2_num_lanes);
+  }
+};
+
+/**
+ * Generate a block in which each slice is fully packed with transactions touching 1 or 2 (randomly
+ * selected) lanes
+ *
+ * @param heavy_percentage The percentage of the transactions which are expensive to execute
+ * @return The generated block
+ */
+Block::Body GenerateBlock(uint64_t heavy_percentage)
+{
+  Rng rng{};
+
+  Block::Body body{};
+  body.block_number = 1;
+  body.slices.resize(NUM_SLICES);
+
+  std::vector<std::size_t> lanes(NUM_LANES);
+  std::iota(lanes.begin(), lanes.end(), 0);
+
+  for (auto &slice : body.slices)
+  {
+    std::shuffle(lanes.begin(), lanes.end(), rng);
+
+    std::size_t lane = 0;
+    while (lane < NUM_LANES)
+    {
+      std::size_t const num_lanes = std::min<std::size_t>(1u + (rng() & 1u), NUM_LANES - lane);
+
+      BitVector mask{NUM_LANES};
+      for (std::size_t i = 0; i < num_lanes; ++i)
+      {
+        mask.set(lanes[lane + i], 1);
+      }
+      lane += num_lanes;
+
+      ByteArray digest{};
+      digest.Resize(32);
+      for (std::size_t i = 0; i < digest.size(); ++i)
+      {
+        digest[i] = static_cast<uint8_t>(rng());
+      }
+
+      // encode the cost of the transaction in the first byte
+      digest[0] = static_cast<uint8_t>(((rng() % 100u) < heavy_percentage) ? 0 : 1);
+
+      slice.emplace_back(TransactionLayout{digest, mask, 1u, 0u, 100u});
+    }
+  }
+
+  return body;
+}
+
+void ExecutionManager_ExecuteBlock(benchmark::State &state)
+{
+  auto const num_executors    = static_cast<std::size_t>(state.range(0));
+  auto const heavy_percentage = static_cast<uint64_t>(state.range(1));
+
+  auto const block   = GenerateBlock(heavy_percentage);
+  auto       storage = std::make_shared<InMemoryStorageUnit>();
+  auto       manager = std::make_shared<ExecutionManager>(
+      num_executors, LOG2_NUM_LANES, storage,
+      []() { return std::make_shared<SpinningExecutor>(); }, nullptr);
+
+  manager->Start();
+
+  for (auto _ : state)
+  {
+    if (manager->Execute(block) != ExecutionManager::ScheduleStatus::SCHEDULED)
+    {
+      state.SkipWithError("Unable to schedule block execution");
+      break;
+    }
+
+    // wait for the block execution to complete
+    while (manager->GetState() != ExecutionManager::State::IDLE)
+    {
+      std::this_thread::yield();
+    }
+  }
+
+  manager->Stop();
+
+  state.counters["blocks/s"] = benchmark::Counter(static_cast<double>(state.iterations()),
+                                                  benchmark::Counter::kIsRate);
+}
+
+void CreateRanges(benchmark::internal::Benchmark *b)
+{
+  for (int executors : {1, 4, 16, 64})
+  {
+    for (int heavy_percentage : {0, 1, 5, 20})
+    {
+      b->Args({executors, heavy_percentage});
+    }
+  }
+}
+
+}  // namespace
+
+BENCHMARK(ExecutionManager_ExecuteBlock)->Apply(CreateRanges)->UseRealTime();
@@ -16,19 +16,31 @@
 //
 //------------------------------------------------------------------------------
 
+#include "core/bitvector.hpp"
 #include "core/bloom_filter.hpp"
+#include "core/byte_array/byte_array.hpp"
+#include "core/random/lcg.hpp"
+#include "ledger/chain/block.hpp"
 #include "ledger/chain/main_chain.hpp"
+#include "ledger/chain/transaction_layout.hpp"
 #include "ledger/testing/block_generator.hpp"
 
 #include "benchmark/benchmark.h"
 
 #include <cstddef>
+#include <cstdint>
+#include <cstring>
 #include <memory>
 #include <vector>
 
 namespace {
 
+using fetch::BitVector;
+using fetch::byte_array::ByteArray;
+using fetch::ledger::Digest;
+using fetch::ledger::DigestSet;
 using fetch::ledger::MainChain;
+using fetch::ledger::TransactionLayout;
 using fetch::ledger::testing::BlockGenerator;
 
 using MainChainPtr = std::unique_ptr<MainChain>;
@@ -127,9 +139,129 @@ void MainChain_Persistent_AddBlocksOutOfOrder(benchmark::State &state)
   }
 }
 
+Digest CreateDigest(uint64_t index)
+{
+  ByteArray digest{};
+  digest.Resize(32);
+  std::memset(digest.pointer(), 0, digest.size());
+
+  // the leading bytes are used for hashing so encode the index at the start of the digest
+  for (std::size_t i = 0; i < sizeof(index); ++i)
+  {
+    digest[i] = static_cast<uint8_t>(index >> (i << 3u));
+  }
+
+  return {digest};
+}
+
+/**
+ * A (large) linear chain in which every block contains a small number of transactions. Since the
+ * chain is expensive to build it is shared between all the duplicate detection benchmarks, the
+ * different chain depths being measured by starting the search from the block at that height.
+ */
+struct TransactionChain
+{
+  static constexpr std::size_t NUM_LANES      = 1;
+  static constexpr std::size_t NUM_SLICES     = 2;
+  static constexpr uint64_t    MAX_DEPTH      = 1000000;
+  static constexpr uint64_t    TXS_PER_SLICE  = 1;
+  static constexpr uint64_t    TXS_PER_BLOCK  = NUM_SLICES * TXS_PER_SLICE;
+  static constexpr std::size_t NUM_CANDIDATES = 100;
+
+  TransactionChain()
+  {
+    BitVector mask{NUM_LANES};
+    mask.SetAllOne();
+
+    BlockGenerator gen{NUM_LANES, NUM_SLICES};
+
+    blocks.reserve(MAX_DEPTH + 1);
+    blocks.emplace_back(gen.Generate());
+
+    uint64_t tx_index{0};
+    for (uint64_t i = 1; i <= MAX_DEPTH; ++i)
+    {
+      auto block = gen.Generate(blocks.back());
+
+      for (auto &slice : block->body.slices)
+      {
+        for (uint64_t j = 0; j < TXS_PER_SLICE; ++j)
+        {
+          slice.push_back(TransactionLayout{CreateDigest(tx_index++), mask, 1u, 0u, MAX_DEPTH});
+        }
+      }
+
+      block->UpdateDigest();
+      chain.AddBlock(*block);
+
+      blocks.emplace_back(std::move(block));
+    }
+  }
+
+  /**
+   * Build the set of digests to check at a given depth: half of which are transactions included
+   * in the chain (spread throughout its history) and the other half previously unseen.
+   */
+  DigestSet Candidates(uint64_t depth) const
+  {
+    fetch::random::LinearCongruentialGenerator rng;
+
+    uint64_t const total_txs = depth * TXS_PER_BLOCK;
+
+    DigestSet candidates{};
+    while (candidates.size() < NUM_CANDIDATES / 2)
+    {
+      candidates.insert(CreateDigest(rng() % total_txs));
+    }
+
+    uint64_t unseen_index = MAX_DEPTH * TXS_PER_BLOCK;
+    while (candidates.size() < NUM_CANDIDATES)
+    {
+      candidates.insert(CreateDigest(unseen_index++));
+    }
+
+    return candidates;
+  }
+
+  MainChain  chain{false, MainChain::Mode::IN_MEMORY_DB};
+  BlockArray blocks;
+};
+
+TransactionChain const &GetTransactionChain()
+{
+  static TransactionChain const instance{};
+  return instance;
+}
+
+void MainChain_DetectDuplicateTransactions(benchmark::State &state)
+{
+  auto const &fixture = GetTransactionChain();
+  auto const  depth   = static_cast<uint64_t>(state.range(0));
+
+  auto const &starting_hash = fixture.blocks[depth]->body.hash;
+  auto const  candidates    = fixture.Candidates(depth);
+
+  std::size_t num_duplicates{0};
+  for (auto _ : state)
+  {
+    auto const duplicates = fixture.chain.DetectDuplicateTransactions(starting_hash, candidates);
+    num_duplicates        = duplicates.size();
+
+    benchmark::DoNotOptimize(duplicates);
+  }
+
+  state.counters["duplicates"] = static_cast<double>(num_duplicates);
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(candidates.size()));
+}
+
 }  // namespace
 
 BENCHMARK(MainChain_InMemory_AddBlocksSequentially);
 BENCHMARK(MainChain_Persistent_AddBlocksSequentially);
 BENCHMARK(MainChain_InMemory_AddBlocksOutOfOrder);
 BENCHMARK(MainChain_Persistent_AddBlocksOutOfOrder);
+BENCHMARK(MainChain_DetectDuplicateTransactions)
+    ->Arg(10000)
+    ->Arg(100000)
+    ->Arg(1000000)
+    ->Unit(benchmark::kMicrosecond);
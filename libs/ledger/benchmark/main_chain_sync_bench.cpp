@@ -0,0 +1,216 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+
+#include "core/reactor.hpp"
+#include "crypto/ecdsa.hpp"
+#include "ledger/chain/block.hpp"
+#include "ledger/chain/main_chain.hpp"
+#include "ledger/protocols/main_chain_rpc_service.hpp"
+#include "ledger/testing/block_generator.hpp"
+#include "network/management/network_manager.hpp"
+#include "network/muddle/muddle.hpp"
+#include "network/p2pservice/p2ptrust_bayrank.hpp"
+#include "network/uri.hpp"
+
+#include "benchmark/benchmark.h"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using fetch::core::Reactor;
+using fetch::crypto::ECDSASigner;
+using fetch::ledger::MainChain;
+using fetch::ledger::MainChainRpcService;
+using fetch::ledger::testing::BlockGenerator;
+using fetch::muddle::Muddle;
+using fetch::muddle::NetworkId;
+using fetch::network::NetworkManager;
+using fetch::network::Peer;
+using fetch::network::Uri;
+
+using BlockPtr     = BlockGenerator::BlockPtr;
+using BlockArray   = std::vector<BlockPtr>;
+using Clock        = std::chrono::steady_clock;
+using Mode         = MainChainRpcService::Mode;
+using TrustSystem  = fetch::p2p::P2PTrustBayRank<Muddle::Address>;
+using ServicePtr   = std::shared_ptr<MainChainRpcService>;
+using MainChainPtr = std::unique_ptr<MainChain>;
+
+constexpr uint16_t BASE_PORT = 9600;
+
+/**
+ * Generate (and cache) a chain of blocks which satisfy the block proof, genesis first
+ */
+BlockArray const &GenerateChain(std::size_t length)
+{
+  static BlockGenerator generator{1, 1};
+  static BlockArray     chain{generator()};
+
+  while (chain.size() <= length)
+  {
+    BlockPtr block{};
+
+    // the proof is required when blocks are synchronised, the target is low so only a few
+    // attempts are needed
+    do
+    {
+      block = generator(chain.back());
+      block->proof.SetTarget(std::size_t{0});
+    } while (!block->proof());
+
+    chain.push_back(std::move(block));
+  }
+
+  return chain;
+}
+
+/**
+ * A minimal node, with a main chain which is synchronised over a local muddle network
+ */
+class Node
+{
+public:
+  Node(NetworkManager const &network_manager, Muddle::PortList const &ports,
+       Muddle::UriList const &peers, Mode mode)
+    : muddle_{NetworkId{"SYNC"}, std::make_shared<ECDSASigner>(), network_manager}
+    , service_{std::make_shared<MainChainRpcService>(muddle_.AsEndpoint(), chain_, trust_, mode)}
+  {
+    muddle_.Start(ports, peers);
+  }
+
+  ~Node()
+  {
+    muddle_.Stop();
+  }
+
+  void WaitForPeers(std::size_t num_peers)
+  {
+    while (muddle_.AsEndpoint().GetDirectlyConnectedPeers().size() < num_peers)
+    {
+      std::this_thread::sleep_for(std::chrono::milliseconds{10});
+    }
+  }
+
+  MainChain &chain()
+  {
+    return chain_;
+  }
+
+  MainChainRpcService &service()
+  {
+    return *service_;
+  }
+
+private:
+  MainChain   chain_{false, MainChain::Mode::IN_MEMORY_DB};
+  TrustSystem trust_{};
+  Muddle      muddle_;
+  ServicePtr  service_;
+};
+
+using NodePtr  = std::unique_ptr<Node>;
+using NodeList = std::vector<NodePtr>;
+
+/**
+ * Measure the rate at which a fresh node catches up with a chain which is served by a number of
+ * peers, all connected over the loopback interface
+ */
+void MainChain_CatchUp(benchmark::State &state)
+{
+  static uint16_t next_port{BASE_PORT};
+
+  auto const length    = static_cast<std::size_t>(state.range(0));
+  auto const num_peers = static_cast<std::size_t>(state.range(1));
+
+  auto const &blocks = GenerateChain(length);
+  auto const  tip    = blocks[length]->body.hash;
+
+  NetworkManager network_manager{"main_chain_sync_bench", 4};
+  network_manager.Start();
+
+  // create the peers which serve the complete chain
+  NodeList        peers{};
+  Muddle::UriList uris{};
+  for (std::size_t i = 0; i < num_peers; ++i)
+  {
+    uint16_t const port = next_port++;
+
+    peers.emplace_back(
+        std::make_unique<Node>(network_manager, Muddle::PortList{port}, Muddle::UriList{},
+                               Mode::STANDALONE));
+    uris.emplace_back(Uri{Peer{"127.0.0.1", port}});
+
+    for (std::size_t j = 1; j <= length; ++j)
+    {
+      peers.back()->chain().AddBlock(*blocks[j]);
+    }
+  }
+
+  for (auto _ : state)
+  {
+    NodePtr node = std::make_unique<Node>(network_manager, Muddle::PortList{}, uris,
+                                          Mode::PRIVATE_NETWORK);
+    node->WaitForPeers(num_peers);
+
+    Reactor reactor{"main_chain_sync_bench"};
+    reactor.Attach(node->service().GetWeakRunnable());
+
+    auto const start = Clock::now();
+    reactor.Start();
+
+    while (node->chain().GetHeaviestBlockHash() != tip)
+    {
+      std::this_thread::sleep_for(std::chrono::milliseconds{1});
+    }
+
+    auto const elapsed = std::chrono::duration<double>(Clock::now() - start);
+    state.SetIterationTime(elapsed.count());
+
+    reactor.Stop();
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+
+  peers.clear();
+  network_manager.Stop();
+}
+
+void CreateRanges(benchmark::internal::Benchmark *b)
+{
+  for (int num_peers : {1, 2, 4, 8})
+  {
+    for (int length : {1000, 5000, 20000})
+    {
+      b->Args({length, num_peers});
+    }
+  }
+}
+
+}  // namespace
+
+BENCHMARK(MainChain_CatchUp)
+    ->Apply(CreateRanges)
+    ->UseManualTime()
+    ->Unit(benchmark::kMillisecond);
@@ -0,0 +1,261 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/bitvector.hpp"
+#include "core/byte_array/const_byte_array.hpp"
+#include "crypto/ecdsa.hpp"
+#include "ledger/chain/address.hpp"
+#include "ledger/chain/transaction.hpp"
+#include "ledger/chain/transaction_builder.hpp"
+#include "ledger/chaincode/token_contract.hpp"
+#include "ledger/executor.hpp"
+#include "ledger/identifier.hpp"
+#include "ledger/shard_config.hpp"
+#include "ledger/state_sentinel_adapter.hpp"
+#include "ledger/storage_unit/storage_unit_bundled_service.hpp"
+#include "ledger/storage_unit/storage_unit_client.hpp"
+#include "network/management/network_manager.hpp"
+#include "network/muddle/muddle.hpp"
+#include "network/uri.hpp"
+
+#include "benchmark/benchmark.h"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using fetch::BitVector;
+using fetch::byte_array::ConstByteArray;
+using fetch::crypto::ECDSASigner;
+using fetch::ledger::Address;
+using fetch::ledger::Executor;
+using fetch::ledger::Identifier;
+using fetch::ledger::ShardConfig;
+using fetch::ledger::ShardConfigs;
+using fetch::ledger::StateSentinelAdapter;
+using fetch::ledger::StorageUnitBundledService;
+using fetch::ledger::StorageUnitClient;
+using fetch::ledger::TokenContract;
+using fetch::ledger::Transaction;
+using fetch::ledger::TransactionBuilder;
+using fetch::muddle::Muddle;
+using fetch::muddle::NetworkId;
+using fetch::network::NetworkManager;
+using fetch::network::Peer;
+using fetch::network::Uri;
+using fetch::storage::ResourceAddress;
+
+using StorageUnitClientPtr = std::shared_ptr<StorageUnitClient>;
+using TransactionPtr       = std::shared_ptr<Transaction>;
+
+constexpr uint32_t LOG2_NUM_LANES = 2;
+constexpr uint32_t NUM_LANES      = 1u << LOG2_NUM_LANES;
+constexpr uint16_t BASE_PORT      = 9400;
+
+/**
+ * A complete set of lane services and a storage unit client, connected together over the loopback
+ * interface in the same way as a constellation node
+ */
+class LoopbackStorage
+{
+public:
+  static LoopbackStorage &Instance()
+  {
+    static LoopbackStorage instance{};
+    return instance;
+  }
+
+  StorageUnitClientPtr const &client() const
+  {
+    return client_;
+  }
+
+  ~LoopbackStorage()
+  {
+    client_.reset();
+    muddle_->Stop();
+    lanes_.Stop();
+    network_manager_.Stop();
+  }
+
+private:
+  LoopbackStorage()
+  {
+    network_manager_.Start();
+
+    ShardConfigs configs(NUM_LANES);
+
+    uint16_t port = BASE_PORT;
+    for (uint32_t i = 0; i < NUM_LANES; ++i)
+    {
+      auto &shard = configs[i];
+
+      shard.lane_id             = i;
+      shard.num_lanes           = NUM_LANES;
+      shard.storage_path        = "storage_unit_client_bench";
+      shard.external_identity   = std::make_shared<ECDSASigner>();
+      shard.external_port       = port++;
+      shard.external_network_id = NetworkId{(i & 0xFFFFFFu) | (uint32_t{'L'} << 24u)};
+      shard.internal_identity   = std::make_shared<ECDSASigner>();
+      shard.internal_port       = port++;
+      shard.internal_network_id = NetworkId{"ISRD"};
+    }
+
+    lanes_.Setup(network_manager_, configs, false, StorageUnitBundledService::Mode::CREATE_DATABASE);
+    lanes_.Start();
+
+    // connect the internal muddle to all the lanes
+    Muddle::UriList uris;
+    for (auto const &shard : configs)
+    {
+      uris.emplace_back(Uri{Peer{"127.0.0.1", shard.internal_port}});
+    }
+
+    muddle_ = std::make_unique<Muddle>(NetworkId{"ISRD"}, std::make_shared<ECDSASigner>(),
+                                       network_manager_);
+    muddle_->Start({}, uris);
+
+    while (muddle_->GetConnections(true).size() < configs.size())
+    {
+      std::this_thread::sleep_for(std::chrono::milliseconds{100});
+    }
+
+    client_ = std::make_shared<StorageUnitClient>(muddle_->AsEndpoint(), configs, LOG2_NUM_LANES);
+  }
+
+  NetworkManager            network_manager_{"storage_unit_client_bench", 4};
+  StorageUnitBundledService lanes_{};
+  std::unique_ptr<Muddle>   muddle_{};
+  StorageUnitClientPtr      client_{};
+};
+
+StorageUnitClient::ResourceAddresses GenerateKeys(std::size_t count)
+{
+  StorageUnitClient::ResourceAddresses keys{};
+  keys.reserve(count);
+
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    keys.emplace_back(ResourceAddress{"fetch.bench.state.key" + std::to_string(i)});
+  }
+
+  return keys;
+}
+
+void PopulateKeys(StorageUnitClient &storage, StorageUnitClient::ResourceAddresses const &keys)
+{
+  StorageUnitClient::KeyValues values{};
+  values.reserve(keys.size());
+
+  for (auto const &key : keys)
+  {
+    values.emplace_back(key, ConstByteArray{"some value for the key"});
+  }
+
+  storage.SetMany(values);
+}
+
+void StorageUnitClient_Get(benchmark::State &state)
+{
+  auto &storage = *LoopbackStorage::Instance().client();
+
+  auto const keys = GenerateKeys(static_cast<std::size_t>(state.range(0)));
+  PopulateKeys(storage, keys);
+
+  for (auto _ : state)
+  {
+    for (auto const &key : keys)
+    {
+      benchmark::DoNotOptimize(storage.Get(key));
+    }
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void StorageUnitClient_GetMany(benchmark::State &state)
+{
+  auto &storage = *LoopbackStorage::Instance().client();
+
+  auto const keys = GenerateKeys(static_cast<std::size_t>(state.range(0)));
+  PopulateKeys(storage, keys);
+
+  for (auto _ : state)
+  {
+    benchmark::DoNotOptimize(storage.GetMany(keys));
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+TransactionPtr CreateTransaction(ECDSASigner const &signer, std::size_t num_transfers)
+{
+  Address const from{signer.identity()};
+
+  TransactionBuilder builder{};
+  builder.From(from).ValidUntil(1000).ChargeRate(1).ChargeLimit(500).Signer(signer.identity());
+
+  for (std::size_t i = 0; i < num_transfers; ++i)
+  {
+    builder.Transfer(Address{ECDSASigner{}.identity()}, 1);
+  }
+
+  return builder.Seal().Sign(signer).Build();
+}
+
+void Executor_Loopback(benchmark::State &state)
+{
+  auto const &storage = LoopbackStorage::Instance().client();
+
+  ECDSASigner signer{};
+  auto const  tx = CreateTransaction(signer, static_cast<std::size_t>(state.range(0)));
+  storage->AddTransaction(*tx);
+
+  BitVector shards{NUM_LANES};
+  shards.SetAllOne();
+
+  // add funds to ensure the transaction passes
+  {
+    StateSentinelAdapter adapter{*storage, Identifier{"fetch.token"}, shards};
+
+    TokenContract tokens{};
+
+    tokens.Attach(adapter);
+    tokens.AddTokens(tx->from(), 500000000);
+    tokens.Detach();
+  }
+
+  Executor executor{storage, nullptr};
+
+  for (auto _ : state)
+  {
+    executor.Execute(tx->digest(), 1, 0, shards);
+  }
+}
+
+}  // namespace
+
+BENCHMARK(StorageUnitClient_Get)->RangeMultiplier(4)->Range(1, 256)->UseRealTime();
+BENCHMARK(StorageUnitClient_GetMany)->RangeMultiplier(4)->Range(1, 256)->UseRealTime();
+BENCHMARK(Executor_Loopback)->Arg(1)->Arg(4)->Arg(16)->UseRealTime();
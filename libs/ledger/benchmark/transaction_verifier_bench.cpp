@@ -17,6 +17,8 @@
 //------------------------------------------------------------------------------
 
 #include "crypto/ecdsa.hpp"
+#include "ledger/chain/transaction.hpp"
+#include "ledger/chain/transaction_batch_verifier.hpp"
 #include "ledger/storage_unit/transaction_sinks.hpp"
 #include "ledger/transaction_verifier.hpp"
 #include "tx_generation.hpp"
@@ -24,13 +26,19 @@
 #include "benchmark/benchmark.h"
 
 #include <condition_variable>
+#include <memory>
 #include <thread>
+#include <vector>
 
+using fetch::ledger::Transaction;
+using fetch::ledger::TransactionBatchVerifier;
 using fetch::ledger::TransactionVerifier;
 using fetch::crypto::ECDSASigner;
 
 namespace {
 
+constexpr std::size_t NUM_SENDERS = 16;
+
 class DummySink : public fetch::ledger::TransactionSink
 {
 
@@ -58,36 +66,69 @@ public:
   void Wait()
   {
     std::unique_lock<std::mutex> lock(lock_);
-    if (count_ >= threshold_)
-    {
-      return;
-    }
-
-    condition_.wait(lock);
+    condition_.wait(lock, [this]() { return count_ >= threshold_; });
   }
 };
 
+/**
+ * Generate a set of signed transactions from a small number of repeat senders
+ */
+TransactionList GenerateSignedTransactions(std::size_t count)
+{
+  std::vector<ECDSASigner> signers(NUM_SENDERS);
+
+  TransactionList txs;
+  txs.reserve(count);
+
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    auto generated = GenerateTransactions(1, signers[i % NUM_SENDERS]);
+    txs.emplace_back(std::move(generated.front()));
+  }
+
+  return txs;
+}
+
+/**
+ * Make unverified copies of the transactions, since the result of verification is cached in the
+ * transaction itself
+ */
+TransactionList CopyTransactions(TransactionList const &txs)
+{
+  TransactionList copies;
+  copies.reserve(txs.size());
+
+  for (auto const &tx : txs)
+  {
+    copies.emplace_back(std::make_shared<Transaction>(*tx));
+  }
+
+  return copies;
+}
+
 void TransactionVerifierBench(benchmark::State &state)
 {
-  //  std::cout << "Tx Verification - threads: " << state.range(0) << " num txs: " << state.range(1)
-  //  << std::endl;
+  auto const num_threads = static_cast<std::size_t>(state.range(0));
+  auto const num_txs     = static_cast<std::size_t>(state.range(1));
+  auto const batch_size  = static_cast<std::size_t>(state.range(2));
 
   // generate the transactions
-  ECDSASigner signer;
-  auto const  txs = GenerateTransactions(static_cast<std::size_t>(state.range(1)), signer);
+  auto const txs = GenerateSignedTransactions(num_txs);
 
-  // wait for the
   for (auto _ : state)
   {
     state.PauseTiming();
 
-    DummySink sink{txs.size()};
+    auto const unverified = CopyTransactions(txs);
+
+    DummySink sink{unverified.size()};
 
     // needs to be created on the heap because of memory use
-    auto verifier = std::make_unique<TransactionVerifier>(sink, state.range(0), "Verifier");
+    auto verifier =
+        std::make_unique<TransactionVerifier>(sink, num_threads, "Verifier", batch_size);
 
     // front load the verifier
-    for (auto const &tx : txs)
+    for (auto const &tx : unverified)
     {
       verifier->AddTransaction(tx);
     }
@@ -95,12 +136,18 @@ void TransactionVerifierBench(benchmark::State &state)
     verifier->Start();
     state.ResumeTiming();
 
-    // wait for the
+    // wait for all the transactions to be dispatched
     sink.Wait();
 
     state.PauseTiming();
     verifier->Stop();
+    state.ResumeTiming();
   }
+
+  state.counters["txs/s/core"] = benchmark::Counter(
+      static_cast<double>(num_txs * static_cast<std::size_t>(state.iterations())) /
+          static_cast<double>(num_threads),
+      benchmark::Counter::kIsRate);
 }
 
 void CreateRanges(benchmark::internal::Benchmark *b)
@@ -109,15 +156,45 @@ void CreateRanges(benchmark::internal::Benchmark *b)
 
   for (int i = 1; i <= max_threads; ++i)
   {
-    b->Args({i, 1});
-    b->Args({i, 10});
-    b->Args({i, 100});
-    b->Args({i, 1000});
-    b->Args({i, 10000});
-    b->Args({i, 100000});
+    for (int batch_size = 1; batch_size <= 256; batch_size *= 4)
+    {
+      b->Args({i, 10000, batch_size});
+    }
   }
 }
 
+void TransactionBatchVerifierBench(benchmark::State &state)
+{
+  auto const batch_size = static_cast<std::size_t>(state.range(0));
+
+  auto const txs = GenerateSignedTransactions(batch_size * 16);
+
+  TransactionBatchVerifier        verifier;
+  TransactionBatchVerifier::Batch batch;
+
+  std::size_t num_verified{0};
+  for (auto _ : state)
+  {
+    state.PauseTiming();
+    auto const unverified = CopyTransactions(txs);
+    state.ResumeTiming();
+
+    for (auto it = unverified.begin(); it != unverified.end();)
+    {
+      batch.assign(it, it + static_cast<std::ptrdiff_t>(batch_size));
+      verifier.Verify(batch);
+
+      it += static_cast<std::ptrdiff_t>(batch_size);
+    }
+
+    num_verified += unverified.size();
+  }
+
+  state.counters["txs/s/core"] =
+      benchmark::Counter(static_cast<double>(num_verified), benchmark::Counter::kIsRate);
+}
+
 }  // namespace
 
-BENCHMARK(TransactionVerifierBench)->Apply(CreateRanges);
+BENCHMARK(TransactionVerifierBench)->Apply(CreateRanges)->UseRealTime();
+BENCHMARK(TransactionBatchVerifierBench)->RangeMultiplier(2)->Range(1, 256);
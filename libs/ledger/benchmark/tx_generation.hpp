@@ -42,6 +42,7 @@ inline TransactionList GenerateTransactions(std::size_t count, ECDSASigner &sign
     auto tx = TransactionBuilder()
                   .From(Address{signer.identity()})
                   .TargetChainCode("fetch.dummy", BitVector{})
+                  .Action("run")
                   .Signer(signer.identity())
                   .Seal()
                   .Sign(signer)
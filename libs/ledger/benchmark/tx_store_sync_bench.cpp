@@ -0,0 +1,275 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/reactor.hpp"
+#include "core/service_ids.hpp"
+#include "crypto/ecdsa.hpp"
+#include "ledger/chain/transaction.hpp"
+#include "ledger/chain/transaction_rpc_serializers.hpp"
+#include "ledger/storage_unit/transaction_finder_protocol.hpp"
+#include "ledger/storage_unit/transaction_store_sync_protocol.hpp"
+#include "ledger/storage_unit/transaction_store_sync_service.hpp"
+#include "network/management/network_manager.hpp"
+#include "network/muddle/muddle.hpp"
+#include "network/muddle/rpc/server.hpp"
+#include "network/uri.hpp"
+#include "storage/resource_mapper.hpp"
+#include "storage/transient_object_store.hpp"
+#include "tx_generation.hpp"
+
+#include "benchmark/benchmark.h"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using fetch::core::Reactor;
+using fetch::ledger::TransactionStoreSyncProtocol;
+using fetch::ledger::TransactionStoreSyncService;
+using fetch::ledger::TxFinderProtocol;
+using fetch::muddle::Muddle;
+using fetch::muddle::NetworkId;
+using fetch::muddle::rpc::Server;
+using fetch::network::NetworkManager;
+using fetch::network::Peer;
+using fetch::network::Uri;
+using fetch::storage::ResourceID;
+
+using Clock        = std::chrono::steady_clock;
+using TxStore      = fetch::storage::TransientObjectStore<Transaction>;
+using TxStorePtr   = std::shared_ptr<TxStore>;
+using MuddlePtr    = std::shared_ptr<Muddle>;
+using SyncService  = std::shared_ptr<TransactionStoreSyncService>;
+using Transactions = std::vector<TransactionList>;
+
+constexpr uint16_t    BASE_PORT            = 9800;
+constexpr std::size_t VERIFICATION_THREADS = 2;
+
+std::string StoreFilename(std::string const &name, std::size_t lane)
+{
+  return "tx_store_sync_bench_" + name + "_lane" + std::to_string(lane);
+}
+
+/**
+ * Generate the transactions held by each of the lanes, the set is shared between all the
+ * benchmarks since signing the transactions is expensive
+ */
+Transactions const &GetTransactions(std::size_t num_lanes, std::size_t txs_per_lane)
+{
+  static Transactions transactions{};
+
+  if ((transactions.size() < num_lanes) ||
+      (!transactions.empty() && (transactions.front().size() < txs_per_lane)))
+  {
+    ECDSASigner signer{};
+
+    transactions.clear();
+    for (std::size_t lane = 0; lane < num_lanes; ++lane)
+    {
+      transactions.emplace_back(GenerateTransactions(txs_per_lane, signer));
+    }
+  }
+
+  return transactions;
+}
+
+/**
+ * A lane of a node which already has the full transaction history and serves it to its peers
+ */
+class SeedLane
+{
+public:
+  SeedLane(NetworkManager const &network_manager, uint16_t port, std::string const &name,
+           std::size_t lane, TransactionList const &transactions, std::size_t num_txs)
+    : store_{std::make_shared<TxStore>(0)}
+    , protocol_{store_.get(), static_cast<int>(lane)}
+    , muddle_{NetworkId{"SYNC"}, std::make_shared<ECDSASigner>(), network_manager}
+    , server_{muddle_.AsEndpoint(), fetch::SERVICE_LANE, fetch::CHANNEL_RPC}
+  {
+    store_->New(StoreFilename(name, lane) + ".db", StoreFilename(name, lane) + "_index.db", true);
+
+    for (std::size_t i = 0; i < num_txs; ++i)
+    {
+      ResourceID const rid{transactions[i]->digest()};
+
+      store_->Set(rid, *transactions[i], false);
+      store_->Confirm(rid);
+    }
+
+    // write all the transactions to the archive
+    auto worker = store_->GetWeakRunnable().lock();
+    while (store_->PendingConfirmations() > 0)
+    {
+      worker->Execute();
+    }
+
+    server_.Add(fetch::RPC_TX_STORE_SYNC, &protocol_);
+    muddle_.Start({port});
+  }
+
+  ~SeedLane()
+  {
+    muddle_.Stop();
+  }
+
+private:
+  TxStorePtr                   store_;
+  TransactionStoreSyncProtocol protocol_;
+  Muddle                       muddle_;
+  Server                       server_;
+};
+
+/**
+ * A lane of a new node which bootstraps its transaction store from the seed lanes
+ */
+class BootstrapLane
+{
+public:
+  BootstrapLane(NetworkManager const &network_manager, uint16_t port, std::size_t lane,
+                Muddle::UriList const &seeds)
+    : store_{std::make_shared<TxStore>(0)}
+    , muddle_{std::make_shared<Muddle>(NetworkId{"SYNC"}, std::make_shared<ECDSASigner>(),
+                                       network_manager)}
+  {
+    store_->New(StoreFilename("bootstrap", lane) + ".db",
+                StoreFilename("bootstrap", lane) + "_index.db", true);
+
+    TransactionStoreSyncService::Config cfg{};
+    cfg.lane_id              = static_cast<uint32_t>(lane);
+    cfg.verification_threads = VERIFICATION_THREADS;
+
+    service_ =
+        std::make_shared<TransactionStoreSyncService>(cfg, muddle_, store_, &finder_, []() {});
+
+    reactor_.Attach(store_->GetWeakRunnable());
+    reactor_.Attach(service_->GetWeakRunnable());
+
+    muddle_->Start({port}, seeds);
+  }
+
+  ~BootstrapLane()
+  {
+    reactor_.Stop();
+    service_->Stop();
+    muddle_->Stop();
+  }
+
+  void Start()
+  {
+    service_->Start();
+    reactor_.Start();
+  }
+
+  std::size_t size() const
+  {
+    return store_->Size();
+  }
+
+private:
+  TxStorePtr       store_;
+  MuddlePtr        muddle_;
+  TxFinderProtocol finder_{};
+  SyncService      service_{};
+  Reactor          reactor_{"SyncBench"};
+};
+
+using SeedLanePtr      = std::unique_ptr<SeedLane>;
+using BootstrapLanePtr = std::unique_ptr<BootstrapLane>;
+
+/**
+ * Measure the rate at which a new node can pull the transaction history of every lane from a set
+ * of local seed nodes. The time includes the verification of every transaction.
+ */
+void Tx_Store_Bootstrap(benchmark::State &state)
+{
+  static uint16_t next_port{BASE_PORT};
+
+  auto const num_lanes    = static_cast<std::size_t>(state.range(0));
+  auto const txs_per_lane = static_cast<std::size_t>(state.range(1));
+  auto const num_seeds    = static_cast<std::size_t>(state.range(2));
+
+  auto const &transactions = GetTransactions(num_lanes, txs_per_lane);
+
+  NetworkManager network_manager{"tx_store_sync_bench", 8};
+  network_manager.Start();
+
+  // build the seed nodes, each of which has the complete history of every lane
+  std::vector<SeedLanePtr>     seeds{};
+  std::vector<Muddle::UriList> seed_uris(num_lanes);
+  for (std::size_t seed = 0; seed < num_seeds; ++seed)
+  {
+    for (std::size_t lane = 0; lane < num_lanes; ++lane)
+    {
+      uint16_t const port = next_port++;
+
+      seeds.emplace_back(std::make_unique<SeedLane>(network_manager, port,
+                                                    "seed" + std::to_string(seed), lane,
+                                                    transactions[lane], txs_per_lane));
+      seed_uris[lane].emplace_back(Uri{Peer{"127.0.0.1", port}});
+    }
+  }
+
+  for (auto _ : state)
+  {
+    std::vector<BootstrapLanePtr> lanes{};
+    for (std::size_t lane = 0; lane < num_lanes; ++lane)
+    {
+      lanes.emplace_back(std::make_unique<BootstrapLane>(network_manager, next_port++, lane,
+                                                         seed_uris[lane]));
+    }
+
+    auto const start = Clock::now();
+
+    for (auto &lane : lanes)
+    {
+      lane->Start();
+    }
+
+    for (auto &lane : lanes)
+    {
+      while (lane->size() < txs_per_lane)
+      {
+        std::this_thread::sleep_for(std::chrono::milliseconds{1});
+      }
+    }
+
+    auto const elapsed = std::chrono::duration<double>(Clock::now() - start);
+    state.SetIterationTime(elapsed.count());
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0) * state.range(1));
+
+  seeds.clear();
+  network_manager.Stop();
+}
+
+}  // namespace
+
+BENCHMARK(Tx_Store_Bootstrap)
+    ->Args({1, 10000, 1})
+    ->Args({1, 10000, 3})
+    ->Args({4, 10000, 1})
+    ->Args({4, 10000, 3})
+    ->UseManualTime()
+    ->Unit(benchmark::kMillisecond);
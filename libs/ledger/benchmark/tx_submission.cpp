@@ -18,23 +18,36 @@
 
 #include "core/byte_array/byte_array.hpp"
 #include "core/byte_array/const_byte_array.hpp"
+#include "core/json/document.hpp"
 #include "core/random/lcg.hpp"
 #include "crypto/ecdsa.hpp"
+#include "ledger/chain/json_transaction.hpp"
 #include "ledger/chain/transaction_builder.hpp"
 #include "ledger/chain/transaction_rpc_serializers.hpp"
+#include "ledger/chain/transaction_serializer.hpp"
+#include "ledger/chain/transaction_stream_decoder.hpp"
 #include "ledger/storage_unit/lane_service.hpp"
 #include "storage/transient_object_store.hpp"
+#include "variant/variant.hpp"
 
 #include "benchmark/benchmark.h"
 
+#include <algorithm>
+#include <memory>
+#include <sstream>
 #include <vector>
 
 namespace {
 
 using fetch::byte_array::ByteArray;
+using fetch::byte_array::ConstByteArray;
 using fetch::storage::ResourceID;
 using fetch::ledger::Transaction;
 using fetch::ledger::TransactionBuilder;
+using fetch::ledger::TransactionSerializer;
+using fetch::ledger::TransactionStreamDecoder;
+using fetch::json::JSONDocument;
+using fetch::variant::Variant;
 using fetch::ledger::Address;
 using fetch::crypto::ECDSASigner;
 using fetch::random::LinearCongruentialGenerator;
@@ -43,7 +56,8 @@ using TransientStore   = fetch::storage::TransientObjectStore<Transaction>;
 using TransactionStore = fetch::storage::ObjectStore<Transaction>;
 using TransactionList  = std::vector<TransactionBuilder::TransactionPtr>;
 
-static constexpr uint32_t LOG2_NUM_LANES = 2;
+static constexpr uint32_t    LOG2_NUM_LANES    = 2;
+static constexpr std::size_t STREAM_CHUNK_SIZE = 16384;
 
 TransactionList GenerateTransactions(std::size_t count, bool large_packets)
 {
@@ -211,8 +225,93 @@ void TransientStoreExpectedOperation(benchmark::State &state)
   }
 }
 
+ConstByteArray GenerateJsonBody(TransactionList const &transactions)
+{
+  Variant body = Variant::Array(transactions.size());
+  for (std::size_t i = 0; i < transactions.size(); ++i)
+  {
+    fetch::ledger::ToJsonTransaction(*transactions[i], body[i]);
+  }
+
+  std::ostringstream oss;
+  oss << body;
+
+  return oss.str();
+}
+
+ConstByteArray GenerateStreamBody(TransactionList const &transactions)
+{
+  ByteArray body;
+  for (auto const &tx : transactions)
+  {
+    TransactionSerializer serializer{};
+    serializer << *tx;
+
+    fetch::ledger::AppendTransactionFrame(body, serializer.data());
+  }
+
+  return body;
+}
+
+void TxIngestJson(benchmark::State &state)
+{
+  auto const            count        = static_cast<std::size_t>(state.range(0));
+  TransactionList const transactions = GenerateTransactions(count, state.range(1) != 0);
+  ConstByteArray const  body         = GenerateJsonBody(transactions);
+
+  for (auto _ : state)
+  {
+    // mirrors the JSON submission path of the contract HTTP interface
+    JSONDocument    doc{body};
+    TransactionList decoded;
+    decoded.reserve(count);
+
+    for (std::size_t i = 0, end = doc.root().size(); i < end; ++i)
+    {
+      auto tx = std::make_shared<Transaction>();
+      if (fetch::ledger::FromJsonTransaction(doc[i], *tx))
+      {
+        decoded.emplace_back(std::move(tx));
+      }
+    }
+
+    benchmark::DoNotOptimize(decoded);
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+  state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(body.size()));
+}
+
+void TxIngestStream(benchmark::State &state)
+{
+  auto const            count        = static_cast<std::size_t>(state.range(0));
+  TransactionList const transactions = GenerateTransactions(count, state.range(1) != 0);
+  ConstByteArray const  body         = GenerateStreamBody(transactions);
+
+  for (auto _ : state)
+  {
+    std::size_t decoded{0};
+
+    TransactionStreamDecoder decoder{
+        [&decoded](TransactionStreamDecoder::TransactionList &&txs) { decoded += txs.size(); }};
+
+    // feed the body in as it would arrive from the network
+    for (std::size_t offset = 0; offset < body.size(); offset += STREAM_CHUNK_SIZE)
+    {
+      decoder.Feed(body.SubArray(offset, std::min(STREAM_CHUNK_SIZE, body.size() - offset)));
+    }
+
+    benchmark::DoNotOptimize(decoded);
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+  state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(body.size()));
+}
+
 }  // namespace
 
+BENCHMARK(TxIngestJson)->Args({1000, 0})->Args({1000, 1})->Args({10000, 0});
+BENCHMARK(TxIngestStream)->Args({1000, 0})->Args({1000, 1})->Args({10000, 0});
 BENCHMARK(TransientStoreExpectedOperation)->Range(10, 1000000);
 BENCHMARK(TxSubmitSingleSmallAlt);
 BENCHMARK(TxSubmitFixedLarge);
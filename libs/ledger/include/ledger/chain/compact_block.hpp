@@ -0,0 +1,103 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/serializers/base_types.hpp"
+#include "ledger/chain/block.hpp"
+#include "ledger/chain/recent_transaction_index.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace fetch {
+namespace ledger {
+
+/**
+ * The compact form of a block used when relaying newly mined blocks around the network.
+ *
+ * Rather than the full transaction layouts, each slice only carries the short ids of its
+ * transactions. Since most of these transactions will already have been synchronised to the
+ * receiving node, the block can usually be rebuilt from the local index of recent transactions.
+ * Transactions which can not be found locally are referred to by their index in the block, counted
+ * across all the slices in order.
+ */
+class CompactBlock
+{
+public:
+  using ShortTxIds         = std::vector<ShortTxId>;
+  using Slices             = std::vector<ShortTxIds>;
+  using TransactionIndices = std::vector<uint64_t>;
+  using TransactionLayouts = std::vector<TransactionLayout>;
+
+  // Construction / Destruction
+  CompactBlock() = default;
+  explicit CompactBlock(Block const &block);
+  CompactBlock(CompactBlock const &) = default;
+  CompactBlock(CompactBlock &&)      = default;
+  ~CompactBlock()                    = default;
+
+  Block  header;  ///< The block with the contents of its slices removed
+  Slices slices;  ///< The short ids of the transactions in each of the slices
+
+  // Helper functions
+  std::size_t        GetTransactionCount() const;
+  TransactionIndices Reconstruct(RecentTransactionIndex const *index, Block &block) const;
+
+  static bool Fill(Block &block, TransactionIndices const &indices,
+                   TransactionLayouts const &layouts);
+  static bool Extract(Block const &block, TransactionIndices const &indices,
+                      TransactionLayouts &layouts);
+
+  // Operators
+  CompactBlock &operator=(CompactBlock const &) = default;
+  CompactBlock &operator=(CompactBlock &&) = default;
+};
+
+}  // namespace ledger
+
+namespace serializers {
+
+template <typename D>
+struct MapSerializer<ledger::CompactBlock, D>
+{
+public:
+  using Type       = ledger::CompactBlock;
+  using DriverType = D;
+
+  static uint8_t const HEADER = 1;
+  static uint8_t const SLICES = 2;
+
+  template <typename Constructor>
+  static void Serialize(Constructor &map_constructor, Type const &block)
+  {
+    auto map = map_constructor(2);
+    map.Append(HEADER, block.header);
+    map.Append(SLICES, block.slices);
+  }
+
+  template <typename MapDeserializer>
+  static void Deserialize(MapDeserializer &map, Type &block)
+  {
+    map.ExpectKeyGetValue(HEADER, block.header);
+    map.ExpectKeyGetValue(SLICES, block.slices);
+  }
+};
+
+}  // namespace serializers
+}  // namespace fetch
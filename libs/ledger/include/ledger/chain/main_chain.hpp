@@ -185,18 +185,38 @@ public:
     }
   };
 
+  /**
+   * A single occurrence of a transaction in the chain. Since the same transaction can be present on
+   * a number of competing forks both the block hash and number are recorded.
+   */
+  struct TransactionIndexEntry
+  {
+    uint64_t  block_number{0};
+    BlockHash block_hash{};
+  };
+
+  using TransactionIndexEntries = std::vector<TransactionIndexEntry>;
+
+  struct TransactionIndexRecord
+  {
+    TransactionIndexEntries entries;
+  };
+
 private:
-  using IntBlockPtr   = std::shared_ptr<Block>;
-  using BlockMap      = std::unordered_map<BlockHash, IntBlockPtr>;
-  using References    = std::unordered_multimap<BlockHash, BlockHash>;
-  using Proof         = Block::Proof;
-  using TipsMap       = std::unordered_map<BlockHash, Tip>;
-  using BlockHashList = std::list<BlockHash>;
-  using LooseBlockMap = std::unordered_map<BlockHash, BlockHashList>;
-  using BlockStore    = fetch::storage::ObjectStore<DbRecord>;
-  using BlockStorePtr = std::unique_ptr<BlockStore>;
-  using RMutex        = std::recursive_mutex;
-  using RLock         = std::unique_lock<RMutex>;
+  using IntBlockPtr     = std::shared_ptr<Block>;
+  using BlockMap        = std::unordered_map<BlockHash, IntBlockPtr>;
+  using References      = std::unordered_multimap<BlockHash, BlockHash>;
+  using Proof           = Block::Proof;
+  using TipsMap         = std::unordered_map<BlockHash, Tip>;
+  using BlockHashList   = std::list<BlockHash>;
+  using LooseBlockMap   = std::unordered_map<BlockHash, BlockHashList>;
+  using BlockStore      = fetch::storage::ObjectStore<DbRecord>;
+  using BlockStorePtr   = std::unique_ptr<BlockStore>;
+  using TxIndex         = DigestMap<TransactionIndexEntries>;
+  using TxIndexStore    = fetch::storage::ObjectStore<TransactionIndexRecord>;
+  using TxIndexStorePtr = std::unique_ptr<TxIndexStore>;
+  using RMutex          = std::recursive_mutex;
+  using RLock           = std::unique_lock<RMutex>;
 
   struct HeaviestTip
   {
@@ -231,6 +251,16 @@ private:
   void AddBlockToBloomFilter(Block const &block) const;
   /// @}
 
+  /// @name Transaction Index
+  /// @{
+  void IndexTransactions(Block const &block) const;
+  void UnindexTransactions(Block const &block) const;
+  void PersistTransactions(Block const &block) const;
+  bool LookupTransaction(Digest const &digest, TransactionIndexEntries &entries) const;
+  void UpdateHeaviestChainIndex() const;
+  bool IsOnHeaviestChain(uint64_t block_number, BlockHash const &hash) const;
+  /// @}
+
   /// @name Low-level storage interface
   /// @{
   void                CacheBlock(IntBlockPtr const &block) const;
@@ -253,8 +283,9 @@ private:
 
   bool RemoveTree(BlockHash const &hash, BlockHashSet &invalidated_blocks);
 
-  BlockStorePtr block_store_;  /// < Long term storage and backup
-  std::fstream  head_store_;
+  BlockStorePtr   block_store_;     /// < Long term storage and backup
+  TxIndexStorePtr tx_index_store_;  /// < Long term storage of the transaction index
+  std::fstream    head_store_;
 
   mutable RMutex   lock_;         ///< Mutex protecting block_chain_, tips_ & heaviest_
   mutable BlockMap block_chain_;  ///< All recent blocks are kept in memory
@@ -263,6 +294,8 @@ private:
   TipsMap                           tips_;          ///< Keep track of the tips
   HeaviestTip                       heaviest_;      ///< Heaviest block/tip
   LooseBlockMap                     loose_blocks_;  ///< Waiting (loose) blocks
+  mutable TxIndex                   tx_index_;      ///< Transaction locations in cached blocks
+  mutable BlockHashes               heaviest_chain_;  ///< Heaviest chain hashes by block number
   std::unique_ptr<BasicBloomFilter> bloom_filter_;
   bool const                        enable_bloom_filter_;
   telemetry::GaugePtr<std::size_t>  bloom_filter_queried_bit_count_;
@@ -326,6 +359,55 @@ public:
     map.ExpectKeyGetValue(NEXT_HASH, dbRecord.next_hash);
   }
 };
+
+template <typename D>
+struct MapSerializer<ledger::MainChain::TransactionIndexEntry, D>
+{
+public:
+  using Type       = ledger::MainChain::TransactionIndexEntry;
+  using DriverType = D;
+
+  static uint8_t const BLOCK_NUMBER = 1;
+  static uint8_t const BLOCK_HASH   = 2;
+
+  template <typename Constructor>
+  static void Serialize(Constructor &map_constructor, Type const &entry)
+  {
+    auto map = map_constructor(2);
+    map.Append(BLOCK_NUMBER, entry.block_number);
+    map.Append(BLOCK_HASH, entry.block_hash);
+  }
+
+  template <typename MapDeserializer>
+  static void Deserialize(MapDeserializer &map, Type &entry)
+  {
+    map.ExpectKeyGetValue(BLOCK_NUMBER, entry.block_number);
+    map.ExpectKeyGetValue(BLOCK_HASH, entry.block_hash);
+  }
+};
+
+template <typename D>
+struct MapSerializer<ledger::MainChain::TransactionIndexRecord, D>
+{
+public:
+  using Type       = ledger::MainChain::TransactionIndexRecord;
+  using DriverType = D;
+
+  static uint8_t const ENTRIES = 1;
+
+  template <typename Constructor>
+  static void Serialize(Constructor &map_constructor, Type const &record)
+  {
+    auto map = map_constructor(1);
+    map.Append(ENTRIES, record.entries);
+  }
+
+  template <typename MapDeserializer>
+  static void Deserialize(MapDeserializer &map, Type &record)
+  {
+    map.ExpectKeyGetValue(ENTRIES, record.entries);
+  }
+};
 }  // namespace serializers
 
 }  // namespace fetch
@@ -0,0 +1,106 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/mutex.hpp"
+#include "ledger/chain/digest.hpp"
+#include "ledger/chain/transaction_layout.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <unordered_map>
+
+namespace fetch {
+namespace ledger {
+
+class Transaction;
+
+/**
+ * A compact identifier for a transaction, formed from the leading bytes of its digest. Used when
+ * relaying blocks to refer to transactions the receiver has most likely already seen.
+ */
+using ShortTxId = uint64_t;
+
+ShortTxId ToShortTxId(Digest const &digest);
+
+/**
+ * A bounded index of the layouts of recently seen transactions, keyed by their short id.
+ *
+ * This is the pool of transactions against which compact blocks are reconstructed. Once the
+ * capacity is reached the oldest entries are evicted first. In the rare case that two different
+ * transactions share a short id the newer one replaces the older, a mismatch which is picked up
+ * later by the block hash check.
+ *
+ * The index is thread safe.
+ */
+class RecentTransactionIndex
+{
+public:
+  static constexpr std::size_t DEFAULT_CAPACITY = 1u << 18u;
+
+  // Construction / Destruction
+  explicit RecentTransactionIndex(uint32_t log2_num_lanes, std::size_t capacity = DEFAULT_CAPACITY);
+  RecentTransactionIndex(RecentTransactionIndex const &) = delete;
+  RecentTransactionIndex(RecentTransactionIndex &&)      = delete;
+  ~RecentTransactionIndex()                              = default;
+
+  /// @name Index Updates
+  /// @{
+  void Add(Transaction const &tx);
+  void Add(TransactionLayout const &layout);
+  /// @}
+
+  /// @name Index Queries
+  /// @{
+  bool        Lookup(ShortTxId id, TransactionLayout &layout) const;
+  uint32_t    log2_num_lanes() const;
+  std::size_t size() const;
+  /// @}
+
+  // Operators
+  RecentTransactionIndex &operator=(RecentTransactionIndex const &) = delete;
+  RecentTransactionIndex &operator=(RecentTransactionIndex &&) = delete;
+
+private:
+  using Layouts = std::unordered_map<ShortTxId, TransactionLayout>;
+  using Order   = std::deque<ShortTxId>;
+
+  uint32_t const    log2_num_lanes_;
+  std::size_t const capacity_;
+
+  mutable Mutex lock_{__LINE__, __FILE__};
+  Layouts       layouts_;  ///< The indexed layouts
+  Order         order_;    ///< The short ids in the order they were added, oldest first
+};
+
+using RecentTransactionIndexPtr = std::shared_ptr<RecentTransactionIndex>;
+
+/**
+ * Get the lane configuration the indexed layouts were generated against
+ *
+ * @return The log2 of the number of lanes
+ */
+inline uint32_t RecentTransactionIndex::log2_num_lanes() const
+{
+  return log2_num_lanes_;
+}
+
+}  // namespace ledger
+}  // namespace fetch
@@ -168,6 +168,9 @@ private:
   // There are only two ways to generate a transaction, each from one of the two companion classes:
   friend class TransactionBuilder;
   friend class TransactionSerializer;
+
+  // Signature verification can also be performed in bulk
+  friend class TransactionBatchVerifier;
 };
 
 /**
@@ -0,0 +1,92 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/byte_array/byte_array.hpp"
+#include "crypto/ecdsa.hpp"
+#include "crypto/identity.hpp"
+#include "crypto/sha256.hpp"
+
+#include <cstddef>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace fetch {
+namespace ledger {
+
+class Transaction;
+
+/**
+ * Verifies the signatures of a batch of transactions.
+ *
+ * The payload of every transaction in the batch is hashed first, reusing a single hasher, and
+ * then every signature is checked against the precomputed digest. Decoded public keys are cached
+ * between batches so that repeat senders do not pay the key parsing cost again.
+ *
+ * Instances are not thread safe and are intended to be owned by a single worker thread.
+ */
+class TransactionBatchVerifier
+{
+public:
+  using TransactionPtr = std::shared_ptr<Transaction>;
+  using Batch          = std::vector<TransactionPtr>;
+
+  static constexpr std::size_t DEFAULT_MAX_CACHED_KEYS = 4096;
+
+  // Construction / Destruction
+  explicit TransactionBatchVerifier(std::size_t max_cached_keys = DEFAULT_MAX_CACHED_KEYS);
+  TransactionBatchVerifier(TransactionBatchVerifier const &) = delete;
+  TransactionBatchVerifier(TransactionBatchVerifier &&)      = delete;
+  ~TransactionBatchVerifier()                                = default;
+
+  /// @name Verification
+  /// @{
+  void Verify(Batch const &batch);
+  /// @}
+
+  /// @name Accessors
+  /// @{
+  std::size_t num_cached_keys() const;
+  /// @}
+
+  // Operators
+  TransactionBatchVerifier &operator=(TransactionBatchVerifier const &) = delete;
+  TransactionBatchVerifier &operator=(TransactionBatchVerifier &&) = delete;
+
+private:
+  using Verifier   = crypto::ECDSAVerifier;
+  using KeyCache   = std::unordered_map<crypto::Identity, Verifier>;
+  using DigestList = std::vector<byte_array::ByteArray>;
+
+  Verifier const &LookupVerifier(crypto::Identity const &identity);
+  bool            VerifySignatures(Transaction const &tx, byte_array::ConstByteArray const &digest);
+
+  std::size_t const max_cached_keys_;
+  KeyCache          keys_;     ///< Decoded public keys of recently seen signatories
+  crypto::SHA256    hasher_;   ///< The payload hasher, reused across transactions
+  DigestList        digests_;  ///< The payload digests of the current batch
+};
+
+inline std::size_t TransactionBatchVerifier::num_cached_keys() const
+{
+  return keys_.size();
+}
+
+}  // namespace ledger
+}  // namespace fetch
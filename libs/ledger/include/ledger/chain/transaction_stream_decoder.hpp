@@ -0,0 +1,153 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/byte_array/byte_array.hpp"
+#include "core/byte_array/const_byte_array.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace fetch {
+namespace ledger {
+
+class Transaction;
+
+/**
+ * Incrementally decodes a stream of length prefixed transaction frames.
+ *
+ * Every frame in the stream is a 32-bit little endian length followed by that many bytes of
+ * `TransactionSerializer` encoded transaction. The stream can be fed in arbitrarily sized chunks
+ * as it arrives from the network. Frames which are wholly contained within a chunk are sliced out
+ * of the receive buffer and decoded directly, without being copied or collected into an
+ * intermediate container. Only frames which straddle two or more chunks are reassembled into a
+ * separate buffer.
+ *
+ * Decoded transactions are handed to the batch handler in groups of at most `batch_size`. Any
+ * transactions decoded from a chunk are always flushed before `Feed` returns so that a slow stream
+ * never holds transactions back.
+ *
+ * Instances are not thread safe, one decoder should be used per stream.
+ */
+class TransactionStreamDecoder
+{
+public:
+  using ConstByteArray  = byte_array::ConstByteArray;
+  using ByteArray       = byte_array::ByteArray;
+  using TransactionPtr  = std::shared_ptr<Transaction>;
+  using TransactionList = std::vector<TransactionPtr>;
+  using BatchHandler    = std::function<void(TransactionList &&)>;
+
+  static constexpr char const *LOGGING_NAME       = "TxStreamDecoder";
+  static constexpr std::size_t PREFIX_SIZE        = sizeof(uint32_t);
+  static constexpr std::size_t MAX_FRAME_SIZE     = 1u << 20u;  // 1MB
+  static constexpr std::size_t DEFAULT_BATCH_SIZE = 256;
+
+  // Construction / Destruction
+  explicit TransactionStreamDecoder(BatchHandler handler,
+                                    std::size_t  batch_size = DEFAULT_BATCH_SIZE);
+  TransactionStreamDecoder(TransactionStreamDecoder const &) = delete;
+  TransactionStreamDecoder(TransactionStreamDecoder &&)      = delete;
+  ~TransactionStreamDecoder()                                = default;
+
+  /// @name Decoding
+  /// @{
+  bool Feed(ConstByteArray const &chunk);
+  /// @}
+
+  /// @name Accessors
+  /// @{
+  std::size_t received() const;
+  std::size_t decoded() const;
+  std::size_t buffered() const;
+  bool        corrupted() const;
+  /// @}
+
+  // Operators
+  TransactionStreamDecoder &operator=(TransactionStreamDecoder const &) = delete;
+  TransactionStreamDecoder &operator=(TransactionStreamDecoder &&) = delete;
+
+private:
+  std::size_t FillPartialFrame(ConstByteArray const &chunk);
+  void        DecodeFrame(ConstByteArray const &frame);
+  void        FlushBatch();
+
+  BatchHandler      handler_;
+  std::size_t const batch_size_;
+  TransactionList   batch_;             ///< The transactions waiting to be handed on
+  ByteArray         partial_;           ///< Reassembly buffer for a frame spanning chunks
+  std::size_t       received_{0};       ///< The number of frames seen in the stream
+  std::size_t       decoded_{0};        ///< The number of frames successfully decoded
+  bool              corrupted_{false};  ///< Set when the framing of the stream is broken
+};
+
+/**
+ * Append a single transaction frame onto the end of the stream
+ *
+ * @param stream The stream being built up
+ * @param encoded_tx The `TransactionSerializer` encoded transaction
+ */
+void AppendTransactionFrame(byte_array::ByteArray &           stream,
+                            byte_array::ConstByteArray const &encoded_tx);
+
+/**
+ * Get the number of frames that were seen in the stream, including ones that failed to decode
+ *
+ * @return The number of frames
+ */
+inline std::size_t TransactionStreamDecoder::received() const
+{
+  return received_;
+}
+
+/**
+ * Get the number of frames that have been successfully decoded into transactions
+ *
+ * @return The number of decoded transactions
+ */
+inline std::size_t TransactionStreamDecoder::decoded() const
+{
+  return decoded_;
+}
+
+/**
+ * Get the number of bytes of an incomplete frame that are waiting for the rest of the frame
+ *
+ * @return The number of buffered bytes
+ */
+inline std::size_t TransactionStreamDecoder::buffered() const
+{
+  return partial_.size();
+}
+
+/**
+ * Determine if the framing of the stream has been broken. Once corrupted all further input is
+ * rejected.
+ *
+ * @return true if corrupted, otherwise false
+ */
+inline bool TransactionStreamDecoder::corrupted() const
+{
+  return corrupted_;
+}
+
+}  // namespace ledger
+}  // namespace fetch
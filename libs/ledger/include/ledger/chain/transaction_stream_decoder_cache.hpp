@@ -0,0 +1,127 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/byte_array/const_byte_array.hpp"
+#include "crypto/fnv.hpp"
+#include "ledger/chain/transaction_stream_decoder.hpp"
+#include "moment/clock_interfaces.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <list>
+#include <memory>
+#include <unordered_map>
+
+namespace fetch {
+namespace ledger {
+
+/**
+ * Keeps a stream decoder for every sender which is part way through a transaction frame.
+ *
+ * The number of partial streams is bounded. A stream which has not made progress within the idle
+ * timeout is expired, and when a new sender arrives while the cache is full the least recently
+ * active stream is evicted to make room. In both cases the incomplete frame of the dropped stream
+ * is discarded, so a set of senders which go quiet half way through a frame can never lock other
+ * senders out.
+ *
+ * Instances are not thread safe.
+ */
+class TransactionStreamDecoderCache
+{
+public:
+  using ConstByteArray = byte_array::ConstByteArray;
+  using Address        = byte_array::ConstByteArray;
+  using BatchHandler   = TransactionStreamDecoder::BatchHandler;
+  using Duration       = moment::ClockInterface::Duration;
+
+  static constexpr char const *CLOCK_NAME          = "tx_stream:idle";
+  static constexpr std::size_t DEFAULT_MAX_STREAMS = 64;
+  static constexpr std::chrono::seconds DEFAULT_IDLE_TIMEOUT{30};
+
+  // Construction / Destruction
+  explicit TransactionStreamDecoderCache(BatchHandler handler,
+                                         std::size_t  max_streams  = DEFAULT_MAX_STREAMS,
+                                         Duration     idle_timeout = DEFAULT_IDLE_TIMEOUT);
+  TransactionStreamDecoderCache(TransactionStreamDecoderCache const &) = delete;
+  TransactionStreamDecoderCache(TransactionStreamDecoderCache &&)      = delete;
+  ~TransactionStreamDecoderCache()                                     = default;
+
+  /// @name Decoding
+  /// @{
+  bool Feed(Address const &from, ConstByteArray const &chunk);
+  /// @}
+
+  /// @name Accessors
+  /// @{
+  std::size_t size() const;
+  std::size_t dropped() const;
+  /// @}
+
+  // Operators
+  TransactionStreamDecoderCache &operator=(TransactionStreamDecoderCache const &) = delete;
+  TransactionStreamDecoderCache &operator=(TransactionStreamDecoderCache &&) = delete;
+
+private:
+  using Timestamp  = moment::ClockInterface::Timestamp;
+  using DecoderPtr = std::unique_ptr<TransactionStreamDecoder>;
+  using Recency    = std::list<Address>;
+
+  struct Stream
+  {
+    DecoderPtr        decoder;
+    Timestamp         last_activity;
+    Recency::iterator position;  ///< The entry of the sender in the recency list
+  };
+
+  using Streams = std::unordered_map<Address, Stream>;
+
+  void ExpireIdleStreams(Timestamp const &now);
+  void Drop(Address const &from);
+
+  BatchHandler      handler_;
+  std::size_t const max_streams_;
+  Duration const    idle_timeout_;
+  moment::ClockPtr  clock_;
+  Streams           streams_;     ///< The decoders of the senders part way through a frame
+  Recency           recency_;     ///< The senders ordered from least to most recently active
+  std::size_t       dropped_{0};  ///< The number of partial streams expired or evicted
+};
+
+/**
+ * Get the number of senders which are currently part way through a frame
+ *
+ * @return The number of partial streams
+ */
+inline std::size_t TransactionStreamDecoderCache::size() const
+{
+  return streams_.size();
+}
+
+/**
+ * Get the number of partial streams which have been expired or evicted, discarding their frame
+ *
+ * @return The number of dropped streams
+ */
+inline std::size_t TransactionStreamDecoderCache::dropped() const
+{
+  return dropped_;
+}
+
+}  // namespace ledger
+}  // namespace fetch
@@ -88,6 +88,7 @@ private:
   SubmitTxStatus     SubmitJsonTx(http::HTTPRequest const &req, ConstByteArray expected_contract,
                                   TxHashes &txs);
   SubmitTxStatus     SubmitBulkTx(http::HTTPRequest const &req);
+  SubmitTxStatus     SubmitStreamTx(http::HTTPRequest const &req);
   /// @}
 
   /// @name Access Log
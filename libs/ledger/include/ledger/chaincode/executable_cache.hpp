@@ -0,0 +1,172 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/byte_array/const_byte_array.hpp"
+#include "core/serializers/main_serializer.hpp"
+#include "crypto/fnv.hpp"  // needed for std::hash<ConstByteArray>
+#include "storage/object_store.hpp"
+#include "telemetry/telemetry.hpp"
+#include "vm/executable_serializers.hpp"
+#include "vm/generator.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace fetch {
+
+namespace vm {
+class Module;
+}  // namespace vm
+
+namespace ledger {
+
+/**
+ * Content addressed cache of compiled smart contract executables.
+ *
+ * Executables are keyed by the digest of the contract source and the type and function tables of
+ * the module they were compiled against, so a contract is never run with bytecode that was
+ * generated for a different module. The most recently used executables are kept in memory and,
+ * once a store has been loaded, every compiled executable is also written to disk so that it
+ * survives eviction and restarts.
+ */
+class ExecutableCache
+{
+public:
+  using ConstByteArray = byte_array::ConstByteArray;
+  using Executable     = vm::Executable;
+  using ExecutablePtr  = std::shared_ptr<Executable>;
+  using Duration       = std::chrono::microseconds;
+
+  /**
+   * The serialized form of a cache entry
+   */
+  struct Record
+  {
+    Executable executable;
+    uint64_t   compile_time_us{0};  ///< The time taken to originally compile the executable
+  };
+
+  static constexpr char const *LOGGING_NAME        = "ExecutableCache";
+  static constexpr std::size_t DEFAULT_MAX_ENTRIES = 256;
+
+  static ExecutableCache &Instance();
+
+  static ConstByteArray CreateKey(ConstByteArray const &source_digest, vm::Module const &module);
+
+  // Construction / Destruction
+  explicit ExecutableCache(std::size_t max_entries = DEFAULT_MAX_ENTRIES);
+  ExecutableCache(ExecutableCache const &) = delete;
+  ExecutableCache(ExecutableCache &&)      = delete;
+  ~ExecutableCache()                       = default;
+
+  /// @name Persistence
+  /// @{
+  void Load(std::string const &prefix);
+  void New(std::string const &prefix);
+  /// @}
+
+  /// @name Cache Operations
+  /// @{
+  ExecutablePtr Lookup(ConstByteArray const &key);
+  void          Add(ConstByteArray const &key, ExecutablePtr executable, Duration compile_time);
+  void          Clear();
+  /// @}
+
+  /// @name Accessors
+  /// @{
+  std::size_t size() const;
+  std::size_t max_entries() const;
+  /// @}
+
+  // Operators
+  ExecutableCache &operator=(ExecutableCache const &) = delete;
+  ExecutableCache &operator=(ExecutableCache &&) = delete;
+
+private:
+  using Mutex    = std::mutex;
+  using Store    = storage::ObjectStore<Record>;
+  using StorePtr = std::unique_ptr<Store>;
+  using KeyList  = std::list<ConstByteArray>;
+
+  struct Element
+  {
+    ExecutablePtr     executable;
+    uint64_t          compile_time_us;
+    KeyList::iterator position;
+  };
+
+  using ElementMap = std::unordered_map<ConstByteArray, Element>;
+
+  void Insert(ConstByteArray const &key, ExecutablePtr executable, uint64_t compile_time_us);
+
+  std::size_t const max_entries_;
+
+  mutable Mutex lock_;
+  KeyList       recently_used_;  ///< Keys in order of use, most recent first
+  ElementMap    elements_;
+  StorePtr      store_;
+
+  /// @name Telemetry
+  /// @{
+  telemetry::CounterPtr memory_hit_count_;
+  telemetry::CounterPtr disk_hit_count_;
+  telemetry::CounterPtr miss_count_;
+  telemetry::CounterPtr eviction_count_;
+  telemetry::CounterPtr compile_time_saved_us_;
+  /// @}
+};
+
+}  // namespace ledger
+
+namespace serializers {
+
+template <typename D>
+struct MapSerializer<ledger::ExecutableCache::Record, D>
+{
+public:
+  using Type       = ledger::ExecutableCache::Record;
+  using DriverType = D;
+
+  static uint8_t const EXECUTABLE      = 1;
+  static uint8_t const COMPILE_TIME_US = 2;
+
+  template <typename Constructor>
+  static void Serialize(Constructor &map_constructor, Type const &record)
+  {
+    auto map = map_constructor(2);
+    map.Append(EXECUTABLE, record.executable);
+    map.Append(COMPILE_TIME_US, record.compile_time_us);
+  }
+
+  template <typename MapDeserializer>
+  static void Deserialize(MapDeserializer &map, Type &record)
+  {
+    map.ExpectKeyGetValue(EXECUTABLE, record.executable);
+    map.ExpectKeyGetValue(COMPILE_TIME_US, record.compile_time_us);
+  }
+};
+
+}  // namespace serializers
+}  // namespace fetch
@@ -18,9 +18,11 @@
 //------------------------------------------------------------------------------
 
 #include "core/bitvector.hpp"
+#include "ledger/chain/transaction.hpp"
 #include "ledger/executor_interface.hpp"
 
 #include <atomic>
+#include <cassert>
 #include <cstdint>
 #include <future>
 #include <memory>
@@ -37,6 +39,7 @@ public:
   using SliceIndex = ExecutorInterface::SliceIndex;
   using Status     = ExecutorInterface::Status;
   using Result     = ExecutorInterface::Result;
+  using TxPtr      = std::shared_ptr<Transaction const>;
 
   static constexpr char const *LOGGING_NAME = "ExecutionItem";
 
@@ -54,6 +57,8 @@ public:
   TokenAmount      fee() const;
   /// @}
 
+  void SetTransaction(TxPtr tx);
+
   void Execute(ExecutorInterface &executor);
 
   // Operators
@@ -69,6 +74,7 @@ private:
   BitVector   shards_;
   Result      result_;
   TokenAmount fee_{0};
+  TxPtr       tx_;  ///< The transaction, if it has already been retrieved from storage
 };
 
 inline ExecutionItem::ExecutionItem(Digest digest, BlockIndex block, SliceIndex slice,
@@ -99,11 +105,30 @@ inline uint64_t ExecutionItem::fee() const
   return fee_;
 }
 
+/**
+ * Provide the transaction for this item, so that the executor does not need to look it up
+ *
+ * @param tx The transaction, which must match the item's digest
+ */
+inline void ExecutionItem::SetTransaction(TxPtr tx)
+{
+  assert(!tx || (tx->digest() == digest_));
+  tx_ = std::move(tx);
+}
+
 inline void ExecutionItem::Execute(ExecutorInterface &executor)
 {
   try
   {
-    result_ = executor.Execute(digest_, block_, slice_, shards_);
+    if (tx_)
+    {
+      result_ = executor.ExecuteTransaction(*tx_, block_, slice_, shards_);
+    }
+    else
+    {
+      result_ = executor.Execute(digest_, block_, slice_, shards_);
+    }
+
     fee_ += result_.fee;
   }
   catch (std::exception const &ex)
@@ -112,6 +137,9 @@ inline void ExecutionItem::Execute(ExecutorInterface &executor)
 
     result_ = {ContractExecutionStatus::RESOURCE_FAILURE};
   }
+
+  // the transaction is not needed once it has been executed
+  tx_.reset();
 }
 
 }  // namespace ledger
@@ -48,6 +48,12 @@ namespace ledger {
 /**
  * The Execution Manager is the object which orchestrates the execution of a
  * specified block across a series of executors and lanes.
+ *
+ * Rather than executing the block slice by slice, the transactions of the block are arranged into a
+ * dependency graph based on the lanes which they touch. A transaction is dispatched to the thread
+ * pool as soon as all the (earlier) transactions which share a lane with it have completed. Since
+ * transactions which do not share a lane can not observe each other, the resulting state is
+ * identical to the one generated by slice ordered execution.
  */
 class ExecutionManager : public ExecutionManagerInterface,
                          public std::enable_shared_from_this<ExecutionManager>
@@ -83,27 +89,44 @@ public:
 private:
   struct Counters
   {
-    std::size_t active{0};
-    std::size_t remaining{0};
+    std::size_t active{0};     ///< The number of items dispatched but not yet completed
+    std::size_t remaining{0};  ///< The number of items yet to be completed
   };
 
-  using ExecutionItemPtr  = std::unique_ptr<ExecutionItem>;
-  using ExecutionItemList = std::vector<ExecutionItemPtr>;
-  using ExecutionPlan     = std::vector<ExecutionItemList>;
-  using ThreadPool        = fetch::network::ThreadPool;
-  using Mutex             = std::mutex;
-  using Counter           = std::atomic<std::size_t>;
-  using Flag              = std::atomic<bool>;
-  using StateHash         = StorageUnitInterface::Hash;
-  using ExecutorList      = std::vector<ExecutorPtr>;
-  using StateHashCache    = storage::ObjectStore<StateHash>;
-  using ThreadPtr         = std::unique_ptr<std::thread>;
-  using BlockSliceList    = ledger::Block::Slices;
-  using Condition         = std::condition_variable;
-  using ResourceID        = storage::ResourceID;
-  using AtomicState       = std::atomic<State>;
-  using CounterPtr        = telemetry::CounterPtr;
-  using HistogramPtr      = telemetry::HistogramPtr;
+  using ExecutionItemPtr = std::unique_ptr<ExecutionItem>;
+  using Counter          = std::atomic<std::size_t>;
+  using Flag             = std::atomic<bool>;
+
+  /**
+   * A node in the execution plan (dependency graph)
+   */
+  struct PlanEntry
+  {
+    explicit PlanEntry(ExecutionItemPtr i)
+      : item{std::move(i)}
+    {}
+
+    ExecutionItemPtr         item;
+    std::vector<std::size_t> dependents{};        ///< Entries waiting on this entry to complete
+    Counter                  num_dependencies{0};  ///< The number of outstanding dependencies
+    bool                     executed{false};      ///< Flag to signal the item was executed
+  };
+
+  using PlanEntryPtr   = std::unique_ptr<PlanEntry>;
+  using ExecutionPlan  = std::vector<PlanEntryPtr>;
+  using PlanIndices    = std::vector<std::size_t>;
+  using ThreadPool     = fetch::network::ThreadPool;
+  using Mutex          = std::mutex;
+  using StateHash      = StorageUnitInterface::Hash;
+  using ExecutorList   = std::vector<ExecutorPtr>;
+  using StateHashCache = storage::ObjectStore<StateHash>;
+  using ThreadPtr      = std::unique_ptr<std::thread>;
+  using BlockSliceList = ledger::Block::Slices;
+  using Condition      = std::condition_variable;
+  using ResourceID     = storage::ResourceID;
+  using AtomicState    = std::atomic<State>;
+  using CounterPtr     = telemetry::CounterPtr;
+  using HistogramPtr   = telemetry::HistogramPtr;
 
   uint32_t const log2_num_lanes_;
 
@@ -114,8 +137,10 @@ private:
 
   StorageUnitPtr storage_;
 
-  Mutex         execution_plan_lock_;  ///< guards `execution_plan_`
+  Mutex         execution_plan_lock_;  ///< guards `execution_plan_` & `plan_roots_`
   ExecutionPlan execution_plan_;
+  PlanIndices   plan_roots_;          ///< Entries without any dependencies
+  Flag          plan_aborted_{false};  ///< Signal that no further items should be dispatched
 
   Digest  last_block_hash_ = GENESIS_DIGEST;
   Address last_block_miner_{};
@@ -123,6 +148,7 @@ private:
   Mutex     monitor_lock_;
   Condition monitor_wake_;
   Condition monitor_notify_;
+  bool      execution_pending_{false};  ///< guarded by `monitor_lock_`
 
   Mutex        idle_executors_lock_;  ///< guards `idle_executors`
   ExecutorList idle_executors_;
@@ -141,12 +167,15 @@ private:
   CounterPtr   slices_executed_count_;
   CounterPtr   fees_settled_count_;
   CounterPtr   blocks_completed_count_;
+  CounterPtr   tx_prefetched_count_;
   HistogramPtr execution_duration_;
 
   void MonitorThreadEntrypoint();
 
   bool PlanExecution(Block::Body const &block);
-  void DispatchExecution(ExecutionItem &item);
+  void PrefetchTransactions();
+  void ScheduleExecution(std::size_t index);
+  void DispatchExecution(PlanEntry &entry);
 };
 
 }  // namespace ledger
@@ -54,6 +54,8 @@ public:
   Result Execute(Digest const &digest, BlockIndex block, SliceIndex slice,
                  BitVector const &shards) override;
   void   SettleFees(Address const &miner, TokenAmount amount, uint32_t log2_num_lanes) override;
+  Result ExecuteTransaction(Transaction const &tx, BlockIndex block, SliceIndex slice,
+                            BitVector const &shards) override;
   /// @}
 
 private:
@@ -61,11 +63,13 @@ private:
   using TransactionPtr          = std::shared_ptr<Transaction>;
   using CachedStorageAdapterPtr = std::shared_ptr<CachedStorageAdapter>;
 
-  bool RetrieveTransaction(Digest const &digest);
-  bool ValidationChecks(Result &result);
-  bool ExecuteTransactionContract(Result &result);
-  bool ProcessTransfers(Result &result);
-  void DeductFees(Result &result);
+  Result ExecuteCurrentTransaction(BlockIndex block, SliceIndex slice, BitVector const &shards);
+  bool   RetrieveTransaction(Digest const &digest);
+  void   PrefetchState();
+  bool   ValidationChecks(Result &result);
+  bool   ExecuteTransactionContract(Result &result);
+  bool   ProcessTransfers(Result &result);
+  void   DeductFees(Result &result);
 
   /// @name Resources
   /// @{
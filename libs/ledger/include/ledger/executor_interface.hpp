@@ -27,6 +27,7 @@ class BitVector;
 namespace ledger {
 
 class Address;
+class Transaction;
 
 class ExecutorInterface
 {
@@ -47,6 +48,9 @@ public:
   virtual Result Execute(Digest const &digest, BlockIndex block, SliceIndex slice,
                          BitVector const &shards)                                              = 0;
   virtual void   SettleFees(Address const &miner, TokenAmount amount, uint32_t log2_num_lanes) = 0;
+
+  virtual Result ExecuteTransaction(Transaction const &tx, BlockIndex block, SliceIndex slice,
+                                    BitVector const &shards);
   /// @}
 };
 
@@ -0,0 +1,195 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "crypto/fnv.hpp"  // needed for std::hash<ConstByteArray>
+#include "ledger/chain/block.hpp"
+#include "ledger/chain/digest.hpp"
+#include "network/muddle/packet.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace fetch {
+namespace ledger {
+
+/**
+ * Schedules the download of a known range of blocks from a set of peers.
+ *
+ * The range of block hashes is split into fixed size windows, each of which can be requested
+ * independently from any peer. Every peer has a limit on the number of windows it can have in
+ * flight. The limit grows by one with each successful response and is reset to one after a failure,
+ * so slow or faulty peers are given less work. Failed windows are retried, preferring a different
+ * peer, up to a maximum number of attempts.
+ *
+ * Completed windows are released strictly in chain order so that the blocks can be added to the
+ * main chain without creating loose blocks. To bound the memory used, only windows within a fixed
+ * distance of the oldest unreleased window are scheduled.
+ */
+class BlockDownloadScheduler
+{
+public:
+  using Address     = muddle::Packet::Address;
+  using Addresses   = std::vector<Address>;
+  using BlockHash   = Digest;
+  using BlockHashes = std::vector<BlockHash>;
+  using Blocks      = std::vector<Block>;
+  using WindowIndex = std::size_t;
+
+  static constexpr std::size_t DEFAULT_WINDOW_SIZE          = 250;
+  static constexpr std::size_t DEFAULT_MAX_IN_FLIGHT        = 4;
+  static constexpr std::size_t DEFAULT_MAX_BUFFERED_WINDOWS = 64;
+  static constexpr std::size_t DEFAULT_MAX_ATTEMPTS         = 8;
+
+  /**
+   * A request for a window of blocks. The blocks are requested by walking backwards from the
+   * newest block in the window (i.e. the same order as `MainChain::TimeTravel` with a negative
+   * limit).
+   */
+  struct Request
+  {
+    WindowIndex window{0};
+    Address     peer{};
+    BlockHash   last_hash{};
+    uint64_t    num_blocks{0};
+  };
+
+  using Requests = std::vector<Request>;
+
+  /**
+   * The outcome of handling the response to a window request
+   */
+  enum class ResponseStatus
+  {
+    ACCEPTED,    ///< The window has been downloaded
+    INCOMPLETE,  ///< The peer does not (yet) have all the blocks, the window will be retried
+    INVALID,     ///< The peer returned blocks which are not part of the chain being downloaded
+    UNEXPECTED,  ///< The window is not currently being downloaded from the peer
+  };
+
+  // Construction / Destruction
+  explicit BlockDownloadScheduler(std::size_t window_size          = DEFAULT_WINDOW_SIZE,
+                                  std::size_t max_in_flight        = DEFAULT_MAX_IN_FLIGHT,
+                                  std::size_t max_buffered_windows = DEFAULT_MAX_BUFFERED_WINDOWS,
+                                  std::size_t max_attempts         = DEFAULT_MAX_ATTEMPTS);
+  BlockDownloadScheduler(BlockDownloadScheduler const &) = delete;
+  BlockDownloadScheduler(BlockDownloadScheduler &&)      = delete;
+  ~BlockDownloadScheduler()                              = default;
+
+  /// @name Scheduling
+  /// @{
+  void           Reset(BlockHashes hashes);
+  void           Clear();
+  Requests       Schedule(Addresses const &peers);
+  ResponseStatus OnResponse(WindowIndex window, Address const &peer, Blocks blocks);
+  void           OnFailure(WindowIndex window, Address const &peer);
+  bool           PopCompleted(Address &peer, Blocks &blocks);
+  /// @}
+
+  /// @name Accessors
+  /// @{
+  bool        complete() const;
+  bool        failed() const;
+  std::size_t num_blocks() const;
+  std::size_t num_windows() const;
+  std::size_t num_in_flight() const;
+  std::size_t num_released() const;
+  /// @}
+
+  // Operators
+  BlockDownloadScheduler &operator=(BlockDownloadScheduler const &) = delete;
+  BlockDownloadScheduler &operator=(BlockDownloadScheduler &&) = delete;
+
+private:
+  enum class WindowState
+  {
+    PENDING,
+    IN_FLIGHT,
+    COMPLETE,
+    RELEASED,
+  };
+
+  struct Window
+  {
+    WindowState state{WindowState::PENDING};
+    std::size_t attempts{0};
+    Address     peer{};         ///< The peer the window was (or is being) downloaded from
+    Address     failed_peer{};  ///< The last peer which failed to supply the window
+    Blocks      blocks{};       ///< The downloaded blocks, newest first
+  };
+
+  struct PeerState
+  {
+    std::size_t in_flight{0};
+    std::size_t limit{1};
+  };
+
+  using Windows = std::vector<Window>;
+  using PeerMap = std::unordered_map<Address, PeerState>;
+
+  std::size_t WindowBegin(WindowIndex window) const;
+  std::size_t WindowEnd(WindowIndex window) const;
+  void        Complete(WindowIndex window, Address const &peer, bool success);
+
+  std::size_t const window_size_;
+  std::size_t const max_in_flight_;
+  std::size_t const max_buffered_windows_;
+  std::size_t const max_attempts_;
+
+  BlockHashes hashes_{};  ///< The hashes of the blocks to download, oldest first
+  Windows     windows_{};
+  PeerMap     peers_{};
+  WindowIndex next_release_{0};
+  std::size_t num_in_flight_{0};
+  bool        failed_{false};
+};
+
+inline bool BlockDownloadScheduler::complete() const
+{
+  return next_release_ == windows_.size();
+}
+
+inline bool BlockDownloadScheduler::failed() const
+{
+  return failed_;
+}
+
+inline std::size_t BlockDownloadScheduler::num_blocks() const
+{
+  return hashes_.size();
+}
+
+inline std::size_t BlockDownloadScheduler::num_windows() const
+{
+  return windows_.size();
+}
+
+inline std::size_t BlockDownloadScheduler::num_in_flight() const
+{
+  return num_in_flight_;
+}
+
+inline std::size_t BlockDownloadScheduler::num_released() const
+{
+  return next_release_;
+}
+
+}  // namespace ledger
+}  // namespace fetch
@@ -19,6 +19,7 @@
 
 #include "core/serializers/base_types.hpp"
 #include "core/service_ids.hpp"
+#include "ledger/chain/compact_block.hpp"
 #include "ledger/chain/main_chain.hpp"
 #include "network/service/protocol.hpp"
 
@@ -28,13 +29,18 @@ namespace ledger {
 class MainChainProtocol : public service::Protocol
 {
 public:
-  using Blocks = std::vector<Block>;
+  using Blocks             = std::vector<Block>;
+  using BlockHashes        = MainChain::BlockHashes;
+  using TransactionIndices = CompactBlock::TransactionIndices;
+  using TransactionLayouts = CompactBlock::TransactionLayouts;
 
   enum
   {
-    HEAVIEST_CHAIN   = 1,
-    TIME_TRAVEL      = 2,
-    COMMON_SUB_CHAIN = 3
+    HEAVIEST_CHAIN     = 1,
+    TIME_TRAVEL        = 2,
+    COMMON_SUB_CHAIN   = 3,
+    CHAIN_HASHES       = 4,
+    BLOCK_TRANSACTIONS = 5
   };
 
   explicit MainChainProtocol(MainChain &chain)
@@ -43,6 +49,8 @@ public:
     Expose(HEAVIEST_CHAIN, this, &MainChainProtocol::GetHeaviestChain);
     Expose(COMMON_SUB_CHAIN, this, &MainChainProtocol::GetCommonSubChain);
     Expose(TIME_TRAVEL, this, &MainChainProtocol::TimeTravel);
+    Expose(CHAIN_HASHES, this, &MainChainProtocol::GetChainHashes);
+    Expose(BLOCK_TRANSACTIONS, this, &MainChainProtocol::GetBlockTransactions);
   }
 
 private:
@@ -67,6 +75,48 @@ private:
     return Copy(chain_.TimeTravel(std::move(start), limit));
   }
 
+  /**
+   * Walk the chain backwards from the specified block (or the heaviest block when empty)
+   * collecting only the block hashes. This allows a syncing node to cheaply discover the blocks it
+   * is missing before downloading them.
+   */
+  BlockHashes GetChainHashes(Digest start, uint64_t limit)
+  {
+    if (start.empty())
+    {
+      start = chain_.GetHeaviestBlockHash();
+    }
+
+    auto const blocks = chain_.GetChainPreceding(std::move(start), limit);
+
+    BlockHashes hashes{};
+    hashes.reserve(blocks.size());
+
+    for (auto const &block : blocks)
+    {
+      hashes.push_back(block->body.hash);
+    }
+
+    return hashes;
+  }
+
+  /**
+   * Lookup the specified transactions from a block. This is used by peers reconstructing a
+   * compact block to fetch the transactions they are missing in a single round trip.
+   */
+  TransactionLayouts GetBlockTransactions(Digest hash, TransactionIndices indices)
+  {
+    TransactionLayouts layouts{};
+
+    auto const block = chain_.GetBlock(hash);
+    if (block && !CompactBlock::Extract(*block, indices, layouts))
+    {
+      layouts.clear();
+    }
+
+    return layouts;
+  }
+
   static Blocks Copy(MainChain::Blocks const &blocks)
   {
     Blocks output{};
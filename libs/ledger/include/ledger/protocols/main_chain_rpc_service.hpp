@@ -21,8 +21,11 @@
 #include "core/mutex.hpp"
 #include "core/random/lcg.hpp"
 #include "core/state_machine.hpp"
+#include "ledger/chain/compact_block.hpp"
 #include "ledger/chain/main_chain.hpp"
+#include "ledger/protocols/block_download_scheduler.hpp"
 #include "ledger/protocols/main_chain_rpc_protocol.hpp"
+#include "network/details/thread_pool.hpp"
 #include "network/generics/backgrounded_work.hpp"
 #include "network/generics/has_worker_thread.hpp"
 #include "network/generics/requesting_queue.hpp"
@@ -33,6 +36,7 @@
 #include "telemetry/telemetry.hpp"
 
 #include <memory>
+#include <unordered_map>
 
 namespace fetch {
 namespace ledger {
@@ -46,6 +50,15 @@ class MainChainSyncWorker;
  * around and nodes will attempt to determine the heaviest chain of their peers and specifically
  * request them. Peers are guarded by the main chain limiting request sizes.
  *
+ * When catching up, the node first collects the hashes of the blocks it is missing from a single
+ * peer. The blocks themselves are then downloaded in windows from all the directly connected peers
+ * concurrently and added to the chain in order.
+ *
+ * When configured with an index of recent transactions, the node also accepts new blocks in their
+ * compact form. Receivers rebuild the block from the transactions they have already seen and fetch
+ * any missing ones from the miner in a single request. Nodes without the index do not listen for
+ * compact blocks. New blocks are broadcast in full unless compact broadcasting is also enabled,
+ * which must only happen once every node on the network accepts compact blocks.
  */
 class MainChainRpcService : public muddle::rpc::Server,
                             public std::enable_shared_from_this<MainChainRpcService>
@@ -55,6 +68,7 @@ public:
   {
     REQUEST_HEAVIEST_CHAIN,
     WAIT_FOR_HEAVIEST_CHAIN,
+    DOWNLOADING_BLOCKS,
     SYNCHRONISING,
     WAITING_FOR_RESPONSE,
     SYNCHRONISED,
@@ -71,6 +85,8 @@ public:
   using RpcClient       = muddle::rpc::Client;
   using TrustSystem     = p2p::P2PTrustInterface<Address>;
   using FutureTimepoint = core::FutureTimepoint;
+  using BlockHashes     = MainChainProtocol::BlockHashes;
+  using RecentTxIndex   = RecentTransactionIndexPtr;
 
   static constexpr char const *LOGGING_NAME = "MainChainRpc";
 
@@ -82,10 +98,11 @@ public:
   };
 
   // Construction / Destruction
-  MainChainRpcService(MuddleEndpoint &endpoint, MainChain &chain, TrustSystem &trust, Mode mode);
+  MainChainRpcService(MuddleEndpoint &endpoint, MainChain &chain, TrustSystem &trust, Mode mode,
+                      RecentTxIndex recent_txs = {}, bool broadcast_compact = false);
   MainChainRpcService(MainChainRpcService const &) = delete;
   MainChainRpcService(MainChainRpcService &&)      = delete;
-  ~MainChainRpcService() override                  = default;
+  ~MainChainRpcService() override;
 
   core::WeakRunnable GetWeakRunnable()
   {
@@ -117,10 +134,46 @@ private:
   using BlockList       = fetch::ledger::MainChainProtocol::Blocks;
   using StateMachine    = core::StateMachine<State>;
   using StateMachinePtr = std::shared_ptr<StateMachine>;
+  using WindowIndex     = BlockDownloadScheduler::WindowIndex;
+  using ResponseStatus  = BlockDownloadScheduler::ResponseStatus;
+
+  struct DownloadRequest
+  {
+    Address         peer;
+    Promise         promise;
+    FutureTimepoint deadline;
+  };
+
+  using DownloadRequests   = std::unordered_map<WindowIndex, DownloadRequest>;
+  using TransactionIndices = MainChainProtocol::TransactionIndices;
+  using TransactionLayouts = MainChainProtocol::TransactionLayouts;
+  using ThreadPool         = network::ThreadPool;
+
+  struct CompactBlockRequest
+  {
+    Address            from;
+    Address            transmitter;
+    Block              block;    ///< The partially reconstructed block
+    TransactionIndices missing;  ///< The indices of the requested transactions
+    Promise            promise;
+    FutureTimepoint    deadline;
+  };
+
+  using CompactBlockRequests = std::unordered_map<BlockHash, CompactBlockRequest>;
 
   /// @name Subscription Handlers
   /// @{
   void OnNewBlock(Address const &from, Block &block, Address const &transmitter);
+  void OnNewCompactBlock(Address const &from, CompactBlock const &compact,
+                         Address const &transmitter);
+  /// @}
+
+  /// @name Compact Block Reconstruction
+  /// @{
+  bool CompleteCompactBlock(Address const &from, Block &block, Address const &transmitter);
+  void RequestBlockTransactions(Address const &from, Address const &transmitter, Block block,
+                                TransactionIndices missing);
+  void OnBlockTransactions(BlockHash const &hash);
   /// @}
 
   /// @name Utilities
@@ -129,12 +182,17 @@ private:
   Address                      GetRandomTrustedPeer() const;
   void                         HandleChainResponse(Address const &peer, BlockList block_list);
   bool                         IsBlockValid(Block &block) const;
+  void                         RequestChainHashes(BlockHash const &start);
+  bool                         AddChainHashes(BlockHashes const &hashes);
+  void                         CollectDownloads();
+  void                         ClearDownloads();
   /// @}
 
   /// @name State Machine Handlers
   /// @{
   State OnRequestHeaviestChain();
   State OnWaitForHeaviestChain();
+  State OnDownloadingBlocks();
   State OnSynchronising();
   State OnWaitingForResponse();
   State OnSynchronised(State current, State previous);
@@ -146,11 +204,14 @@ private:
   MuddleEndpoint &endpoint_;
   MainChain &     chain_;
   TrustSystem &   trust_;
+  RecentTxIndex   recent_txs_;
+  bool const      broadcast_compact_;
   /// @}
 
   /// @name RPC Server
   /// @{
   SubscriptionPtr   block_subscription_;
+  SubscriptionPtr   compact_block_subscription_;
   MainChainProtocol main_chain_protocol_;
   /// @}
 
@@ -161,6 +222,19 @@ private:
   Address         current_peer_address_;
   BlockHash       current_missing_block_;
   Promise         current_request_;
+  BlockHashes     sync_hashes_;  ///< The hashes of the missing blocks, newest first
+  /// @}
+
+  /// @name Block Download
+  /// @{
+  BlockDownloadScheduler download_scheduler_;
+  DownloadRequests       download_requests_;
+  /// @}
+
+  /// @name Compact Blocks
+  /// @{
+  Mutex                compact_lock_{__LINE__, __FILE__};
+  CompactBlockRequests compact_requests_;  ///< The blocks waiting for missing transactions
   /// @}
 
   /// @name Telemetry
@@ -172,11 +246,19 @@ private:
   telemetry::CounterPtr recv_block_invalid_count_;
   telemetry::CounterPtr state_request_heaviest_;
   telemetry::CounterPtr state_wait_heaviest_;
+  telemetry::CounterPtr state_downloading_;
   telemetry::CounterPtr state_synchronising_;
   telemetry::CounterPtr state_wait_response_;
   telemetry::CounterPtr state_synchronised_;
-
+  telemetry::CounterPtr download_block_count_;
+  telemetry::CounterPtr download_failure_count_;
+  telemetry::CounterPtr recv_compact_block_count_;
+  telemetry::CounterPtr compact_block_complete_count_;
+  telemetry::CounterPtr compact_block_fetched_tx_count_;
+  telemetry::CounterPtr compact_block_failure_count_;
   /// @}
+
+  ThreadPool thread_pool_;  ///< Completes compact blocks away from the network threads
 };
 
 constexpr char const *MainChainRpcService::ToString(State state) noexcept
@@ -187,6 +269,8 @@ constexpr char const *MainChainRpcService::ToString(State state) noexcept
     return "Requesting Heaviest Chain";
   case State::WAIT_FOR_HEAVIEST_CHAIN:
     return "Waiting for Heaviest Chain";
+  case State::DOWNLOADING_BLOCKS:
+    return "Downloading Blocks";
   case State::SYNCHRONISING:
     return "Synchronising";
   case State::WAITING_FOR_RESPONSE:
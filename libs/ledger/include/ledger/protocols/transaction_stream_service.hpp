@@ -0,0 +1,84 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/mutex.hpp"
+#include "ledger/chain/transaction_stream_decoder_cache.hpp"
+#include "network/muddle/muddle_endpoint.hpp"
+#include "network/muddle/subscription.hpp"
+#include "telemetry/telemetry.hpp"
+
+#include <cstddef>
+#include <memory>
+
+namespace fetch {
+namespace ledger {
+
+class TransactionProcessor;
+
+/**
+ * Ingests streams of transactions sent directly over the muddle by trusted gateways.
+ *
+ * Each message on the channel carries a run of length prefixed transaction frames (see
+ * `TransactionStreamDecoder`). A frame is allowed to span several messages from the same sender,
+ * so a decoder is kept for every sender which is part way through a frame (see
+ * `TransactionStreamDecoderCache`). Decoded transactions are handed to the transaction processor
+ * in batches.
+ */
+class TransactionStreamService
+{
+public:
+  using MuddleEndpoint  = muddle::MuddleEndpoint;
+  using Subscription    = muddle::Subscription;
+  using SubscriptionPtr = std::shared_ptr<Subscription>;
+  using Address         = muddle::Packet::Address;
+  using Payload         = muddle::Packet::Payload;
+
+  static constexpr char const *LOGGING_NAME = "TxStreamService";
+
+  // Construction / Destruction
+  TransactionStreamService(MuddleEndpoint &endpoint, TransactionProcessor &processor);
+  TransactionStreamService(TransactionStreamService const &) = delete;
+  TransactionStreamService(TransactionStreamService &&)      = delete;
+  ~TransactionStreamService()                                = default;
+
+  // Operators
+  TransactionStreamService &operator=(TransactionStreamService const &) = delete;
+  TransactionStreamService &operator=(TransactionStreamService &&) = delete;
+
+private:
+  using TransactionList = TransactionStreamDecoder::TransactionList;
+  using CounterPtr      = telemetry::CounterPtr;
+
+  void OnMessage(Address const &from, Payload const &payload);
+  void OnTransactions(TransactionList &&txs);
+
+  TransactionProcessor &        processor_;
+  TransactionStreamDecoderCache decoders_;  ///< Decoders of senders part way through a frame
+  SubscriptionPtr               subscription_;
+  Mutex                         lock_{__LINE__, __FILE__};
+
+  // telemetry
+  CounterPtr recv_message_count_;
+  CounterPtr recv_tx_count_;
+  CounterPtr recv_malformed_count_;
+  CounterPtr recv_dropped_count_;
+};
+
+}  // namespace ledger
+}  // namespace fetch
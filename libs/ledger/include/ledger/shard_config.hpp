@@ -21,6 +21,7 @@
 #include "network/muddle/network_id.hpp"
 
 #include <chrono>
+#include <cstdint>
 #include <vector>
 
 namespace fetch {
@@ -60,6 +61,12 @@ struct ShardConfig
   Timeperiod  sync_service_promise_timeout{2000};
   Timeperiod  sync_service_fetch_period{5000};
   /// @}
+
+  /// @name State Database Configuration
+  /// @{
+  uint64_t state_checkpoint_interval{0};  ///< Commits between state snapshots, zero disables them
+  uint64_t max_state_checkpoints{4};      ///< The number of state snapshots kept on disk
+  /// @}
 };
 
 using ShardConfigs = std::vector<ShardConfig>;
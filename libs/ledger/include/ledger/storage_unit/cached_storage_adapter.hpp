@@ -41,6 +41,7 @@ public:
 
   void Flush();
   void Clear();
+  void Prefetch(ResourceAddresses const &keys);
 
   /// @name State Interface
   /// @{
@@ -51,6 +52,9 @@ public:
   bool     Unlock(ShardIndex index) override;
   Keys     KeyDump() const override;
   void     Reset() override;
+
+  Documents GetMany(ResourceAddresses const &keys) override;
+  void      SetMany(KeyValues const &values) override;
   /// @}
 
 private:
@@ -60,8 +64,9 @@ private:
     bool       flushed{false};
 
     CacheEntry() = default;
-    explicit CacheEntry(StateValue v)
+    explicit CacheEntry(StateValue v, bool f = false)
       : value{std::move(v)}
+      , flushed{f}
     {}
   };
 
@@ -19,8 +19,6 @@
 
 #include "core/reactor.hpp"
 #include "ledger/shard_config.hpp"
-#include "network/generics/backgrounded_work.hpp"
-#include "network/generics/has_worker_thread.hpp"
 #include "network/muddle/muddle.hpp"
 #include "storage/object_store_protocol.hpp"
 #include "storage/transient_object_store.hpp"
@@ -104,9 +102,6 @@ private:
   using StateDbProto              = storage::RevertibleDocumentStoreProtocol;
   using TxStore                   = storage::TransientObjectStore<Transaction>;
   using TxStoreProto              = storage::ObjectStoreProtocol<Transaction>;
-  using BackgroundedWork          = network::BackgroundedWork<TransactionStoreSyncService>;
-  using BackgroundedWorkThread    = network::HasWorkerThread<BackgroundedWork>;
-  using BackgroundedWorkThreadPtr = std::shared_ptr<BackgroundedWorkThread>;
   using LaneControllerPtr         = std::shared_ptr<LaneController>;
   using LaneControllerProtocolPtr = std::shared_ptr<LaneControllerProtocol>;
   using StateDbPtr                = std::shared_ptr<StateDb>;
@@ -119,15 +114,11 @@ private:
   using LaneIdentityProtocolPtr   = std::shared_ptr<LaneIdentityProtocol>;
   using TxFinderProtocolPtr       = std::unique_ptr<TxFinderProtocol>;
 
-  static constexpr unsigned int SYNC_PERIOD_MS = 500;
-
   TxStorePtr tx_store_;
 
   Reactor reactor_;
 
-  ShardConfig const         cfg_;
-  BackgroundedWork          bg_work_;
-  BackgroundedWorkThreadPtr workthread_;
+  ShardConfig const cfg_;
 
   /// @name External P2P Network
   /// @{
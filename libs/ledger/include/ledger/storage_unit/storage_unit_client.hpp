@@ -73,11 +73,14 @@ public:
   bool      GetTransaction(ConstByteArray const &digest, Transaction &tx) override;
   bool      HasTransaction(ConstByteArray const &digest) override;
   void      IssueCallForMissingTxs(DigestSet const &tx_set) override;
+  bool      GetTransactions(Digests const &digests, Transactions &txs) override;
   TxLayouts PollRecentTx(uint32_t max_to_poll) override;
 
-  Document GetOrCreate(ResourceAddress const &key) override;
-  Document Get(ResourceAddress const &key) override;
-  void     Set(ResourceAddress const &key, StateValue const &value) override;
+  Document  GetOrCreate(ResourceAddress const &key) override;
+  Document  Get(ResourceAddress const &key) override;
+  void      Set(ResourceAddress const &key, StateValue const &value) override;
+  Documents GetMany(ResourceAddresses const &keys) override;
+  void      SetMany(KeyValues const &values) override;
 
   Keys KeyDump() const override;
   void Reset() override;
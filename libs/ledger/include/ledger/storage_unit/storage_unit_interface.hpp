@@ -23,6 +23,7 @@
 #include "storage/document.hpp"
 #include "storage/resource_mapper.hpp"
 
+#include <utility>
 #include <vector>
 
 namespace fetch {
@@ -33,11 +34,15 @@ class Transaction;
 class StorageInterface
 {
 public:
-  using Document        = storage::Document;
-  using ResourceAddress = storage::ResourceAddress;
-  using StateValue      = byte_array::ConstByteArray;
-  using ShardIndex      = uint32_t;
-  using Keys            = std::vector<storage::ResourceID>;
+  using Document          = storage::Document;
+  using Documents         = std::vector<Document>;
+  using ResourceAddress   = storage::ResourceAddress;
+  using ResourceAddresses = std::vector<ResourceAddress>;
+  using StateValue        = byte_array::ConstByteArray;
+  using KeyValue          = std::pair<ResourceAddress, StateValue>;
+  using KeyValues         = std::vector<KeyValue>;
+  using ShardIndex        = uint32_t;
+  using Keys              = std::vector<storage::ResourceID>;
 
   // Construction / Destruction
   StorageInterface()          = default;
@@ -53,6 +58,12 @@ public:
   virtual Keys     KeyDump() const                                          = 0;
   virtual void     Reset()                                                  = 0;
   /// @}
+
+  /// @name Batched State Interface
+  /// @{
+  virtual Documents GetMany(ResourceAddresses const &keys);
+  virtual void      SetMany(KeyValues const &values);
+  /// @}
 };
 
 class StorageUnitInterface : public StorageInterface
@@ -61,6 +72,8 @@ public:
   using Hash           = byte_array::ConstByteArray;
   using ConstByteArray = byte_array::ConstByteArray;
   using TxLayouts      = std::vector<TransactionLayout>;
+  using Digests        = std::vector<Digest>;
+  using Transactions   = std::vector<Transaction>;
 
   // Construction / Destruction
   StorageUnitInterface()           = default;
@@ -72,6 +85,8 @@ public:
   virtual bool GetTransaction(Digest const &digest, Transaction &tx) = 0;
   virtual bool HasTransaction(Digest const &digest)                  = 0;
   virtual void IssueCallForMissingTxs(DigestSet const &tx_set)       = 0;
+
+  virtual bool GetTransactions(Digests const &digests, Transactions &txs);
   /// @}
 
   virtual TxLayouts PollRecentTx(uint32_t) = 0;
@@ -0,0 +1,181 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "crypto/fnv.hpp"  // needed for std::hash<ConstByteArray>
+#include "network/muddle/packet.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <unordered_map>
+#include <vector>
+
+namespace fetch {
+namespace ledger {
+
+/**
+ * Schedules the pulling of the subtrees of a remote transaction store from a set of peers.
+ *
+ * The key space is split into subtrees identified by a prefix of the resource id. Any number of
+ * subtrees can be in flight at once, spread over all of the available peers. Each peer has a
+ * window which limits the number of its outstanding requests. The window is adapted from the
+ * measured round trip times: it grows by one while the latency stays close to the fastest latency
+ * observed for that peer, shrinks by one when the peer appears to be queuing requests and is
+ * halved after a failure. Request timeouts are derived from the smoothed round trip time and its
+ * variation in the same way as a TCP retransmission timeout.
+ *
+ * Responses which reach the pull limit are assumed to be truncated and the subtree is split into
+ * its two children, which are then pulled independently.
+ */
+class SubtreeSyncScheduler
+{
+public:
+  using Address    = muddle::Packet::Address;
+  using Addresses  = std::vector<Address>;
+  using Clock      = std::chrono::steady_clock;
+  using Timepoint  = Clock::time_point;
+  using Duration   = std::chrono::milliseconds;
+  using RequestId  = uint64_t;
+  using RequestIds = std::vector<RequestId>;
+
+  static constexpr uint32_t    DEFAULT_MAX_BITS       = 24;
+  static constexpr std::size_t DEFAULT_INITIAL_WINDOW = 2;
+  static constexpr std::size_t DEFAULT_MAX_WINDOW     = 32;
+
+  /**
+   * A subtree is the set of resource ids whose first `bits` bits match the `prefix`. The bits are
+   * ordered in the same way as the storage keys, i.e. least significant bit of the first byte first
+   */
+  struct Subtree
+  {
+    uint32_t prefix{0};
+    uint32_t bits{0};
+  };
+
+  struct Request
+  {
+    RequestId id{0};
+    Address   peer{};
+    Subtree   subtree{};
+  };
+
+  using Requests = std::vector<Request>;
+
+  // Construction / Destruction
+  SubtreeSyncScheduler(uint64_t pull_limit, Duration initial_timeout,
+                       std::size_t max_window = DEFAULT_MAX_WINDOW,
+                       uint32_t    max_bits   = DEFAULT_MAX_BITS);
+  SubtreeSyncScheduler(SubtreeSyncScheduler const &) = delete;
+  SubtreeSyncScheduler(SubtreeSyncScheduler &&)      = delete;
+  ~SubtreeSyncScheduler()                            = default;
+
+  /// @name Scheduling
+  /// @{
+  void       Reset(uint32_t bits);
+  void       Clear();
+  Requests   Schedule(Addresses const &peers, Timepoint const &now = Clock::now());
+  bool       OnResponse(RequestId id, std::size_t num_objects, Timepoint const &now = Clock::now());
+  void       OnFailure(RequestId id);
+  RequestIds Expire(Timepoint const &now = Clock::now());
+  /// @}
+
+  /// @name Accessors
+  /// @{
+  bool        complete() const;
+  std::size_t num_pending() const;
+  std::size_t num_in_flight() const;
+  std::size_t num_completed() const;
+  std::size_t GetWindow(Address const &peer) const;
+  Duration    GetTimeout(Address const &peer) const;
+  /// @}
+
+  // Operators
+  SubtreeSyncScheduler &operator=(SubtreeSyncScheduler const &) = delete;
+  SubtreeSyncScheduler &operator=(SubtreeSyncScheduler &&) = delete;
+
+private:
+  using Microseconds = std::chrono::microseconds;
+
+  struct PendingSubtree
+  {
+    Subtree subtree{};
+    Address failed_peer{};  ///< The last peer which failed to supply the subtree
+  };
+
+  struct InFlightSubtree
+  {
+    Subtree   subtree{};
+    Address   peer{};
+    Timepoint sent{};
+    Timepoint deadline{};
+  };
+
+  struct PeerState
+  {
+    std::size_t  in_flight{0};
+    std::size_t  window{DEFAULT_INITIAL_WINDOW};
+    bool         has_sample{false};
+    Microseconds min_rtt{0};
+    Microseconds srtt{0};
+    Microseconds rttvar{0};
+  };
+
+  using PendingQueue = std::deque<PendingSubtree>;
+  using InFlightMap  = std::unordered_map<RequestId, InFlightSubtree>;
+  using PeerMap      = std::unordered_map<Address, PeerState>;
+
+  Duration   CalculateTimeout(PeerState const &peer) const;
+  PeerState &LookupPeer(Address const &address);
+  void       Release(InFlightMap::iterator it, bool success);
+
+  uint64_t const    pull_limit_;
+  Duration const    initial_timeout_;
+  std::size_t const max_window_;
+  uint32_t const    max_bits_;
+
+  PendingQueue pending_{};
+  InFlightMap  in_flight_{};
+  PeerMap      peers_{};
+  RequestId    next_id_{1};
+  std::size_t  num_completed_{0};
+};
+
+inline bool SubtreeSyncScheduler::complete() const
+{
+  return pending_.empty() && in_flight_.empty();
+}
+
+inline std::size_t SubtreeSyncScheduler::num_pending() const
+{
+  return pending_.size();
+}
+
+inline std::size_t SubtreeSyncScheduler::num_in_flight() const
+{
+  return in_flight_.size();
+}
+
+inline std::size_t SubtreeSyncScheduler::num_completed() const
+{
+  return num_completed_;
+}
+
+}  // namespace ledger
+}  // namespace fetch
@@ -21,6 +21,7 @@
 #include "core/service_ids.hpp"
 #include "core/state_machine.hpp"
 #include "ledger/storage_unit/lane_controller.hpp"
+#include "ledger/storage_unit/subtree_sync_scheduler.hpp"
 #include "ledger/storage_unit/transaction_sinks.hpp"
 #include "ledger/transaction_verifier.hpp"
 #include "network/generics/promise_of.hpp"
@@ -36,7 +37,6 @@
 #include <cstdint>
 #include <functional>
 #include <memory>
-#include <queue>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -73,8 +73,9 @@ public:
   using PromiseOfObjectCount  = network::PromiseOf<uint64_t>;
   using TxArray               = std::vector<Transaction>;
   using RequestingTxList      = network::RequestingQueueOf<Address, TxArray>;
-  using RequestingSubTreeList = network::RequestingQueueOf<uint64_t, TxArray>;
   using PromiseOfTxList       = network::PromiseOf<TxArray>;
+  using SubtreeRequestId      = SubtreeSyncScheduler::RequestId;
+  using SubtreeRequests       = std::unordered_map<SubtreeRequestId, PromiseOfTxList>;
   using ResourceID            = storage::ResourceID;
   using EventNewTransaction   = std::function<void(Transaction const &)>;
   using TrimCacheCallback     = std::function<void()>;
@@ -86,8 +87,9 @@ public:
 
   static constexpr char const *LOGGING_NAME = "TransactionStoreSyncService";
   static constexpr std::size_t MAX_OBJECT_COUNT_RESOLUTION_PER_CYCLE = 128;
-  static constexpr std::size_t MAX_SUBTREE_RESOLUTION_PER_CYCLE      = 128;
   static constexpr std::size_t MAX_OBJECT_RESOLUTION_PER_CYCLE       = 128;
+  // Stop requesting further subtrees while the verifier is this far behind
+  static constexpr std::size_t MAX_VERIFIER_BACKLOG = 32768;
   // Limit the amount to be retrieved at once from the TxFinderProtocol
   static constexpr uint64_t TX_FINDER_PROTO_LIMIT = 1000;
   // Limit the amount a single rpc call will provide
@@ -100,6 +102,7 @@ public:
     std::chrono::milliseconds main_timeout{5000};
     std::chrono::milliseconds promise_wait_timeout{2000};
     std::chrono::milliseconds fetch_object_wait_duration{5000};
+    std::size_t               max_subtree_window{SubtreeSyncScheduler::DEFAULT_MAX_WINDOW};
   };
 
   TransactionStoreSyncService(Config const &cfg, MuddlePtr muddle, ObjectStorePtr store,
@@ -131,6 +134,11 @@ public:
     }
   }
 
+  core::WeakRunnable GetWeakRunnable()
+  {
+    return state_machine_;
+  }
+
 protected:
   void OnTransaction(TransactionPtr const &tx) override;
 
@@ -159,12 +167,9 @@ private:
   RequestingObjectCount pending_object_count_;
   uint64_t              max_object_count_;
 
-  RequestingSubTreeList pending_subtree_;
-  RequestingTxList      pending_objects_;
-
-  std::queue<uint8_t>                                          roots_to_sync_;
-  uint64_t                                                     root_size_ = 0;
-  std::unordered_map<PromiseOfTxList::PromiseCounter, uint8_t> promise_id_to_roots_;
+  SubtreeSyncScheduler subtree_scheduler_;
+  SubtreeRequests      pending_subtree_;
+  RequestingTxList     pending_objects_;
 
   std::atomic_bool is_ready_{false};
 };
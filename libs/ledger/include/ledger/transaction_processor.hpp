@@ -17,6 +17,7 @@
 //
 //------------------------------------------------------------------------------
 
+#include "ledger/chain/recent_transaction_index.hpp"
 #include "ledger/dag/dag_interface.hpp"
 #include "ledger/storage_unit/transaction_sinks.hpp"
 #include "ledger/transaction_verifier.hpp"
@@ -39,9 +40,11 @@ public:
   static constexpr char const *LOGGING_NAME = "TransactionProcessor";
   using DAGPtr                              = std::shared_ptr<::fetch::ledger::DAGInterface>;
   using TxStatusCachePtr                    = std::shared_ptr<TransactionStatusCache>;
+  using RecentTxIndexPtr                    = RecentTransactionIndexPtr;
   // Construction / Destruction
   TransactionProcessor(DAGPtr dag, StorageUnitInterface &storage, BlockPackerInterface &packer,
-                       TxStatusCachePtr tx_status_cache, std::size_t num_threads);
+                       TxStatusCachePtr tx_status_cache, std::size_t num_threads,
+                       RecentTxIndexPtr recent_txs = {});
   TransactionProcessor(TransactionProcessor const &) = delete;
   TransactionProcessor(TransactionProcessor &&)      = delete;
   ~TransactionProcessor() override;
@@ -56,6 +59,7 @@ public:
   /// @{
   void AddTransaction(TransactionPtr const &mtx);
   void AddTransaction(TransactionPtr &&mtx);
+  void AddTransactions(TransactionList &&txs);
   /// @}
 
   // Operators
@@ -73,6 +77,7 @@ private:
   StorageUnitInterface &storage_;
   BlockPackerInterface &packer_;
   TxStatusCachePtr      status_cache_;
+  RecentTxIndexPtr      recent_txs_;  ///< Optional index used to rebuild compact blocks
   TransactionVerifier   verifier_;
   ThreadPtr             poll_new_tx_thread_;
   Flag                  running_{false};
@@ -126,5 +131,15 @@ inline void TransactionProcessor::AddTransaction(TransactionPtr &&tx)
   verifier_.AddTransaction(std::move(tx));
 }
 
+/**
+ * Add a batch of transactions to the processor
+ *
+ * @param txs The transactions to be processed
+ */
+inline void TransactionProcessor::AddTransactions(TransactionList &&txs)
+{
+  verifier_.AddTransactions(std::move(txs));
+}
+
 }  // namespace ledger
 }  // namespace fetch
@@ -23,6 +23,7 @@
 #include <cstddef>
 #include <memory>
 #include <thread>
+#include <vector>
 
 namespace fetch {
 namespace ledger {
@@ -35,11 +36,14 @@ class TransactionVerifier
 public:
   static constexpr char const *LOGGING_NAME = "TxVerifier";
 
-  using TransactionPtr = std::shared_ptr<Transaction>;
+  using TransactionPtr  = std::shared_ptr<Transaction>;
+  using TransactionList = std::vector<TransactionPtr>;
+
+  static constexpr std::size_t DEFAULT_BATCH_SIZE = 64;
 
   // Construction / Destruction
   TransactionVerifier(TransactionSink &sink, std::size_t verifying_threads,
-                      std::string const &name);
+                      std::string const &name, std::size_t batch_size = DEFAULT_BATCH_SIZE);
   TransactionVerifier(TransactionVerifier const &) = delete;
   TransactionVerifier(TransactionVerifier &&)      = delete;
   ~TransactionVerifier();
@@ -54,8 +58,11 @@ public:
   /// @{
   void AddTransaction(TransactionPtr const &tx);
   void AddTransaction(TransactionPtr &&tx);
+  void AddTransactions(TransactionList &&txs);
   /// @}
 
+  std::size_t GetBacklog() const;
+
   // Operators
   TransactionVerifier &operator=(TransactionVerifier const &) = delete;
   TransactionVerifier &operator=(TransactionVerifier &&) = delete;
@@ -76,6 +83,7 @@ private:
   void Dispatcher();
 
   std::size_t const verifying_threads_;
+  std::size_t const batch_size_;
   std::string const name_;
   Sink &            sink_;
   Flag              active_{true};
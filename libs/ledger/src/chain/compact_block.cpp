@@ -0,0 +1,207 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "ledger/chain/compact_block.hpp"
+
+#include <utility>
+
+namespace fetch {
+namespace ledger {
+namespace {
+
+/**
+ * Locate a transaction in the block from its index across all the slices
+ *
+ * @param slices The slices of the block
+ * @param index The index of the transaction
+ * @return A pointer to the transaction if the index is in range, otherwise nullptr
+ */
+template <typename Slices>
+auto Locate(Slices &slices, uint64_t index) -> decltype(&slices[0][0])
+{
+  for (auto &slice : slices)
+  {
+    if (index < slice.size())
+    {
+      return &slice[index];
+    }
+
+    index -= slice.size();
+  }
+
+  return nullptr;
+}
+
+}  // namespace
+
+/**
+ * Build the compact form of the specified block
+ *
+ * @param block The full block
+ */
+CompactBlock::CompactBlock(Block const &block)
+{
+  // copy everything but the slice contents into the header
+  header.body.hash           = block.body.hash;
+  header.body.previous_hash  = block.body.previous_hash;
+  header.body.merkle_hash    = block.body.merkle_hash;
+  header.body.block_number   = block.body.block_number;
+  header.body.miner          = block.body.miner;
+  header.body.log2_num_lanes = block.body.log2_num_lanes;
+  header.body.dag_epoch      = block.body.dag_epoch;
+  header.body.timestamp      = block.body.timestamp;
+  header.nonce               = block.nonce;
+  header.proof               = block.proof;
+  header.weight              = block.weight;
+  header.total_weight        = block.total_weight;
+
+  slices.reserve(block.body.slices.size());
+  for (auto const &slice : block.body.slices)
+  {
+    ShortTxIds ids{};
+    ids.reserve(slice.size());
+
+    for (auto const &layout : slice)
+    {
+      ids.push_back(ToShortTxId(layout.digest()));
+    }
+
+    slices.emplace_back(std::move(ids));
+  }
+}
+
+/**
+ * Get the number of transactions present in the block
+ *
+ * @return The transaction count
+ */
+std::size_t CompactBlock::GetTransactionCount() const
+{
+  std::size_t count{0};
+
+  for (auto const &slice : slices)
+  {
+    count += slice.size();
+  }
+
+  return count;
+}
+
+/**
+ * Rebuild the full block from the transactions available in the local index.
+ *
+ * Transactions which are not available are left empty in the output block and their indices
+ * returned so that they can be requested from a peer. The caller is responsible for checking the
+ * digest of the completed block, since a short id collision can result in the wrong transaction
+ * being selected.
+ *
+ * @param index The index of recent transactions (can be null)
+ * @param block The output block
+ * @return The indices of the transactions which could not be found
+ */
+CompactBlock::TransactionIndices CompactBlock::Reconstruct(RecentTransactionIndex const *index,
+                                                           Block &block) const
+{
+  // layouts generated for a different lane configuration can not be used
+  bool const use_index =
+      (index != nullptr) && (index->log2_num_lanes() == header.body.log2_num_lanes);
+
+  block = header;
+  block.body.slices.resize(slices.size());
+
+  TransactionIndices missing{};
+  uint64_t           tx_index{0};
+
+  for (std::size_t i = 0; i < slices.size(); ++i)
+  {
+    auto const &ids   = slices[i];
+    auto &      slice = block.body.slices[i];
+
+    slice.resize(ids.size());
+    for (std::size_t j = 0; j < ids.size(); ++j, ++tx_index)
+    {
+      if (!(use_index && index->Lookup(ids[j], slice[j])))
+      {
+        missing.push_back(tx_index);
+      }
+    }
+  }
+
+  return missing;
+}
+
+/**
+ * Populate the missing transactions of a reconstructed block
+ *
+ * @param block The block being reconstructed
+ * @param indices The indices of the transactions
+ * @param layouts The layouts for each of the indices
+ * @return true if all the layouts were placed, otherwise false
+ */
+bool CompactBlock::Fill(Block &block, TransactionIndices const &indices,
+                        TransactionLayouts const &layouts)
+{
+  if (indices.size() != layouts.size())
+  {
+    return false;
+  }
+
+  for (std::size_t i = 0; i < indices.size(); ++i)
+  {
+    auto *layout = Locate(block.body.slices, indices[i]);
+    if (layout == nullptr)
+    {
+      return false;
+    }
+
+    *layout = layouts[i];
+  }
+
+  return true;
+}
+
+/**
+ * Collect the specified transactions from a full block
+ *
+ * @param block The full block
+ * @param indices The indices of the requested transactions
+ * @param layouts The output layouts in the same order as the indices
+ * @return true if all the indices were valid, otherwise false
+ */
+bool CompactBlock::Extract(Block const &block, TransactionIndices const &indices,
+                           TransactionLayouts &layouts)
+{
+  layouts.clear();
+  layouts.reserve(indices.size());
+
+  for (auto const index : indices)
+  {
+    auto const *layout = Locate(block.body.slices, index);
+    if (layout == nullptr)
+    {
+      return false;
+    }
+
+    layouts.push_back(*layout);
+  }
+
+  return true;
+}
+
+}  // namespace ledger
+}  // namespace fetch
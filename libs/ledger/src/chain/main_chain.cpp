@@ -69,7 +69,8 @@ MainChain::MainChain(bool const enable_bloom_filter, Mode mode)
   if (Mode::IN_MEMORY_DB != mode)
   {
     // create the block store
-    block_store_ = std::make_unique<BlockStore>();
+    block_store_    = std::make_unique<BlockStore>();
+    tx_index_store_ = std::make_unique<TxIndexStore>();
 
     RecoverFromFile(mode);
   }
@@ -90,6 +91,11 @@ MainChain::~MainChain()
   {
     block_store_->Flush(false);
   }
+
+  if (tx_index_store_)
+  {
+    tx_index_store_->Flush(false);
+  }
 }
 
 void MainChain::Reset()
@@ -101,10 +107,13 @@ void MainChain::Reset()
   loose_blocks_.clear();
   block_chain_.clear();
   references_.clear();
+  tx_index_.clear();
+  heaviest_chain_.clear();
 
   if (block_store_)
   {
     block_store_->New("chain.db", "chain.index.db");
+    tx_index_store_->New("chain.tx.db", "chain.tx.index.db");
     head_store_.close();
     head_store_.open("chain.head.db",
                      std::ios::binary | std::ios::in | std::ios::out | std::ios::trunc);
@@ -170,8 +179,17 @@ void MainChain::CacheBlock(IntBlockPtr const &block) const
  */
 MainChain::BlockMap::size_type MainChain::UncacheBlock(BlockHash const &hash) const
 {
-  return block_chain_.erase(hash);
+  auto const it = block_chain_.find(hash);
+  if (it == block_chain_.end())
+  {
+    return 0;
+  }
+
+  UnindexTransactions(*it->second);
+  block_chain_.erase(it);
+
   // references are kept intact while this cache is alive
+  return 1;
 }
 
 /**
@@ -219,6 +237,9 @@ void MainChain::KeepBlock(IntBlockPtr const &block) const
 
   // now write the block itself; if next_hash is genesis, it will be rewritten later by a child
   block_store_->Set(storage::ResourceID(hash), record);
+
+  // record the locations of all the transactions in this block
+  PersistTransactions(*block);
 }
 
 /**
@@ -259,6 +280,197 @@ void MainChain::AddBlockToBloomFilter(Block const &block) const
   }
 }
 
+/**
+ * Internal: Record the locations of all the transactions in the specified (cached) block
+ *
+ * @param block The block whose transactions should be indexed
+ */
+void MainChain::IndexTransactions(Block const &block) const
+{
+  for (auto const &slice : block.body.slices)
+  {
+    for (auto const &tx : slice)
+    {
+      auto &entries = tx_index_[tx.digest()];
+
+      bool const already_indexed =
+          std::any_of(entries.begin(), entries.end(), [&block](TransactionIndexEntry const &e) {
+            return e.block_hash == block.body.hash;
+          });
+
+      if (!already_indexed)
+      {
+        entries.push_back(TransactionIndexEntry{block.body.block_number, block.body.hash});
+      }
+    }
+  }
+}
+
+/**
+ * Internal: Remove the locations of all the transactions in the specified block from the in
+ * memory index. Any entries already written to the persistent index are unaffected.
+ *
+ * @param block The block whose transactions should be removed from the index
+ */
+void MainChain::UnindexTransactions(Block const &block) const
+{
+  for (auto const &slice : block.body.slices)
+  {
+    for (auto const &tx : slice)
+    {
+      auto it = tx_index_.find(tx.digest());
+      if (it == tx_index_.end())
+      {
+        continue;
+      }
+
+      auto &entries = it->second;
+      entries.erase(
+          std::remove_if(entries.begin(), entries.end(),
+                         [&block](TransactionIndexEntry const &e) {
+                           return e.block_hash == block.body.hash;
+                         }),
+          entries.end());
+
+      if (entries.empty())
+      {
+        tx_index_.erase(it);
+      }
+    }
+  }
+}
+
+/**
+ * Internal: Record the locations of all the transactions in the specified block in the persistent
+ * transaction index
+ *
+ * @param block The block (being written to the block store) whose transactions should be indexed
+ */
+void MainChain::PersistTransactions(Block const &block) const
+{
+  assert(static_cast<bool>(tx_index_store_));
+
+  // a transaction can appear in several (forked) blocks, so existing records must still be read,
+  // but all the updates for the block are written to the store in a single batch
+  tx_index_store_->WithBatch([this, &block]() {
+    for (auto const &slice : block.body.slices)
+    {
+      for (auto const &tx : slice)
+      {
+        storage::ResourceID const rid{tx.digest()};
+
+        TransactionIndexRecord record{};
+        tx_index_store_->LocklessGet(rid, record);
+
+        bool const already_indexed = std::any_of(
+            record.entries.begin(), record.entries.end(),
+            [&block](TransactionIndexEntry const &e) { return e.block_hash == block.body.hash; });
+
+        if (!already_indexed)
+        {
+          record.entries.push_back(TransactionIndexEntry{block.body.block_number, block.body.hash});
+          tx_index_store_->LocklessSet(rid, record);
+        }
+      }
+    }
+  });
+}
+
+/**
+ * Internal: Lookup all the known locations of a transaction in the chain
+ *
+ * @param[in] digest The digest of the transaction to lookup
+ * @param[out] entries The set of locations (blocks) in which the transaction has been seen
+ * @return true if at least one location was found, otherwise false
+ */
+bool MainChain::LookupTransaction(Digest const &digest, TransactionIndexEntries &entries) const
+{
+  entries.clear();
+
+  // persistent index (written blocks)
+  if (tx_index_store_)
+  {
+    TransactionIndexRecord record{};
+    if (tx_index_store_->Get(storage::ResourceID{digest}, record))
+    {
+      entries = std::move(record.entries);
+    }
+  }
+
+  // in memory index (cached blocks)
+  auto const it = tx_index_.find(digest);
+  if (it != tx_index_.end())
+  {
+    for (auto const &entry : it->second)
+    {
+      bool const duplicate =
+          std::any_of(entries.begin(), entries.end(), [&entry](TransactionIndexEntry const &e) {
+            return e.block_hash == entry.block_hash;
+          });
+
+      if (!duplicate)
+      {
+        entries.push_back(entry);
+      }
+    }
+  }
+
+  return !entries.empty();
+}
+
+/**
+ * Internal: Update the index of the heaviest chain (block number to block hash) to reflect the
+ * current heaviest tip.
+ *
+ * Only the section of the chain which differs from the previous heaviest chain is visited, so in
+ * the common case this will only look at a single block.
+ */
+void MainChain::UpdateHeaviestChainIndex() const
+{
+  FETCH_LOCK(lock_);
+
+  IntBlockPtr block;
+  if (!LookupBlock(heaviest_.hash, block, false))
+  {
+    FETCH_LOG_WARN(LOGGING_NAME, "Unable to locate heaviest block when updating chain index");
+    return;
+  }
+
+  // discard any entries that are ahead of the current heaviest block
+  heaviest_chain_.resize(block->body.block_number + 1);
+
+  for (;;)
+  {
+    auto &entry = heaviest_chain_[block->body.block_number];
+
+    // once the chains agree at a given height, all previous entries must also be the same
+    if (entry == block->body.hash)
+    {
+      break;
+    }
+
+    entry = block->body.hash;
+
+    if ((block->body.block_number == 0) ||
+        !LookupBlock(block->body.previous_hash, block, false))
+    {
+      break;
+    }
+  }
+}
+
+/**
+ * Internal: Determine if the specified block is part of the current heaviest chain
+ *
+ * @param block_number The block number of the block
+ * @param hash The hash of the block
+ * @return true if the block is on the heaviest chain, otherwise false
+ */
+bool MainChain::IsOnHeaviestChain(uint64_t block_number, BlockHash const &hash) const
+{
+  return (block_number < heaviest_chain_.size()) && (heaviest_chain_[block_number] == hash);
+}
+
 /**
  * Get the current heaviest block on the chain
  *
@@ -318,7 +530,7 @@ bool MainChain::RemoveTree(BlockHash const &removed_hash, BlockHashSet &invalida
       references_.erase(children.first, children.second);
 
       // next, remove the block record from the cache, if found
-      if (block_chain_.erase(hash))
+      if (UncacheBlock(hash))
       {
         retVal = true;
       }
@@ -732,6 +944,7 @@ void MainChain::RecoverFromFile(Mode mode)
   if (Mode::CREATE_PERSISTENT_DB == mode)
   {
     block_store_->New("chain.db", "chain.index.db");
+    tx_index_store_->New("chain.tx.db", "chain.tx.index.db");
     head_store_.open("chain.head.db",
                      std::ios::binary | std::ios::in | std::ios::out | std::ios::trunc);
     return;
@@ -739,6 +952,7 @@ void MainChain::RecoverFromFile(Mode mode)
   else if (Mode::LOAD_PERSISTENT_DB == mode)
   {
     block_store_->Load("chain.db", "chain.index.db");
+    tx_index_store_->Load("chain.tx.db", "chain.tx.index.db");
     head_store_.open("chain.head.db", std::ios::binary | std::ios::in | std::ios::out);
   }
   else
@@ -764,7 +978,12 @@ void MainChain::RecoverFromFile(Mode mode)
     // Copy head block so as to walk down the chain
     IntBlockPtr next = std::make_shared<Block>(*block);
 
-    while (LoadBlock(next->body.previous_hash, *next))
+    // since the walk visits every block on the stored chain, rebuild the heaviest chain index
+    heaviest_chain_.assign(block_index + 1, BlockHash{});
+    heaviest_chain_[block_index] = head_block_hash;
+
+    BlockHash next_hash = next->body.previous_hash;
+    while (LoadBlock(next_hash, *next))
     {
       if (next->body.block_number != block_index - 1)
       {
@@ -774,7 +993,9 @@ void MainChain::RecoverFromFile(Mode mode)
         break;
       }
 
-      block_index = next->body.block_number;
+      block_index                  = next->body.block_number;
+      heaviest_chain_[block_index] = next_hash;
+      next_hash                    = next->body.previous_hash;
     }
 
     if (block_index != 0)
@@ -822,7 +1043,10 @@ void MainChain::RecoverFromFile(Mode mode)
   // Recovering the chain has failed in some way, reset the storage.
   if (!recovery_complete)
   {
+    heaviest_chain_.clear();
+
     block_store_->New("chain.db", "chain.index.db");
+    tx_index_store_->New("chain.tx.db", "chain.tx.index.db");
 
     // reopen the file and clear the contents
     head_store_.close();
@@ -916,6 +1140,7 @@ void MainChain::WriteToFile()
 
     // Force flush of the file object!
     block_store_->Flush(false);
+    tx_index_store_->Flush(false);
 
     // as final step do some sanity checks
     TrimCache();
@@ -971,6 +1196,7 @@ void MainChain::TrimCache()
         }
 
         // remove the entry from the main block chain
+        UnindexTransactions(*chain_it->second);
         chain_it = block_chain_.erase(chain_it);
       }
       else
@@ -1209,11 +1435,13 @@ BlockStatus MainChain::InsertBlock(IntBlockPtr const &block, bool evaluate_loose
   // Add block
   FETCH_LOG_DEBUG(LOGGING_NAME, "Adding block to chain: 0x", block->body.hash.ToHex());
   AddBlockToCache(block);
+  IndexTransactions(*block);
 
   // If the heaviest branch has been updated we should determine if any blocks should be flushed
   // to disk
   if (heaviest_advanced)
   {
+    UpdateHeaviestChainIndex();
     WriteToFile();
   }
 
@@ -1518,6 +1746,9 @@ void MainChain::SetHeadHash(BlockHash const &hash)
 /**
  * Strip transactions in container that already exist in the blockchain
  *
+ * Transactions are checked against the transaction index, which records the blocks in which each
+ * transaction has been seen, rather than by walking the chain.
+ *
  * @param: starting_hash Block to start looking downwards from
  * @tparam: transaction The set of transaction to be filtered
  *
@@ -1551,41 +1782,63 @@ DigestSet MainChain::DetectDuplicateTransactions(BlockHash const &starting_hash,
     bloom_filter_query_count_->increment();
   }
 
-  auto search_chain_for_duplicates =
-      [this, block](DigestSet const &transaction_digests) mutable -> DigestSet {
-    DigestSet duplicates{};
-    for (;;)
+  DigestSet const &candidates = enable_bloom_filter_ ? potential_duplicates : transactions;
+  DigestSet         duplicates{};
+
+  if (!candidates.empty())
+  {
+    FETCH_LOCK(lock_);
+
+    // ensure that the heaviest chain index reflects any recent changes to the heaviest tip
+    UpdateHeaviestChainIndex();
+
+    // In the common case the starting block is on the heaviest chain, and ancestry can be checked
+    // directly against the heaviest chain index. Otherwise walk back along the fork until the
+    // heaviest chain is reached, recording the blocks which are exclusive to the fork.
+    BlockHashSet fork_blocks{};
+    bool         fork_point_found{true};
+    uint64_t     fork_point{block->body.block_number};
+
+    IntBlockPtr current{block};
+    while (!IsOnHeaviestChain(current->body.block_number, current->body.hash))
     {
-      // Traversing the chain fully is costly: break out early if we know the transactions are all
-      // duplicated (or both sets are empty)
-      if (transaction_digests.size() == duplicates.size())
+      fork_blocks.insert(current->body.hash);
+
+      if (!LookupBlock(current->body.previous_hash, current, false))
       {
+        fork_point_found = false;
         break;
       }
+    }
 
-      for (auto const &slice : block->body.slices)
+    if (fork_point_found)
+    {
+      fork_point = current->body.block_number;
+    }
+
+    TransactionIndexEntries entries{};
+    for (auto const &digest : candidates)
+    {
+      if (!LookupTransaction(digest, entries))
       {
-        for (auto const &tx : slice)
-        {
-          if (transaction_digests.find(tx.digest()) != transaction_digests.end())
-          {
-            duplicates.insert(tx.digest());
-          }
-        }
+        continue;
       }
 
-      // exit the loop once we can no longer find the block
-      if (!LookupBlock(block->body.previous_hash, block, false))
+      for (auto const &entry : entries)
       {
-        break;
+        bool const is_ancestor =
+            (fork_blocks.find(entry.block_hash) != fork_blocks.end()) ||
+            (fork_point_found && (entry.block_number <= fork_point) &&
+             IsOnHeaviestChain(entry.block_number, entry.block_hash));
+
+        if (is_ancestor)
+        {
+          duplicates.insert(digest);
+          break;
+        }
       }
     }
-
-    return duplicates;
-  };
-
-  DigestSet const duplicates =
-      search_chain_for_duplicates(enable_bloom_filter_ ? potential_duplicates : transactions);
+  }
 
   auto const false_positives = potential_duplicates.size() - duplicates.size();
 
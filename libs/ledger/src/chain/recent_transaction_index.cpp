@@ -0,0 +1,132 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "ledger/chain/recent_transaction_index.hpp"
+#include "ledger/chain/transaction.hpp"
+
+#include <algorithm>
+
+namespace fetch {
+namespace ledger {
+
+constexpr std::size_t RecentTransactionIndex::DEFAULT_CAPACITY;
+
+/**
+ * Compute the short id for a transaction digest
+ *
+ * @param digest The full transaction digest
+ * @return The short id, formed from (up to) the first 8 bytes of the digest in little endian order
+ */
+ShortTxId ToShortTxId(Digest const &digest)
+{
+  std::size_t const length = std::min(digest.size(), sizeof(ShortTxId));
+
+  ShortTxId id{0};
+  for (std::size_t i = 0; i < length; ++i)
+  {
+    id |= static_cast<ShortTxId>(digest[i]) << (8u * i);
+  }
+
+  return id;
+}
+
+/**
+ * Construct the index
+ *
+ * @param log2_num_lanes The lane configuration used when generating layouts from transactions
+ * @param capacity The maximum number of layouts to retain
+ */
+RecentTransactionIndex::RecentTransactionIndex(uint32_t log2_num_lanes, std::size_t capacity)
+  : log2_num_lanes_{log2_num_lanes}
+  , capacity_{std::max<std::size_t>(capacity, 1)}
+{}
+
+/**
+ * Add a newly seen transaction to the index
+ *
+ * @param tx The transaction to be added
+ */
+void RecentTransactionIndex::Add(Transaction const &tx)
+{
+  Add(TransactionLayout{tx, log2_num_lanes_});
+}
+
+/**
+ * Add the layout of a newly seen transaction to the index
+ *
+ * @param layout The layout to be added
+ */
+void RecentTransactionIndex::Add(TransactionLayout const &layout)
+{
+  ShortTxId const id = ToShortTxId(layout.digest());
+
+  FETCH_LOCK(lock_);
+
+  auto it = layouts_.find(id);
+  if (it != layouts_.end())
+  {
+    // the entry keeps its original position in the eviction order
+    it->second = layout;
+    return;
+  }
+
+  // make room for the new entry
+  while (order_.size() >= capacity_)
+  {
+    layouts_.erase(order_.front());
+    order_.pop_front();
+  }
+
+  layouts_.emplace(id, layout);
+  order_.push_back(id);
+}
+
+/**
+ * Lookup a transaction layout from its short id
+ *
+ * @param id The short id of the transaction
+ * @param layout The output layout, populated when found
+ * @return true if the transaction was found, otherwise false
+ */
+bool RecentTransactionIndex::Lookup(ShortTxId id, TransactionLayout &layout) const
+{
+  FETCH_LOCK(lock_);
+
+  auto it = layouts_.find(id);
+  if (it == layouts_.end())
+  {
+    return false;
+  }
+
+  layout = it->second;
+  return true;
+}
+
+/**
+ * Get the number of transactions in the index
+ *
+ * @return The number of transactions
+ */
+std::size_t RecentTransactionIndex::size() const
+{
+  FETCH_LOCK(lock_);
+  return layouts_.size();
+}
+
+}  // namespace ledger
+}  // namespace fetch
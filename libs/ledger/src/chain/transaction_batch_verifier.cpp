@@ -0,0 +1,151 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/logging.hpp"
+#include "ledger/chain/transaction.hpp"
+#include "ledger/chain/transaction_batch_verifier.hpp"
+#include "ledger/chain/transaction_serializer.hpp"
+
+#include <cassert>
+#include <exception>
+
+namespace fetch {
+namespace ledger {
+
+constexpr std::size_t TransactionBatchVerifier::DEFAULT_MAX_CACHED_KEYS;
+
+namespace {
+
+constexpr char const *LOGGING_NAME = "TxBatchVerifier";
+
+}  // namespace
+
+/**
+ * Construct the batch verifier
+ *
+ * @param max_cached_keys The maximum number of decoded public keys to be retained between batches
+ */
+TransactionBatchVerifier::TransactionBatchVerifier(std::size_t max_cached_keys)
+  : max_cached_keys_{max_cached_keys}
+{}
+
+/**
+ * Verify all the transactions in the batch. The result of the verification is stored in each
+ * transaction in the same way as `Transaction::Verify` and can be queried with `IsVerified`.
+ *
+ * @param batch The transactions to be verified
+ */
+void TransactionBatchVerifier::Verify(Batch const &batch)
+{
+  digests_.resize(batch.size());
+
+  // hash all the transaction payloads
+  for (std::size_t i = 0; i < batch.size(); ++i)
+  {
+    Transaction const &tx = *batch[i];
+
+    if (tx.verification_completed_ || tx.signatories_.empty())
+    {
+      continue;
+    }
+
+    hasher_.Reset();
+    hasher_.Update(TransactionSerializer::SerializePayload(tx));
+    digests_[i] = hasher_.Final();
+  }
+
+  // verify all the signatures
+  for (std::size_t i = 0; i < batch.size(); ++i)
+  {
+    Transaction &tx = *batch[i];
+
+    if (tx.verification_completed_)
+    {
+      continue;
+    }
+
+    bool verified{false};
+    try
+    {
+      verified = !tx.signatories_.empty() && VerifySignatures(tx, digests_[i]);
+    }
+    catch (std::exception const &e)
+    {
+      FETCH_LOG_WARN(LOGGING_NAME, "Unable to verify transaction: 0x", tx.digest().ToHex(), " - ",
+                     e.what());
+    }
+
+    tx.verified_               = verified;
+    tx.verification_completed_ = true;
+  }
+}
+
+/**
+ * Internal: Look up (or decode and cache) the verifier for the specified identity
+ *
+ * @param identity The identity of the signatory
+ * @return The verifier for the identity
+ */
+TransactionBatchVerifier::Verifier const &TransactionBatchVerifier::LookupVerifier(
+    crypto::Identity const &identity)
+{
+  auto it = keys_.find(identity);
+  if (it == keys_.end())
+  {
+    // decode the key before making room so that invalid keys do not flush the cache
+    Verifier verifier{identity};
+
+    // the cache only exists to avoid the key parsing cost for repeat senders, so rather than
+    // tracking usage it is simply flushed when full
+    if (keys_.size() >= max_cached_keys_)
+    {
+      keys_.clear();
+    }
+
+    it = keys_.emplace(identity, std::move(verifier)).first;
+  }
+
+  return it->second;
+}
+
+/**
+ * Internal: Check all the signatures of a transaction against its payload digest
+ *
+ * @param tx The transaction to be checked
+ * @param digest The digest of the transaction payload
+ * @return true if all the signatures are valid, otherwise false
+ */
+bool TransactionBatchVerifier::VerifySignatures(Transaction const &tx,
+                                                byte_array::ConstByteArray const &digest)
+{
+  for (auto const &signatory : tx.signatories_)
+  {
+    if (!LookupVerifier(signatory.identity).VerifyHash(digest, signatory.signature))
+    {
+      return false;
+    }
+
+    // ensure is well formed
+    assert(!signatory.address.address().empty());
+  }
+
+  return true;
+}
+
+}  // namespace ledger
+}  // namespace fetch
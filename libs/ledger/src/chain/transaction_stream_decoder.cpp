@@ -0,0 +1,242 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/logging.hpp"
+#include "ledger/chain/transaction.hpp"
+#include "ledger/chain/transaction_serializer.hpp"
+#include "ledger/chain/transaction_stream_decoder.hpp"
+
+#include <algorithm>
+#include <exception>
+#include <utility>
+
+namespace fetch {
+namespace ledger {
+
+constexpr char const *TransactionStreamDecoder::LOGGING_NAME;
+constexpr std::size_t TransactionStreamDecoder::PREFIX_SIZE;
+constexpr std::size_t TransactionStreamDecoder::MAX_FRAME_SIZE;
+constexpr std::size_t TransactionStreamDecoder::DEFAULT_BATCH_SIZE;
+
+namespace {
+
+using byte_array::ByteArray;
+using byte_array::ConstByteArray;
+
+std::size_t ReadFrameLength(uint8_t const *prefix)
+{
+  return static_cast<std::size_t>(prefix[0]) | (static_cast<std::size_t>(prefix[1]) << 8u) |
+         (static_cast<std::size_t>(prefix[2]) << 16u) |
+         (static_cast<std::size_t>(prefix[3]) << 24u);
+}
+
+bool IsValidFrameLength(std::size_t length)
+{
+  return (length > 0) && (length <= TransactionStreamDecoder::MAX_FRAME_SIZE);
+}
+
+}  // namespace
+
+/**
+ * Construct a stream decoder
+ *
+ * @param handler The handler to be called with each batch of decoded transactions
+ * @param batch_size The maximum number of transactions handed to the handler in one go
+ */
+TransactionStreamDecoder::TransactionStreamDecoder(BatchHandler handler, std::size_t batch_size)
+  : handler_{std::move(handler)}
+  , batch_size_{std::max<std::size_t>(batch_size, 1)}
+{
+  batch_.reserve(batch_size_);
+}
+
+/**
+ * Feed the next chunk of the stream into the decoder
+ *
+ * @param chunk The next chunk of the stream
+ * @return true if the stream is still valid, otherwise false
+ */
+bool TransactionStreamDecoder::Feed(ConstByteArray const &chunk)
+{
+  if (corrupted_)
+  {
+    return false;
+  }
+
+  std::size_t offset{0};
+
+  // complete the frame which was left over from the previous chunk(s)
+  if (!partial_.empty())
+  {
+    offset = FillPartialFrame(chunk);
+  }
+
+  // decode all the frames which are wholly contained within this chunk
+  while (!corrupted_ && ((offset + PREFIX_SIZE) <= chunk.size()))
+  {
+    std::size_t const length = ReadFrameLength(chunk.pointer() + offset);
+    if (!IsValidFrameLength(length))
+    {
+      FETCH_LOG_WARN(LOGGING_NAME, "Invalid frame length: ", length);
+      corrupted_ = true;
+      break;
+    }
+
+    if ((offset + PREFIX_SIZE + length) > chunk.size())
+    {
+      break;
+    }
+
+    DecodeFrame(chunk.SubArray(offset + PREFIX_SIZE, length));
+    offset += PREFIX_SIZE + length;
+  }
+
+  // retain the start of the frame which continues into the next chunk
+  if (!corrupted_ && (offset < chunk.size()))
+  {
+    partial_.Append(chunk.SubArray(offset));
+  }
+
+  FlushBatch();
+
+  if (corrupted_)
+  {
+    partial_ = ByteArray{};
+  }
+
+  return !corrupted_;
+}
+
+/**
+ * Internal: Copy as much of the partial frame as is available from the start of the chunk and
+ * decode it if it has been completed.
+ *
+ * @param chunk The chunk that has just been received
+ * @return The offset into the chunk of the first byte after the partial frame
+ */
+std::size_t TransactionStreamDecoder::FillPartialFrame(ConstByteArray const &chunk)
+{
+  std::size_t offset{0};
+
+  // complete the length prefix
+  if (partial_.size() < PREFIX_SIZE)
+  {
+    offset = std::min(PREFIX_SIZE - partial_.size(), chunk.size());
+    partial_.Append(chunk.SubArray(0, offset));
+
+    if (partial_.size() < PREFIX_SIZE)
+    {
+      return offset;
+    }
+  }
+
+  std::size_t const length = ReadFrameLength(partial_.pointer());
+  if (!IsValidFrameLength(length))
+  {
+    FETCH_LOG_WARN(LOGGING_NAME, "Invalid frame length: ", length);
+    corrupted_ = true;
+    return chunk.size();
+  }
+
+  // copy over the remainder of the frame that is available
+  std::size_t const frame_size = PREFIX_SIZE + length;
+  std::size_t const available  = std::min(frame_size - partial_.size(), chunk.size() - offset);
+  if (available > 0)
+  {
+    partial_.Reserve(frame_size);
+    partial_.Append(chunk.SubArray(offset, available));
+    offset += available;
+  }
+
+  if (partial_.size() == frame_size)
+  {
+    // the reassembly buffer is handed over, the next partial frame starts a fresh one
+    ByteArray const frame{std::move(partial_)};
+    partial_ = ByteArray{};
+
+    DecodeFrame(frame.SubArray(PREFIX_SIZE, length));
+  }
+
+  return offset;
+}
+
+/**
+ * Internal: Decode a single transaction frame and add it to the current batch
+ *
+ * @param frame The encoded transaction
+ */
+void TransactionStreamDecoder::DecodeFrame(ConstByteArray const &frame)
+{
+  ++received_;
+
+  try
+  {
+    auto tx = std::make_shared<Transaction>();
+
+    TransactionSerializer serializer{frame};
+    if (serializer.Deserialize(*tx))
+    {
+      ++decoded_;
+      batch_.emplace_back(std::move(tx));
+
+      if (batch_.size() >= batch_size_)
+      {
+        FlushBatch();
+      }
+    }
+    else
+    {
+      FETCH_LOG_DEBUG(LOGGING_NAME, "Discarding malformed transaction frame");
+    }
+  }
+  catch (std::exception const &ex)
+  {
+    FETCH_LOG_DEBUG(LOGGING_NAME, "Unable to decode transaction frame: ", ex.what());
+  }
+}
+
+/**
+ * Internal: Hand the current batch of decoded transactions over to the handler
+ */
+void TransactionStreamDecoder::FlushBatch()
+{
+  if (batch_.empty())
+  {
+    return;
+  }
+
+  if (handler_)
+  {
+    handler_(std::move(batch_));
+  }
+
+  batch_ = TransactionList{};
+  batch_.reserve(batch_size_);
+}
+
+void AppendTransactionFrame(ByteArray &stream, ConstByteArray const &encoded_tx)
+{
+  auto const length = static_cast<uint32_t>(encoded_tx.size());
+
+  stream.Append(static_cast<uint8_t>(length), static_cast<uint8_t>(length >> 8u),
+                static_cast<uint8_t>(length >> 16u), static_cast<uint8_t>(length >> 24u),
+                encoded_tx);
+}
+
+}  // namespace ledger
+}  // namespace fetch
@@ -0,0 +1,133 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "ledger/chain/transaction_stream_decoder_cache.hpp"
+#include "moment/clocks.hpp"
+
+#include <algorithm>
+#include <utility>
+
+namespace fetch {
+namespace ledger {
+
+constexpr char const *         TransactionStreamDecoderCache::CLOCK_NAME;
+constexpr std::size_t          TransactionStreamDecoderCache::DEFAULT_MAX_STREAMS;
+constexpr std::chrono::seconds TransactionStreamDecoderCache::DEFAULT_IDLE_TIMEOUT;
+
+/**
+ * Construct the decoder cache
+ *
+ * @param handler The handler to be called with each batch of decoded transactions
+ * @param max_streams The maximum number of partial streams which are kept
+ * @param idle_timeout The time after which a partial stream without progress is expired
+ */
+TransactionStreamDecoderCache::TransactionStreamDecoderCache(BatchHandler handler,
+                                                             std::size_t  max_streams,
+                                                             Duration     idle_timeout)
+  : handler_{std::move(handler)}
+  , max_streams_{std::max<std::size_t>(max_streams, 1)}
+  , idle_timeout_{idle_timeout}
+  , clock_{moment::GetClock(CLOCK_NAME)}
+{}
+
+/**
+ * Feed the next chunk of a sender's stream into its decoder
+ *
+ * @param from The sender of the stream
+ * @param chunk The next chunk of the stream
+ * @return true if the stream is still valid, otherwise false
+ */
+bool TransactionStreamDecoderCache::Feed(Address const &from, ConstByteArray const &chunk)
+{
+  auto const now = clock_->Now();
+
+  ExpireIdleStreams(now);
+
+  // lookup the decoder for a frame which is already in progress, otherwise create a new one
+  auto it = streams_.find(from);
+  if (it == streams_.end())
+  {
+    if (streams_.size() >= max_streams_)
+    {
+      Drop(recency_.front());
+    }
+
+    it = streams_.emplace(from, Stream{std::make_unique<TransactionStreamDecoder>(handler_), now,
+                                       recency_.end()})
+             .first;
+  }
+  else
+  {
+    recency_.erase(it->second.position);
+  }
+
+  auto &stream  = it->second;
+  bool  success = stream.decoder->Feed(chunk);
+
+  // only the senders which are part way through a frame need to keep their decoder
+  if (stream.decoder->corrupted() || (stream.decoder->buffered() == 0))
+  {
+    streams_.erase(it);
+  }
+  else
+  {
+    stream.last_activity = now;
+    stream.position      = recency_.insert(recency_.end(), from);
+  }
+
+  return success;
+}
+
+/**
+ * Internal: Expire the partial streams which have made no progress within the idle timeout
+ *
+ * @param now The current time
+ */
+void TransactionStreamDecoderCache::ExpireIdleStreams(Timestamp const &now)
+{
+  while (!recency_.empty())
+  {
+    auto const &stream = streams_.at(recency_.front());
+    if ((now - stream.last_activity) < idle_timeout_)
+    {
+      break;
+    }
+
+    Drop(recency_.front());
+  }
+}
+
+/**
+ * Internal: Discard the partial stream of a sender
+ *
+ * @param from The sender whose stream is discarded
+ */
+void TransactionStreamDecoderCache::Drop(Address const &from)
+{
+  auto it = streams_.find(from);
+  if (it != streams_.end())
+  {
+    recency_.erase(it->second.position);
+    streams_.erase(it);
+
+    ++dropped_;
+  }
+}
+
+}  // namespace ledger
+}  // namespace fetch
@@ -25,6 +25,7 @@
 #include "http/json_response.hpp"
 #include "ledger/chain/json_transaction.hpp"
 #include "ledger/chain/transaction.hpp"
+#include "ledger/chain/transaction_stream_decoder.hpp"
 #include "ledger/chaincode/contract.hpp"
 #include "ledger/chaincode/contract_http_interface.hpp"
 #include "ledger/state_adapter.hpp"
@@ -268,6 +269,11 @@ http::HTTPResponse ContractHttpInterface::OnTransaction(http::HTTPRequest const
       submitted      = SubmitBulkTx(request);
       unknown_format = false;
     }
+    else if (content_type == "application/vnd.fetch-ai.transaction+stream")
+    {
+      submitted      = SubmitStreamTx(request);
+      unknown_format = false;
+    }
 
     // record the transaction in the access log
     RecordTransaction(submitted, request, expected_contract);
@@ -405,6 +411,43 @@ ContractHttpInterface::SubmitTxStatus ContractHttpInterface::SubmitBulkTx(
   return SubmitTxStatus{submitted, encoded_txs.size()};
 }
 
+/**
+ * Method handles incoming http request containing a stream of length prefixed binary
+ * transactions (see `TransactionStreamDecoder`). The body is typically uploaded with chunked
+ * transfer encoding. Transactions are sliced directly out of the request body and handed to the
+ * processor in batches.
+ *
+ * @param request http request containing the transaction stream
+ * @return submit status, please see the `SubmitTxStatus` structure
+ */
+ContractHttpInterface::SubmitTxStatus ContractHttpInterface::SubmitStreamTx(
+    http::HTTPRequest const &request)
+{
+  std::size_t submitted{0};
+
+  TransactionStreamDecoder decoder{[this, &submitted](TransactionProcessor::TransactionList &&txs) {
+    submitted += txs.size();
+    processor_.AddTransactions(std::move(txs));
+  }};
+
+  decoder.Feed(request.body());
+
+  std::size_t received = decoder.received();
+
+  // a broken or truncated stream is reported as a received, but unprocessed, transaction
+  if (decoder.corrupted() || (decoder.buffered() > 0))
+  {
+    FETCH_LOG_WARN(LOGGING_NAME, "Malformed transaction stream from ",
+                   request.originating_address(), ':', request.originating_port());
+    ++received;
+  }
+
+  FETCH_LOG_DEBUG(LOGGING_NAME, "Submitted ", submitted, " streamed transactions from ",
+                  request.originating_address(), ':', request.originating_port());
+
+  return SubmitTxStatus{submitted, received};
+}
+
 /**
  * Record a transaction submission event in the HTTP access log
  *
@@ -0,0 +1,285 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/logging.hpp"
+#include "core/mutex.hpp"
+#include "crypto/sha256.hpp"
+#include "ledger/chaincode/executable_cache.hpp"
+#include "storage/resource_mapper.hpp"
+#include "telemetry/counter.hpp"
+#include "telemetry/registry.hpp"
+#include "vm/module.hpp"
+
+#include <cassert>
+#include <exception>
+#include <memory>
+#include <string>
+#include <utility>
+
+namespace fetch {
+namespace ledger {
+namespace {
+
+// Bump whenever the serialized form of an executable changes, invalidating all stored entries
+constexpr uint8_t FORMAT_VERSION = 1;
+
+}  // namespace
+
+constexpr std::size_t ExecutableCache::DEFAULT_MAX_ENTRIES;
+
+/**
+ * Get the process wide executable cache
+ *
+ * @return The cache instance
+ */
+ExecutableCache &ExecutableCache::Instance()
+{
+  static ExecutableCache instance;
+  return instance;
+}
+
+/**
+ * Create the cache key for a contract
+ *
+ * @param source_digest The digest of the contract source
+ * @param module The module the contract is compiled against, this must have been set up by a
+ * compiler
+ * @return The cache key
+ */
+ExecutableCache::ConstByteArray ExecutableCache::CreateKey(ConstByteArray const &source_digest,
+                                                           vm::Module const &module)
+{
+  crypto::SHA256 hash;
+  hash.Reset();
+
+  hash.Update(&FORMAT_VERSION, sizeof(FORMAT_VERSION));
+  hash.Update(source_digest);
+
+  // the type ids and opcodes referenced by an executable are positions in these tables
+  for (auto const &type_info : module.type_info_array())
+  {
+    hash.Update(type_info.name);
+  }
+
+  for (auto const &function_info : module.function_info_array())
+  {
+    hash.Update(function_info.unique_id);
+  }
+
+  return hash.Final();
+}
+
+/**
+ * Construct an in memory only cache
+ *
+ * @param max_entries The maximum number of executables to keep in memory
+ */
+ExecutableCache::ExecutableCache(std::size_t max_entries)
+  : max_entries_{max_entries}
+  , memory_hit_count_{telemetry::Registry::Instance().CreateCounter(
+        "ledger_executable_cache_memory_hits_total",
+        "The total number of executables found in the in memory cache")}
+  , disk_hit_count_{telemetry::Registry::Instance().CreateCounter(
+        "ledger_executable_cache_disk_hits_total",
+        "The total number of executables loaded from the persistent cache")}
+  , miss_count_{telemetry::Registry::Instance().CreateCounter(
+        "ledger_executable_cache_misses_total",
+        "The total number of executables which had to be compiled")}
+  , eviction_count_{telemetry::Registry::Instance().CreateCounter(
+        "ledger_executable_cache_evictions_total",
+        "The total number of executables evicted from the in memory cache")}
+  , compile_time_saved_us_{telemetry::Registry::Instance().CreateCounter(
+        "ledger_executable_cache_compile_time_saved_us_total",
+        "The total compilation time in microseconds avoided by cache hits")}
+{
+  assert(max_entries_ > 0);
+}
+
+/**
+ * Load (creating if necessary) the persistent store for the cache
+ *
+ * @param prefix The file prefix for the store
+ */
+void ExecutableCache::Load(std::string const &prefix)
+{
+  auto store = std::make_unique<Store>();
+  store->Load(prefix + ".db", prefix + ".index.db", true);
+
+  FETCH_LOCK(lock_);
+  store_ = std::move(store);
+}
+
+/**
+ * Create a new (empty) persistent store for the cache
+ *
+ * @param prefix The file prefix for the store
+ */
+void ExecutableCache::New(std::string const &prefix)
+{
+  auto store = std::make_unique<Store>();
+  store->New(prefix + ".db", prefix + ".index.db");
+
+  FETCH_LOCK(lock_);
+  store_ = std::move(store);
+}
+
+/**
+ * Lookup an executable, first in memory and then in the persistent store
+ *
+ * @param key The cache key for the contract
+ * @return The executable if present, otherwise a nullptr
+ */
+ExecutableCache::ExecutablePtr ExecutableCache::Lookup(ConstByteArray const &key)
+{
+  FETCH_LOCK(lock_);
+
+  auto it = elements_.find(key);
+  if (it != elements_.end())
+  {
+    // mark the element as the most recently used
+    recently_used_.splice(recently_used_.begin(), recently_used_, it->second.position);
+
+    memory_hit_count_->increment();
+    compile_time_saved_us_->add(it->second.compile_time_us);
+
+    return it->second.executable;
+  }
+
+  if (store_)
+  {
+    Record record{};
+    bool   loaded{false};
+
+    try
+    {
+      loaded = store_->Get(storage::ResourceID{key}, record);
+    }
+    catch (std::exception const &ex)
+    {
+      FETCH_LOG_WARN(LOGGING_NAME, "Discarding corrupt executable 0x", key.ToHex(), ": ",
+                     ex.what());
+      store_->Erase(storage::ResourceID{key});
+    }
+
+    if (loaded)
+    {
+      auto executable = std::make_shared<Executable>(std::move(record.executable));
+      Insert(key, executable, record.compile_time_us);
+
+      disk_hit_count_->increment();
+      compile_time_saved_us_->add(record.compile_time_us);
+
+      return executable;
+    }
+  }
+
+  miss_count_->increment();
+
+  return {};
+}
+
+/**
+ * Add a freshly compiled executable to the cache
+ *
+ * @param key The cache key for the contract
+ * @param executable The compiled executable
+ * @param compile_time The time taken to compile the executable
+ */
+void ExecutableCache::Add(ConstByteArray const &key, ExecutablePtr executable,
+                          Duration compile_time)
+{
+  assert(static_cast<bool>(executable));
+
+  auto const compile_time_us = static_cast<uint64_t>(compile_time.count());
+
+  FETCH_LOCK(lock_);
+
+  if (store_)
+  {
+    try
+    {
+      store_->Set(storage::ResourceID{key}, Record{*executable, compile_time_us});
+    }
+    catch (std::exception const &ex)
+    {
+      FETCH_LOG_WARN(LOGGING_NAME, "Unable to persist executable 0x", key.ToHex(), ": ",
+                     ex.what());
+    }
+  }
+
+  Insert(key, std::move(executable), compile_time_us);
+}
+
+/**
+ * Remove all the executables held in memory. The persistent store is unaffected.
+ */
+void ExecutableCache::Clear()
+{
+  FETCH_LOCK(lock_);
+
+  elements_.clear();
+  recently_used_.clear();
+}
+
+std::size_t ExecutableCache::size() const
+{
+  FETCH_LOCK(lock_);
+  return elements_.size();
+}
+
+std::size_t ExecutableCache::max_entries() const
+{
+  return max_entries_;
+}
+
+/**
+ * Insert (or refresh) an executable in the memory cache, evicting the least recently used entries
+ * if the cache is full. The lock must be held by the caller.
+ *
+ * @param key The cache key for the contract
+ * @param executable The executable
+ * @param compile_time_us The time taken to originally compile the executable
+ */
+void ExecutableCache::Insert(ConstByteArray const &key, ExecutablePtr executable,
+                             uint64_t compile_time_us)
+{
+  auto it = elements_.find(key);
+  if (it != elements_.end())
+  {
+    recently_used_.splice(recently_used_.begin(), recently_used_, it->second.position);
+    it->second.executable      = std::move(executable);
+    it->second.compile_time_us = compile_time_us;
+    return;
+  }
+
+  while (elements_.size() >= max_entries_)
+  {
+    assert(!recently_used_.empty());
+
+    elements_.erase(recently_used_.back());
+    recently_used_.pop_back();
+
+    eviction_count_->increment();
+  }
+
+  recently_used_.push_front(key);
+  elements_.emplace(key, Element{std::move(executable), compile_time_us, recently_used_.begin()});
+}
+
+}  // namespace ledger
+}  // namespace fetch
@@ -23,6 +23,7 @@
 #include "crypto/sha256.hpp"
 #include "ledger/chain/transaction.hpp"
 #include "ledger/chaincode/contract.hpp"
+#include "ledger/chaincode/executable_cache.hpp"
 #include "ledger/chaincode/smart_contract.hpp"
 #include "ledger/chaincode/smart_contract_exception.hpp"
 #include "ledger/fetch_msgpack.hpp"
@@ -31,12 +32,14 @@
 #include "variant/variant.hpp"
 #include "variant/variant_utils.hpp"
 #include "vm/address.hpp"
+#include "vm/compiler.hpp"
 #include "vm/function_decorators.hpp"
 #include "vm/module.hpp"
 #include "vm/string.hpp"
 #include "vm_modules/vm_factory.hpp"
 
 #include <algorithm>
+#include <chrono>
 #include <cstddef>
 #include <cstdint>
 #include <exception>
@@ -94,7 +97,6 @@ void ValidateAddressesInParams(Transaction const &tx, vm::ParameterPack const &p
 SmartContract::SmartContract(std::string const &source)
   : source_{source}
   , digest_{fetch::crypto::Hash<fetch::crypto::SHA256>(ConstByteArray(source))}
-  , executable_{std::make_shared<Executable>()}
   , module_{VMFactory::GetModule(VMFactory::USE_SMART_CONTRACTS)}
 {
   if (source_.empty())
@@ -108,13 +110,34 @@ SmartContract::SmartContract(std::string const &source)
   module_->CreateFreeFunction("getBlockNumber",
                               [this](vm::VM *) -> BlockIndex { return block_index_; });
 
-  // create and compile the executable
-  auto errors = vm_modules::VMFactory::Compile(module_, source_, *executable_);
+  // setting up a compiler registers the module's types and functions, these are needed both to
+  // key the executable cache and to run an executable taken from it. On a cache miss the same
+  // compiler is used to build the executable
+  vm::Compiler compiler{module_.get()};
 
-  // if there are any compilation errors
-  if (!errors.empty())
+  auto &cache = ExecutableCache::Instance();
+
+  auto const cache_key = ExecutableCache::CreateKey(digest_, *module_);
+  executable_          = cache.Lookup(cache_key);
+
+  if (!executable_)
   {
-    throw SmartContractException(SmartContractException::Category::COMPILATION, std::move(errors));
+    executable_ = std::make_shared<Executable>();
+
+    // create and compile the executable
+    auto const start  = std::chrono::steady_clock::now();
+    auto       errors = vm_modules::VMFactory::Compile(module_, compiler, source_, *executable_);
+
+    // if there are any compilation errors
+    if (!errors.empty())
+    {
+      throw SmartContractException(SmartContractException::Category::COMPILATION,
+                                   std::move(errors));
+    }
+
+    cache.Add(cache_key, executable_,
+              std::chrono::duration_cast<ExecutableCache::Duration>(
+                  std::chrono::steady_clock::now() - start));
   }
 
   // since we now have a fully compiled executable we can evaluate the functions and assign the
@@ -32,8 +32,12 @@
 #include "telemetry/histogram.hpp"
 #include "telemetry/registry.hpp"
 #include "telemetry/utils/timer.hpp"
+#include "vectorise/platform.hpp"
 
+#include <algorithm>
 #include <chrono>
+#include <exception>
+#include <limits>
 #include <memory>
 #include <thread>
 #include <vector>
@@ -68,6 +72,9 @@ ExecutionManager::ExecutionManager(std::size_t num_executors, uint32_t log2_num_
         "ledger_exec_mgr_fees_settled_total", "The total number of settle fees rounds"))
   , blocks_completed_count_(Registry::Instance().CreateCounter(
         "ledger_exec_mgr_blocks_completed_total", "The total number of settle fees rounds"))
+  , tx_prefetched_count_(Registry::Instance().CreateCounter(
+        "ledger_exec_mgr_tx_prefetched_total",
+        "The total number of transactions retrieved in bulk before execution"))
   , execution_duration_(Registry::Instance().CreateHistogram(
         {0.000001, 0.000002, 0.000003, 0.000004, 0.000005, 0.000006, 0.000007, 0.000008, 0.000009,
          0.00001,  0.00002,  0.00003,  0.00004,  0.00005,  0.00006,  0.00007,  0.00008,  0.00009,
@@ -184,6 +191,7 @@ ExecutionManager::ScheduleStatus ExecutionManager::Execute(Block::Body const &bl
   // trigger the monitor / dispatch thread
   {
     FETCH_LOCK(monitor_lock_);
+    execution_pending_ = true;
     monitor_wake_.notify_one();
   }
 
@@ -194,22 +202,29 @@ ExecutionManager::ScheduleStatus ExecutionManager::Execute(Block::Body const &bl
  * Given a input block, plan the execution of the transactions across the lanes
  * and slices
  *
+ * The plan is a dependency graph: each transaction depends on the last transaction (in slice
+ * order) to have used each of its lanes.
+ *
  * @param block The input block to plan
  * @return true if successful, otherwise false
  */
 bool ExecutionManager::PlanExecution(Block::Body const &block)
 {
+  static constexpr std::size_t NO_ENTRY = std::numeric_limits<std::size_t>::max();
+
   FETCH_LOCK(execution_plan_lock_);
 
-  // clear and resize the execution plan
+  // clear the execution plan
   execution_plan_.clear();
-  execution_plan_.resize(block.slices.size());
+  plan_roots_.clear();
+  plan_aborted_ = false;
+
+  // the index of the last plan entry to have used each lane
+  std::vector<std::size_t> lane_owners(1u << log2_num_lanes_, NO_ENTRY);
 
   uint64_t slice_index = 0;
   for (auto const &slice : block.slices)
   {
-    auto &slice_plan = execution_plan_[slice_index];
-
     // process the transactions
     for (auto const &tx : slice)
     {
@@ -217,9 +232,50 @@ bool ExecutionManager::PlanExecution(Block::Body const &block)
       // and some level of dynamic scaling should be applied.
       assert((1u << log2_num_lanes_) == tx.mask().size());
 
+      std::size_t const index = execution_plan_.size();
+
       // insert the item into the execution plan
-      slice_plan.emplace_back(
-          std::make_unique<ExecutionItem>(tx.digest(), block.block_number, slice_index, tx.mask()));
+      execution_plan_.emplace_back(std::make_unique<PlanEntry>(
+          std::make_unique<ExecutionItem>(tx.digest(), block.block_number, slice_index, tx.mask())));
+
+      auto &entry = *execution_plan_.back();
+
+      // link this entry to the previous users of each of its lanes
+      auto const &mask = tx.mask();
+      for (std::size_t block_index = 0; block_index < mask.blocks(); ++block_index)
+      {
+        for (BitVector::Block bits = mask(block_index); bits != 0; bits &= (bits - 1))
+        {
+          std::size_t const lane =
+              (block_index * BitVector::ELEMENT_BIT_SIZE) +
+              static_cast<std::size_t>(platform::CountTrailingZeroes64(bits));
+
+          if (lane >= lane_owners.size())
+          {
+            break;
+          }
+
+          auto &owner = lane_owners[lane];
+          if (owner != NO_ENTRY)
+          {
+            // since all the lanes of this entry are processed together, duplicate links to the same
+            // owner will always be adjacent
+            auto &owner_dependents = execution_plan_[owner]->dependents;
+            if (owner_dependents.empty() || (owner_dependents.back() != index))
+            {
+              owner_dependents.push_back(index);
+              ++entry.num_dependencies;
+            }
+          }
+
+          owner = index;
+        }
+      }
+
+      if (entry.num_dependencies == 0)
+      {
+        plan_roots_.push_back(index);
+      }
     }
 
     ++slice_index;
@@ -228,15 +284,88 @@ bool ExecutionManager::PlanExecution(Block::Body const &block)
   return true;
 }
 
+/**
+ * Retrieve all the transactions in the execution plan from storage in a single batch, i.e. one
+ * round trip per lane, rather than leaving each executor to look up its own transaction. Any
+ * transaction which can not be retrieved is simply looked up by the executor as before.
+ *
+ * Must be called with the execution plan lock held.
+ */
+void ExecutionManager::PrefetchTransactions()
+{
+  StorageUnitInterface::Digests digests{};
+  digests.reserve(execution_plan_.size());
+  for (auto const &entry : execution_plan_)
+  {
+    digests.push_back(entry->item->digest());
+  }
+
+  StorageUnitInterface::Transactions txs{};
+
+  try
+  {
+    storage_->GetTransactions(digests, txs);
+  }
+  catch (std::exception const &ex)
+  {
+    FETCH_LOG_WARN(LOGGING_NAME, "Exception caught when prefetching transactions: ", ex.what());
+    return;
+  }
+
+  std::size_t const num_txs = std::min(txs.size(), execution_plan_.size());
+  for (std::size_t i = 0; i < num_txs; ++i)
+  {
+    // missing transactions are left default constructed
+    if (txs[i].digest() == digests[i])
+    {
+      execution_plan_[i]->item->SetTransaction(
+          std::make_shared<Transaction const>(std::move(txs[i])));
+      tx_prefetched_count_->increment();
+    }
+  }
+}
+
+/**
+ * Post the specified plan entry to the thread pool for execution
+ *
+ * The caller must have already accounted for the item in the active counter
+ *
+ * @param index The index of the entry in the execution plan
+ */
+void ExecutionManager::ScheduleExecution(std::size_t index)
+{
+  auto self  = shared_from_this();
+  auto entry = execution_plan_[index].get();
+
+  thread_pool_->Post([self, entry]() {
+    telemetry::FunctionTimer const timer{*(self->execution_duration_)};
+    self->DispatchExecution(*entry);
+  });
+}
+
 /**
  * Dispatches an execution item to the next available executor
  *
- * This function should be called from a context of a thread pool
+ * This function should be called from a context of a thread pool. On completion any dependent
+ * entries which are no longer waiting on other entries are scheduled for execution.
  *
- * @param item The execution item to dispatch
+ * @param entry The execution plan entry to dispatch
  */
-void ExecutionManager::DispatchExecution(ExecutionItem &item)
+void ExecutionManager::DispatchExecution(PlanEntry &entry)
 {
+  auto &item = *entry.item;
+
+  // in the case where the execution has been aborted, there is no need to execute the item
+  if (plan_aborted_)
+  {
+    counters_.ApplyVoid([](auto &counters) {
+      --counters.active;
+      --counters.remaining;
+    });
+
+    return;
+  }
+
   ExecutorPtr executor;
 
   // lookup a free executor
@@ -255,11 +384,10 @@ void ExecutionManager::DispatchExecution(ExecutionItem &item)
 
   if (executor)
   {
-    // increment the active counters
-    counters_.ApplyVoid([](auto &counters) { ++counters.active; });
-
     // execute the item
     item.Execute(*executor);
+    entry.executed = true;
+
     auto const &result{item.result()};
 
     // determine what the status is
@@ -269,11 +397,6 @@ void ExecutionManager::DispatchExecution(ExecutionItem &item)
                      " status: ", ledger::ToString(result.status));
     }
 
-    counters_.ApplyVoid([](auto &counters) {
-      --counters.active;
-      --counters.remaining;
-    });
-
     ++completed_executions_;
     tx_executed_count_->increment();
 
@@ -281,11 +404,62 @@ void ExecutionManager::DispatchExecution(ExecutionItem &item)
       FETCH_LOCK(idle_executors_lock_);
       idle_executors_.push_back(std::move(executor));
     }
+
+    // In the case of a stall or fatal error, the execution of the block will not complete. Signal
+    // that no further items should be dispatched.
+    switch (result.status)
+    {
+    case ExecutionItem::Status::SUCCESS:
+    case ExecutionItem::Status::CHAIN_CODE_LOOKUP_FAILURE:
+    case ExecutionItem::Status::CHAIN_CODE_EXEC_FAILURE:
+    case ExecutionItem::Status::CONTRACT_NAME_PARSE_FAILURE:
+    case ExecutionItem::Status::CONTRACT_LOOKUP_FAILURE:
+    case ExecutionItem::Status::TX_NOT_VALID_FOR_BLOCK:
+    case ExecutionItem::Status::INSUFFICIENT_AVAILABLE_FUNDS:
+    case ExecutionItem::Status::TRANSFER_FAILURE:
+    case ExecutionItem::Status::INSUFFICIENT_CHARGE:
+      break;
+    default:
+      plan_aborted_ = true;
+      break;
+    }
   }
   else
   {
     FETCH_LOG_ERROR(LOGGING_NAME, "Failed to secure an idle executor");
+
+    plan_aborted_ = true;
   }
+
+  // determine which of the dependent entries are now ready for execution
+  PlanIndices ready{};
+  if (!plan_aborted_)
+  {
+    for (auto const index : entry.dependents)
+    {
+      if (--(execution_plan_[index]->num_dependencies) == 0)
+      {
+        ready.push_back(index);
+      }
+    }
+  }
+
+  // the newly ready entries must be accounted for before this entry is marked as complete,
+  // otherwise the monitor could incorrectly observe that there is no outstanding work
+  if (!ready.empty())
+  {
+    counters_.ApplyVoid([&ready](auto &counters) { counters.active += ready.size(); });
+
+    for (auto const index : ready)
+    {
+      ScheduleExecution(index);
+    }
+  }
+
+  counters_.ApplyVoid([](auto &counters) {
+    --counters.active;
+    --counters.remaining;
+  });
 }
 
 /**
@@ -374,7 +548,7 @@ void ExecutionManager::MonitorThreadEntrypoint()
     STALLED,
     COMPLETED,
     IDLE,
-    SCHEDULE_NEXT_SLICE,
+    SCHEDULE,
     RUNNING,
     SETTLE_FEES,
     BOOKMARKING_STATE
@@ -382,8 +556,7 @@ void ExecutionManager::MonitorThreadEntrypoint()
 
   MonitorState monitor_state = MonitorState::COMPLETED;
 
-  std::size_t current_slice        = 0;
-  uint64_t    aggregate_block_fees = 0;
+  uint64_t aggregate_block_fees = 0;
 
   Digest current_block;
 
@@ -425,7 +598,8 @@ void ExecutionManager::MonitorThreadEntrypoint()
       // enter the idle state where we wait for the next block to be posted
       {
         std::unique_lock<std::mutex> lock(monitor_lock_);
-        monitor_wake_.wait(lock);
+        monitor_wake_.wait(lock, [this]() { return execution_pending_ || !running_; });
+        execution_pending_ = false;
       }
 
       state_.ApplyVoid([](auto &state) { state = State::ACTIVE; });
@@ -433,45 +607,40 @@ void ExecutionManager::MonitorThreadEntrypoint()
 
       FETCH_LOG_DEBUG(LOGGING_NAME, "Now Active");
 
-      // schedule the next slice if we have been triggered
+      // schedule the execution if we have been triggered
       if (running_)
       {
-        monitor_state        = MonitorState::SCHEDULE_NEXT_SLICE;
-        current_slice        = 0;
+        monitor_state        = MonitorState::SCHEDULE;
         aggregate_block_fees = 0;
       }
 
       break;
     }
 
-    case MonitorState::SCHEDULE_NEXT_SLICE:
+    case MonitorState::SCHEDULE:
     {
       FETCH_LOCK(execution_plan_lock_);
 
-      slices_executed_count_->increment();
-
       if (execution_plan_.empty())
       {
         monitor_state = MonitorState::SETTLE_FEES;
       }
       else
       {
-        auto const &slice_plan = execution_plan_[current_slice];
-
         // determine the target number of executions being expected (must be
         // done before the thread pool dispatch)
-        counters_.ApplyVoid([&slice_plan](auto &counters) {
-          counters = Counters{0, slice_plan.size()};
+        counters_.ApplyVoid([this](auto &counters) {
+          counters = Counters{plan_roots_.size(), execution_plan_.size()};
         });
 
-        auto self = shared_from_this();
-        for (auto &item : slice_plan)
+        // retrieve all the transactions for the block up front
+        PrefetchTransactions();
+
+        // dispatch all the items which do not depend on any others, the remaining items will be
+        // dispatched as their dependencies complete
+        for (auto const index : plan_roots_)
         {
-          // create the closure and dispatch to the thread pool
-          thread_pool_->Post([self, &item]() {
-            telemetry::FunctionTimer const timer{*(self->execution_duration_)};
-            self->DispatchExecution(*item);
-          });
+          ScheduleExecution(index);
         }
 
         monitor_state = MonitorState::RUNNING;
@@ -482,19 +651,23 @@ void ExecutionManager::MonitorThreadEntrypoint()
 
     case MonitorState::RUNNING:
     {
-      // wait for the execution to complete
+      // wait for the execution to complete, or in the case of an abort, for all the outstanding
+      // executions to finish
       bool const finished =
-          counters_.Wait([](auto const &counters) -> bool { return counters.remaining == 0; },
+          counters_.Wait([](auto const &counters) -> bool { return counters.active == 0; },
                          std::chrono::seconds{2});
 
       if (!finished)
       {
         counters_.ApplyVoid([](auto const &counters) {
-          FETCH_LOG_WARN(LOGGING_NAME, "### Extra long execution: remaining: ", counters.remaining);
+          FETCH_LOG_WARN(LOGGING_NAME, "### Extra long execution: remaining: ", counters.remaining,
+                         " active: ", counters.active);
         });
       }
       else
       {
+        FETCH_LOCK(execution_plan_lock_);
+
         // evaluate the status of the executions
         std::size_t num_complete{0};
         std::size_t num_stalls{0};
@@ -502,11 +675,18 @@ void ExecutionManager::MonitorThreadEntrypoint()
         std::size_t num_fatal_errors{0};
 
         // look through all execution items and determine if it was successful
-        for (auto const &item : execution_plan_[current_slice])
+        for (auto const &entry : execution_plan_)
         {
-          assert(item);
+          assert(entry && entry->item);
 
-          switch (item->result().status)
+          if (!entry->executed)
+          {
+            continue;
+          }
+
+          auto const &item = *entry->item;
+
+          switch (item.result().status)
           {
           case ExecutionItem::Status::SUCCESS:
             ++num_complete;
@@ -530,11 +710,11 @@ void ExecutionManager::MonitorThreadEntrypoint()
           }
 
           // update aggregate fees
-          aggregate_block_fees += item->fee();
+          aggregate_block_fees += item.fee();
 
           if (tx_status_cache_)
           {
-            tx_status_cache_->Update(item->digest(), item->result());
+            tx_status_cache_->Update(item.digest(), item.result());
           }
         }
 
@@ -543,23 +723,23 @@ void ExecutionManager::MonitorThreadEntrypoint()
         {
           if (num_stalls + num_errors + num_fatal_errors)
           {
-            FETCH_LOG_WARN(LOGGING_NAME, "Slice ", current_slice,
-                           " Execution Status - Complete: ", num_complete, " Stalls: ", num_stalls,
-                           " Errors: ", num_errors, " Fatal Errors: ", num_fatal_errors);
+            FETCH_LOG_WARN(LOGGING_NAME, "Block Execution Status - Complete: ", num_complete,
+                           " Stalls: ", num_stalls, " Errors: ", num_errors,
+                           " Fatal Errors: ", num_fatal_errors);
           }
           else
           {
-            FETCH_LOG_DEBUG(LOGGING_NAME, "Slice ", current_slice,
-                            " Execution Status - Complete: ", num_complete, " Stalls: ", num_stalls,
-                            " Errors: ", num_errors);
+            FETCH_LOG_DEBUG(LOGGING_NAME, "Block Execution Status - Complete: ", num_complete,
+                            " Stalls: ", num_stalls, " Errors: ", num_errors);
           }
         }
 
-        // increment the slice counter
-        ++current_slice;
+        // determine if any items were not executed as a result of the execution being aborted
+        std::size_t const num_incomplete =
+            counters_.Apply([](auto const &counters) -> std::size_t { return counters.remaining; });
 
-        // decide the next monitor state based on the status of the slice execution
-        if (num_fatal_errors)
+        // decide the next monitor state based on the status of the block execution
+        if (num_fatal_errors || (num_incomplete && !num_stalls))
         {
           monitor_state = MonitorState::FAILED;
         }
@@ -567,12 +747,9 @@ void ExecutionManager::MonitorThreadEntrypoint()
         {
           monitor_state = MonitorState::STALLED;
         }
-        else if (num_slices_ > current_slice)
-        {
-          monitor_state = MonitorState::SCHEDULE_NEXT_SLICE;
-        }
         else
         {
+          slices_executed_count_->add(num_slices_);
           monitor_state = MonitorState::SETTLE_FEES;
         }
       }
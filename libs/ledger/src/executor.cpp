@@ -138,6 +138,48 @@ Executor::Result Executor::Execute(Digest const &digest, BlockIndex block, Slice
 
   FETCH_LOG_DEBUG(LOGGING_NAME, "Executing tx ", byte_array::ToBase64(digest));
 
+  // attempt to retrieve the transaction from the storage
+  if (!RetrieveTransaction(digest))
+  {
+    // signal that the contract failed to be executed
+    return Result{Status::TX_LOOKUP_FAILURE};
+  }
+
+  return ExecuteCurrentTransaction(block, slice, shards);
+}
+
+/**
+ * Executes a transaction, which has already been retrieved from storage, across a series of lanes
+ *
+ * @param tx The transaction to be executed
+ * @param block The current block index
+ * @param slice The current slice index
+ * @param shards The bit vector outlining the shards in use by this transaction
+ * @return The status code for the operation
+ */
+Executor::Result Executor::ExecuteTransaction(Transaction const &tx, BlockIndex block,
+                                              SliceIndex slice, BitVector const &shards)
+{
+  telemetry::FunctionTimer const timer{*overall_duration_};
+
+  FETCH_LOG_DEBUG(LOGGING_NAME, "Executing tx ", byte_array::ToBase64(tx.digest()));
+
+  current_tx_ = std::make_shared<Transaction>(tx);
+
+  return ExecuteCurrentTransaction(block, slice, shards);
+}
+
+/**
+ * Executes the current transaction
+ *
+ * @param block The current block index
+ * @param slice The current slice index
+ * @param shards The bit vector outlining the shards in use by this transaction
+ * @return The status code for the operation
+ */
+Executor::Result Executor::ExecuteCurrentTransaction(BlockIndex block, SliceIndex slice,
+                                                     BitVector const &shards)
+{
   Result result{Status::INEXPLICABLE_FAILURE};
 
   // cache the state for the current transaction
@@ -146,44 +188,38 @@ Executor::Result Executor::Execute(Digest const &digest, BlockIndex block, Slice
   allowed_shards_ = shards;
   log2_num_lanes_ = shards.log2_size();
 
-  // attempt to retrieve the transaction from the storage
-  if (!RetrieveTransaction(digest))
+  // update the charge related data provided by Tx sender
+  result.charge_rate  = current_tx_->charge();
+  result.charge_limit = current_tx_->charge_limit();
+
+  // create the storage cache
+  storage_cache_ = std::make_shared<CachedStorageAdapter>(*storage_);
+
+  // populate the cache with the state known to be accessed by the transaction
+  PrefetchState();
+
+  // follow the three step process for executing a transaction
+  //
+  // 0. Validation checks (does the originator have correct funds)
+  // 1. Execute the containing transaction
+  // 2. Execute any token transfers
+  // 3. Process the fees
+  //
+  bool const success =
+      ValidationChecks(result) && ExecuteTransactionContract(result) && ProcessTransfers(result);
+
+  if (!success)
   {
-    // signal that the contract failed to be executed
-    result.status = Status::TX_LOOKUP_FAILURE;
+    // in addition to avoid indeterminate data being partially flushed. In the case of the when
+    // the transaction execution fails then we also clear all the cached data.
+    storage_cache_->Clear();
   }
-  else
-  {
-    // update the charge related data provided by Tx sender
-    result.charge_rate  = current_tx_->charge();
-    result.charge_limit = current_tx_->charge_limit();
-
-    // create the storage cache
-    storage_cache_ = std::make_shared<CachedStorageAdapter>(*storage_);
-
-    // follow the three step process for executing a transaction
-    //
-    // 0. Validation checks (does the originator have correct funds)
-    // 1. Execute the containing transaction
-    // 2. Execute any token transfers
-    // 3. Process the fees
-    //
-    bool const success =
-        ValidationChecks(result) && ExecuteTransactionContract(result) && ProcessTransfers(result);
-
-    if (!success)
-    {
-      // in addition to avoid indeterminate data being partially flushed. In the case of the when
-      // the transaction execution fails then we also clear all the cached data.
-      storage_cache_->Clear();
-    }
 
-    // deduct the fees from the originator
-    DeductFees(result);
+  // deduct the fees from the originator
+  DeductFees(result);
 
-    // flush the storage so that all changes are now persistent
-    storage_cache_->Flush();
-  }
+  // flush the storage so that all changes are now persistent
+  storage_cache_->Flush();
 
   return result;
 }
@@ -234,6 +270,45 @@ bool Executor::RetrieveTransaction(Digest const &digest)
   return success;
 }
 
+/**
+ * Populate the storage cache with the token balances of all the parties named by the current
+ * transaction. These are always accessed during execution so retrieving them up front means a
+ * single round trip per lane rather than one per resource.
+ */
+void Executor::PrefetchState()
+{
+  Identifier const token_scope{"fetch.token"};
+
+  StorageInterface::ResourceAddresses keys{};
+  keys.reserve(current_tx_->transfers().size() + 1u);
+
+  auto const add_key = [this, &keys, &token_scope](Address const &address) {
+    auto key = StateAdapter::CreateAddress(token_scope, address.display());
+
+    // only prefetch resources from the shards which the transaction is allowed to access
+    if (allowed_shards_.bit(key.lane(log2_num_lanes_)))
+    {
+      keys.emplace_back(std::move(key));
+    }
+  };
+
+  add_key(current_tx_->from());
+  for (auto const &transfer : current_tx_->transfers())
+  {
+    add_key(transfer.to);
+  }
+
+  try
+  {
+    storage_cache_->Prefetch(keys);
+  }
+  catch (std::exception const &ex)
+  {
+    // prefetching is only an optimisation, the resources will be retrieved on demand instead
+    FETCH_LOG_WARN(LOGGING_NAME, "Exception caught when prefetching state: ", ex.what());
+  }
+}
+
 bool Executor::ValidationChecks(Result &result)
 {
   telemetry::FunctionTimer const timer{*validation_checks_duration_};
@@ -0,0 +1,45 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "ledger/chain/transaction.hpp"
+#include "ledger/executor_interface.hpp"
+
+namespace fetch {
+namespace ledger {
+
+/**
+ * Execute a transaction which has already been retrieved from storage.
+ *
+ * The default implementation simply executes the transaction by digest. Implementations which
+ * can use the supplied transaction directly should override this to avoid the lookup.
+ *
+ * @param tx The transaction to be executed
+ * @param block The current block index
+ * @param slice The current slice index
+ * @param shards The bit vector outlining the shards in use by this transaction
+ * @return The status code for the operation
+ */
+ExecutorInterface::Result ExecutorInterface::ExecuteTransaction(Transaction const &tx,
+                                                                BlockIndex block, SliceIndex slice,
+                                                                BitVector const &shards)
+{
+  return Execute(tx.digest(), block, slice, shards);
+}
+
+}  // namespace ledger
+}  // namespace fetch
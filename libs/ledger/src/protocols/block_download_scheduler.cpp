@@ -0,0 +1,290 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+
+#include "ledger/protocols/block_download_scheduler.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <utility>
+
+namespace fetch {
+namespace ledger {
+
+constexpr std::size_t BlockDownloadScheduler::DEFAULT_WINDOW_SIZE;
+constexpr std::size_t BlockDownloadScheduler::DEFAULT_MAX_IN_FLIGHT;
+constexpr std::size_t BlockDownloadScheduler::DEFAULT_MAX_BUFFERED_WINDOWS;
+constexpr std::size_t BlockDownloadScheduler::DEFAULT_MAX_ATTEMPTS;
+
+/**
+ * Construct the scheduler
+ *
+ * @param window_size The maximum number of blocks requested from a peer at once
+ * @param max_in_flight The maximum number of outstanding windows per peer
+ * @param max_buffered_windows The maximum number of windows downloaded ahead of the chain
+ * @param max_attempts The number of failed attempts after which a window (and the sync) fails
+ */
+BlockDownloadScheduler::BlockDownloadScheduler(std::size_t window_size, std::size_t max_in_flight,
+                                               std::size_t max_buffered_windows,
+                                               std::size_t max_attempts)
+  : window_size_{std::max<std::size_t>(window_size, 1)}
+  , max_in_flight_{std::max<std::size_t>(max_in_flight, 1)}
+  , max_buffered_windows_{std::max<std::size_t>(max_buffered_windows, 1)}
+  , max_attempts_{std::max<std::size_t>(max_attempts, 1)}
+{}
+
+/**
+ * Start a new download
+ *
+ * @param hashes The hashes of the blocks to be downloaded, oldest first
+ */
+void BlockDownloadScheduler::Reset(BlockHashes hashes)
+{
+  Clear();
+
+  hashes_ = std::move(hashes);
+  windows_.resize((hashes_.size() + window_size_ - 1u) / window_size_);
+}
+
+/**
+ * Abandon the current download
+ */
+void BlockDownloadScheduler::Clear()
+{
+  hashes_.clear();
+  windows_.clear();
+  peers_.clear();
+
+  next_release_  = 0;
+  num_in_flight_ = 0;
+  failed_        = false;
+}
+
+/**
+ * Assign pending windows to the available peers, oldest windows first
+ *
+ * @param peers The peers which are currently available
+ * @return The set of requests which should be made
+ */
+BlockDownloadScheduler::Requests BlockDownloadScheduler::Schedule(Addresses const &peers)
+{
+  Requests requests{};
+
+  if (failed_ || peers.empty())
+  {
+    return requests;
+  }
+
+  WindowIndex const end = std::min(windows_.size(), next_release_ + max_buffered_windows_);
+
+  for (WindowIndex index = next_release_; index < end; ++index)
+  {
+    auto &window = windows_[index];
+
+    if (WindowState::PENDING != window.state)
+    {
+      continue;
+    }
+
+    // select the peer with the most spare capacity, avoiding the peer which last failed
+    Address const *selected{nullptr};
+    std::size_t    selected_capacity{0};
+
+    for (auto const &address : peers)
+    {
+      auto const &peer = peers_[address];
+
+      std::size_t capacity = (peer.in_flight < peer.limit) ? peer.limit - peer.in_flight : 0;
+      if (capacity && (address == window.failed_peer))
+      {
+        // only used if no other peer is available
+        capacity = 0;
+        if (!selected)
+        {
+          selected = &address;
+        }
+      }
+
+      if (capacity > selected_capacity)
+      {
+        selected          = &address;
+        selected_capacity = capacity;
+      }
+    }
+
+    if (!selected)
+    {
+      // all the peers are busy
+      break;
+    }
+
+    auto &peer = peers_[*selected];
+    ++peer.in_flight;
+    ++num_in_flight_;
+
+    window.state = WindowState::IN_FLIGHT;
+    window.peer  = *selected;
+
+    std::size_t const begin = WindowBegin(index);
+    std::size_t const last  = WindowEnd(index) - 1u;
+
+    requests.emplace_back(Request{index, *selected, hashes_[last], last - begin + 1u});
+  }
+
+  return requests;
+}
+
+/**
+ * Handle the response to a window request. The response is only accepted if it contains exactly
+ * the expected blocks. A peer which is behind the chain being downloaded returns fewer (or no)
+ * blocks, which is treated in the same way as a failed request. Only blocks which do not match the
+ * expected chain make the response invalid.
+ *
+ * @param window The index of the window
+ * @param peer The peer which supplied the response
+ * @param blocks The blocks received, newest first
+ * @return The status of the response
+ */
+BlockDownloadScheduler::ResponseStatus BlockDownloadScheduler::OnResponse(WindowIndex window,
+                                                                          Address const &peer,
+                                                                          Blocks blocks)
+{
+  if ((window >= windows_.size()) || (WindowState::IN_FLIGHT != windows_[window].state) ||
+      (windows_[window].peer != peer))
+  {
+    return ResponseStatus::UNEXPECTED;
+  }
+
+  std::size_t const begin = WindowBegin(window);
+  std::size_t const end   = WindowEnd(window);
+
+  // every block returned must be the expected one and linked to the next (older) block
+  bool valid = (blocks.size() <= (end - begin));
+  for (std::size_t i = 0; valid && (i < blocks.size()); ++i)
+  {
+    blocks[i].UpdateDigest();
+    valid = (blocks[i].body.hash == hashes_[end - 1u - i]) &&
+            ((i == 0) || (blocks[i - 1u].body.previous_hash == blocks[i].body.hash));
+  }
+
+  if (!valid)
+  {
+    Complete(window, peer, false);
+    return ResponseStatus::INVALID;
+  }
+
+  if (blocks.size() != (end - begin))
+  {
+    Complete(window, peer, false);
+    return ResponseStatus::INCOMPLETE;
+  }
+
+  windows_[window].blocks = std::move(blocks);
+  Complete(window, peer, true);
+
+  return ResponseStatus::ACCEPTED;
+}
+
+/**
+ * Handle a failed (or timed out) window request
+ *
+ * @param window The index of the window
+ * @param peer The peer the window was requested from
+ */
+void BlockDownloadScheduler::OnFailure(WindowIndex window, Address const &peer)
+{
+  if ((window < windows_.size()) && (WindowState::IN_FLIGHT == windows_[window].state) &&
+      (windows_[window].peer == peer))
+  {
+    Complete(window, peer, false);
+  }
+}
+
+/**
+ * Release the next window of blocks if it has been downloaded
+ *
+ * @param peer The output peer which supplied the blocks
+ * @param blocks The output blocks, newest first
+ * @return true if a window was released, otherwise false
+ */
+bool BlockDownloadScheduler::PopCompleted(Address &peer, Blocks &blocks)
+{
+  if ((next_release_ >= windows_.size()) ||
+      (WindowState::COMPLETE != windows_[next_release_].state))
+  {
+    return false;
+  }
+
+  auto &window = windows_[next_release_++];
+
+  peer   = window.peer;
+  blocks = std::move(window.blocks);
+
+  window.state  = WindowState::RELEASED;
+  window.blocks = Blocks{};
+
+  return true;
+}
+
+std::size_t BlockDownloadScheduler::WindowBegin(WindowIndex window) const
+{
+  return window * window_size_;
+}
+
+std::size_t BlockDownloadScheduler::WindowEnd(WindowIndex window) const
+{
+  return std::min(hashes_.size(), (window + 1u) * window_size_);
+}
+
+/**
+ * Internal: Update the window and peer state at the end of a request
+ *
+ * @param window The index of the window
+ * @param peer The peer the window was requested from
+ * @param success Flag to signal if the window was successfully downloaded
+ */
+void BlockDownloadScheduler::Complete(WindowIndex window, Address const &peer, bool success)
+{
+  auto &state = peers_[peer];
+  auto &entry = windows_[window];
+
+  assert(state.in_flight > 0);
+  assert(num_in_flight_ > 0);
+  --state.in_flight;
+  --num_in_flight_;
+
+  if (success)
+  {
+    entry.state = WindowState::COMPLETE;
+    state.limit = std::min(state.limit + 1u, max_in_flight_);
+  }
+  else
+  {
+    entry.state       = WindowState::PENDING;
+    entry.failed_peer = peer;
+    state.limit       = 1;
+
+    if (++entry.attempts >= max_attempts_)
+    {
+      failed_ = true;
+    }
+  }
+}
+
+}  // namespace ledger
+}  // namespace fetch
@@ -30,11 +30,21 @@
 #include "telemetry/counter.hpp"
 #include "telemetry/registry.hpp"
 
+#include <algorithm>
+#include <chrono>
 #include <cstddef>
 #include <cstdint>
+#include <exception>
+#include <memory>
+#include <numeric>
+#include <utility>
 
-static const uint32_t MAX_CHAIN_REQUEST_SIZE = 10000;
-static const uint64_t MAX_SUB_CHAIN_SIZE     = 1000;
+static const uint64_t MAX_CHAIN_HASHES_SIZE = fetch::ledger::MainChain::UPPER_BOUND;
+static const uint64_t MAX_SUB_CHAIN_SIZE    = 1000;
+
+static constexpr std::chrono::seconds DOWNLOAD_TIMEOUT{30};
+static constexpr std::chrono::seconds COMPACT_BLOCK_TIMEOUT{10};
+static constexpr std::size_t          MAX_COMPACT_BLOCK_REQUESTS = 64;
 
 namespace fetch {
 namespace ledger {
@@ -69,13 +79,18 @@ constexpr State GetInitialState(Mode mode) noexcept
 }  // namespace
 
 MainChainRpcService::MainChainRpcService(MuddleEndpoint &endpoint, MainChain &chain,
-                                         TrustSystem &trust, Mode mode)
+                                         TrustSystem &trust, Mode mode, RecentTxIndex recent_txs,
+                                         bool broadcast_compact)
   : muddle::rpc::Server(endpoint, SERVICE_MAIN_CHAIN, CHANNEL_RPC)
   , mode_(mode)
   , endpoint_(endpoint)
   , chain_(chain)
   , trust_(trust)
+  , recent_txs_(std::move(recent_txs))
+  , broadcast_compact_(recent_txs_ && broadcast_compact)
   , block_subscription_(endpoint.Subscribe(SERVICE_MAIN_CHAIN, CHANNEL_BLOCKS))
+  , compact_block_subscription_(
+        recent_txs_ ? endpoint.Subscribe(SERVICE_MAIN_CHAIN, CHANNEL_COMPACT_BLOCKS) : nullptr)
   , main_chain_protocol_(chain_)
   , rpc_client_("R:MChain", endpoint, SERVICE_MAIN_CHAIN, CHANNEL_RPC)
   , state_machine_{std::make_shared<StateMachine>("MainChain", GetInitialState(mode_),
@@ -101,6 +116,9 @@ MainChainRpcService::MainChainRpcService(MuddleEndpoint &endpoint, MainChain &ch
   , state_wait_heaviest_{telemetry::Registry::Instance().CreateCounter(
         "ledger_mainchain_service_state_wait_heaviest_total",
         "The number of times in the wait heaviest state")}
+  , state_downloading_{telemetry::Registry::Instance().CreateCounter(
+        "ledger_mainchain_service_state_downloading_total",
+        "The number of times in the downloading blocks state")}
   , state_synchronising_{telemetry::Registry::Instance().CreateCounter(
         "ledger_mainchain_service_state_synchronising_total",
         "The number of times in the synchronisiing state")}
@@ -110,6 +128,25 @@ MainChainRpcService::MainChainRpcService(MuddleEndpoint &endpoint, MainChain &ch
   , state_synchronised_{telemetry::Registry::Instance().CreateCounter(
         "ledger_mainchain_service_state_synchronised_total",
         "The number of times in the sychronised state")}
+  , download_block_count_{telemetry::Registry::Instance().CreateCounter(
+        "ledger_mainchain_service_download_block_total",
+        "The total number of blocks downloaded while catching up")}
+  , download_failure_count_{telemetry::Registry::Instance().CreateCounter(
+        "ledger_mainchain_service_download_failure_total",
+        "The total number of failed block download requests")}
+  , recv_compact_block_count_{telemetry::Registry::Instance().CreateCounter(
+        "ledger_mainchain_service_recv_compact_block_total",
+        "The number of received compact blocks from the network")}
+  , compact_block_complete_count_{telemetry::Registry::Instance().CreateCounter(
+        "ledger_mainchain_service_compact_block_complete_total",
+        "The number of compact blocks rebuilt entirely from the recently seen transactions")}
+  , compact_block_fetched_tx_count_{telemetry::Registry::Instance().CreateCounter(
+        "ledger_mainchain_service_compact_block_fetched_tx_total",
+        "The total number of missing compact block transactions requested from peers")}
+  , compact_block_failure_count_{telemetry::Registry::Instance().CreateCounter(
+        "ledger_mainchain_service_compact_block_failure_total",
+        "The total number of compact blocks which could not be reconstructed")}
+  , thread_pool_{network::MakeThreadPool(1, "MChain")}
 {
   // register the main chain protocol
   Add(RPC_MAIN_CHAIN, &main_chain_protocol_);
@@ -118,6 +155,7 @@ MainChainRpcService::MainChainRpcService(MuddleEndpoint &endpoint, MainChain &ch
   // clang-format off
   state_machine_->RegisterHandler(State::REQUEST_HEAVIEST_CHAIN,  this, &MainChainRpcService::OnRequestHeaviestChain);
   state_machine_->RegisterHandler(State::WAIT_FOR_HEAVIEST_CHAIN, this, &MainChainRpcService::OnWaitForHeaviestChain);
+  state_machine_->RegisterHandler(State::DOWNLOADING_BLOCKS,      this, &MainChainRpcService::OnDownloadingBlocks);
   state_machine_->RegisterHandler(State::SYNCHRONISING,           this, &MainChainRpcService::OnSynchronising);
   state_machine_->RegisterHandler(State::WAITING_FOR_RESPONSE,    this, &MainChainRpcService::OnWaitingForResponse);
   state_machine_->RegisterHandler(State::SYNCHRONISED,            this, &MainChainRpcService::OnSynchronised);
@@ -145,10 +183,55 @@ MainChainRpcService::MainChainRpcService(MuddleEndpoint &endpoint, MainChain &ch
     // dispatch the event
     OnNewBlock(from, block, transmitter);
   });
+
+  // compact blocks can only be rebuilt with an index of the recently seen transactions
+  if (compact_block_subscription_)
+  {
+    compact_block_subscription_->SetMessageHandler(
+        [this](Address const &from, uint16_t, uint16_t, uint16_t, Packet::Payload const &payload,
+               Address transmitter) {
+          FETCH_LOG_DEBUG(LOGGING_NAME, "Triggering new compact block handler");
+
+          BlockSerializer serialiser(payload);
+
+          // deserialize the compact block
+          CompactBlock compact;
+          serialiser >> compact;
+
+          // dispatch the event
+          OnNewCompactBlock(from, compact, transmitter);
+        });
+  }
+
+  thread_pool_->Start();
+}
+
+MainChainRpcService::~MainChainRpcService()
+{
+  thread_pool_->Stop();
 }
 
 void MainChainRpcService::BroadcastBlock(MainChainRpcService::Block const &block)
 {
+  // only enabled once every node on the network accepts compact blocks
+  if (broadcast_compact_)
+  {
+    CompactBlock const compact{block};
+
+    // determine the serialised size of the compact block
+    BlockSerializerCounter counter;
+    counter << compact;
+
+    // allocate the buffer and serialise the compact block
+    BlockSerializer serializer;
+    serializer.Reserve(counter.size());
+    serializer << compact;
+
+    // broadcast the compact block to the nodes on the network
+    endpoint_.Broadcast(SERVICE_MAIN_CHAIN, CHANNEL_COMPACT_BLOCKS, serializer.data());
+    return;
+  }
+
   // determine the serialised size of the block
   BlockSerializerCounter counter;
   counter << block;
@@ -220,6 +303,218 @@ void MainChainRpcService::OnNewBlock(Address const &from, Block &block, Address
   }
 }
 
+/**
+ * Handle a new compact block from the network, rebuilding it from the recently seen transactions
+ *
+ * @param from The miner of the block
+ * @param compact The compact block
+ * @param transmitter The peer which relayed the block
+ */
+void MainChainRpcService::OnNewCompactBlock(Address const &from, CompactBlock const &compact,
+                                            Address const &transmitter)
+{
+  recv_compact_block_count_->increment();
+
+  BlockHash const &hash = compact.header.body.hash;
+
+  if (chain_.GetBlock(hash))
+  {
+    recv_block_duplicate_count_->increment();
+    FETCH_LOG_DEBUG(LOGGING_NAME, "Duplicate compact block: 0x", hash.ToHex());
+    return;
+  }
+
+  {
+    FETCH_LOCK(compact_lock_);
+    if (compact_requests_.find(hash) != compact_requests_.end())
+    {
+      return;
+    }
+  }
+
+  Block block;
+  auto  missing = compact.Reconstruct(recent_txs_.get(), block);
+
+  if (missing.empty())
+  {
+    if (CompleteCompactBlock(from, block, transmitter))
+    {
+      compact_block_complete_count_->increment();
+      return;
+    }
+
+    // a short id collision selected the wrong transaction, fall back to requesting all of them
+    FETCH_LOG_INFO(LOGGING_NAME, "Compact block 0x", hash.ToHex(),
+                   " reconstruction mismatch, requesting all transactions");
+
+    missing.resize(compact.GetTransactionCount());
+    std::iota(missing.begin(), missing.end(), 0);
+
+    block.body.hash = hash;
+  }
+
+  RequestBlockTransactions(from, transmitter, std::move(block), std::move(missing));
+}
+
+/**
+ * Check the digest of a reconstructed block and if correct handle it as a new block
+ *
+ * @param from The miner of the block
+ * @param block The reconstructed block
+ * @param transmitter The peer which relayed the block
+ * @return true if the block matched the expected digest, otherwise false
+ */
+bool MainChainRpcService::CompleteCompactBlock(Address const &from, Block &block,
+                                               Address const &transmitter)
+{
+  BlockHash const expected_hash = block.body.hash;
+
+  // recalculate the block hash
+  block.UpdateDigest();
+
+  if (block.body.hash != expected_hash)
+  {
+    return false;
+  }
+
+  // dispatch the event
+  OnNewBlock(from, block, transmitter);
+
+  return true;
+}
+
+/**
+ * Request the specified transactions of a compact block from its miner. All the missing
+ * transactions are requested in a single batch.
+ *
+ * @param from The miner of the block
+ * @param transmitter The peer which relayed the block
+ * @param block The partially reconstructed block
+ * @param missing The indices of the missing transactions
+ */
+void MainChainRpcService::RequestBlockTransactions(Address const &from,
+                                                   Address const &transmitter, Block block,
+                                                   TransactionIndices missing)
+{
+  BlockHash const hash = block.body.hash;
+
+  compact_block_fetched_tx_count_->add(missing.size());
+
+  auto promise = rpc_client_.CallSpecificAddress(
+      from, RPC_MAIN_CHAIN, MainChainProtocol::BLOCK_TRANSACTIONS, hash, missing);
+
+  {
+    FETCH_LOCK(compact_lock_);
+
+    // discard any requests which have been abandoned by the peer
+    for (auto it = compact_requests_.begin(); it != compact_requests_.end();)
+    {
+      if (it->second.deadline.IsDue())
+      {
+        compact_block_failure_count_->increment();
+        it = compact_requests_.erase(it);
+      }
+      else
+      {
+        ++it;
+      }
+    }
+
+    // in the worst case the block will be recovered when the chain is synchronised
+    if (compact_requests_.size() >= MAX_COMPACT_BLOCK_REQUESTS)
+    {
+      compact_block_failure_count_->increment();
+      return;
+    }
+
+    compact_requests_[hash] =
+        CompactBlockRequest{from,    transmitter, std::move(block), std::move(missing),
+                            promise, FutureTimepoint{COMPACT_BLOCK_TIMEOUT}};
+  }
+
+  // the promise is completed while the network holds its locks, so defer all the processing
+  std::weak_ptr<MainChainRpcService> weak_self = shared_from_this();
+
+  auto const on_complete = [weak_self, hash]() {
+    auto self = weak_self.lock();
+    if (self)
+    {
+      self->thread_pool_->Post([service = self.get(), hash]() {
+        service->OnBlockTransactions(hash);
+      });
+    }
+  };
+
+  promise->WithHandlers().Then(on_complete).Catch(on_complete);
+}
+
+/**
+ * Handle the response to a request for the missing transactions of a compact block
+ *
+ * @param hash The hash of the block being reconstructed
+ */
+void MainChainRpcService::OnBlockTransactions(BlockHash const &hash)
+{
+  CompactBlockRequest request;
+
+  {
+    FETCH_LOCK(compact_lock_);
+
+    auto it = compact_requests_.find(hash);
+    if (it == compact_requests_.end())
+    {
+      return;
+    }
+
+    request = std::move(it->second);
+    compact_requests_.erase(it);
+  }
+
+  bool filled{false};
+  if (request.promise->IsSuccessful())
+  {
+    try
+    {
+      filled = CompactBlock::Fill(request.block, request.missing,
+                                  request.promise->As<TransactionLayouts>());
+    }
+    catch (std::exception const &ex)
+    {
+      FETCH_LOG_WARN(LOGGING_NAME, "Unable to decode compact block transactions: ", ex.what());
+    }
+  }
+
+  bool const full_request = request.missing.size() == request.block.GetTransactionCount();
+
+  if (filled && CompleteCompactBlock(request.from, request.block, request.transmitter))
+  {
+    return;
+  }
+
+  if (filled && !full_request)
+  {
+    // a short id collision selected the wrong transaction, fall back to requesting all of them
+    TransactionIndices all(request.block.GetTransactionCount());
+    std::iota(all.begin(), all.end(), 0);
+
+    request.block.body.hash = hash;
+    RequestBlockTransactions(request.from, request.transmitter, std::move(request.block),
+                             std::move(all));
+    return;
+  }
+
+  compact_block_failure_count_->increment();
+
+  if (filled || request.promise->IsSuccessful())
+  {
+    // the peer responded with transactions which are not part of the block
+    trust_.AddFeedback(request.from, p2p::TrustSubject::BLOCK, p2p::TrustQuality::LIED);
+  }
+
+  FETCH_LOG_WARN(LOGGING_NAME, "Unable to reconstruct compact block: 0x", hash.ToHex(),
+                 " (from: ", ToBase64(request.from), ")");
+}
+
 MainChainRpcService::Address MainChainRpcService::GetRandomTrustedPeer() const
 {
   static random::LinearCongruentialGenerator rng;
@@ -309,8 +604,52 @@ void MainChainRpcService::HandleChainResponse(Address const &address, BlockList
 }
 
 /**
- * Request from a random peer the heaviest chain, starting from the newest block
- * and going backwards. The client is free to return less blocks than requested.
+ * Request from the current peer the hashes of its heaviest chain, walking backwards from the
+ * specified block (or the heaviest block when empty)
+ *
+ * @param start The hash of the block to start from
+ */
+void MainChainRpcService::RequestChainHashes(BlockHash const &start)
+{
+  current_request_ = rpc_client_.CallSpecificAddress(current_peer_address_, RPC_MAIN_CHAIN,
+                                                     MainChainProtocol::CHAIN_HASHES, start,
+                                                     MAX_CHAIN_HASHES_SIZE);
+}
+
+/**
+ * Add a response of chain hashes (newest first) to the set of missing blocks
+ *
+ * @param hashes The hashes returned from the peer
+ * @return true if the missing range is complete, otherwise false
+ */
+bool MainChainRpcService::AddChainHashes(BlockHashes const &hashes)
+{
+  auto it = hashes.begin();
+
+  // continuation requests start from the oldest hash which has already been recorded
+  if ((it != hashes.end()) && !sync_hashes_.empty() && (*it == sync_hashes_.back()))
+  {
+    ++it;
+  }
+
+  for (; it != hashes.end(); ++it)
+  {
+    // once a block that is already known is found the remainder of the chain is also known
+    if (chain_.GetBlock(*it))
+    {
+      return true;
+    }
+
+    sync_hashes_.push_back(*it);
+  }
+
+  // a short response signals that the start of the chain has been reached
+  return hashes.size() < MAX_CHAIN_HASHES_SIZE;
+}
+
+/**
+ * Request from a random peer the hashes of the heaviest chain, starting from the newest block
+ * and going backwards. The client is free to return less hashes than requested.
  *
  */
 MainChainRpcService::State MainChainRpcService::OnRequestHeaviestChain()
@@ -324,9 +663,9 @@ MainChainRpcService::State MainChainRpcService::OnRequestHeaviestChain()
   if (!peer.empty())
   {
     current_peer_address_ = peer;
-    current_request_ =
-        rpc_client_.CallSpecificAddress(current_peer_address_, RPC_MAIN_CHAIN,
-                                        MainChainProtocol::HEAVIEST_CHAIN, MAX_CHAIN_REQUEST_SIZE);
+    sync_hashes_.clear();
+
+    RequestChainHashes(BlockHash{});
 
     next_state = State::WAIT_FOR_HEAVIEST_CHAIN;
   }
@@ -354,11 +693,30 @@ MainChainRpcService::State MainChainRpcService::OnWaitForHeaviestChain()
     {
       if (PromiseState::SUCCESS == status)
       {
-        // the request was successful, simply hand off the blocks to be added to the chain
-        HandleChainResponse(current_peer_address_, current_request_->As<BlockList>());
-
-        // now we have completed a request we can start normal synchronisation
-        next_state = State::SYNCHRONISING;
+        if (!AddChainHashes(current_request_->As<BlockHashes>()))
+        {
+          // continue walking back down the peer's chain
+          RequestChainHashes(sync_hashes_.back());
+
+          return State::WAIT_FOR_HEAVIEST_CHAIN;
+        }
+
+        if (sync_hashes_.empty())
+        {
+          // nothing to download, we can start normal synchronisation
+          next_state = State::SYNCHRONISING;
+        }
+        else
+        {
+          FETCH_LOG_INFO(LOGGING_NAME, "Downloading ", sync_hashes_.size(), " missing blocks");
+
+          // the download is scheduled oldest block first
+          std::reverse(sync_hashes_.begin(), sync_hashes_.end());
+          download_scheduler_.Reset(std::move(sync_hashes_));
+          sync_hashes_.clear();
+
+          next_state = State::DOWNLOADING_BLOCKS;
+        }
       }
       else
       {
@@ -367,6 +725,7 @@ MainChainRpcService::State MainChainRpcService::OnWaitForHeaviestChain()
 
         // since we want to sync at least with one chain before proceeding we restart the state
         // machine back to the requesting
+        sync_hashes_.clear();
         next_state = State::REQUEST_HEAVIEST_CHAIN;
       }
 
@@ -379,6 +738,126 @@ MainChainRpcService::State MainChainRpcService::OnWaitForHeaviestChain()
   return next_state;
 }
 
+/**
+ * Internal: Hand the completed (or timed out) download requests to the scheduler
+ */
+void MainChainRpcService::CollectDownloads()
+{
+  for (auto it = download_requests_.begin(); it != download_requests_.end();)
+  {
+    auto const  window  = it->first;
+    auto const &request = it->second;
+    auto const  status  = request.promise->GetState();
+
+    if ((PromiseState::WAITING == status) && !request.deadline.IsDue())
+    {
+      ++it;
+      continue;
+    }
+
+    char const *failure{nullptr};
+    if (PromiseState::SUCCESS == status)
+    {
+      auto const response = download_scheduler_.OnResponse(window, request.peer,
+                                                           request.promise->As<BlockList>());
+
+      switch (response)
+      {
+      case ResponseStatus::ACCEPTED:
+        break;
+      case ResponseStatus::INCOMPLETE:
+        // the peer is (most likely) just behind, the window is retried without any penalty
+        failure = "Incomplete response";
+        break;
+      case ResponseStatus::INVALID:
+        // the peer returned blocks which are not part of the chain being downloaded
+        trust_.AddFeedback(request.peer, p2p::TrustSubject::BLOCK, p2p::TrustQuality::LIED);
+        failure = "Invalid response";
+        break;
+      case ResponseStatus::UNEXPECTED:
+        failure = "Unexpected response";
+        break;
+      }
+    }
+    else
+    {
+      download_scheduler_.OnFailure(window, request.peer);
+      failure = (PromiseState::WAITING == status) ? "Timed out" : service::ToString(status);
+    }
+
+    if (failure)
+    {
+      download_failure_count_->increment();
+
+      FETCH_LOG_INFO(LOGGING_NAME, "Block download from: ", ToBase64(request.peer),
+                     " failed. Reason: ", failure);
+    }
+
+    it = download_requests_.erase(it);
+  }
+}
+
+/**
+ * Internal: Abandon all the outstanding downloads
+ */
+void MainChainRpcService::ClearDownloads()
+{
+  download_requests_.clear();
+  download_scheduler_.Clear();
+}
+
+/**
+ * Download the missing blocks from all the connected peers, adding them to the chain in order
+ */
+MainChainRpcService::State MainChainRpcService::OnDownloadingBlocks()
+{
+  state_downloading_->increment();
+
+  CollectDownloads();
+
+  // add all the blocks which are now available to the chain
+  Address   peer{};
+  BlockList blocks{};
+  while (download_scheduler_.PopCompleted(peer, blocks))
+  {
+    download_block_count_->add(blocks.size());
+    HandleChainResponse(peer, std::move(blocks));
+  }
+
+  if (download_scheduler_.failed())
+  {
+    FETCH_LOG_WARN(LOGGING_NAME, "Block download failed, restarting synchronisation");
+
+    ClearDownloads();
+    return State::REQUEST_HEAVIEST_CHAIN;
+  }
+
+  if (download_scheduler_.complete())
+  {
+    FETCH_LOG_INFO(LOGGING_NAME, "Block download complete");
+
+    ClearDownloads();
+    return State::SYNCHRONISING;
+  }
+
+  // dispatch the next set of requests
+  auto const requests = download_scheduler_.Schedule(endpoint_.GetDirectlyConnectedPeers());
+  for (auto const &request : requests)
+  {
+    FETCH_LOG_DEBUG(LOGGING_NAME, "Requesting ", request.num_blocks, " blocks from muddle://",
+                    ToBase64(request.peer));
+
+    auto promise = rpc_client_.CallSpecificAddress(
+        request.peer, RPC_MAIN_CHAIN, MainChainProtocol::TIME_TRAVEL, request.last_hash,
+        -static_cast<int64_t>(request.num_blocks));
+
+    download_requests_[request.window] =
+        DownloadRequest{request.peer, std::move(promise), FutureTimepoint{DOWNLOAD_TIMEOUT}};
+  }
+
+  return State::DOWNLOADING_BLOCKS;
+}
+
 MainChainRpcService::State MainChainRpcService::OnSynchronising()
 {
   state_synchronising_->increment();
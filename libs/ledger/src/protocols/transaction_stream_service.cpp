@@ -0,0 +1,102 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/byte_array/encoders.hpp"
+#include "core/logging.hpp"
+#include "core/service_ids.hpp"
+#include "ledger/protocols/transaction_stream_service.hpp"
+#include "ledger/transaction_processor.hpp"
+#include "telemetry/counter.hpp"
+#include "telemetry/registry.hpp"
+
+#include <utility>
+
+namespace fetch {
+namespace ledger {
+
+using byte_array::ToBase64;
+
+constexpr char const *TransactionStreamService::LOGGING_NAME;
+
+/**
+ * Construct the transaction stream service
+ *
+ * @param endpoint The muddle endpoint the streams are received on
+ * @param processor The processor the decoded transactions are handed to
+ */
+TransactionStreamService::TransactionStreamService(MuddleEndpoint &      endpoint,
+                                                   TransactionProcessor &processor)
+  : processor_{processor}
+  , decoders_{[this](TransactionList &&txs) { OnTransactions(std::move(txs)); }}
+  , subscription_{endpoint.Subscribe(SERVICE_TX_STREAM, CHANNEL_TX_FRAMES)}
+  , recv_message_count_{telemetry::Registry::Instance().CreateCounter(
+        "ledger_tx_stream_service_recv_message_total",
+        "The total number of transaction stream messages received")}
+  , recv_tx_count_{telemetry::Registry::Instance().CreateCounter(
+        "ledger_tx_stream_service_recv_tx_total",
+        "The total number of transactions decoded from the streams")}
+  , recv_malformed_count_{telemetry::Registry::Instance().CreateCounter(
+        "ledger_tx_stream_service_recv_malformed_total",
+        "The total number of streams discarded because their framing was broken")}
+  , recv_dropped_count_{telemetry::Registry::Instance().CreateCounter(
+        "ledger_tx_stream_service_recv_dropped_total",
+        "The total number of partial streams discarded because they were idle or evicted")}
+{
+  subscription_->SetMessageHandler([this](Address const &from, uint16_t, uint16_t, uint16_t,
+                                          Payload const &payload, Address const &) {
+    OnMessage(from, payload);
+  });
+}
+
+/**
+ * Internal: Handle the next message of a stream
+ *
+ * @param from The sender of the stream
+ * @param payload The next part of the stream
+ */
+void TransactionStreamService::OnMessage(Address const &from, Payload const &payload)
+{
+  recv_message_count_->increment();
+
+  FETCH_LOCK(lock_);
+
+  auto const dropped = decoders_.dropped();
+
+  if (!decoders_.Feed(from, payload))
+  {
+    FETCH_LOG_WARN(LOGGING_NAME, "Discarding malformed transaction stream from: ",
+                   ToBase64(from));
+    recv_malformed_count_->increment();
+  }
+
+  recv_dropped_count_->add(decoders_.dropped() - dropped);
+}
+
+/**
+ * Internal: Hand a batch of decoded transactions on to the processor
+ *
+ * @param txs The decoded transactions
+ */
+void TransactionStreamService::OnTransactions(TransactionList &&txs)
+{
+  recv_tx_count_->add(txs.size());
+  processor_.AddTransactions(std::move(txs));
+}
+
+}  // namespace ledger
+}  // namespace fetch
@@ -46,18 +46,22 @@ void CachedStorageAdapter::Flush()
 
   if (flush_required_)
   {
+    KeyValues values{};
+
     for (auto &entry : cache_)
     {
       if (!entry.second.flushed)
       {
-        // set the value on the storage engine
-        storage_.Set(entry.first, entry.second.value);
+        values.emplace_back(entry.first, entry.second.value);
 
         // signal the entry as flushed
         entry.second.flushed = true;
       }
     }
 
+    // set all the values on the storage engine in a single batch
+    storage_.SetMany(values);
+
     // reset the top level flush flag
     flush_required_ = false;
   }
@@ -74,6 +78,45 @@ void CachedStorageAdapter::Clear()
   flush_required_ = false;
 }
 
+/**
+ * Populate the cache with a series of resources from the storage engine in a single batched
+ * request. Resources which are already cached or which are not present in the storage engine are
+ * ignored.
+ *
+ * @param keys The keys to be prefetched
+ */
+void CachedStorageAdapter::Prefetch(ResourceAddresses const &keys)
+{
+  ResourceAddresses missing{};
+  missing.reserve(keys.size());
+
+  for (auto const &key : keys)
+  {
+    if (!HasCacheEntry(key))
+    {
+      missing.push_back(key);
+    }
+  }
+
+  if (missing.empty())
+  {
+    return;
+  }
+
+  auto const docs = storage_.GetMany(missing);
+  assert(docs.size() == missing.size());
+
+  FETCH_LOCK(lock_);
+  for (std::size_t i = 0; i < docs.size(); ++i)
+  {
+    // prefetched values are a copy of the storage engine, therefore they do not need flushing
+    if (!docs[i].failed)
+    {
+      cache_.emplace(missing[i], CacheEntry{docs[i].document, true});
+    }
+  }
+}
+
 /**
  * Get a resource from the storage engine or cache
  *
@@ -154,6 +197,40 @@ void CachedStorageAdapter::Set(ResourceAddress const &key, StateValue const &val
   AddCacheEntry(key, value);
 }
 
+/**
+ * Get a series of resources from the storage engine or cache
+ *
+ * @param keys The keys to be accessed
+ * @return The documents containing the results, in the same order as the keys
+ */
+CachedStorageAdapter::Documents CachedStorageAdapter::GetMany(ResourceAddresses const &keys)
+{
+  Prefetch(keys);
+
+  Documents docs{};
+  docs.reserve(keys.size());
+
+  for (auto const &key : keys)
+  {
+    docs.emplace_back(Get(key));
+  }
+
+  return docs;
+}
+
+/**
+ * Set a series of values to the storage engine
+ *
+ * @param values The key value pairs being set
+ */
+void CachedStorageAdapter::SetMany(KeyValues const &values)
+{
+  for (auto const &value : values)
+  {
+    AddCacheEntry(value.first, value.second);
+  }
+}
+
 /**
  * Lock a resource on the storage engine
  *
@@ -58,7 +58,7 @@ std::string GeneratePrefix(std::string const &storage_path, uint32_t lane)
 }  // namespace
 
 LaneService::LaneService(NetworkManager nm, ShardConfig config, bool sign_packets, Mode mode)
-  : tx_store_(std::make_shared<TxStore>(meta::Log2(config.num_lanes)))
+  : tx_store_(std::make_shared<TxStore>(meta::Log2(config.num_lanes), config.lane_id))
   , reactor_("LaneServiceReactor")
   , cfg_{std::move(config)}
 {
@@ -137,6 +137,11 @@ LaneService::LaneService(NetworkManager nm, ShardConfig config, bool sign_packet
     break;
   }
 
+  state_db_->SetCheckpointPolicy(cfg_.state_checkpoint_interval, cfg_.max_state_checkpoints);
+
+  // hot state (token balances and the like) is read far more often than it is written
+  state_db_->EnableCache("state_lane" + std::to_string(cfg_.lane_id));
+
   state_db_protocol_ =
       std::make_shared<StateDbProto>(state_db_.get(), cfg_.lane_id, cfg_.num_lanes);
   internal_rpc_server_->Add(RPC_STATE, state_db_protocol_.get());
@@ -150,8 +155,6 @@ LaneService::~LaneService()
 {
   reactor_.Stop();
 
-  workthread_ = nullptr;
-
   FETCH_LOG_INFO(LOGGING_NAME, "Lane ", cfg_.lane_id, " Teardown.");
 
   external_muddle_->Shutdown();
@@ -190,18 +193,20 @@ void LaneService::Start()
 
   tx_sync_service_->Start();
 
-  // TX Sync service - attach to reactor once #892 is merged
-  workthread_ =
-      std::make_shared<BackgroundedWorkThread>(&bg_work_, "BW:LS-" + std::to_string(cfg_.lane_id),
-                                               [this]() { tx_sync_service_->Execute(); });
-  workthread_->ChangeWaitTime(std::chrono::milliseconds{unsigned{SYNC_PERIOD_MS}});
+  // TX Sync service
+  reactor_.Attach(tx_sync_service_->GetWeakRunnable());
 }
 
 void LaneService::Stop()
 {
   FETCH_LOG_INFO(LOGGING_NAME, "Lane ", cfg_.lane_id, " Stopping.");
+  auto runnable = tx_sync_service_->GetWeakRunnable().lock();
+  if (runnable)
+  {
+    reactor_.Detach(*runnable);
+  }
+
   tx_sync_service_->Stop();
-  workthread_ = nullptr;
 
   external_muddle_->Stop();
   internal_muddle_->Stop();
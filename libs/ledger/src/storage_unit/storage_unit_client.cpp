@@ -43,6 +43,16 @@ namespace {
 
 using AddressList = std::vector<MuddleEndpoint::Address>;
 
+/**
+ * The set of requests, from a batched operation, which are destined for a single lane
+ */
+template <typename T>
+struct LaneBatch
+{
+  std::vector<T>           requests{};   ///< The requests to be sent to the lane
+  std::vector<std::size_t> positions{};  ///< The index of each request in the original batch
+};
+
 AddressList GenerateAddressList(ShardConfigs const &shards)
 {
   AddressList addresses{};
@@ -424,6 +434,77 @@ bool StorageUnitClient::GetTransaction(byte_array::ConstByteArray const &digest,
   return success;
 }
 
+bool StorageUnitClient::GetTransactions(Digests const &digests, Transactions &txs)
+{
+  using ElementList = TxStoreProtocol::ElementList;
+
+  txs.clear();
+  txs.resize(digests.size());
+
+  // group the requests by the lane which is responsible for them
+  std::vector<LaneBatch<ResourceID>> batches(num_lanes());
+  for (std::size_t i = 0; i < digests.size(); ++i)
+  {
+    ResourceID resource{digests[i]};
+
+    auto &batch = batches.at(resource.lane(log2_num_lanes_));
+    batch.requests.emplace_back(std::move(resource));
+    batch.positions.push_back(i);
+  }
+
+  // issue all the requests before waiting on any of them, i.e. a single round trip per lane
+  std::vector<service::Promise> promises(batches.size());
+  for (uint32_t lane = 0; lane < num_lanes(); ++lane)
+  {
+    if (!batches[lane].requests.empty())
+    {
+      promises[lane] = rpc_client_->CallSpecificAddress(
+          LookupAddress(lane), RPC_TX_STORE, TxStoreProtocol::GET_BULK, batches[lane].requests);
+    }
+  }
+
+  std::size_t num_retrieved{0};
+  for (std::size_t lane = 0; lane < promises.size(); ++lane)
+  {
+    if (!promises[lane])
+    {
+      continue;
+    }
+
+    auto const &batch = batches[lane];
+
+    try
+    {
+      auto const elements = promises[lane]->As<ElementList>();
+
+      // the response preserves the order of the request but omits any missing transactions
+      std::size_t index{0};
+      for (auto const &element : elements)
+      {
+        while ((index < batch.requests.size()) && !(batch.requests[index] == element.key))
+        {
+          ++index;
+        }
+
+        if (index == batch.requests.size())
+        {
+          break;
+        }
+
+        txs[batch.positions[index++]] = element.value;
+        ++num_retrieved;
+      }
+    }
+    catch (std::exception const &e)
+    {
+      FETCH_LOG_WARN(LOGGING_NAME, "Unable to get transactions from lane ", lane,
+                     ", because: ", e.what());
+    }
+  }
+
+  return num_retrieved == digests.size();
+}
+
 bool StorageUnitClient::HasTransaction(ConstByteArray const &digest)
 {
   bool present{false};
@@ -538,6 +619,110 @@ void StorageUnitClient::Set(ResourceAddress const &key, StateValue const &value)
   }
 }
 
+StorageUnitClient::Documents StorageUnitClient::GetMany(ResourceAddresses const &keys)
+{
+  Documents docs(keys.size());
+
+  // group the requests by the lane which is responsible for them
+  std::vector<LaneBatch<ResourceID>> batches(num_lanes());
+  for (std::size_t i = 0; i < keys.size(); ++i)
+  {
+    auto &batch = batches.at(keys[i].lane(log2_num_lanes_));
+    batch.requests.emplace_back(keys[i].as_resource_id());
+    batch.positions.push_back(i);
+  }
+
+  // issue all the requests before waiting on any of them, i.e. a single round trip per lane
+  std::vector<service::Promise> promises(batches.size());
+  for (uint32_t lane = 0; lane < num_lanes(); ++lane)
+  {
+    if (!batches[lane].requests.empty())
+    {
+      promises[lane] =
+          rpc_client_->CallSpecificAddress(LookupAddress(lane), RPC_STATE,
+                                           RevertibleDocumentStoreProtocol::GET_MANY,
+                                           batches[lane].requests);
+    }
+  }
+
+  for (std::size_t lane = 0; lane < promises.size(); ++lane)
+  {
+    if (!promises[lane])
+    {
+      continue;
+    }
+
+    auto const &batch = batches[lane];
+
+    try
+    {
+      auto lane_docs = promises[lane]->As<Documents>();
+
+      if (lane_docs.size() != batch.positions.size())
+      {
+        throw std::runtime_error("Mismatched number of documents in response");
+      }
+
+      for (std::size_t i = 0; i < lane_docs.size(); ++i)
+      {
+        docs[batch.positions[i]] = std::move(lane_docs[i]);
+      }
+    }
+    catch (std::exception const &e)
+    {
+      FETCH_LOG_WARN(LOGGING_NAME, "Unable to get documents from lane ", lane,
+                     ", because: ", e.what());
+
+      // signal the failure for all the documents in this lane
+      for (auto const position : batch.positions)
+      {
+        docs[position].failed = true;
+      }
+    }
+  }
+
+  return docs;
+}
+
+void StorageUnitClient::SetMany(KeyValues const &values)
+{
+  using Element = RevertibleDocumentStoreProtocol::Element;
+
+  // group the requests by the lane which is responsible for them
+  std::vector<LaneBatch<Element>> batches(num_lanes());
+  for (auto const &value : values)
+  {
+    batches.at(value.first.lane(log2_num_lanes_))
+        .requests.emplace_back(Element{value.first.as_resource_id(), value.second});
+  }
+
+  // issue all the requests before waiting on any of them, i.e. a single round trip per lane
+  std::vector<service::Promise> promises;
+  promises.reserve(batches.size());
+  for (uint32_t lane = 0; lane < num_lanes(); ++lane)
+  {
+    if (!batches[lane].requests.empty())
+    {
+      promises.emplace_back(rpc_client_->CallSpecificAddress(
+          LookupAddress(lane), RPC_STATE, RevertibleDocumentStoreProtocol::SET_MANY,
+          batches[lane].requests));
+    }
+  }
+
+  for (auto &promise : promises)
+  {
+    try
+    {
+      promise->Wait();
+    }
+    catch (std::exception const &e)
+    {
+      FETCH_LOG_WARN(LOGGING_NAME, "Failed to call SET_MANY (store documents), because: ",
+                     e.what());
+    }
+  }
+}
+
 bool StorageUnitClient::Lock(ShardIndex index)
 {
   bool success{false};
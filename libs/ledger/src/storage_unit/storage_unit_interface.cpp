@@ -0,0 +1,83 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "ledger/chain/transaction.hpp"
+#include "ledger/storage_unit/storage_unit_interface.hpp"
+
+namespace fetch {
+namespace ledger {
+
+/**
+ * Get a series of resources from the storage engine.
+ *
+ * The default implementation simply makes a single request per key. Implementations which are
+ * backed by a remote store should override this in order to amortise the cost of the round trip.
+ *
+ * @param keys The keys to be accessed
+ * @return The documents in the same order as the requested keys
+ */
+StorageInterface::Documents StorageInterface::GetMany(ResourceAddresses const &keys)
+{
+  Documents documents{};
+  documents.reserve(keys.size());
+
+  for (auto const &key : keys)
+  {
+    documents.emplace_back(Get(key));
+  }
+
+  return documents;
+}
+
+/**
+ * Set a series of values on the storage engine
+ *
+ * @param values The key value pairs to be set
+ */
+void StorageInterface::SetMany(KeyValues const &values)
+{
+  for (auto const &element : values)
+  {
+    Set(element.first, element.second);
+  }
+}
+
+/**
+ * Retrieve a series of transactions from the storage engine
+ *
+ * @param digests The digests of the transactions to be retrieved
+ * @param txs The output list of transactions, in the same order as the requested digests
+ * @return true if all the transactions were retrieved, otherwise false
+ */
+bool StorageUnitInterface::GetTransactions(Digests const &digests, Transactions &txs)
+{
+  bool success{true};
+
+  txs.clear();
+  txs.resize(digests.size());
+
+  for (std::size_t i = 0; i < digests.size(); ++i)
+  {
+    success &= GetTransaction(digests[i], txs[i]);
+  }
+
+  return success;
+}
+
+}  // namespace ledger
+}  // namespace fetch
@@ -0,0 +1,344 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "ledger/storage_unit/subtree_sync_scheduler.hpp"
+
+#include <algorithm>
+#include <cassert>
+
+namespace fetch {
+namespace ledger {
+namespace {
+
+using Duration     = SubtreeSyncScheduler::Duration;
+using Microseconds = std::chrono::microseconds;
+
+// A response is considered to be uncongested when its round trip time is within this factor of the
+// fastest round trip time seen for the peer
+constexpr int64_t LATENCY_TOLERANCE = 2;
+
+constexpr Duration MIN_TIMEOUT{250};
+constexpr Duration MAX_TIMEOUT{60000};
+
+}  // namespace
+
+constexpr uint32_t    SubtreeSyncScheduler::DEFAULT_MAX_BITS;
+constexpr std::size_t SubtreeSyncScheduler::DEFAULT_INITIAL_WINDOW;
+constexpr std::size_t SubtreeSyncScheduler::DEFAULT_MAX_WINDOW;
+
+/**
+ * Construct the scheduler
+ *
+ * @param pull_limit The maximum number of objects a peer will return for a single subtree
+ * @param initial_timeout The request timeout used for peers with no latency measurements
+ * @param max_window The maximum number of outstanding requests per peer
+ * @param max_bits The maximum length of a subtree prefix
+ */
+SubtreeSyncScheduler::SubtreeSyncScheduler(uint64_t pull_limit, Duration initial_timeout,
+                                           std::size_t max_window, uint32_t max_bits)
+  : pull_limit_{std::max<uint64_t>(pull_limit, 1)}
+  , initial_timeout_{initial_timeout}
+  , max_window_{std::max<std::size_t>(max_window, 1)}
+  , max_bits_{std::min<uint32_t>(max_bits, 31)}
+{}
+
+/**
+ * Start a new sync, splitting the key space into 2^bits subtrees
+ *
+ * @param bits The length of the initial subtree prefixes
+ */
+void SubtreeSyncScheduler::Reset(uint32_t bits)
+{
+  Clear();
+
+  bits = std::min(bits, max_bits_);
+
+  for (uint32_t prefix = 0, end = (1u << bits); prefix < end; ++prefix)
+  {
+    pending_.emplace_back(PendingSubtree{Subtree{prefix, bits}, Address{}});
+  }
+}
+
+/**
+ * Abandon the current sync
+ */
+void SubtreeSyncScheduler::Clear()
+{
+  pending_.clear();
+  in_flight_.clear();
+  peers_.clear();
+
+  num_completed_ = 0;
+}
+
+/**
+ * Assign pending subtrees to the available peers, up to the window of each peer
+ *
+ * @param peers The peers which are currently available
+ * @param now The current time
+ * @return The set of requests which should be made
+ */
+SubtreeSyncScheduler::Requests SubtreeSyncScheduler::Schedule(Addresses const &peers,
+                                                              Timepoint const &now)
+{
+  Requests requests{};
+
+  while (!pending_.empty())
+  {
+    auto const &next = pending_.front();
+
+    // select the peer with the most spare capacity, avoiding the peer which last failed
+    Address const *selected{nullptr};
+    std::size_t    selected_capacity{0};
+
+    for (auto const &address : peers)
+    {
+      auto const &peer = LookupPeer(address);
+
+      std::size_t capacity = (peer.in_flight < peer.window) ? peer.window - peer.in_flight : 0;
+      if (capacity && (address == next.failed_peer))
+      {
+        // only used if no other peer is available
+        capacity = 0;
+        if (!selected)
+        {
+          selected = &address;
+        }
+      }
+
+      if (capacity > selected_capacity)
+      {
+        selected          = &address;
+        selected_capacity = capacity;
+      }
+    }
+
+    if (!selected)
+    {
+      // all the peers are busy
+      break;
+    }
+
+    auto &peer = LookupPeer(*selected);
+    ++peer.in_flight;
+
+    RequestId const id = next_id_++;
+    in_flight_.emplace(id, InFlightSubtree{next.subtree, *selected, now,
+                                           now + CalculateTimeout(peer)});
+    requests.emplace_back(Request{id, *selected, next.subtree});
+
+    pending_.pop_front();
+  }
+
+  return requests;
+}
+
+/**
+ * Handle the response to a subtree request
+ *
+ * @param id The id of the request
+ * @param num_objects The number of objects returned by the peer
+ * @param now The time at which the response was received
+ * @return true if the request was in flight, otherwise false
+ */
+bool SubtreeSyncScheduler::OnResponse(RequestId id, std::size_t num_objects, Timepoint const &now)
+{
+  auto it = in_flight_.find(id);
+  if (it == in_flight_.end())
+  {
+    return false;
+  }
+
+  auto &      peer    = LookupPeer(it->second.peer);
+  auto const &subtree = it->second.subtree;
+
+  // update the latency estimates for the peer
+  auto const rtt = std::max(std::chrono::duration_cast<Microseconds>(now - it->second.sent),
+                            Microseconds{1});
+
+  if (!peer.has_sample)
+  {
+    peer.has_sample = true;
+    peer.min_rtt    = rtt;
+    peer.srtt       = rtt;
+    peer.rttvar     = rtt / 2;
+  }
+  else
+  {
+    auto const error = rtt - peer.srtt;
+
+    peer.min_rtt = std::min(peer.min_rtt, rtt);
+    peer.srtt += error / 8;
+    peer.rttvar += (((error < Microseconds::zero()) ? -error : error) - peer.rttvar) / 4;
+  }
+
+  // grow the window while the peer keeps up with the requests, otherwise back off
+  if (rtt <= (peer.min_rtt * LATENCY_TOLERANCE))
+  {
+    peer.window = std::min(peer.window + 1u, max_window_);
+  }
+  else if (peer.window > 1u)
+  {
+    --peer.window;
+  }
+
+  if ((num_objects >= pull_limit_) && (subtree.bits < max_bits_))
+  {
+    // the response was truncated, pull the remainder of the subtree as two smaller subtrees
+    uint32_t const bits = subtree.bits + 1u;
+
+    pending_.emplace_front(PendingSubtree{Subtree{subtree.prefix | (1u << subtree.bits), bits}});
+    pending_.emplace_front(PendingSubtree{Subtree{subtree.prefix, bits}});
+  }
+  else
+  {
+    ++num_completed_;
+  }
+
+  Release(it, true);
+
+  return true;
+}
+
+/**
+ * Handle a failed subtree request. The subtree is retried, preferring a different peer.
+ *
+ * @param id The id of the request
+ */
+void SubtreeSyncScheduler::OnFailure(RequestId id)
+{
+  auto it = in_flight_.find(id);
+  if (it != in_flight_.end())
+  {
+    Release(it, false);
+  }
+}
+
+/**
+ * Fail all the requests which have not received a response before their deadline
+ *
+ * @param now The current time
+ * @return The ids of the requests which have expired
+ */
+SubtreeSyncScheduler::RequestIds SubtreeSyncScheduler::Expire(Timepoint const &now)
+{
+  RequestIds expired{};
+
+  auto it = in_flight_.begin();
+  while (it != in_flight_.end())
+  {
+    auto current = it++;
+
+    if (current->second.deadline <= now)
+    {
+      expired.push_back(current->first);
+      Release(current, false);
+    }
+  }
+
+  return expired;
+}
+
+/**
+ * Get the current window size for a peer
+ *
+ * @param peer The address of the peer
+ * @return The maximum number of outstanding requests for the peer
+ */
+std::size_t SubtreeSyncScheduler::GetWindow(Address const &peer) const
+{
+  auto it = peers_.find(peer);
+  return (it == peers_.end()) ? std::min(DEFAULT_INITIAL_WINDOW, max_window_) : it->second.window;
+}
+
+/**
+ * Get the current request timeout for a peer
+ *
+ * @param peer The address of the peer
+ * @return The timeout applied to new requests to the peer
+ */
+SubtreeSyncScheduler::Duration SubtreeSyncScheduler::GetTimeout(Address const &peer) const
+{
+  auto it = peers_.find(peer);
+  return (it == peers_.end()) ? initial_timeout_ : CalculateTimeout(it->second);
+}
+
+/**
+ * Internal: Calculate the request timeout for a peer from its latency estimates
+ *
+ * @param peer The state of the peer
+ * @return The request timeout
+ */
+SubtreeSyncScheduler::Duration SubtreeSyncScheduler::CalculateTimeout(PeerState const &peer) const
+{
+  if (!peer.has_sample)
+  {
+    return initial_timeout_;
+  }
+
+  auto const timeout = std::chrono::duration_cast<Duration>(peer.srtt + (peer.rttvar * 4)) +
+                       Duration{1};
+
+  return std::min(std::max(timeout, MIN_TIMEOUT), MAX_TIMEOUT);
+}
+
+/**
+ * Internal: Lookup the state of a peer, creating it if this is the first request to the peer
+ *
+ * @param address The address of the peer
+ * @return The state of the peer
+ */
+SubtreeSyncScheduler::PeerState &SubtreeSyncScheduler::LookupPeer(Address const &address)
+{
+  auto it = peers_.find(address);
+  if (it == peers_.end())
+  {
+    PeerState state{};
+    state.window = std::min(DEFAULT_INITIAL_WINDOW, max_window_);
+
+    it = peers_.emplace(address, state).first;
+  }
+
+  return it->second;
+}
+
+/**
+ * Internal: Update the peer state at the end of a request and stop tracking it
+ *
+ * @param it The iterator to the in flight request
+ * @param success Flag to signal if the request was successful
+ */
+void SubtreeSyncScheduler::Release(InFlightMap::iterator it, bool success)
+{
+  auto &peer = LookupPeer(it->second.peer);
+
+  assert(peer.in_flight > 0);
+  --peer.in_flight;
+
+  if (!success)
+  {
+    peer.window = std::max<std::size_t>(peer.window / 2u, 1u);
+
+    pending_.emplace_back(PendingSubtree{it->second.subtree, it->second.peer});
+  }
+
+  in_flight_.erase(it);
+}
+
+}  // namespace ledger
+}  // namespace fetch
@@ -23,6 +23,7 @@
 #include <cassert>
 #include <chrono>
 #include <memory>
+#include <utility>
 
 static char const *FETCH_MAYBE_UNUSED ToString(fetch::ledger::tx_sync::State state)
 {
@@ -63,6 +64,31 @@ static char const *FETCH_MAYBE_UNUSED ToString(fetch::ledger::tx_sync::State sta
 
 namespace fetch {
 namespace ledger {
+namespace {
+
+using fetch::service::PromiseState;
+
+/**
+ * Build the resource id prefix for a subtree, the prefix bits are stored least significant bit of
+ * the first byte first in order to match the ordering of the storage keys
+ *
+ * @param subtree The subtree to be pulled
+ * @return The resource id prefix
+ */
+byte_array::ByteArray ToResourcePrefix(SubtreeSyncScheduler::Subtree const &subtree)
+{
+  byte_array::ByteArray prefix;
+  prefix.Resize(std::size_t{storage::ResourceID::RESOURCE_ID_SIZE_IN_BYTES});
+
+  for (std::size_t i = 0; i < sizeof(subtree.prefix); ++i)
+  {
+    prefix[i] = static_cast<uint8_t>(subtree.prefix >> (i * 8u));
+  }
+
+  return prefix;
+}
+
+}  // namespace
 
 TransactionStoreSyncService::TransactionStoreSyncService(Config const &cfg, MuddlePtr muddle,
                                                          ObjectStorePtr    store,
@@ -78,6 +104,7 @@ TransactionStoreSyncService::TransactionStoreSyncService(Config const &cfg, Mudd
                                      muddle_->AsEndpoint(), SERVICE_LANE, CHANNEL_RPC))
   , store_(std::move(store))
   , verifier_(*this, cfg_.verification_threads, "TxV-L" + std::to_string(cfg_.lane_id))
+  , subtree_scheduler_(PULL_LIMIT, cfg_.promise_wait_timeout, cfg_.max_subtree_window)
 {
   state_machine_->RegisterHandler(State::INITIAL, this, &TransactionStoreSyncService::OnInitial);
   state_machine_->RegisterHandler(State::QUERY_OBJECT_COUNTS, this,
@@ -115,6 +142,8 @@ TransactionStoreSyncService::State TransactionStoreSyncService::OnInitial()
 {
   if (muddle_->AsEndpoint().GetDirectlyConnectedPeers().empty())
   {
+    state_machine_->Delay(std::chrono::milliseconds{100});
+
     return State::INITIAL;
   }
 
@@ -166,144 +195,137 @@ TransactionStoreSyncService::State TransactionStoreSyncService::OnResolvingObjec
     }
   }
 
-  // If there are objects to sync from the network, fetch N roots from each of the peers in
-  // parallel. So if we decided to split the sync into 4 roots, the mask would be 2 (bits) and
-  // the roots to sync 00, 10, 01 and 11...
-  // where roots to sync are all objects with the key starting with those bits
+  // If there are objects to sync from the network, split the key space into 2^N subtrees which
+  // are then pulled from all of the peers in parallel. So if we decided to split the sync into 4
+  // subtrees, the prefix would be 2 (bits) and the subtrees to sync 00, 10, 01 and 11...
+  // where subtrees to sync are all objects with the key starting with those bits. Subtrees which
+  // turn out to be larger than the pull limit are split further by the scheduler.
   if (max_object_count_ == 0)
   {
     FETCH_LOG_DEBUG(LOGGING_NAME, "Network appears to have no transactions! Number of peers: ",
                     muddle_->AsEndpoint().GetDirectlyConnectedPeers().size());
-  }
-  else
-  {
-    FETCH_LOG_DEBUG(LOGGING_NAME, "Lane ", cfg_.lane_id, ": ",
-                    "Expected tx size: ", max_object_count_);
 
-    root_size_ = platform::Log2Ceil(((max_object_count_ / (PULL_LIMIT / 2)) + 1)) + 1;
-
-    for (uint64_t i = 0, end = (1u << root_size_); i < end; ++i)
-    {
-      roots_to_sync_.push(static_cast<uint8_t>(i));
-    }
-  }
-
-  if (roots_to_sync_.empty())
-  {
     state_machine_->Delay(std::chrono::milliseconds{20});
 
     return State::QUERY_OBJECT_COUNTS;
   }
 
+  FETCH_LOG_DEBUG(LOGGING_NAME, "Lane ", cfg_.lane_id, ": ",
+                  "Expected tx size: ", max_object_count_);
+
+  auto const bits = platform::Log2Ceil(((max_object_count_ / (PULL_LIMIT / 2)) + 1)) + 1;
+  subtree_scheduler_.Reset(static_cast<uint32_t>(bits));
+
   return State::QUERY_SUBTREE;
 }
 
 TransactionStoreSyncService::State TransactionStoreSyncService::OnQuerySubtree()
 {
-  assert(!roots_to_sync_.empty());
-
-  // sanity check that this is not the case
-  for (auto const &connection : muddle_->AsEndpoint().GetDirectlyConnectedPeers())
+  // only pull more transactions once the verifier has caught up, the pulled transactions are
+  // verified in the background while the next subtrees are being fetched
+  if (verifier_.GetBacklog() >= MAX_VERIFIER_BACKLOG)
   {
-    // if there are no further roots to sync then we need to exit
-    if (roots_to_sync_.empty())
-    {
-      break;
-    }
-
-    // extract the next root to sync
-    auto root = roots_to_sync_.front();
-    roots_to_sync_.pop();
-
-    byte_array::ByteArray transactions_prefix;
+    return State::RESOLVING_SUBTREE;
+  }
 
-    transactions_prefix.Resize(std::size_t{ResourceID::RESOURCE_ID_SIZE_IN_BYTES});
-    transactions_prefix[0] = root;
+  auto const requests =
+      subtree_scheduler_.Schedule(muddle_->AsEndpoint().GetDirectlyConnectedPeers());
 
+  for (auto const &request : requests)
+  {
     auto promise = PromiseOfTxList(client_->CallSpecificAddress(
-        connection, RPC_TX_STORE_SYNC, TransactionStoreSyncProtocol::PULL_SUBTREE,
-        transactions_prefix, root_size_));
+        request.peer, RPC_TX_STORE_SYNC, TransactionStoreSyncProtocol::PULL_SUBTREE,
+        ToResourcePrefix(request.subtree), uint64_t{request.subtree.bits}));
 
-    promise_id_to_roots_[promise.id()] = root;
-    pending_subtree_.Add(root, promise);
-  }
-
-  if (!roots_to_sync_.empty())
-  {
-    return State::QUERY_SUBTREE;
+    pending_subtree_.emplace(request.id, std::move(promise));
   }
 
-  promise_wait_timeout_.Set(cfg_.promise_wait_timeout);
-
   return State::RESOLVING_SUBTREE;
 }
 
 TransactionStoreSyncService::State TransactionStoreSyncService::OnResolvingSubtree()
 {
-  auto counts = pending_subtree_.Resolve();
-
   std::size_t synced_tx{0};
-  for (auto &result : pending_subtree_.Get(MAX_SUBTREE_RESOLUTION_PER_CYCLE))
+  std::size_t failed{0};
+
+  auto it = pending_subtree_.begin();
+  while (it != pending_subtree_.end())
   {
-    FETCH_LOG_DEBUG(LOGGING_NAME, "Lane ", cfg_.lane_id, ": ", "Got ", result.promised.size(),
-                    " subtree objects!");
+    auto const status = it->second.GetState();
 
-    for (auto &tx : result.promised)
+    if (PromiseState::WAITING == status)
     {
-      // add the transaction to the verifier
-      verifier_.AddTransaction(std::make_shared<Transaction>(tx));
+      ++it;
+      continue;
+    }
 
-      ++synced_tx;
+    if (PromiseState::SUCCESS == status)
+    {
+      auto transactions = it->second.Get();
+
+      subtree_scheduler_.OnResponse(it->first, transactions.size());
+
+      // hand the whole batch to the verifier
+      TransactionVerifier::TransactionList batch{};
+      batch.reserve(transactions.size());
+
+      for (auto &tx : transactions)
+      {
+        batch.emplace_back(std::make_shared<Transaction>(std::move(tx)));
+      }
+
+      synced_tx += batch.size();
+      verifier_.AddTransactions(std::move(batch));
     }
+    else
+    {
+      subtree_scheduler_.OnFailure(it->first);
+      ++failed;
+    }
+
+    it = pending_subtree_.erase(it);
   }
 
-  if (synced_tx)
+  // abandon the requests which have taken too long, the subtrees are requested again
+  auto const expired = subtree_scheduler_.Expire();
+  for (auto const &id : expired)
   {
-    FETCH_LOG_INFO(LOGGING_NAME, "Lane ", cfg_.lane_id, " Incorporated ", synced_tx, " txs");
+    pending_subtree_.erase(id);
   }
 
-  if (counts.failed > 0)
+  if (synced_tx)
   {
-    FETCH_LOG_WARN(LOGGING_NAME, "Lane ", cfg_.lane_id, ": ", "Failed subtree promises count ",
-                   counts.failed);
-    for (auto &fail : pending_subtree_.GetFailures(MAX_SUBTREE_RESOLUTION_PER_CYCLE))
-    {
-      roots_to_sync_.push(promise_id_to_roots_[fail.promise.id()]);
-    }
+    FETCH_LOG_INFO(LOGGING_NAME, "Lane ", cfg_.lane_id, " Incorporated ", synced_tx, " txs (",
+                   subtree_scheduler_.num_completed(), " subtrees complete, ",
+                   subtree_scheduler_.num_pending(), " remaining)");
   }
-  if (counts.pending > 0)
+
+  if (failed || !expired.empty())
   {
-    if (!promise_wait_timeout_.IsDue())
-    {
-      if (!roots_to_sync_.empty())
-      {
-        return State::QUERY_SUBTREE;
-      }
+    FETCH_LOG_WARN(LOGGING_NAME, "Lane ", cfg_.lane_id, ": ", "Failed subtree promises: ", failed,
+                   " timed out: ", expired.size());
+  }
 
-      return State::RESOLVING_SUBTREE;
-    }
-    else
-    {
-      FETCH_LOG_WARN(LOGGING_NAME, "Lane ", cfg_.lane_id, ": ",
-                     "Timeout for subtree promises count!", counts.pending);
-      // get the pending
-      auto pending = pending_subtree_.GetPending();
-      for (auto &req : pending)
-      {
-        roots_to_sync_.push(promise_id_to_roots_[req.second.id()]);
-      }
-    }
+  if (subtree_scheduler_.complete())
+  {
+    return State::QUERY_OBJECTS;
   }
 
-  promise_id_to_roots_.clear();
+  if (!synced_tx && !failed && expired.empty())
+  {
+    // nothing has changed, wait for the outstanding requests (or the verifier) to make progress
+    state_machine_->Delay(std::chrono::milliseconds{5});
+  }
 
-  return roots_to_sync_.empty() ? State::QUERY_OBJECTS : State::QUERY_SUBTREE;
+  return State::QUERY_SUBTREE;
 }
 
 TransactionStoreSyncService::State TransactionStoreSyncService::OnQueryObjects()
 {
   if (!fetch_object_wait_timeout_.IsDue())
   {
+    state_machine_->Delay(std::chrono::milliseconds{100});
+
     return State::QUERY_OBJECTS;
   }
 
@@ -370,6 +392,8 @@ TransactionStoreSyncService::State TransactionStoreSyncService::OnResolvingObjec
   {
     if (!promise_wait_timeout_.IsDue())
     {
+      state_machine_->Delay(std::chrono::milliseconds{20});
+
       return State::RESOLVING_OBJECTS;
     }
     FETCH_LOG_WARN(LOGGING_NAME, "Lane ", cfg_.lane_id, ": ",
@@ -38,15 +38,17 @@ namespace ledger {
  *
  * @param storage The reference to the storage unit
  * @param miner The reference to the system miner
+ * @param recent_txs The (optional) index of recently seen transactions to be updated
  */
 TransactionProcessor::TransactionProcessor(DAGPtr dag, StorageUnitInterface &storage,
                                            BlockPackerInterface &packer,
                                            TxStatusCachePtr      tx_status_cache,
-                                           std::size_t           num_threads)
+                                           std::size_t num_threads, RecentTxIndexPtr recent_txs)
   : dag_{std::move(dag)}
   , storage_{storage}
   , packer_{packer}
   , status_cache_{std::move(tx_status_cache)}
+  , recent_txs_{std::move(recent_txs)}
   , verifier_{*this, num_threads, "TxV-P"}
   , running_{false}
 {}
@@ -85,6 +87,11 @@ void TransactionProcessor::OnTransaction(TransactionPtr const &tx)
     // dispatch the summary to the miner
     packer_.EnqueueTransaction(*tx);
 
+    if (recent_txs_)
+    {
+      recent_txs_->Add(*tx);
+    }
+
     // update the status cache with the state of this transaction
     if (status_cache_)
     {
@@ -131,6 +138,11 @@ void TransactionProcessor::ThreadEntryPoint()
     {
       packer_.EnqueueTransaction(summary);
 
+      if (recent_txs_)
+      {
+        recent_txs_->Add(summary);
+      }
+
       FETCH_METRIC_TX_QUEUED(summary.transaction_hash);
     }
   }
@@ -20,6 +20,7 @@
 #include "core/set_thread_name.hpp"
 #include "core/string/to_lower.hpp"
 #include "ledger/chain/transaction.hpp"
+#include "ledger/chain/transaction_batch_verifier.hpp"
 #include "ledger/storage_unit/transaction_sinks.hpp"
 #include "ledger/transaction_verifier.hpp"
 #include "metrics/metrics.hpp"
@@ -31,12 +32,16 @@
 #include <algorithm>
 #include <chrono>
 #include <string>
+#include <vector>
 
 static const std::chrono::milliseconds POP_TIMEOUT{300};
+static const std::chrono::milliseconds NO_WAIT{0};
 
 namespace fetch {
 namespace ledger {
 
+constexpr std::size_t TransactionVerifier::DEFAULT_BATCH_SIZE;
+
 namespace {
 
 using telemetry::Registry;
@@ -83,10 +88,12 @@ telemetry::CounterPtr CreateCounter(std::string const &prefix, std::string const
  * @param sink The destination for verified transactions
  * @param verifying_threads The number of verifying threads to be used
  * @param name The name of the verifier
+ * @param batch_size The maximum number of transactions verified together by a single thread
  */
 TransactionVerifier::TransactionVerifier(TransactionSink &sink, std::size_t verifying_threads,
-                                         std::string const &name)
+                                         std::string const &name, std::size_t batch_size)
   : verifying_threads_(verifying_threads)
+  , batch_size_(std::max<std::size_t>(batch_size, 1))
   , name_(name)
   , sink_(sink)
   , unverified_queue_length_(
@@ -181,37 +188,87 @@ void TransactionVerifier::AddTransaction(TransactionPtr &&tx)
   unverified_tx_total_->increment();
 }
 
+/**
+ * Add a batch of transactions into the processing queue
+ *
+ * @param txs The transactions to be added
+ */
+void TransactionVerifier::AddTransactions(TransactionList &&txs)
+{
+  for (auto &tx : txs)
+  {
+    unverified_queue_.Push(std::move(tx));
+  }
+
+  unverified_queue_length_->increment(txs.size());
+  unverified_tx_total_->add(txs.size());
+}
+
+/**
+ * Get the number of transactions which have been added but are still to be verified
+ *
+ * @return The number of unverified transactions
+ */
+std::size_t TransactionVerifier::GetBacklog() const
+{
+  return static_cast<std::size_t>(unverified_queue_length_->get());
+}
+
 /**
  * Internal: Thread process for the verification of
  */
 void TransactionVerifier::Verifier()
 {
-  TransactionPtr tx;
+  TransactionBatchVerifier        batch_verifier;
+  TransactionBatchVerifier::Batch batch;
+  TransactionPtr                  tx;
+
+  batch.reserve(batch_size_);
 
   while (active_)
   {
     try
     {
-      // wait for a mutable transaction to be available
+      batch.clear();
+
+      // wait for a mutable transaction to be available, then take any others which are already
+      // queued up to the batch size
       if (unverified_queue_.Pop(tx, POP_TIMEOUT))
       {
-        unverified_queue_length_->decrement();
+        batch.emplace_back(std::move(tx));
+
+        while ((batch.size() < batch_size_) && unverified_queue_.Pop(tx, NO_WAIT))
+        {
+          batch.emplace_back(std::move(tx));
+        }
+      }
+
+      if (batch.empty())
+      {
+        continue;
+      }
 
-        FETCH_LOG_DEBUG(LOGGING_NAME, "Verifying TX: 0x", tx->digest().ToHex());
+      unverified_queue_length_->decrement(batch.size());
 
-        // check the status
-        if (tx->Verify())
+      FETCH_LOG_DEBUG(LOGGING_NAME, "Verifying batch of ", batch.size(), " TXs");
+
+      batch_verifier.Verify(batch);
+
+      // check the status
+      for (auto &verified_tx : batch)
+      {
+        if (verified_tx->IsVerified())
         {
-          FETCH_LOG_DEBUG(LOGGING_NAME, "TX Verify Complete: 0x", tx->digest().ToHex());
+          FETCH_LOG_DEBUG(LOGGING_NAME, "TX Verify Complete: 0x", verified_tx->digest().ToHex());
 
-          verified_queue_.Push(std::move(tx));
+          verified_queue_.Push(std::move(verified_tx));
           verified_queue_length_->increment();
           verified_tx_total_->increment();
         }
         else
         {
           FETCH_LOG_WARN(LOGGING_NAME, name_ + " Unable to verify transaction: 0x",
-                         tx->digest().ToHex());
+                         verified_tx->digest().ToHex());
 
           discarded_tx_total_->increment();
         }
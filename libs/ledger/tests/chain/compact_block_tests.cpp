@@ -0,0 +1,243 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/bitvector.hpp"
+#include "core/byte_array/byte_array.hpp"
+#include "core/serializers/main_serializer.hpp"
+#include "ledger/chain/address.hpp"
+#include "ledger/chain/block.hpp"
+#include "ledger/chain/compact_block.hpp"
+#include "ledger/chain/recent_transaction_index.hpp"
+#include "ledger/chain/transaction_layout.hpp"
+
+#include "gtest/gtest.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace {
+
+using fetch::BitVector;
+using fetch::byte_array::ByteArray;
+using fetch::ledger::Address;
+using fetch::ledger::Block;
+using fetch::ledger::CompactBlock;
+using fetch::ledger::Digest;
+using fetch::ledger::RecentTransactionIndex;
+using fetch::ledger::ToShortTxId;
+using fetch::ledger::TransactionLayout;
+using fetch::serializers::MsgPackSerializer;
+
+using TransactionIndices = CompactBlock::TransactionIndices;
+using TransactionLayouts = CompactBlock::TransactionLayouts;
+
+constexpr uint32_t LOG2_NUM_LANES = 2;
+constexpr uint32_t NUM_LANES      = 1u << LOG2_NUM_LANES;
+
+/**
+ * Create a digest whose first 8 bytes are the short id and remaining bytes the tail value
+ */
+Digest MakeDigest(uint64_t short_id, uint8_t tail = 0)
+{
+  ByteArray digest;
+  digest.Resize(32);
+
+  for (std::size_t i = 0; i < digest.size(); ++i)
+  {
+    digest[i] = (i < sizeof(uint64_t)) ? static_cast<uint8_t>(short_id >> (8u * i)) : tail;
+  }
+
+  return digest;
+}
+
+TransactionLayout MakeLayout(uint64_t short_id, uint8_t tail = 0)
+{
+  BitVector mask{NUM_LANES};
+  mask.set(short_id % NUM_LANES, 1);
+
+  return {MakeDigest(short_id, tail), mask, short_id, 0, 100};
+}
+
+class CompactBlockTests : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    block_.body.previous_hash  = MakeDigest(1000);
+    block_.body.merkle_hash    = MakeDigest(2000);
+    block_.body.block_number   = 7;
+    block_.body.miner          = Address{MakeDigest(3000)};
+    block_.body.log2_num_lanes = LOG2_NUM_LANES;
+    block_.nonce               = 42;
+
+    // three slices, the middle one being empty
+    block_.body.slices.resize(3);
+    for (uint64_t i = 1; i <= 6; ++i)
+    {
+      layouts_.push_back(MakeLayout(i));
+      block_.body.slices[(i <= 4) ? 0 : 2].push_back(layouts_.back());
+    }
+
+    block_.UpdateDigest();
+  }
+
+  Block                  block_;
+  TransactionLayouts     layouts_;
+  RecentTransactionIndex index_{LOG2_NUM_LANES};
+};
+
+TEST_F(CompactBlockTests, ShortIdIsLeadingDigestBytes)
+{
+  EXPECT_EQ(0x0123456789abcdefull, ToShortTxId(MakeDigest(0x0123456789abcdefull, 0xFF)));
+  EXPECT_EQ(ToShortTxId(MakeDigest(5, 1)), ToShortTxId(MakeDigest(5, 2)));
+}
+
+TEST_F(CompactBlockTests, IndexEvictsOldestFirst)
+{
+  RecentTransactionIndex index{LOG2_NUM_LANES, 3};
+
+  for (uint64_t i = 1; i <= 4; ++i)
+  {
+    index.Add(MakeLayout(i));
+  }
+
+  // adding an existing transaction does not change the eviction order
+  index.Add(MakeLayout(2));
+
+  TransactionLayout layout;
+  EXPECT_EQ(3u, index.size());
+  EXPECT_FALSE(index.Lookup(1, layout));
+  EXPECT_TRUE(index.Lookup(2, layout));
+  EXPECT_EQ(MakeDigest(2), layout.digest());
+
+  index.Add(MakeLayout(5));
+  EXPECT_FALSE(index.Lookup(2, layout));
+  EXPECT_TRUE(index.Lookup(5, layout));
+}
+
+TEST_F(CompactBlockTests, SerializationRoundTrip)
+{
+  CompactBlock const compact{block_};
+
+  EXPECT_EQ(6u, compact.GetTransactionCount());
+  EXPECT_EQ(0u, compact.header.GetTransactionCount());
+
+  MsgPackSerializer serializer;
+  serializer << compact;
+  serializer.seek(0);
+
+  CompactBlock output;
+  serializer >> output;
+
+  ASSERT_EQ(3u, output.slices.size());
+  EXPECT_EQ(compact.slices, output.slices);
+  EXPECT_EQ(block_.body.hash, output.header.body.hash);
+  EXPECT_EQ(block_.body.block_number, output.header.body.block_number);
+  EXPECT_EQ(block_.nonce, output.header.nonce);
+}
+
+TEST_F(CompactBlockTests, ReconstructFromIndex)
+{
+  for (auto const &layout : layouts_)
+  {
+    index_.Add(layout);
+  }
+
+  CompactBlock const compact{block_};
+
+  Block block;
+  EXPECT_TRUE(compact.Reconstruct(&index_, block).empty());
+
+  block.UpdateDigest();
+  EXPECT_EQ(block_.body.hash, block.body.hash);
+  EXPECT_EQ(block_.body.slices, block.body.slices);
+}
+
+TEST_F(CompactBlockTests, ReconstructWithMissingTransactions)
+{
+  index_.Add(layouts_[0]);
+  index_.Add(layouts_[2]);
+  index_.Add(layouts_[5]);
+
+  CompactBlock const compact{block_};
+
+  Block      block;
+  auto const missing = compact.Reconstruct(&index_, block);
+  EXPECT_EQ((TransactionIndices{1, 3, 4}), missing);
+
+  // the sender looks up the missing transactions from the full block
+  TransactionLayouts layouts;
+  ASSERT_TRUE(CompactBlock::Extract(block_, missing, layouts));
+  EXPECT_EQ((TransactionLayouts{layouts_[1], layouts_[3], layouts_[4]}), layouts);
+
+  ASSERT_TRUE(CompactBlock::Fill(block, missing, layouts));
+
+  block.UpdateDigest();
+  EXPECT_EQ(block_.body.hash, block.body.hash);
+}
+
+TEST_F(CompactBlockTests, ReconstructWithoutIndex)
+{
+  CompactBlock const compact{block_};
+
+  Block block;
+  EXPECT_EQ((TransactionIndices{0, 1, 2, 3, 4, 5}), compact.Reconstruct(nullptr, block));
+
+  // layouts built for a different lane configuration can not be used
+  RecentTransactionIndex index{LOG2_NUM_LANES + 1};
+  for (auto const &layout : layouts_)
+  {
+    index.Add(layout);
+  }
+
+  EXPECT_EQ(6u, compact.Reconstruct(&index, block).size());
+}
+
+TEST_F(CompactBlockTests, ShortIdCollisionChangesDigest)
+{
+  // a different transaction which shares the short id of one in the block
+  index_.Add(MakeLayout(3, 0xAA));
+  for (auto const &layout : layouts_)
+  {
+    if (layout.digest() != MakeDigest(3))
+    {
+      index_.Add(layout);
+    }
+  }
+
+  CompactBlock const compact{block_};
+
+  Block block;
+  EXPECT_TRUE(compact.Reconstruct(&index_, block).empty());
+
+  block.UpdateDigest();
+  EXPECT_NE(block_.body.hash, block.body.hash);
+}
+
+TEST_F(CompactBlockTests, InvalidIndicesAreRejected)
+{
+  TransactionLayouts layouts;
+  EXPECT_FALSE(CompactBlock::Extract(block_, TransactionIndices{0, 6}, layouts));
+
+  Block block{block_};
+  EXPECT_FALSE(CompactBlock::Fill(block, TransactionIndices{0, 1}, TransactionLayouts{}));
+  EXPECT_FALSE(CompactBlock::Fill(block, TransactionIndices{6}, TransactionLayouts{layouts_[0]}));
+}
+
+}  // namespace
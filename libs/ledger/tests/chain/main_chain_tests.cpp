@@ -872,6 +872,63 @@ TEST_P(MainChainTests, CheckResolvedLooseWeight)
   ASSERT_EQ(chain_->GetBlock(main5->body.hash)->total_weight, main5->total_weight);
 }
 
+TEST_P(MainChainTests, CheckDuplicateTransactionDetectionAcrossForks)
+{
+  auto const genesis = generator_->Generate();
+
+  auto const make_digest = [](uint8_t value) {
+    byte_array::ByteArray digest{};
+    digest.Resize(32);
+    for (std::size_t i = 0; i < digest.size(); ++i)
+    {
+      digest[i] = value;
+    }
+    return byte_array::ConstByteArray{digest};
+  };
+
+  BitVector mask{1};
+  mask.SetAllOne();
+
+  auto const tx_main = make_digest(1);
+  auto const tx_side = make_digest(2);
+  auto const tx_new  = make_digest(3);
+
+  // build a long main chain with a transaction at the very beginning
+  auto const first = generator_->Generate(genesis);
+  first->body.slices[0].emplace_back(tx_main, mask, 1u, 0u, 100u);
+  first->UpdateDigest();
+
+  auto const main = Generate(generator_, first, 3 * ledger::FINALITY_PERIOD);
+
+  // build a side chain (off the first main block) containing a different transaction
+  auto const side = generator_->Generate(first);
+  side->body.slices[0].emplace_back(tx_side, mask, 1u, 0u, 100u);
+  side->UpdateDigest();
+
+  ASSERT_EQ(BlockStatus::ADDED, chain_->AddBlock(*first));
+  for (auto const &block : main)
+  {
+    ASSERT_EQ(BlockStatus::ADDED, chain_->AddBlock(*block));
+  }
+  ASSERT_EQ(BlockStatus::ADDED, chain_->AddBlock(*side));
+
+  ledger::DigestSet const candidates{tx_main, tx_side, tx_new};
+
+  // from the tip of the main chain only the main transaction is a duplicate
+  auto const main_duplicates =
+      chain_->DetectDuplicateTransactions(main.back()->body.hash, candidates);
+  EXPECT_EQ(main_duplicates, (ledger::DigestSet{tx_main}));
+
+  // from the side chain both the main and side chain transactions are duplicates
+  auto const side_duplicates = chain_->DetectDuplicateTransactions(side->body.hash, candidates);
+  EXPECT_EQ(side_duplicates, (ledger::DigestSet{tx_main, tx_side}));
+
+  // from genesis nothing has been seen
+  auto const genesis_duplicates =
+      chain_->DetectDuplicateTransactions(genesis->body.hash, candidates);
+  EXPECT_TRUE(genesis_duplicates.empty());
+}
+
 INSTANTIATE_TEST_CASE_P(ParamBased, MainChainTests,
                         ::testing::Values(MainChain::Mode::CREATE_PERSISTENT_DB,
                                           MainChain::Mode::IN_MEMORY_DB), );
@@ -0,0 +1,191 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/bitvector.hpp"
+#include "crypto/ecdsa.hpp"
+#include "crypto/prover.hpp"
+#include "ledger/chain/address.hpp"
+#include "ledger/chain/transaction.hpp"
+#include "ledger/chain/transaction_batch_verifier.hpp"
+#include "ledger/chain/transaction_builder.hpp"
+
+#include "gtest/gtest.h"
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace {
+
+using fetch::BitVector;
+using fetch::byte_array::ConstByteArray;
+using fetch::crypto::ECDSASigner;
+using fetch::crypto::Identity;
+using fetch::crypto::Prover;
+using fetch::ledger::Address;
+using fetch::ledger::Transaction;
+using fetch::ledger::TransactionBatchVerifier;
+using fetch::ledger::TransactionBuilder;
+
+using TransactionPtr = TransactionBatchVerifier::TransactionPtr;
+using Batch          = TransactionBatchVerifier::Batch;
+
+/**
+ * A prover which claims one identity but signs with the key of another
+ */
+class ForgingSigner : public Prover
+{
+public:
+  ForgingSigner(ECDSASigner const &claimed, ECDSASigner const &actual)
+    : claimed_{claimed}
+    , actual_{actual}
+  {}
+
+  Identity identity() const override
+  {
+    return claimed_.identity();
+  }
+
+  void Load(ConstByteArray const &) override
+  {}
+
+  ConstByteArray Sign(ConstByteArray const &message) const override
+  {
+    return actual_.Sign(message);
+  }
+
+private:
+  ECDSASigner const &claimed_;
+  ECDSASigner const &actual_;
+};
+
+class TransactionBatchVerifierTests : public ::testing::Test
+{
+protected:
+  static TransactionPtr CreateTransaction(ECDSASigner const &signer, Prover const &prover,
+                                          uint64_t index)
+  {
+    return TransactionBuilder()
+        .From(Address{signer.identity()})
+        .TargetChainCode("fetch.dummy", BitVector{})
+        .Action("run")
+        .ChargeLimit(index)
+        .Signer(signer.identity())
+        .Seal()
+        .Sign(prover)
+        .Build();
+  }
+
+  static TransactionPtr CreateTransaction(ECDSASigner const &signer, uint64_t index)
+  {
+    return CreateTransaction(signer, signer, index);
+  }
+
+  static TransactionPtr Copy(TransactionPtr const &tx)
+  {
+    return std::make_shared<Transaction>(*tx);
+  }
+
+  ECDSASigner alice_{};
+  ECDSASigner bob_{};
+};
+
+TEST_F(TransactionBatchVerifierTests, MatchesIndividualVerification)
+{
+  ForgingSigner forger{alice_, bob_};
+
+  Batch batch{};
+  for (uint64_t i = 0; i < 20; ++i)
+  {
+    switch (i % 3)
+    {
+    case 0:
+      batch.emplace_back(CreateTransaction(alice_, i));
+      break;
+    case 1:
+      batch.emplace_back(CreateTransaction(bob_, i));
+      break;
+    default:
+      batch.emplace_back(CreateTransaction(alice_, forger, i));
+      break;
+    }
+  }
+
+  // take unverified copies for the individual verification
+  Batch individual{};
+  for (auto const &tx : batch)
+  {
+    individual.emplace_back(Copy(tx));
+  }
+
+  TransactionBatchVerifier verifier{};
+  verifier.Verify(batch);
+
+  for (std::size_t i = 0; i < batch.size(); ++i)
+  {
+    EXPECT_EQ((i % 3) != 2, batch[i]->IsVerified()) << "tx " << i;
+    EXPECT_EQ(individual[i]->Verify(), batch[i]->IsVerified()) << "tx " << i;
+  }
+}
+
+TEST_F(TransactionBatchVerifierTests, KeysAreCachedForRepeatSenders)
+{
+  TransactionBatchVerifier verifier{};
+
+  for (uint64_t i = 0; i < 4; ++i)
+  {
+    verifier.Verify({CreateTransaction(alice_, 2 * i), CreateTransaction(bob_, 2 * i + 1)});
+  }
+
+  EXPECT_EQ(2u, verifier.num_cached_keys());
+}
+
+TEST_F(TransactionBatchVerifierTests, KeyCacheIsBounded)
+{
+  TransactionBatchVerifier verifier{2};
+  std::vector<ECDSASigner> signers(5);
+
+  Batch batch{};
+  for (uint64_t i = 0; i < signers.size(); ++i)
+  {
+    batch.emplace_back(CreateTransaction(signers[i], i));
+  }
+
+  verifier.Verify(batch);
+
+  EXPECT_GE(2u, verifier.num_cached_keys());
+  for (auto const &tx : batch)
+  {
+    EXPECT_TRUE(tx->IsVerified());
+  }
+}
+
+TEST_F(TransactionBatchVerifierTests, PreviousResultsAreKept)
+{
+  ForgingSigner forger{alice_, bob_};
+
+  auto forged = CreateTransaction(alice_, forger, 1);
+  EXPECT_FALSE(forged->Verify());
+
+  TransactionBatchVerifier verifier{};
+  verifier.Verify({forged, CreateTransaction(alice_, 2)});
+
+  EXPECT_FALSE(forged->IsVerified());
+}
+
+}  // namespace
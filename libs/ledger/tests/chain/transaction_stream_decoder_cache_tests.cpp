@@ -0,0 +1,193 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/bitvector.hpp"
+#include "core/byte_array/byte_array.hpp"
+#include "crypto/ecdsa.hpp"
+#include "ledger/chain/address.hpp"
+#include "ledger/chain/transaction.hpp"
+#include "ledger/chain/transaction_builder.hpp"
+#include "ledger/chain/transaction_serializer.hpp"
+#include "ledger/chain/transaction_stream_decoder_cache.hpp"
+#include "moment/clocks.hpp"
+
+#include "gtest/gtest.h"
+
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <string>
+
+namespace {
+
+using fetch::BitVector;
+using fetch::byte_array::ByteArray;
+using fetch::byte_array::ConstByteArray;
+using fetch::crypto::ECDSASigner;
+using fetch::ledger::Address;
+using fetch::ledger::AppendTransactionFrame;
+using fetch::ledger::TransactionBuilder;
+using fetch::ledger::TransactionSerializer;
+using fetch::ledger::TransactionStreamDecoder;
+using fetch::ledger::TransactionStreamDecoderCache;
+using fetch::moment::AdjustableClockPtr;
+using fetch::moment::CreateAdjustableClock;
+
+using TransactionList = TransactionStreamDecoder::TransactionList;
+
+constexpr std::size_t MAX_STREAMS = 4;
+constexpr auto        TIMEOUT     = std::chrono::seconds{30};
+
+class TransactionStreamDecoderCacheTests : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    clock_ = CreateAdjustableClock(TransactionStreamDecoderCache::CLOCK_NAME);
+    cache_ = std::make_unique<TransactionStreamDecoderCache>(
+        [this](TransactionList &&txs) { decoded_ += txs.size(); }, MAX_STREAMS, TIMEOUT);
+
+    auto tx = TransactionBuilder()
+                  .From(Address{signer_.identity()})
+                  .TargetChainCode("fetch.dummy", BitVector{})
+                  .Action("run")
+                  .Signer(signer_.identity())
+                  .Seal()
+                  .Sign(signer_)
+                  .Build();
+
+    TransactionSerializer serializer{};
+    serializer << *tx;
+
+    AppendTransactionFrame(frame_, serializer.data());
+  }
+
+  static ConstByteArray Sender(std::size_t index)
+  {
+    return ConstByteArray{"sender-" + std::to_string(index)};
+  }
+
+  /// Send the first part of the frame, leaving the sender part way through it
+  void SendStart(ConstByteArray const &from)
+  {
+    EXPECT_TRUE(cache_->Feed(from, frame_.SubArray(0, 10)));
+  }
+
+  /// Send the middle part of the frame, leaving the sender part way through it
+  void SendMiddle(ConstByteArray const &from)
+  {
+    EXPECT_TRUE(cache_->Feed(from, frame_.SubArray(10, 10)));
+  }
+
+  /// Send the rest of the frame
+  void SendEnd(ConstByteArray const &from)
+  {
+    EXPECT_TRUE(cache_->Feed(from, frame_.SubArray(20, frame_.size() - 20)));
+  }
+
+  using CachePtr = std::unique_ptr<TransactionStreamDecoderCache>;
+
+  AdjustableClockPtr clock_;
+  CachePtr           cache_;
+  ECDSASigner        signer_{};
+  ByteArray          frame_{};
+  std::size_t        decoded_{0};
+};
+
+TEST_F(TransactionStreamDecoderCacheTests, KeepsDecodersOnlyForPartialFrames)
+{
+  EXPECT_TRUE(cache_->Feed(Sender(0), frame_));
+  EXPECT_EQ(0, cache_->size());
+  EXPECT_EQ(1, decoded_);
+
+  SendStart(Sender(1));
+  SendMiddle(Sender(1));
+  EXPECT_EQ(1, cache_->size());
+
+  SendEnd(Sender(1));
+  EXPECT_EQ(0, cache_->size());
+  EXPECT_EQ(2, decoded_);
+  EXPECT_EQ(0, cache_->dropped());
+}
+
+TEST_F(TransactionStreamDecoderCacheTests, IdleSendersDoNotLockOutOthers)
+{
+  // fill the cache with senders which go quiet part way through a frame
+  for (std::size_t i = 0; i < MAX_STREAMS; ++i)
+  {
+    SendStart(Sender(i));
+  }
+  EXPECT_EQ(MAX_STREAMS, cache_->size());
+
+  clock_->Advance(TIMEOUT);
+
+  // a new sender is still able to stream, and the idle senders have been expired
+  SendStart(Sender(MAX_STREAMS));
+  EXPECT_EQ(1, cache_->size());
+  EXPECT_EQ(MAX_STREAMS, cache_->dropped());
+
+  SendMiddle(Sender(MAX_STREAMS));
+  SendEnd(Sender(MAX_STREAMS));
+  EXPECT_EQ(0, cache_->size());
+  EXPECT_EQ(1, decoded_);
+}
+
+TEST_F(TransactionStreamDecoderCacheTests, EvictsLeastRecentlyActiveSenderWhenFull)
+{
+  for (std::size_t i = 0; i < MAX_STREAMS; ++i)
+  {
+    SendStart(Sender(i));
+    clock_->Advance(std::chrono::seconds{1});
+  }
+
+  // the first sender makes progress, so the second becomes the least recently active
+  SendMiddle(Sender(0));
+
+  SendStart(Sender(MAX_STREAMS));
+  EXPECT_EQ(MAX_STREAMS, cache_->size());
+  EXPECT_EQ(1, cache_->dropped());
+
+  // all the other senders are able to complete their frames
+  SendEnd(Sender(0));
+  for (std::size_t i = 2; i <= MAX_STREAMS; ++i)
+  {
+    SendMiddle(Sender(i));
+    SendEnd(Sender(i));
+  }
+
+  EXPECT_EQ(0, cache_->size());
+  EXPECT_EQ(MAX_STREAMS, decoded_);
+}
+
+TEST_F(TransactionStreamDecoderCacheTests, ActiveSendersAreNotExpired)
+{
+  SendStart(Sender(0));
+
+  clock_->Advance(TIMEOUT - std::chrono::seconds{1});
+  SendMiddle(Sender(0));
+
+  clock_->Advance(TIMEOUT - std::chrono::seconds{1});
+  SendStart(Sender(1));
+  EXPECT_EQ(2, cache_->size());
+  EXPECT_EQ(0, cache_->dropped());
+
+  SendEnd(Sender(0));
+  EXPECT_EQ(1, decoded_);
+}
+
+}  // namespace
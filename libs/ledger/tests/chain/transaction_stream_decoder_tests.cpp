@@ -0,0 +1,180 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/bitvector.hpp"
+#include "core/byte_array/byte_array.hpp"
+#include "crypto/ecdsa.hpp"
+#include "ledger/chain/address.hpp"
+#include "ledger/chain/transaction.hpp"
+#include "ledger/chain/transaction_builder.hpp"
+#include "ledger/chain/transaction_serializer.hpp"
+#include "ledger/chain/transaction_stream_decoder.hpp"
+
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace {
+
+using fetch::BitVector;
+using fetch::byte_array::ByteArray;
+using fetch::byte_array::ConstByteArray;
+using fetch::crypto::ECDSASigner;
+using fetch::ledger::Address;
+using fetch::ledger::AppendTransactionFrame;
+using fetch::ledger::TransactionBuilder;
+using fetch::ledger::TransactionSerializer;
+using fetch::ledger::TransactionStreamDecoder;
+
+using TransactionList = TransactionStreamDecoder::TransactionList;
+using BatchSizes      = std::vector<std::size_t>;
+
+class TransactionStreamDecoderTests : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    for (uint64_t i = 0; i < 10; ++i)
+    {
+      auto tx = TransactionBuilder()
+                    .From(Address{signer_.identity()})
+                    .TargetChainCode("fetch.dummy", BitVector{})
+                    .Action("run")
+                    .ChargeLimit(i)
+                    .Signer(signer_.identity())
+                    .Seal()
+                    .Sign(signer_)
+                    .Build();
+
+      TransactionSerializer serializer{};
+      serializer << *tx;
+
+      AppendTransactionFrame(stream_, serializer.data());
+      expected_.emplace_back(std::move(tx));
+    }
+  }
+
+  TransactionStreamDecoder::BatchHandler Collect()
+  {
+    return [this](TransactionList &&txs) {
+      batch_sizes_.push_back(txs.size());
+      for (auto &tx : txs)
+      {
+        decoded_.emplace_back(std::move(tx));
+      }
+    };
+  }
+
+  void ExpectAllDecoded() const
+  {
+    ASSERT_EQ(expected_.size(), decoded_.size());
+    for (std::size_t i = 0; i < expected_.size(); ++i)
+    {
+      EXPECT_EQ(expected_[i]->digest(), decoded_[i]->digest());
+    }
+  }
+
+  ECDSASigner     signer_{};
+  ByteArray       stream_{};
+  TransactionList expected_{};
+  TransactionList decoded_{};
+  BatchSizes      batch_sizes_{};
+};
+
+TEST_F(TransactionStreamDecoderTests, DecodesWholeStream)
+{
+  TransactionStreamDecoder decoder{Collect()};
+
+  EXPECT_TRUE(decoder.Feed(stream_));
+  EXPECT_EQ(expected_.size(), decoder.received());
+  EXPECT_EQ(expected_.size(), decoder.decoded());
+  EXPECT_EQ(0, decoder.buffered());
+  EXPECT_EQ(BatchSizes{expected_.size()}, batch_sizes_);
+
+  ExpectAllDecoded();
+}
+
+TEST_F(TransactionStreamDecoderTests, DecodesFramesSpanningChunks)
+{
+  TransactionStreamDecoder decoder{Collect()};
+
+  // feed in awkwardly sized chunks so that both the prefixes and payloads are split
+  for (std::size_t chunk_size : {1u, 3u, 7u, 64u, 301u})
+  {
+    decoded_.clear();
+
+    for (std::size_t offset = 0; offset < stream_.size(); offset += chunk_size)
+    {
+      std::size_t const length = std::min(chunk_size, stream_.size() - offset);
+      EXPECT_TRUE(decoder.Feed(stream_.SubArray(offset, length)));
+    }
+
+    EXPECT_EQ(0, decoder.buffered());
+    ExpectAllDecoded();
+  }
+}
+
+TEST_F(TransactionStreamDecoderTests, LimitsTheBatchSize)
+{
+  TransactionStreamDecoder decoder{Collect(), 4};
+
+  EXPECT_TRUE(decoder.Feed(stream_));
+  EXPECT_EQ((BatchSizes{4, 4, 2}), batch_sizes_);
+
+  ExpectAllDecoded();
+}
+
+TEST_F(TransactionStreamDecoderTests, SkipsMalformedTransactions)
+{
+  ByteArray stream{};
+  AppendTransactionFrame(stream, ConstByteArray{0x00, 0x01, 0x02});
+  stream.Append(stream_);
+
+  TransactionStreamDecoder decoder{Collect()};
+
+  EXPECT_TRUE(decoder.Feed(stream));
+  EXPECT_EQ(expected_.size() + 1, decoder.received());
+  EXPECT_EQ(expected_.size(), decoder.decoded());
+
+  ExpectAllDecoded();
+}
+
+TEST_F(TransactionStreamDecoderTests, RejectsBrokenFraming)
+{
+  ByteArray stream{stream_.Copy()};
+  stream.Append(ConstByteArray{0xff, 0xff, 0xff, 0xff, 0x00});
+
+  TransactionStreamDecoder decoder{Collect()};
+
+  EXPECT_FALSE(decoder.Feed(stream));
+  EXPECT_TRUE(decoder.corrupted());
+  EXPECT_EQ(0, decoder.buffered());
+
+  // all the transactions before the broken frame are still delivered
+  ExpectAllDecoded();
+
+  // once broken all further input is rejected
+  EXPECT_FALSE(decoder.Feed(stream_));
+  EXPECT_EQ(expected_.size(), decoder.decoded());
+}
+
+}  // namespace
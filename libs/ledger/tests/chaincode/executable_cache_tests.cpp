@@ -0,0 +1,185 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "crypto/hash.hpp"
+#include "crypto/sha256.hpp"
+#include "ledger/chaincode/executable_cache.hpp"
+#include "ledger/chaincode/smart_contract.hpp"
+#include "vm/compiler.hpp"
+#include "vm/module.hpp"
+#include "vm/variant.hpp"
+#include "vm/vm.hpp"
+#include "vm_modules/vm_factory.hpp"
+
+#include "gtest/gtest.h"
+
+#include <chrono>
+#include <memory>
+#include <string>
+
+namespace {
+
+using fetch::byte_array::ConstByteArray;
+using fetch::crypto::Hash;
+using fetch::crypto::SHA256;
+using fetch::ledger::ExecutableCache;
+using fetch::ledger::SmartContract;
+using fetch::vm::Compiler;
+using fetch::vm::Executable;
+using fetch::vm::Module;
+using fetch::vm::VM;
+using fetch::vm::Variant;
+using fetch::vm_modules::VMFactory;
+
+using ExecutablePtr = ExecutableCache::ExecutablePtr;
+using ModulePtr     = std::shared_ptr<Module>;
+
+char const *STORE_PREFIX = "executable_cache_tests";
+
+char const *SOURCE = R"(
+  @query
+  function value() : Int64
+    var total = 0i64;
+    for (i in 0:10)
+      total = total + toInt64(i) * 2i64;
+    endfor
+    return total;
+  endfunction
+)";
+
+class ExecutableCacheTests : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    module_ = VMFactory::GetModule(VMFactory::USE_SMART_CONTRACTS);
+
+    // populate the registered types and functions of the module
+    Compiler compiler{module_.get()};
+  }
+
+  ExecutablePtr Compile(std::string const &source)
+  {
+    auto executable = std::make_shared<Executable>();
+    EXPECT_TRUE(VMFactory::Compile(module_, source, *executable).empty());
+    return executable;
+  }
+
+  ConstByteArray KeyFor(std::string const &source)
+  {
+    return ExecutableCache::CreateKey(Hash<SHA256>(source), *module_);
+  }
+
+  int64_t Run(Executable const &executable)
+  {
+    VM          vm{module_.get()};
+    std::string error;
+    Variant     output;
+
+    EXPECT_TRUE(vm.Execute(executable, "value", error, output)) << error;
+
+    return output.Get<int64_t>();
+  }
+
+  ModulePtr module_;
+};
+
+TEST_F(ExecutableCacheTests, key_depends_on_source_and_module)
+{
+  auto const key = KeyFor(SOURCE);
+
+  EXPECT_EQ(key, KeyFor(SOURCE));
+  EXPECT_NE(key, KeyFor(std::string{SOURCE} + " "));
+
+  auto           other_module = VMFactory::GetModule(VMFactory::MOD_CORE);
+  Compiler const compiler{other_module.get()};
+
+  EXPECT_NE(key, ExecutableCache::CreateKey(Hash<SHA256>(SOURCE), *other_module));
+}
+
+TEST_F(ExecutableCacheTests, lookup_returns_added_executable)
+{
+  ExecutableCache cache{4};
+
+  auto const key = KeyFor(SOURCE);
+  EXPECT_FALSE(cache.Lookup(key));
+
+  auto executable = Compile(SOURCE);
+  cache.Add(key, executable, std::chrono::microseconds{100});
+
+  EXPECT_EQ(executable, cache.Lookup(key));
+  EXPECT_EQ(1u, cache.size());
+}
+
+TEST_F(ExecutableCacheTests, least_recently_used_executable_is_evicted)
+{
+  ExecutableCache cache{2};
+
+  auto const key1 = KeyFor(SOURCE);
+  auto const key2 = KeyFor(std::string{SOURCE} + " ");
+  auto const key3 = KeyFor(std::string{SOURCE} + "  ");
+
+  auto executable = Compile(SOURCE);
+  cache.Add(key1, executable, std::chrono::microseconds{1});
+  cache.Add(key2, executable, std::chrono::microseconds{1});
+
+  // refresh the first entry so that the second becomes the least recently used
+  EXPECT_TRUE(cache.Lookup(key1));
+
+  cache.Add(key3, executable, std::chrono::microseconds{1});
+
+  EXPECT_EQ(2u, cache.size());
+  EXPECT_TRUE(cache.Lookup(key1));
+  EXPECT_FALSE(cache.Lookup(key2));
+  EXPECT_TRUE(cache.Lookup(key3));
+}
+
+TEST_F(ExecutableCacheTests, executables_are_reloaded_from_the_persistent_store)
+{
+  auto const key      = KeyFor(SOURCE);
+  auto const expected = Run(*Compile(SOURCE));
+
+  {
+    ExecutableCache cache{4};
+    cache.New(STORE_PREFIX);
+    cache.Add(key, Compile(SOURCE), std::chrono::microseconds{100});
+  }
+
+  // a new cache (e.g. after a restart) loads the executable from disk
+  ExecutableCache cache{4};
+  cache.Load(STORE_PREFIX);
+
+  auto executable = cache.Lookup(key);
+  ASSERT_TRUE(executable);
+  EXPECT_EQ(1u, cache.size());
+  EXPECT_EQ(expected, Run(*executable));
+
+  // once evicted from memory the executable is still available
+  cache.Clear();
+  EXPECT_TRUE(cache.Lookup(key));
+}
+
+TEST_F(ExecutableCacheTests, smart_contracts_share_cached_executables)
+{
+  SmartContract first{SOURCE};
+  SmartContract second{SOURCE};
+
+  EXPECT_EQ(first.executable(), second.executable());
+}
+
+}  // namespace
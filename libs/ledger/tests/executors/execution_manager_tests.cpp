@@ -126,26 +126,17 @@ protected:
       return a.timestamp < b.timestamp;
     });
 
-    // Step 3. Check that the start time
-    if (!history.empty())
+    // Step 3. Check that any transactions which share a lane were started in slice order.
+    // Transactions which do not share any lanes are free to be executed in any order
+    success = true;
+    for (std::size_t i = 0; success && (i < history.size()); ++i)
     {
-      std::size_t current_slice = 0;
-
-      success = true;
-      for (std::size_t i = 1; i < history.size(); ++i)
+      for (std::size_t j = i + 1; j < history.size(); ++j)
       {
-        auto const &current = history[i];
+        auto const &earlier = history[i];
+        auto const &later   = history[j];
 
-        if (current.slice == current_slice)
-        {
-          continue;  // same slice
-        }
-        else if (current.slice > current_slice)
-        {
-          current_slice = current.slice;
-          continue;  // next slice
-        }
-        else
+        if ((earlier.slice > later.slice) && ((earlier.shards & later.shards).PopCount() > 0))
         {
           success = false;
           break;
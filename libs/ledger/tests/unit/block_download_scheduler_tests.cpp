@@ -0,0 +1,316 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+
+#include "core/byte_array/const_byte_array.hpp"
+#include "ledger/chain/block.hpp"
+#include "ledger/protocols/block_download_scheduler.hpp"
+#include "ledger/testing/block_generator.hpp"
+
+#include "gtest/gtest.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace {
+
+using fetch::byte_array::ConstByteArray;
+using fetch::ledger::Block;
+using fetch::ledger::BlockDownloadScheduler;
+using fetch::ledger::testing::BlockGenerator;
+
+using Address        = BlockDownloadScheduler::Address;
+using Addresses      = BlockDownloadScheduler::Addresses;
+using Blocks         = BlockDownloadScheduler::Blocks;
+using Request        = BlockDownloadScheduler::Request;
+using Requests       = BlockDownloadScheduler::Requests;
+using ResponseStatus = BlockDownloadScheduler::ResponseStatus;
+
+constexpr std::size_t WINDOW_SIZE   = 10;
+constexpr std::size_t MAX_IN_FLIGHT = 2;
+constexpr std::size_t MAX_BUFFERED  = 4;
+constexpr std::size_t MAX_ATTEMPTS  = 3;
+
+class BlockDownloadSchedulerTests : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    BlockGenerator generator{1, 1};
+
+    // generate a chain, oldest block first (genesis is not downloaded)
+    auto previous = generator();
+    for (std::size_t i = 0; i < NUM_BLOCKS; ++i)
+    {
+      previous = generator(previous);
+      chain_.push_back(*previous);
+    }
+  }
+
+  void Reset()
+  {
+    BlockDownloadScheduler::BlockHashes hashes{};
+    for (auto const &block : chain_)
+    {
+      hashes.push_back(block.body.hash);
+    }
+
+    scheduler_.Reset(std::move(hashes));
+  }
+
+  /**
+   * Build the response that an honest peer would return for the request
+   */
+  Blocks Respond(Request const &request) const
+  {
+    Blocks blocks{};
+
+    auto it = chain_.rbegin();
+    while (it->body.hash != request.last_hash)
+    {
+      ++it;
+    }
+
+    for (uint64_t i = 0; i < request.num_blocks; ++i, ++it)
+    {
+      blocks.push_back(*it);
+    }
+
+    return blocks;
+  }
+
+  Blocks PopAll(Address const &expected_peer = Address{})
+  {
+    Blocks  output{};
+    Address peer{};
+    Blocks  window{};
+
+    while (scheduler_.PopCompleted(peer, window))
+    {
+      if (!expected_peer.empty())
+      {
+        EXPECT_EQ(expected_peer, peer);
+      }
+
+      // windows are released newest block first, convert back to chain order
+      output.insert(output.end(), window.rbegin(), window.rend());
+    }
+
+    return output;
+  }
+
+  static constexpr std::size_t NUM_BLOCKS = 95;
+
+  Address const          peer1_{"peer1"};
+  Address const          peer2_{"peer2"};
+  Blocks                 chain_{};
+  BlockDownloadScheduler scheduler_{WINDOW_SIZE, MAX_IN_FLIGHT, MAX_BUFFERED, MAX_ATTEMPTS};
+};
+
+constexpr std::size_t BlockDownloadSchedulerTests::NUM_BLOCKS;
+
+TEST_F(BlockDownloadSchedulerTests, DownloadsAllBlocksInOrder)
+{
+  Reset();
+  EXPECT_EQ(10u, scheduler_.num_windows());
+
+  Blocks output{};
+  while (!scheduler_.complete())
+  {
+    auto const requests = scheduler_.Schedule({peer1_, peer2_});
+    ASSERT_FALSE(requests.empty());
+
+    // respond in reverse order to ensure that the blocks are still released in order
+    for (auto it = requests.rbegin(); it != requests.rend(); ++it)
+    {
+      EXPECT_EQ(ResponseStatus::ACCEPTED,
+                scheduler_.OnResponse(it->window, it->peer, Respond(*it)));
+    }
+
+    auto const released = PopAll();
+    output.insert(output.end(), released.begin(), released.end());
+  }
+
+  ASSERT_EQ(chain_.size(), output.size());
+  for (std::size_t i = 0; i < chain_.size(); ++i)
+  {
+    EXPECT_EQ(chain_[i].body.hash, output[i].body.hash);
+  }
+
+  EXPECT_FALSE(scheduler_.failed());
+  EXPECT_EQ(0u, scheduler_.num_in_flight());
+}
+
+TEST_F(BlockDownloadSchedulerTests, InFlightWindowsArePerPeerLimited)
+{
+  Reset();
+
+  // each peer starts with a single request in flight
+  auto requests = scheduler_.Schedule({peer1_, peer2_});
+  ASSERT_EQ(2u, requests.size());
+  EXPECT_NE(requests[0].peer, requests[1].peer);
+  EXPECT_TRUE(scheduler_.Schedule({peer1_, peer2_}).empty());
+
+  // a successful response increases the limit of the peer
+  auto const &first = (requests[0].peer == peer1_) ? requests[0] : requests[1];
+  EXPECT_EQ(ResponseStatus::ACCEPTED, scheduler_.OnResponse(first.window, peer1_, Respond(first)));
+
+  requests = scheduler_.Schedule({peer1_, peer2_});
+  ASSERT_EQ(2u, requests.size());
+  EXPECT_EQ(peer1_, requests[0].peer);
+  EXPECT_EQ(peer1_, requests[1].peer);
+}
+
+TEST_F(BlockDownloadSchedulerTests, DownloadIsLimitedToTheBufferedWindows)
+{
+  Reset();
+
+  // the first window is never answered, so nothing can be released
+  auto const blocked = scheduler_.Schedule({peer1_});
+  ASSERT_EQ(1u, blocked.size());
+  EXPECT_EQ(0u, blocked[0].window);
+
+  for (std::size_t i = 0; i < 10; ++i)
+  {
+    for (auto const &request : scheduler_.Schedule({peer2_}))
+    {
+      EXPECT_LT(request.window, MAX_BUFFERED);
+      EXPECT_EQ(ResponseStatus::ACCEPTED,
+                scheduler_.OnResponse(request.window, request.peer, Respond(request)));
+    }
+  }
+
+  EXPECT_TRUE(PopAll().empty());
+
+  // once the first window arrives the buffered windows are released
+  EXPECT_EQ(ResponseStatus::ACCEPTED,
+            scheduler_.OnResponse(blocked[0].window, peer1_, Respond(blocked[0])));
+  EXPECT_EQ(MAX_BUFFERED * WINDOW_SIZE, PopAll().size());
+  EXPECT_EQ(MAX_BUFFERED, scheduler_.num_released());
+}
+
+TEST_F(BlockDownloadSchedulerTests, FailedWindowsAreRetriedWithAnotherPeer)
+{
+  Reset();
+
+  auto requests = scheduler_.Schedule({peer1_});
+  ASSERT_EQ(1u, requests.size());
+
+  scheduler_.OnFailure(requests[0].window, peer1_);
+
+  requests = scheduler_.Schedule({peer1_, peer2_});
+  ASSERT_FALSE(requests.empty());
+  EXPECT_EQ(0u, requests[0].window);
+  EXPECT_EQ(peer2_, requests[0].peer);
+
+  EXPECT_EQ(ResponseStatus::ACCEPTED,
+            scheduler_.OnResponse(requests[0].window, peer2_, Respond(requests[0])));
+  EXPECT_EQ(WINDOW_SIZE, PopAll(peer2_).size());
+}
+
+TEST_F(BlockDownloadSchedulerTests, InvalidResponsesAreRejected)
+{
+  Reset();
+
+  // a response containing a modified block
+  auto requests = scheduler_.Schedule({peer1_});
+  ASSERT_EQ(1u, requests.size());
+
+  auto blocks = Respond(requests[0]);
+  blocks[3].body.block_number += 1;
+  EXPECT_EQ(ResponseStatus::INVALID, scheduler_.OnResponse(requests[0].window, peer1_, blocks));
+
+  // a response containing more blocks than requested
+  requests = scheduler_.Schedule({peer1_});
+  ASSERT_EQ(1u, requests.size());
+
+  blocks = Respond(requests[0]);
+  blocks.push_back(blocks.back());
+  EXPECT_EQ(ResponseStatus::INVALID, scheduler_.OnResponse(requests[0].window, peer1_, blocks));
+
+  // a response from a peer which was not asked
+  requests = scheduler_.Schedule({peer1_});
+  ASSERT_EQ(1u, requests.size());
+  EXPECT_EQ(ResponseStatus::UNEXPECTED,
+            scheduler_.OnResponse(requests[0].window, peer2_, Respond(requests[0])));
+
+  EXPECT_TRUE(PopAll().empty());
+}
+
+TEST_F(BlockDownloadSchedulerTests, ResponsesFromPeersWhichAreBehindAreRetried)
+{
+  Reset();
+
+  // a peer which does not yet have the newest block of the window returns nothing
+  auto requests = scheduler_.Schedule({peer1_});
+  ASSERT_EQ(1u, requests.size());
+  EXPECT_EQ(ResponseStatus::INCOMPLETE,
+            scheduler_.OnResponse(requests[0].window, peer1_, Blocks{}));
+
+  // a truncated (but otherwise correct) response
+  requests = scheduler_.Schedule({peer1_});
+  ASSERT_EQ(1u, requests.size());
+  EXPECT_EQ(0u, requests[0].window);
+
+  auto blocks = Respond(requests[0]);
+  blocks.pop_back();
+  EXPECT_EQ(ResponseStatus::INCOMPLETE,
+            scheduler_.OnResponse(requests[0].window, peer1_, std::move(blocks)));
+
+  // the window is then downloaded from a peer which is up to date
+  requests = scheduler_.Schedule({peer1_, peer2_});
+  ASSERT_FALSE(requests.empty());
+  EXPECT_EQ(0u, requests[0].window);
+  EXPECT_EQ(peer2_, requests[0].peer);
+  EXPECT_EQ(ResponseStatus::ACCEPTED,
+            scheduler_.OnResponse(requests[0].window, peer2_, Respond(requests[0])));
+
+  EXPECT_EQ(WINDOW_SIZE, PopAll(peer2_).size());
+  EXPECT_FALSE(scheduler_.failed());
+}
+
+TEST_F(BlockDownloadSchedulerTests, DownloadFailsAfterRepeatedFailures)
+{
+  Reset();
+
+  for (std::size_t i = 0; i < MAX_ATTEMPTS; ++i)
+  {
+    EXPECT_FALSE(scheduler_.failed());
+
+    auto const requests = scheduler_.Schedule({peer1_});
+    ASSERT_EQ(1u, requests.size());
+    EXPECT_EQ(0u, requests[0].window);
+
+    scheduler_.OnFailure(requests[0].window, peer1_);
+  }
+
+  EXPECT_TRUE(scheduler_.failed());
+  EXPECT_TRUE(scheduler_.Schedule({peer1_, peer2_}).empty());
+}
+
+TEST_F(BlockDownloadSchedulerTests, EmptyDownloadIsComplete)
+{
+  scheduler_.Reset({});
+
+  EXPECT_TRUE(scheduler_.complete());
+  EXPECT_TRUE(scheduler_.Schedule({peer1_}).empty());
+}
+
+}  // namespace
@@ -0,0 +1,224 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "ledger/storage_unit/subtree_sync_scheduler.hpp"
+
+#include "gtest/gtest.h"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <set>
+#include <utility>
+
+namespace {
+
+using fetch::ledger::SubtreeSyncScheduler;
+
+using Address   = SubtreeSyncScheduler::Address;
+using Duration  = SubtreeSyncScheduler::Duration;
+using Timepoint = SubtreeSyncScheduler::Timepoint;
+using Requests  = SubtreeSyncScheduler::Requests;
+
+constexpr uint64_t    PULL_LIMIT = 100;
+constexpr std::size_t MAX_WINDOW = 8;
+constexpr uint32_t    MAX_BITS   = 6;
+
+class SubtreeSyncSchedulerTests : public ::testing::Test
+{
+protected:
+  Address const        peer1_{"peer1"};
+  Address const        peer2_{"peer2"};
+  Timepoint            now_{SubtreeSyncScheduler::Clock::now()};
+  SubtreeSyncScheduler scheduler_{PULL_LIMIT, Duration{2000}, MAX_WINDOW, MAX_BITS};
+};
+
+TEST_F(SubtreeSyncSchedulerTests, PullsAllSubtreesFromAllPeers)
+{
+  scheduler_.Reset(4);
+  EXPECT_EQ(16u, scheduler_.num_pending());
+
+  std::set<std::pair<uint32_t, uint32_t>> subtrees{};
+  std::set<Address>                       peers{};
+
+  while (!scheduler_.complete())
+  {
+    auto const requests = scheduler_.Schedule({peer1_, peer2_}, now_);
+    ASSERT_FALSE(requests.empty());
+
+    now_ += Duration{10};
+
+    for (auto const &request : requests)
+    {
+      EXPECT_TRUE(subtrees.emplace(request.subtree.prefix, request.subtree.bits).second);
+      peers.insert(request.peer);
+
+      EXPECT_TRUE(scheduler_.OnResponse(request.id, 1, now_));
+    }
+  }
+
+  EXPECT_EQ(16u, subtrees.size());
+  EXPECT_EQ(16u, scheduler_.num_completed());
+  EXPECT_EQ(2u, peers.size());
+  EXPECT_EQ(0u, scheduler_.num_in_flight());
+}
+
+TEST_F(SubtreeSyncSchedulerTests, WindowGrowsWhileLatencyIsStable)
+{
+  scheduler_.Reset(MAX_BITS);
+  EXPECT_EQ(SubtreeSyncScheduler::DEFAULT_INITIAL_WINDOW, scheduler_.GetWindow(peer1_));
+
+  for (std::size_t i = 0; i < 4; ++i)
+  {
+    auto const requests = scheduler_.Schedule({peer1_}, now_);
+    EXPECT_EQ(scheduler_.GetWindow(peer1_), requests.size());
+
+    now_ += Duration{10};
+
+    for (auto const &request : requests)
+    {
+      EXPECT_TRUE(scheduler_.OnResponse(request.id, 1, now_));
+    }
+  }
+
+  EXPECT_EQ(MAX_WINDOW, scheduler_.GetWindow(peer1_));
+}
+
+TEST_F(SubtreeSyncSchedulerTests, WindowShrinksWhenLatencyRises)
+{
+  scheduler_.Reset(MAX_BITS);
+
+  // establish the baseline latency and grow the window
+  for (std::size_t i = 0; i < 4; ++i)
+  {
+    auto const requests = scheduler_.Schedule({peer1_}, now_);
+    now_ += Duration{10};
+
+    for (auto const &request : requests)
+    {
+      scheduler_.OnResponse(request.id, 1, now_);
+    }
+  }
+  ASSERT_EQ(MAX_WINDOW, scheduler_.GetWindow(peer1_));
+
+  // the peer starts to queue the requests
+  auto const requests = scheduler_.Schedule({peer1_}, now_);
+  ASSERT_EQ(MAX_WINDOW, requests.size());
+  now_ += Duration{50};
+
+  for (auto const &request : requests)
+  {
+    scheduler_.OnResponse(request.id, 1, now_);
+  }
+
+  EXPECT_EQ(1u, scheduler_.GetWindow(peer1_));
+}
+
+TEST_F(SubtreeSyncSchedulerTests, FailedSubtreesAreRetriedWithAnotherPeer)
+{
+  scheduler_.Reset(0);
+
+  auto requests = scheduler_.Schedule({peer1_}, now_);
+  ASSERT_EQ(1u, requests.size());
+
+  scheduler_.OnFailure(requests[0].id);
+  EXPECT_EQ(1u, scheduler_.GetWindow(peer1_));
+  EXPECT_FALSE(scheduler_.OnResponse(requests[0].id, 1, now_));
+
+  requests = scheduler_.Schedule({peer1_, peer2_}, now_);
+  ASSERT_EQ(1u, requests.size());
+  EXPECT_EQ(peer2_, requests[0].peer);
+  EXPECT_EQ(0u, requests[0].subtree.bits);
+
+  EXPECT_TRUE(scheduler_.OnResponse(requests[0].id, 1, now_));
+  EXPECT_TRUE(scheduler_.complete());
+}
+
+TEST_F(SubtreeSyncSchedulerTests, TruncatedSubtreesAreSplit)
+{
+  scheduler_.Reset(1);
+
+  auto requests = scheduler_.Schedule({peer1_}, now_);
+  ASSERT_EQ(2u, requests.size());
+  EXPECT_EQ(1u, requests[1].subtree.prefix);
+
+  // the second subtree is larger than the pull limit
+  EXPECT_TRUE(scheduler_.OnResponse(requests[0].id, PULL_LIMIT - 1, now_));
+  EXPECT_TRUE(scheduler_.OnResponse(requests[1].id, PULL_LIMIT, now_));
+  EXPECT_EQ(1u, scheduler_.num_completed());
+
+  requests = scheduler_.Schedule({peer1_}, now_);
+  ASSERT_EQ(2u, requests.size());
+  EXPECT_EQ(1u, requests[0].subtree.prefix);
+  EXPECT_EQ(2u, requests[0].subtree.bits);
+  EXPECT_EQ(3u, requests[1].subtree.prefix);
+  EXPECT_EQ(2u, requests[1].subtree.bits);
+}
+
+TEST_F(SubtreeSyncSchedulerTests, SubtreesAreNotSplitBeyondTheMaximumPrefix)
+{
+  scheduler_.Reset(MAX_BITS + 2);
+  EXPECT_EQ(1u << MAX_BITS, scheduler_.num_pending());
+
+  auto const requests = scheduler_.Schedule({peer1_}, now_);
+  ASSERT_FALSE(requests.empty());
+  EXPECT_EQ(MAX_BITS, requests[0].subtree.bits);
+
+  EXPECT_TRUE(scheduler_.OnResponse(requests[0].id, PULL_LIMIT, now_));
+  EXPECT_EQ(1u, scheduler_.num_completed());
+}
+
+TEST_F(SubtreeSyncSchedulerTests, TimeoutsFollowTheMeasuredLatency)
+{
+  scheduler_.Reset(MAX_BITS);
+  EXPECT_EQ(Duration{2000}, scheduler_.GetTimeout(peer1_));
+
+  auto requests = scheduler_.Schedule({peer1_}, now_);
+  ASSERT_EQ(2u, requests.size());
+
+  // nothing expires before the initial timeout
+  EXPECT_TRUE(scheduler_.Expire(now_ + Duration{1999}).empty());
+
+  now_ += Duration{400};
+  EXPECT_TRUE(scheduler_.OnResponse(requests[0].id, 1, now_));
+  EXPECT_TRUE(scheduler_.OnResponse(requests[1].id, 1, now_));
+
+  // the timeout is derived from the smoothed round trip time and its variation
+  auto const timeout = scheduler_.GetTimeout(peer1_);
+  EXPECT_GT(timeout, Duration{400});
+  EXPECT_LT(timeout, Duration{2000});
+
+  requests = scheduler_.Schedule({peer1_}, now_);
+  ASSERT_FALSE(requests.empty());
+
+  auto const expired = scheduler_.Expire(now_ + timeout);
+  EXPECT_EQ(requests.size(), expired.size());
+  EXPECT_EQ(0u, scheduler_.num_in_flight());
+  EXPECT_EQ((1u << MAX_BITS) - 2u, scheduler_.num_pending());
+}
+
+TEST_F(SubtreeSyncSchedulerTests, NoPeersMeansNoRequests)
+{
+  scheduler_.Reset(2);
+
+  EXPECT_TRUE(scheduler_.Schedule({}, now_).empty());
+  EXPECT_EQ(4u, scheduler_.num_pending());
+  EXPECT_FALSE(scheduler_.complete());
+}
+
+}  // namespace
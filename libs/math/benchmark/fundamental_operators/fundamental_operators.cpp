@@ -0,0 +1,147 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "math/fundamental_operators.hpp"
+#include "math/matrix_operations.hpp"
+#include "math/tensor.hpp"
+#include "vectorise/platform.hpp"
+
+#include "benchmark/benchmark.h"
+
+#include <vector>
+
+// The vectorised kernels run on registers of the width selected at build time (SSE: 128,
+// AVX2: 256, AVX-512: 512 bits). The register_bits counter records which one was used so that
+// runs from differently configured builds can be compared side by side.
+
+template <class T>
+void SetUpOperands(fetch::math::Tensor<T> &a, fetch::math::Tensor<T> &b)
+{
+  for (std::size_t i = 0; i < a.size(); ++i)
+  {
+    a[i] = static_cast<T>(i % 17) + T(1);
+    b[i] = static_cast<T>(i % 5) + T(1);
+  }
+}
+
+template <class T>
+void SetCounters(benchmark::State &state, std::size_t elements)
+{
+  state.counters["register_bits"] = fetch::platform::VectorRegisterSize<T>::value;
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * elements));
+}
+
+template <class T, int H, int W>
+void BM_AddVectorised(benchmark::State &state)
+{
+  using SizeType = fetch::math::SizeType;
+
+  fetch::math::Tensor<T> a(std::vector<SizeType>{H, W});
+  fetch::math::Tensor<T> b(std::vector<SizeType>{H, W});
+  fetch::math::Tensor<T> ret(std::vector<SizeType>{H, W});
+  SetUpOperands(a, b);
+
+  fetch::memory::Range range(0, ret.data().size());
+  for (auto _ : state)
+  {
+    fetch::math::details_vectorisation::Add(a, b, range, ret);
+    benchmark::DoNotOptimize(ret.data().pointer());
+  }
+
+  SetCounters<T>(state, a.size());
+}
+
+BENCHMARK_TEMPLATE(BM_AddVectorised, float, 256, 256)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_AddVectorised, double, 256, 256)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_AddVectorised, float, 1024, 1024)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_AddVectorised, double, 1024, 1024)->Unit(benchmark::kMicrosecond);
+
+template <class T, int H, int W>
+void BM_AddIterator(benchmark::State &state)
+{
+  using SizeType = fetch::math::SizeType;
+
+  fetch::math::Tensor<T> a(std::vector<SizeType>{H, W});
+  fetch::math::Tensor<T> b(std::vector<SizeType>{H, W});
+  fetch::math::Tensor<T> ret(std::vector<SizeType>{H, W});
+  SetUpOperands(a, b);
+
+  for (auto _ : state)
+  {
+    fetch::math::Add(a, b, ret);
+    benchmark::DoNotOptimize(ret.data().pointer());
+  }
+
+  SetCounters<T>(state, a.size());
+}
+
+BENCHMARK_TEMPLATE(BM_AddIterator, float, 256, 256)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_AddIterator, double, 256, 256)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_AddIterator, float, 1024, 1024)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_AddIterator, double, 1024, 1024)->Unit(benchmark::kMicrosecond);
+
+template <class T, int H, int W>
+void BM_MultiplyVectorised(benchmark::State &state)
+{
+  using SizeType = fetch::math::SizeType;
+
+  fetch::math::Tensor<T> a(std::vector<SizeType>{H, W});
+  fetch::math::Tensor<T> b(std::vector<SizeType>{H, W});
+  fetch::math::Tensor<T> ret(std::vector<SizeType>{H, W});
+  SetUpOperands(a, b);
+
+  fetch::memory::Range range(0, ret.data().size());
+  for (auto _ : state)
+  {
+    fetch::math::details_vectorisation::Multiply(a, b, range, ret);
+    benchmark::DoNotOptimize(ret.data().pointer());
+  }
+
+  SetCounters<T>(state, a.size());
+}
+
+BENCHMARK_TEMPLATE(BM_MultiplyVectorised, float, 256, 256)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_MultiplyVectorised, double, 256, 256)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_MultiplyVectorised, float, 1024, 1024)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_MultiplyVectorised, double, 1024, 1024)->Unit(benchmark::kMicrosecond);
+
+template <class T, int H, int W>
+void BM_SumVectorised(benchmark::State &state)
+{
+  using SizeType = fetch::math::SizeType;
+
+  fetch::math::Tensor<T> a(std::vector<SizeType>{H, W});
+  fetch::math::Tensor<T> b(std::vector<SizeType>{H, W});
+  SetUpOperands(a, b);
+
+  T ret{0};
+  for (auto _ : state)
+  {
+    fetch::math::details_vectorisation::Sum(a, ret);
+    benchmark::DoNotOptimize(ret);
+  }
+
+  SetCounters<T>(state, a.size());
+}
+
+BENCHMARK_TEMPLATE(BM_SumVectorised, float, 256, 256)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_SumVectorised, double, 256, 256)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_SumVectorised, float, 1024, 1024)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_SumVectorised, double, 1024, 1024)->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_MAIN();
@@ -16,11 +16,14 @@
 //
 //------------------------------------------------------------------------------
 
+#include "math/linalg/blas/gemm_kernel.hpp"
 #include "math/matrix_operations.hpp"
 #include "math/tensor.hpp"
 
 #include "benchmark/benchmark.h"
 
+#include <cstddef>
+#include <cstdint>
 #include <vector>
 
 template <class T, int C, int H, int W>
@@ -713,4 +716,103 @@ BENCHMARK_TEMPLATE(BM_DynamicStitch, fetch::fixed_point::FixedPoint<16, 16>, 256
 BENCHMARK_TEMPLATE(BM_DynamicStitch, fetch::fixed_point::FixedPoint<32, 32>, 256, 256, 256)
     ->Unit(benchmark::kMillisecond);
 
+// Gemm throughput on square matrices, swept over the matrix size and the gemm thread count
+void GemmArguments(benchmark::internal::Benchmark *b)
+{
+  for (int64_t threads : {1, 2, 4, 8})
+  {
+    for (int64_t size : {64, 128, 256, 512, 1024})
+    {
+      b->Args({size, threads});
+    }
+  }
+  b->Unit(benchmark::kMillisecond)->UseRealTime();
+}
+
+void ReportGemm(benchmark::State &state)
+{
+  auto const size = static_cast<double>(state.range(0));
+
+  state.counters["GFLOP"] = benchmark::Counter(
+      2.0 * size * size * size * 1e-9, benchmark::Counter::kIsIterationInvariantRate);
+  state.counters["threads"] = static_cast<double>(state.range(1));
+
+  fetch::math::linalg::SetGemmConcurrency(1);
+}
+
+template <class T>
+void BM_Dot(benchmark::State &state)
+{
+  using SizeType = fetch::math::SizeType;
+
+  auto const size = static_cast<SizeType>(state.range(0));
+  fetch::math::linalg::SetGemmConcurrency(static_cast<std::size_t>(state.range(1)));
+
+  fetch::math::Tensor<T> a(std::vector<SizeType>{size, size});
+  fetch::math::Tensor<T> b(std::vector<SizeType>{size, size});
+  fetch::math::Tensor<T> ret(std::vector<SizeType>{size, size});
+  a.FillUniformRandom();
+  b.FillUniformRandom();
+
+  for (auto _ : state)
+  {
+    fetch::math::Dot(a, b, ret);
+  }
+
+  ReportGemm(state);
+}
+
+BENCHMARK_TEMPLATE(BM_Dot, float)->Apply(GemmArguments);
+BENCHMARK_TEMPLATE(BM_Dot, double)->Apply(GemmArguments);
+
+template <class T>
+void BM_DotTranspose(benchmark::State &state)
+{
+  using SizeType = fetch::math::SizeType;
+
+  auto const size = static_cast<SizeType>(state.range(0));
+  fetch::math::linalg::SetGemmConcurrency(static_cast<std::size_t>(state.range(1)));
+
+  fetch::math::Tensor<T> a(std::vector<SizeType>{size, size});
+  fetch::math::Tensor<T> b(std::vector<SizeType>{size, size});
+  fetch::math::Tensor<T> ret(std::vector<SizeType>{size, size});
+  a.FillUniformRandom();
+  b.FillUniformRandom();
+
+  for (auto _ : state)
+  {
+    fetch::math::DotTranspose(a, b, ret);
+  }
+
+  ReportGemm(state);
+}
+
+BENCHMARK_TEMPLATE(BM_DotTranspose, float)->Apply(GemmArguments);
+BENCHMARK_TEMPLATE(BM_DotTranspose, double)->Apply(GemmArguments);
+
+template <class T>
+void BM_TransposeDot(benchmark::State &state)
+{
+  using SizeType = fetch::math::SizeType;
+
+  auto const size = static_cast<SizeType>(state.range(0));
+  fetch::math::linalg::SetGemmConcurrency(static_cast<std::size_t>(state.range(1)));
+
+  fetch::math::Tensor<T> a(std::vector<SizeType>{size, size});
+  fetch::math::Tensor<T> b(std::vector<SizeType>{size, size});
+  fetch::math::Tensor<T> ret(std::vector<SizeType>{size, size});
+  a.FillUniformRandom();
+  b.FillUniformRandom();
+
+  for (auto _ : state)
+  {
+    fetch::math::TransposeDot(a, b, ret);
+  }
+
+  ReportGemm(state);
+}
+
+BENCHMARK_TEMPLATE(BM_TransposeDot, float)->Apply(GemmArguments);
+BENCHMARK_TEMPLATE(BM_TransposeDot, double)->Apply(GemmArguments);
+
 BENCHMARK_MAIN();
@@ -0,0 +1,57 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+/* Cache blocked matrix multiplication shared by the vectorised gemm
+ * implementations. It computes
+ *
+ *   C = alpha * op(A) * op(B) + beta * C
+ *
+ * where op(X) is either X or its transpose. Blocks of op(A) and op(B) are
+ * copied into contiguous panels that fit in cache, and a register blocked
+ * micro-kernel walks over those panels. Large products can be split across
+ * the threads of a pool that is shared by all gemm calls.
+ */
+
+#include "math/base_types.hpp"
+#include "math/tensor_view.hpp"
+
+#include <cstddef>
+
+namespace fetch {
+namespace math {
+namespace linalg {
+
+/**
+ * Sets the number of threads a single vectorised gemm call may use. The
+ * default is one, i.e. the calling thread only. Zero selects the number of
+ * hardware threads.
+ */
+void        SetGemmConcurrency(std::size_t threads);
+std::size_t GemmConcurrency();
+
+namespace details {
+
+template <typename T>
+void BlockedGemm(bool transpose_a, bool transpose_b, T alpha, TensorView<T> const &a,
+                 TensorView<T> const &b, T beta, TensorView<T> &c);
+
+}  // namespace details
+}  // namespace linalg
+}  // namespace math
+}  // namespace fetch
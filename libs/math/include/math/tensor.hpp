@@ -827,8 +827,9 @@ typename Tensor<T, C>::ViewType Tensor<T, C>::View()
 {
   assert(shape_.size() >= 1);
 
-  SizeType N     = shape_.size() - 1;
-  SizeType width = shape_[N] * stride_[N] / padded_height_;
+  SizeType N                = shape_.size() - 1;
+  SizeType dimension_length = (N == 0 ? padded_height_ : shape_[N]);
+  SizeType width            = dimension_length * stride_[N] / padded_height_;
   return TensorView<Type, ContainerType>(data_, height(), width);
 }
 
@@ -843,8 +844,9 @@ typename Tensor<T, C>::ViewType const Tensor<T, C>::View() const
 {
   assert(shape_.size() >= 1);
 
-  SizeType N     = shape_.size() - 1;
-  SizeType width = shape_[N] * stride_[N] / padded_height_;
+  SizeType N                = shape_.size() - 1;
+  SizeType dimension_length = (N == 0 ? padded_height_ : shape_[N]);
+  SizeType width            = dimension_length * stride_[N] / padded_height_;
   return TensorView<Type, ContainerType>(data_, height(), width);
 }
 
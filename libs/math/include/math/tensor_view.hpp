@@ -41,7 +41,8 @@ public:
 
   enum
   {
-    LOG_PADDING = 2,
+    // Columns always span whole vector registers, so wide registers need more padding
+    LOG_PADDING = (ContainerType::E_LOG_SIMD_COUNT > 2) ? ContainerType::E_LOG_SIMD_COUNT : 2,
     PADDING     = static_cast<SizeType>(1) << LOG_PADDING
   };
 
@@ -0,0 +1,414 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "math/linalg/blas/gemm_kernel.hpp"
+#include "vectorise/threading/pool.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <exception>
+#include <future>
+#include <thread>
+#include <vector>
+
+namespace fetch {
+namespace math {
+namespace linalg {
+namespace {
+
+std::atomic<std::size_t> gemm_concurrency{1};
+
+threading::Pool &GemmPool()
+{
+  static threading::Pool pool{std::max<std::size_t>(std::thread::hardware_concurrency(), 1),
+                              "Gemm"};
+  return pool;
+}
+
+template <typename T>
+struct GemmBlocking
+{
+  using VectorRegisterType = typename TensorView<T>::VectorRegisterType;
+
+  enum : SizeType
+  {
+    // the micro-kernel keeps an MR x NR tile of C in 2 * NR vector registers
+    MR = 2 * VectorRegisterType::E_BLOCK_COUNT,
+    NR = 6,
+
+    // a KC x NR panel of B stays in L1, an MC x KC block of A in L2 and a
+    // KC x NC block of B in L3
+    KC = 256,
+    MC = 128,
+    NC = 3072,
+
+    // products below this many multiply-adds are not worth splitting
+    PARALLEL_THRESHOLD = 1ull << 21
+  };
+
+  static_assert(MC % MR == 0, "A blocks must consist of whole micro-panels");
+  static_assert(NC % NR == 0, "B blocks must consist of whole micro-panels");
+};
+
+/**
+ * Read only access to op(X) for a column major matrix X with a padded
+ * leading dimension
+ */
+template <typename T>
+struct Operand
+{
+  T const *data;
+  SizeType row_stride;
+  SizeType col_stride;
+
+  T operator()(SizeType i, SizeType j) const
+  {
+    return data[(i * row_stride) + (j * col_stride)];
+  }
+};
+
+template <typename T>
+Operand<T> MakeOperand(TensorView<T> const &x, bool transpose)
+{
+  if (transpose)
+  {
+    return {x.data().pointer(), x.padded_height(), 1};
+  }
+
+  return {x.data().pointer(), 1, x.padded_height()};
+}
+
+template <typename T>
+T *AlignedScratch(std::vector<T> &buffer, SizeType size)
+{
+  constexpr std::uintptr_t alignment = 64;
+
+  if (buffer.size() < size + (alignment / sizeof(T)))
+  {
+    buffer.resize(size + (alignment / sizeof(T)));
+  }
+
+  auto address = reinterpret_cast<std::uintptr_t>(buffer.data());
+  address      = (address + alignment - 1) & ~(alignment - 1);
+  return reinterpret_cast<T *>(address);
+}
+
+/**
+ * Copies rows [i0, i0 + mc) and columns [l0, l0 + kc) of op(A) into
+ * micro-panels of MR rows, each stored column by column. Rows beyond the
+ * matrix are zero filled so the micro-kernel never has to test for edges.
+ */
+template <typename T>
+void PackA(Operand<T> const &a, SizeType i0, SizeType mc, SizeType l0, SizeType kc, T *packed)
+{
+  constexpr SizeType MR = GemmBlocking<T>::MR;
+
+  for (SizeType ip = 0; ip < mc; ip += MR)
+  {
+    SizeType const rows = std::min<SizeType>(MR, mc - ip);
+
+    for (SizeType l = 0; l < kc; ++l)
+    {
+      for (SizeType r = 0; r < rows; ++r)
+      {
+        packed[r] = a(i0 + ip + r, l0 + l);
+      }
+
+      std::fill(packed + rows, packed + MR, static_cast<T>(0));
+      packed += MR;
+    }
+  }
+}
+
+/**
+ * Copies rows [l0, l0 + kc) and columns [j0, j0 + nc) of op(B) into
+ * micro-panels of NR columns, each stored row by row.
+ */
+template <typename T>
+void PackB(Operand<T> const &b, SizeType l0, SizeType kc, SizeType j0, SizeType nc, T *packed)
+{
+  constexpr SizeType NR = GemmBlocking<T>::NR;
+
+  for (SizeType jp = 0; jp < nc; jp += NR)
+  {
+    SizeType const cols = std::min<SizeType>(NR, nc - jp);
+
+    for (SizeType l = 0; l < kc; ++l)
+    {
+      for (SizeType r = 0; r < cols; ++r)
+      {
+        packed[r] = b(l0 + l, j0 + jp + r);
+      }
+
+      std::fill(packed + cols, packed + NR, static_cast<T>(0));
+      packed += NR;
+    }
+  }
+}
+
+/**
+ * Multiplies an MR x kc panel of A with a kc x NR panel of B and stores the
+ * MR x NR result column by column in tile
+ */
+template <typename T>
+void MicroKernel(SizeType kc, T const *pa, T const *pb, T *tile)
+{
+  using VectorRegisterType = typename GemmBlocking<T>::VectorRegisterType;
+
+  constexpr SizeType E  = VectorRegisterType::E_BLOCK_COUNT;
+  constexpr SizeType MR = GemmBlocking<T>::MR;
+  constexpr SizeType NR = GemmBlocking<T>::NR;
+
+  VectorRegisterType zero(static_cast<T>(0));
+  VectorRegisterType c00 = zero, c01 = zero, c02 = zero, c03 = zero, c04 = zero, c05 = zero;
+  VectorRegisterType c10 = zero, c11 = zero, c12 = zero, c13 = zero, c14 = zero, c15 = zero;
+
+  for (SizeType l = 0; l < kc; ++l)
+  {
+    VectorRegisterType const a0(pa);
+    VectorRegisterType const a1(pa + E);
+    VectorRegisterType       b;
+
+    b   = VectorRegisterType(pb[0]);
+    c00 = c00 + (a0 * b);
+    c10 = c10 + (a1 * b);
+    b   = VectorRegisterType(pb[1]);
+    c01 = c01 + (a0 * b);
+    c11 = c11 + (a1 * b);
+    b   = VectorRegisterType(pb[2]);
+    c02 = c02 + (a0 * b);
+    c12 = c12 + (a1 * b);
+    b   = VectorRegisterType(pb[3]);
+    c03 = c03 + (a0 * b);
+    c13 = c13 + (a1 * b);
+    b   = VectorRegisterType(pb[4]);
+    c04 = c04 + (a0 * b);
+    c14 = c14 + (a1 * b);
+    b   = VectorRegisterType(pb[5]);
+    c05 = c05 + (a0 * b);
+    c15 = c15 + (a1 * b);
+
+    pa += MR;
+    pb += NR;
+  }
+
+  c00.Store(tile + (0 * MR));
+  c10.Store(tile + (0 * MR) + E);
+  c01.Store(tile + (1 * MR));
+  c11.Store(tile + (1 * MR) + E);
+  c02.Store(tile + (2 * MR));
+  c12.Store(tile + (2 * MR) + E);
+  c03.Store(tile + (3 * MR));
+  c13.Store(tile + (3 * MR) + E);
+  c04.Store(tile + (4 * MR));
+  c14.Store(tile + (4 * MR) + E);
+  c05.Store(tile + (5 * MR));
+  c15.Store(tile + (5 * MR) + E);
+
+  static_assert(NR == 6, "micro-kernel is unrolled for six columns");
+}
+
+/**
+ * Applies beta to C and accumulates alpha * op(A) * op(B) into rows
+ * [m0, m1) and columns [n0, n1) of C.
+ */
+template <typename T>
+void GemmRange(Operand<T> const &a, Operand<T> const &b, SizeType k, T alpha, T beta, T *c,
+               SizeType ldc, SizeType m0, SizeType m1, SizeType n0, SizeType n1)
+{
+  constexpr SizeType MR = GemmBlocking<T>::MR;
+  constexpr SizeType NR = GemmBlocking<T>::NR;
+  constexpr SizeType KC = GemmBlocking<T>::KC;
+  constexpr SizeType MC = GemmBlocking<T>::MC;
+  constexpr SizeType NC = GemmBlocking<T>::NC;
+
+  if (beta != static_cast<T>(1))
+  {
+    for (SizeType j = n0; j < n1; ++j)
+    {
+      T *column = c + (j * ldc);
+      for (SizeType i = m0; i < m1; ++i)
+      {
+        // beta == 0 overwrites C, so NaNs already in it do not propagate
+        column[i] = (beta == static_cast<T>(0)) ? static_cast<T>(0) : beta * column[i];
+      }
+    }
+  }
+
+  if ((alpha == static_cast<T>(0)) || (k == 0))
+  {
+    return;
+  }
+
+  thread_local std::vector<T> buffer_a;
+  thread_local std::vector<T> buffer_b;
+
+  T *packed_a = AlignedScratch(buffer_a, MC * KC);
+  T *packed_b = AlignedScratch(buffer_b, KC * std::min<SizeType>(NC, n1 - n0 + NR));
+
+  alignas(64) T tile[MR * NR];
+
+  for (SizeType jc = n0; jc < n1; jc += NC)
+  {
+    SizeType const nc = std::min<SizeType>(NC, n1 - jc);
+
+    for (SizeType lc = 0; lc < k; lc += KC)
+    {
+      SizeType const kc = std::min<SizeType>(KC, k - lc);
+      PackB(b, lc, kc, jc, nc, packed_b);
+
+      for (SizeType ic = m0; ic < m1; ic += MC)
+      {
+        SizeType const mc = std::min<SizeType>(MC, m1 - ic);
+        PackA(a, ic, mc, lc, kc, packed_a);
+
+        for (SizeType jr = 0; jr < nc; jr += NR)
+        {
+          SizeType const cols = std::min<SizeType>(NR, nc - jr);
+
+          for (SizeType ir = 0; ir < mc; ir += MR)
+          {
+            SizeType const rows = std::min<SizeType>(MR, mc - ir);
+
+            MicroKernel(kc, packed_a + (ir * kc), packed_b + (jr * kc), tile);
+
+            for (SizeType j = 0; j < cols; ++j)
+            {
+              T *column = c + ((jc + jr + j) * ldc) + ic + ir;
+              for (SizeType i = 0; i < rows; ++i)
+              {
+                column[i] += alpha * tile[(j * MR) + i];
+              }
+            }
+          }
+        }
+      }
+    }
+  }
+}
+
+}  // namespace
+
+void SetGemmConcurrency(std::size_t threads)
+{
+  if (threads == 0)
+  {
+    threads = std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+  }
+
+  gemm_concurrency = threads;
+}
+
+std::size_t GemmConcurrency()
+{
+  return gemm_concurrency;
+}
+
+namespace details {
+
+template <typename T>
+void BlockedGemm(bool transpose_a, bool transpose_b, T alpha, TensorView<T> const &a,
+                 TensorView<T> const &b, T beta, TensorView<T> &c)
+{
+  SizeType const m = c.height();
+  SizeType const n = c.width();
+  SizeType const k = transpose_a ? a.height() : a.width();
+
+  if ((m == 0) || (n == 0) ||
+      (((alpha == static_cast<T>(0)) || (k == 0)) && (beta == static_cast<T>(1))))
+  {
+    return;
+  }
+
+  Operand<T> const op_a = MakeOperand(a, transpose_a);
+  Operand<T> const op_b = MakeOperand(b, transpose_b);
+  T *const         data = c.data().pointer();
+  SizeType const   ldc  = c.padded_height();
+
+  // Split the larger dimension of C into one chunk per thread. Chunks never
+  // overlap and every element is summed in the same order, so the result
+  // does not depend on the thread count.
+  bool const     split_columns = n >= m;
+  SizeType const extent        = split_columns ? n : m;
+  SizeType const unit          = split_columns ? SizeType{GemmBlocking<T>::NR}
+                                               : SizeType{GemmBlocking<T>::MR};
+  SizeType       chunks        = 1;
+
+  if ((m * n * k) >= GemmBlocking<T>::PARALLEL_THRESHOLD)
+  {
+    chunks = std::min<SizeType>(GemmConcurrency(), (extent + unit - 1) / unit);
+  }
+
+  SizeType const chunk_size = (((extent + chunks - 1) / chunks + unit - 1) / unit) * unit;
+
+  auto run_chunk = [&](SizeType begin) {
+    SizeType const end = std::min<SizeType>(begin + chunk_size, extent);
+
+    if (split_columns)
+    {
+      GemmRange(op_a, op_b, k, alpha, beta, data, ldc, 0, m, begin, end);
+    }
+    else
+    {
+      GemmRange(op_a, op_b, k, alpha, beta, data, ldc, begin, end, 0, n);
+    }
+  };
+
+  std::vector<std::future<void>> pending;
+  for (SizeType begin = chunk_size; begin < extent; begin += chunk_size)
+  {
+    pending.emplace_back(GemmPool().Dispatch(run_chunk, begin));
+  }
+
+  // the other chunks refer to this frame, so they must finish before it unwinds
+  std::exception_ptr error;
+  try
+  {
+    run_chunk(0);
+  }
+  catch (...)
+  {
+    error = std::current_exception();
+  }
+
+  for (auto &result : pending)
+  {
+    result.wait();
+  }
+
+  if (error)
+  {
+    std::rethrow_exception(error);
+  }
+
+  for (auto &result : pending)
+  {
+    result.get();
+  }
+}
+
+template void BlockedGemm<float>(bool, bool, float, TensorView<float> const &,
+                                 TensorView<float> const &, float, TensorView<float> &);
+template void BlockedGemm<double>(bool, bool, double, TensorView<double> const &,
+                                  TensorView<double> const &, double, TensorView<double> &);
+
+}  // namespace details
+}  // namespace linalg
+}  // namespace math
+}  // namespace fetch
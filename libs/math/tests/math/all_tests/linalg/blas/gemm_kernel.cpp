@@ -0,0 +1,145 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "math/linalg/blas/base.hpp"
+#include "math/linalg/blas/gemm_kernel.hpp"
+#include "math/linalg/blas/gemm_nn_novector.hpp"
+#include "math/linalg/blas/gemm_nn_vector.hpp"
+#include "math/linalg/blas/gemm_nt_novector.hpp"
+#include "math/linalg/blas/gemm_nt_vector.hpp"
+#include "math/linalg/blas/gemm_tn_novector.hpp"
+#include "math/linalg/blas/gemm_tn_vector.hpp"
+#include "math/linalg/blas/gemm_tt_novector.hpp"
+#include "math/linalg/blas/gemm_tt_vector.hpp"
+#include "math/linalg/prototype.hpp"
+#include "math/tensor.hpp"
+
+#include "gtest/gtest.h"
+
+#include <cstddef>
+#include <vector>
+
+using namespace fetch;
+using namespace fetch::math;
+using namespace fetch::math::linalg;
+
+namespace {
+
+template <typename T>
+class BlockedGemmTest : public ::testing::Test
+{
+protected:
+  void TearDown() override
+  {
+    SetGemmConcurrency(1);
+  }
+};
+
+using MyTypes = ::testing::Types<float, double>;
+TYPED_TEST_CASE(BlockedGemmTest, MyTypes);
+
+// Sizes straddle the micro-kernel tile and the cache blocks in every dimension
+std::vector<std::vector<SizeType>> const shapes{
+    {1, 1, 1}, {3, 7, 5}, {37, 13, 11}, {133, 61, 300}, {70, 200, 129}, {300, 9, 1000}};
+
+template <typename Vectorised, typename Reference, typename T>
+void CheckAgainstReference(bool transpose_a, bool transpose_b, T alpha, T beta)
+{
+  Vectorised vectorised;
+  Reference  reference;
+
+  for (std::size_t threads : {1, 4})
+  {
+    SetGemmConcurrency(threads);
+
+    for (auto const &shape : shapes)
+    {
+      SizeType const m = shape[0];
+      SizeType const n = shape[1];
+      SizeType const k = shape[2];
+
+      auto a = Tensor<T>::UniformRandom(m * k);
+      auto b = Tensor<T>::UniformRandom(k * n);
+      auto c = Tensor<T>::UniformRandom(m * n);
+      a.Reshape(transpose_a ? SizeVector{k, m} : SizeVector{m, k});
+      b.Reshape(transpose_b ? SizeVector{n, k} : SizeVector{k, n});
+      c.Reshape({m, n});
+
+      Tensor<T> expected = c.Copy();
+      reference(alpha, a.View(), b.View(), beta, expected.View());
+      vectorised(alpha, a.View(), b.View(), beta, c.View());
+
+      EXPECT_TRUE(c.AllClose(expected, T(1e-4), T(1e-4)))
+          << "m=" << m << " n=" << n << " k=" << k << " threads=" << threads;
+    }
+  }
+}
+
+}  // namespace
+
+TYPED_TEST(BlockedGemmTest, nn_matches_reference)
+{
+  using Type = TypeParam;
+
+  CheckAgainstReference<Blas<Type, Signature(_C <= _alpha, _A, _B, _beta, _C),
+                             Computes(_C <= _alpha * _A * _B + _beta * _C),
+                             platform::Parallelisation::VECTORISE>,
+                        Blas<Type, Signature(_C <= _alpha, _A, _B, _beta, _C),
+                             Computes(_C <= _alpha * _A * _B + _beta * _C),
+                             platform::Parallelisation::NOT_PARALLEL>>(false, false, Type(0.5),
+                                                                      Type(2));
+}
+
+TYPED_TEST(BlockedGemmTest, nt_matches_reference)
+{
+  using Type = TypeParam;
+
+  CheckAgainstReference<Blas<Type, Signature(_C <= _alpha, _A, _B, _beta, _C),
+                             Computes(_C <= _alpha * _A * T(_B) + _beta * _C),
+                             platform::Parallelisation::VECTORISE>,
+                        Blas<Type, Signature(_C <= _alpha, _A, _B, _beta, _C),
+                             Computes(_C <= _alpha * _A * T(_B) + _beta * _C),
+                             platform::Parallelisation::NOT_PARALLEL>>(false, true, Type(1),
+                                                                      Type(0));
+}
+
+TYPED_TEST(BlockedGemmTest, tn_matches_reference)
+{
+  using Type = TypeParam;
+
+  CheckAgainstReference<Blas<Type, Signature(_C <= _alpha, _A, _B, _beta, _C),
+                             Computes(_C <= _alpha * T(_A) * _B + _beta * _C),
+                             platform::Parallelisation::VECTORISE>,
+                        Blas<Type, Signature(_C <= _alpha, _A, _B, _beta, _C),
+                             Computes(_C <= _alpha * T(_A) * _B + _beta * _C),
+                             platform::Parallelisation::NOT_PARALLEL>>(true, false, Type(-1),
+                                                                      Type(1));
+}
+
+TYPED_TEST(BlockedGemmTest, tt_matches_reference)
+{
+  using Type = TypeParam;
+
+  CheckAgainstReference<Blas<Type, Signature(_C <= _alpha, _A, _B, _beta, _C),
+                             Computes(_C <= _alpha * T(_A) * T(_B) + _beta * _C),
+                             platform::Parallelisation::VECTORISE>,
+                        Blas<Type, Signature(_C <= _alpha, _A, _B, _beta, _C),
+                             Computes(_C <= _alpha * T(_A) * T(_B) + _beta * _C),
+                             platform::Parallelisation::NOT_PARALLEL>>(true, true, Type(2),
+                                                                      Type(0.5));
+}
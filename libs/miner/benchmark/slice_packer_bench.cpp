@@ -0,0 +1,105 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/bitvector.hpp"
+#include "core/byte_array/byte_array.hpp"
+#include "core/random/lcg.hpp"
+#include "ledger/chain/block.hpp"
+#include "ledger/chain/transaction_layout.hpp"
+#include "miner/slice_packer.hpp"
+#include "miner/transaction_layout_queue.hpp"
+
+#include "benchmark/benchmark.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+
+namespace {
+
+using fetch::BitVector;
+using fetch::byte_array::ByteArray;
+using fetch::ledger::Block;
+using fetch::ledger::TransactionLayout;
+using fetch::miner::SlicePacker;
+using fetch::miner::TransactionLayoutQueue;
+
+using Rng = fetch::random::LinearCongruentialGenerator;
+
+constexpr std::size_t NUM_LANES   = 16;
+constexpr std::size_t NUM_SLICES  = 64;
+constexpr std::size_t DIGEST_SIZE = 32;
+
+void PopulateQueue(TransactionLayoutQueue &queue, std::size_t num_transactions)
+{
+  Rng                                 rng{};
+  std::mt19937_64                     gen{42};
+  std::poisson_distribution<uint32_t> num_resources(3.0);
+
+  for (std::size_t i = 0; i < num_transactions; ++i)
+  {
+    ByteArray digest{};
+    digest.Resize(DIGEST_SIZE);
+
+    auto *raw = reinterpret_cast<Rng::RandomType *>(digest.pointer());
+    for (std::size_t j = 0; j < DIGEST_SIZE / sizeof(Rng::RandomType); ++j)
+    {
+      raw[j] = rng();
+    }
+
+    BitVector mask{NUM_LANES};
+    for (uint32_t j = 0, count = num_resources(gen); j < count; ++j)
+    {
+      mask.set(rng() % NUM_LANES, 1);
+    }
+
+    queue.Add(TransactionLayout{digest, mask, rng() % 1000u, 1, 1000});
+  }
+}
+
+void SlicePacker_GenerateSlices(benchmark::State &state)
+{
+  TransactionLayoutQueue queue;
+  PopulateQueue(queue, static_cast<std::size_t>(state.range(0)));
+
+  SlicePacker packer{NUM_LANES};
+
+  for (auto _ : state)
+  {
+    Block::Slices slices(NUM_SLICES);
+
+    // the packed transactions are not removed so each iteration packs the same pool
+    packer.Load(queue);
+    for (auto &slice : slices)
+    {
+      packer.GenerateSlice(slice);
+    }
+
+    benchmark::DoNotOptimize(slices);
+  }
+
+  state.counters["packed"] = static_cast<double>(packer.num_packed());
+}
+
+}  // namespace
+
+BENCHMARK(SlicePacker_GenerateSlices)
+    ->Arg(10000)
+    ->Arg(100000)
+    ->Arg(1000000)
+    ->Unit(benchmark::kMillisecond);
@@ -0,0 +1,114 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "ledger/chain/block.hpp"
+#include "miner/transaction_layout_queue.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace fetch {
+namespace miner {
+
+/**
+ * Greedy slice packing engine.
+ *
+ * The candidate transactions are loaded into a contiguous structure-of-arrays pool. The lane mask
+ * of each candidate is stored inline in the pool as a fixed number of 64-bit words, so checking a
+ * candidate against the slice being built is a short, allocation free loop. Candidates are visited
+ * in fee order (highest first, ties in queue order) using a binary heap. Candidates which collide
+ * with a slice are kept, still in order, at the front of the search for the next slice.
+ */
+class SlicePacker
+{
+public:
+  using Queue = TransactionLayoutQueue;
+  using Slice = ledger::Block::Slice;
+
+  // Construction / Destruction
+  explicit SlicePacker(std::size_t num_lanes);
+  SlicePacker(SlicePacker const &) = delete;
+  SlicePacker(SlicePacker &&)      = delete;
+  ~SlicePacker()                   = default;
+
+  /// @name Packing
+  /// @{
+  void        Load(Queue &queue);
+  void        GenerateSlice(Slice &slice);
+  std::size_t RemovePacked(Queue &queue);
+  /// @}
+
+  /// @name Accessors
+  /// @{
+  std::size_t num_candidates() const;
+  std::size_t num_packed() const;
+  /// @}
+
+  // Operators
+  SlicePacker &operator=(SlicePacker const &) = delete;
+  SlicePacker &operator=(SlicePacker &&) = delete;
+
+private:
+  using Word          = uint64_t;
+  using Index         = uint32_t;
+  using WordArray     = std::vector<Word>;
+  using IndexArray    = std::vector<Index>;
+  using ChargeArray   = std::vector<uint64_t>;
+  using IteratorArray = std::vector<Queue::Iterator>;
+
+  static constexpr std::size_t BITS_PER_WORD = sizeof(Word) * 8u;
+
+  bool HasPriority(Index a, Index b) const;
+  bool Collides(Index index) const;
+  void Place(Index index, Slice &slice);
+
+  std::size_t const num_lanes_;
+  std::size_t const words_per_mask_;
+
+  /// @name Candidate Pool
+  /// @{
+  IteratorArray layouts_;     ///< The location of each candidate in the source queue
+  ChargeArray   charges_;     ///< The charge (fee) of each candidate
+  IndexArray    lane_count_;  ///< The number of lanes used by each candidate
+  WordArray     masks_;       ///< The lane masks, `words_per_mask_` words per candidate
+  /// @}
+
+  /// @name Search State
+  /// @{
+  IndexArray heap_;      ///< Candidates not yet visited, ordered by fee
+  IndexArray deferred_;  ///< Visited but unpacked candidates, in fee order
+  IndexArray next_deferred_;
+  IndexArray packed_;      ///< Candidates which have been packed into a slice
+  WordArray  slice_mask_;  ///< The lanes used by the current slice
+  /// @}
+};
+
+inline std::size_t SlicePacker::num_candidates() const
+{
+  return layouts_.size();
+}
+
+inline std::size_t SlicePacker::num_packed() const
+{
+  return packed_.size();
+}
+
+}  // namespace miner
+}  // namespace fetch
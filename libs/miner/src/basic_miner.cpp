@@ -22,6 +22,7 @@
 #include "ledger/chain/main_chain.hpp"
 #include "ledger/chain/transaction.hpp"
 #include "miner/basic_miner.hpp"
+#include "miner/slice_packer.hpp"
 #include "telemetry/counter.hpp"
 #include "telemetry/gauge.hpp"
 #include "telemetry/registry.hpp"
@@ -236,76 +237,17 @@ uint64_t BasicMiner::GetBacklog() const
 void BasicMiner::GenerateSlices(Queue &transactions, Block::Body &block, std::size_t offset,
                                 std::size_t interval, std::size_t num_lanes)
 {
-  // sort by fees
-  transactions.Sort(SortByFee);
+  SlicePacker packer{num_lanes};
+  packer.Load(transactions);
 
   for (std::size_t slice_idx = offset; slice_idx < block.slices.size(); slice_idx += interval)
   {
-    auto &slice = block.slices[slice_idx];
-
     // generate the slice
-    GenerateSlice(transactions, slice, slice_idx, num_lanes);
+    packer.GenerateSlice(block.slices[slice_idx]);
   }
-}
-
-/**
- * Internal: Generate a slice
- *
- * @param transactions The transaction queue to be used when generating the slice
- * @param slice The slice to be populated
- * @param slice_index The slice number
- * @param num_lanes The number of lanes for the block
- */
-void BasicMiner::GenerateSlice(Queue &transactions, Block::Slice &      slice,
-                               std::size_t /*slice_index*/, std::size_t num_lanes)
-{
-  BitVector slice_state{num_lanes};
-
-  auto it = transactions.begin();
-  while (it != transactions.end())
-  {
-    // exit the search loop once the slice is full
-    if (slice_state.PopCount() == num_lanes)
-    {
-      break;
-    }
-
-    BitVector const &mask = it->mask();
-
-    // calculate the collisions for this
-    BitVector const collisions = slice_state & mask;
 
-    // determine if there are collisions
-    if (collisions.PopCount() == 0)
-    {
-      // update the slice state
-      slice_state |= mask;
-
-      // insert the transaction into the slice
-      slice.push_back(*it);
-
-      // remove the transaction from the main queue
-      it = transactions.Erase(it);
-    }
-    else
-    {
-      // advance to the next iterator
-      ++it;
-    }
-  }
-}
-
-/**
- * Sorting method for transactions
- *
- * @param a The reference to a transaction entry
- * @param b The reference to the other transaction entry
- * @return true if a is preferable to b, otherwise false
- */
-bool BasicMiner::SortByFee(TransactionLayout const &a, TransactionLayout const &b)
-{
-  // this doesn't seem to the a good metric
-  return a.charge() > b.charge();
+  // remove all the packed transactions from the queue
+  packer.RemovePacked(transactions);
 }
 
 }  // namespace miner
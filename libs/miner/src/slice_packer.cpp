@@ -0,0 +1,221 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/bitvector.hpp"
+#include "miner/slice_packer.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <limits>
+
+namespace fetch {
+namespace miner {
+
+constexpr std::size_t SlicePacker::BITS_PER_WORD;
+
+/**
+ * Construct the packer
+ *
+ * @param num_lanes The number of lanes of the block being packed
+ */
+SlicePacker::SlicePacker(std::size_t num_lanes)
+  : num_lanes_{num_lanes}
+  , words_per_mask_{(num_lanes + BITS_PER_WORD - 1u) / BITS_PER_WORD}
+  , slice_mask_(words_per_mask_, 0)
+{}
+
+/**
+ * Load the contents of the queue into the candidate pool. The queue must not be modified (other
+ * than by `RemovePacked`) while the packer is in use.
+ *
+ * @param queue The queue of transactions to be packed
+ */
+void SlicePacker::Load(Queue &queue)
+{
+  std::size_t const num_candidates = queue.size();
+  assert(num_candidates <= std::numeric_limits<Index>::max());
+
+  layouts_.clear();
+  charges_.clear();
+  lane_count_.clear();
+  masks_.clear();
+  heap_.clear();
+  deferred_.clear();
+  packed_.clear();
+
+  layouts_.reserve(num_candidates);
+  charges_.reserve(num_candidates);
+  lane_count_.reserve(num_candidates);
+  masks_.reserve(num_candidates * words_per_mask_);
+  heap_.reserve(num_candidates);
+
+  for (auto it = queue.begin(), end = queue.end(); it != end; ++it)
+  {
+    BitVector const &mask = it->mask();
+    assert(mask.size() == num_lanes_);
+
+    auto const index = static_cast<Index>(layouts_.size());
+
+    layouts_.push_back(it);
+    charges_.push_back(it->charge());
+    lane_count_.push_back(static_cast<Index>(mask.PopCount()));
+
+    for (std::size_t i = 0; i < words_per_mask_; ++i)
+    {
+      masks_.push_back((i < mask.blocks()) ? mask(i) : Word{0});
+    }
+
+    heap_.push_back(index);
+  }
+
+  // the heap comparator orders the lowest priority candidate first
+  std::make_heap(heap_.begin(), heap_.end(),
+                 [this](Index a, Index b) { return HasPriority(b, a); });
+}
+
+/**
+ * Pack the next slice from the remaining candidates
+ *
+ * @param slice The slice to be populated
+ */
+void SlicePacker::GenerateSlice(Slice &slice)
+{
+  auto const lower_priority = [this](Index a, Index b) { return HasPriority(b, a); };
+
+  std::fill(slice_mask_.begin(), slice_mask_.end(), Word{0});
+  next_deferred_.clear();
+
+  std::size_t lanes_used{0};
+
+  // previously deferred candidates have a higher priority than any remaining in the heap
+  auto it = deferred_.begin();
+  for (; (it != deferred_.end()) && (lanes_used < num_lanes_); ++it)
+  {
+    if (Collides(*it))
+    {
+      next_deferred_.push_back(*it);
+    }
+    else
+    {
+      Place(*it, slice);
+      lanes_used += lane_count_[*it];
+    }
+  }
+
+  // carry over the candidates which were not visited because the slice filled up
+  next_deferred_.insert(next_deferred_.end(), it, deferred_.end());
+
+  while (!heap_.empty() && (lanes_used < num_lanes_))
+  {
+    std::pop_heap(heap_.begin(), heap_.end(), lower_priority);
+    Index const index = heap_.back();
+    heap_.pop_back();
+
+    if (Collides(index))
+    {
+      next_deferred_.push_back(index);
+    }
+    else
+    {
+      Place(index, slice);
+      lanes_used += lane_count_[index];
+    }
+  }
+
+  std::swap(deferred_, next_deferred_);
+}
+
+/**
+ * Remove all the packed transactions from the queue they were loaded from
+ *
+ * @param queue The queue which was previously loaded
+ * @return The number of transactions removed
+ */
+std::size_t SlicePacker::RemovePacked(Queue &queue)
+{
+  for (Index const index : packed_)
+  {
+    queue.Erase(layouts_[index]);
+  }
+
+  std::size_t const num_removed = packed_.size();
+  packed_.clear();
+
+  return num_removed;
+}
+
+/**
+ * Determine if candidate a should be packed before candidate b
+ *
+ * @param a The index of the first candidate
+ * @param b The index of the second candidate
+ * @return true if a has the higher priority, otherwise false
+ */
+bool SlicePacker::HasPriority(Index a, Index b) const
+{
+  if (charges_[a] != charges_[b])
+  {
+    return charges_[a] > charges_[b];
+  }
+
+  // preserve the queue order for equal fees
+  return a < b;
+}
+
+/**
+ * Determine if the lanes of a candidate intersect with the lanes of the current slice
+ *
+ * @param index The index of the candidate
+ * @return true if there is a collision, otherwise false
+ */
+bool SlicePacker::Collides(Index index) const
+{
+  Word const *mask = &masks_[index * words_per_mask_];
+
+  for (std::size_t i = 0; i < words_per_mask_; ++i)
+  {
+    if (mask[i] & slice_mask_[i])
+    {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+/**
+ * Add a candidate to the current slice
+ *
+ * @param index The index of the candidate
+ * @param slice The slice being populated
+ */
+void SlicePacker::Place(Index index, Slice &slice)
+{
+  Word const *mask = &masks_[index * words_per_mask_];
+
+  for (std::size_t i = 0; i < words_per_mask_; ++i)
+  {
+    slice_mask_[i] |= mask[i];
+  }
+
+  slice.push_back(*layouts_[index]);
+  packed_.push_back(index);
+}
+
+}  // namespace miner
+}  // namespace fetch
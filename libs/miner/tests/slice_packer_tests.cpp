@@ -0,0 +1,183 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/bitvector.hpp"
+#include "ledger/chain/block.hpp"
+#include "ledger/chain/transaction_layout.hpp"
+#include "meta/log2.hpp"
+#include "miner/slice_packer.hpp"
+#include "miner/transaction_layout_queue.hpp"
+#include "tx_generator.hpp"
+
+#include "gtest/gtest.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <random>
+#include <vector>
+
+namespace {
+
+using fetch::BitVector;
+using fetch::ledger::Block;
+using fetch::ledger::TransactionLayout;
+using fetch::miner::SlicePacker;
+using fetch::miner::TransactionLayoutQueue;
+
+using Slices = Block::Slices;
+
+/**
+ * The original list based greedy packing algorithm, used as a reference
+ */
+Slices ReferencePacking(TransactionLayoutQueue const &queue, std::size_t num_lanes,
+                        std::size_t num_slices)
+{
+  std::list<TransactionLayout> candidates(queue.begin(), queue.end());
+  candidates.sort([](auto const &a, auto const &b) { return a.charge() > b.charge(); });
+
+  Slices slices(num_slices);
+  for (auto &slice : slices)
+  {
+    BitVector slice_state{num_lanes};
+
+    for (auto it = candidates.begin(); it != candidates.end();)
+    {
+      if (slice_state.PopCount() == num_lanes)
+      {
+        break;
+      }
+
+      if ((slice_state & it->mask()).PopCount() == 0)
+      {
+        slice_state |= it->mask();
+        slice.push_back(*it);
+        it = candidates.erase(it);
+      }
+      else
+      {
+        ++it;
+      }
+    }
+  }
+
+  return slices;
+}
+
+class SlicePackerTests : public ::testing::TestWithParam<uint32_t>
+{
+protected:
+  static constexpr std::size_t NUM_SLICES  = 16;
+  static constexpr std::size_t RANDOM_SEED = 42;
+
+  void Populate(std::size_t num_transactions, uint32_t log2_num_lanes)
+  {
+    TransactionGenerator generator{log2_num_lanes};
+    generator.Seed(RANDOM_SEED);
+
+    std::mt19937_64                     rng{RANDOM_SEED};
+    std::poisson_distribution<uint32_t> num_resources(3.0);
+    std::uniform_int_distribution<int>  fee(0, 9);
+
+    for (std::size_t i = 0; i < num_transactions; ++i)
+    {
+      auto const layout = generator(num_resources(rng));
+
+      // use a small range of fees so that there are plenty of ties
+      queue_.Add(TransactionLayout{layout.digest(), layout.mask(),
+                                   static_cast<uint64_t>(fee(rng)), layout.valid_from(),
+                                   layout.valid_until()});
+    }
+  }
+
+  TransactionLayoutQueue queue_;
+};
+
+TEST_P(SlicePackerTests, MatchesReferencePacking)
+{
+  uint32_t const    log2_num_lanes = GetParam();
+  std::size_t const num_lanes      = 1u << log2_num_lanes;
+
+  Populate(2000, log2_num_lanes);
+
+  auto const expected = ReferencePacking(queue_, num_lanes, NUM_SLICES);
+
+  SlicePacker packer{num_lanes};
+  packer.Load(queue_);
+  EXPECT_EQ(2000u, packer.num_candidates());
+
+  Slices slices(NUM_SLICES);
+  for (auto &slice : slices)
+  {
+    packer.GenerateSlice(slice);
+  }
+
+  ASSERT_EQ(expected.size(), slices.size());
+  for (std::size_t i = 0; i < slices.size(); ++i)
+  {
+    ASSERT_EQ(expected[i].size(), slices[i].size()) << "slice " << i;
+
+    for (std::size_t j = 0; j < slices[i].size(); ++j)
+    {
+      EXPECT_EQ(expected[i][j].digest(), slices[i][j].digest()) << "slice " << i;
+    }
+  }
+}
+
+TEST_P(SlicePackerTests, PackedTransactionsAreRemovedFromTheQueue)
+{
+  uint32_t const    log2_num_lanes = GetParam();
+  std::size_t const num_lanes      = 1u << log2_num_lanes;
+
+  Populate(500, log2_num_lanes);
+
+  SlicePacker packer{num_lanes};
+  packer.Load(queue_);
+
+  std::size_t num_packed{0};
+  Slices      slices(NUM_SLICES);
+  for (auto &slice : slices)
+  {
+    packer.GenerateSlice(slice);
+    num_packed += slice.size();
+
+    // ensure there are no collisions within the slice
+    BitVector lanes{num_lanes};
+    for (auto const &tx : slice)
+    {
+      EXPECT_EQ(0u, (lanes & tx.mask()).PopCount());
+      lanes |= tx.mask();
+    }
+  }
+
+  EXPECT_EQ(num_packed, packer.num_packed());
+  EXPECT_EQ(num_packed, packer.RemovePacked(queue_));
+  EXPECT_EQ(500u - num_packed, queue_.size());
+
+  for (auto const &slice : slices)
+  {
+    for (auto const &tx : slice)
+    {
+      EXPECT_EQ(queue_.digests().end(), queue_.digests().find(tx.digest()));
+    }
+  }
+}
+
+INSTANTIATE_TEST_CASE_P(ParamBased, SlicePackerTests, ::testing::Values(0u, 1u, 4u, 6u, 7u, 9u), );
+
+}  // namespace
@@ -25,9 +25,34 @@
 
 #include "benchmark/benchmark.h"
 
+#include <sys/resource.h>
+
+#include <chrono>
 #include <memory>
 #include <string>
 
+namespace {
+
+/**
+ * The high water mark of the resident set size of the process. Since this never goes down,
+ * run a single benchmark per process (--benchmark_filter) to attribute it to that benchmark.
+ */
+double PeakRssMegabytes()
+{
+  struct rusage usage
+  {
+  };
+  getrusage(RUSAGE_SELF, &usage);
+
+#ifdef __APPLE__
+  return static_cast<double>(usage.ru_maxrss) / (1024.0 * 1024.0);  // bytes
+#else
+  return static_cast<double>(usage.ru_maxrss) / 1024.0;  // kilobytes
+#endif
+}
+
+}  // namespace
+
 template <typename T, fetch::math::SizeType B, fetch::math::SizeType I, fetch::math::SizeType H,
           fetch::math::SizeType O, fetch::math::SizeType E>
 void BM_Setup_And_Train(benchmark::State &state)
@@ -50,6 +75,9 @@ void BM_Setup_And_Train(benchmark::State &state)
   data.FillUniformRandom();
   gt.FillUniformRandom();
 
+  SizeType                      n_steps = 0;
+  std::chrono::duration<double> step_time{0};
+
   for (auto _ : state)
   {
     // make a graph
@@ -77,9 +105,15 @@ void BM_Setup_And_Train(benchmark::State &state)
     // Do optimisation
     for (SizeType i = 0; i < n_epochs; ++i)
     {
+      auto const start = std::chrono::steady_clock::now();
       optimiser.Run({data}, gt);
+      step_time += std::chrono::steady_clock::now() - start;
+      ++n_steps;
     }
   }
+
+  state.counters["step_ms"]     = 1000.0 * step_time.count() / static_cast<double>(n_steps);
+  state.counters["peak_rss_mb"] = PeakRssMegabytes();
 }
 
 BENCHMARK_TEMPLATE(BM_Setup_And_Train, float, 1, 1, 1, 1, 100)->Unit(benchmark::kMillisecond);
@@ -89,4 +123,43 @@ BENCHMARK_TEMPLATE(BM_Setup_And_Train, float, 100, 100, 100, 100, 100)
 BENCHMARK_TEMPLATE(BM_Setup_And_Train, float, 100, 1000, 1000, 1000, 100)
     ->Unit(benchmark::kMillisecond);
 
+template <typename T, fetch::math::SizeType B, fetch::math::SizeType H, fetch::math::SizeType L>
+void BM_Inference(benchmark::State &state)
+{
+  using SizeType   = fetch::math::SizeType;
+  using DataType   = T;
+  using TensorType = fetch::math::Tensor<DataType>;
+
+  SizeType batch_size  = B;
+  SizeType hidden_size = H;
+  SizeType n_layers    = L;
+
+  TensorType data({hidden_size, batch_size});
+  data.FillUniformRandom();
+
+  // a stack of fully connected layers, each followed by an activation
+  fetch::ml::Graph<TensorType> g;
+
+  std::string input_name  = g.template AddNode<fetch::ml::ops::PlaceHolder<TensorType>>("", {});
+  std::string output_name = input_name;
+  for (SizeType i = 0; i < n_layers; ++i)
+  {
+    std::string h = g.template AddNode<fetch::ml::layers::FullyConnected<TensorType>>(
+        "", {output_name}, hidden_size, hidden_size);
+    output_name = g.template AddNode<fetch::ml::ops::Relu<TensorType>>("", {h});
+  }
+
+  for (auto _ : state)
+  {
+    g.SetInput(input_name, data);
+    benchmark::DoNotOptimize(g.Evaluate(output_name, false));
+  }
+
+  state.counters["peak_rss_mb"] = PeakRssMegabytes();
+}
+
+BENCHMARK_TEMPLATE(BM_Inference, float, 100, 1000, 2)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_Inference, float, 100, 1000, 16)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_Inference, float, 1000, 1000, 16)->Unit(benchmark::kMillisecond);
+
 BENCHMARK_MAIN();
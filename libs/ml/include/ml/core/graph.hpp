@@ -18,6 +18,7 @@
 //------------------------------------------------------------------------------
 
 #include "ml/core/node.hpp"
+#include "ml/core/tensor_arena.hpp"
 #include "ml/meta/ml_type_traits.hpp"
 #include "ml/ops/weights.hpp"
 
@@ -28,6 +29,7 @@
 #include <stdexcept>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
@@ -142,13 +144,28 @@ protected:
   std::vector<std::pair<std::string, std::vector<std::string>>> connections_;
   std::unordered_map<std::string, SizeType>                     trainable_lookup_;
   std::vector<NodePtrType>                                      trainable_nodes_;
+  TensorArena<TensorType>                                       arena_;
 
   void       InsertSharedCopy(std::shared_ptr<Graph<TensorType>> output_ptr);
   TensorType ForwardPropagate(std::string const &node_name, bool is_training = true);
+  TensorType ExecutePlan(std::string const &node_name, bool is_training);
+  std::vector<std::pair<Node<TensorType> *, TensorType>> BackPropagatePlan(
+      std::string const &node_name, TensorType const &error_signal);
 
 private:
+  /**
+   * The nodes needed to evaluate one target, ordered so that every node comes after its inputs
+   */
+  struct ExecutionPlan
+  {
+    std::vector<NodePtrType>           nodes;
+    std::vector<std::vector<SizeType>> inputs;  ///< The plan index of every input of every node
+  };
+
   GraphState graph_state_ = GraphState::NOT_COMPILED;
 
+  std::unordered_map<std::string, ExecutionPlan> execution_plans_;
+
   friend class optimisers::Optimiser<TensorType>;
   friend class model::ModelInterface<TensorType>;
   friend class distributed_learning::TrainingClient<TensorType>;
@@ -167,6 +184,8 @@ private:
       std::string const &node_name, std::string &updated_name);
 
   void ResetGraphCache(bool input_size_changed, std::shared_ptr<Node<T>> n = {});
+
+  ExecutionPlan const &GetExecutionPlan(std::string const &node_name);
 };
 
 //////////////////////
@@ -227,11 +246,13 @@ void Graph<TensorType>::ResetCompile()
     // remove inputs and output from the node
     nodes_.at(node_name)->ResetInputsAndOutputs();
   }
+  execution_plans_.clear();
   graph_state_ = GraphState::NOT_COMPILED;
 }
 
 /**
- * Links Node inputs and sets up the trainables object ready for use by an optimiser
+ * Links Node inputs and sets up the trainables object ready for use by an optimiser.
+ * The execution plan for each evaluated node is derived from these links on first use.
  * @tparam TensorType
  */
 template <typename TensorType>
@@ -319,7 +340,7 @@ TensorType Graph<TensorType>::Evaluate(std::string const &node_name, bool is_tra
 
   if (nodes_.find(node_name) != nodes_.end())
   {
-    return (*(nodes_[node_name]->Evaluate(is_training))).Copy();
+    return ExecutePlan(node_name, is_training).Copy();
   }
   else
   {
@@ -340,7 +361,7 @@ TensorType Graph<TensorType>::ForwardPropagate(std::string const &node_name, boo
 
   if (nodes_.find(node_name) != nodes_.end())
   {
-    return (*(nodes_[node_name]->Evaluate(is_training)));
+    return ExecutePlan(node_name, is_training);
   }
   else
   {
@@ -368,7 +389,7 @@ void Graph<TensorType>::BackPropagate(std::string const &node_name, TensorType c
       ForwardPropagate(node_name);
     }
 
-    nodes_[node_name]->BackPropagate(error_signal);
+    BackPropagatePlan(node_name, error_signal);
   }
   else
   {
@@ -380,6 +401,127 @@ void Graph<TensorType>::BackPropagate(std::string const &node_name, TensorType c
 /// PROTECTED METHODS ///
 /////////////////////////
 
+/**
+ * Runs the execution plan of a node, evaluating only those nodes whose cached output is stale.
+ * When not training nothing is needed for a backward pass, so every intermediate output is
+ * handed back to the arena as soon as its last consumer has run, and later nodes reuse it.
+ * @param node_name name of node to evaluate for output
+ * @param is_training whether the ops should run in training mode
+ * @return a shallow copy of the output tensor
+ */
+template <typename TensorType>
+TensorType Graph<TensorType>::ExecutePlan(std::string const &node_name, bool is_training)
+{
+  ExecutionPlan const &plan   = GetExecutionPlan(node_name);
+  SizeType const       target = plan.nodes.size() - 1;
+
+  // walk back from the target to find the stale nodes and the last node that reads each output
+  std::vector<bool>     pending(plan.nodes.size(), false);
+  std::vector<SizeType> last_use(plan.nodes.size(), 0);
+  pending[target] = !plan.nodes[target]->HasValidCache();
+
+  for (SizeType i = target + 1; i-- > 0;)
+  {
+    if (pending[i])
+    {
+      for (SizeType input : plan.inputs[i])
+      {
+        pending[input]  = pending[input] || !plan.nodes[input]->HasValidCache();
+        last_use[input] = std::max(last_use[input], i);
+      }
+    }
+  }
+
+  for (SizeType i = 0; i <= target; ++i)
+  {
+    if (!pending[i])
+    {
+      continue;
+    }
+
+    plan.nodes[i]->Evaluate(is_training, &arena_);
+
+    if (!is_training)
+    {
+      for (SizeType input : plan.inputs[i])
+      {
+        if (last_use[input] == i)
+        {
+          plan.nodes[input]->ReleaseOutput(arena_);
+        }
+      }
+    }
+  }
+
+  return *(plan.nodes[target]->Evaluate(is_training, &arena_));
+}
+
+/**
+ * Backpropagates an error signal through the execution plan of a node in reverse order.
+ * Each node runs its backward pass once with the sum of the error signals from all of its
+ * consumers, and those signals are dropped as soon as they have been used.
+ * @param node_name name of node from which to begin backprop
+ * @param error_signal the error signal arriving at the output of the node
+ * @return the error signals of the nodes without inputs, which the graph cannot propagate further
+ */
+template <typename TensorType>
+std::vector<std::pair<Node<TensorType> *, TensorType>> Graph<TensorType>::BackPropagatePlan(
+    std::string const &node_name, TensorType const &error_signal)
+{
+  ExecutionPlan const &plan   = GetExecutionPlan(node_name);
+  SizeType const       target = plan.nodes.size() - 1;
+
+  std::vector<TensorType> signals(plan.nodes.size());
+  std::vector<bool>       has_signal(plan.nodes.size(), false);
+  signals[target]    = error_signal;
+  has_signal[target] = true;
+
+  std::vector<std::pair<Node<TensorType> *, TensorType>> non_back_propagated_error_signals;
+
+  for (SizeType i = target + 1; i-- > 0;)
+  {
+    if (!has_signal[i])
+    {
+      continue;
+    }
+
+    std::vector<TensorType> back_propagated_error_signals = plan.nodes[i]->Backward(signals[i]);
+    signals[i]                                            = TensorType{};
+
+    // If no input to backprop to, return gradient to caller
+    if (plan.inputs[i].empty())
+    {
+      for (auto &g : back_propagated_error_signals)
+      {
+        non_back_propagated_error_signals.emplace_back(plan.nodes[i].get(), std::move(g));
+      }
+      continue;
+    }
+
+    auto bp_it = back_propagated_error_signals.begin();
+    for (SizeType input : plan.inputs[i])
+    {
+      if (!has_signal[input])
+      {
+        signals[input]    = std::move(*bp_it);
+        has_signal[input] = true;
+      }
+      else if (signals[input].data().IsUnique())
+      {
+        signals[input].InlineAdd(*bp_it);
+      }
+      else
+      {
+        // the accumulated signal is still shared with an op, so sum into a new buffer
+        signals[input] = fetch::math::Add(signals[input], *bp_it);
+      }
+      ++bp_it;
+    }
+  }
+
+  return non_back_propagated_error_signals;
+}
+
 ///////////////////////
 /// PRIVATE METHODS ///
 ///////////////////////
@@ -465,6 +607,7 @@ bool Graph<T>::InsertNode(std::string const &node_name, NodePtrType node_ptr)
 {
   // put node in look up table
   nodes_[node_name] = node_ptr;
+  execution_plans_.clear();
   return nodes_.find(node_name) != nodes_.end();
 }
 
@@ -508,6 +651,7 @@ void Graph<TensorType>::SetGraphSaveableParams(GraphSaveableParams<TensorType> c
     LinkNodesInGraph(node.first, node.second);
   }
 
+  execution_plans_.clear();
   graph_state_ = static_cast<GraphState>(sp.graph_state);
 }
 
@@ -537,6 +681,11 @@ void Graph<TensorType>::SetInput(std::string const &node_name, TensorType data)
   if (placeholder)
   {
     bool input_size_changed = placeholder->SetData(data);
+    if (input_size_changed)
+    {
+      // buffers sized for the previous input are unlikely to fit again
+      arena_.Clear();
+    }
     ResetGraphCache(input_size_changed, nodes_[node_name]);
   }
   else
@@ -740,6 +889,68 @@ void Graph<T>::AddGradients(std::vector<TensorType> grads)
   }
 }
 
+/**
+ * Returns the execution plan of a node, building it from the node links on first use.
+ * The plan holds every ancestor of the node in topological order, followed by the node itself.
+ * @tparam TensorType
+ * @param node_name name of the node to be evaluated
+ * @return the cached execution plan
+ */
+template <typename TensorType>
+typename Graph<TensorType>::ExecutionPlan const &Graph<TensorType>::GetExecutionPlan(
+    std::string const &node_name)
+{
+  auto it = execution_plans_.find(node_name);
+  if (it != execution_plans_.end())
+  {
+    return it->second;
+  }
+
+  ExecutionPlan                                         plan;
+  std::unordered_map<Node<TensorType> const *, SizeType> plan_index;
+
+  // iterative depth first search, placing each node once all of its inputs have been placed
+  std::vector<std::pair<NodePtrType, SizeType>> stack;
+  std::unordered_set<Node<TensorType> const *>  visited;
+  stack.emplace_back(nodes_.at(node_name), 0);
+  visited.insert(stack.back().first.get());
+
+  while (!stack.empty())
+  {
+    NodePtrType node       = stack.back().first;
+    SizeType &  next_input = stack.back().second;
+    auto const &inputs     = node->GetInputs();
+
+    if (next_input < inputs.size())
+    {
+      NodePtrType input = inputs[next_input];
+      ++next_input;
+
+      if (visited.insert(input.get()).second)
+      {
+        stack.emplace_back(input, 0);
+      }
+      continue;
+    }
+
+    plan_index[node.get()] = plan.nodes.size();
+    plan.nodes.emplace_back(node);
+    stack.pop_back();
+  }
+
+  for (auto const &node : plan.nodes)
+  {
+    std::vector<SizeType> inputs;
+    for (auto const &input : node->GetInputs())
+    {
+      inputs.emplace_back(plan_index.at(input.get()));
+    }
+    plan.inputs.emplace_back(std::move(inputs));
+  }
+
+  return execution_plans_.emplace(node_name, std::move(plan)).first->second;
+}
+
 /**
  * Connect the new node to the current graph by setting input and output nodes to it and saving it
  * in the lookup table. Can also be used by ResetCompile to unlink previously linked nodes
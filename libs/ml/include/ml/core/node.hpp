@@ -18,6 +18,7 @@
 //------------------------------------------------------------------------------
 
 #include "core/logging.hpp"
+#include "ml/core/tensor_arena.hpp"
 #include "ml/ops/ops.hpp"
 #include "ml/saveparams/saveable_params.hpp"
 
@@ -109,10 +110,15 @@ public:
   ///////////////////////////////////
 
   VecTensorType                                 GatherInputs() const;
-  std::shared_ptr<T>                            Evaluate(bool is_training);
+  std::shared_ptr<T>                            Evaluate(bool            is_training,
+                                                         TensorArena<T> *arena = nullptr);
+  bool                                          ReleaseOutput(TensorArena<T> &arena);
+  void                                          ClearOutput();
+  std::vector<TensorType>                       Backward(TensorType const &error_signal);
   std::vector<std::pair<Node<T> *, TensorType>> BackPropagate(TensorType const &error_signal);
 
   void                            AddInput(NodePtrType const &i);
+  std::vector<NodePtrType> const &GetInputs() const;
   std::vector<std::string>        GetInputNames();
   void                            AddOutput(NodePtrType const &o);
   std::vector<NodePtrType> const &GetOutputs() const;
@@ -199,10 +205,11 @@ typename Node<T>::VecTensorType Node<T>::GatherInputs() const
  * recalculated as necessary
  * @tparam T tensor type
  * @tparam O operation class
+ * @param arena optional pool from which a resized output buffer is taken
  * @return the tensor with the forward result
  */
 template <typename T>
-std::shared_ptr<T> Node<T>::Evaluate(bool is_training)
+std::shared_ptr<T> Node<T>::Evaluate(bool is_training, TensorArena<T> *arena)
 {
   op_ptr_->SetTraining(is_training);
 
@@ -214,10 +221,19 @@ std::shared_ptr<T> Node<T>::Evaluate(bool is_training)
     {
       auto output_shape = op_ptr_->ComputeOutputShape(inputs);
 
-      if (cached_output_.shape() !=
-          output_shape)  // make shape compatible right before we do the forwarding
+      // nodes without inputs hand out their op's own data, so need no buffer of their own
+      if (!input_nodes_.empty() &&
+          cached_output_.shape() !=
+              output_shape)  // make shape compatible right before we do the forwarding
       {
-        cached_output_.Reshape(output_shape);
+        if (arena)
+        {
+          cached_output_ = arena->Acquire(output_shape);
+        }
+        else
+        {
+          cached_output_.Reshape(output_shape);
+        }
       }
     }
     op_ptr_->Forward(inputs, cached_output_);
@@ -227,6 +243,59 @@ std::shared_ptr<T> Node<T>::Evaluate(bool is_training)
   return std::make_shared<T>(cached_output_);
 }
 
+/**
+ * Hands the cached output buffer back to the arena once no downstream node needs it any more.
+ * Nodes without inputs (placeholders, weights) own their data and are never released, nor is
+ * an output which is still shared with something outside of this node.
+ * @tparam T tensor type
+ * @param arena the pool which takes over the buffer
+ * @return true if the buffer was released
+ */
+template <typename T>
+bool Node<T>::ReleaseOutput(TensorArena<T> &arena)
+{
+  if (input_nodes_.empty() || (cached_output_status_ != CachedOutputState::VALID_CACHE))
+  {
+    return false;
+  }
+
+  if (!arena.Release(cached_output_))
+  {
+    return false;
+  }
+
+  cached_output_status_ = CachedOutputState::CHANGED_SIZE;
+  return true;
+}
+
+/**
+ * Drops the cached output without recycling it, e.g. when its buffer is shared with a node of
+ * another graph which is left as the only owner
+ * @tparam T tensor type
+ */
+template <typename T>
+void Node<T>::ClearOutput()
+{
+  cached_output_        = TensorType{};
+  cached_output_status_ = CachedOutputState::CHANGED_SIZE;
+}
+
+/**
+ * Runs the backward pass of this node's operation only, without recursing into the inputs
+ * @tparam T the tensor type
+ * @param error_signal the error signal arriving at the output of this node
+ * @return one error signal per input node (or the op's own signals for nodes without inputs)
+ */
+template <typename T>
+std::vector<T> Node<T>::Backward(TensorType const &error_signal)
+{
+  VecTensorType           inputs                        = GatherInputs();
+  std::vector<TensorType> back_propagated_error_signals = op_ptr_->Backward(inputs, error_signal);
+  assert(back_propagated_error_signals.size() == inputs.size() || inputs.empty());
+
+  return back_propagated_error_signals;
+}
+
 /**
  * Recursively backpropagates errorsignal through this node to all input nodes
  * @tparam T the tensor type
@@ -237,10 +306,8 @@ std::shared_ptr<T> Node<T>::Evaluate(bool is_training)
 template <typename T>
 std::vector<std::pair<Node<T> *, T>> Node<T>::BackPropagate(TensorType const &error_signal)
 {
-  VecTensorType           inputs                        = GatherInputs();
-  std::vector<TensorType> back_propagated_error_signals = op_ptr_->Backward(inputs, error_signal);
+  std::vector<TensorType> back_propagated_error_signals = Backward(error_signal);
   std::vector<std::pair<Node<T> *, TensorType>> non_back_propagated_error_signals;
-  assert(back_propagated_error_signals.size() == inputs.size() || inputs.empty());
 
   auto bp_it = back_propagated_error_signals.begin();
   for (auto &i : input_nodes_)
@@ -288,6 +355,17 @@ void Node<T>::AddInput(NodePtrType const &i)
   input_nodes_.push_back(i);
 }
 
+/**
+ * gets all registered inputs of this node
+ * @tparam T tensor type
+ * @return vector of pointers to input nodes
+ */
+template <typename T>
+std::vector<typename Node<T>::NodePtrType> const &Node<T>::GetInputs() const
+{
+  return input_nodes_;
+}
+
 /**
  * registers a node as an input to this node
  * @tparam T tensor type
@@ -107,6 +107,9 @@ protected:
 private:
   std::vector<std::string> input_node_names_;
   std::string              output_node_name_;
+  bool                     boundary_released_ = false;
+
+  void ReleaseBoundary();
 };
 
 /**
@@ -124,17 +127,39 @@ void SubGraph<T>::Forward(VecTensorType const &inputs, TensorType &output)
   {
     this->SetInput(input_node_names_[i], *(inputs.at(i)));
   }
-  output = *(this->nodes_[output_node_name_]->Evaluate(this->is_training_));
+  boundary_released_ = false;
+
+  if (!this->is_training_)
+  {
+    // the buffer prepared by the caller is replaced below, so let the output node have it
+    this->arena_.Release(output);
+  }
+
+  output = this->ExecutePlan(output_node_name_, this->is_training_);
+
+  if (!this->is_training_)
+  {
+    ReleaseBoundary();
+  }
 }
 
 template <typename T>
 std::vector<T> SubGraph<T>::Backward(VecTensorType const &inputs, TensorType const &error_signal)
 {
   assert(inputs.size() == this->input_node_names_.size());
-  FETCH_UNUSED(inputs);
+
+  if (boundary_released_)
+  {
+    // the inputs were let go after an inference pass, so bind them again
+    for (uint64_t i(0); i < inputs.size(); ++i)
+    {
+      this->SetInput(input_node_names_[i], *(inputs.at(i)));
+    }
+    boundary_released_ = false;
+  }
 
   std::vector<std::pair<Node<T> *, TensorType>> non_back_prop_err_signal =
-      this->nodes_[output_node_name_]->BackPropagate(error_signal);
+      this->BackPropagatePlan(output_node_name_, error_signal);
   std::vector<TensorType> back_prop_err_signal;
 
   // aggregate the error to each input, if there are more than one error signal for one input
@@ -164,6 +189,29 @@ std::vector<T> SubGraph<T>::Backward(VecTensorType const &inputs, TensorType con
   return back_prop_err_signal;
 }
 
+/**
+ * Nothing is kept for a backward pass after an inference pass, so let go of the data bound to the
+ * input placeholders and of the output buffer. The wrapping graph is then the only owner of both
+ * and can recycle them.
+ * @tparam T
+ */
+template <typename T>
+void SubGraph<T>::ReleaseBoundary()
+{
+  for (auto const &input_node_name : input_node_names_)
+  {
+    auto node        = this->nodes_.at(input_node_name);
+    auto placeholder = std::dynamic_pointer_cast<ops::PlaceHolder<T>>(node->GetOp());
+    assert(placeholder);
+
+    placeholder->ReleaseData();
+    node->ClearOutput();
+  }
+
+  this->nodes_.at(output_node_name_)->ClearOutput();
+  boundary_released_ = true;
+}
+
 template <typename T>
 void SubGraph<T>::AddInputNode(std::string const &node_name)
 {
@@ -0,0 +1,123 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include <cstddef>
+#include <map>
+#include <utility>
+#include <vector>
+
+namespace fetch {
+namespace ml {
+
+/**
+ * A pool of tensor buffers which are no longer referenced by the graph. Buffers are keyed by
+ * their exact shape so that a node whose output shape matches a released buffer can take it over
+ * instead of allocating a fresh one.
+ * @tparam T the tensor type
+ */
+template <typename T>
+class TensorArena
+{
+public:
+  using TensorType = T;
+  using SizeType   = typename TensorType::SizeType;
+  using SizeVector = typename TensorType::SizeVector;
+
+  TensorType Acquire(SizeVector const &shape);
+  bool       Release(TensorType &tensor);
+  void       Clear();
+
+  SizeType num_buffers() const
+  {
+    return num_buffers_;
+  }
+
+  SizeType num_elements() const
+  {
+    return num_elements_;
+  }
+
+private:
+  std::map<SizeVector, std::vector<TensorType>> free_buffers_;
+  SizeType                                      num_buffers_{0};
+  SizeType                                      num_elements_{0};
+};
+
+/**
+ * Returns a tensor of the requested shape, recycling a released buffer when one is available.
+ * The contents of a recycled buffer are left as they were.
+ * @param shape the shape of the tensor required
+ * @return a tensor which is not referenced anywhere else
+ */
+template <typename T>
+T TensorArena<T>::Acquire(SizeVector const &shape)
+{
+  auto it = free_buffers_.find(shape);
+  if (it == free_buffers_.end() || it->second.empty())
+  {
+    return TensorType(shape);
+  }
+
+  TensorType tensor = std::move(it->second.back());
+  it->second.pop_back();
+
+  --num_buffers_;
+  num_elements_ -= tensor.size();
+
+  return tensor;
+}
+
+/**
+ * Hands a buffer back to the arena, leaving the caller with an empty tensor. Only buffers with no
+ * other owner are pooled, since anything still sharing the storage would otherwise see it
+ * overwritten.
+ * @param tensor the tensor to release
+ * @return true if the buffer was added to the pool
+ */
+template <typename T>
+bool TensorArena<T>::Release(TensorType &tensor)
+{
+  if ((tensor.size() == 0) || !tensor.data().IsUnique())
+  {
+    return false;
+  }
+
+  num_elements_ += tensor.size();
+  ++num_buffers_;
+
+  auto shape = tensor.shape();
+  free_buffers_[shape].emplace_back(std::move(tensor));
+  tensor = TensorType{};
+
+  return true;
+}
+
+/**
+ * Drops every pooled buffer
+ */
+template <typename T>
+void TensorArena<T>::Clear()
+{
+  free_buffers_.clear();
+  num_buffers_  = 0;
+  num_elements_ = 0;
+}
+
+}  // namespace ml
+}  // namespace fetch
@@ -99,10 +99,27 @@ public:
     {
       shape_changed = (output_->shape() != data.shape());
     }
+    else if (!released_shape_.empty())
+    {
+      shape_changed = (released_shape_ != data.shape());
+    }
     output_ = std::make_shared<TensorType>(data);
     return shape_changed;
   }
 
+  /**
+   * Drops the reference to the data once nothing downstream needs it any more. The shape is
+   * remembered so that binding data of the same shape again does not count as a resize.
+   */
+  void ReleaseData()
+  {
+    if (output_)
+    {
+      released_shape_ = output_->shape();
+      output_.reset();
+    }
+  }
+
   std::vector<SizeType> ComputeOutputShape(VecTensorType const &inputs) const override
   {
     FETCH_UNUSED(inputs);
@@ -119,6 +136,9 @@ public:
 
 protected:
   ArrayPtrType output_;
+
+private:
+  std::vector<SizeType> released_shape_;
 };
 
 }  // namespace ops
@@ -21,6 +21,7 @@
 #include "ml/layers/convolution_1d.hpp"
 #include "ml/layers/fully_connected.hpp"
 #include "ml/ops/activations/relu.hpp"
+#include "ml/ops/add.hpp"
 #include "ml/ops/multiply.hpp"
 #include "ml/ops/placeholder.hpp"
 #include "ml/ops/subtract.hpp"
@@ -415,3 +416,72 @@ TYPED_TEST(GraphTest, diamond_graph_getStateDict)
   ASSERT_NE(sd.dict_["Diamond_Weight2"].weights_, nullptr);
   EXPECT_EQ(sd.dict_["Diamond_Weight2"].weights_->shape(), data2.shape());
 }
+
+TYPED_TEST(GraphTest, inference_reuses_released_buffers)
+{
+  using TensorType = TypeParam;
+  using SizeType   = typename TypeParam::SizeType;
+
+  fetch::ml::Graph<TensorType> g;
+
+  g.template AddNode<fetch::ml::ops::PlaceHolder<TensorType>>("Input", {});
+  g.template AddNode<fetch::ml::layers::FullyConnected<TensorType>>("FC1", {"Input"}, 4u, 4u);
+  g.template AddNode<fetch::ml::ops::Relu<TensorType>>("Relu", {"FC1"});
+  g.template AddNode<fetch::ml::layers::FullyConnected<TensorType>>("FC2", {"Relu"}, 4u, 4u);
+  g.template AddNode<fetch::ml::ops::Add<TensorType>>("Residual", {"FC2", "Relu"});
+  g.template AddNode<fetch::ml::ops::Relu<TensorType>>("Output", {"Residual"});
+
+  TensorType data(std::vector<SizeType>({4, 8}));
+  data.FillUniformRandom();
+  g.SetInput("Input", data);
+
+  TensorType relu   = g.Evaluate("Relu", true);
+  TensorType output = g.Evaluate("Output", true);
+
+  // evaluating in inference mode releases the intermediate outputs along the way
+  g.SetInput("Input", data);
+  EXPECT_TRUE(g.Evaluate("Output", false) == output);
+  EXPECT_TRUE(g.Evaluate("Relu", false) == relu);
+
+  // a second pass recycles the released buffers
+  TensorType data2(std::vector<SizeType>({4, 8}));
+  data2.FillUniformRandom();
+  g.SetInput("Input", data2);
+  TensorType inference = g.Evaluate("Output", false);
+
+  g.SetInput("Input", data2);
+  EXPECT_TRUE(g.Evaluate("Output", true) == inference);
+}
+
+TYPED_TEST(GraphTest, residual_graph_backward_matches_recursive_backward)
+{
+  using DataType   = typename TypeParam::Type;
+  using TensorType = TypeParam;
+
+  TensorType data         = TensorType::FromString(R"(-1,0,1,2,3,4)");
+  TensorType error_signal = TensorType::FromString(R"(-0.5,0,0.5,1,1.5,2)");
+
+  // every level feeds its output to both inputs of the next, so the gradient doubles per level
+  fetch::ml::Graph<TensorType> g;
+  std::string name = g.template AddNode<fetch::ml::ops::Weights<TensorType>>("Weights", {});
+  for (std::size_t i = 0; i < 8; ++i)
+  {
+    name = g.template AddNode<fetch::ml::ops::Add<TensorType>>("", {name, name});
+  }
+
+  g.SetInput("Weights", data);
+  g.Evaluate(name);
+  g.BackPropagate(name, error_signal);
+  TensorType gradient = g.GetGradients().at(0).Copy();
+
+  TensorType expected = error_signal * DataType{256};
+  ASSERT_TRUE(gradient.AllClose(expected, fetch::math::function_tolerance<DataType>(),
+                                fetch::math::function_tolerance<DataType>()));
+
+  // the recursive traversal revisits the shared inputs once per path but must agree
+  g.ResetGradients();
+  g.GetNode(name)->BackPropagate(error_signal);
+  ASSERT_TRUE(g.GetGradients().at(0).AllClose(gradient,
+                                              fetch::math::function_tolerance<DataType>(),
+                                              fetch::math::function_tolerance<DataType>()));
+}
@@ -0,0 +1,240 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/byte_array/const_byte_array.hpp"
+#include "crypto/ecdsa.hpp"
+#include "network/details/thread_pool.hpp"
+#include "network/management/network_manager.hpp"
+#include "network/muddle/muddle.hpp"
+#include "network/muddle/rpc/client.hpp"
+#include "network/muddle/rpc/server.hpp"
+#include "network/peer.hpp"
+#include "network/service/protocol.hpp"
+#include "network/uri.hpp"
+
+#include "benchmark/benchmark.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using fetch::byte_array::ConstByteArray;
+using fetch::crypto::ECDSASigner;
+using fetch::muddle::Muddle;
+using fetch::muddle::NetworkId;
+using fetch::network::MakeThreadPool;
+using fetch::network::NetworkManager;
+using fetch::network::Peer;
+using fetch::network::ThreadPool;
+using fetch::network::Uri;
+using fetch::service::Promise;
+using fetch::service::Protocol;
+
+using Clock     = std::chrono::steady_clock;
+using Timepoint = Clock::time_point;
+using RpcClient = fetch::muddle::rpc::Client;
+using RpcServer = fetch::muddle::rpc::Server;
+
+constexpr uint16_t SERVICE   = 10;
+constexpr uint16_t CHANNEL   = 12;
+constexpr uint64_t PROTOCOL  = 1;
+constexpr uint16_t BASE_PORT = 8130;
+
+class EchoProtocol : public Protocol
+{
+public:
+  enum
+  {
+    EXCHANGE = 1
+  };
+
+  EchoProtocol()
+  {
+    Expose(EXCHANGE, this, &EchoProtocol::Echo);
+  }
+
+private:
+  ConstByteArray Echo(ConstByteArray const &value)
+  {
+    return value;
+  }
+};
+
+/**
+ * A pair of muddles connected over the loopback interface, one serving the echo protocol and the
+ * other making calls to it
+ */
+class Loopback
+{
+public:
+  Loopback(uint16_t port, std::size_t executor_threads)
+    : server_muddle_{NetworkId{"RPCB"}, std::make_shared<ECDSASigner>(), network_manager_}
+    , client_muddle_{NetworkId{"RPCB"}, std::make_shared<ECDSASigner>(), network_manager_}
+    , server_{server_muddle_.AsEndpoint(), SERVICE, CHANNEL}
+  {
+    if (executor_threads > 0)
+    {
+      executor_ = MakeThreadPool(executor_threads, "RpcBench");
+      executor_->Start();
+    }
+
+    client_ = std::make_unique<RpcClient>("RpcBench", client_muddle_.AsEndpoint(), SERVICE,
+                                          CHANNEL, executor_);
+    server_.Add(PROTOCOL, &protocol_);
+
+    network_manager_.Start();
+    server_muddle_.Start({port});
+    client_muddle_.Start({static_cast<uint16_t>(port + 1)}, {Uri{Peer{"127.0.0.1", port}}});
+
+    while (!client_muddle_.IsConnected(address()))
+    {
+      std::this_thread::sleep_for(std::chrono::milliseconds{10});
+    }
+  }
+
+  ~Loopback()
+  {
+    client_.reset();
+
+    if (executor_)
+    {
+      executor_->Stop();
+    }
+
+    client_muddle_.Stop();
+    server_muddle_.Stop();
+    network_manager_.Stop();
+  }
+
+  Muddle::Address const &address() const
+  {
+    return server_muddle_.identity().identifier();
+  }
+
+  RpcClient &client()
+  {
+    return *client_;
+  }
+
+private:
+  NetworkManager             network_manager_{"RpcBench", 2};
+  Muddle                     server_muddle_;
+  Muddle                     client_muddle_;
+  EchoProtocol               protocol_;
+  RpcServer                  server_;
+  ThreadPool                 executor_;
+  std::unique_ptr<RpcClient> client_;
+};
+
+double Percentile(std::vector<double> &samples, double fraction)
+{
+  if (samples.empty())
+  {
+    return 0.0;
+  }
+
+  auto const index = static_cast<std::size_t>(fraction * static_cast<double>(samples.size() - 1));
+  std::nth_element(samples.begin(), samples.begin() + static_cast<std::ptrdiff_t>(index),
+                   samples.end());
+
+  return samples[index];
+}
+
+/**
+ * Measure the round trip time of RPC calls between two muddles over loopback. Each iteration
+ * issues a window of concurrent calls and waits for all of them to complete.
+ *
+ * Args: {executor threads (0 = complete on the network thread), calls in flight}
+ */
+void Muddle_Rpc_RoundTrip(benchmark::State &state)
+{
+  static uint16_t next_port{BASE_PORT};
+
+  auto const executor_threads = static_cast<std::size_t>(state.range(0));
+  auto const window           = static_cast<std::size_t>(state.range(1));
+
+  Loopback loopback{next_port, executor_threads};
+  next_port = static_cast<uint16_t>(next_port + 2);
+
+  ConstByteArray const payload{std::string(64, 'x')};
+
+  std::vector<Promise>     promises(window);
+  std::vector<Timepoint>   started(window);
+  std::vector<Timepoint>   completed(window);
+  std::vector<double>      latencies{};
+  std::atomic<std::size_t> num_completed{0};
+
+  for (auto _ : state)
+  {
+    num_completed = 0;
+
+    for (std::size_t i = 0; i < window; ++i)
+    {
+      started[i]  = Clock::now();
+      promises[i] = loopback.client().CallSpecificAddress(loopback.address(), PROTOCOL,
+                                                          EchoProtocol::EXCHANGE, payload);
+      promises[i]->WithHandlers().Then([&completed, &num_completed, i]() {
+        completed[i] = Clock::now();
+        ++num_completed;
+      });
+    }
+
+    for (std::size_t i = 0; i < window; ++i)
+    {
+      if (!promises[i]->Wait())
+      {
+        state.SkipWithError("RPC call failed");
+        return;
+      }
+    }
+
+    // waiters are woken before the handlers are run, so wait for the last of the timestamps
+    while (num_completed < window)
+    {
+      std::this_thread::yield();
+    }
+
+    for (std::size_t i = 0; i < window; ++i)
+    {
+      latencies.push_back(
+          std::chrono::duration<double, std::micro>(completed[i] - started[i]).count());
+    }
+  }
+
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(window));
+  state.counters["p50_us"] = Percentile(latencies, 0.50);
+  state.counters["p99_us"] = Percentile(latencies, 0.99);
+}
+
+}  // namespace
+
+BENCHMARK(Muddle_Rpc_RoundTrip)
+    ->Args({0, 1})
+    ->Args({0, 64})
+    ->Args({2, 1})
+    ->Args({2, 64})
+    ->UseRealTime()
+    ->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,178 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "network/management/network_manager.hpp"
+#include "network/message.hpp"
+#include "network/tcp/tcp_client.hpp"
+#include "network/tcp/tcp_server.hpp"
+
+#include "benchmark/benchmark.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+
+namespace {
+
+using fetch::network::NetworkManager;
+using fetch::network::TCPClient;
+using fetch::network::TCPServer;
+using fetch::network::message_type;
+
+constexpr uint16_t    PORT         = 8095;
+constexpr std::size_t NUM_MESSAGES = 10000;
+
+// Server which simply counts the messages that it receives
+class CountingServer : public TCPServer
+{
+public:
+  CountingServer(uint16_t port, NetworkManager const &nmanager)
+    : TCPServer(port, nmanager)
+  {}
+
+  ~CountingServer() override = default;
+
+  void PushRequest(connection_handle_type /*client*/, message_type const & /*msg*/) override
+  {
+    ++received;
+  }
+
+  std::atomic<std::size_t> received{0};
+};
+
+/**
+ * A server and a single client connected to it over the loopback interface
+ */
+class Loopback
+{
+public:
+  Loopback()
+  {
+    nmanager_.Start();
+    server_.Start();
+
+    client_.OnMessage([this](message_type const &) { ++client_received; });
+    client_.Connect("localhost", PORT);
+
+    while (!client_.WaitForAlive(100))
+    {
+      std::this_thread::sleep_for(std::chrono::milliseconds{10});
+    }
+
+    // once the server has seen a message the connection is established in both directions
+    client_.Send("ping");
+    while (server_.received == 0)
+    {
+      std::this_thread::sleep_for(std::chrono::milliseconds{10});
+    }
+
+    server_.received = 0;
+  }
+
+  ~Loopback()
+  {
+    client_.Cleanup();
+    server_.Stop();
+    nmanager_.Stop();
+  }
+
+  TCPClient &client()
+  {
+    return client_;
+  }
+
+  CountingServer &server()
+  {
+    return server_;
+  }
+
+  std::atomic<std::size_t> client_received{0};
+
+private:
+  NetworkManager nmanager_{"NetMgr", 4};
+  CountingServer server_{PORT, nmanager_};
+  TCPClient      client_{nmanager_};
+};
+
+template <typename Counter>
+void WaitFor(Counter const &counter, std::size_t target)
+{
+  while (counter < target)
+  {
+    std::this_thread::yield();
+  }
+}
+
+// Stream of (small) messages from the client to the server
+void TcpClientToServer(benchmark::State &state)
+{
+  Loopback loopback{};
+
+  auto const         message_size = static_cast<std::size_t>(state.range(0));
+  message_type const message{std::string(message_size, 'A')};
+
+  std::size_t expected = 0;
+  for (auto _ : state)
+  {
+    for (std::size_t i = 0; i < NUM_MESSAGES; ++i)
+    {
+      loopback.client().Send(message);
+    }
+
+    expected += NUM_MESSAGES;
+    WaitFor(loopback.server().received, expected);
+  }
+
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(NUM_MESSAGES));
+  state.SetBytesProcessed(state.iterations() *
+                          static_cast<int64_t>(NUM_MESSAGES * message_size));
+}
+
+// Broadcast storm of (small) messages from the server to the client
+void TcpServerBroadcast(benchmark::State &state)
+{
+  Loopback loopback{};
+
+  auto const         message_size = static_cast<std::size_t>(state.range(0));
+  message_type const message{std::string(message_size, 'B')};
+
+  std::size_t expected = 0;
+  for (auto _ : state)
+  {
+    for (std::size_t i = 0; i < NUM_MESSAGES; ++i)
+    {
+      loopback.server().Broadcast(message);
+    }
+
+    expected += NUM_MESSAGES;
+    WaitFor(loopback.client_received, expected);
+  }
+
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(NUM_MESSAGES));
+  state.SetBytesProcessed(state.iterations() *
+                          static_cast<int64_t>(NUM_MESSAGES * message_size));
+}
+
+}  // namespace
+
+BENCHMARK(TcpClientToServer)->RangeMultiplier(8)->Range(64, 32768)->UseRealTime();
+BENCHMARK(TcpServerBroadcast)->RangeMultiplier(8)->Range(64, 32768)->UseRealTime();
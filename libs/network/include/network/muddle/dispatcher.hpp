@@ -27,6 +27,7 @@
 #include <memory>
 #include <unordered_map>
 #include <unordered_set>
+#include <vector>
 
 namespace fetch {
 namespace muddle {
@@ -79,12 +80,14 @@ private:
     Address   address;
   };
 
-  using PromiseMap = std::unordered_map<uint64_t, PromiseEntry>;
-  using PromiseSet = std::unordered_set<uint64_t>;
-  using HandleMap  = std::unordered_map<Handle, PromiseSet>;
+  using PromiseMap  = std::unordered_map<uint64_t, PromiseEntry>;
+  using PromiseSet  = std::unordered_set<uint64_t>;
+  using HandleMap   = std::unordered_map<Handle, PromiseSet>;
+  using PromiseList = std::vector<Promise>;
 
-  Mutex    counter_lock_{__LINE__, __FILE__};
-  uint16_t counter_{1};
+  static void FailPromises(PromiseList const &promises);
+
+  Counter counter_{1};
 
   Mutex      promises_lock_{__LINE__, __FILE__};
   PromiseMap promises_;
@@ -17,22 +17,29 @@
 //
 //------------------------------------------------------------------------------
 
-#include "core/mutex.hpp"
+#include "network/details/thread_pool.hpp"
 #include "network/muddle/muddle_endpoint.hpp"
 #include "network/service/client_interface.hpp"
 #include "network/service/promise.hpp"
 #include "network/service/types.hpp"
 
-#include <atomic>
-#include <list>
+#include <functional>
 #include <memory>
-#include <thread>
+#include <string>
 #include <utility>
 
 namespace fetch {
 namespace muddle {
 namespace rpc {
 
+/**
+ * RPC client over a muddle endpoint.
+ *
+ * Calls are completed as soon as the dispatcher matches the response packet to the pending
+ * exchange. By default the call promise is resolved (and its handlers run) on the thread that
+ * delivered the response. Alternatively an executor can be provided, in which case the response
+ * processing is posted to it so that slow handlers do not hold up the network.
+ */
 class Client : protected service::ServiceClientInterface
 {
 public:
@@ -49,7 +56,8 @@ public:
   static constexpr char const *LOGGING_NAME = "MuddleRpcClient";
 
   // Construction / Destruction
-  Client(std::string name, MuddleEndpoint &endpoint, uint16_t service, uint16_t channel);
+  Client(std::string name, MuddleEndpoint &endpoint, uint16_t service, uint16_t channel,
+         ThreadPool executor = ThreadPool{});
   Client(Client const &) = delete;
   Client(Client &&)      = delete;
   ~Client() override;
@@ -58,12 +66,11 @@ public:
   Promise CallSpecificAddress(Address const &address, ProtocolId const &protocol,
                               FunctionId const &function, Args &&... args)
   {
-    FETCH_LOCK(call_mutex_);
-    // update the target address
-    address_ = address;
-
-    // execute the call
-    return Call(network_id_.value(), protocol, function, std::forward<Args>(args)...);
+    return CallVia(
+        [this, &address](network::message_type const &request, Promise const &promise) {
+          return DeliverRequest(address, request, promise);
+        },
+        protocol, function, std::forward<Args>(args)...);
   }
 
   // Operators
@@ -74,30 +81,17 @@ protected:
   bool DeliverRequest(network::message_type const &data) override;
 
 private:
-  using Flag         = std::atomic<bool>;
-  using PromiseQueue = std::list<MuddleEndpoint::Response>;
-
-  static std::size_t const NUM_THREADS = 1;
+  bool DeliverRequest(Address const &address, network::message_type const &data,
+                      Promise const &promise);
 
   std::string const name_;
   MuddleEndpoint &  endpoint_;
-  Address           address_;
-  NetworkId const   network_id_;
   uint16_t const    service_;
   uint16_t const    channel_;
+  ThreadPool const  executor_;
 
   SharedHandler handler_;
-
-  std::mutex call_mutex_;  // priority 1
-
-  PromiseQueue            promise_queue_;
-  std::mutex              promise_queue_lock_;  // priority 2
-  std::condition_variable promise_queue_cv_;
-
-  std::thread background_thread_;
-  Flag        running_{false};
-
-  void BackgroundWorker();
+  SharedHandler failure_handler_;
 };
 
 }  // namespace rpc
@@ -56,6 +56,41 @@ public:
   template <typename... arguments>
   Promise Call(uint32_t /*network_id*/, protocol_handler_type const &protocol,
                function_handler_type const &function, arguments &&... args)
+  {
+    return CallVia(
+        [this](network::message_type const &request, Promise const & /*promise*/) {
+          return DeliverRequest(request);
+        },
+        protocol, function, std::forward<arguments>(args)...);
+  }
+
+  Promise CallWithPackedArguments(protocol_handler_type const &protocol,
+                                  function_handler_type const &function,
+                                  byte_array::ByteArray const &args);
+
+  /// @name Subscriptions
+  /// @{
+  subscription_handler_type Subscribe(protocol_handler_type const &protocol,
+                                      feed_handler_type const &feed, AbstractCallable *callback);
+  void                      Unsubscribe(subscription_handler_type id);
+  /// @}
+
+protected:
+  virtual bool DeliverRequest(network::message_type const &request) = 0;
+
+  /**
+   * Pack a call and hand the request to the specified delivery function instead of DeliverRequest.
+   * This allows clients to route each call independently, without any state shared between calls.
+   *
+   * @param deliver The delivery function: bool(network::message_type const &, Promise const &)
+   * @param protocol The protocol id
+   * @param function The function id
+   * @param args The call arguments
+   * @return The promise for the call
+   */
+  template <typename Deliver, typename... arguments>
+  Promise CallVia(Deliver &&deliver, protocol_handler_type const &protocol,
+                  function_handler_type const &function, arguments &&... args)
   {
     FETCH_LOG_DEBUG(LOGGING_NAME, "Service Client Calling ", protocol, ":", function);
 
@@ -79,7 +114,7 @@ public:
 
     PackCall(params, protocol, function, std::forward<arguments>(args)...);
 
-    if (!DeliverRequest(params.data()))
+    if (!deliver(params.data(), prom))
     {
       FETCH_LOG_WARN(LOGGING_NAME, "Call to ", protocol, ":", function, " prom=", prom->id(),
                      " failed!");
@@ -94,21 +129,8 @@ public:
     return prom;
   }
 
-  Promise CallWithPackedArguments(protocol_handler_type const &protocol,
-                                  function_handler_type const &function,
-                                  byte_array::ByteArray const &args);
-
-  /// @name Subscriptions
-  /// @{
-  subscription_handler_type Subscribe(protocol_handler_type const &protocol,
-                                      feed_handler_type const &feed, AbstractCallable *callback);
-  void                      Unsubscribe(subscription_handler_type id);
-  /// @}
-
-protected:
-  virtual bool DeliverRequest(network::message_type const &request) = 0;
-
   bool ProcessServerMessage(network::message_type const &msg);
+  void FailPromise(PromiseCounter id);
   void ProcessRPCResult(network::message_type const &msg, service::serializer_type &params);
 
 private:
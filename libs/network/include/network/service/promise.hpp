@@ -150,9 +150,8 @@ private:
   void UpdateState(State state);
   void DispatchCallbacks();
 
-  static Counter counter_;
-  static Mutex   counter_lock_;
-  static Counter GetNextId();
+  static std::atomic<Counter> counter_;
+  static Counter              GetNextId();
 
   Counter const  id_{GetNextId()};
   AtomicState    state_{State::WAITING};
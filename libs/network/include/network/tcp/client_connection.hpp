@@ -24,10 +24,13 @@
 #include "network/management/client_manager.hpp"
 #include "network/management/network_manager.hpp"
 #include "network/message.hpp"
+#include "network/tcp/message_framing.hpp"
 
 #include "network/fetch_asio.hpp"
 #include <atomic>
+#include <memory>
 #include <utility>
+#include <vector>
 
 namespace fetch {
 namespace network {
@@ -103,7 +106,7 @@ public:
     auto strong_strand = network_manager_.CreateIO<Strand>();
     if (!strong_strand)
     {
-      FETCH_LOG_INFO(LOGGING_NAME, "Failed to create strand. Will not read header");
+      FETCH_LOG_INFO(LOGGING_NAME, "Failed to create strand. Will not read");
       return;
     }
 
@@ -111,7 +114,7 @@ public:
 
     strand_ = strong_strand;
 
-    ReadHeader(strong_strand);
+    ReadNext(strong_strand);
   }
 
   void Send(message_type const &msg) override
@@ -189,21 +192,9 @@ private:
   bool               can_write_{true};
   mutable mutex_type queue_mutex_;
 
-  // TODO(issue 17): put this in shared class
-  static const uint64_t networkMagic_ = 0xFE7C80A1FE7C80A1;
+  FrameReader reader_{};
 
-  // TODO(issue 17): fix this to be self-contained
-  union
-  {
-    char bytes[2 * sizeof(uint64_t)];
-    struct
-    {
-      uint64_t magic;
-      uint64_t length;
-    } content;
-  } header_;
-
-  void ReadHeader(StrongStrand strong_strand)
+  void ReadNext(StrongStrand strong_strand)
   {
     if (shutting_down_)
     {
@@ -216,11 +207,9 @@ private:
       return;
     }
 
-    FETCH_LOG_DEBUG(LOGGING_NAME, "Server: Waiting for next header.");
+    FETCH_LOG_DEBUG(LOGGING_NAME, "Server: Waiting for more data.");
     auto self(shared_from_this());
     auto cb = [this, socket_ptr, self, strong_strand](std::error_code ec, std::size_t len) {
-      FETCH_UNUSED(len);
-
       auto ptr = manager_.lock();
       if (!ptr)
       {
@@ -229,63 +218,20 @@ private:
 
       if (!ec)
       {
-        FETCH_LOG_DEBUG(LOGGING_NAME, "Server: Read header.");
-        ReadBody(strong_strand);
-      }
-      else
-      {
-        ptr->Leave(this->handle());
-      }
-    };
-
-    asio::async_read(*socket_ptr, asio::buffer(header_.bytes, 2 * sizeof(uint64_t)), cb);
-  }
-
-  void ReadBody(StrongStrand strong_strand)
-  {
-    if (shutting_down_)
-    {
-      return;
-    }
+        // dispatch all the complete messages that are now in the receive buffer
+        auto const status = reader_.Commit(len, [this, &ptr](message_type const &message) {
+          FETCH_LOG_DEBUG(LOGGING_NAME, "Server: Recv message");
+          ptr->PushRequest(this->handle(), message);
+        });
 
-    auto socket_ptr = socket_.lock();
-    if (!socket_ptr)
-    {
-      return;
-    }
-
-    byte_array::ByteArray message;
-
-    if (header_.content.magic != networkMagic_)
-    {
-      FETCH_LOG_DEBUG(LOGGING_NAME, "Magic incorrect - closing connection.");
-      auto ptr = manager_.lock();
-      if (!ptr)
-      {
-        return;
-      }
-      ptr->Leave(this->handle());
-      return;
-    }
-
-    message.Resize(header_.content.length);
-    auto self(shared_from_this());
-    auto cb = [this, socket_ptr, self, message, strong_strand](std::error_code ec,
-                                                               std::size_t     len) {
-      FETCH_UNUSED(len);
-
-      auto ptr = manager_.lock();
-      if (!ptr)
-      {
-        return;
-      }
-
-      if (!ec)
-      {
-        FETCH_LOG_DEBUG(LOGGING_NAME, "Server: Recv message");
+        if (status != FrameReader::Status::OK)
+        {
+          FETCH_LOG_DEBUG(LOGGING_NAME, "Magic incorrect - closing connection.");
+          ptr->Leave(this->handle());
+          return;
+        }
 
-        ptr->PushRequest(this->handle(), message);
-        ReadHeader(strong_strand);
+        ReadNext(strong_strand);
       }
       else
       {
@@ -293,22 +239,8 @@ private:
       }
     };
 
-    asio::async_read(*socket_ptr, asio::buffer(message.pointer(), message.size()), cb);
-  }
-
-  static void SetHeader(byte_array::ByteArray &header, uint64_t bufSize)
-  {
-    header.Resize(16);
-
-    for (std::size_t i = 0; i < 8; ++i)
-    {
-      header[i] = uint8_t((networkMagic_ >> i * 8) & 0xff);
-    }
-
-    for (std::size_t i = 0; i < 8; ++i)
-    {
-      header[i + 8] = uint8_t((bufSize >> i * 8) & 0xff);
-    }
+    socket_ptr->async_read_some(asio::buffer(reader_.write_pointer(), reader_.write_capacity()),
+                                cb);
   }
 
   // Always executed in a run(), in a strand
@@ -328,7 +260,8 @@ private:
       }
     }
 
-    message_type buffer;
+    // drain as much of the queue as possible so that it can be sent with a single write
+    auto batch = std::make_shared<WriteBatch>();
     {
       FETCH_LOCK(queue_mutex_);
       if (write_queue_.empty())
@@ -337,19 +270,22 @@ private:
         can_write_ = true;
         return;
       }
-      buffer = write_queue_.front();
-      write_queue_.pop_front();
+      batch->Drain(write_queue_);
     }
 
-    byte_array::ByteArray header;
-    SetHeader(header, buffer.size());
+    std::vector<asio::const_buffer> buffers;
+    buffers.reserve(2 * batch->size());
+    for (std::size_t i = 0; i < batch->size(); ++i)
+    {
+      auto const &message = batch->message(i);
 
-    std::vector<asio::const_buffer> buffers{asio::buffer(header.pointer(), header.size()),
-                                            asio::buffer(buffer.pointer(), buffer.size())};
+      buffers.emplace_back(asio::buffer(batch->header(i), MessageFraming::HEADER_SIZE));
+      buffers.emplace_back(asio::buffer(message.pointer(), message.size()));
+    }
 
     auto socket = socket_.lock();
 
-    auto cb = [this, selfLock, socket, buffer, header](std::error_code ec, std::size_t len) {
+    auto cb = [this, selfLock, socket, batch](std::error_code ec, std::size_t len) {
       FETCH_UNUSED(len);
 
       {
@@ -27,11 +27,13 @@
 #include "network/management/abstract_connection.hpp"
 #include "network/management/network_manager.hpp"
 #include "network/message.hpp"
+#include "network/tcp/message_framing.hpp"
 
 #include <atomic>
 #include <memory>
 #include <mutex>
 #include <utility>
+#include <vector>
 
 namespace fetch {
 namespace network {
@@ -137,7 +139,7 @@ public:
             {
               this->SetAddress(endpoint.address().to_string());
               this->SetPort(uint16_t(port.AsInt()));
-              ReadHeader();
+              ReadNext();
             }
             else
             {
@@ -236,8 +238,6 @@ public:
   }
 
 private:
-  static const uint64_t networkMagic_ = 0xFE7C80A1FE7C80A1;
-
   network_manager_type networkManager_;
   // IO objects should be guaranteed to have lifetime less than the
   // io_service/networkManager
@@ -255,7 +255,9 @@ private:
   mutable mutex_type callback_mutex_;
   std::atomic<bool>  connected_{false};
 
-  void ReadHeader() noexcept
+  FrameReader reader_{};  ///< Only accessed from within the strand
+
+  void ReadNext() noexcept
   {
     auto strand = strand_.lock();
     if (!strand)
@@ -264,12 +266,10 @@ private:
     }
     assert(strand->running_in_this_thread());
 
-    self_type             self   = shared_from_this();
-    auto                  socket = socket_.lock();
-    byte_array::ByteArray header;
-    header.Resize(2 * sizeof(uint64_t));
+    self_type self   = shared_from_this();
+    auto      socket = socket_.lock();
 
-    auto cb = [this, self, socket, header, strand](std::error_code ec, std::size_t) {
+    auto cb = [this, self, socket, strand](std::error_code ec, std::size_t len) {
       shared_self_type selfLock = self.lock();
       if (!selfLock)
       {
@@ -278,13 +278,28 @@ private:
 
       if (!ec)
       {
-        FETCH_LOG_DEBUG(LOGGING_NAME, "Read message header.");
-        ReadBody(header);
+        // extract all the complete messages that are now in the receive buffer
+        auto const status =
+            reader_.Commit(len, [this](message_type const &message) { SignalMessage(message); });
+
+        if (status != FrameReader::Status::OK)
+        {
+          byte_array::ByteArray dummy;
+          dummy.Resize(MessageFraming::HEADER_SIZE);
+          MessageFraming::WriteHeader(dummy.pointer(), 0);
+
+          FETCH_LOG_ERROR(LOGGING_NAME, "Magic incorrect during network read:\ngot:      ",
+                          ToHex(reader_.last_header()),
+                          "\nExpected: ", ToHex(byte_array::ByteArray(dummy)));
+          return;
+        }
+
+        ReadNext();
       }
       else
       {
         // We expect to get an ec here when the socked is closed via a post
-        FETCH_LOG_INFO(LOGGING_NAME, "Socket closed inside ReadHeader: ", ec.message());
+        FETCH_LOG_INFO(LOGGING_NAME, "Socket closed inside ReadNext: ", ec.message());
         SignalLeave();
       }
     };
@@ -292,7 +307,8 @@ private:
     if (socket)
     {
       assert(strand->running_in_this_thread());
-      asio::async_read(*socket, asio::buffer(header.pointer(), header.size()), strand->wrap(cb));
+      socket->async_read_some(asio::buffer(reader_.write_pointer(), reader_.write_capacity()),
+                              strand->wrap(cb));
 
       bool const previously_connected = connected_.exchange(true);
 
@@ -303,86 +319,12 @@ private:
     }
     else
     {
-      FETCH_LOG_INFO(LOGGING_NAME, "Socket no longer valid in ReadHeader");
+      FETCH_LOG_INFO(LOGGING_NAME, "Socket no longer valid in ReadNext");
       connected_ = false;
       SignalLeave();
     }
   }
 
-  void ReadBody(byte_array::ByteArray const &header) noexcept
-  {
-    auto strand = strand_.lock();
-    assert(strand->running_in_this_thread());
-
-    assert(header.size() >= sizeof(networkMagic_));
-    uint64_t magic = *reinterpret_cast<const uint64_t *>(header.pointer());
-    uint64_t size  = *reinterpret_cast<const uint64_t *>(header.pointer() + sizeof(uint64_t));
-
-    if (magic != networkMagic_)
-    {
-      byte_array::ByteArray dummy;
-      SetHeader(dummy, 0);
-      dummy.Resize(16);
-
-      FETCH_LOG_ERROR(LOGGING_NAME,
-                      "Magic incorrect during network read:\ngot:      ", ToHex(header),
-                      "\nExpected: ", ToHex(byte_array::ByteArray(dummy)));
-      return;
-    }
-
-    byte_array::ByteArray message;
-    message.Resize(size);
-
-    self_type self   = shared_from_this();
-    auto      socket = socket_.lock();
-    auto      cb     = [this, self, message, socket, strand](std::error_code ec, std::size_t len) {
-      FETCH_UNUSED(len);
-
-      shared_self_type selfLock = self.lock();
-      if (!selfLock)
-      {
-        return;
-      }
-
-      if (!ec)
-      {
-        SignalMessage(message);
-        ReadHeader();
-      }
-      else
-      {
-        FETCH_LOG_ERROR(LOGGING_NAME, "Reading body failed, dying: ", ec, ec.message());
-        SignalLeave();
-      }
-    };
-
-    if (socket)
-    {
-      assert(strand->running_in_this_thread());
-      asio::async_read(*socket, asio::buffer(message.pointer(), message.size()), strand->wrap(cb));
-    }
-    else
-    {
-      FETCH_LOG_ERROR(LOGGING_NAME, "Invalid socket when attempting to read body");
-      SignalLeave();
-    }
-  }
-
-  static void SetHeader(byte_array::ByteArray &header, uint64_t bufSize)
-  {
-    header.Resize(16);
-
-    for (std::size_t i = 0; i < 8; ++i)
-    {
-      header[i] = uint8_t((networkMagic_ >> i * 8) & 0xff);
-    }
-
-    for (std::size_t i = 0; i < 8; ++i)
-    {
-      header[i + 8] = uint8_t((bufSize >> i * 8) & 0xff);
-    }
-  }
-
   // Always executed in a run(), in a strand
   void WriteNext(shared_self_type selfLock)
   {
@@ -400,7 +342,8 @@ private:
       }
     }
 
-    message_type buffer;
+    // drain as much of the queue as possible so that it can be sent with a single write
+    auto batch = std::make_shared<WriteBatch>();
     {
       FETCH_LOCK(queue_mutex_);
       if (write_queue_.empty())
@@ -409,19 +352,22 @@ private:
         can_write_ = true;
         return;
       }
-      buffer = write_queue_.front();
-      write_queue_.pop_front();
+      batch->Drain(write_queue_);
     }
 
-    byte_array::ByteArray header;
-    SetHeader(header, buffer.size());
+    std::vector<asio::const_buffer> buffers;
+    buffers.reserve(2 * batch->size());
+    for (std::size_t i = 0; i < batch->size(); ++i)
+    {
+      auto const &message = batch->message(i);
 
-    std::vector<asio::const_buffer> buffers{asio::buffer(header.pointer(), header.size()),
-                                            asio::buffer(buffer.pointer(), buffer.size())};
+      buffers.emplace_back(asio::buffer(batch->header(i), MessageFraming::HEADER_SIZE));
+      buffers.emplace_back(asio::buffer(message.pointer(), message.size()));
+    }
 
     auto socket = socket_.lock();
 
-    auto cb = [this, selfLock, socket, buffer, header](std::error_code ec, std::size_t len) {
+    auto cb = [this, selfLock, socket, batch](std::error_code ec, std::size_t len) {
       FETCH_UNUSED(len);
 
       {
@@ -0,0 +1,209 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/byte_array/byte_array.hpp"
+#include "core/byte_array/const_byte_array.hpp"
+#include "network/message.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace fetch {
+namespace network {
+
+/**
+ * Each message on a TCP connection is prefixed with a 16 byte header made up of a magic value
+ * followed by the length of the message body
+ */
+struct MessageFraming
+{
+  static constexpr uint64_t    NETWORK_MAGIC = 0xFE7C80A1FE7C80A1;
+  static constexpr std::size_t HEADER_SIZE   = 2 * sizeof(uint64_t);
+
+  static void WriteHeader(uint8_t *header, uint64_t body_size);
+};
+
+/**
+ * A group of messages, drained from a connection's write queue, which are written to the socket
+ * with a single scatter-gather write. The headers for all the messages are stored contiguously.
+ */
+class WriteBatch
+{
+public:
+  using Messages = std::vector<message_type>;
+
+  static constexpr std::size_t MAX_BYTES    = 256 * 1024;
+  static constexpr std::size_t MAX_MESSAGES = 512;
+
+  std::size_t Drain(message_queue_type &queue, std::size_t max_bytes = MAX_BYTES,
+                    std::size_t max_messages = MAX_MESSAGES);
+
+  bool empty() const
+  {
+    return messages_.empty();
+  }
+
+  std::size_t size() const
+  {
+    return messages_.size();
+  }
+
+  std::size_t size_bytes() const
+  {
+    return size_bytes_;
+  }
+
+  uint8_t const *header(std::size_t index) const
+  {
+    return headers_.pointer() + (index * MessageFraming::HEADER_SIZE);
+  }
+
+  message_type const &message(std::size_t index) const
+  {
+    return messages_[index];
+  }
+
+private:
+  byte_array::ByteArray headers_{};
+  Messages              messages_{};
+  std::size_t           size_bytes_{0};
+};
+
+/**
+ * Incremental parser for framed messages. Data from the socket is read directly into the receive
+ * buffer (see write_pointer() and write_capacity()) and then as many complete messages as are
+ * present are extracted in one go. Messages which are too large for the receive buffer are read
+ * straight into their own allocation.
+ */
+class FrameReader
+{
+public:
+  enum class Status
+  {
+    OK,
+    BAD_MAGIC
+  };
+
+  static constexpr std::size_t DEFAULT_BUFFER_SIZE = 64 * 1024;
+
+  explicit FrameReader(std::size_t buffer_size = DEFAULT_BUFFER_SIZE);
+
+  uint8_t *write_pointer();
+  std::size_t write_capacity() const;
+
+  template <typename Handler>
+  Status Commit(std::size_t num_bytes, Handler &&handler);
+
+  byte_array::ConstByteArray const &last_header() const
+  {
+    return last_header_;
+  }
+
+private:
+  bool NextFrame(uint64_t &magic, uint64_t &body_size) const;
+  void Compact();
+
+  byte_array::ByteArray buffer_;
+  std::size_t           begin_{0};
+  std::size_t           end_{0};
+
+  byte_array::ByteArray large_message_{};
+  std::size_t           large_filled_{0};
+  bool                  large_pending_{false};
+
+  byte_array::ConstByteArray last_header_{};
+};
+
+/**
+ * Record that data has been received into the area given by write_pointer() and dispatch all the
+ * messages that are now complete
+ *
+ * @param num_bytes The number of bytes received
+ * @param handler The callable invoked with each complete message
+ * @return OK if successful, otherwise BAD_MAGIC if the stream is corrupt
+ */
+template <typename Handler>
+FrameReader::Status FrameReader::Commit(std::size_t num_bytes, Handler &&handler)
+{
+  if (large_pending_)
+  {
+    large_filled_ += num_bytes;
+
+    if (large_filled_ == large_message_.size())
+    {
+      large_pending_ = false;
+
+      message_type message{std::move(large_message_)};
+      large_message_ = byte_array::ByteArray{};
+      handler(message);
+    }
+
+    return Status::OK;
+  }
+
+  end_ += num_bytes;
+
+  uint64_t magic     = 0;
+  uint64_t body_size = 0;
+  while (NextFrame(magic, body_size))
+  {
+    if (magic != MessageFraming::NETWORK_MAGIC)
+    {
+      last_header_ = buffer_.SubArray(begin_, MessageFraming::HEADER_SIZE).Copy();
+      return Status::BAD_MAGIC;
+    }
+
+    std::size_t const available = end_ - begin_ - MessageFraming::HEADER_SIZE;
+    uint8_t const *   body      = buffer_.pointer() + begin_ + MessageFraming::HEADER_SIZE;
+
+    if (available >= body_size)
+    {
+      message_type message;
+      message.Resize(body_size);
+      std::memcpy(message.pointer(), body, body_size);
+
+      begin_ += MessageFraming::HEADER_SIZE + body_size;
+      handler(message);
+    }
+    else if ((MessageFraming::HEADER_SIZE + body_size) > buffer_.size())
+    {
+      // the message will never fit in the receive buffer, continue reading into its own storage
+      large_message_.Resize(body_size);
+      std::memcpy(large_message_.pointer(), body, available);
+      large_filled_  = available;
+      large_pending_ = true;
+
+      begin_ = end_;
+      break;
+    }
+    else
+    {
+      break;
+    }
+  }
+
+  Compact();
+
+  return Status::OK;
+}
+
+}  // namespace network
+}  // namespace fetch
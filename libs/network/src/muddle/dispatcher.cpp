@@ -28,6 +28,7 @@
 
 #include <chrono>
 #include <cstdint>
+#include <utility>
 
 namespace fetch {
 namespace muddle {
@@ -114,7 +115,7 @@ Dispatcher::Promise Dispatcher::RegisterExchange(uint16_t service, uint16_t chan
  */
 bool Dispatcher::Dispatch(PacketPtr packet)
 {
-  bool success = false;
+  Promise promise{};
 
   double duration_secs{0.0};
   {
@@ -131,12 +132,9 @@ bool Dispatcher::Dispatch(PacketPtr packet)
         // capture the network time
         duration_secs = ToSeconds(Clock::now() - it->second.timestamp);
 
-        // fulfill the pending promise
-        it->second.promise->Fulfill(packet->GetPayload());
-
-        // finally remove the promise from the map (since it has been completed)
+        // remove the promise from the map (since it has been completed)
+        promise = std::move(it->second.promise);
         promises_.erase(it);
-        success = true;
       }
       else
       {
@@ -147,9 +145,14 @@ bool Dispatcher::Dispatch(PacketPtr packet)
     }
   }
 
-  // telemetry
+  bool const success = static_cast<bool>(promise);
+
   if (success)
   {
+    // fulfill the pending promise outside of the lock, since this runs the completion handlers
+    promise->Fulfill(packet->GetPayload());
+
+    // telemetry
     exchange_success_totals_->increment();
     exchange_times_->Add(duration_secs);
     exchange_time_max_->max(duration_secs);
@@ -200,6 +203,8 @@ void Dispatcher::NotifyConnectionFailure(Handle handle)
   }
 
   // update all the affected promises
+  PromiseList failed_promises{};
+
   {
     FETCH_LOCK(promises_lock_);
 
@@ -208,11 +213,13 @@ void Dispatcher::NotifyConnectionFailure(Handle handle)
       auto it = promises_.find(id);
       if (it != promises_.end())
       {
-        it->second.promise->Fail();
+        failed_promises.emplace_back(std::move(it->second.promise));
         promises_.erase(it);
       }
     }
   }
+
+  FailPromises(failed_promises);
 }
 
 /**
@@ -222,72 +229,97 @@ void Dispatcher::NotifyConnectionFailure(Handle handle)
  */
 void Dispatcher::Cleanup(Timepoint const &now)
 {
-  FETCH_LOCK(promises_lock_);
-  FETCH_LOCK(handles_lock_);
-
-  PromiseSet dead_promises{};
+  PromiseList failed_promises{};
 
-  // Step 1. Determine which of the promises is now deemed to be dead
-  auto promise_it = promises_.begin();
-  while (promise_it != promises_.end())
   {
-    auto const delta = now - promise_it->second.timestamp;
-    if (delta > PROMISE_TIMEOUT)
-    {
-      FETCH_LOG_INFO(LOGGING_NAME, "Discarding promise due to timeout");
-      promise_it->second.promise->Fail();
-      dead_promises.insert(promise_it->first);
+    FETCH_LOCK(promises_lock_);
+    FETCH_LOCK(handles_lock_);
 
-      // erase the whole entry
-      promise_it = promises_.erase(promise_it);
-    }
-    else
-    {
-      ++promise_it;
-    }
-  }
+    PromiseSet dead_promises{};
 
-  // Step 2. Clean up the handles map
-  for (auto const &id : dead_promises)
-  {
-    // evaluate all the of the handles
-    auto handle_it = handles_.begin();
-    while (handle_it != handles_.end())
+    // Step 1. Determine which of the promises is now deemed to be dead
+    auto promise_it = promises_.begin();
+    while (promise_it != promises_.end())
     {
-      auto &promise_set = handle_it->second;
-
-      // ensure the affected promise is removed from the set
-      promise_set.erase(id);
-
-      // clear out the whole handle set if needed
-      if (promise_set.empty())
+      auto const delta = now - promise_it->second.timestamp;
+      if (delta > PROMISE_TIMEOUT)
       {
-        handle_it = handles_.erase(handle_it);
+        FETCH_LOG_INFO(LOGGING_NAME, "Discarding promise due to timeout");
+        failed_promises.emplace_back(std::move(promise_it->second.promise));
+        dead_promises.insert(promise_it->first);
+
+        // erase the whole entry
+        promise_it = promises_.erase(promise_it);
       }
       else
       {
-        ++handle_it;
+        ++promise_it;
+      }
+    }
+
+    // Step 2. Clean up the handles map
+    for (auto const &id : dead_promises)
+    {
+      // evaluate all the of the handles
+      auto handle_it = handles_.begin();
+      while (handle_it != handles_.end())
+      {
+        auto &promise_set = handle_it->second;
+
+        // ensure the affected promise is removed from the set
+        promise_set.erase(id);
+
+        // clear out the whole handle set if needed
+        if (promise_set.empty())
+        {
+          handle_it = handles_.erase(handle_it);
+        }
+        else
+        {
+          ++handle_it;
+        }
       }
     }
   }
+
+  FailPromises(failed_promises);
 }
 
 void Dispatcher::FailAllPendingPromises()
 {
-  FETCH_LOCK(promises_lock_);
-  FETCH_LOCK(handles_lock_);
-  for (auto promise_it = promises_.begin(); promise_it != promises_.end();)
+  PromiseList failed_promises{};
+
   {
-    promise_it->second.promise->Fail();
-    promise_it = promises_.erase(promise_it);
+    FETCH_LOCK(promises_lock_);
+    FETCH_LOCK(handles_lock_);
+    for (auto promise_it = promises_.begin(); promise_it != promises_.end();)
+    {
+      failed_promises.emplace_back(std::move(promise_it->second.promise));
+      promise_it = promises_.erase(promise_it);
+    }
   }
+
+  FailPromises(failed_promises);
 }
 
 uint16_t Dispatcher::GetNextCounter()
 {
-  FETCH_LOCK(counter_lock_);
   return counter_++;
 }
 
+/**
+ * Fail a set of promises which have already been removed from the pending map. This is always
+ * done without holding any of the dispatcher locks since it triggers the completion handlers.
+ *
+ * @param promises The promises to fail
+ */
+void Dispatcher::FailPromises(PromiseList const &promises)
+{
+  for (auto const &promise : promises)
+  {
+    promise->Fail();
+  }
+}
+
 }  // namespace muddle
 }  // namespace fetch
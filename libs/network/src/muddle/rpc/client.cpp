@@ -16,30 +16,49 @@
 //
 //------------------------------------------------------------------------------
 
-#include "core/set_thread_name.hpp"
 #include "network/muddle/rpc/client.hpp"
 
-#include <chrono>
-#include <cstddef>
 #include <cstdint>
 #include <exception>
-#include <list>
 #include <memory>
-#include <mutex>
 #include <string>
-#include <thread>
 #include <utility>
 
 namespace fetch {
 namespace muddle {
 namespace rpc {
+namespace {
+
+using WorkItem = std::function<void()>;
+
+/**
+ * Run the work item on the executor if one has been configured, otherwise run it immediately on
+ * the calling thread
+ *
+ * @param executor The (optional) executor
+ * @param work The work item to be run
+ */
+void Execute(Client::ThreadPool const &executor, WorkItem work)
+{
+  if (executor)
+  {
+    executor->Post(std::move(work));
+  }
+  else
+  {
+    work();
+  }
+}
+
+}  // namespace
 
-Client::Client(std::string name, MuddleEndpoint &endpoint, uint16_t service, uint16_t channel)
+Client::Client(std::string name, MuddleEndpoint &endpoint, uint16_t service, uint16_t channel,
+               ThreadPool executor)
   : name_(std::move(name))
   , endpoint_(endpoint)
-  , network_id_(endpoint.network_id())
   , service_(service)
   , channel_(channel)
+  , executor_(std::move(executor))
 {
   handler_ = std::make_shared<Handler>([this](Promise promise) {
     FETCH_LOG_DEBUG(LOGGING_NAME, "Handling an inner promise ", promise->id());
@@ -54,26 +73,28 @@ Client::Client(std::string name, MuddleEndpoint &endpoint, uint16_t service, uin
     }
   });
 
-  // start the background thread processs
-  running_           = true;
-  background_thread_ = std::thread{&Client::BackgroundWorker, this};
+  failure_handler_ = std::make_shared<Handler>([this](Promise promise) {
+    FETCH_LOG_DEBUG(LOGGING_NAME, "Failing call promise ", promise->id());
+
+    FailPromise(promise->id());
+  });
 }
 
 Client::~Client()
 {
-  FETCH_LOG_WARN(LOGGING_NAME, "Client teardown...");
-  // clear that handler
+  // clear the handlers, any responses which arrive after this point are discarded
   handler_.reset();
+  failure_handler_.reset();
+}
 
-  FETCH_LOG_WARN(LOGGING_NAME, "Handler reset, stopping threadpool");
-  running_ = false;
-  promise_queue_cv_.notify_all();
-  background_thread_.join();
-  background_thread_ = std::thread{};
-  FETCH_LOG_WARN(LOGGING_NAME, "Threadpool stopped, client destructor end");
+bool Client::DeliverRequest(network::message_type const & /*data*/)
+{
+  FETCH_LOG_ERROR(LOGGING_NAME, "Unable to deliver request without a target address");
+  return false;
 }
 
-bool Client::DeliverRequest(network::message_type const &data)
+bool Client::DeliverRequest(Address const &address, network::message_type const &data,
+                            Promise const &call)
 {
   FETCH_LOG_DEBUG(LOGGING_NAME, "Please send this packet to the server  ", service_, ",", channel_);
 
@@ -82,37 +103,42 @@ bool Client::DeliverRequest(network::message_type const &data)
   try
   {
     // signal to the networking that an exchange is requested
-    auto promise = endpoint_.Exchange(address_, service_, channel_, data);
+    auto promise = endpoint_.Exchange(address, service_, channel_, data);
     ident        = promise.id();
 
     FETCH_LOG_DEBUG(LOGGING_NAME, "Sent this packet to the server  ", service_, ",", channel_,
                     "@prom=", promise.id(), " response size=", data.size());
 
-    // establish the correct course of action when
-    WeakHandler handler = handler_;
+    // the exchange promise is resolved directly by the dispatcher when the response arrives (or
+    // when the exchange fails), the call promise is then completed on the configured executor
+    WeakHandler handler         = handler_;
+    WeakHandler failure_handler = failure_handler_;
+    ThreadPool  executor        = executor_;
     promise.WithHandlers()
-        .Then([handler, promise]() {
+        .Then([handler, executor, promise]() {
           FETCH_LOG_DEBUG(LOGGING_NAME, "Got the response to our question...",
                           "@prom=", promise.id());
-          auto callback = handler.lock();
-          if (callback)
-          {
-            (*callback)(promise.GetInnerPromise());
-          }
+
+          Execute(executor, [handler, response = promise.GetInnerPromise()]() {
+            auto callback = handler.lock();
+            if (callback)
+            {
+              (*callback)(response);
+            }
+          });
         })
-        .Catch([promise]() {
-          // TODO(EJF): This is actually a bug since the RPC promise implementation doesn't have a
-          // callback process
-          FETCH_LOG_DEBUG(LOGGING_NAME, "Exchange promise failed", "@prom=", promise.id());
+        .Catch([failure_handler, executor, call, ident]() {
+          FETCH_LOG_DEBUG(LOGGING_NAME, "Exchange promise failed", "@prom=", ident);
+
+          Execute(executor, [failure_handler, call]() {
+            auto callback = failure_handler.lock();
+            if (callback)
+            {
+              (*callback)(call);
+            }
+          });
         });
 
-    // Add this new wrapping promise to the execution queue
-    {
-      FETCH_LOCK(promise_queue_lock_);
-      promise_queue_.emplace_back(std::move(promise));
-      promise_queue_cv_.notify_one();
-    }
-
     return true;
   }
   catch (std::exception const &e)
@@ -123,68 +149,6 @@ bool Client::DeliverRequest(network::message_type const &data)
   }
 }
 
-void Client::BackgroundWorker()
-{
-  using PromiseState = service::PromiseState;
-
-  SetThreadName(name_);
-
-  std::list<MuddleEndpoint::Response> pending_promises;
-
-  std::size_t consecutive_idle_loops{0};
-  while (running_)
-  {
-    bool was_idle{true};
-
-    // attempt to extract and promises from the queue
-    {
-      FETCH_LOCK(promise_queue_lock_);
-      if (!promise_queue_.empty())
-      {
-        pending_promises.splice(pending_promises.end(), promise_queue_);
-        was_idle = false;
-      }
-    }
-
-    // evaluate the promises in the queue
-    auto it = pending_promises.begin();
-    while (it != pending_promises.end())
-    {
-      // evaluate the state of the current promise
-      PromiseState const state = it->GetState();
-
-      if (service::PromiseState::WAITING != state)
-      {
-        // erase the promise from the queue
-        it       = pending_promises.erase(it);
-        was_idle = false;
-      }
-      else
-      {
-        // advance to the next iterator
-        ++it;
-      }
-    }
-
-    if (pending_promises.empty())
-    {
-      std::unique_lock<std::mutex> lk(promise_queue_lock_);
-      promise_queue_cv_.wait(lk);
-
-      was_idle = false;
-    }
-
-    // update the idle loop counter
-    consecutive_idle_loops = (was_idle) ? consecutive_idle_loops + 1 : 0;
-
-    // if we are in sustained a period of idleness then we should sleep the thread
-    if (consecutive_idle_loops >= 3)
-    {
-      std::this_thread::sleep_for(std::chrono::milliseconds{100});
-    }
-  }
-}
-
 }  // namespace rpc
 }  // namespace muddle
 }  // namespace fetch
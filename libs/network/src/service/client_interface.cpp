@@ -19,6 +19,7 @@
 #include "network/service/client_interface.hpp"
 
 #include <algorithm>
+#include <utility>
 
 namespace fetch {
 namespace service {
@@ -284,6 +285,32 @@ void ServiceClientInterface::RemovePromise(PromiseCounter id)
   promises_.erase(id);
 }
 
+/**
+ * Fail a pending call whose request or response was lost in transit. Calls which have already
+ * been resolved are ignored.
+ *
+ * @param id The id of the call promise
+ */
+void ServiceClientInterface::FailPromise(PromiseCounter id)
+{
+  Promise promise;
+
+  {
+    FETCH_LOCK(promises_mutex_);
+
+    auto it = promises_.find(id);
+    if (it == promises_.end())
+    {
+      return;
+    }
+
+    promise = std::move(it->second);
+    promises_.erase(it);
+  }
+
+  promise->Fail();
+}
+
 subscription_handler_type ServiceClientInterface::CreateSubscription(
     protocol_handler_type const &protocol, feed_handler_type const &feed, AbstractCallable *cb)
 {
@@ -37,8 +37,7 @@ void LogTimout(NAME const &name, ID const &id)
 }
 }  // namespace
 
-PromiseImplementation::Counter PromiseImplementation::counter_{0};
-Mutex                          PromiseImplementation::counter_lock_{__LINE__, __FILE__};
+std::atomic<PromiseImplementation::Counter> PromiseImplementation::counter_{0};
 
 PromiseBuilder PromiseImplementation::WithHandlers()
 {
@@ -149,7 +148,6 @@ void PromiseImplementation::DispatchCallbacks()
 
 PromiseImplementation::Counter PromiseImplementation::GetNextId()
 {
-  FETCH_LOCK(counter_lock_);
   return counter_++;
 }
 
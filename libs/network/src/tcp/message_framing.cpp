@@ -0,0 +1,168 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "network/tcp/message_framing.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace fetch {
+namespace network {
+
+constexpr uint64_t    MessageFraming::NETWORK_MAGIC;
+constexpr std::size_t MessageFraming::HEADER_SIZE;
+constexpr std::size_t WriteBatch::MAX_BYTES;
+constexpr std::size_t WriteBatch::MAX_MESSAGES;
+constexpr std::size_t FrameReader::DEFAULT_BUFFER_SIZE;
+
+/**
+ * Write the header for a message into the specified buffer (which must be at least HEADER_SIZE
+ * bytes long)
+ *
+ * @param header The output buffer
+ * @param body_size The size of the message body
+ */
+void MessageFraming::WriteHeader(uint8_t *header, uint64_t body_size)
+{
+  for (std::size_t i = 0; i < 8; ++i)
+  {
+    header[i] = uint8_t((NETWORK_MAGIC >> i * 8) & 0xff);
+  }
+
+  for (std::size_t i = 0; i < 8; ++i)
+  {
+    header[i + 8] = uint8_t((body_size >> i * 8) & 0xff);
+  }
+}
+
+/**
+ * Move messages from the front of the write queue into the batch. At least one message is always
+ * taken (if available) so that messages larger than the byte budget are still sent.
+ *
+ * @param queue The write queue to drain
+ * @param max_bytes The (soft) limit on the number of bytes in the batch
+ * @param max_messages The limit on the number of messages in the batch
+ * @return The number of messages added to the batch
+ */
+std::size_t WriteBatch::Drain(message_queue_type &queue, std::size_t max_bytes,
+                              std::size_t max_messages)
+{
+  std::size_t count = 0;
+
+  while (!queue.empty() && (messages_.size() < max_messages))
+  {
+    std::size_t const frame_size = MessageFraming::HEADER_SIZE + queue.front().size();
+
+    if (!messages_.empty() && ((size_bytes_ + frame_size) > max_bytes))
+    {
+      break;
+    }
+
+    messages_.emplace_back(std::move(queue.front()));
+    queue.pop_front();
+
+    size_bytes_ += frame_size;
+    ++count;
+  }
+
+  // build all the headers in one contiguous buffer
+  headers_.Resize(messages_.size() * MessageFraming::HEADER_SIZE);
+  for (std::size_t i = 0; i < messages_.size(); ++i)
+  {
+    MessageFraming::WriteHeader(headers_.pointer() + (i * MessageFraming::HEADER_SIZE),
+                                messages_[i].size());
+  }
+
+  return count;
+}
+
+FrameReader::FrameReader(std::size_t buffer_size)
+{
+  buffer_.Resize(std::max(buffer_size, MessageFraming::HEADER_SIZE));
+}
+
+/**
+ * Get the location into which the next socket read should be made
+ *
+ * @return The pointer to the start of the free space
+ */
+uint8_t *FrameReader::write_pointer()
+{
+  if (large_pending_)
+  {
+    return large_message_.pointer() + large_filled_;
+  }
+
+  return buffer_.pointer() + end_;
+}
+
+/**
+ * Get the number of bytes that can be read into the area given by write_pointer()
+ *
+ * @return The number of bytes
+ */
+std::size_t FrameReader::write_capacity() const
+{
+  if (large_pending_)
+  {
+    return large_message_.size() - large_filled_;
+  }
+
+  return buffer_.size() - end_;
+}
+
+/**
+ * Determine if there is a complete header at the front of the unparsed data
+ *
+ * @param magic The output magic value from the header
+ * @param body_size The output body size from the header
+ * @return true if there is a complete header, otherwise false
+ */
+bool FrameReader::NextFrame(uint64_t &magic, uint64_t &body_size) const
+{
+  if ((end_ - begin_) < MessageFraming::HEADER_SIZE)
+  {
+    return false;
+  }
+
+  uint8_t const *header = buffer_.pointer() + begin_;
+  std::memcpy(&magic, header, sizeof(uint64_t));
+  std::memcpy(&body_size, header + sizeof(uint64_t), sizeof(uint64_t));
+
+  return true;
+}
+
+/**
+ * Move any partially received frame to the start of the receive buffer
+ */
+void FrameReader::Compact()
+{
+  if (begin_ == end_)
+  {
+    begin_ = end_ = 0;
+  }
+  else if (begin_ != 0)
+  {
+    std::memmove(buffer_.pointer(), buffer_.pointer() + begin_, end_ - begin_);
+    end_ -= begin_;
+    begin_ = 0;
+  }
+}
+
+}  // namespace network
+}  // namespace fetch
@@ -0,0 +1,186 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "network/tcp/message_framing.hpp"
+
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace {
+
+using fetch::byte_array::ByteArray;
+using fetch::network::FrameReader;
+using fetch::network::MessageFraming;
+using fetch::network::WriteBatch;
+using fetch::network::message_queue_type;
+using fetch::network::message_type;
+
+using Messages = std::vector<message_type>;
+
+message_type CreateMessage(std::size_t length, char fill)
+{
+  return message_type{std::string(length, fill)};
+}
+
+// flatten a write batch into the byte stream that would appear on the wire
+ByteArray Serialise(WriteBatch const &batch)
+{
+  ByteArray stream;
+  stream.Resize(batch.size_bytes());
+
+  std::size_t offset = 0;
+  for (std::size_t i = 0; i < batch.size(); ++i)
+  {
+    std::memcpy(stream.pointer() + offset, batch.header(i), MessageFraming::HEADER_SIZE);
+    offset += MessageFraming::HEADER_SIZE;
+
+    auto const &message = batch.message(i);
+    std::memcpy(stream.pointer() + offset, message.pointer(), message.size());
+    offset += message.size();
+  }
+
+  return stream;
+}
+
+// feed the stream into the reader in chunks of (at most) the specified size
+Messages Receive(FrameReader &reader, ByteArray const &stream, std::size_t chunk_size)
+{
+  Messages received{};
+
+  std::size_t offset = 0;
+  while (offset < stream.size())
+  {
+    std::size_t const amount =
+        std::min({chunk_size, reader.write_capacity(), stream.size() - offset});
+
+    std::memcpy(reader.write_pointer(), stream.pointer() + offset, amount);
+    offset += amount;
+
+    auto const status =
+        reader.Commit(amount, [&received](message_type const &msg) { received.push_back(msg); });
+    EXPECT_EQ(status, FrameReader::Status::OK);
+  }
+
+  return received;
+}
+
+TEST(MessageFramingTests, WriteBatchRespectsByteBudget)
+{
+  message_queue_type queue{};
+  for (std::size_t i = 0; i < 10; ++i)
+  {
+    queue.push_back(CreateMessage(100, 'A'));
+  }
+
+  WriteBatch batch{};
+  EXPECT_EQ(batch.Drain(queue, 4 * (100 + MessageFraming::HEADER_SIZE)), 4u);
+  EXPECT_EQ(batch.size(), 4u);
+  EXPECT_EQ(queue.size(), 6u);
+}
+
+TEST(MessageFramingTests, WriteBatchAlwaysTakesOneMessage)
+{
+  message_queue_type queue{};
+  queue.push_back(CreateMessage(1000, 'A'));
+  queue.push_back(CreateMessage(10, 'B'));
+
+  WriteBatch batch{};
+  EXPECT_EQ(batch.Drain(queue, 100), 1u);
+  EXPECT_EQ(batch.message(0).size(), 1000u);
+  EXPECT_EQ(queue.size(), 1u);
+}
+
+TEST(MessageFramingTests, ManyMessagesInSingleRead)
+{
+  message_queue_type queue{};
+  Messages           expected{};
+  for (std::size_t i = 0; i < 50; ++i)
+  {
+    expected.push_back(CreateMessage(i, static_cast<char>('A' + (i % 26))));
+    queue.push_back(expected.back());
+  }
+
+  WriteBatch batch{};
+  batch.Drain(queue);
+  ASSERT_EQ(batch.size(), expected.size());
+
+  FrameReader reader{};
+  EXPECT_EQ(Receive(reader, Serialise(batch), 1u << 20), expected);
+}
+
+TEST(MessageFramingTests, FramesSplitAcrossReads)
+{
+  message_queue_type queue{};
+  Messages           expected{};
+  for (std::size_t i = 0; i < 20; ++i)
+  {
+    expected.push_back(CreateMessage(7 * i + 3, static_cast<char>('a' + i)));
+    queue.push_back(expected.back());
+  }
+
+  WriteBatch batch{};
+  batch.Drain(queue);
+
+  for (std::size_t chunk_size : {1u, 5u, 17u, 64u})
+  {
+    FrameReader reader{64};
+    EXPECT_EQ(Receive(reader, Serialise(batch), chunk_size), expected);
+  }
+}
+
+TEST(MessageFramingTests, MessagesLargerThanBuffer)
+{
+  message_queue_type queue{};
+  Messages           expected{};
+  expected.push_back(CreateMessage(10, 'A'));
+  expected.push_back(CreateMessage(5000, 'B'));
+  expected.push_back(CreateMessage(20, 'C'));
+  expected.push_back(CreateMessage(300, 'D'));
+
+  for (auto const &msg : expected)
+  {
+    queue.push_back(msg);
+  }
+
+  WriteBatch batch{};
+  batch.Drain(queue);
+
+  FrameReader reader{128};
+  EXPECT_EQ(Receive(reader, Serialise(batch), 1000), expected);
+}
+
+TEST(MessageFramingTests, BadMagicIsDetected)
+{
+  FrameReader reader{};
+
+  std::memset(reader.write_pointer(), 0xAB, MessageFraming::HEADER_SIZE);
+
+  bool const called =
+      reader.Commit(MessageFraming::HEADER_SIZE, [](message_type const &) { FAIL(); }) ==
+      FrameReader::Status::BAD_MAGIC;
+
+  EXPECT_TRUE(called);
+  EXPECT_EQ(reader.last_header().size(), MessageFraming::HEADER_SIZE);
+}
+
+}  // namespace
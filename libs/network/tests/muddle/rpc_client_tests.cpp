@@ -0,0 +1,257 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/byte_array/const_byte_array.hpp"
+#include "core/mutex.hpp"
+#include "network/details/thread_pool.hpp"
+#include "network/muddle/muddle_endpoint.hpp"
+#include "network/muddle/network_id.hpp"
+#include "network/muddle/rpc/client.hpp"
+#include "network/service/message_types.hpp"
+#include "network/service/promise.hpp"
+#include "network/service/types.hpp"
+
+#include "gtest/gtest.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using fetch::byte_array::ConstByteArray;
+using fetch::muddle::MuddleEndpoint;
+using fetch::muddle::NetworkId;
+using fetch::network::MakeThreadPool;
+using fetch::service::MakePromise;
+using fetch::service::PromiseCounter;
+using fetch::service::SERVICE_RESULT;
+using fetch::service::serializer_type;
+
+using RpcClient = fetch::muddle::rpc::Client;
+using Promise   = fetch::service::Promise;
+
+constexpr uint16_t SERVICE  = 10;
+constexpr uint16_t CHANNEL  = 12;
+constexpr uint64_t PROTOCOL = 1;
+constexpr uint64_t FUNCTION = 2;
+
+// Endpoint which records the exchanges made through it so that they can be resolved by the test
+class FakeEndpoint : public MuddleEndpoint
+{
+public:
+  struct Record
+  {
+    Address        address;
+    PromiseCounter call_id;
+    Promise        promise;
+  };
+
+  void Send(Address const &, uint16_t, uint16_t, Payload const &) override
+  {}
+
+  void Send(Address const &, uint16_t, uint16_t, uint16_t, Payload const &) override
+  {}
+
+  void Broadcast(uint16_t, uint16_t, Payload const &) override
+  {}
+
+  Response Exchange(Address const &address, uint16_t, uint16_t, Payload const &request) override
+  {
+    // extract the id of the call promise from the request
+    serializer_type                             params{request};
+    fetch::service::service_classification_type type{};
+    PromiseCounter                              call_id{};
+    params >> type >> call_id;
+
+    Promise promise = MakePromise();
+
+    FETCH_LOCK(lock_);
+    exchanges_.push_back({address, call_id, promise});
+
+    return Response{promise};
+  }
+
+  SubscriptionPtr Subscribe(uint16_t, uint16_t) override
+  {
+    return {};
+  }
+
+  SubscriptionPtr Subscribe(Address const &, uint16_t, uint16_t) override
+  {
+    return {};
+  }
+
+  NetworkId const &network_id() const override
+  {
+    return network_id_;
+  }
+
+  AddressList GetDirectlyConnectedPeers() const override
+  {
+    return {};
+  }
+
+  std::vector<Record> exchanges()
+  {
+    FETCH_LOCK(lock_);
+    return exchanges_;
+  }
+
+  // Fulfill an exchange with the response the remote server would have sent
+  static void Respond(Record const &exchange, ConstByteArray const &value)
+  {
+    serializer_type response;
+    response << SERVICE_RESULT << exchange.call_id << value;
+
+    exchange.promise->Fulfill(response.data());
+  }
+
+private:
+  NetworkId           network_id_{"TEST"};
+  fetch::Mutex        lock_{__LINE__, __FILE__};
+  std::vector<Record> exchanges_;
+};
+
+class RpcClientTests : public ::testing::Test
+{
+protected:
+  Promise Call(RpcClient &client, std::string const &address, ConstByteArray const &value)
+  {
+    return client.CallSpecificAddress(address, PROTOCOL, FUNCTION, value);
+  }
+
+  FakeEndpoint endpoint_;
+};
+
+TEST_F(RpcClientTests, CallCompletesWhenResponseArrives)
+{
+  RpcClient client{"Client", endpoint_, SERVICE, CHANNEL};
+
+  auto promise = Call(client, "peer", "hello");
+  EXPECT_TRUE(promise->IsWaiting());
+
+  auto const exchanges = endpoint_.exchanges();
+  ASSERT_EQ(exchanges.size(), 1u);
+  EXPECT_EQ(exchanges[0].address, ConstByteArray{"peer"});
+
+  // without an executor the call is completed immediately by the delivering thread
+  FakeEndpoint::Respond(exchanges[0], "world");
+
+  ASSERT_TRUE(promise->IsSuccessful());
+  EXPECT_EQ(promise->As<ConstByteArray>(), ConstByteArray{"world"});
+}
+
+TEST_F(RpcClientTests, CallFailsWhenExchangeFails)
+{
+  RpcClient client{"Client", endpoint_, SERVICE, CHANNEL};
+
+  auto promise = Call(client, "peer", "hello");
+
+  auto const exchanges = endpoint_.exchanges();
+  ASSERT_EQ(exchanges.size(), 1u);
+
+  // e.g. the connection was lost or the exchange timed out
+  exchanges[0].promise->Fail();
+
+  EXPECT_TRUE(promise->IsFailed());
+  EXPECT_THROW(promise->As<ConstByteArray>(), std::runtime_error);
+}
+
+TEST_F(RpcClientTests, CallCompletedOnExecutor)
+{
+  auto executor = MakeThreadPool(1, "RpcExec");
+  executor->Start();
+
+  {
+    RpcClient client{"Client", endpoint_, SERVICE, CHANNEL, executor};
+
+    auto promise = Call(client, "peer", "hello");
+
+    std::thread::id handler_thread{};
+    promise->WithHandlers().Then(
+        [&handler_thread]() { handler_thread = std::this_thread::get_id(); });
+
+    auto const exchanges = endpoint_.exchanges();
+    ASSERT_EQ(exchanges.size(), 1u);
+    FakeEndpoint::Respond(exchanges[0], "world");
+
+    ASSERT_TRUE(promise->Wait(5000u));
+    EXPECT_EQ(promise->As<ConstByteArray>(), ConstByteArray{"world"});
+
+    // handlers are run after waiters are woken up
+    while (handler_thread == std::thread::id{})
+    {
+      std::this_thread::yield();
+    }
+
+    EXPECT_NE(handler_thread, std::this_thread::get_id());
+  }
+
+  executor->Stop();
+}
+
+TEST_F(RpcClientTests, ConcurrentCallsUseTheirOwnAddress)
+{
+  static constexpr std::size_t NUM_THREADS = 4;
+  static constexpr std::size_t NUM_CALLS   = 100;
+
+  RpcClient client{"Client", endpoint_, SERVICE, CHANNEL};
+
+  std::vector<std::vector<Promise>> promises(NUM_THREADS);
+  std::vector<std::thread>          threads;
+  for (std::size_t i = 0; i < NUM_THREADS; ++i)
+  {
+    threads.emplace_back([this, &client, &promises, i]() {
+      std::string const address = "peer" + std::to_string(i);
+      for (std::size_t call = 0; call < NUM_CALLS; ++call)
+      {
+        promises[i].push_back(Call(client, address, address));
+      }
+    });
+  }
+
+  for (auto &thread : threads)
+  {
+    thread.join();
+  }
+
+  auto const exchanges = endpoint_.exchanges();
+  ASSERT_EQ(exchanges.size(), NUM_THREADS * NUM_CALLS);
+
+  // respond to every call by echoing the address the call was sent to
+  for (auto const &exchange : exchanges)
+  {
+    FakeEndpoint::Respond(exchange, exchange.address);
+  }
+
+  for (std::size_t i = 0; i < NUM_THREADS; ++i)
+  {
+    for (auto const &promise : promises[i])
+    {
+      ASSERT_TRUE(promise->IsSuccessful());
+      EXPECT_EQ(promise->As<ConstByteArray>(), ConstByteArray{"peer" + std::to_string(i)});
+    }
+  }
+}
+
+}  // namespace
@@ -585,6 +585,104 @@ void TestCase7(std::string host, uint16_t port)
   }
 }
 
+template <std::size_t N = 1>
+void TestCase8(std::string host, uint16_t port)
+{
+  std::cerr << "\nTEST CASE 8. Threads: " << N << std::endl;
+  std::cerr << "Verify ordering of many small packets, bidirectional at once" << std::endl;
+
+  NetworkManager nmanager{"NetMgr", N};
+  nmanager.Start();
+
+  for (std::size_t index = 0; index < 3; ++index)
+  {
+    std::unique_ptr<Server> server = std::make_unique<Server>(port, nmanager);
+    server->Start();
+
+    waitUntilConnected(host, port);
+
+    {
+      FETCH_LOCK(messages_);
+      globalMessagesFromServer_.clear();
+    }
+
+    // Many small packets which will be coalesced into batched writes and reads
+    std::vector<message_type> to_send;
+    for (std::size_t i = 0; i < 10000; ++i)
+    {
+      to_send.push_back(std::to_string(i));
+    }
+
+    auto client = std::make_shared<Client>(host, port, nmanager);
+    if (!(client->WaitForAlive(1000)))
+    {
+      FETCH_LOG_ERROR(LOGGING_NAME, "Client never opened!");
+      throw 1;
+    }
+
+    std::mutex                messages_recieve;
+    std::vector<message_type> recieved_client;
+
+    client->OnMessage([&](message_type const &msg) {
+      FETCH_LOCK(messages_recieve);
+      recieved_client.push_back(msg);
+    });
+
+    for (auto const &msg : to_send)
+    {
+      client->Send(msg);
+    }
+
+    // wait for the server to see the connection before broadcasting back
+    for (;;)
+    {
+      {
+        FETCH_LOCK(messages_);
+        if (globalMessagesFromServer_.size() == to_send.size())
+        {
+          break;
+        }
+      }
+
+      std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+
+    for (auto const &msg : to_send)
+    {
+      server->Broadcast(msg);
+    }
+
+    for (;;)
+    {
+      {
+        FETCH_LOCK(messages_recieve);
+        if (recieved_client.size() == to_send.size())
+        {
+          break;
+        }
+      }
+
+      std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+
+    FETCH_LOCK(messages_);
+    FETCH_LOCK(messages_recieve);
+
+    // a single connection must preserve the order of the messages
+    if (globalMessagesFromServer_ != to_send)
+    {
+      FETCH_LOG_ERROR(LOGGING_NAME, "Client->server messages out of order.");
+      throw 1;
+    }
+
+    if (recieved_client != to_send)
+    {
+      FETCH_LOG_ERROR(LOGGING_NAME, "Server->client messages out of order.");
+      throw 1;
+    }
+  }
+}
+
 class TCPClientServerTest : public testing::TestWithParam<std::size_t>
 {
 public:
@@ -611,6 +709,7 @@ TEST_P(TCPClientServerTest, DISABLED_basic_test)
     TestCase5<1>(host, port_number);
     TestCase6<1>(host, port_number);
     TestCase7<1>(host, port_number);
+    TestCase8<1>(host, port_number);
 
     TestCase0<10>(host, port_number);
     TestCase1<10>(host, port_number);
@@ -620,6 +719,7 @@ TEST_P(TCPClientServerTest, DISABLED_basic_test)
     TestCase5<10>(host, port_number);
     TestCase6<10>(host, port_number);
     TestCase7<10>(host, port_number);
+    TestCase8<10>(host, port_number);
   }
 }
 
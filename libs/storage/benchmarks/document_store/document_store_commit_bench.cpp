@@ -0,0 +1,121 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/byte_array/const_byte_array.hpp"
+#include "core/random/lfg.hpp"
+#include "storage/new_revertible_document_store.hpp"
+#include "storage/resource_mapper.hpp"
+
+#include "benchmark/benchmark.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+using fetch::byte_array::ConstByteArray;
+using fetch::random::LaggedFibonacciGenerator;
+using fetch::storage::NewRevertibleDocumentStore;
+using fetch::storage::ResourceAddress;
+using fetch::storage::ResourceID;
+
+namespace {
+
+using Writes = std::vector<std::pair<ResourceID, ConstByteArray>>;
+
+// Generate a block worth of writes: a mix of updates to existing keys and new keys
+Writes GenerateWrites(LaggedFibonacciGenerator<> &lfg, std::size_t count, std::size_t key_space,
+                      std::size_t value_size)
+{
+  Writes writes;
+  writes.reserve(count);
+
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    std::string value(value_size, '\0');
+    for (auto &c : value)
+    {
+      c = static_cast<char>(lfg());
+    }
+
+    writes.emplace_back(ResourceAddress(std::to_string(lfg() % key_space)), ConstByteArray(value));
+  }
+
+  return writes;
+}
+
+// Args: {writes per commit, value size}
+void StateCommitArgs(benchmark::internal::Benchmark *b)
+{
+  for (int64_t const writes : {100, 1000, 10000})
+  {
+    for (int64_t const size : {64, 1024})
+    {
+      b->Args({writes, size});
+    }
+  }
+}
+
+template <bool BATCHED>
+void DocumentStore_Commit(benchmark::State &state)
+{
+  auto const num_writes = static_cast<std::size_t>(state.range(0));
+  auto const value_size = static_cast<std::size_t>(state.range(1));
+
+  NewRevertibleDocumentStore store;
+  store.New("doc_bench_state.db", "doc_bench_state_deltas.db", "doc_bench_index.db",
+            "doc_bench_index_deltas.db", true);
+
+  LaggedFibonacciGenerator<> lfg;
+
+  for (auto _ : state)
+  {
+    state.PauseTiming();
+    auto const writes = GenerateWrites(lfg, num_writes, 4 * num_writes, value_size);
+    state.ResumeTiming();
+
+    if (BATCHED)
+    {
+      store.BeginBatch();
+    }
+
+    for (auto const &write : writes)
+    {
+      store.Set(write.first, write.second);
+    }
+
+    if (BATCHED)
+    {
+      store.CommitBatch();
+    }
+
+    benchmark::DoNotOptimize(store.Commit());
+  }
+
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(num_writes));
+}
+
+}  // namespace
+
+BENCHMARK_TEMPLATE(DocumentStore_Commit, false)
+    ->Apply(StateCommitArgs)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(DocumentStore_Commit, true)
+    ->Apply(StateCommitArgs)
+    ->Unit(benchmark::kMillisecond);
@@ -0,0 +1,101 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/byte_array/const_byte_array.hpp"
+#include "core/random/lfg.hpp"
+#include "storage/new_revertible_document_store.hpp"
+#include "storage/resource_mapper.hpp"
+
+#include "benchmark/benchmark.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+using fetch::byte_array::ConstByteArray;
+using fetch::random::LaggedFibonacciGenerator;
+using fetch::storage::NewRevertibleDocumentStore;
+using fetch::storage::ResourceAddress;
+using fetch::storage::ResourceID;
+
+namespace {
+
+constexpr std::size_t NUM_KEYS       = 10000;
+constexpr std::size_t NUM_HOT_KEYS   = 100;
+constexpr std::size_t VALUE_SIZE     = 64;
+constexpr std::size_t CACHE_CAPACITY = 4u * 1024u * 1024u;
+
+using StorePtr = std::unique_ptr<NewRevertibleDocumentStore>;
+using Keys     = std::vector<ResourceID>;
+
+StorePtr store;
+Keys     keys;
+
+void Setup(std::size_t cache_capacity)
+{
+  store = std::make_unique<NewRevertibleDocumentStore>();
+  store->New("doc_read_bench_state.db", "doc_read_bench_state_deltas.db",
+             "doc_read_bench_index.db", "doc_read_bench_index_deltas.db", true);
+  store->EnableCache("read_bench", cache_capacity);
+
+  keys.clear();
+  store->BeginBatch();
+  for (std::size_t i = 0; i < NUM_KEYS; ++i)
+  {
+    keys.emplace_back(ResourceAddress(std::to_string(i)));
+    store->Set(keys.back(), ConstByteArray(std::string(VALUE_SIZE, static_cast<char>(i))));
+  }
+  store->CommitBatch();
+  store->Commit();
+}
+
+// Args: {cache enabled}. Nine in ten reads are of a small set of hot keys (token balances and the
+// like) while other readers compete for the store
+void DocumentStore_Read(benchmark::State &state)
+{
+  bool const cached = state.range(0) != 0;
+
+  if (state.thread_index == 0)
+  {
+    Setup(cached ? CACHE_CAPACITY : 0);
+  }
+
+  LaggedFibonacciGenerator<> lfg(static_cast<uint64_t>(state.thread_index) + 1u);
+
+  for (auto _ : state)
+  {
+    uint64_t const    value = lfg();
+    std::size_t const index =
+        ((value % 10) != 0) ? ((value >> 8u) % NUM_HOT_KEYS) : ((value >> 8u) % NUM_KEYS);
+
+    benchmark::DoNotOptimize(store->Get(keys[index]));
+  }
+
+  if (state.thread_index == 0)
+  {
+    store.reset();
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+
+}  // namespace
+
+BENCHMARK(DocumentStore_Read)->Arg(0)->Arg(1)->ThreadRange(1, 8)->UseRealTime();
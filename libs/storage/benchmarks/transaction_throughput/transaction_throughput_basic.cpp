@@ -19,6 +19,7 @@
 #include "core/byte_array/byte_array.hpp"
 #include "core/byte_array/const_byte_array.hpp"
 #include "core/random/lcg.hpp"
+#include "core/reactor.hpp"
 #include "crypto/ecdsa.hpp"
 #include "ledger/chain/transaction_builder.hpp"
 #include "ledger/chain/transaction_rpc_serializers.hpp"
@@ -27,6 +28,8 @@
 
 #include "benchmark/benchmark.h"
 
+#include <cstddef>
+#include <memory>
 #include <vector>
 
 using fetch::byte_array::ByteArray;
@@ -133,4 +136,66 @@ void TxSubmitWrites(benchmark::State &state)
 
 BENCHMARK(TxSubmitWrites)->Ranges({{0, 1}, {1, 1000000}});
 
+// Clients concurrently set, read and confirm transactions in the transient store while the write
+// back worker drains confirmations to disk in the background
+void TransientStoreConcurrentClients(benchmark::State &state)
+{
+  static constexpr std::size_t TX_PER_THREAD = 1024;
+
+  static std::unique_ptr<TransactionStore>     store;
+  static std::unique_ptr<fetch::core::Reactor> reactor;
+  static std::vector<TransactionList>          transactions;
+
+  if (state.thread_index == 0)
+  {
+    store = std::make_unique<TransactionStore>(2);
+    store->New("transient_transaction.db", "transient_transaction_index.db", true);
+
+    reactor = std::make_unique<fetch::core::Reactor>("TxStoreBench");
+    reactor->Attach(store->GetWeakRunnable());
+    reactor->Start();
+
+    if (transactions.size() < static_cast<std::size_t>(state.threads))
+    {
+      transactions.resize(static_cast<std::size_t>(state.threads));
+      for (auto &list : transactions)
+      {
+        if (list.empty())
+        {
+          list = GenerateTransactions(TX_PER_THREAD, false);
+        }
+      }
+    }
+  }
+
+  Transaction retrieved;
+  std::size_t index = 0;
+
+  for (auto _ : state)
+  {
+    auto const &tx = *transactions[static_cast<std::size_t>(state.thread_index)][index];
+    index          = (index + 1) % TX_PER_THREAD;
+
+    ResourceID const rid{tx.digest()};
+
+    store->Set(rid, tx, false);
+    store->Has(rid);
+    store->Get(rid, retrieved);
+    store->Confirm(rid);
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+
+  if (state.thread_index == 0)
+  {
+    state.counters["pending"] = static_cast<double>(store->PendingConfirmations());
+
+    reactor->Stop();
+    reactor.reset();
+    store.reset();
+  }
+}
+
+BENCHMARK(TransientStoreConcurrentClients)->ThreadRange(1, 8)->UseRealTime();
+
 BENCHMARK_MAIN();
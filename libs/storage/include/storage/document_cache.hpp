@@ -0,0 +1,128 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/byte_array/const_byte_array.hpp"
+#include "crypto/fnv.hpp"  // needed for std::hash<ConstByteArray>
+#include "telemetry/telemetry.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace fetch {
+namespace storage {
+
+/**
+ * Bounded, in memory cache of recently read documents, keyed by resource address.
+ *
+ * The cache is split into a number of independently locked shards, each with its own least
+ * recently used list, so that concurrent lookups of different documents do not contend. The
+ * capacity is measured in bytes of document data and is divided evenly between the shards.
+ *
+ * The cache is disabled (zero capacity) unless a capacity is given. Telemetry is only exported
+ * once the owner has named the cache, so that each cache reports its own labelled series.
+ */
+class DocumentCache
+{
+public:
+  using ConstByteArray = byte_array::ConstByteArray;
+
+  static constexpr std::size_t NUM_SHARDS       = 16;
+  static constexpr std::size_t DEFAULT_CAPACITY = 4u * 1024u * 1024u;  // bytes, when enabled
+
+  // Construction / Destruction
+  explicit DocumentCache(std::size_t capacity = 0);
+  DocumentCache(DocumentCache const &) = delete;
+  DocumentCache(DocumentCache &&)      = delete;
+  ~DocumentCache()                     = default;
+
+  /// @name Cache Operations
+  /// @{
+  bool Lookup(ConstByteArray const &key, ConstByteArray &document);
+  void Add(ConstByteArray const &key, ConstByteArray const &document);
+  void Erase(ConstByteArray const &key);
+  void Clear();
+  /// @}
+
+  /// @name Accessors
+  /// @{
+  void        SetName(std::string const &name);
+  void        SetCapacity(std::size_t capacity);
+  bool        enabled() const;
+  std::size_t capacity() const;
+  std::size_t size() const;
+  std::size_t size_in_bytes() const;
+  uint64_t    hits() const;
+  uint64_t    misses() const;
+  uint64_t    evictions() const;
+  /// @}
+
+  // Operators
+  DocumentCache &operator=(DocumentCache const &) = delete;
+  DocumentCache &operator=(DocumentCache &&) = delete;
+
+private:
+  using Mutex   = std::mutex;
+  using Counter = std::atomic<uint64_t>;
+  using KeyList = std::list<ConstByteArray>;
+
+  struct Element
+  {
+    ConstByteArray    document;
+    KeyList::iterator position;
+  };
+
+  using ElementMap = std::unordered_map<ConstByteArray, Element>;
+
+  struct Shard
+  {
+    mutable Mutex lock;
+    KeyList       recently_used;  ///< Keys in order of use, most recent first
+    ElementMap    elements;
+    std::size_t   size_in_bytes{0};
+    std::size_t   capacity{0};
+  };
+
+  using Shards = std::array<Shard, NUM_SHARDS>;
+
+  Shard &LookupShard(ConstByteArray const &key);
+  void   EvictLocked(Shard &shard, std::size_t capacity);
+  void   EraseLocked(Shard &shard, ElementMap::iterator it);
+
+  Shards            shards_;
+  std::atomic<bool> enabled_{false};
+  Counter           hits_{0};
+  Counter           misses_{0};
+  Counter           evictions_{0};
+
+  /// @name Telemetry (only present once the cache has been named)
+  /// @{
+  telemetry::CounterPtr hit_count_;
+  telemetry::CounterPtr miss_count_;
+  telemetry::CounterPtr eviction_count_;
+  /// @}
+};
+
+}  // namespace storage
+}  // namespace fetch
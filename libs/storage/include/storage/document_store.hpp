@@ -18,13 +18,23 @@
 //------------------------------------------------------------------------------
 
 #include "core/byte_array/byte_array.hpp"
+#include "crypto/hash.hpp"
+#include "crypto/sha256.hpp"
+#include "storage/document_cache.hpp"
 #include "storage/file_object.hpp"
 #include "storage/key_value_index.hpp"
 #include "storage/resource_mapper.hpp"
+#include "vectorise/threading/pool.hpp"
 
+#include <algorithm>
 #include <cassert>
+#include <exception>
 #include <fstream>
+#include <future>
+#include <map>
 #include <memory>
+#include <utility>
+#include <vector>
 
 #include "core/mutex.hpp"
 #include "network/service/protocol.hpp"
@@ -33,6 +43,14 @@
 namespace fetch {
 namespace storage {
 
+/**
+ * The pool shared by all document stores for hashing large write batches. It is sized to the
+ * hardware concurrency, so concurrent commits queue their work rather than adding threads.
+ *
+ * @return: the process wide hashing pool
+ */
+threading::Pool &DocumentHashPool();
+
 /**
  * DocumentStore maps keys to serialized data (documents) which is stored on
  * your filesystem
@@ -41,6 +59,17 @@ namespace storage {
  * to locations
  * in the document store
  *
+ * Writes can optionally be grouped into a write batch (BeginBatch / CommitBatch). While a batch
+ * is open sets and erases are buffered in memory and only applied, in key order, when the batch
+ * is committed. This allows the document hashes to be computed in parallel, the merkle tree to be
+ * rehashed once for the whole batch and the underlying files to be flushed once, while producing
+ * the same root hash as the equivalent sequence of individual writes.
+ *
+ * Recently read documents can optionally be kept in a bounded in memory cache (see EnableCache).
+ * Lookups which hit the cache do not take the store lock, so hot documents can be read
+ * concurrently and while writes are in progress. Entries are invalidated by Set and Erase, and the
+ * whole cache is dropped whenever the store is loaded or reverted.
+ *
  */
 template <std::size_t BLOCK_SIZE = 2048, typename A = FileBlockType<BLOCK_SIZE>,
           typename B = KeyValueIndex<>, typename C = VersionedRandomAccessStack<A>,
@@ -50,6 +79,7 @@ class DocumentStore
 public:
   using self_type       = DocumentStore<BLOCK_SIZE, A, B, C, D>;
   using byte_array_type = byte_array::ByteArray;
+  using KeyValues       = std::vector<std::pair<ResourceID, byte_array::ConstByteArray>>;
 
   using file_block_type      = A;
   using key_value_index_type = B;
@@ -63,6 +93,9 @@ public:
 
   static constexpr char const *LOGGING_NAME = "DocumentStore";
 
+  // The minimum number of documents in a batch for each additional hashing thread
+  static constexpr std::size_t MIN_DOCUMENTS_PER_HASH_THREAD = 64;
+
   DocumentStore()                         = default;
   DocumentStore(DocumentStore const &rhs) = delete;
   DocumentStore(DocumentStore &&rhs)      = delete;
@@ -73,6 +106,8 @@ public:
             std::string const &index_diff, bool const &create = true)
   {
     FETCH_LOCK(mutex_);
+    ClearBatch();
+    cache_.Clear();
     file_object_.Load(doc_file, doc_diff, create);
     key_index_.Load(index_file, index_diff, create);
   }
@@ -81,6 +116,8 @@ public:
            std::string const &index_diff)
   {
     FETCH_LOCK(mutex_);
+    ClearBatch();
+    cache_.Clear();
     file_object_.New(doc_file, doc_diff);
     key_index_.New(index_file, index_diff);
   }
@@ -88,6 +125,8 @@ public:
   void Load(std::string const &doc_file, std::string const &index_file, bool const &create = true)
   {
     FETCH_LOCK(mutex_);
+    ClearBatch();
+    cache_.Clear();
     file_object_.Load(doc_file, create);
     key_index_.Load(index_file, create);
   }
@@ -95,6 +134,8 @@ public:
   void New(std::string const &doc_file, std::string const &index_file)
   {
     FETCH_LOCK(mutex_);
+    ClearBatch();
+    cache_.Clear();
     file_object_.New(doc_file);
     key_index_.New(index_file);
   }
@@ -104,14 +145,51 @@ public:
     byte_array::ConstByteArray const &address = rid.id();
     index_type                        index   = 0;
 
+    // Cached documents are always up to date, since they are invalidated (under the lock) before
+    // any change to the document is made visible
+    byte_array::ConstByteArray cached;
+    if (cache_.Lookup(address, cached))
+    {
+      Document document;
+      document.document = cached.Copy();
+      return document;
+    }
+
     FETCH_LOCK(mutex_);
 
+    // Writes which are still buffered in an open batch take precedence over the stored documents
+    if (batch_open_)
+    {
+      auto const it = batch_.find(address);
+      if (it != batch_.end())
+      {
+        Document document;
+
+        if (!it->second.erase)
+        {
+          document.document = it->second.value.Copy();
+        }
+        else if (!create)
+        {
+          document.failed = true;
+        }
+
+        return document;
+      }
+    }
+
     // If the file already exists, seek to it
     if (key_index_.GetIfExists(address, index))
     {
       file_object_.SeekFile(index);
+
+      Document document = file_object_.AsDocument();
+      cache_.Add(address, document.document.Copy());
+
+      return document;
     }
-    else if (create)
+
+    if (create)
     {
       // Else create
       file_object_.CreateNewFile();
@@ -137,6 +215,13 @@ public:
     index_type                        index   = 0;
 
     FETCH_LOCK(mutex_);
+    cache_.Erase(address);
+
+    if (batch_open_)
+    {
+      batch_[address] = PendingWrite{false, value.Copy()};
+      return;
+    }
 
     if (key_index_.GetIfExists(address, index))
     {
@@ -158,12 +243,47 @@ public:
     key_index_.Flush();
   }
 
+  /**
+   * Write several documents in a single locked step. The writes are applied as one batch, so the
+   * merkle tree is rehashed and the files are flushed only once. If a batch is already open the
+   * writes are simply added to it.
+   *
+   * @param: values The keys and documents to be written
+   */
+  void SetMany(KeyValues const &values)
+  {
+    FETCH_LOCK(mutex_);
+
+    WriteBatch  local_batch;
+    WriteBatch &batch = batch_open_ ? batch_ : local_batch;
+
+    for (auto const &value : values)
+    {
+      byte_array::ConstByteArray const &address = value.first.id();
+
+      cache_.Erase(address);
+      batch[address] = PendingWrite{false, value.second.Copy()};
+    }
+
+    if (!batch_open_)
+    {
+      ApplyWrites(local_batch);
+    }
+  }
+
   void Erase(ResourceID const &rid)
   {
     byte_array::ConstByteArray const &address = rid.id();
     index_type                        index   = 0;
 
     FETCH_LOCK(mutex_);
+    cache_.Erase(address);
+
+    if (batch_open_)
+    {
+      batch_[address] = PendingWrite{true, {}};
+      return;
+    }
 
     if (key_index_.GetIfExists(address, index))
     {
@@ -184,15 +304,84 @@ public:
   void Flush(bool lazy = true)
   {
     FETCH_LOCK(mutex_);
+    ApplyBatch();
     file_object_.Flush(lazy);
     key_index_.Flush(lazy);
   }
 
+  /**
+   * Open a write batch. Until the batch is committed, Set and Erase only record the change (later
+   * writes to a key replace earlier ones) and Get / GetOrCreate see the buffered values. Iteration,
+   * size and the tree hash reflect the stored documents only, although Commit, CurrentHash and
+   * Flush will commit an open batch before proceeding.
+   */
+  void BeginBatch()
+  {
+    FETCH_LOCK(mutex_);
+    batch_open_ = true;
+  }
+
+  /**
+   * Apply all the writes buffered since BeginBatch in a single pass and close the batch
+   */
+  void CommitBatch()
+  {
+    FETCH_LOCK(mutex_);
+    ApplyBatch();
+  }
+
+  /**
+   * Drop all the writes buffered since BeginBatch and close the batch
+   */
+  void DiscardBatch()
+  {
+    FETCH_LOCK(mutex_);
+    ClearBatch();
+  }
+
+  bool InBatch() const
+  {
+    FETCH_LOCK(mutex_);
+    return batch_open_;
+  }
+
+  std::size_t batch_size() const
+  {
+    FETCH_LOCK(mutex_);
+    return batch_.size();
+  }
+
   std::size_t size() const
   {
     return key_index_.size();
   }
 
+  /**
+   * Enable the read cache. Must be called before the store is shared between threads.
+   *
+   * @param name The name of the store, used to label the cache telemetry
+   * @param capacity The maximum number of bytes of document data kept in the cache
+   */
+  void EnableCache(std::string const &name,
+                   std::size_t        capacity = DocumentCache::DEFAULT_CAPACITY)
+  {
+    cache_.SetName(name);
+    cache_.SetCapacity(capacity);
+  }
+
+  /**
+   * Set the maximum number of bytes of document data kept in the read cache, zero disables it
+   */
+  void SetCacheCapacity(std::size_t capacity)
+  {
+    cache_.SetCapacity(capacity);
+  }
+
+  DocumentCache const &cache() const
+  {
+    return cache_;
+  }
+
   /**
    * STL-like functionality achieved with an iterator class. This has to wrap an
    * iterator to the
@@ -291,6 +480,8 @@ public:
   byte_array_type Commit()
   {
     FETCH_LOCK(mutex_);
+    ApplyBatch();
+
     byte_array_type hash = key_index_.Hash();
 
     if (key_index_.underlying_stack().HashExists(hash) ||
@@ -309,6 +500,8 @@ public:
   bool RevertToHash(byte_array_type const &hash)
   {
     FETCH_LOCK(mutex_);
+    ClearBatch();
+    cache_.Clear();
 
     // TODO(private issue 615): HashExists implement
     if (!(key_index_.underlying_stack().HashExists(hash) &&
@@ -327,6 +520,19 @@ public:
     return true;
   }
 
+  /**
+   * Configure the checkpoints of both underlying files, which must support them
+   *
+   * @param interval The number of commits between checkpoints, zero disables checkpoints
+   * @param max_checkpoints The maximum number of checkpoints kept
+   */
+  void SetCheckpointPolicy(uint64_t interval, uint64_t max_checkpoints)
+  {
+    FETCH_LOCK(mutex_);
+    key_index_.underlying_stack().SetCheckpointPolicy(interval, max_checkpoints);
+    file_object_.underlying_stack().SetCheckpointPolicy(interval, max_checkpoints);
+  }
+
   bool HashExists(byte_array_type const &hash)
   {
     FETCH_LOCK(mutex_);
@@ -337,13 +543,177 @@ public:
   hash_type CurrentHash()
   {
     FETCH_LOCK(mutex_);
+    ApplyBatch();
     return key_index_.Hash();
   }
 
 protected:
-  Mutex                mutex_{__LINE__, __FILE__};
+  struct PendingWrite
+  {
+    bool                       erase{false};
+    byte_array::ConstByteArray value;
+  };
+
+  // Ordered so that a batch is always applied in key order
+  using WriteBatch  = std::map<byte_array::ConstByteArray, PendingWrite>;
+  using BatchedSets = std::vector<typename WriteBatch::value_type const *>;
+
+  mutable Mutex        mutex_{__LINE__, __FILE__};
   key_value_index_type key_index_;
   file_object_type     file_object_;
+  WriteBatch           batch_;
+  bool                 batch_open_{false};
+  DocumentCache        cache_;
+
+  void ClearBatch()
+  {
+    batch_.clear();
+    batch_open_ = false;
+  }
+
+  /**
+   * Apply the open batch (if any) and close it. Must be called with the mutex held.
+   */
+  void ApplyBatch()
+  {
+    if (!batch_open_)
+    {
+      return;
+    }
+
+    WriteBatch batch;
+    std::swap(batch, batch_);
+    batch_open_ = false;
+
+    ApplyWrites(batch);
+  }
+
+  /**
+   * Apply a set of buffered writes. Erasures are applied first since they restructure the tree and
+   * flush it, then the documents are written and the merkle tree is rehashed once for all of them.
+   * Must be called with the mutex held.
+   *
+   * @param: batch The writes to be applied
+   */
+  void ApplyWrites(WriteBatch const &batch)
+  {
+    BatchedSets sets;
+    sets.reserve(batch.size());
+
+    index_type index = 0;
+    for (auto const &write : batch)
+    {
+      if (!write.second.erase)
+      {
+        sets.push_back(&write);
+      }
+      else if (key_index_.GetIfExists(write.first, index))
+      {
+        file_object_.SeekFile(index);
+
+        key_index_.Erase(write.first);
+        file_object_.Erase();
+      }
+    }
+
+    std::vector<hash_type> const hashes = HashDocuments(sets);
+
+    key_index_.BeginBatch();
+
+    for (std::size_t i = 0; i < sets.size(); ++i)
+    {
+      byte_array::ConstByteArray const &address = sets[i]->first;
+      byte_array::ConstByteArray const &value   = sets[i]->second.value;
+
+      if (key_index_.GetIfExists(address, index))
+      {
+        file_object_.SeekFile(index);
+      }
+      else
+      {
+        file_object_.CreateNewFile(value.size());
+      }
+
+      file_object_.Resize(value.size());
+      file_object_.Write(value);
+
+      key_index_.Set(address, file_object_.id(), hashes[i]);
+    }
+
+    key_index_.CommitBatch();
+
+    file_object_.Flush();
+    key_index_.Flush();
+  }
+
+  /**
+   * Compute the hash of each of the documents to be written, matching FileObject::Hash. Large
+   * batches are split across the shared hashing pool.
+   *
+   * @param: sets The buffered writes
+   *
+   * @return: the document hashes, in the same order as sets
+   */
+  static std::vector<hash_type> HashDocuments(BatchedSets const &sets)
+  {
+    std::vector<hash_type> hashes(sets.size());
+
+    auto const hash_range = [&sets, &hashes](std::size_t begin, std::size_t end) {
+      for (std::size_t i = begin; i < end; ++i)
+      {
+        hashes[i] = crypto::Hash<crypto::SHA256>(sets[i]->second.value);
+      }
+    };
+
+    threading::Pool &pool = DocumentHashPool();
+
+    std::size_t const num_threads =
+        std::min(pool.concurrency(), (sets.size() / MIN_DOCUMENTS_PER_HASH_THREAD) + 1);
+
+    if (num_threads <= 1)
+    {
+      hash_range(0, sets.size());
+      return hashes;
+    }
+
+    std::size_t const              chunk = (sets.size() + num_threads - 1) / num_threads;
+    std::vector<std::future<void>> pending;
+    pending.reserve(num_threads - 1);
+
+    // the calling thread hashes the first chunk itself
+    for (std::size_t begin = chunk; begin < sets.size(); begin += chunk)
+    {
+      pending.emplace_back(pool.Dispatch(hash_range, begin, std::min(begin + chunk, sets.size())));
+    }
+
+    // the other chunks refer to this frame, so they must finish before it unwinds
+    std::exception_ptr error;
+    try
+    {
+      hash_range(0, std::min(chunk, sets.size()));
+    }
+    catch (...)
+    {
+      error = std::current_exception();
+    }
+
+    for (auto &result : pending)
+    {
+      result.wait();
+    }
+
+    if (error)
+    {
+      std::rethrow_exception(error);
+    }
+
+    for (auto &result : pending)
+    {
+      result.get();
+    }
+
+    return hashes;
+  }
 };
 
 }  // namespace storage
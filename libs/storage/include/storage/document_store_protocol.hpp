@@ -20,15 +20,18 @@
 #include "core/byte_array/encoders.hpp"
 #include "core/mutex.hpp"
 #include "core/synchronisation/protected.hpp"
+#include "network/service/call_context.hpp"
 #include "network/service/protocol.hpp"
 #include "storage/document_store.hpp"
 #include "storage/new_revertible_document_store.hpp"
+#include "storage/object_store_protocol.hpp"
 #include "telemetry/counter.hpp"
 #include "telemetry/histogram.hpp"
 #include "telemetry/registry.hpp"
 #include "telemetry/utils/timer.hpp"
 
 #include <map>
+#include <vector>
 
 namespace fetch {
 namespace storage {
@@ -40,7 +43,11 @@ public:
   using lane_type              = uint32_t;  // TODO(issue 12): Fetch from some other palce
   using CallContext            = service::CallContext;
 
-  using Identifier = byte_array::ConstByteArray;
+  using Identifier  = byte_array::ConstByteArray;
+  using ResourceIDs = std::vector<ResourceID>;
+  using Documents   = std::vector<Document>;
+  using Element     = ResourceKeyValuePair<byte_array::ConstByteArray>;
+  using ElementList = std::vector<Element>;
 
   static constexpr char const *LOGGING_NAME = "RevertibleDocumentStoreProtocol";
 
@@ -58,6 +65,9 @@ public:
     KEY_DUMP,
     RESET,
 
+    GET_MANY,
+    SET_MANY,
+
     LOCK = 20,
     UNLOCK,
     HAS_LOCK
@@ -95,6 +105,8 @@ public:
     this->Expose(GET, this, &RevertibleDocumentStoreProtocol::Get);
     this->Expose(GET_OR_CREATE, this, &RevertibleDocumentStoreProtocol::GetOrCreate);
     this->Expose(SET, this, &RevertibleDocumentStoreProtocol::Set);
+    this->Expose(GET_MANY, this, &RevertibleDocumentStoreProtocol::GetMany);
+    this->Expose(SET_MANY, this, &RevertibleDocumentStoreProtocol::SetMany);
 
     // Functionality for hashing/state
     this->Expose(COMMIT, this, &RevertibleDocumentStoreProtocol::Commit);
@@ -242,6 +254,37 @@ private:
     set_count_->increment();
   }
 
+  Documents GetMany(ResourceIDs const &rids)
+  {
+    Documents docs{};
+    docs.reserve(rids.size());
+
+    for (auto const &rid : rids)
+    {
+      docs.emplace_back(Get(rid));
+    }
+
+    return docs;
+  }
+
+  void SetMany(ElementList const &elements)
+  {
+    telemetry::FunctionTimer const timer{*set_durations_};
+
+    NewRevertibleDocumentStore::KeyValues values{};
+    values.reserve(elements.size());
+
+    for (auto const &element : elements)
+    {
+      values.emplace_back(element.key, element.value);
+    }
+
+    // the writes are applied in a single locked step so that the store is rehashed and flushed
+    // only once, and concurrent writes and commits never observe a partially applied batch
+    doc_store_->SetMany(values);
+    set_count_->add(elements.size());
+  }
+
   NewRevertibleDocumentStore::Hash Commit()
   {
     auto const hash = doc_store_->Commit();
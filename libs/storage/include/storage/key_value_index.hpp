@@ -57,6 +57,7 @@
 // (256), this represents that the node is a leaf. The nodes can contain additional information
 
 #include "crypto/sha256.hpp"
+#include "crypto/sha256_batch.hpp"
 #include "storage/cached_random_access_stack.hpp"
 #include "storage/key.hpp"
 #include "storage/new_versioned_random_access_stack.hpp"
@@ -68,6 +69,7 @@
 #include <deque>
 #include <queue>
 #include <set>
+#include <vector>
 
 namespace fetch {
 namespace storage {
@@ -187,6 +189,10 @@ public:
 
   static constexpr char const *LOGGING_NAME = "KeyValueIndex";
 
+  static constexpr std::size_t NODE_HASH_SIZE = sizeof(key_value_pair::hash);
+  static_assert(NODE_HASH_SIZE == crypto::SHA256Batch::DIGEST_SIZE,
+                "Node hashes must be batch hashable");
+
   KeyValueIndex()
   {
     stack_.OnFileLoaded([this]() { root_ = stack_.header_extra(); });
@@ -221,73 +227,35 @@ public:
 
     stack_.SetExtraHeader(root_);
 
-    std::unordered_map<uint64_t, uint64_t> depths;
-    std::unordered_map<uint64_t, uint64_t> parents;
-    std::priority_queue<UpdateTask>        q;
-
-    for (auto &k : schedule_update_)
-    {
-      auto &         kv   = k.second;
-      uint64_t       last = k.first;
-      uint64_t       pid  = kv.parent;
-      key_value_pair parent;
-      uint64_t       depth = 1;
-
-      while (pid != uint64_t(-1))
-      {
-        if (parents.find(last) != parents.end())
-        {
-          depth += depths[last];
-          break;
-        }
-        parents[last] = pid;
-
-        stack_.Get(pid, parent);
-        last = pid;
-        pid  = parent.parent;
-        ++depth;
-      }
+    ApplyScheduledUpdates();
+  }
 
-      // Adding root
-      if (pid == uint64_t(-1))
-      {
-        parents[last] = pid;
-      }
+  /**
+   * Start deferring the rehashing of parent nodes. Subsequent calls to Set only schedule the
+   * update, even on stacks that support direct writes, so that ancestors shared by several changed
+   * leaves are hashed once when the batch is committed rather than once per key.
+   */
+  void BeginBatch()
+  {
+    defer_updates_ = true;
+  }
 
-      last = k.first;
-      while (parents.find(last) != parents.end())
-      {
-        if (depths.find(last) != depths.end())
-        {
-          break;
-        }
-        depths[last] = depth;
-        q.push({depth, last});
-        --depth;
-        last = parents[last];
-      }
-    }
+  /**
+   * Stop deferring parent updates and rehash every node affected since BeginBatch, level by level
+   */
+  void CommitBatch()
+  {
+    defer_updates_ = false;
 
-    UpdateTask task;
-    while (!q.empty())
+    if (this->is_open())
     {
-      task = q.top();
-      q.pop();
-
-      key_value_pair element, left, right;
-      stack_.Get(task.element, element);
-      if (element.is_leaf())
-      {
-        continue;
-      }
-
-      stack_.Get(element.left, left);
-      stack_.Get(element.right, right);
-      element.UpdateNode(left, right);
-      stack_.Set(task.element, element);
+      ApplyScheduledUpdates();
     }
+  }
 
-    schedule_update_.clear();
+  bool InBatch() const
+  {
+    return defer_updates_;
   }
 
   void Delete(byte_array::ConstByteArray const & /*key*/)
@@ -455,11 +423,11 @@ public:
       stack_.Set(uint64_t(index), kv);
     }
 
-    // Depending on whether the underlying stack is caching or not, we write to it or defer writing
-    // to it by scheduling updates until the next flush
+    // Depending on whether the underlying stack is caching or not (or a batch is open), we write to
+    // it or defer writing to it by scheduling updates until the next flush or batch commit
     if ((kv.parent != index_type(-1)) && (update_parent))
     {
-      if (stack_.DirectWrite())
+      if (stack_.DirectWrite() && !defer_updates_)
       {
         UpdateParents(kv.parent, index, kv);
       }
@@ -800,6 +768,109 @@ private:
 
   uint64_t                                     root_ = 0;
   std::unordered_map<uint64_t, key_value_pair> schedule_update_;
+  bool                                         defer_updates_{false};
+
+  /**
+   * Rehash the ancestors of every scheduled node. Nodes are grouped by depth and the deepest levels
+   * are written first so that each level can be batch hashed
+   */
+  void ApplyScheduledUpdates()
+  {
+    std::unordered_map<uint64_t, uint64_t> depths;
+    std::unordered_map<uint64_t, uint64_t> parents;
+    std::priority_queue<UpdateTask>        q;
+
+    for (auto &k : schedule_update_)
+    {
+      auto &         kv   = k.second;
+      uint64_t       last = k.first;
+      uint64_t       pid  = kv.parent;
+      key_value_pair parent;
+      uint64_t       depth = 1;
+
+      while (pid != uint64_t(-1))
+      {
+        if (parents.find(last) != parents.end())
+        {
+          depth += depths[last];
+          break;
+        }
+        parents[last] = pid;
+
+        stack_.Get(pid, parent);
+        last = pid;
+        pid  = parent.parent;
+        ++depth;
+      }
+
+      // Adding root
+      if (pid == uint64_t(-1))
+      {
+        parents[last] = pid;
+      }
+
+      last = k.first;
+      while (parents.find(last) != parents.end())
+      {
+        if (depths.find(last) != depths.end())
+        {
+          break;
+        }
+        depths[last] = depth;
+        q.push({depth, last});
+        --depth;
+        last = parents[last];
+      }
+    }
+
+    // Nodes with the same priority are never ancestors of one another, so each level can be hashed
+    // together in a single batch once all the deeper levels have been written
+    std::vector<uint64_t>       indices;
+    std::vector<key_value_pair> elements;
+    std::vector<uint8_t>        messages;
+    std::vector<uint8_t>        digests;
+
+    while (!q.empty())
+    {
+      uint64_t const priority = q.top().priority;
+
+      indices.clear();
+      elements.clear();
+      messages.clear();
+
+      while (!q.empty() && (q.top().priority == priority))
+      {
+        key_value_pair element, left, right;
+        stack_.Get(q.top().element, element);
+
+        if (!element.is_leaf())
+        {
+          stack_.Get(element.left, left);
+          stack_.Get(element.right, right);
+
+          // matches the ordering of KeyValuePair::UpdateNode
+          messages.insert(messages.end(), right.hash, right.hash + NODE_HASH_SIZE);
+          messages.insert(messages.end(), left.hash, left.hash + NODE_HASH_SIZE);
+
+          indices.push_back(q.top().element);
+          elements.push_back(element);
+        }
+
+        q.pop();
+      }
+
+      digests.resize(elements.size() * NODE_HASH_SIZE);
+      crypto::SHA256Batch::Hash64(messages.data(), elements.size(), digests.data());
+
+      for (std::size_t i = 0; i < elements.size(); ++i)
+      {
+        std::memcpy(elements[i].hash, &digests[i * NODE_HASH_SIZE], NODE_HASH_SIZE);
+        stack_.Set(indices[i], elements[i]);
+      }
+    }
+
+    schedule_update_.clear();
+  }
 
   /**
    * Update the parents of a changed node, since this changes the merkle tree
@@ -21,7 +21,10 @@
 #include "storage/new_versioned_random_access_stack.hpp"
 
 #include <cstddef>
+#include <cstdint>
 #include <string>
+#include <utility>
+#include <vector>
 
 namespace fetch {
 namespace storage {
@@ -35,6 +38,7 @@ public:
   using ByteArray      = byte_array::ConstByteArray;
   using UnderlyingType = storage::Document;
   using Keys           = std::vector<ResourceID>;
+  using KeyValues      = std::vector<std::pair<ResourceID, ByteArray>>;
 
   bool New(std::string const &state, std::string const &state_history, std::string const &index,
            std::string const &index_history, bool create_if_not_exist);
@@ -44,8 +48,22 @@ public:
   UnderlyingType Get(ResourceID const &rid);
   UnderlyingType GetOrCreate(ResourceID const &rid);
   void           Set(ResourceID const &rid, ByteArray const &value);
+  void           SetMany(KeyValues const &values);
   void           Erase(ResourceID const &rid);
 
+  // Write batches
+  void BeginBatch();
+  void CommitBatch();
+  void DiscardBatch();
+
+  // Read cache
+  void EnableCache(std::string const &name,
+                   std::size_t        capacity = DocumentCache::DEFAULT_CAPACITY);
+  void SetCacheCapacity(std::size_t capacity);
+
+  // Checkpoints
+  void SetCheckpointPolicy(uint64_t interval, uint64_t max_checkpoints);
+
   Hash Commit();
   bool RevertToHash(Hash const &hash);
   Hash CurrentHash();
@@ -35,6 +35,21 @@
 // ......│ PUSH │ POP  │ SWAP │BKMARK│ PUSH │  HISTORY
 //       │      │      │      │      │      │
 //       └──────┴──────┴──────┴──────┴──────┘
+//                              │
+//                              ▼
+//                   ┌──────┬──────┬──────┐      ┌──────┬──────┬──────┬──────┐
+//                   │      │      │      │      │      │      │      │      │
+//                   │BKMARK│BKMARK│BKMARK│◀─────│ SLOT │ SLOT │ SLOT │ SLOT │  HASH INDEX
+//                   │      │      │      │      │      │      │      │      │
+//                   └──────┴──────┴──────┘      └──────┴──────┴──────┴──────┘
+//                        HASH HISTORY
+//
+//  Optionally, the whole of the main stack is also copied to a checkpoint file every so many
+//  commits, along with the position of the history at that point. Reverting to a distant bookmark
+//  can then restore the checkpoint and truncate the history, rather than replaying every
+//  intervening record. Checkpoints are disabled by default (see `SetCheckpointPolicy`) since each
+//  one is a synchronous copy of the whole stack taken during `Commit`, and every checkpoint kept
+//  costs another full copy of the stack on disk.
 
 #include "storage/cached_random_access_stack.hpp"
 #include "storage/key.hpp"
@@ -44,7 +59,11 @@
 
 #include "core/byte_array/encoders.hpp"
 
+#include <algorithm>
+#include <cstdio>
 #include <cstring>
+#include <string>
+#include <vector>
 
 namespace fetch {
 namespace storage {
@@ -255,7 +274,60 @@ private:
     uint64_t data = 0;
   };
 
+  /**
+   * A slot in the on-disk open addressing hash table which maps bookmark keys to their most recent
+   * position in the hash history.
+   */
+  struct HashIndexSlot
+  {
+    HashIndexSlot()
+    {
+      // Clear the whole structure (including padded regions) are zeroed
+      memset(this, 0, sizeof(decltype(*this)));
+      position = EMPTY_SLOT;
+    }
+
+    DefaultKey key{};
+    uint64_t   position = EMPTY_SLOT;
+  };
+
+  /**
+   * Stored in the header of the hash index, used to check the index is consistent with the hash
+   * history when loading from disk
+   */
+  struct HashIndexHeader
+  {
+    uint64_t indexed = 0;  ///< The number of hash history entries which have been indexed
+    uint64_t used    = 0;  ///< The number of slots which are not empty (including deleted slots)
+  };
+
+  /**
+   * A record of a snapshot of the main stack, taken directly after a bookmark was committed
+   */
+  struct Checkpoint
+  {
+    uint64_t             hash_position = 0;  ///< The position of the bookmark in the hash history
+    VariantStack::Header history{};          ///< The position of the top of the history
+    header_type          header{};           ///< The header of the main stack
+    uint64_t             size = 0;           ///< The number of elements in the main stack
+  };
+
+  using HashIndex         = RandomAccessStack<HashIndexSlot, HashIndexHeader>;
+  using HashChain         = RandomAccessStack<uint64_t>;
+  using CheckpointRecords = RandomAccessStack<Checkpoint>;
+  using Checkpoints       = std::vector<Checkpoint>;
+  using SnapshotStack     = RandomAccessStack<T, header_type>;
+
+  static constexpr uint64_t EMPTY_SLOT   = uint64_t(-1);
+  static constexpr uint64_t DELETED_SLOT = uint64_t(-2);
+  static constexpr uint64_t NO_POSITION  = uint64_t(-1);
+
+  static constexpr uint64_t MIN_HASH_INDEX_CAPACITY = 64;
+
 public:
+  static constexpr uint64_t DEFAULT_CHECKPOINT_INTERVAL = 0;  // disabled
+  static constexpr uint64_t DEFAULT_MAX_CHECKPOINTS     = 4;
+
   using type               = T;
   using event_handler_type = std::function<void()>;
 
@@ -315,19 +387,29 @@ public:
   void Load(std::string const &filename, std::string const &history,
             bool const &create_if_not_exist = true)
   {
+    history_filename_ = history;
+
     stack_.Load(filename, create_if_not_exist);
     history_.Load(history, create_if_not_exist);
 
     hash_history_.Load("hash_history_" + history, create_if_not_exist);
     internal_bookmark_index_ = stack_.header_extra().bookmark;
+
+    LoadHashIndex();
+    LoadCheckpoints();
   }
 
   void New(std::string const &filename, std::string const &history)
   {
+    history_filename_ = history;
+
     stack_.New(filename);
     history_.New(history);
     hash_history_.New("hash_history_" + history);
     internal_bookmark_index_ = stack_.header_extra().bookmark;
+
+    RebuildHashIndex();
+    ClearCheckpoints();
   }
 
   void Clear()
@@ -337,6 +419,39 @@ public:
     hash_history_.Clear();
 
     internal_bookmark_index_ = stack_.header_extra().bookmark;
+
+    RebuildHashIndex();
+    ClearCheckpoints();
+  }
+
+  /**
+   * Configure how often a snapshot of the main stack is taken.
+   *
+   * Taking a checkpoint copies the whole of the main stack to a new file as part of the commit,
+   * so it stalls that commit for time proportional to the size of the stack. Up to
+   * `max_checkpoints` of these copies are kept on disk in addition to the stack itself. They only
+   * pay for themselves where reverts to distant bookmarks are expected.
+   *
+   * @param: interval The number of commits between checkpoints, zero disables checkpoints
+   * @param: max_checkpoints The maximum number of checkpoints kept, the oldest being discarded
+   */
+  void SetCheckpointPolicy(uint64_t interval, uint64_t max_checkpoints)
+  {
+    checkpoint_interval_ = interval;
+    max_checkpoints_     = max_checkpoints;
+
+    while (checkpoints_.size() > max_checkpoints_)
+    {
+      RemoveCheckpointFile(checkpoints_.front());
+      checkpoints_.erase(checkpoints_.begin());
+    }
+
+    StoreCheckpoints();
+  }
+
+  std::size_t num_checkpoints() const
+  {
+    return checkpoints_.size();
   }
 
   type Get(std::size_t i) const
@@ -408,7 +523,7 @@ public:
     HistoryBookmark history_bookmark{internal_bookmark_index_, key};
 
     history_.Push(history_bookmark, HistoryBookmark::value);
-    hash_history_.Push(history_bookmark);
+    PushHashHistory(history_bookmark);
 
     // Update our header with this information (the bookmark index)
     header_type h = stack_.header_extra();
@@ -420,6 +535,13 @@ public:
     // Optionally flush since this is a checkpoint
     Flush(false);
 
+    // Periodically snapshot the main stack so that distant reverts do not replay the whole history
+    if ((checkpoint_interval_ != 0) && (max_checkpoints_ != 0) &&
+        ((hash_history_.size() % checkpoint_interval_) == 0))
+    {
+      TakeCheckpoint();
+    }
+
     return internal_bookmark_index_ - 1;
   }
 
@@ -431,33 +553,43 @@ public:
       return false;
     }
 
-    uint64_t        hash_history_size = hash_history_.size();
-    HistoryBookmark book;
-
-    for (std::size_t i = 0; i < hash_history_size; ++i)
-    {
-      uint64_t reverse_index = hash_history_size - i - 1;
-      hash_history_.Get(reverse_index, book);
-
-      if (book.key == key)
-      {
-        return true;
-      }
-    }
-
-    return false;
+    uint64_t position{0};
+    return LookupHashIndex(key, position);
   }
 
   /**
    * Revert the main stack to the point at bookmark b by continually popping off changes from the
-   * history, inspecting their type, and applying a revert with that change. Unsafe if the key
-   * doesn't exist!
+   * history, inspecting their type, and applying a revert with that change. When a checkpoint has
+   * been taken at or after the bookmark, and restoring it is cheaper than replaying the history
+   * down to it, the checkpoint is restored first.
    *
    * @param: b The bookmark to revert to
    *
    */
   void RevertToHash(DefaultKey const &key)
   {
+    uint64_t position{0};
+    if (!LookupHashIndex(key, position))
+    {
+      throw StorageException("Attempt to revert to key failed, key not found in the history.");
+    }
+
+    // find the oldest checkpoint which is still at or after the bookmark being reverted to
+    auto const checkpoint =
+        std::find_if(checkpoints_.begin(), checkpoints_.end(), [position](Checkpoint const &c) {
+          return c.hash_position >= position;
+        });
+
+    if (checkpoint != checkpoints_.end())
+    {
+      uint64_t const records_skipped = history_.size() - checkpoint->history.object_count;
+
+      if (records_skipped > (checkpoint->size + stack_.size()))
+      {
+        RestoreCheckpoint(*checkpoint);
+      }
+    }
+
     bool bookmark_found = false;
 
     while (!bookmark_found)
@@ -495,6 +627,16 @@ public:
         throw StorageException("Undefined type found when reverting in versioned history");
       }
     }
+
+    // any checkpoints taken after the bookmark are no longer part of the history
+    while (!checkpoints_.empty() && ((checkpoints_.back().hash_position > position) ||
+                                     (checkpoints_.back().history.object_count > history_.size())))
+    {
+      RemoveCheckpointFile(checkpoints_.back());
+      checkpoints_.pop_back();
+    }
+
+    StoreCheckpoints();
   }
 
   void Flush(bool lazy = true)
@@ -503,6 +645,8 @@ public:
     stack_.Flush(lazy);
     history_.Flush(lazy);
     hash_history_.Flush(lazy);
+    hash_index_.Flush(lazy);
+    hash_chain_.Flush(lazy);
   }
 
   std::size_t size() const
@@ -524,6 +668,21 @@ private:
   VariantStack                       history_;
   RandomAccessStack<HistoryBookmark> hash_history_;
   uint64_t                           internal_bookmark_index_{0};
+  std::string                        history_filename_;
+
+  /// @name Hash Index
+  /// @{
+  HashIndex hash_index_;  ///< Maps bookmark keys to positions in the hash history
+  HashChain hash_chain_;  ///< The previous position of the same key, for each hash history entry
+  /// @}
+
+  /// @name Checkpoints
+  /// @{
+  CheckpointRecords checkpoint_records_;
+  Checkpoints       checkpoints_;
+  uint64_t          checkpoint_interval_{DEFAULT_CHECKPOINT_INTERVAL};
+  uint64_t          max_checkpoints_{DEFAULT_MAX_CHECKPOINTS};
+  /// @}
 
   event_handler_type on_file_loaded_;
   event_handler_type on_before_flush_;
@@ -555,12 +714,372 @@ private:
         FETCH_LOG_ERROR(LOGGING_NAME, "Hash history top does not match bookmark being removed!");
       }
 
-      hash_history_.Pop();
+      PopHashHistory();
     }
 
     return key_to_compare == book.key;
   }
 
+  static uint64_t HashIndexStart(DefaultKey const &key, uint64_t capacity)
+  {
+    // keys are the output of a cryptographic hash, so any 64 bits of them are well distributed
+    uint64_t value{0};
+    std::memcpy(&value, &key, sizeof(value));
+
+    return value & (capacity - 1);
+  }
+
+  /**
+   * Find the most recent position of a key in the hash history
+   *
+   * @param: key The key to search for
+   * @param: position The position of the key if found
+   *
+   * @return: true if the key was found, otherwise false
+   */
+  bool LookupHashIndex(DefaultKey const &key, uint64_t &position) const
+  {
+    uint64_t const capacity = hash_index_.size();
+    uint64_t       index    = HashIndexStart(key, capacity);
+
+    HashIndexSlot slot;
+    for (uint64_t probe = 0; probe < capacity; ++probe, index = (index + 1) & (capacity - 1))
+    {
+      hash_index_.Get(index, slot);
+
+      if (slot.position == EMPTY_SLOT)
+      {
+        break;
+      }
+
+      if ((slot.position != DELETED_SLOT) && (slot.key == key))
+      {
+        position = slot.position;
+        return true;
+      }
+    }
+
+    return false;
+  }
+
+  /**
+   * Set the position of a key in the hash index, adding it if it is not already present. The table
+   * must have at least one free slot.
+   *
+   * @param: key The key to update
+   * @param: position The new position of the key
+   */
+  void UpdateHashIndex(DefaultKey const &key, uint64_t position)
+  {
+    uint64_t const capacity = hash_index_.size();
+    uint64_t       index    = HashIndexStart(key, capacity);
+    uint64_t       target   = capacity;
+    bool           is_empty = false;
+
+    HashIndexSlot slot;
+    for (uint64_t probe = 0; probe < capacity; ++probe, index = (index + 1) & (capacity - 1))
+    {
+      hash_index_.Get(index, slot);
+
+      if (slot.position == EMPTY_SLOT)
+      {
+        // the key is not present, prefer reusing an earlier deleted slot
+        if (target == capacity)
+        {
+          target   = index;
+          is_empty = true;
+        }
+        break;
+      }
+
+      if (slot.position == DELETED_SLOT)
+      {
+        if (target == capacity)
+        {
+          target = index;
+        }
+      }
+      else if (slot.key == key)
+      {
+        target = index;
+        break;
+      }
+    }
+
+    assert(target != capacity);
+
+    slot.key      = key;
+    slot.position = position;
+    hash_index_.Set(target, slot);
+
+    if (is_empty)
+    {
+      HashIndexHeader header = hash_index_.header_extra();
+      ++header.used;
+      hash_index_.SetExtraHeader(header);
+    }
+  }
+
+  /**
+   * Push a bookmark on to the hash history, keeping the hash index in step
+   *
+   * @param: book The bookmark to push
+   */
+  void PushHashHistory(HistoryBookmark const &book)
+  {
+    uint64_t previous{NO_POSITION};
+    LookupHashIndex(book.key, previous);
+
+    uint64_t const position = hash_history_.Push(book);
+    hash_chain_.Push(previous);
+
+    // keep the load factor (including deleted slots) at most one half
+    if ((hash_index_.header_extra().used + 1) * 2 > hash_index_.size())
+    {
+      RebuildHashIndex();
+    }
+    else
+    {
+      UpdateHashIndex(book.key, position);
+
+      HashIndexHeader header = hash_index_.header_extra();
+      header.indexed         = hash_history_.size();
+      hash_index_.SetExtraHeader(header);
+    }
+  }
+
+  /**
+   * Pop the top bookmark from the hash history, keeping the hash index in step. The key then maps
+   * to its previous position, if there is one.
+   */
+  void PopHashHistory()
+  {
+    uint64_t const        position = hash_history_.size() - 1;
+    HistoryBookmark const book     = hash_history_.Top();
+    uint64_t const        previous = hash_chain_.Top();
+
+    uint64_t current{NO_POSITION};
+    if (LookupHashIndex(book.key, current) && (current == position))
+    {
+      UpdateHashIndex(book.key, (previous == NO_POSITION) ? DELETED_SLOT : previous);
+    }
+
+    hash_history_.Pop();
+    hash_chain_.Pop();
+
+    HashIndexHeader header = hash_index_.header_extra();
+    header.indexed         = hash_history_.size();
+    hash_index_.SetExtraHeader(header);
+  }
+
+  /**
+   * Load the hash index from disk, rebuilding it from the hash history if it is missing or does not
+   * match the hash history (for example after an unclean shutdown)
+   */
+  void LoadHashIndex()
+  {
+    hash_index_.Load("hash_index_" + history_filename_, true);
+    hash_chain_.Load("hash_chain_" + history_filename_, true);
+
+    uint64_t const capacity = hash_index_.size();
+
+    bool const consistent = (capacity >= MIN_HASH_INDEX_CAPACITY) &&
+                            ((capacity & (capacity - 1)) == 0) &&
+                            (hash_index_.header_extra().indexed == hash_history_.size()) &&
+                            (hash_chain_.size() == hash_history_.size());
+
+    if (!consistent)
+    {
+      FETCH_LOG_INFO(LOGGING_NAME, "Rebuilding hash index for: ", history_filename_);
+      RebuildHashIndex();
+    }
+  }
+
+  /**
+   * Recreate the hash index and chain from the complete hash history
+   */
+  void RebuildHashIndex()
+  {
+    uint64_t const count = hash_history_.size();
+
+    uint64_t capacity = MIN_HASH_INDEX_CAPACITY;
+    while (capacity < (count * 4))
+    {
+      capacity <<= 1;
+    }
+
+    hash_index_.New("hash_index_" + history_filename_);
+    hash_chain_.New("hash_chain_" + history_filename_);
+
+    HashIndexSlot const empty_slot{};
+    for (uint64_t i = 0; i < capacity; ++i)
+    {
+      hash_index_.LazyPush(empty_slot);
+    }
+    hash_index_.SetExtraHeader(HashIndexHeader{});
+
+    HistoryBookmark book;
+    for (uint64_t i = 0; i < count; ++i)
+    {
+      hash_history_.Get(i, book);
+
+      uint64_t previous{NO_POSITION};
+      LookupHashIndex(book.key, previous);
+
+      hash_chain_.LazyPush(previous);
+      UpdateHashIndex(book.key, i);
+    }
+
+    HashIndexHeader header = hash_index_.header_extra();
+    header.indexed         = count;
+    hash_index_.SetExtraHeader(header);
+
+    hash_index_.Flush(true);
+    hash_chain_.Flush(true);
+  }
+
+  std::string CheckpointFilename(Checkpoint const &checkpoint) const
+  {
+    return "checkpoint_" + std::to_string(checkpoint.hash_position) + "_" + history_filename_;
+  }
+
+  void RemoveCheckpointFile(Checkpoint const &checkpoint) const
+  {
+    std::remove(CheckpointFilename(checkpoint).c_str());
+  }
+
+  /**
+   * Load the list of checkpoints from disk, discarding any which are no longer part of the history
+   */
+  void LoadCheckpoints()
+  {
+    checkpoint_records_.Load("checkpoints_" + history_filename_, true);
+
+    checkpoints_.clear();
+
+    Checkpoint checkpoint;
+    for (uint64_t i = 0; i < checkpoint_records_.size(); ++i)
+    {
+      checkpoint_records_.Get(i, checkpoint);
+
+      if ((checkpoint.hash_position < hash_history_.size()) &&
+          (checkpoint.history.object_count <= history_.size()))
+      {
+        checkpoints_.push_back(checkpoint);
+      }
+    }
+
+    StoreCheckpoints();
+  }
+
+  void ClearCheckpoints()
+  {
+    for (auto const &checkpoint : checkpoints_)
+    {
+      RemoveCheckpointFile(checkpoint);
+    }
+
+    checkpoints_.clear();
+    checkpoint_records_.New("checkpoints_" + history_filename_);
+  }
+
+  void StoreCheckpoints()
+  {
+    if (history_filename_.empty())
+    {
+      return;
+    }
+
+    checkpoint_records_.New("checkpoints_" + history_filename_);
+
+    for (auto const &checkpoint : checkpoints_)
+    {
+      checkpoint_records_.LazyPush(checkpoint);
+    }
+
+    checkpoint_records_.Flush(true);
+  }
+
+  /**
+   * Copy the complete main stack to a checkpoint file, recording the current position of the
+   * history. Must be called directly after a bookmark has been committed.
+   */
+  void TakeCheckpoint()
+  {
+    Checkpoint checkpoint;
+    checkpoint.hash_position = hash_history_.size() - 1;
+    checkpoint.history       = history_.Position();
+    checkpoint.header        = stack_.header_extra();
+    checkpoint.size          = stack_.size();
+
+    SnapshotStack snapshot;
+    snapshot.New(CheckpointFilename(checkpoint));
+
+    type object;
+    for (uint64_t i = 0; i < checkpoint.size; ++i)
+    {
+      stack_.Get(i, object);
+      snapshot.LazyPush(object);
+    }
+
+    snapshot.SetExtraHeader(checkpoint.header);
+    snapshot.Close();
+
+    checkpoints_.push_back(checkpoint);
+
+    while (checkpoints_.size() > max_checkpoints_)
+    {
+      RemoveCheckpointFile(checkpoints_.front());
+      checkpoints_.erase(checkpoints_.begin());
+    }
+
+    StoreCheckpoints();
+  }
+
+  /**
+   * Restore the main stack from a checkpoint and truncate the history back to the point at which
+   * the checkpoint was taken
+   *
+   * @param: checkpoint The checkpoint to restore
+   */
+  void RestoreCheckpoint(Checkpoint const &checkpoint)
+  {
+    FETCH_LOG_DEBUG(LOGGING_NAME, "Restoring checkpoint at: ", checkpoint.hash_position);
+
+    SnapshotStack snapshot;
+    snapshot.Load(CheckpointFilename(checkpoint), false);
+
+    while (stack_.size() > checkpoint.size)
+    {
+      stack_.Pop();
+    }
+
+    type object;
+    for (uint64_t i = 0; i < checkpoint.size; ++i)
+    {
+      snapshot.Get(i, object);
+
+      if (i < stack_.size())
+      {
+        stack_.Set(i, object);
+      }
+      else
+      {
+        stack_.Push(object);
+      }
+    }
+
+    stack_.SetExtraHeader(checkpoint.header);
+
+    // the history now ends with the bookmark which was committed when the checkpoint was taken
+    history_.Truncate(checkpoint.history);
+
+    while (hash_history_.size() > (checkpoint.hash_position + 1))
+    {
+      PopHashHistory();
+    }
+  }
+
   void RevertSwap()
   {
     HistorySwap swap;
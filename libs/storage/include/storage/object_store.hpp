@@ -144,6 +144,32 @@ public:
     f();
   }
 
+  /**
+   * Obtain a lock then execute closure with all of its writes grouped into a single write batch
+   * of the underlying document store. The closure should use the lockless accessors. If it throws
+   * the buffered writes are discarded.
+   *
+   * @param: f The closure
+   */
+  template <typename F>
+  void WithBatch(F &&f)
+  {
+    FETCH_LOCK(mutex_);
+    store_.BeginBatch();
+
+    try
+    {
+      f();
+    }
+    catch (...)
+    {
+      store_.DiscardBatch();
+      throw;
+    }
+
+    store_.CommitBatch();
+  }
+
   /**
    * Do a get without locking the structure, do this when it is guaranteed you
    * have locked (using WithLock) or don't need to lock (single threaded scenario)
@@ -26,6 +26,9 @@
 #include "telemetry/registry.hpp"
 #include "telemetry/utils/timer.hpp"
 
+#include <utility>
+#include <vector>
+
 namespace fetch {
 namespace storage {
 
@@ -46,6 +49,7 @@ public:
 
   using Element     = ResourceKeyValuePair<T>;
   using ElementList = std::vector<Element>;
+  using ResourceIDs = std::vector<ResourceID>;
 
   enum
   {
@@ -53,7 +57,8 @@ public:
     SET,
     SET_BULK,
     HAS,
-    GET_RECENT
+    GET_RECENT,
+    GET_BULK
   };
 
   ObjectStoreProtocol(TransientObjectStore<T> *obj_store, uint32_t lane)
@@ -72,6 +77,7 @@ public:
     this->Expose(SET_BULK, this, &self_type::SetBulk);
     this->Expose(HAS, obj_store, &TransientObjectStore<T>::Has);
     this->Expose(GET_RECENT, obj_store, &TransientObjectStore<T>::GetRecent);
+    this->Expose(GET_BULK, this, &self_type::GetBulk);
   }
 
 private:
@@ -129,6 +135,33 @@ private:
     return ret;
   }
 
+  ElementList GetBulk(ResourceIDs const &rids)
+  {
+    FETCH_LOG_DEBUG(LOGGING_NAME, "Getting multiple objects across object store protocol");
+
+    telemetry::FunctionTimer const timer{*get_durations_};
+
+    ElementList elements{};
+    elements.reserve(rids.size());
+
+    // unlike the single lookup, missing elements are simply omitted from the response so that a
+    // single absent object does not fail the whole batch
+    for (ResourceID const &rid : rids)
+    {
+      Element element{rid, T{}};
+
+      if (obj_store_->Get(rid, element.value))
+      {
+        obj_store_->Confirm(rid);
+        get_count_->increment();
+
+        elements.emplace_back(std::move(element));
+      }
+    }
+
+    return elements;
+  }
+
   TransientObjectStore<T> *obj_store_;
   telemetry::CounterPtr    set_count_;
   telemetry::CounterPtr    get_count_;
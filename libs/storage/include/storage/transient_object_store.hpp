@@ -25,7 +25,13 @@
 #include "core/state_machine.hpp"
 #include "ledger/chain/transaction_layout.hpp"
 #include "storage/object_store.hpp"
+#include "telemetry/gauge.hpp"
+#include "telemetry/histogram.hpp"
+#include "telemetry/registry.hpp"
 
+#include <algorithm>
+#include <array>
+#include <atomic>
 #include <chrono>
 #include <functional>
 #include <map>
@@ -42,6 +48,10 @@ namespace storage {
  * to be requested very soon after being written are stored in a cache. Once items are finished with
  * they can be 'confirmed', that is, written to the underlying object store.
  *
+ * The cache is split into shards selected by the bits of the resource ID that follow the lane
+ * bits, each with its own lock, so that concurrent readers and writers rarely contend. Confirmed
+ * objects are written back in batches whose size follows the number of pending confirmations.
+ *
  * @tparam Object The type of the object being stored
  */
 template <typename Object>
@@ -56,7 +66,13 @@ public:
 
   static constexpr char const *LOGGING_NAME = "TransientObjectStore";
 
-  explicit TransientObjectStore(uint32_t log2_num_lanes);
+  static constexpr std::size_t LOG2_NUM_SHARDS = 4;
+  static constexpr std::size_t NUM_SHARDS      = 1u << LOG2_NUM_SHARDS;
+  static constexpr std::size_t MIN_BATCH_SIZE  = 100;
+  static constexpr std::size_t MAX_BATCH_SIZE  = 6400;
+  static constexpr std::size_t WRITE_CHUNK     = 100;
+
+  explicit TransientObjectStore(uint32_t log2_num_lanes, uint32_t lane = 0);
   TransientObjectStore(TransientObjectStore const &) = delete;
   TransientObjectStore(TransientObjectStore &&)      = delete;
 
@@ -82,6 +98,7 @@ public:
   TransientObjectStore &operator=(TransientObjectStore &&) = delete;
 
   std::size_t Size() const;
+  std::size_t PendingConfirmations() const;
 
   TxArray PullSubtree(byte_array::ConstByteArray const &rid, uint64_t bit_count,
                       uint64_t pull_limit);
@@ -101,30 +118,50 @@ private:
   using RecentQueue     = fetch::core::MPMCQueue<ledger::TransactionLayout, 1 << 15>;
   using Cache           = std::unordered_map<ResourceID, Object>;
   using Flag            = std::atomic<bool>;
+  using Counter         = std::atomic<std::size_t>;
+  using Clock           = std::chrono::steady_clock;
+  using Timepoint       = Clock::time_point;
+
+  struct Shard
+  {
+    mutable Mutex mutex{__LINE__, __FILE__};  ///< The mutex for this part of the cache
+    Cache         cache;                      ///< The objects whose IDs map to this shard
+  };
+
+  using Shards = std::array<Shard, NUM_SHARDS>;
+
+  Shard &LookupShard(ResourceID const &rid);
 
   bool GetFromCache(ResourceID const &rid, Object &object);
   void SetInCache(ResourceID const &rid, Object const &object);
   bool IsInCache(ResourceID const &rid);
+  void EraseFromCache(ResourceID const &rid);
 
   Phase OnPopulating();
   Phase OnWriting();
   Phase OnFlushing();
 
-  uint32_t const    log2_num_lanes_;
-  const std::size_t batch_size_ = 100;
+  uint32_t const log2_num_lanes_;
+  std::size_t    batch_size_{MIN_BATCH_SIZE};
 
-  std::vector<ResourceID> rids;
-  std::size_t             extracted_count = 0;
-  std::size_t             written_count   = 0;
+  std::vector<ResourceID>                    rids;
+  std::vector<std::pair<ResourceID, Object>> chunk;
+  std::size_t                                extracted_count = 0;
+  std::size_t                                written_count   = 0;
+  Timepoint                                  batch_started{};
 
-  mutable Mutex   cache_mutex_{__LINE__, __FILE__};  ///< The mutex for the cache
+  Shards          shards_;            ///< The main object cache, split by resource ID
   StateMachinePtr state_machine_;     ///< The state machine controlling the worker writing to disk
-  Cache           cache_;             ///< The main object cache
   Archive         archive_;           ///< The persistent object store
   Queue           confirm_queue_;     ///< The queue of elements to be stored
+  Counter         pending_{0};        ///< The number of confirmed elements not yet evicted
   RecentQueue     most_recent_seen_;  ///< The queue of elements to be stored
   Callback        set_callback_;      ///< The completion handler
   Flag            stop_{false};       ///< Flag to signal the stop of the worker
+
+  telemetry::GaugePtr<uint64_t> queue_depth_;       ///< Confirmations waiting to be written
+  telemetry::GaugePtr<uint64_t> batch_size_gauge_;  ///< The size of the current write batch
+  telemetry::HistogramPtr       flush_durations_;   ///< Time from extraction to cache eviction
   static constexpr core::Tickets::Count recent_queue_alarm_threshold{RecentQueue::QUEUE_LENGTH >>
                                                                      1};
 };
@@ -135,12 +172,23 @@ private:
  * @tparam O The type of the object being stored
  */
 template <typename O>
-TransientObjectStore<O>::TransientObjectStore(uint32_t log2_num_lanes)
+TransientObjectStore<O>::TransientObjectStore(uint32_t log2_num_lanes, uint32_t lane)
   : log2_num_lanes_(log2_num_lanes)
-  , rids(batch_size_)
+  , rids(MAX_BATCH_SIZE)
   , state_machine_{
         std::make_shared<core::StateMachine<Phase>>("TransientObjectStore", Phase::Populating)}
-
+  , queue_depth_{telemetry::Registry::Instance().CreateGauge<uint64_t>(
+        "ledger_tx_store_confirm_queue_depth",
+        "The number of confirmed transactions waiting to be written to disk",
+        {{"lane", std::to_string(lane)}})}
+  , batch_size_gauge_{telemetry::Registry::Instance().CreateGauge<uint64_t>(
+        "ledger_tx_store_write_batch_size", "The number of transactions in the current write batch",
+        {{"lane", std::to_string(lane)}})}
+  , flush_durations_{telemetry::Registry::Instance().CreateHistogram(
+        {0.000001, 0.00001, 0.0001, 0.001, 0.01, 0.1, 1, 10., 100.},
+        "ledger_tx_store_flush_duration",
+        "The histogram of times taken to write a batch to disk and evict it from the cache",
+        {{"lane", std::to_string(lane)}})}
 {
   state_machine_->RegisterHandler(Phase::Populating, this, &TransientObjectStore<O>::OnPopulating);
   state_machine_->RegisterHandler(Phase::Writing, this, &TransientObjectStore<O>::OnWriting);
@@ -150,9 +198,28 @@ TransientObjectStore<O>::TransientObjectStore(uint32_t log2_num_lanes)
 template <typename O>
 std::size_t TransientObjectStore<O>::Size() const
 {
-  FETCH_LOCK(cache_mutex_);
+  std::size_t size = archive_.size();
+
+  for (auto const &shard : shards_)
+  {
+    FETCH_LOCK(shard.mutex);
+    size += shard.cache.size();
+  }
 
-  return archive_.size() + cache_.size();
+  return size;
+}
+
+/**
+ * Get the number of confirmed objects that have not yet been written to disk and evicted from
+ * the cache
+ *
+ * @tparam O The type of the object being stored
+ * @return The number of pending confirmations
+ */
+template <typename O>
+std::size_t TransientObjectStore<O>::PendingConfirmations() const
+{
+  return pending_;
 }
 
 template <typename O>
@@ -181,13 +248,34 @@ typename TransientObjectStore<O>::TxArray TransientObjectStore<O>::PullSubtree(
 
 template <typename O>
 constexpr core::Tickets::Count TransientObjectStore<O>::recent_queue_alarm_threshold;
+template <typename O>
+constexpr std::size_t TransientObjectStore<O>::LOG2_NUM_SHARDS;
+template <typename O>
+constexpr std::size_t TransientObjectStore<O>::NUM_SHARDS;
+template <typename O>
+constexpr std::size_t TransientObjectStore<O>::MIN_BATCH_SIZE;
+template <typename O>
+constexpr std::size_t TransientObjectStore<O>::MAX_BATCH_SIZE;
+template <typename O>
+constexpr std::size_t TransientObjectStore<O>::WRITE_CHUNK;
 
-// Populating: We are filling up our batch of objects from the queue that is being posted
+// Populating: We are filling up our batch of objects from the queue that is being posted. The
+// batch grows with the backlog so that the writer catches up when confirmations arrive faster
+// than a minimum sized batch can be written.
 template <typename O>
 typename TransientObjectStore<O>::Phase TransientObjectStore<O>::OnPopulating()
 {
   assert(extracted_count < batch_size_);
 
+  if (extracted_count == 0)
+  {
+    std::size_t const backlog = pending_;
+
+    batch_size_ = std::min(std::max(backlog, MIN_BATCH_SIZE), MAX_BATCH_SIZE);
+    queue_depth_->set(backlog);
+    batch_size_gauge_->set(batch_size_);
+  }
+
   // ensure the write count is reset
   written_count = 0;
 
@@ -200,6 +288,11 @@ typename TransientObjectStore<O>::Phase TransientObjectStore<O>::OnPopulating()
     // update the index if needed
     if (extracted)
     {
+      if (extracted_count == 0)
+      {
+        batch_started = Clock::now();
+      }
+
       ++extracted_count;
     }
 
@@ -230,7 +323,9 @@ typename TransientObjectStore<O>::Phase TransientObjectStore<O>::OnPopulating()
   return Phase::Populating;
 }
 
-// Writing: We are extracting the items from the cache and writing them to disk
+// Writing: We are extracting the items from the cache and writing them to disk. Each step
+// writes a chunk of the batch under a single lock of the archive, so that readers of the archive
+// are only held up for a chunk at a time.
 template <typename O>
 typename TransientObjectStore<O>::Phase TransientObjectStore<O>::OnWriting()
 {
@@ -239,28 +334,30 @@ typename TransientObjectStore<O>::Phase TransientObjectStore<O>::OnWriting()
   {
     return Phase::Flushing;
   }
-  else
+
+  std::size_t const chunk_end = std::min(written_count + WRITE_CHUNK, extracted_count);
+
+  chunk.clear();
+  for (; written_count < chunk_end; ++written_count)
   {
     O           obj;
     auto const &rid = rids[written_count];
 
-    FETCH_LOCK(cache_mutex_);
-
-    // get the element from the cache
+    // get the element from the cache. A miss means the RID was confirmed more than once and an
+    // earlier batch has already written and evicted it.
     if (GetFromCache(rid, obj))
     {
-      // write out the object
-      archive_.Set(rid, obj);
-
-      ++written_count;
+      chunk.emplace_back(rid, std::move(obj));
     }
-    else
+  }
+
+  // write out the objects
+  archive_.WithLock([this]() {
+    for (auto const &element : chunk)
     {
-      // If this is the case then for some reason the RID that was added
-      // to the queue has been removed from the cache.
-      assert(false);
+      archive_.LocklessSet(element.first, element.second);
     }
-  }
+  });
 
   return Phase::Writing;
 }
@@ -271,16 +368,18 @@ typename TransientObjectStore<O>::Phase TransientObjectStore<O>::OnWriting()
 template <typename O>
 typename TransientObjectStore<O>::Phase TransientObjectStore<O>::OnFlushing()
 {
-  FETCH_LOCK(cache_mutex_);
-
   assert(extracted_count <= batch_size_);
 
   for (std::size_t i = 0; i < extracted_count; ++i)
   {
-    cache_.erase(rids[i]);
+    EraseFromCache(rids[i]);
   }
 
+  pending_ -= extracted_count;
   extracted_count = 0;
+  chunk.clear();
+
+  flush_durations_->Add(std::chrono::duration<double>(Clock::now() - batch_started).count());
 
   return Phase::Populating;
 }
@@ -334,10 +433,9 @@ bool TransientObjectStore<O>::Get(ResourceID const &rid, O &object)
 {
   bool success = false;
 
-  {
-    FETCH_LOCK(cache_mutex_);
-    success = GetFromCache(rid, object) || archive_.Get(rid, object);
-  }
+  // the writer stores an object in the archive before evicting it from the cache, so checking
+  // the cache first never misses an object that is in transit
+  success = GetFromCache(rid, object) || archive_.Get(rid, object);
 
   if (!success)
   {
@@ -387,8 +485,6 @@ typename TransientObjectStore<O>::TxLayouts TransientObjectStore<O>::GetRecent(u
 template <typename O>
 bool TransientObjectStore<O>::Has(ResourceID const &rid)
 {
-  FETCH_LOCK(cache_mutex_);
-
   return IsInCache(rid) || archive_.Has(rid);
 }
 
@@ -406,11 +502,7 @@ void TransientObjectStore<O>::Set(ResourceID const &rid, O const &object, bool n
 
   FETCH_LOG_DEBUG(LOGGING_NAME, "Adding TX: ", byte_array::ToBase64(rid.id()));
 
-  {
-    FETCH_LOCK(cache_mutex_);
-
-    SetInCache(rid, object);
-  }
+  SetInCache(rid, object);
 
   if (newly_seen)
   {
@@ -451,26 +543,37 @@ void TransientObjectStore<O>::Set(ResourceID const &rid, O const &object, bool n
 template <typename O>
 bool TransientObjectStore<O>::Confirm(ResourceID const &rid)
 {
+  if (!IsInCache(rid))
   {
-    FETCH_LOCK(cache_mutex_);
-
-    if (!IsInCache(rid))
-    {
-      return false;
-    }
+    return false;
   }
 
   // add the element into the queue of items to be pushed to disk
+  ++pending_;
   confirm_queue_.Push(rid);
 
   return true;
 }
 
 /**
- * Internal: Lookup an element from the cache
+ * Internal: Find the cache shard responsible for a resource
  *
- * Note: Not thread safe. Always lock cache_mutex_ before
- * calling this function.
+ * The lowest bits of the resource group select the lane, so the shard is taken from the bits
+ * that follow them. Otherwise every resource of a lane would map to the same shard.
+ *
+ * @tparam O The type of the object being stored
+ * @param rid The resource id to be mapped
+ * @return The shard holding the resource
+ */
+template <typename O>
+typename TransientObjectStore<O>::Shard &TransientObjectStore<O>::LookupShard(
+    ResourceID const &rid)
+{
+  return shards_[(rid.resource_group() >> log2_num_lanes_) & (NUM_SHARDS - 1u)];
+}
+
+/**
+ * Internal: Lookup an element from the cache
  *
  * @tparam O The type of the object being stored
  * @param rid The resource id to be queried
@@ -480,10 +583,13 @@ bool TransientObjectStore<O>::Confirm(ResourceID const &rid)
 template <typename O>
 bool TransientObjectStore<O>::GetFromCache(ResourceID const &rid, O &object)
 {
-  bool success = false;
+  bool   success = false;
+  Shard &shard   = LookupShard(rid);
 
-  auto it = cache_.find(rid);
-  if (it != cache_.end())
+  FETCH_LOCK(shard.mutex);
+
+  auto it = shard.cache.find(rid);
+  if (it != shard.cache.end())
   {
     object  = it->second;
     success = true;
@@ -495,9 +601,6 @@ bool TransientObjectStore<O>::GetFromCache(ResourceID const &rid, O &object)
 /**
  * Internal: Set an element into the cache
  *
- * Note: Not thread safe. Always lock cache_mutex_ before
- * calling this function.
- *
  * @tparam O The type of the object being stored
  * @param rid The resource id of the element to be set
  * @param object The reference to the object to be stored
@@ -507,9 +610,12 @@ void TransientObjectStore<O>::SetInCache(ResourceID const &rid, O const &object)
 {
   typename Cache::iterator it;
   bool                     inserted{false};
+  Shard &                  shard = LookupShard(rid);
+
+  FETCH_LOCK(shard.mutex);
 
   // attempt to insert the element into the map
-  std::tie(it, inserted) = cache_.emplace(rid, object);
+  std::tie(it, inserted) = shard.cache.emplace(rid, object);
 
   // check to see if the insertion was successful
   if (!inserted)
@@ -522,9 +628,6 @@ void TransientObjectStore<O>::SetInCache(ResourceID const &rid, O const &object)
 /**
  * Internal: Check to see if an element is in the cache
  *
- * Note: Not thread safe. Always lock cache_mutex_ before
- * calling this function.
- *
  * @tparam O The type of the object being stored
  * @param rid The resource id of the element
  * @return
@@ -532,7 +635,27 @@ void TransientObjectStore<O>::SetInCache(ResourceID const &rid, O const &object)
 template <typename O>
 bool TransientObjectStore<O>::IsInCache(ResourceID const &rid)
 {
-  return cache_.find(rid) != cache_.end();
+  Shard &shard = LookupShard(rid);
+
+  FETCH_LOCK(shard.mutex);
+
+  return shard.cache.find(rid) != shard.cache.end();
+}
+
+/**
+ * Internal: Remove an element from the cache
+ *
+ * @tparam O The type of the object being stored
+ * @param rid The resource id of the element
+ */
+template <typename O>
+void TransientObjectStore<O>::EraseFromCache(ResourceID const &rid)
+{
+  Shard &shard = LookupShard(rid);
+
+  FETCH_LOCK(shard.mutex);
+
+  shard.cache.erase(rid);
 }
 
 }  // namespace storage
@@ -261,6 +261,31 @@ public:
     fin.close();
   }
 
+  /**
+   * Get the current position of the top of the stack. This can later be used to truncate the
+   * stack back to this point in a single operation.
+   *
+   * @return: The position of the top of the stack
+   */
+  Header Position() const
+  {
+    return header_;
+  }
+
+  /**
+   * Truncate the stack back to a position previously obtained with Position(). Unsafe if the stack
+   * has since been truncated below this position.
+   *
+   * @param: position The position to truncate to
+   */
+  void Truncate(Header const &position)
+  {
+    assert(position.end <= header_.end);
+    assert(position.object_count <= header_.object_count);
+
+    header_ = position;
+  }
+
   bool empty() const
   {
     return header_.object_count == 0;
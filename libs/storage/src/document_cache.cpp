@@ -0,0 +1,293 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "storage/document_cache.hpp"
+#include "telemetry/counter.hpp"
+#include "telemetry/registry.hpp"
+
+#include <functional>
+#include <string>
+
+namespace fetch {
+namespace storage {
+
+/**
+ * Construct an empty cache
+ *
+ * @param capacity The maximum number of bytes of document data to be cached, zero disables
+ */
+DocumentCache::DocumentCache(std::size_t capacity)
+{
+  SetCapacity(capacity);
+}
+
+/**
+ * Lookup a document in the cache, marking it as the most recently used
+ *
+ * @param key The address of the document
+ * @param document The output document, only populated on a hit
+ * @return true if the document was found, otherwise false
+ */
+bool DocumentCache::Lookup(ConstByteArray const &key, ConstByteArray &document)
+{
+  if (!enabled_)
+  {
+    return false;
+  }
+
+  bool found{false};
+
+  {
+    auto &shard = LookupShard(key);
+    std::lock_guard<Mutex> guard(shard.lock);
+
+    auto it = shard.elements.find(key);
+    if (it != shard.elements.end())
+    {
+      shard.recently_used.splice(shard.recently_used.begin(), shard.recently_used,
+                                 it->second.position);
+
+      document = it->second.document;
+      found    = true;
+    }
+  }
+
+  if (found)
+  {
+    ++hits_;
+
+    if (hit_count_)
+    {
+      hit_count_->increment();
+    }
+  }
+  else
+  {
+    ++misses_;
+
+    if (miss_count_)
+    {
+      miss_count_->increment();
+    }
+  }
+
+  return found;
+}
+
+/**
+ * Add (or replace) a document in the cache, evicting the least recently used documents to make
+ * space. Documents which are larger than a shard's capacity are not cached.
+ *
+ * @param key The address of the document
+ * @param document The document contents, this must not be modified after being added
+ */
+void DocumentCache::Add(ConstByteArray const &key, ConstByteArray const &document)
+{
+  if (!enabled_)
+  {
+    return;
+  }
+
+  auto &shard = LookupShard(key);
+  std::lock_guard<Mutex> guard(shard.lock);
+
+  auto it = shard.elements.find(key);
+  if (it != shard.elements.end())
+  {
+    EraseLocked(shard, it);
+  }
+
+  if ((shard.capacity == 0) || (document.size() > shard.capacity))
+  {
+    return;
+  }
+
+  EvictLocked(shard, shard.capacity - document.size());
+
+  shard.recently_used.push_front(key);
+  shard.elements.emplace(key, Element{document, shard.recently_used.begin()});
+  shard.size_in_bytes += document.size();
+}
+
+/**
+ * Remove a document from the cache, if present
+ *
+ * @param key The address of the document
+ */
+void DocumentCache::Erase(ConstByteArray const &key)
+{
+  auto &shard = LookupShard(key);
+  std::lock_guard<Mutex> guard(shard.lock);
+
+  auto it = shard.elements.find(key);
+  if (it != shard.elements.end())
+  {
+    EraseLocked(shard, it);
+  }
+}
+
+/**
+ * Remove all the documents from the cache
+ */
+void DocumentCache::Clear()
+{
+  for (auto &shard : shards_)
+  {
+    std::lock_guard<Mutex> guard(shard.lock);
+
+    shard.recently_used.clear();
+    shard.elements.clear();
+    shard.size_in_bytes = 0;
+  }
+}
+
+/**
+ * Export the hit, miss and eviction counts of this cache, labelled with the specified name. This
+ * must be called before the cache is shared between threads.
+ *
+ * @param name The name of the owning store, used as the value of the "store" label
+ */
+void DocumentCache::SetName(std::string const &name)
+{
+  telemetry::Registry::Labels const labels{{"store", name}};
+
+  hit_count_ = telemetry::Registry::Instance().CreateCounter(
+      "ledger_storage_document_cache_hits_total",
+      "The total number of documents read from the in memory cache", labels);
+  miss_count_ = telemetry::Registry::Instance().CreateCounter(
+      "ledger_storage_document_cache_misses_total",
+      "The total number of documents which had to be read from disk", labels);
+  eviction_count_ = telemetry::Registry::Instance().CreateCounter(
+      "ledger_storage_document_cache_evictions_total",
+      "The total number of documents evicted from the in memory cache", labels);
+}
+
+/**
+ * Update the capacity of the cache, evicting documents if necessary
+ *
+ * @param capacity The maximum number of bytes of document data to be cached, zero disables
+ */
+void DocumentCache::SetCapacity(std::size_t capacity)
+{
+  std::size_t const shard_capacity = capacity / NUM_SHARDS;
+
+  // when shrinking to nothing, stop serving lookups before the documents are evicted
+  if (shard_capacity == 0)
+  {
+    enabled_ = false;
+  }
+
+  for (auto &shard : shards_)
+  {
+    std::lock_guard<Mutex> guard(shard.lock);
+
+    shard.capacity = shard_capacity;
+    EvictLocked(shard, shard.capacity);
+  }
+
+  enabled_ = (shard_capacity != 0);
+}
+
+bool DocumentCache::enabled() const
+{
+  return enabled_;
+}
+
+std::size_t DocumentCache::capacity() const
+{
+  std::size_t capacity{0};
+  for (auto const &shard : shards_)
+  {
+    std::lock_guard<Mutex> guard(shard.lock);
+    capacity += shard.capacity;
+  }
+
+  return capacity;
+}
+
+std::size_t DocumentCache::size() const
+{
+  std::size_t size{0};
+  for (auto const &shard : shards_)
+  {
+    std::lock_guard<Mutex> guard(shard.lock);
+    size += shard.elements.size();
+  }
+
+  return size;
+}
+
+std::size_t DocumentCache::size_in_bytes() const
+{
+  std::size_t size{0};
+  for (auto const &shard : shards_)
+  {
+    std::lock_guard<Mutex> guard(shard.lock);
+    size += shard.size_in_bytes;
+  }
+
+  return size;
+}
+
+uint64_t DocumentCache::hits() const
+{
+  return hits_;
+}
+
+uint64_t DocumentCache::misses() const
+{
+  return misses_;
+}
+
+uint64_t DocumentCache::evictions() const
+{
+  return evictions_;
+}
+
+DocumentCache::Shard &DocumentCache::LookupShard(ConstByteArray const &key)
+{
+  return shards_[std::hash<ConstByteArray>{}(key) % NUM_SHARDS];
+}
+
+/**
+ * Evict the least recently used documents until the shard is within the specified size. Must be
+ * called with the shard lock held.
+ */
+void DocumentCache::EvictLocked(Shard &shard, std::size_t capacity)
+{
+  while (shard.size_in_bytes > capacity)
+  {
+    EraseLocked(shard, shard.elements.find(shard.recently_used.back()));
+    ++evictions_;
+
+    if (eviction_count_)
+    {
+      eviction_count_->increment();
+    }
+  }
+}
+
+void DocumentCache::EraseLocked(Shard &shard, ElementMap::iterator it)
+{
+  shard.size_in_bytes -= it->second.document.size();
+  shard.recently_used.erase(it->second.position);
+  shard.elements.erase(it);
+}
+
+}  // namespace storage
+}  // namespace fetch
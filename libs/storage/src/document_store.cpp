@@ -0,0 +1,37 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "storage/document_store.hpp"
+#include "vectorise/threading/pool.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <thread>
+
+namespace fetch {
+namespace storage {
+
+threading::Pool &DocumentHashPool()
+{
+  static threading::Pool pool{std::max<std::size_t>(std::thread::hardware_concurrency(), 1),
+                              "DocHash"};
+  return pool;
+}
+
+}  // namespace storage
+}  // namespace fetch
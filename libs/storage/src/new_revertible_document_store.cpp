@@ -98,11 +98,53 @@ void NewRevertibleDocumentStore::Set(ResourceID const &rid, ByteArray const &val
   return storage_.Set(rid, value);
 }
 
+void NewRevertibleDocumentStore::SetMany(KeyValues const &values)
+{
+  storage_.SetMany(values);
+}
+
 void NewRevertibleDocumentStore::Erase(ResourceID const &rid)
 {
   return storage_.Erase(rid);
 }
 
+void NewRevertibleDocumentStore::BeginBatch()
+{
+  storage_.BeginBatch();
+}
+
+void NewRevertibleDocumentStore::CommitBatch()
+{
+  storage_.CommitBatch();
+}
+
+void NewRevertibleDocumentStore::DiscardBatch()
+{
+  storage_.DiscardBatch();
+}
+
+void NewRevertibleDocumentStore::EnableCache(std::string const &name, std::size_t capacity)
+{
+  storage_.EnableCache(name, capacity);
+}
+
+void NewRevertibleDocumentStore::SetCacheCapacity(std::size_t capacity)
+{
+  storage_.SetCacheCapacity(capacity);
+}
+
+/**
+ * Enable periodic snapshots of the store, so that reverts to distant states do not have to replay
+ * the whole of the intervening history. Each snapshot is a full copy of the store on disk.
+ *
+ * @param interval The number of commits between snapshots, zero disables them
+ * @param max_checkpoints The maximum number of snapshots kept
+ */
+void NewRevertibleDocumentStore::SetCheckpointPolicy(uint64_t interval, uint64_t max_checkpoints)
+{
+  storage_.SetCheckpointPolicy(interval, max_checkpoints);
+}
+
 // State-based operations
 Hash NewRevertibleDocumentStore::Commit()
 {
@@ -0,0 +1,180 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/byte_array/const_byte_array.hpp"
+#include "storage/document_cache.hpp"
+
+#include "gtest/gtest.h"
+
+#include <cstddef>
+#include <string>
+
+namespace {
+
+using fetch::byte_array::ConstByteArray;
+using fetch::storage::DocumentCache;
+
+constexpr std::size_t NUM_SHARDS = DocumentCache::NUM_SHARDS;
+
+ConstByteArray Key(std::size_t index)
+{
+  return ConstByteArray{"key-" + std::to_string(index)};
+}
+
+ConstByteArray Value(std::size_t size, char fill = 'x')
+{
+  return ConstByteArray{std::string(size, fill)};
+}
+
+TEST(DocumentCacheTests, CheckLookupAfterAdd)
+{
+  DocumentCache cache{DocumentCache::DEFAULT_CAPACITY};
+
+  ConstByteArray document;
+  EXPECT_FALSE(cache.Lookup(Key(0), document));
+
+  cache.Add(Key(0), Value(10, 'a'));
+  ASSERT_TRUE(cache.Lookup(Key(0), document));
+  EXPECT_EQ(document, Value(10, 'a'));
+
+  // replacing a document updates the accounting
+  cache.Add(Key(0), Value(20, 'b'));
+  ASSERT_TRUE(cache.Lookup(Key(0), document));
+  EXPECT_EQ(document, Value(20, 'b'));
+  EXPECT_EQ(cache.size(), 1u);
+  EXPECT_EQ(cache.size_in_bytes(), 20u);
+
+  EXPECT_EQ(cache.hits(), 2u);
+  EXPECT_EQ(cache.misses(), 1u);
+}
+
+TEST(DocumentCacheTests, CheckEraseAndClear)
+{
+  DocumentCache cache{DocumentCache::DEFAULT_CAPACITY};
+
+  for (std::size_t i = 0; i < 100; ++i)
+  {
+    cache.Add(Key(i), Value(8));
+  }
+  EXPECT_EQ(cache.size(), 100u);
+
+  ConstByteArray document;
+  cache.Erase(Key(5));
+  EXPECT_FALSE(cache.Lookup(Key(5), document));
+  EXPECT_TRUE(cache.Lookup(Key(6), document));
+  EXPECT_EQ(cache.size(), 99u);
+
+  cache.Clear();
+  EXPECT_FALSE(cache.Lookup(Key(6), document));
+  EXPECT_EQ(cache.size(), 0u);
+  EXPECT_EQ(cache.size_in_bytes(), 0u);
+}
+
+TEST(DocumentCacheTests, CheckCapacityIsRespected)
+{
+  static constexpr std::size_t DOCUMENT_SIZE = 100;
+  static constexpr std::size_t CAPACITY      = NUM_SHARDS * DOCUMENT_SIZE * 4;
+
+  DocumentCache cache{CAPACITY};
+
+  for (std::size_t i = 0; i < 1000; ++i)
+  {
+    cache.Add(Key(i), Value(DOCUMENT_SIZE));
+    EXPECT_LE(cache.size_in_bytes(), CAPACITY);
+  }
+
+  // documents larger than a shard are never cached
+  cache.Add(Key(1000), Value(CAPACITY));
+
+  ConstByteArray document;
+  EXPECT_FALSE(cache.Lookup(Key(1000), document));
+
+  // reducing the capacity evicts documents
+  cache.SetCapacity(CAPACITY / 2);
+  EXPECT_LE(cache.size_in_bytes(), CAPACITY / 2);
+}
+
+TEST(DocumentCacheTests, CheckLeastRecentlyUsedIsEvicted)
+{
+  // two documents per shard
+  DocumentCache cache{NUM_SHARDS * 20};
+
+  cache.Add(Key(0), Value(10));
+
+  // the document is used before every insertion, so it is never the least recently used
+  ConstByteArray document;
+  for (std::size_t i = 1; i < 1000; ++i)
+  {
+    ASSERT_TRUE(cache.Lookup(Key(0), document));
+    cache.Add(Key(i), Value(10));
+  }
+
+  EXPECT_LE(cache.size(), 2 * NUM_SHARDS);
+}
+
+TEST(DocumentCacheTests, CheckDisabledCache)
+{
+  DocumentCache cache{0};
+
+  cache.Add(Key(0), Value(0));
+  cache.Add(Key(1), Value(10));
+
+  ConstByteArray document;
+  EXPECT_FALSE(cache.Lookup(Key(0), document));
+  EXPECT_FALSE(cache.Lookup(Key(1), document));
+  EXPECT_EQ(cache.size(), 0u);
+  EXPECT_FALSE(cache.enabled());
+}
+
+TEST(DocumentCacheTests, CheckDisabledByDefault)
+{
+  DocumentCache cache{};
+  EXPECT_FALSE(cache.enabled());
+  EXPECT_EQ(cache.capacity(), 0u);
+
+  cache.Add(Key(0), Value(10));
+
+  // lookups of a disabled cache are not counted as misses
+  ConstByteArray document;
+  EXPECT_FALSE(cache.Lookup(Key(0), document));
+  EXPECT_EQ(cache.misses(), 0u);
+
+  cache.SetCapacity(DocumentCache::DEFAULT_CAPACITY);
+  EXPECT_TRUE(cache.enabled());
+}
+
+TEST(DocumentCacheTests, CheckCachesAreCountedSeparately)
+{
+  DocumentCache first{DocumentCache::DEFAULT_CAPACITY};
+  DocumentCache second{DocumentCache::DEFAULT_CAPACITY};
+  first.SetName("first");
+  second.SetName("second");
+
+  first.Add(Key(0), Value(10));
+
+  ConstByteArray document;
+  EXPECT_TRUE(first.Lookup(Key(0), document));
+  EXPECT_FALSE(second.Lookup(Key(0), document));
+
+  EXPECT_EQ(first.hits(), 1u);
+  EXPECT_EQ(first.misses(), 0u);
+  EXPECT_EQ(second.hits(), 0u);
+  EXPECT_EQ(second.misses(), 1u);
+}
+
+}  // namespace
@@ -26,6 +26,7 @@
 #include "gtest/gtest.h"
 
 #include <algorithm>
+#include <stdexcept>
 
 using namespace fetch::storage;
 using namespace fetch::byte_array;
@@ -143,6 +144,43 @@ TEST(storage_object_store_basic_functionality, Setting_and_getting_elements)
   }
 }
 
+TEST(storage_object_store_basic_functionality, batched_writes_are_applied_on_completion)
+{
+  ObjectStore<uint64_t> testStore;
+  testStore.New("testFile.db", "testIndex.db");
+
+  testStore.WithBatch([&testStore]() {
+    for (uint64_t i = 0; i < 10; ++i)
+    {
+      testStore.LocklessSet(ResourceAddress(std::to_string(i)), i);
+    }
+
+    // writes made earlier in the batch are visible to later reads
+    uint64_t result = 0;
+    EXPECT_TRUE(testStore.LocklessGet(ResourceAddress("3"), result));
+    EXPECT_EQ(3, result);
+  });
+
+  EXPECT_EQ(10, testStore.size());
+
+  for (uint64_t i = 0; i < 10; ++i)
+  {
+    uint64_t result = 0;
+    EXPECT_TRUE(testStore.Get(ResourceAddress(std::to_string(i)), result));
+    EXPECT_EQ(i, result);
+  }
+
+  // a failing batch leaves the store untouched
+  EXPECT_THROW(testStore.WithBatch([&testStore]() {
+    testStore.LocklessSet(ResourceAddress("10"), 10);
+    throw std::runtime_error("batch failed");
+  }),
+               std::runtime_error);
+
+  EXPECT_FALSE(testStore.Has(ResourceAddress("10")));
+  EXPECT_EQ(10, testStore.size());
+}
+
 TEST(storage_object_store_basic_functionality, find_over_basic_struct)
 {
   std::vector<uint64_t> keyTests{99, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 100};
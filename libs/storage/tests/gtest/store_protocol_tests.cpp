@@ -0,0 +1,269 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/bitvector.hpp"
+#include "core/byte_array/const_byte_array.hpp"
+#include "core/serializers/main_serializer.hpp"
+#include "crypto/ecdsa.hpp"
+#include "ledger/chain/address.hpp"
+#include "ledger/chain/transaction.hpp"
+#include "ledger/chain/transaction_builder.hpp"
+#include "ledger/chain/transaction_layout_rpc_serializers.hpp"
+#include "ledger/chain/transaction_rpc_serializers.hpp"
+#include "network/service/abstract_callable.hpp"
+#include "network/service/protocol.hpp"
+#include "storage/document_store_protocol.hpp"
+#include "storage/new_revertible_document_store.hpp"
+#include "storage/object_store_protocol.hpp"
+#include "storage/resource_mapper.hpp"
+#include "storage/transient_object_store.hpp"
+
+#include "gtest/gtest.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace {
+
+using fetch::BitVector;
+using fetch::byte_array::ConstByteArray;
+using fetch::crypto::ECDSASigner;
+using fetch::ledger::Address;
+using fetch::ledger::Transaction;
+using fetch::ledger::TransactionBuilder;
+using fetch::serializers::MsgPackSerializer;
+using fetch::service::PackArgs;
+using fetch::service::Protocol;
+using fetch::storage::NewRevertibleDocumentStore;
+using fetch::storage::ObjectStoreProtocol;
+using fetch::storage::ResourceAddress;
+using fetch::storage::ResourceID;
+using fetch::storage::RevertibleDocumentStoreProtocol;
+using fetch::storage::TransientObjectStore;
+
+using StateProtocol = RevertibleDocumentStoreProtocol;
+using ObjectStore   = TransientObjectStore<Transaction>;
+using ObjectProto   = ObjectStoreProtocol<Transaction>;
+using ResourceIDs   = std::vector<ResourceID>;
+using FunctionId    = fetch::service::function_handler_type;
+
+constexpr uint32_t LANE = 0;
+
+/**
+ * Invoke a protocol handler directly, in the same way the RPC server does
+ */
+template <typename... Args>
+MsgPackSerializer Invoke(Protocol &protocol, FunctionId function, Args &&... args)
+{
+  MsgPackSerializer params{};
+  PackArgs(params, std::forward<Args>(args)...);
+
+  MsgPackSerializer result{};
+  (*protocol[function])(result, params);
+  result.seek(0);
+
+  return result;
+}
+
+template <typename R, typename... Args>
+R Call(Protocol &protocol, FunctionId function, Args &&... args)
+{
+  auto result = Invoke(protocol, function, std::forward<Args>(args)...);
+
+  R value{};
+  result >> value;
+  return value;
+}
+
+ResourceIDs MakeKeys(std::size_t count)
+{
+  ResourceIDs keys{};
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    keys.emplace_back(ResourceAddress{"key-" + std::to_string(i)});
+  }
+
+  return keys;
+}
+
+ConstByteArray MakeValue(std::size_t index)
+{
+  return ConstByteArray{"value-" + std::to_string(index)};
+}
+
+Transaction MakeTransaction(ECDSASigner const &signer, std::size_t index)
+{
+  return *TransactionBuilder()
+              .From(Address{signer.identity()})
+              .TargetChainCode("fetch.dummy", BitVector{})
+              .Action("run")
+              .Signer(signer.identity())
+              .Data(std::to_string(index))
+              .Seal()
+              .Sign(signer)
+              .Build();
+}
+
+TEST(StoreProtocolTests, state_get_many_and_set_many_round_trip)
+{
+  NewRevertibleDocumentStore store;
+  store.New("sp_a.db", "sp_b.db", "sp_c.db", "sp_d.db", true);
+  StateProtocol protocol{&store, LANE};
+
+  auto const keys = MakeKeys(20);
+
+  StateProtocol::ElementList elements{};
+  for (std::size_t i = 0; i < keys.size(); ++i)
+  {
+    elements.push_back({keys[i], MakeValue(i)});
+  }
+
+  // write all the values in a single request
+  Invoke(protocol, StateProtocol::SET_MANY, elements);
+
+  // the batched writes must produce the same state as the individual writes
+  NewRevertibleDocumentStore reference;
+  reference.New("sp_e.db", "sp_f.db", "sp_g.db", "sp_h.db", true);
+  for (auto const &element : elements)
+  {
+    reference.Set(element.key, element.value);
+  }
+  EXPECT_EQ(store.Commit(), reference.Commit());
+
+  // read back a mix of present and absent keys, in a different order to which they were written
+  ResourceIDs request{keys[5], ResourceID{ResourceAddress{"missing"}}, keys[0], keys[19]};
+
+  auto const documents = Call<StateProtocol::Documents>(protocol, StateProtocol::GET_MANY, request);
+  ASSERT_EQ(documents.size(), request.size());
+
+  EXPECT_FALSE(documents[0].failed);
+  EXPECT_EQ(documents[0].document, MakeValue(5));
+  EXPECT_TRUE(documents[1].failed);
+  EXPECT_FALSE(documents[2].failed);
+  EXPECT_EQ(documents[2].document, MakeValue(0));
+  EXPECT_FALSE(documents[3].failed);
+  EXPECT_EQ(documents[3].document, MakeValue(19));
+}
+
+TEST(StoreProtocolTests, state_set_many_is_isolated_from_concurrent_writes_and_commits)
+{
+  static constexpr std::size_t NUM_BATCHES    = 20;
+  static constexpr std::size_t BATCH_SIZE     = 10;
+  static constexpr std::size_t NUM_SINGLE_SET = NUM_BATCHES * BATCH_SIZE;
+
+  NewRevertibleDocumentStore store;
+  store.New("sp_i.db", "sp_j.db", "sp_k.db", "sp_l.db", true);
+  StateProtocol protocol{&store, LANE};
+
+  auto const batch_keys = MakeKeys(NUM_BATCHES * BATCH_SIZE);
+
+  ResourceIDs single_keys{};
+  for (std::size_t i = 0; i < NUM_SINGLE_SET; ++i)
+  {
+    single_keys.emplace_back(ResourceAddress{"single-" + std::to_string(i)});
+  }
+
+  // one client writes individual keys...
+  std::thread single_writer{[&protocol, &single_keys]() {
+    for (std::size_t i = 0; i < single_keys.size(); ++i)
+    {
+      Invoke(protocol, StateProtocol::SET, single_keys[i], MakeValue(i));
+    }
+  }};
+
+  // ...while another writes batches and commits between them
+  std::thread batch_writer{[&protocol, &batch_keys]() {
+    for (std::size_t batch = 0; batch < NUM_BATCHES; ++batch)
+    {
+      StateProtocol::ElementList elements{};
+      for (std::size_t i = batch * BATCH_SIZE; i < (batch + 1) * BATCH_SIZE; ++i)
+      {
+        elements.push_back({batch_keys[i], MakeValue(i)});
+      }
+
+      Invoke(protocol, StateProtocol::SET_MANY, elements);
+      Invoke(protocol, StateProtocol::COMMIT);
+    }
+  }};
+
+  single_writer.join();
+  batch_writer.join();
+
+  // none of the writes have been lost...
+  auto const documents =
+      Call<StateProtocol::Documents>(protocol, StateProtocol::GET_MANY, single_keys);
+  ASSERT_EQ(documents.size(), single_keys.size());
+  for (std::size_t i = 0; i < documents.size(); ++i)
+  {
+    EXPECT_FALSE(documents[i].failed);
+    EXPECT_EQ(documents[i].document, MakeValue(i));
+  }
+
+  // ...and the final state is the same as applying them all one at a time
+  NewRevertibleDocumentStore reference;
+  reference.New("sp_m.db", "sp_n.db", "sp_o.db", "sp_p.db", true);
+  for (std::size_t i = 0; i < NUM_SINGLE_SET; ++i)
+  {
+    reference.Set(single_keys[i], MakeValue(i));
+    reference.Set(batch_keys[i], MakeValue(i));
+  }
+  EXPECT_EQ(store.Commit(), reference.Commit());
+}
+
+TEST(StoreProtocolTests, object_get_bulk_omits_missing_objects)
+{
+  ObjectStore store{0, LANE};
+  store.New("sp_obj.db", "sp_obj_index.db", true);
+  ObjectProto protocol{&store, LANE};
+
+  ECDSASigner const signer;
+
+  std::vector<Transaction> txs{};
+  ResourceIDs              keys{};
+  for (std::size_t i = 0; i < 10; ++i)
+  {
+    txs.push_back(MakeTransaction(signer, i));
+    keys.emplace_back(txs.back().digest());
+
+    // only store every other transaction
+    if ((i % 2) == 0)
+    {
+      store.Set(keys.back(), txs.back(), true);
+    }
+  }
+
+  auto const elements = Call<ObjectProto::ElementList>(protocol, ObjectProto::GET_BULK, keys);
+
+  // the missing transactions are omitted and the response preserves the order of the request
+  ASSERT_EQ(elements.size(), keys.size() / 2);
+  for (std::size_t i = 0; i < elements.size(); ++i)
+  {
+    EXPECT_EQ(elements[i].key, keys[2 * i]);
+    EXPECT_EQ(elements[i].value.digest(), txs[2 * i].digest());
+  }
+
+  // an empty request is valid
+  EXPECT_TRUE(
+      Call<ObjectProto::ElementList>(protocol, ObjectProto::GET_BULK, ResourceIDs{}).empty());
+}
+
+}  // namespace
@@ -0,0 +1,205 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/bitvector.hpp"
+#include "crypto/ecdsa.hpp"
+#include "ledger/chain/address.hpp"
+#include "ledger/chain/transaction.hpp"
+#include "ledger/chain/transaction_builder.hpp"
+#include "ledger/chain/transaction_rpc_serializers.hpp"
+#include "storage/resource_mapper.hpp"
+#include "storage/transient_object_store.hpp"
+
+#include "gtest/gtest.h"
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using fetch::BitVector;
+using fetch::crypto::ECDSASigner;
+using fetch::ledger::Address;
+using fetch::ledger::Transaction;
+using fetch::ledger::TransactionBuilder;
+using fetch::storage::ResourceID;
+
+using TransactionStore = fetch::storage::TransientObjectStore<Transaction>;
+using TransactionList  = std::vector<Transaction>;
+
+constexpr uint32_t LOG2_NUM_LANES = 2;
+
+TransactionList GenerateTransactions(std::size_t count)
+{
+  ECDSASigner const signer;
+
+  TransactionList transactions;
+  transactions.reserve(count);
+
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    auto tx = TransactionBuilder()
+                  .From(Address{signer.identity()})
+                  .TargetChainCode("fetch.dummy", BitVector{})
+                  .Action("run")
+                  .Signer(signer.identity())
+                  .Data(std::to_string(i))
+                  .Seal()
+                  .Sign(signer)
+                  .Build();
+
+    transactions.push_back(*tx);
+  }
+
+  return transactions;
+}
+
+class TransientObjectStoreTests : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    store_ = std::make_unique<TransactionStore>(LOG2_NUM_LANES);
+    store_->New("transient_store_test.db", "transient_store_test_index.db", true);
+  }
+
+  // Runs the write back worker until every confirmed transaction has reached the archive
+  void DrainConfirmations()
+  {
+    auto worker = store_->GetWeakRunnable().lock();
+    ASSERT_TRUE(worker);
+
+    for (std::size_t i = 0; (i < 100000) && (store_->PendingConfirmations() > 0); ++i)
+    {
+      worker->Execute();
+    }
+
+    EXPECT_EQ(store_->PendingConfirmations(), 0u);
+  }
+
+  std::unique_ptr<TransactionStore> store_;
+};
+
+TEST_F(TransientObjectStoreTests, set_get_and_has_across_shards)
+{
+  auto const transactions = GenerateTransactions(200);
+
+  for (auto const &tx : transactions)
+  {
+    store_->Set(ResourceID{tx.digest()}, tx, false);
+  }
+
+  EXPECT_EQ(store_->Size(), transactions.size());
+
+  for (auto const &tx : transactions)
+  {
+    ResourceID const rid{tx.digest()};
+    Transaction      retrieved;
+
+    EXPECT_TRUE(store_->Has(rid));
+    ASSERT_TRUE(store_->Get(rid, retrieved));
+    EXPECT_EQ(retrieved.digest(), tx.digest());
+  }
+}
+
+TEST_F(TransientObjectStoreTests, confirmed_objects_are_written_back)
+{
+  auto const transactions = GenerateTransactions(300);
+
+  for (auto const &tx : transactions)
+  {
+    store_->Set(ResourceID{tx.digest()}, tx, false);
+  }
+
+  // unknown resources can not be confirmed
+  EXPECT_FALSE(store_->Confirm(ResourceID{GenerateTransactions(1).front().digest()}));
+
+  for (auto const &tx : transactions)
+  {
+    EXPECT_TRUE(store_->Confirm(ResourceID{tx.digest()}));
+  }
+
+  EXPECT_EQ(store_->PendingConfirmations(), transactions.size());
+
+  DrainConfirmations();
+
+  EXPECT_EQ(store_->Size(), transactions.size());
+
+  for (auto const &tx : transactions)
+  {
+    Transaction retrieved;
+    ASSERT_TRUE(store_->Get(ResourceID{tx.digest()}, retrieved));
+    EXPECT_EQ(retrieved.digest(), tx.digest());
+  }
+}
+
+TEST_F(TransientObjectStoreTests, concurrent_clients_and_writer)
+{
+  static constexpr std::size_t NUM_CLIENTS = 4;
+
+  std::vector<TransactionList> transactions;
+  for (std::size_t i = 0; i < NUM_CLIENTS; ++i)
+  {
+    transactions.push_back(GenerateTransactions(150));
+  }
+
+  std::vector<std::thread> clients;
+  for (auto const &list : transactions)
+  {
+    clients.emplace_back([this, &list]() {
+      for (auto const &tx : list)
+      {
+        ResourceID const rid{tx.digest()};
+        Transaction      retrieved;
+
+        store_->Set(rid, tx, false);
+        EXPECT_TRUE(store_->Get(rid, retrieved));
+        EXPECT_TRUE(store_->Confirm(rid));
+      }
+    });
+  }
+
+  // write back while the clients are still running
+  auto worker = store_->GetWeakRunnable().lock();
+  for (std::size_t i = 0; i < 1000; ++i)
+  {
+    worker->Execute();
+  }
+
+  for (auto &client : clients)
+  {
+    client.join();
+  }
+
+  DrainConfirmations();
+
+  for (auto const &list : transactions)
+  {
+    for (auto const &tx : list)
+    {
+      Transaction retrieved;
+      ASSERT_TRUE(store_->Get(ResourceID{tx.digest()}, retrieved));
+      EXPECT_EQ(retrieved.digest(), tx.digest());
+    }
+  }
+}
+
+}  // namespace
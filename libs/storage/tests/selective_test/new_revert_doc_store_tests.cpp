@@ -633,3 +633,163 @@ TEST(new_revertible_store_test, stress_test)
     ASSERT_EQ(current_state.size(), store.size());
   }
 }
+
+TEST(new_revertible_store_test, batched_writes_match_individual_writes)
+{
+  NewRevertibleDocumentStore individual;
+  NewRevertibleDocumentStore batched;
+  individual.New("a_77.db", "b_77.db", "c_77.db", "d_77.db", true);
+  batched.New("a_78.db", "b_78.db", "c_78.db", "d_78.db", true);
+
+  LinearCongruentialGenerator rng;
+  auto                        unique_hashes = GenerateUniqueHashes(1000);
+
+  std::vector<ResourceID> rids;
+  for (auto const &hash : unique_hashes)
+  {
+    rids.emplace_back(ResourceID(hash));
+  }
+
+  std::vector<ByteArray> hashes;
+
+  for (std::size_t round = 0; round < 4; ++round)
+  {
+    batched.BeginBatch();
+
+    // overwrite, create and erase a random selection of keys, touching some keys more than once
+    for (std::size_t i = 0; i < 600; ++i)
+    {
+      auto const &rid = rids[rng() % rids.size()];
+
+      if ((round > 0) && ((rng() % 5) == 0))
+      {
+        individual.Erase(rid);
+        batched.Erase(rid);
+
+        EXPECT_TRUE(batched.Get(rid).failed);
+      }
+      else
+      {
+        std::string const value = GetStringForTesting(rng);
+
+        individual.Set(rid, value);
+        batched.Set(rid, value);
+
+        auto const document = batched.Get(rid);
+        EXPECT_FALSE(document.failed);
+        EXPECT_EQ(std::string{document.document}, value);
+      }
+    }
+
+    batched.CommitBatch();
+
+    ASSERT_EQ(batched.size(), individual.size());
+    ASSERT_EQ(batched.CurrentHash(), individual.CurrentHash());
+
+    hashes.push_back(batched.Commit());
+    ASSERT_EQ(hashes.back(), individual.Commit());
+  }
+
+  // Every key must be readable from the batched store exactly as it is from the reference
+  for (auto const &rid : rids)
+  {
+    auto const expected = individual.Get(rid);
+    auto const actual   = batched.Get(rid);
+
+    ASSERT_EQ(actual.failed, expected.failed);
+    ASSERT_EQ(actual.document, expected.document);
+  }
+
+  // Discarded batches leave the store untouched and reverting still works
+  batched.BeginBatch();
+  batched.Set(rids[0], "discarded");
+  batched.DiscardBatch();
+  EXPECT_EQ(batched.CurrentHash(), hashes.back());
+
+  ASSERT_TRUE(batched.RevertToHash(hashes.front()));
+  EXPECT_EQ(batched.CurrentHash(), hashes.front());
+}
+
+TEST(new_revertible_store_test, cached_reads_track_writes_and_reverts)
+{
+  NewRevertibleDocumentStore store;
+  store.New("a_79.db", "b_79.db", "c_79.db", "d_79.db", true);
+  store.EnableCache("cached_reads_test");
+
+  ResourceID const rid{ResourceAddress{"cached"}};
+  ResourceID const other{ResourceAddress{"other"}};
+
+  store.Set(rid, "first");
+  auto const first_hash = store.Commit();
+
+  // read twice, the second read is served from the cache
+  EXPECT_EQ(std::string{store.Get(rid).document}, "first");
+  EXPECT_EQ(std::string{store.Get(rid).document}, "first");
+
+  // modifying the returned document must not affect the cached copy
+  auto document = store.Get(rid);
+  document.document[0] = 'F';
+  EXPECT_EQ(std::string{store.Get(rid).document}, "first");
+
+  store.Set(rid, "second");
+  EXPECT_EQ(std::string{store.Get(rid).document}, "second");
+
+  store.Erase(rid);
+  EXPECT_TRUE(store.Get(rid).failed);
+
+  // batched writes are visible in the batch and after the commit
+  store.Set(rid, "third");
+  EXPECT_EQ(std::string{store.Get(rid).document}, "third");
+  store.BeginBatch();
+  store.Set(rid, "fourth");
+  EXPECT_EQ(std::string{store.Get(rid).document}, "fourth");
+  store.DiscardBatch();
+  EXPECT_EQ(std::string{store.Get(rid).document}, "third");
+  store.BeginBatch();
+  store.Set(rid, "fifth");
+  store.Set(other, "other");
+  store.CommitBatch();
+  EXPECT_EQ(std::string{store.Get(rid).document}, "fifth");
+  EXPECT_EQ(std::string{store.Get(other).document}, "other");
+
+  // reverting drops the cached documents
+  ASSERT_TRUE(store.RevertToHash(first_hash));
+  EXPECT_EQ(std::string{store.Get(rid).document}, "first");
+  EXPECT_TRUE(store.Get(other).failed);
+
+  // with the cache disabled the reads are unchanged
+  store.SetCacheCapacity(0);
+  EXPECT_EQ(std::string{store.Get(rid).document}, "first");
+}
+
+TEST(new_revertible_store_test, revert_with_checkpoints_enabled)
+{
+  NewRevertibleDocumentStore store;
+  store.New("a_80.db", "b_80.db", "c_80.db", "d_80.db", true);
+  store.SetCheckpointPolicy(3, 2);
+
+  // commit a series of states, each changing every key
+  std::vector<ConstByteArray> hashes;
+  for (std::size_t commit = 0; commit < 12; ++commit)
+  {
+    for (std::size_t i = 0; i < 8; ++i)
+    {
+      store.Set(storage::ResourceAddress(std::to_string(i)), std::to_string(commit * 100 + i));
+    }
+
+    hashes.push_back(store.Commit());
+  }
+
+  // revert back across the checkpoints, most recent first
+  for (std::size_t commit : {10u, 7u, 1u})
+  {
+    ASSERT_TRUE(store.RevertToHash(hashes[commit]));
+
+    for (std::size_t i = 0; i < 8; ++i)
+    {
+      auto document = store.Get(storage::ResourceAddress(std::to_string(i)));
+      ASSERT_FALSE(document.failed);
+      EXPECT_EQ(std::string{document.document}, std::to_string(commit * 100 + i));
+    }
+  }
+}
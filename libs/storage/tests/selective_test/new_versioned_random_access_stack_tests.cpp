@@ -202,3 +202,127 @@ TEST(versioned_random_access_stack_gtest, loading_file)
     }
   }
 }
+
+TEST(versioned_random_access_stack_gtest, hash_exists_tracks_commits_and_reverts)
+{
+  NewVersionedRandomAccessStack<StringProxy> stack;
+  stack.New("d_main.db", "d_history.db");
+
+  std::vector<ByteArray> hashes;
+  for (std::size_t i = 0; i < 200; ++i)
+  {
+    hashes.push_back(Hash<crypto::SHA256>(std::to_string(i)));
+  }
+
+  // commit enough hashes to force the index to grow a number of times
+  for (std::size_t i = 0; i < 100; ++i)
+  {
+    stack.Push(std::to_string(i));
+    stack.Commit(hashes[i]);
+  }
+
+  for (std::size_t i = 0; i < 200; ++i)
+  {
+    EXPECT_EQ(stack.HashExists(hashes[i]), i < 100);
+  }
+
+  stack.RevertToHash(hashes[49]);
+  EXPECT_EQ(stack.size(), 50);
+
+  for (std::size_t i = 0; i < 200; ++i)
+  {
+    EXPECT_EQ(stack.HashExists(hashes[i]), i < 50);
+  }
+
+  // a key committed twice maps back to its earlier bookmark when the later one is reverted
+  stack.Push(std::string{"duplicate"});
+  stack.Commit(hashes[10]);
+  stack.Push(std::string{"after duplicate"});
+  stack.Commit(hashes[150]);
+
+  stack.RevertToHash(hashes[10]);
+  EXPECT_EQ(stack.size(), 51);
+  EXPECT_FALSE(stack.HashExists(hashes[150]));
+
+  stack.RevertToHash(hashes[30]);
+  EXPECT_EQ(stack.size(), 31);
+  EXPECT_TRUE(stack.HashExists(hashes[10]));
+
+  stack.RevertToHash(hashes[10]);
+  EXPECT_EQ(stack.size(), 11);
+  EXPECT_FALSE(stack.HashExists(hashes[30]));
+}
+
+TEST(versioned_random_access_stack_gtest, revert_across_checkpoints)
+{
+  std::vector<ByteArray> hashes;
+  for (std::size_t i = 0; i < 40; ++i)
+  {
+    hashes.push_back(Hash<crypto::SHA256>(std::to_string(i)));
+  }
+
+  auto const expected_value = [](std::size_t commit, std::size_t i) {
+    return std::to_string(commit * 100 + i);
+  };
+
+  {
+    NewVersionedRandomAccessStack<StringProxy> stack;
+    stack.New("e_main.db", "e_history.db");
+    stack.SetCheckpointPolicy(4, 3);
+
+    for (std::size_t i = 0; i < 8; ++i)
+    {
+      stack.Push(std::to_string(i));
+    }
+
+    // each commit rewrites the whole stack many times over, so the history is much larger than the
+    // stack itself
+    for (std::size_t commit = 0; commit < 40; ++commit)
+    {
+      for (std::size_t round = 0; round < 4; ++round)
+      {
+        for (std::size_t i = 0; i < 8; ++i)
+        {
+          stack.Set(i, expected_value(commit, i + round));
+        }
+      }
+
+      for (std::size_t i = 0; i < 8; ++i)
+      {
+        stack.Set(i, expected_value(commit, i));
+      }
+
+      stack.Commit(hashes[commit]);
+    }
+
+    EXPECT_EQ(stack.num_checkpoints(), 3);
+
+    // revert to a bookmark just below the oldest remaining checkpoint
+    stack.RevertToHash(hashes[30]);
+
+    for (std::size_t i = 0; i < 8; ++i)
+    {
+      EXPECT_EQ(stack.Get(i), expected_value(30, i));
+    }
+
+    EXPECT_EQ(stack.num_checkpoints(), 0);
+    EXPECT_FALSE(stack.HashExists(hashes[31]));
+    EXPECT_TRUE(stack.HashExists(hashes[30]));
+  }
+
+  {
+    NewVersionedRandomAccessStack<StringProxy> stack;
+    stack.Load("e_main.db", "e_history.db");
+
+    EXPECT_TRUE(stack.HashExists(hashes[0]));
+    EXPECT_TRUE(stack.HashExists(hashes[30]));
+    EXPECT_FALSE(stack.HashExists(hashes[31]));
+
+    stack.RevertToHash(hashes[3]);
+
+    for (std::size_t i = 0; i < 8; ++i)
+    {
+      EXPECT_EQ(stack.Get(i), expected_value(3, i));
+    }
+  }
+}
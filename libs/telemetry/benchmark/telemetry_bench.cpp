@@ -0,0 +1,142 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/mutex.hpp"
+#include "telemetry/counter.hpp"
+#include "telemetry/histogram.hpp"
+
+#include "benchmark/benchmark.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <vector>
+
+namespace {
+
+using fetch::telemetry::Counter;
+using fetch::telemetry::Histogram;
+
+/**
+ * The previous histogram implementation, a mutex protected ordered map of cumulative buckets
+ */
+class MutexHistogram
+{
+public:
+  explicit MutexHistogram(std::vector<double> const &buckets)
+  {
+    for (auto const &bucket : buckets)
+    {
+      buckets_.emplace(bucket, 0u);
+    }
+  }
+
+  void Add(double const &value)
+  {
+    FETCH_LOCK(lock_);
+
+    for (auto it = buckets_.lower_bound(value), end = buckets_.end(); it != end; ++it)
+    {
+      ++(it->second);
+    }
+
+    ++count_;
+    sum_ += value;
+  }
+
+private:
+  std::mutex                 lock_;
+  std::map<double, uint64_t> buckets_;
+  uint64_t                   count_{0};
+  double                     sum_{0.0};
+};
+
+// the bucket layout used for the execution manager and executor durations
+std::vector<double> const DURATION_BUCKETS{
+    0.000001, 0.000002, 0.000003, 0.000004, 0.000005, 0.000006, 0.000007, 0.000008, 0.000009,
+    0.00001,  0.00002,  0.00003,  0.00004,  0.00005,  0.00006,  0.00007,  0.00008,  0.00009,
+    0.0001,   0.0002,   0.0003,   0.0004,   0.0005,   0.0006,   0.0007,   0.0008,   0.0009,
+    0.001,    0.01,     0.1,      1,        10.,      100.};
+
+double SampleValue(std::size_t i)
+{
+  // spread the samples over the range of the buckets
+  static constexpr double SAMPLES[] = {0.0000015, 0.0000072, 0.000035, 0.00041,
+                                       0.00087,   0.0042,    0.07,     3.0};
+
+  return SAMPLES[i & 7u];
+}
+
+template <typename T>
+void Histogram_Add(benchmark::State &state, T &histogram)
+{
+  std::size_t i{0};
+  for (auto _ : state)
+  {
+    histogram.Add(SampleValue(i++));
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+
+void Histogram_Add_Mutex(benchmark::State &state)
+{
+  static MutexHistogram histogram{DURATION_BUCKETS};
+
+  Histogram_Add(state, histogram);
+}
+
+void Histogram_Add_Sharded(benchmark::State &state)
+{
+  static Histogram histogram{DURATION_BUCKETS, "bench_duration", ""};
+
+  Histogram_Add(state, histogram);
+}
+
+void Counter_Increment_Atomic(benchmark::State &state)
+{
+  static std::atomic<uint64_t> counter{0};
+
+  for (auto _ : state)
+  {
+    counter.fetch_add(1);
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+
+void Counter_Increment_Sharded(benchmark::State &state)
+{
+  static Counter counter{"bench_counter_total", ""};
+
+  for (auto _ : state)
+  {
+    counter.increment();
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+
+}  // namespace
+
+BENCHMARK(Histogram_Add_Mutex)->ThreadRange(1, 32)->UseRealTime();
+BENCHMARK(Histogram_Add_Sharded)->ThreadRange(1, 32)->UseRealTime();
+BENCHMARK(Counter_Increment_Atomic)->ThreadRange(1, 32)->UseRealTime();
+BENCHMARK(Counter_Increment_Sharded)->ThreadRange(1, 32)->UseRealTime();
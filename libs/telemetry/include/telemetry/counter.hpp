@@ -18,13 +18,18 @@
 //------------------------------------------------------------------------------
 
 #include "telemetry/measurement.hpp"
+#include "telemetry/sharded_array.hpp"
 
-#include <atomic>
+#include <cstdint>
 #include <string>
 
 namespace fetch {
 namespace telemetry {
 
+/**
+ * A monotonic counter. Updates are made to a per thread shard, so that they do not contend when
+ * the counter is used on hot paths, and are only summed when the counter is read.
+ */
 class Counter : public Measurement
 {
 public:
@@ -53,7 +58,7 @@ public:
   Counter &operator=(Counter &&) = delete;
 
 private:
-  std::atomic<uint64_t> counter_{0};
+  ShardedArray counter_{1};
 };
 
 }  // namespace telemetry
@@ -18,17 +18,23 @@
 //------------------------------------------------------------------------------
 
 #include "telemetry/measurement.hpp"
+#include "telemetry/sharded_array.hpp"
 
-#include <functional>
+#include <cstddef>
 #include <initializer_list>
-#include <map>
-#include <mutex>
 #include <string>
 #include <vector>
 
 namespace fetch {
 namespace telemetry {
 
+/**
+ * A histogram of observed values.
+ *
+ * The bucket bounds are kept in a flat sorted array which is binary searched on each addition.
+ * Only the matching bucket is updated (the cumulative counts are built when the histogram is
+ * streamed) and all the updates are made lock free to a per thread shard.
+ */
 class Histogram : public Measurement
 {
 public:
@@ -56,17 +62,17 @@ public:
   Histogram &operator=(Histogram &&) = delete;
 
 private:
-  using Mutex     = std::mutex;
-  using BucketMap = std::map<double, uint64_t>;
+  using Bounds = std::vector<double>;
 
   template <typename Iterator>
   Histogram(Iterator const &begin, Iterator const &end, std::string const &name,
             std::string const &description, Labels const &labels = Labels{});
 
-  mutable Mutex lock_;
-  BucketMap     buckets_;
-  uint64_t      count_{0};
-  double        sum_{0.0};
+  std::size_t overflow_index() const;
+  std::size_t sum_index() const;
+
+  Bounds       bounds_;  ///< The sorted upper bounds of the buckets
+  ShardedArray values_;  ///< The bucket counts, the overflow count and the (bit cast) sum
 };
 
 }  // namespace telemetry
@@ -0,0 +1,104 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace fetch {
+namespace telemetry {
+
+/**
+ * A fixed size array of counters which is replicated across a number of shards.
+ *
+ * Each thread updates the values in its own shard (selected when the thread first uses any
+ * sharded array) so that concurrent updates do not contend on the same cache lines. The shards
+ * are only combined when the values are read, which for telemetry happens on collection.
+ */
+class ShardedArray
+{
+public:
+  using Value = std::atomic<uint64_t>;
+
+  // Construction / Destruction
+  explicit ShardedArray(std::size_t size);
+  ShardedArray(ShardedArray const &) = delete;
+  ShardedArray(ShardedArray &&)      = delete;
+  ~ShardedArray()                    = default;
+
+  /// @name Accessors
+  /// @{
+  std::size_t  size() const;
+  std::size_t  num_shards() const;
+  Value &      local(std::size_t index);
+  Value const &at(std::size_t shard, std::size_t index) const;
+  uint64_t     Sum(std::size_t index) const;
+  /// @}
+
+  // Operators
+  ShardedArray &operator=(ShardedArray const &) = delete;
+  ShardedArray &operator=(ShardedArray &&) = delete;
+
+private:
+  using Values = std::unique_ptr<Value[], void (*)(void *)>;
+
+  static std::size_t LocalShard();
+
+  std::size_t const size_;
+  std::size_t const num_shards_;
+  std::size_t const stride_;  ///< The number of values per shard, padded to whole cache lines
+  Values            values_;  ///< The values of all the shards, aligned to a cache line
+};
+
+inline std::size_t ShardedArray::size() const
+{
+  return size_;
+}
+
+inline std::size_t ShardedArray::num_shards() const
+{
+  return num_shards_;
+}
+
+/**
+ * Access the value at the specified index in the shard of the calling thread
+ *
+ * @param index The index of the value
+ * @return The reference to the value
+ */
+inline ShardedArray::Value &ShardedArray::local(std::size_t index)
+{
+  return values_[(LocalShard() * stride_) + index];
+}
+
+/**
+ * Access the value at the specified index in the specified shard
+ *
+ * @param shard The index of the shard
+ * @param index The index of the value
+ * @return The reference to the value
+ */
+inline ShardedArray::Value const &ShardedArray::at(std::size_t shard, std::size_t index) const
+{
+  return values_[(shard * stride_) + index];
+}
+
+}  // namespace telemetry
+}  // namespace fetch
@@ -19,6 +19,7 @@
 #include "core/string/ends_with.hpp"
 #include "telemetry/counter.hpp"
 
+#include <atomic>
 #include <ostream>
 #include <stdexcept>
 #include <string>
@@ -53,33 +54,33 @@ Counter::Counter(std::string name, std::string description, Labels labels)
 void Counter::ToStream(OutputStream &stream) const
 {
   WriteHeader(stream, "counter");
-  WriteValuePrefix(stream) << counter_ << '\n';
+  WriteValuePrefix(stream) << count() << '\n';
 }
 
 uint64_t Counter::count() const
 {
-  return counter_;
+  return counter_.Sum(0);
 }
 
 void Counter::increment()
 {
-  ++counter_;
+  add(1);
 }
 
 void Counter::add(uint64_t value)
 {
-  counter_ += value;
+  counter_.local(0).fetch_add(value, std::memory_order_relaxed);
 }
 
 Counter &Counter::operator++()
 {
-  ++counter_;
+  add(1);
   return *this;
 }
 
 Counter &Counter::operator+=(uint64_t value)
 {
-  counter_ += value;
+  add(value);
   return *this;
 }
 
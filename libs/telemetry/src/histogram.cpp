@@ -16,13 +16,33 @@
 //
 //------------------------------------------------------------------------------
 
-#include "core/mutex.hpp"
 #include "telemetry/histogram.hpp"
 
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
 #include <ostream>
 
 namespace fetch {
 namespace telemetry {
+namespace {
+
+uint64_t ToBits(double value)
+{
+  uint64_t bits{0};
+  std::memcpy(&bits, &value, sizeof(bits));
+  return bits;
+}
+
+double FromBits(uint64_t bits)
+{
+  double value{0.0};
+  std::memcpy(&value, &bits, sizeof(value));
+  return value;
+}
+
+}  // namespace
 
 /**
  * Create a histogram from a init. list of bucket values
@@ -64,14 +84,12 @@ template <typename Iterator>
 Histogram::Histogram(Iterator const &begin, Iterator const &end, std::string const &name,
                      std::string const &description, Labels const &labels)
   : Measurement{name, description, labels}
+  , bounds_(begin, end)
+  , values_{bounds_.size() + 2u}
 {
-  FETCH_LOCK(lock_);
-
-  // build up the initial bucket values
-  for (auto it = begin; it != end; ++it)
-  {
-    buckets_.emplace(*it, 0u);
-  }
+  // ensure the bucket bounds are ordered and unique
+  std::sort(bounds_.begin(), bounds_.end());
+  bounds_.erase(std::unique(bounds_.begin(), bounds_.end()), bounds_.end());
 }
 
 /**
@@ -81,17 +99,19 @@ Histogram::Histogram(Iterator const &begin, Iterator const &end, std::string con
  */
 void Histogram::Add(double const &value)
 {
-  FETCH_LOCK(lock_);
+  // find the smallest bucket which can contain the value (or the overflow bucket)
+  auto const bucket = static_cast<std::size_t>(
+      std::lower_bound(bounds_.begin(), bounds_.end(), value) - bounds_.begin());
+
+  values_.local(bucket).fetch_add(1, std::memory_order_relaxed);
 
-  // update all of the buckets
-  for (auto it = buckets_.lower_bound(value), end = buckets_.end(); it != end; ++it)
+  // update the sum, since the shard is normally only used by this thread this rarely retries
+  auto &   sum     = values_.local(sum_index());
+  uint64_t current = sum.load(std::memory_order_relaxed);
+  while (!sum.compare_exchange_weak(current, ToBits(FromBits(current) + value),
+                                    std::memory_order_relaxed))
   {
-    ++(it->second);
   }
-
-  // update the aggregates
-  ++count_;
-  sum_ += value;
 }
 
 /**
@@ -102,18 +122,43 @@ void Histogram::Add(double const &value)
  */
 void Histogram::ToStream(OutputStream &stream) const
 {
-  FETCH_LOCK(lock_);
-
   WriteHeader(stream, "histogram");
-  for (auto const &element : buckets_)
+
+  // aggregate the shards into the cumulative bucket counts
+  uint64_t count{0};
+  for (std::size_t i = 0; i < bounds_.size(); ++i)
   {
-    WriteValuePrefix(stream, "bucket", {{"le", std::to_string(element.first)}})
-        << element.second << '\n';
+    count += values_.Sum(i);
+
+    WriteValuePrefix(stream, "bucket", {{"le", std::to_string(bounds_[i])}}) << count << '\n';
+  }
+  count += values_.Sum(overflow_index());
+
+  double sum{0.0};
+  for (std::size_t shard = 0; shard < values_.num_shards(); ++shard)
+  {
+    sum += FromBits(values_.at(shard, sum_index()).load(std::memory_order_relaxed));
   }
-  WriteValuePrefix(stream, "bucket", {{"le", "+Inf"}}) << count_ << '\n';
 
-  WriteValuePrefix(stream, "sum") << sum_ << '\n';
-  WriteValuePrefix(stream, "count") << count_ << '\n';
+  WriteValuePrefix(stream, "bucket", {{"le", "+Inf"}}) << count << '\n';
+  WriteValuePrefix(stream, "sum") << sum << '\n';
+  WriteValuePrefix(stream, "count") << count << '\n';
+}
+
+/**
+ * Internal: The index of the count of values larger than all the bucket bounds
+ */
+std::size_t Histogram::overflow_index() const
+{
+  return bounds_.size();
+}
+
+/**
+ * Internal: The index of the sum of all the values
+ */
+std::size_t Histogram::sum_index() const
+{
+  return bounds_.size() + 1u;
 }
 
 }  // namespace telemetry
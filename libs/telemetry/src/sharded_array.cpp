@@ -0,0 +1,127 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "telemetry/sharded_array.hpp"
+
+#include <mm_malloc.h>
+
+#include <algorithm>
+#include <new>
+#include <thread>
+
+namespace fetch {
+namespace telemetry {
+namespace {
+
+constexpr std::size_t CACHE_LINE_SIZE = 64;
+constexpr std::size_t MAX_NUM_SHARDS  = 64;
+constexpr std::size_t VALUES_PER_LINE = CACHE_LINE_SIZE / sizeof(ShardedArray::Value);
+
+/**
+ * Determine the number of shards to use, one per hardware thread rounded up to a power of two
+ *
+ * @return The number of shards
+ */
+std::size_t CalculateNumShards()
+{
+  std::size_t const concurrency =
+      std::min<std::size_t>(std::max(std::thread::hardware_concurrency(), 1u), MAX_NUM_SHARDS);
+
+  std::size_t num_shards{1};
+  while (num_shards < concurrency)
+  {
+    num_shards <<= 1u;
+  }
+
+  return num_shards;
+}
+
+/**
+ * Get the number of shards, calculated on first use to avoid depending on the static
+ * initialisation order of metrics
+ *
+ * @return The number of shards
+ */
+std::size_t NumShards()
+{
+  static std::size_t const num_shards = CalculateNumShards();
+  return num_shards;
+}
+
+std::atomic<std::size_t> next_thread_index{0};
+
+}  // namespace
+
+/**
+ * Construct a zeroed sharded array
+ *
+ * @param size The number of values in the array
+ */
+ShardedArray::ShardedArray(std::size_t size)
+  : size_{size}
+  , num_shards_{NumShards()}
+  , stride_{((size + VALUES_PER_LINE - 1u) / VALUES_PER_LINE) * VALUES_PER_LINE}
+  , values_{static_cast<Value *>(
+                _mm_malloc(num_shards_ * stride_ * sizeof(Value), CACHE_LINE_SIZE)),
+            _mm_free}
+{
+  if (!values_)
+  {
+    throw std::bad_alloc{};
+  }
+
+  for (std::size_t i = 0, end = num_shards_ * stride_; i < end; ++i)
+  {
+    new (&values_[i]) Value{0};
+  }
+}
+
+/**
+ * Calculate the total of a value across all the shards
+ *
+ * @param index The index of the value
+ * @return The total value
+ */
+uint64_t ShardedArray::Sum(std::size_t index) const
+{
+  uint64_t total{0};
+
+  for (std::size_t shard = 0; shard < num_shards_; ++shard)
+  {
+    total += at(shard, index).load(std::memory_order_relaxed);
+  }
+
+  return total;
+}
+
+/**
+ * Internal: Determine the shard to be used by the calling thread. Threads are assigned shards in
+ * a round robin fashion the first time they are used.
+ *
+ * @return The index of the shard
+ */
+std::size_t ShardedArray::LocalShard()
+{
+  static thread_local std::size_t const shard =
+      next_thread_index.fetch_add(1, std::memory_order_relaxed) & (NumShards() - 1u);
+
+  return shard;
+}
+
+}  // namespace telemetry
+}  // namespace fetch
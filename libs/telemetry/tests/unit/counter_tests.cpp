@@ -21,6 +21,8 @@
 #include "gtest/gtest.h"
 
 #include <memory>
+#include <thread>
+#include <vector>
 
 namespace {
 
@@ -85,4 +87,28 @@ test_counter_total{foo="bar"} 500
   EXPECT_EQ(oss.str(), std::string{EXPECTED_TEXT});
 }
 
+TEST_F(CounterTests, ConcurrentIncrements)
+{
+  static constexpr std::size_t NUM_THREADS    = 8;
+  static constexpr std::size_t NUM_INCREMENTS = 10000;
+
+  std::vector<std::thread> threads;
+  for (std::size_t i = 0; i < NUM_THREADS; ++i)
+  {
+    threads.emplace_back([this]() {
+      for (std::size_t j = 0; j < NUM_INCREMENTS; ++j)
+      {
+        counter_->increment();
+      }
+    });
+  }
+
+  for (auto &thread : threads)
+  {
+    thread.join();
+  }
+
+  EXPECT_EQ(NUM_THREADS * NUM_INCREMENTS, counter_->count());
+}
+
 }  // namespace
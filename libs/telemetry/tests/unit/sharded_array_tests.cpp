@@ -0,0 +1,80 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "telemetry/sharded_array.hpp"
+
+#include "gtest/gtest.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using fetch::telemetry::ShardedArray;
+
+constexpr std::size_t CACHE_LINE_SIZE = 64;
+
+TEST(ShardedArrayTests, CheckShardsAreCacheLineAligned)
+{
+  for (std::size_t size : {1u, 3u, 8u, 9u, 17u})
+  {
+    ShardedArray array{size};
+
+    for (std::size_t shard = 0; shard < array.num_shards(); ++shard)
+    {
+      auto const address = reinterpret_cast<std::uintptr_t>(&array.at(shard, 0));
+      EXPECT_EQ(0u, address % CACHE_LINE_SIZE);
+    }
+  }
+}
+
+TEST(ShardedArrayTests, CheckValuesAreZeroedAndSummed)
+{
+  static constexpr std::size_t NUM_THREADS = 4;
+
+  ShardedArray array{3};
+
+  for (std::size_t index = 0; index < array.size(); ++index)
+  {
+    EXPECT_EQ(0u, array.Sum(index));
+  }
+
+  std::vector<std::thread> threads;
+  for (std::size_t i = 0; i < NUM_THREADS; ++i)
+  {
+    threads.emplace_back([&array]() {
+      for (std::size_t j = 0; j < 1000; ++j)
+      {
+        array.local(1).fetch_add(1, std::memory_order_relaxed);
+      }
+    });
+  }
+
+  for (auto &thread : threads)
+  {
+    thread.join();
+  }
+
+  EXPECT_EQ(0u, array.Sum(0));
+  EXPECT_EQ(NUM_THREADS * 1000u, array.Sum(1));
+  EXPECT_EQ(0u, array.Sum(2));
+}
+
+}  // namespace
@@ -0,0 +1,138 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "vectorise/memory/shared_array.hpp"
+#include "vectorise/vectorise.hpp"
+
+#include "benchmark/benchmark.h"
+
+#include <cstddef>
+
+using namespace fetch::memory;
+using namespace fetch::vectorize;
+
+// Runs the same kernels on every register width the build supports, so that the SSE, AVX2 and
+// AVX-512 backends can be compared from a single binary. The parallel dispatcher itself always
+// uses the widest one.
+
+template <typename T, std::size_t N = 100000>
+class RegisterWidthBench
+{
+public:
+  RegisterWidthBench()
+    : a_(N)
+    , b_(N)
+  {
+    for (std::size_t i = 0; i < N; ++i)
+    {
+      b_[i] = T(i + 1);
+    }
+  }
+
+  template <std::size_t W, typename F>
+  void Apply(F &&kernel)
+  {
+    using VectorRegisterType = VectorRegister<T, W>;
+
+    VectorRegisterType x, y;
+    for (std::size_t i = 0; i < N; i += VectorRegisterType::E_BLOCK_COUNT)
+    {
+      x = VectorRegisterType(b_.pointer() + i);
+      kernel(x, y);
+      y.Store(a_.pointer() + i);
+    }
+  }
+
+  SharedArray<T> a_, b_;
+};
+
+template <typename T, std::size_t W>
+void BM_ApproxExpLog(benchmark::State &state)
+{
+  using VectorRegisterType = VectorRegister<T, W>;
+
+  RegisterWidthBench<T> bench;
+  VectorRegisterType    one(T(1));
+  for (auto _ : state)
+  {
+    bench.template Apply<W>([one](VectorRegisterType const &x, VectorRegisterType &y) {
+      y = approx_exp(one + approx_log(x));
+    });
+    benchmark::DoNotOptimize(bench.a_.pointer());
+  }
+}
+
+template <typename T, std::size_t W>
+void BM_MultiplyAdd(benchmark::State &state)
+{
+  using VectorRegisterType = VectorRegister<T, W>;
+
+  RegisterWidthBench<T> bench;
+  VectorRegisterType    scale(T(3)), offset(T(2));
+  for (auto _ : state)
+  {
+    bench.template Apply<W>([scale, offset](VectorRegisterType const &x, VectorRegisterType &y) {
+      y = max(scale * x + offset, x);
+    });
+    benchmark::DoNotOptimize(bench.a_.pointer());
+  }
+}
+
+template <typename T, std::size_t W>
+void BM_Reduce(benchmark::State &state)
+{
+  using VectorRegisterType = VectorRegister<T, W>;
+
+  RegisterWidthBench<T> bench;
+  T                     sum{0};
+  for (auto _ : state)
+  {
+    VectorRegisterType acc(T(0));
+    for (std::size_t i = 0; i < bench.b_.size(); i += VectorRegisterType::E_BLOCK_COUNT)
+    {
+      acc = acc + VectorRegisterType(bench.b_.pointer() + i);
+    }
+    sum = reduce(acc);
+    benchmark::DoNotOptimize(sum);
+  }
+}
+
+BENCHMARK_TEMPLATE(BM_ApproxExpLog, float, 128);
+BENCHMARK_TEMPLATE(BM_ApproxExpLog, double, 128);
+BENCHMARK_TEMPLATE(BM_MultiplyAdd, float, 128);
+BENCHMARK_TEMPLATE(BM_MultiplyAdd, double, 128);
+BENCHMARK_TEMPLATE(BM_Reduce, float, 128);
+BENCHMARK_TEMPLATE(BM_Reduce, double, 128);
+
+#ifdef __AVX2__
+BENCHMARK_TEMPLATE(BM_ApproxExpLog, float, 256);
+BENCHMARK_TEMPLATE(BM_ApproxExpLog, double, 256);
+BENCHMARK_TEMPLATE(BM_MultiplyAdd, float, 256);
+BENCHMARK_TEMPLATE(BM_MultiplyAdd, double, 256);
+BENCHMARK_TEMPLATE(BM_Reduce, float, 256);
+BENCHMARK_TEMPLATE(BM_Reduce, double, 256);
+#endif
+
+#if defined(__AVX512F__) && defined(__AVX512DQ__)
+BENCHMARK_TEMPLATE(BM_ApproxExpLog, float, 512);
+BENCHMARK_TEMPLATE(BM_ApproxExpLog, double, 512);
+BENCHMARK_TEMPLATE(BM_MultiplyAdd, float, 512);
+BENCHMARK_TEMPLATE(BM_MultiplyAdd, double, 512);
+BENCHMARK_TEMPLATE(BM_Reduce, float, 512);
+BENCHMARK_TEMPLATE(BM_Reduce, double, 512);
+#endif
@@ -0,0 +1,43 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "vectorise/arch/avx.hpp"
+
+#ifdef __AVX2__
+#include <immintrin.h>
+#include <limits>
+
+namespace fetch {
+namespace vectorize {
+
+inline VectorRegister<float, 256> abs(VectorRegister<float, 256> const &a)
+{
+  const __m256 mask = _mm256_castsi256_ps(_mm256_set1_epi32(std::numeric_limits<int32_t>::max()));
+  return VectorRegister<float, 256>(_mm256_and_ps(mask, a.data()));
+}
+
+inline VectorRegister<double, 256> abs(VectorRegister<double, 256> const &a)
+{
+  const __m256d mask = _mm256_castsi256_pd(_mm256_set1_epi64x(std::numeric_limits<int64_t>::max()));
+  return VectorRegister<double, 256>(_mm256_and_pd(mask, a.data()));
+}
+
+}  // namespace vectorize
+}  // namespace fetch
+#endif
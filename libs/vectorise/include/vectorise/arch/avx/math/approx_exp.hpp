@@ -0,0 +1,72 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "vectorise/arch/avx.hpp"
+
+#ifdef __AVX2__
+#include <cmath>
+#include <cstdint>
+
+namespace fetch {
+namespace vectorize {
+
+inline VectorRegister<float, 256> approx_exp(VectorRegister<float, 256> const &x)
+{
+  enum
+  {
+    mantissa = 23,
+    exponent = 8,
+  };
+
+  constexpr float                  multiplier      = float(1ull << mantissa);
+  constexpr float                  exponent_offset = (float(((1ull << (exponent - 1)) - 1)));
+  const VectorRegister<float, 256> a(float(multiplier / M_LN2));
+  const VectorRegister<float, 256> b(float(exponent_offset * multiplier - 60801));
+
+  VectorRegister<float, 256> y    = a * x + b;
+  __m256i                    conv = _mm256_cvtps_epi32(y.data());
+
+  return VectorRegister<float, 256>(_mm256_castsi256_ps(conv));
+}
+
+inline VectorRegister<double, 256> approx_exp(VectorRegister<double, 256> const &x)
+{
+  enum
+  {
+    mantissa = 20,
+    exponent = 11,
+  };
+
+  constexpr double                  multiplier      = double(1ull << mantissa);
+  constexpr double                  exponent_offset = (double(((1ull << (exponent - 1)) - 1)));
+  const VectorRegister<double, 256> a(double(multiplier / M_LN2));
+  const VectorRegister<double, 256> b(double(exponent_offset * multiplier - 60801));
+
+  VectorRegister<double, 256> y = a * x + b;
+
+  // Only the upper 32 bits of each double are computed, the lower half is left zero
+  __m256i conv = _mm256_cvtepi32_epi64(_mm256_cvtpd_epi32(y.data()));
+  conv         = _mm256_slli_epi64(conv, 32);
+
+  return VectorRegister<double, 256>(_mm256_castsi256_pd(conv));
+}
+
+}  // namespace vectorize
+}  // namespace fetch
+#endif
@@ -0,0 +1,73 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "vectorise/arch/avx.hpp"
+
+#ifdef __AVX2__
+#include <cmath>
+#include <cstdint>
+
+namespace fetch {
+namespace vectorize {
+
+inline VectorRegister<float, 256> approx_log(VectorRegister<float, 256> const &x)
+{
+  enum
+  {
+    mantissa = 23,
+    exponent = 8,
+  };
+
+  constexpr float                  multiplier      = float(1ull << mantissa);
+  constexpr float                  exponent_offset = (float(((1ull << (exponent - 1)) - 1)));
+  const VectorRegister<float, 256> a(float(M_LN2 / multiplier));
+  const VectorRegister<float, 256> b(float(exponent_offset * multiplier - 60801));
+
+  __m256i conv = _mm256_castps_si256(x.data());
+
+  VectorRegister<float, 256> y(_mm256_cvtepi32_ps(conv));
+
+  return a * (y - b);
+}
+
+inline VectorRegister<double, 256> approx_log(VectorRegister<double, 256> const &x)
+{
+  enum
+  {
+    mantissa = 20,
+    exponent = 11,
+  };
+
+  constexpr double                  multiplier      = double(1ull << mantissa);
+  constexpr double                  exponent_offset = (double(((1ull << (exponent - 1)) - 1)));
+  const VectorRegister<double, 256> a(double(M_LN2 / multiplier));
+  const VectorRegister<double, 256> b(double(exponent_offset * multiplier - 60801));
+
+  // Gather the upper 32 bits of each double into the lower 128 bits of the register
+  __m256i conv = _mm256_castpd_si256(x.data());
+  conv         = _mm256_permutevar8x32_epi32(conv, _mm256_setr_epi32(1, 3, 5, 7, 0, 2, 4, 6));
+
+  VectorRegister<double, 256> y(_mm256_cvtepi32_pd(_mm256_castsi256_si128(conv)));
+
+  return a * (y - b);
+}
+
+}  // namespace vectorize
+}  // namespace fetch
+#endif
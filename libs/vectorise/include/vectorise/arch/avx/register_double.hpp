@@ -0,0 +1,191 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#ifdef __AVX2__
+#include "vectorise/arch/avx/info.hpp"
+#include "vectorise/arch/avx/register_float.hpp"
+#include "vectorise/arch/avx/register_int32.hpp"
+#include "vectorise/info.hpp"
+#include "vectorise/register.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <immintrin.h>
+
+namespace fetch {
+namespace vectorize {
+
+template <>
+class VectorRegister<double, 256>
+{
+public:
+  using type             = double;
+  using mm_register_type = __m256d;
+
+  enum
+  {
+    E_VECTOR_SIZE   = 256,
+    E_REGISTER_SIZE = sizeof(mm_register_type),
+    E_BLOCK_COUNT   = E_REGISTER_SIZE / sizeof(type)
+  };
+
+  static_assert((E_BLOCK_COUNT * sizeof(type)) == E_REGISTER_SIZE,
+                "type cannot be contained in the given register size.");
+
+  VectorRegister() = default;
+  VectorRegister(type const *d)
+  {
+    data_ = _mm256_load_pd(d);
+  }
+  VectorRegister(mm_register_type const &d)
+    : data_(d)
+  {}
+  VectorRegister(mm_register_type &&d)
+    : data_(d)
+  {}
+  VectorRegister(type const &c)
+  {
+    data_ = _mm256_set1_pd(c);
+  }
+
+  explicit operator mm_register_type()
+  {
+    return data_;
+  }
+
+  void Store(type *ptr) const
+  {
+    _mm256_store_pd(ptr, data_);
+  }
+  void Stream(type *ptr) const
+  {
+    _mm256_stream_pd(ptr, data_);
+  }
+
+  mm_register_type const &data() const
+  {
+    return data_;
+  }
+  mm_register_type &data()
+  {
+    return data_;
+  }
+
+private:
+  mm_register_type data_;
+};
+
+inline VectorRegister<double, 256> operator-(VectorRegister<double, 256> const &x)
+{
+  return VectorRegister<double, 256>(_mm256_sub_pd(_mm256_setzero_pd(), x.data()));
+}
+
+#define FETCH_ADD_OPERATOR(op, type, L, fnc)                                       \
+  inline VectorRegister<type, 256> operator op(VectorRegister<type, 256> const &a, \
+                                               VectorRegister<type, 256> const &b) \
+  {                                                                                \
+    L ret = fnc(a.data(), b.data());                                               \
+    return VectorRegister<type, 256>(ret);                                         \
+  }
+
+FETCH_ADD_OPERATOR(*, double, __m256d, _mm256_mul_pd)
+FETCH_ADD_OPERATOR(-, double, __m256d, _mm256_sub_pd)
+FETCH_ADD_OPERATOR(/, double, __m256d, _mm256_div_pd)
+FETCH_ADD_OPERATOR(+, double, __m256d, _mm256_add_pd)
+
+#undef FETCH_ADD_OPERATOR
+
+// Comparisons yield 1 in the lanes where they hold and 0 elsewhere
+#define FETCH_ADD_OPERATOR(op, type, L, predicate)                                 \
+  inline VectorRegister<type, 256> operator op(VectorRegister<type, 256> const &a, \
+                                               VectorRegister<type, 256> const &b) \
+  {                                                                                \
+    L imm = _mm256_cmp_pd(a.data(), b.data(), predicate);                          \
+    L ret = _mm256_and_pd(imm, _mm256_set1_pd(type(1)));                           \
+    return VectorRegister<type, 256>(ret);                                         \
+  }
+
+FETCH_ADD_OPERATOR(==, double, __m256d, _CMP_EQ_OQ)
+FETCH_ADD_OPERATOR(!=, double, __m256d, _CMP_NEQ_UQ)
+FETCH_ADD_OPERATOR(>=, double, __m256d, _CMP_GE_OS)
+FETCH_ADD_OPERATOR(>, double, __m256d, _CMP_GT_OS)
+FETCH_ADD_OPERATOR(<=, double, __m256d, _CMP_LE_OS)
+FETCH_ADD_OPERATOR(<, double, __m256d, _CMP_LT_OS)
+
+#undef FETCH_ADD_OPERATOR
+
+// FREE FUNCTIONS
+
+inline VectorRegister<double, 256> vector_zero_below_element(VectorRegister<double, 256> const &a,
+                                                             int const &                        n)
+{
+  __m256i index = _mm256_setr_epi64x(0, 1, 2, 3);
+  __m256i mask  = _mm256_cmpgt_epi64(index, _mm256_set1_epi64x(n - 1));
+  return VectorRegister<double, 256>(_mm256_and_pd(a.data(), _mm256_castsi256_pd(mask)));
+}
+
+inline VectorRegister<double, 256> vector_zero_above_element(VectorRegister<double, 256> const &a,
+                                                             int const &                        n)
+{
+  __m256i index = _mm256_setr_epi64x(0, 1, 2, 3);
+  __m256i mask  = _mm256_cmpgt_epi64(_mm256_set1_epi64x(n + 1), index);
+  return VectorRegister<double, 256>(_mm256_and_pd(a.data(), _mm256_castsi256_pd(mask)));
+}
+
+inline VectorRegister<double, 256> shift_elements_left(VectorRegister<double, 256> const &x)
+{
+  __m256d n = _mm256_permute4x64_pd(x.data(), _MM_SHUFFLE(2, 1, 0, 3));
+  n         = _mm256_blend_pd(n, _mm256_setzero_pd(), 0x1);
+  return VectorRegister<double, 256>(n);
+}
+
+inline VectorRegister<double, 256> shift_elements_right(VectorRegister<double, 256> const &x)
+{
+  __m256d n = _mm256_permute4x64_pd(x.data(), _MM_SHUFFLE(0, 3, 2, 1));
+  n         = _mm256_blend_pd(n, _mm256_setzero_pd(), 0x8);
+  return VectorRegister<double, 256>(n);
+}
+
+inline double first_element(VectorRegister<double, 256> const &x)
+{
+  return _mm256_cvtsd_f64(x.data());
+}
+
+inline double reduce(VectorRegister<double, 256> const &x)
+{
+  __m128d r = _mm_add_pd(_mm256_castpd256_pd128(x.data()), _mm256_extractf128_pd(x.data(), 1));
+  r         = _mm_hadd_pd(r, r);
+  return _mm_cvtsd_f64(r);
+}
+
+inline bool all_less_than(VectorRegister<double, 256> const &x,
+                          VectorRegister<double, 256> const &y)
+{
+  return _mm256_movemask_pd(_mm256_cmp_pd(x.data(), y.data(), _CMP_LT_OS)) == 0xF;
+}
+
+inline bool any_less_than(VectorRegister<double, 256> const &x,
+                          VectorRegister<double, 256> const &y)
+{
+  return _mm256_movemask_pd(_mm256_cmp_pd(x.data(), y.data(), _CMP_LT_OS)) != 0;
+}
+
+}  // namespace vectorize
+}  // namespace fetch
+#endif
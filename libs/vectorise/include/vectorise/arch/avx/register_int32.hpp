@@ -0,0 +1,199 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#ifdef __AVX2__
+#include "vectorise/arch/avx/info.hpp"
+#include "vectorise/info.hpp"
+#include "vectorise/register.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <immintrin.h>
+
+namespace fetch {
+namespace vectorize {
+
+// AVX2 integers
+template <>
+class VectorRegister<int32_t, 256>
+{
+public:
+  using type             = int32_t;
+  using mm_register_type = __m256i;
+
+  enum
+  {
+    E_VECTOR_SIZE   = 256,
+    E_REGISTER_SIZE = sizeof(mm_register_type),
+    E_BLOCK_COUNT   = E_REGISTER_SIZE / sizeof(type)
+  };
+
+  static_assert((E_BLOCK_COUNT * sizeof(type)) == E_REGISTER_SIZE,
+                "type cannot be contained in the given register size.");
+
+  VectorRegister() = default;
+  VectorRegister(type const *d)
+  {
+    data_ = _mm256_load_si256(reinterpret_cast<mm_register_type const *>(d));
+  }
+  VectorRegister(type const &c)
+  {
+    data_ = _mm256_set1_epi32(c);
+  }
+  VectorRegister(mm_register_type const &d)
+    : data_(d)
+  {}
+  VectorRegister(mm_register_type &&d)
+    : data_(d)
+  {}
+
+  explicit operator mm_register_type()
+  {
+    return data_;
+  }
+
+  void Store(type *ptr) const
+  {
+    _mm256_store_si256(reinterpret_cast<mm_register_type *>(ptr), data_);
+  }
+
+  void Stream(type *ptr) const
+  {
+    _mm256_stream_si256(reinterpret_cast<mm_register_type *>(ptr), data_);
+  }
+
+  mm_register_type const &data() const
+  {
+    return data_;
+  }
+  mm_register_type &data()
+  {
+    return data_;
+  }
+
+private:
+  mm_register_type data_;
+};
+
+inline VectorRegister<int32_t, 256> operator-(VectorRegister<int32_t, 256> const &x)
+{
+  return VectorRegister<int32_t, 256>(_mm256_sub_epi32(_mm256_setzero_si256(), x.data()));
+}
+
+inline VectorRegister<int32_t, 256> operator+(VectorRegister<int32_t, 256> const &a,
+                                              VectorRegister<int32_t, 256> const &b)
+{
+  __m256i ret = _mm256_add_epi32(a.data(), b.data());
+  return VectorRegister<int32_t, 256>(ret);
+}
+
+inline VectorRegister<int32_t, 256> operator-(VectorRegister<int32_t, 256> const &a,
+                                              VectorRegister<int32_t, 256> const &b)
+{
+  __m256i ret = _mm256_sub_epi32(a.data(), b.data());
+  return VectorRegister<int32_t, 256>(ret);
+}
+
+inline VectorRegister<int32_t, 256> operator*(VectorRegister<int32_t, 256> const &a,
+                                              VectorRegister<int32_t, 256> const &b)
+{
+  __m256i ret = _mm256_mullo_epi32(a.data(), b.data());
+  return VectorRegister<int32_t, 256>(ret);
+}
+
+inline VectorRegister<int32_t, 256> operator/(VectorRegister<int32_t, 256> const &a,
+                                              VectorRegister<int32_t, 256> const &b)
+{
+  // There is no integer division instruction, so divide lane by lane
+  alignas(32) int32_t d1[8];
+  alignas(32) int32_t d2[8];
+  alignas(32) int32_t ret[8];
+  a.Store(d1);
+  b.Store(d2);
+
+  // don't divide by zero
+  for (std::size_t i = 0; i < 8; ++i)
+  {
+    ret[i] = d2[i] != 0 ? d1[i] / d2[i] : 0;
+  }
+
+  return VectorRegister<int32_t, 256>(ret);
+}
+
+inline VectorRegister<int32_t, 256> operator==(VectorRegister<int32_t, 256> const &a,
+                                               VectorRegister<int32_t, 256> const &b)
+{
+  __m256i ret = _mm256_cmpeq_epi32(a.data(), b.data());
+  return VectorRegister<int32_t, 256>(ret);
+}
+
+inline VectorRegister<int32_t, 256> operator<(VectorRegister<int32_t, 256> const &a,
+                                              VectorRegister<int32_t, 256> const &b)
+{
+  __m256i ret = _mm256_cmpgt_epi32(b.data(), a.data());
+  return VectorRegister<int32_t, 256>(ret);
+}
+
+inline VectorRegister<int32_t, 256> vector_zero_below_element(
+    VectorRegister<int32_t, 256> const &a, int const &n)
+{
+  __m256i index = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+  __m256i mask  = _mm256_cmpgt_epi32(index, _mm256_set1_epi32(n - 1));
+  return VectorRegister<int32_t, 256>(_mm256_and_si256(a.data(), mask));
+}
+
+inline VectorRegister<int32_t, 256> vector_zero_above_element(
+    VectorRegister<int32_t, 256> const &a, int const &n)
+{
+  __m256i index = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+  __m256i mask  = _mm256_cmpgt_epi32(_mm256_set1_epi32(n + 1), index);
+  return VectorRegister<int32_t, 256>(_mm256_and_si256(a.data(), mask));
+}
+
+inline int32_t first_element(VectorRegister<int32_t, 256> const &x)
+{
+  return _mm_cvtsi128_si32(_mm256_castsi256_si128(x.data()));
+}
+
+inline int32_t reduce(VectorRegister<int32_t, 256> const &x)
+{
+  __m128i r = _mm_add_epi32(_mm256_castsi256_si128(x.data()),
+                            _mm256_extracti128_si256(x.data(), 1));
+  r         = _mm_hadd_epi32(r, r);
+  r         = _mm_hadd_epi32(r, r);
+  return _mm_cvtsi128_si32(r);
+}
+
+inline VectorRegister<int32_t, 256> shift_elements_left(VectorRegister<int32_t, 256> const &x)
+{
+  __m256i n = _mm256_permutevar8x32_epi32(x.data(), _mm256_setr_epi32(7, 0, 1, 2, 3, 4, 5, 6));
+  n         = _mm256_blend_epi32(n, _mm256_setzero_si256(), 0x01);
+  return n;
+}
+
+inline VectorRegister<int32_t, 256> shift_elements_right(VectorRegister<int32_t, 256> const &x)
+{
+  __m256i n = _mm256_permutevar8x32_epi32(x.data(), _mm256_setr_epi32(1, 2, 3, 4, 5, 6, 7, 0));
+  n         = _mm256_blend_epi32(n, _mm256_setzero_si256(), 0x80);
+  return n;
+}
+
+}  // namespace vectorize
+}  // namespace fetch
+#endif
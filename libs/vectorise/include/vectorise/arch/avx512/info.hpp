@@ -17,7 +17,9 @@
 //
 //------------------------------------------------------------------------------
 
-#ifdef __AVX__
+#if defined(__AVX512F__) && defined(__AVX512DQ__)
+#include "vectorise/info.hpp"
+
 #include <cstddef>
 #include <cstdint>
 #include <emmintrin.h>
@@ -28,52 +30,52 @@ namespace fetch {
 namespace vectorize {
 
 template <>
-struct VectorInfo<uint8_t, 256>
+struct VectorInfo<uint8_t, 512>
 {
   using naitve_type   = uint8_t;
-  using register_type = __m256i;
+  using register_type = __m512i;
 };
 
 template <>
-struct VectorInfo<uint16_t, 256>
+struct VectorInfo<uint16_t, 512>
 {
   using naitve_type   = uint16_t;
-  using register_type = __m256i;
+  using register_type = __m512i;
 };
 
 template <>
-struct VectorInfo<uint32_t, 256>
+struct VectorInfo<uint32_t, 512>
 {
   using naitve_type   = uint32_t;
-  using register_type = __m256i;
+  using register_type = __m512i;
 };
 
 template <>
-struct VectorInfo<uint64_t, 256>
+struct VectorInfo<uint64_t, 512>
 {
   using naitve_type   = uint64_t;
-  using register_type = __m256i;
+  using register_type = __m512i;
 };
 
 template <>
-struct VectorInfo<int, 256>
+struct VectorInfo<int, 512>
 {
   using naitve_type   = int;
-  using register_type = __m256i;
+  using register_type = __m512i;
 };
 
 template <>
-struct VectorInfo<float, 256>
+struct VectorInfo<float, 512>
 {
   using naitve_type   = float;
-  using register_type = __m256;
+  using register_type = __m512;
 };
 
 template <>
-struct VectorInfo<double, 256>
+struct VectorInfo<double, 512>
 {
   using naitve_type   = double;
-  using register_type = __m256d;
+  using register_type = __m512d;
 };
 }  // namespace vectorize
 }  // namespace fetch
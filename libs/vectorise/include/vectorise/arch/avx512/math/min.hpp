@@ -0,0 +1,40 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "vectorise/arch/avx512.hpp"
+
+#if defined(__AVX512F__) && defined(__AVX512DQ__)
+namespace fetch {
+namespace vectorize {
+
+inline VectorRegister<float, 512> min(VectorRegister<float, 512> const &a,
+                                      VectorRegister<float, 512> const &b)
+{
+  return VectorRegister<float, 512>(_mm512_min_ps(a.data(), b.data()));
+}
+
+inline VectorRegister<double, 512> min(VectorRegister<double, 512> const &a,
+                                       VectorRegister<double, 512> const &b)
+{
+  return VectorRegister<double, 512>(_mm512_min_pd(a.data(), b.data()));
+}
+
+}  // namespace vectorize
+}  // namespace fetch
+#endif
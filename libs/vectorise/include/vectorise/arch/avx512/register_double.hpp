@@ -0,0 +1,187 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#if defined(__AVX512F__) && defined(__AVX512DQ__)
+#include "vectorise/arch/avx512/info.hpp"
+#include "vectorise/arch/avx512/register_float.hpp"
+#include "vectorise/arch/avx512/register_int32.hpp"
+#include "vectorise/info.hpp"
+#include "vectorise/register.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <immintrin.h>
+
+namespace fetch {
+namespace vectorize {
+
+template <>
+class VectorRegister<double, 512>
+{
+public:
+  using type             = double;
+  using mm_register_type = __m512d;
+
+  enum
+  {
+    E_VECTOR_SIZE   = 512,
+    E_REGISTER_SIZE = sizeof(mm_register_type),
+    E_BLOCK_COUNT   = E_REGISTER_SIZE / sizeof(type)
+  };
+
+  static_assert((E_BLOCK_COUNT * sizeof(type)) == E_REGISTER_SIZE,
+                "type cannot be contained in the given register size.");
+
+  VectorRegister() = default;
+  VectorRegister(type const *d)
+  {
+    data_ = _mm512_load_pd(d);
+  }
+  VectorRegister(mm_register_type const &d)
+    : data_(d)
+  {}
+  VectorRegister(mm_register_type &&d)
+    : data_(d)
+  {}
+  VectorRegister(type const &c)
+  {
+    data_ = _mm512_set1_pd(c);
+  }
+
+  explicit operator mm_register_type()
+  {
+    return data_;
+  }
+
+  void Store(type *ptr) const
+  {
+    _mm512_store_pd(ptr, data_);
+  }
+  void Stream(type *ptr) const
+  {
+    _mm512_stream_pd(ptr, data_);
+  }
+
+  mm_register_type const &data() const
+  {
+    return data_;
+  }
+  mm_register_type &data()
+  {
+    return data_;
+  }
+
+private:
+  mm_register_type data_;
+};
+
+inline VectorRegister<double, 512> operator-(VectorRegister<double, 512> const &x)
+{
+  return VectorRegister<double, 512>(_mm512_sub_pd(_mm512_setzero_pd(), x.data()));
+}
+
+#define FETCH_ADD_OPERATOR(op, type, L, fnc)                                       \
+  inline VectorRegister<type, 512> operator op(VectorRegister<type, 512> const &a, \
+                                               VectorRegister<type, 512> const &b) \
+  {                                                                                \
+    L ret = fnc(a.data(), b.data());                                               \
+    return VectorRegister<type, 512>(ret);                                         \
+  }
+
+FETCH_ADD_OPERATOR(*, double, __m512d, _mm512_mul_pd)
+FETCH_ADD_OPERATOR(-, double, __m512d, _mm512_sub_pd)
+FETCH_ADD_OPERATOR(/, double, __m512d, _mm512_div_pd)
+FETCH_ADD_OPERATOR(+, double, __m512d, _mm512_add_pd)
+
+#undef FETCH_ADD_OPERATOR
+
+// Comparisons yield 1 in the lanes where they hold and 0 elsewhere
+#define FETCH_ADD_OPERATOR(op, type, L, predicate)                                 \
+  inline VectorRegister<type, 512> operator op(VectorRegister<type, 512> const &a, \
+                                               VectorRegister<type, 512> const &b) \
+  {                                                                                \
+    auto mask = _mm512_cmp_pd_mask(a.data(), b.data(), predicate);                 \
+    L    ret  = _mm512_maskz_mov_pd(mask, _mm512_set1_pd(type(1)));                \
+    return VectorRegister<type, 512>(ret);                                         \
+  }
+
+FETCH_ADD_OPERATOR(==, double, __m512d, _CMP_EQ_OQ)
+FETCH_ADD_OPERATOR(!=, double, __m512d, _CMP_NEQ_UQ)
+FETCH_ADD_OPERATOR(>=, double, __m512d, _CMP_GE_OS)
+FETCH_ADD_OPERATOR(>, double, __m512d, _CMP_GT_OS)
+FETCH_ADD_OPERATOR(<=, double, __m512d, _CMP_LE_OS)
+FETCH_ADD_OPERATOR(<, double, __m512d, _CMP_LT_OS)
+
+#undef FETCH_ADD_OPERATOR
+
+// FREE FUNCTIONS
+
+inline VectorRegister<double, 512> vector_zero_below_element(VectorRegister<double, 512> const &a,
+                                                             int const &                        n)
+{
+  __m512i  index = _mm512_setr_epi64(0, 1, 2, 3, 4, 5, 6, 7);
+  __mmask8 mask  = _mm512_cmpge_epi64_mask(index, _mm512_set1_epi64(n));
+  return VectorRegister<double, 512>(_mm512_maskz_mov_pd(mask, a.data()));
+}
+
+inline VectorRegister<double, 512> vector_zero_above_element(VectorRegister<double, 512> const &a,
+                                                             int const &                        n)
+{
+  __m512i  index = _mm512_setr_epi64(0, 1, 2, 3, 4, 5, 6, 7);
+  __mmask8 mask  = _mm512_cmple_epi64_mask(index, _mm512_set1_epi64(n));
+  return VectorRegister<double, 512>(_mm512_maskz_mov_pd(mask, a.data()));
+}
+
+inline VectorRegister<double, 512> shift_elements_left(VectorRegister<double, 512> const &x)
+{
+  __m512i n = _mm512_alignr_epi64(_mm512_castpd_si512(x.data()), _mm512_setzero_si512(), 7);
+  return VectorRegister<double, 512>(_mm512_castsi512_pd(n));
+}
+
+inline VectorRegister<double, 512> shift_elements_right(VectorRegister<double, 512> const &x)
+{
+  __m512i n = _mm512_alignr_epi64(_mm512_setzero_si512(), _mm512_castpd_si512(x.data()), 1);
+  return VectorRegister<double, 512>(_mm512_castsi512_pd(n));
+}
+
+inline double first_element(VectorRegister<double, 512> const &x)
+{
+  return _mm_cvtsd_f64(_mm512_castpd512_pd128(x.data()));
+}
+
+inline double reduce(VectorRegister<double, 512> const &x)
+{
+  return _mm512_reduce_add_pd(x.data());
+}
+
+inline bool all_less_than(VectorRegister<double, 512> const &x,
+                          VectorRegister<double, 512> const &y)
+{
+  return _mm512_cmp_pd_mask(x.data(), y.data(), _CMP_LT_OS) == 0xFF;
+}
+
+inline bool any_less_than(VectorRegister<double, 512> const &x,
+                          VectorRegister<double, 512> const &y)
+{
+  return _mm512_cmp_pd_mask(x.data(), y.data(), _CMP_LT_OS) != 0;
+}
+
+}  // namespace vectorize
+}  // namespace fetch
+#endif
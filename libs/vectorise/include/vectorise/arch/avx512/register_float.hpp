@@ -0,0 +1,184 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#if defined(__AVX512F__) && defined(__AVX512DQ__)
+#include "vectorise/arch/avx512/info.hpp"
+#include "vectorise/arch/avx512/register_int32.hpp"
+#include "vectorise/info.hpp"
+#include "vectorise/register.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <immintrin.h>
+
+namespace fetch {
+namespace vectorize {
+
+template <>
+class VectorRegister<float, 512>
+{
+public:
+  using type             = float;
+  using mm_register_type = __m512;
+
+  enum
+  {
+    E_VECTOR_SIZE   = 512,
+    E_REGISTER_SIZE = sizeof(mm_register_type),
+    E_BLOCK_COUNT   = E_REGISTER_SIZE / sizeof(type)
+  };
+
+  static_assert((E_BLOCK_COUNT * sizeof(type)) == E_REGISTER_SIZE,
+                "type cannot be contained in the given register size.");
+
+  VectorRegister() = default;
+  VectorRegister(type const *d)
+  {
+    data_ = _mm512_load_ps(d);
+  }
+  VectorRegister(mm_register_type const &d)
+    : data_(d)
+  {}
+  VectorRegister(mm_register_type &&d)
+    : data_(d)
+  {}
+  VectorRegister(type const &c)
+  {
+    data_ = _mm512_set1_ps(c);
+  }
+
+  explicit operator mm_register_type()
+  {
+    return data_;
+  }
+
+  void Store(type *ptr) const
+  {
+    _mm512_store_ps(ptr, data_);
+  }
+  void Stream(type *ptr) const
+  {
+    _mm512_stream_ps(ptr, data_);
+  }
+
+  mm_register_type const &data() const
+  {
+    return data_;
+  }
+  mm_register_type &data()
+  {
+    return data_;
+  }
+
+private:
+  mm_register_type data_;
+};
+
+inline VectorRegister<float, 512> operator-(VectorRegister<float, 512> const &x)
+{
+  return VectorRegister<float, 512>(_mm512_sub_ps(_mm512_setzero_ps(), x.data()));
+}
+
+#define FETCH_ADD_OPERATOR(op, type, L, fnc)                                       \
+  inline VectorRegister<type, 512> operator op(VectorRegister<type, 512> const &a, \
+                                               VectorRegister<type, 512> const &b) \
+  {                                                                                \
+    L ret = fnc(a.data(), b.data());                                               \
+    return VectorRegister<type, 512>(ret);                                         \
+  }
+
+FETCH_ADD_OPERATOR(*, float, __m512, _mm512_mul_ps)
+FETCH_ADD_OPERATOR(-, float, __m512, _mm512_sub_ps)
+FETCH_ADD_OPERATOR(/, float, __m512, _mm512_div_ps)
+FETCH_ADD_OPERATOR(+, float, __m512, _mm512_add_ps)
+
+#undef FETCH_ADD_OPERATOR
+
+// Comparisons yield 1 in the lanes where they hold and 0 elsewhere
+#define FETCH_ADD_OPERATOR(op, type, L, predicate)                                 \
+  inline VectorRegister<type, 512> operator op(VectorRegister<type, 512> const &a, \
+                                               VectorRegister<type, 512> const &b) \
+  {                                                                                \
+    auto mask = _mm512_cmp_ps_mask(a.data(), b.data(), predicate);                 \
+    L    ret  = _mm512_maskz_mov_ps(mask, _mm512_set1_ps(type(1)));                \
+    return VectorRegister<type, 512>(ret);                                         \
+  }
+
+FETCH_ADD_OPERATOR(==, float, __m512, _CMP_EQ_OQ)
+FETCH_ADD_OPERATOR(!=, float, __m512, _CMP_NEQ_UQ)
+FETCH_ADD_OPERATOR(>=, float, __m512, _CMP_GE_OS)
+FETCH_ADD_OPERATOR(>, float, __m512, _CMP_GT_OS)
+FETCH_ADD_OPERATOR(<=, float, __m512, _CMP_LE_OS)
+FETCH_ADD_OPERATOR(<, float, __m512, _CMP_LT_OS)
+
+#undef FETCH_ADD_OPERATOR
+
+// FREE FUNCTIONS
+
+inline VectorRegister<float, 512> vector_zero_below_element(VectorRegister<float, 512> const &a,
+                                                            int const &                       n)
+{
+  __m512i   index = _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+  __mmask16 mask  = _mm512_cmpge_epi32_mask(index, _mm512_set1_epi32(n));
+  return VectorRegister<float, 512>(_mm512_maskz_mov_ps(mask, a.data()));
+}
+
+inline VectorRegister<float, 512> vector_zero_above_element(VectorRegister<float, 512> const &a,
+                                                            int const &                       n)
+{
+  __m512i   index = _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+  __mmask16 mask  = _mm512_cmple_epi32_mask(index, _mm512_set1_epi32(n));
+  return VectorRegister<float, 512>(_mm512_maskz_mov_ps(mask, a.data()));
+}
+
+inline VectorRegister<float, 512> shift_elements_left(VectorRegister<float, 512> const &x)
+{
+  __m512i n = _mm512_alignr_epi32(_mm512_castps_si512(x.data()), _mm512_setzero_si512(), 15);
+  return VectorRegister<float, 512>(_mm512_castsi512_ps(n));
+}
+
+inline VectorRegister<float, 512> shift_elements_right(VectorRegister<float, 512> const &x)
+{
+  __m512i n = _mm512_alignr_epi32(_mm512_setzero_si512(), _mm512_castps_si512(x.data()), 1);
+  return VectorRegister<float, 512>(_mm512_castsi512_ps(n));
+}
+
+inline float first_element(VectorRegister<float, 512> const &x)
+{
+  return _mm_cvtss_f32(_mm512_castps512_ps128(x.data()));
+}
+
+inline float reduce(VectorRegister<float, 512> const &x)
+{
+  return _mm512_reduce_add_ps(x.data());
+}
+
+inline bool all_less_than(VectorRegister<float, 512> const &x, VectorRegister<float, 512> const &y)
+{
+  return _mm512_cmp_ps_mask(x.data(), y.data(), _CMP_LT_OS) == 0xFFFF;
+}
+
+inline bool any_less_than(VectorRegister<float, 512> const &x, VectorRegister<float, 512> const &y)
+{
+  return _mm512_cmp_ps_mask(x.data(), y.data(), _CMP_LT_OS) != 0;
+}
+
+}  // namespace vectorize
+}  // namespace fetch
+#endif
@@ -0,0 +1,192 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#if defined(__AVX512F__) && defined(__AVX512DQ__)
+#include "vectorise/arch/avx512/info.hpp"
+#include "vectorise/info.hpp"
+#include "vectorise/register.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <immintrin.h>
+
+namespace fetch {
+namespace vectorize {
+
+// AVX-512 integers
+template <>
+class VectorRegister<int32_t, 512>
+{
+public:
+  using type             = int32_t;
+  using mm_register_type = __m512i;
+
+  enum
+  {
+    E_VECTOR_SIZE   = 512,
+    E_REGISTER_SIZE = sizeof(mm_register_type),
+    E_BLOCK_COUNT   = E_REGISTER_SIZE / sizeof(type)
+  };
+
+  static_assert((E_BLOCK_COUNT * sizeof(type)) == E_REGISTER_SIZE,
+                "type cannot be contained in the given register size.");
+
+  VectorRegister() = default;
+  VectorRegister(type const *d)
+  {
+    data_ = _mm512_load_si512(d);
+  }
+  VectorRegister(type const &c)
+  {
+    data_ = _mm512_set1_epi32(c);
+  }
+  VectorRegister(mm_register_type const &d)
+    : data_(d)
+  {}
+  VectorRegister(mm_register_type &&d)
+    : data_(d)
+  {}
+
+  explicit operator mm_register_type()
+  {
+    return data_;
+  }
+
+  void Store(type *ptr) const
+  {
+    _mm512_store_si512(ptr, data_);
+  }
+
+  void Stream(type *ptr) const
+  {
+    _mm512_stream_si512(reinterpret_cast<mm_register_type *>(ptr), data_);
+  }
+
+  mm_register_type const &data() const
+  {
+    return data_;
+  }
+  mm_register_type &data()
+  {
+    return data_;
+  }
+
+private:
+  mm_register_type data_;
+};
+
+inline VectorRegister<int32_t, 512> operator-(VectorRegister<int32_t, 512> const &x)
+{
+  return VectorRegister<int32_t, 512>(_mm512_sub_epi32(_mm512_setzero_si512(), x.data()));
+}
+
+inline VectorRegister<int32_t, 512> operator+(VectorRegister<int32_t, 512> const &a,
+                                              VectorRegister<int32_t, 512> const &b)
+{
+  __m512i ret = _mm512_add_epi32(a.data(), b.data());
+  return VectorRegister<int32_t, 512>(ret);
+}
+
+inline VectorRegister<int32_t, 512> operator-(VectorRegister<int32_t, 512> const &a,
+                                              VectorRegister<int32_t, 512> const &b)
+{
+  __m512i ret = _mm512_sub_epi32(a.data(), b.data());
+  return VectorRegister<int32_t, 512>(ret);
+}
+
+inline VectorRegister<int32_t, 512> operator*(VectorRegister<int32_t, 512> const &a,
+                                              VectorRegister<int32_t, 512> const &b)
+{
+  __m512i ret = _mm512_mullo_epi32(a.data(), b.data());
+  return VectorRegister<int32_t, 512>(ret);
+}
+
+inline VectorRegister<int32_t, 512> operator/(VectorRegister<int32_t, 512> const &a,
+                                              VectorRegister<int32_t, 512> const &b)
+{
+  // There is no integer division instruction, so divide lane by lane
+  alignas(64) int32_t d1[16];
+  alignas(64) int32_t d2[16];
+  alignas(64) int32_t ret[16];
+  a.Store(d1);
+  b.Store(d2);
+
+  // don't divide by zero
+  for (std::size_t i = 0; i < 16; ++i)
+  {
+    ret[i] = d2[i] != 0 ? d1[i] / d2[i] : 0;
+  }
+
+  return VectorRegister<int32_t, 512>(ret);
+}
+
+// Comparisons yield all bits set in the lanes where they hold, as for SSE and AVX2
+inline VectorRegister<int32_t, 512> operator==(VectorRegister<int32_t, 512> const &a,
+                                               VectorRegister<int32_t, 512> const &b)
+{
+  __mmask16 mask = _mm512_cmpeq_epi32_mask(a.data(), b.data());
+  return VectorRegister<int32_t, 512>(_mm512_movm_epi32(mask));
+}
+
+inline VectorRegister<int32_t, 512> operator<(VectorRegister<int32_t, 512> const &a,
+                                              VectorRegister<int32_t, 512> const &b)
+{
+  __mmask16 mask = _mm512_cmplt_epi32_mask(a.data(), b.data());
+  return VectorRegister<int32_t, 512>(_mm512_movm_epi32(mask));
+}
+
+inline VectorRegister<int32_t, 512> vector_zero_below_element(
+    VectorRegister<int32_t, 512> const &a, int const &n)
+{
+  __m512i   index = _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+  __mmask16 mask  = _mm512_cmpge_epi32_mask(index, _mm512_set1_epi32(n));
+  return VectorRegister<int32_t, 512>(_mm512_maskz_mov_epi32(mask, a.data()));
+}
+
+inline VectorRegister<int32_t, 512> vector_zero_above_element(
+    VectorRegister<int32_t, 512> const &a, int const &n)
+{
+  __m512i   index = _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+  __mmask16 mask  = _mm512_cmple_epi32_mask(index, _mm512_set1_epi32(n));
+  return VectorRegister<int32_t, 512>(_mm512_maskz_mov_epi32(mask, a.data()));
+}
+
+inline int32_t first_element(VectorRegister<int32_t, 512> const &x)
+{
+  return _mm_cvtsi128_si32(_mm512_castsi512_si128(x.data()));
+}
+
+inline int32_t reduce(VectorRegister<int32_t, 512> const &x)
+{
+  return _mm512_reduce_add_epi32(x.data());
+}
+
+inline VectorRegister<int32_t, 512> shift_elements_left(VectorRegister<int32_t, 512> const &x)
+{
+  return VectorRegister<int32_t, 512>(_mm512_alignr_epi32(x.data(), _mm512_setzero_si512(), 15));
+}
+
+inline VectorRegister<int32_t, 512> shift_elements_right(VectorRegister<int32_t, 512> const &x)
+{
+  return VectorRegister<int32_t, 512>(_mm512_alignr_epi32(_mm512_setzero_si512(), x.data(), 1));
+}
+
+}  // namespace vectorize
+}  // namespace fetch
+#endif
@@ -168,6 +168,13 @@ inline int32_t first_element(VectorRegister<int32_t, 128> const &x)
   return static_cast<int32_t>(_mm_extract_epi32(x.data(), 0));
 }
 
+inline int32_t reduce(VectorRegister<int32_t, 128> const &x)
+{
+  __m128i r = _mm_hadd_epi32(x.data(), x.data());
+  r         = _mm_hadd_epi32(r, r);
+  return _mm_cvtsi128_si32(r);
+}
+
 inline VectorRegister<int32_t, 128> shift_elements_left(VectorRegister<int32_t, 128> const &x)
 {
   __m128i n = _mm_bslli_si128(x.data(), 4);
@@ -17,6 +17,18 @@
 //
 //------------------------------------------------------------------------------
 
+#include "vectorise/arch/avx/math/abs.hpp"
+#include "vectorise/arch/avx/math/approx_exp.hpp"
+#include "vectorise/arch/avx/math/approx_log.hpp"
+#include "vectorise/arch/avx/math/max.hpp"
+#include "vectorise/arch/avx/math/min.hpp"
+#include "vectorise/arch/avx/math/sqrt.hpp"
+#include "vectorise/arch/avx512/math/abs.hpp"
+#include "vectorise/arch/avx512/math/approx_exp.hpp"
+#include "vectorise/arch/avx512/math/approx_log.hpp"
+#include "vectorise/arch/avx512/math/max.hpp"
+#include "vectorise/arch/avx512/math/min.hpp"
+#include "vectorise/arch/avx512/math/sqrt.hpp"
 #include "vectorise/arch/sse/math/abs.hpp"
 #include "vectorise/arch/sse/math/approx_exp.hpp"
 #include "vectorise/arch/sse/math/approx_log.hpp"
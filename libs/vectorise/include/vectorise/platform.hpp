@@ -181,7 +181,9 @@ struct VectorRegisterSize
 {
   enum
   {
-#ifdef __AVX__
+#if defined(__AVX512F__) && defined(__AVX512DQ__)
+    value = 512
+#elif defined __AVX2__
     value = 256
 #elif defined __SSE__
     value = 128
@@ -201,15 +203,24 @@ struct VectorRegisterSize
     };                                \
   }
 
-#ifdef __AVX2__
+#if defined(__AVX512F__) && defined(__AVX512DQ__)
+
+ADD_REGISTER_SIZE(int, 512);
+ADD_REGISTER_SIZE(double, 512);
+ADD_REGISTER_SIZE(float, 512);
+
+#elif defined __AVX2__
 
 ADD_REGISTER_SIZE(int, 256);
+ADD_REGISTER_SIZE(double, 256);
+ADD_REGISTER_SIZE(float, 256);
 
 #elif defined __AVX__
 
+// The 256 bit registers rely on AVX2 for their integer and permute operations
 ADD_REGISTER_SIZE(int, 128);
-ADD_REGISTER_SIZE(double, 256);
-ADD_REGISTER_SIZE(float, 256);
+ADD_REGISTER_SIZE(double, 128);
+ADD_REGISTER_SIZE(float, 128);
 
 #elif defined __SSE42__
 
@@ -248,6 +259,15 @@ constexpr bool has_avx2()
 #endif
 }
 
+constexpr bool has_avx512()
+{
+#if defined(__AVX512F__) && defined(__AVX512DQ__)
+  return true;
+#else
+  return false;
+#endif
+}
+
 constexpr bool has_sse()
 {
 #ifdef __SSE__
@@ -17,8 +17,9 @@
 //
 //------------------------------------------------------------------------------
 
+#include "vectorise/arch/avx.hpp"
+#include "vectorise/arch/avx512.hpp"
 #include "vectorise/arch/sse.hpp"
-#include "vectorise/avx.hpp"
 #include "vectorise/info.hpp"
 #include "vectorise/iterator.hpp"
 #include "vectorise/math.hpp"
@@ -0,0 +1,267 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "vectorise/memory/shared_array.hpp"
+#include "vectorise/vectorise.hpp"
+
+#include "gtest/gtest.h"
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+using namespace fetch::vectorize;
+
+namespace {
+
+template <typename R>
+class VectoriseWideRegisterTest : public ::testing::Test
+{
+public:
+  using RegisterType = R;
+  using type         = typename R::type;
+
+  enum
+  {
+    N = R::E_BLOCK_COUNT
+  };
+
+  void SetUp() override
+  {
+    for (std::size_t i = 0; i < N; ++i)
+    {
+      a_[i] = type(i + 1);
+      b_[i] = type(2 * i + 3);
+    }
+  }
+
+  // Shared arrays are 64 byte aligned, which suits the aligned loads of every register width
+  fetch::memory::SharedArray<type> a_{N};
+  fetch::memory::SharedArray<type> b_{N};
+  fetch::memory::SharedArray<type> c_{N};
+};
+
+using WideRegisterTypes = ::testing::Types<
+#if defined(__AVX512F__) && defined(__AVX512DQ__)
+    VectorRegister<int32_t, 512>, VectorRegister<float, 512>, VectorRegister<double, 512>,
+#endif
+#ifdef __AVX2__
+    VectorRegister<int32_t, 256>, VectorRegister<float, 256>, VectorRegister<double, 256>,
+#endif
+    VectorRegister<int32_t, 128>, VectorRegister<float, 128>, VectorRegister<double, 128>>;
+
+TYPED_TEST_CASE(VectoriseWideRegisterTest, WideRegisterTypes);
+
+TYPED_TEST(VectoriseWideRegisterTest, arithmetic)
+{
+  using RegisterType = typename TestFixture::RegisterType;
+  using type         = typename TestFixture::type;
+
+  RegisterType a(this->a_.pointer()), b(this->b_.pointer()), three(type(3));
+  RegisterType c = three * a * b - a + b;
+  c.Store(this->c_.pointer());
+
+  for (std::size_t i = 0; i < TestFixture::N; ++i)
+  {
+    EXPECT_EQ(this->c_[i], type(3) * this->a_[i] * this->b_[i] - this->a_[i] + this->b_[i]);
+  }
+}
+
+TYPED_TEST(VectoriseWideRegisterTest, reduce_and_first_element)
+{
+  using RegisterType = typename TestFixture::RegisterType;
+  using type         = typename TestFixture::type;
+
+  RegisterType a(this->a_.pointer());
+  type         sum = 0;
+  for (std::size_t i = 0; i < TestFixture::N; ++i)
+  {
+    sum += this->a_[i];
+  }
+
+  EXPECT_EQ(first_element(a), this->a_[0]);
+  EXPECT_EQ(first_element(shift_elements_right(a)), this->a_[1]);
+  EXPECT_EQ(first_element(shift_elements_left(a)), type(0));
+
+  // Draining a register from the front visits every lane in order
+  for (std::size_t i = 0; i < TestFixture::N; ++i)
+  {
+    EXPECT_EQ(first_element(a), this->a_[i]);
+    a = shift_elements_right(a);
+  }
+  EXPECT_EQ(first_element(a), type(0));
+
+  EXPECT_EQ(reduce(RegisterType(this->a_.pointer())), sum);
+}
+
+TYPED_TEST(VectoriseWideRegisterTest, shift_elements)
+{
+  using RegisterType = typename TestFixture::RegisterType;
+  using type         = typename TestFixture::type;
+  std::size_t const N = TestFixture::N;
+
+  shift_elements_left(RegisterType(this->a_.pointer())).Store(this->c_.pointer());
+  EXPECT_EQ(this->c_[0], type(0));
+  for (std::size_t i = 1; i < N; ++i)
+  {
+    EXPECT_EQ(this->c_[i], this->a_[i - 1]);
+  }
+
+  shift_elements_right(RegisterType(this->a_.pointer())).Store(this->c_.pointer());
+  EXPECT_EQ(this->c_[N - 1], type(0));
+  for (std::size_t i = 0; i + 1 < N; ++i)
+  {
+    EXPECT_EQ(this->c_[i], this->a_[i + 1]);
+  }
+}
+
+// The 128 bit integer register has no masking helpers, so these only cover the floating point
+// registers and the wide integer ones
+template <typename R>
+class VectoriseWideMaskTest : public VectoriseWideRegisterTest<R>
+{
+};
+
+using WideMaskTypes = ::testing::Types<
+#if defined(__AVX512F__) && defined(__AVX512DQ__)
+    VectorRegister<int32_t, 512>, VectorRegister<float, 512>, VectorRegister<double, 512>,
+#endif
+#ifdef __AVX2__
+    VectorRegister<int32_t, 256>, VectorRegister<float, 256>, VectorRegister<double, 256>,
+#endif
+    VectorRegister<float, 128>, VectorRegister<double, 128>>;
+
+TYPED_TEST_CASE(VectoriseWideMaskTest, WideMaskTypes);
+
+TYPED_TEST(VectoriseWideMaskTest, zero_below_and_above_element)
+{
+  using RegisterType = typename TestFixture::RegisterType;
+  using type         = typename TestFixture::type;
+  int const N        = int(TestFixture::N);
+
+  for (int n = 0; n < N; ++n)
+  {
+    vector_zero_below_element(RegisterType(this->a_.pointer()), n).Store(this->c_.pointer());
+    for (int i = 0; i < N; ++i)
+    {
+      EXPECT_EQ(this->c_[i], (i >= n) ? this->a_[i] : type(0));
+    }
+
+    vector_zero_above_element(RegisterType(this->a_.pointer()), n).Store(this->c_.pointer());
+    for (int i = 0; i < N; ++i)
+    {
+      EXPECT_EQ(this->c_[i], (i <= n) ? this->a_[i] : type(0));
+    }
+  }
+}
+
+template <typename R>
+class VectoriseWideMathTest : public VectoriseWideRegisterTest<R>
+{
+};
+
+using WideMathTypes = ::testing::Types<
+#if defined(__AVX512F__) && defined(__AVX512DQ__)
+    VectorRegister<float, 512>, VectorRegister<double, 512>,
+#endif
+#ifdef __AVX2__
+    VectorRegister<float, 256>, VectorRegister<double, 256>,
+#endif
+    VectorRegister<float, 128>, VectorRegister<double, 128>>;
+
+TYPED_TEST_CASE(VectoriseWideMathTest, WideMathTypes);
+
+TYPED_TEST(VectoriseWideMathTest, comparisons_and_elementwise_math)
+{
+  using RegisterType = typename TestFixture::RegisterType;
+  using type         = typename TestFixture::type;
+
+  RegisterType a(this->a_.pointer()), b(this->b_.pointer()), four(type(4));
+
+  (a < four).Store(this->c_.pointer());
+  for (std::size_t i = 0; i < TestFixture::N; ++i)
+  {
+    EXPECT_EQ(this->c_[i], (this->a_[i] < type(4)) ? type(1) : type(0));
+  }
+
+  max(a, four).Store(this->c_.pointer());
+  for (std::size_t i = 0; i < TestFixture::N; ++i)
+  {
+    EXPECT_EQ(this->c_[i], std::max(this->a_[i], type(4)));
+  }
+
+  min(a, four).Store(this->c_.pointer());
+  for (std::size_t i = 0; i < TestFixture::N; ++i)
+  {
+    EXPECT_EQ(this->c_[i], std::min(this->a_[i], type(4)));
+  }
+
+  abs(a - b).Store(this->c_.pointer());
+  for (std::size_t i = 0; i < TestFixture::N; ++i)
+  {
+    EXPECT_EQ(this->c_[i], std::abs(this->a_[i] - this->b_[i]));
+  }
+
+  sqrt(a * a).Store(this->c_.pointer());
+  for (std::size_t i = 0; i < TestFixture::N; ++i)
+  {
+    EXPECT_EQ(this->c_[i], this->a_[i]);
+  }
+
+  EXPECT_TRUE(all_less_than(a, b));
+  EXPECT_FALSE(any_less_than(b, a));
+}
+
+// The approximations are accurate to a few percent; every width must agree bit for bit with SSE
+TYPED_TEST(VectoriseWideMathTest, approx_exp_and_log)
+{
+  using RegisterType = typename TestFixture::RegisterType;
+  using type         = typename TestFixture::type;
+  using SSERegister  = VectorRegister<type, 128>;
+
+  for (std::size_t i = 0; i < TestFixture::N; ++i)
+  {
+    this->a_[i] = type(0.25) * type(i) - type(1);
+  }
+
+  alignas(16) type reference[SSERegister::E_BLOCK_COUNT];
+
+  approx_exp(RegisterType(this->a_.pointer())).Store(this->c_.pointer());
+  for (std::size_t i = 0; i < TestFixture::N; i += SSERegister::E_BLOCK_COUNT)
+  {
+    approx_exp(SSERegister(this->a_.pointer() + i)).Store(reference);
+    for (std::size_t j = 0; j < SSERegister::E_BLOCK_COUNT; ++j)
+    {
+      EXPECT_EQ(this->c_[i + j], reference[j]);
+      EXPECT_NEAR(this->c_[i + j], std::exp(this->a_[i + j]), 0.1 * std::exp(this->a_[i + j]));
+    }
+  }
+
+  approx_log(RegisterType(this->b_.pointer())).Store(this->c_.pointer());
+  for (std::size_t i = 0; i < TestFixture::N; i += SSERegister::E_BLOCK_COUNT)
+  {
+    approx_log(SSERegister(this->b_.pointer() + i)).Store(reference);
+    for (std::size_t j = 0; j < SSERegister::E_BLOCK_COUNT; ++j)
+    {
+      EXPECT_EQ(this->c_[i + j], reference[j]);
+      EXPECT_NEAR(this->c_[i + j], std::log(this->b_[i + j]), 0.1);
+    }
+  }
+}
+
+}  // namespace
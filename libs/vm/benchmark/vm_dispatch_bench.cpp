@@ -0,0 +1,160 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "vm/compiler.hpp"
+#include "vm/ir.hpp"
+#include "vm/module.hpp"
+#include "vm/variant.hpp"
+#include "vm/vm.hpp"
+
+#include "benchmark/benchmark.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace {
+
+using fetch::vm::ChargeAmount;
+using fetch::vm::Compiler;
+using fetch::vm::Executable;
+using fetch::vm::IR;
+using fetch::vm::Module;
+using fetch::vm::VM;
+using fetch::vm::Variant;
+
+using ExecutionMode = VM::ExecutionMode;
+
+char const *ARITHMETIC_LOOP = R"(
+  function main() : Int64
+    var total = 0i64;
+    var i = 0i64;
+    while (i < 100000i64)
+      var a = i * 3i64;
+      total = total + a;
+      total = total - i;
+      i = i + 1i64;
+    endwhile
+    return total;
+  endfunction
+)";
+
+char const *NESTED_LOOP = R"(
+  function main() : Int64
+    var total = 0i64;
+    for (i in 0:300)
+      for (j in 0:300)
+        if (i % 3 == 0)
+          continue;
+        endif
+        total += 1i64;
+      endfor
+    endfor
+    return total;
+  endfunction
+)";
+
+char const *RECURSIVE_CALLS = R"(
+  function fib(n : Int64) : Int64
+    if (n < 2i64)
+      return n;
+    endif
+    return fib(n - 1i64) + fib(n - 2i64);
+  endfunction
+
+  function main() : Int64
+    return fib(20i64);
+  endfunction
+)";
+
+void RunProgram(benchmark::State &state, char const *source, ExecutionMode mode)
+{
+  Module                   module;
+  Compiler                 compiler{&module};
+  IR                       ir;
+  Executable               executable;
+  VM                       vm{&module};
+  std::vector<std::string> errors;
+
+  if (!compiler.Compile(source, "default", ir, errors) ||
+      !vm.GenerateExecutable(ir, "default_ir", executable, errors))
+  {
+    state.SkipWithError("Unable to compile benchmark program");
+    return;
+  }
+
+  vm.SetExecutionMode(mode);
+
+  std::string        error;
+  Variant            output;
+  ChargeAmount const initial_charge = vm.GetChargeTotal();
+  for (auto _ : state)
+  {
+    if (!vm.Execute(executable, "main", error, output))
+    {
+      state.SkipWithError(error.c_str());
+      break;
+    }
+  }
+
+  // the charge total accumulates across executions, report the charge of a single run
+  if (state.iterations() > 0)
+  {
+    state.counters["charge"] = static_cast<double>(vm.GetChargeTotal() - initial_charge) /
+                               static_cast<double>(state.iterations());
+  }
+}
+
+void ArithmeticLoop_Interpreted(benchmark::State &state)
+{
+  RunProgram(state, ARITHMETIC_LOOP, ExecutionMode::INTERPRETED);
+}
+
+void ArithmeticLoop_Threaded(benchmark::State &state)
+{
+  RunProgram(state, ARITHMETIC_LOOP, ExecutionMode::THREADED);
+}
+
+void NestedLoop_Interpreted(benchmark::State &state)
+{
+  RunProgram(state, NESTED_LOOP, ExecutionMode::INTERPRETED);
+}
+
+void NestedLoop_Threaded(benchmark::State &state)
+{
+  RunProgram(state, NESTED_LOOP, ExecutionMode::THREADED);
+}
+
+void RecursiveCalls_Interpreted(benchmark::State &state)
+{
+  RunProgram(state, RECURSIVE_CALLS, ExecutionMode::INTERPRETED);
+}
+
+void RecursiveCalls_Threaded(benchmark::State &state)
+{
+  RunProgram(state, RECURSIVE_CALLS, ExecutionMode::THREADED);
+}
+
+}  // namespace
+
+BENCHMARK(ArithmeticLoop_Interpreted)->Unit(benchmark::kMicrosecond);
+BENCHMARK(ArithmeticLoop_Threaded)->Unit(benchmark::kMicrosecond);
+BENCHMARK(NestedLoop_Interpreted)->Unit(benchmark::kMicrosecond);
+BENCHMARK(NestedLoop_Threaded)->Unit(benchmark::kMicrosecond);
+BENCHMARK(RecursiveCalls_Interpreted)->Unit(benchmark::kMicrosecond);
+BENCHMARK(RecursiveCalls_Threaded)->Unit(benchmark::kMicrosecond);
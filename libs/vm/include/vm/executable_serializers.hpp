@@ -0,0 +1,408 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/serializers/main_serializer.hpp"
+#include "vm/common.hpp"
+#include "vm/generator.hpp"
+#include "vm/variant.hpp"
+
+#include <cstdint>
+#include <stdexcept>
+
+namespace fetch {
+namespace serializers {
+
+template <typename D>
+struct MapSerializer<vm::TypeInfo, D>
+{
+public:
+  using Type       = vm::TypeInfo;
+  using DriverType = D;
+
+  static uint8_t const TYPE_KIND          = 1;
+  static uint8_t const NAME               = 2;
+  static uint8_t const TEMPLATE_TYPE_ID   = 3;
+  static uint8_t const PARAMETER_TYPE_IDS = 4;
+
+  template <typename Constructor>
+  static void Serialize(Constructor &map_constructor, Type const &type_info)
+  {
+    auto map = map_constructor(4);
+    map.Append(TYPE_KIND, static_cast<uint8_t>(type_info.type_kind));
+    map.Append(NAME, type_info.name);
+    map.Append(TEMPLATE_TYPE_ID, type_info.template_type_id);
+    map.Append(PARAMETER_TYPE_IDS, type_info.parameter_type_ids);
+  }
+
+  template <typename MapDeserializer>
+  static void Deserialize(MapDeserializer &map, Type &type_info)
+  {
+    uint8_t type_kind{0};
+    map.ExpectKeyGetValue(TYPE_KIND, type_kind);
+    map.ExpectKeyGetValue(NAME, type_info.name);
+    map.ExpectKeyGetValue(TEMPLATE_TYPE_ID, type_info.template_type_id);
+    map.ExpectKeyGetValue(PARAMETER_TYPE_IDS, type_info.parameter_type_ids);
+
+    type_info.type_kind = static_cast<vm::TypeKind>(type_kind);
+  }
+};
+
+/**
+ * Serializer for the constants of an executable. Only primitive values can appear in the constant
+ * table, object variants are rejected.
+ */
+template <typename D>
+struct MapSerializer<vm::Variant, D>
+{
+public:
+  using Type       = vm::Variant;
+  using DriverType = D;
+
+  static uint8_t const TYPE_ID = 1;
+  static uint8_t const VALUE   = 2;
+
+  template <typename Constructor>
+  static void Serialize(Constructor &map_constructor, Type const &variant)
+  {
+    if (!variant.IsPrimitive())
+    {
+      throw std::runtime_error("Unable to serialize non-primitive executable constant");
+    }
+
+    auto map = map_constructor(2);
+    map.Append(TYPE_ID, variant.type_id);
+    map.Append(VALUE, variant.primitive.ui64);
+  }
+
+  template <typename MapDeserializer>
+  static void Deserialize(MapDeserializer &map, Type &variant)
+  {
+    vm::TypeId    type_id{vm::TypeIds::Unknown};
+    vm::Primitive primitive{};
+
+    map.ExpectKeyGetValue(TYPE_ID, type_id);
+    map.ExpectKeyGetValue(VALUE, primitive.ui64);
+
+    variant = vm::Variant{primitive, type_id};
+
+    if (!variant.IsPrimitive())
+    {
+      throw std::runtime_error("Unable to deserialize non-primitive executable constant");
+    }
+  }
+};
+
+template <typename D>
+struct MapSerializer<vm::AnnotationLiteral, D>
+{
+public:
+  using Type       = vm::AnnotationLiteral;
+  using DriverType = D;
+
+  static uint8_t const TYPE  = 1;
+  static uint8_t const VALUE = 2;
+
+  template <typename Constructor>
+  static void Serialize(Constructor &map_constructor, Type const &literal)
+  {
+    auto map = map_constructor(2);
+    map.Append(TYPE, static_cast<uint8_t>(literal.type));
+
+    switch (literal.type)
+    {
+    case vm::AnnotationLiteralType::Boolean:
+      map.Append(VALUE, literal.boolean);
+      break;
+    case vm::AnnotationLiteralType::Integer:
+      map.Append(VALUE, literal.integer);
+      break;
+    case vm::AnnotationLiteralType::Real:
+      map.Append(VALUE, literal.real);
+      break;
+    case vm::AnnotationLiteralType::Unknown:
+    case vm::AnnotationLiteralType::String:
+    case vm::AnnotationLiteralType::Identifier:
+      map.Append(VALUE, literal.str);
+      break;
+    }
+  }
+
+  template <typename MapDeserializer>
+  static void Deserialize(MapDeserializer &map, Type &literal)
+  {
+    uint8_t type{0};
+    map.ExpectKeyGetValue(TYPE, type);
+
+    switch (static_cast<vm::AnnotationLiteralType>(type))
+    {
+    case vm::AnnotationLiteralType::Boolean:
+    {
+      bool value{false};
+      map.ExpectKeyGetValue(VALUE, value);
+      literal.SetBoolean(value);
+      break;
+    }
+    case vm::AnnotationLiteralType::Integer:
+    {
+      int64_t value{0};
+      map.ExpectKeyGetValue(VALUE, value);
+      literal.SetInteger(value);
+      break;
+    }
+    case vm::AnnotationLiteralType::Real:
+    {
+      double value{0};
+      map.ExpectKeyGetValue(VALUE, value);
+      literal.SetReal(value);
+      break;
+    }
+    case vm::AnnotationLiteralType::String:
+    {
+      std::string value;
+      map.ExpectKeyGetValue(VALUE, value);
+      literal.SetString(value);
+      break;
+    }
+    case vm::AnnotationLiteralType::Identifier:
+    {
+      std::string value;
+      map.ExpectKeyGetValue(VALUE, value);
+      literal.SetIdentifier(value);
+      break;
+    }
+    case vm::AnnotationLiteralType::Unknown:
+      map.ExpectKeyGetValue(VALUE, literal.str);
+      literal.type = vm::AnnotationLiteralType::Unknown;
+      break;
+    default:
+      throw std::runtime_error("Invalid annotation literal type");
+    }
+  }
+};
+
+template <typename D>
+struct MapSerializer<vm::AnnotationElement, D>
+{
+public:
+  using Type       = vm::AnnotationElement;
+  using DriverType = D;
+
+  static uint8_t const TYPE  = 1;
+  static uint8_t const NAME  = 2;
+  static uint8_t const VALUE = 3;
+
+  template <typename Constructor>
+  static void Serialize(Constructor &map_constructor, Type const &element)
+  {
+    auto map = map_constructor(3);
+    map.Append(TYPE, static_cast<uint8_t>(element.type));
+    map.Append(NAME, element.name);
+    map.Append(VALUE, element.value);
+  }
+
+  template <typename MapDeserializer>
+  static void Deserialize(MapDeserializer &map, Type &element)
+  {
+    uint8_t type{0};
+    map.ExpectKeyGetValue(TYPE, type);
+    map.ExpectKeyGetValue(NAME, element.name);
+    map.ExpectKeyGetValue(VALUE, element.value);
+
+    element.type = static_cast<vm::AnnotationElementType>(type);
+  }
+};
+
+template <typename D>
+struct MapSerializer<vm::Annotation, D>
+{
+public:
+  using Type       = vm::Annotation;
+  using DriverType = D;
+
+  static uint8_t const NAME     = 1;
+  static uint8_t const ELEMENTS = 2;
+
+  template <typename Constructor>
+  static void Serialize(Constructor &map_constructor, Type const &annotation)
+  {
+    auto map = map_constructor(2);
+    map.Append(NAME, annotation.name);
+    map.Append(ELEMENTS, annotation.elements);
+  }
+
+  template <typename MapDeserializer>
+  static void Deserialize(MapDeserializer &map, Type &annotation)
+  {
+    map.ExpectKeyGetValue(NAME, annotation.name);
+    map.ExpectKeyGetValue(ELEMENTS, annotation.elements);
+  }
+};
+
+template <typename D>
+struct ArraySerializer<vm::Executable::Instruction, D>
+{
+public:
+  using Type       = vm::Executable::Instruction;
+  using DriverType = D;
+
+  template <typename Constructor>
+  static void Serialize(Constructor &array_constructor, Type const &instruction)
+  {
+    auto array = array_constructor(4);
+    array.Append(instruction.opcode);
+    array.Append(instruction.type_id);
+    array.Append(instruction.index);
+    array.Append(instruction.data);
+  }
+
+  template <typename ArrayDeserializer>
+  static void Deserialize(ArrayDeserializer &array, Type &instruction)
+  {
+    if (array.size() != 4)
+    {
+      throw SerializableException(std::string("Invalid executable instruction"));
+    }
+
+    array.GetNextValue(instruction.opcode);
+    array.GetNextValue(instruction.type_id);
+    array.GetNextValue(instruction.index);
+    array.GetNextValue(instruction.data);
+  }
+};
+
+template <typename D>
+struct MapSerializer<vm::Executable::Variable, D>
+{
+public:
+  using Type       = vm::Executable::Variable;
+  using DriverType = D;
+
+  static uint8_t const NAME         = 1;
+  static uint8_t const TYPE_ID      = 2;
+  static uint8_t const SCOPE_NUMBER = 3;
+
+  template <typename Constructor>
+  static void Serialize(Constructor &map_constructor, Type const &variable)
+  {
+    auto map = map_constructor(3);
+    map.Append(NAME, variable.name);
+    map.Append(TYPE_ID, variable.type_id);
+    map.Append(SCOPE_NUMBER, variable.scope_number);
+  }
+
+  template <typename MapDeserializer>
+  static void Deserialize(MapDeserializer &map, Type &variable)
+  {
+    map.ExpectKeyGetValue(NAME, variable.name);
+    map.ExpectKeyGetValue(TYPE_ID, variable.type_id);
+    map.ExpectKeyGetValue(SCOPE_NUMBER, variable.scope_number);
+  }
+};
+
+template <typename D>
+struct MapSerializer<vm::Executable::Function, D>
+{
+public:
+  using Type       = vm::Executable::Function;
+  using DriverType = D;
+
+  static uint8_t const NAME           = 1;
+  static uint8_t const ANNOTATIONS    = 2;
+  static uint8_t const NUM_VARIABLES  = 3;
+  static uint8_t const NUM_PARAMETERS = 4;
+  static uint8_t const RETURN_TYPE_ID = 5;
+  static uint8_t const VARIABLES      = 6;
+  static uint8_t const INSTRUCTIONS   = 7;
+  static uint8_t const LINE_NUMBERS   = 8;
+
+  template <typename Constructor>
+  static void Serialize(Constructor &map_constructor, Type const &function)
+  {
+    auto map = map_constructor(8);
+    map.Append(NAME, function.name);
+    map.Append(ANNOTATIONS, function.annotations);
+    map.Append(NUM_VARIABLES, static_cast<int32_t>(function.num_variables));
+    map.Append(NUM_PARAMETERS, static_cast<int32_t>(function.num_parameters));
+    map.Append(RETURN_TYPE_ID, function.return_type_id);
+    map.Append(VARIABLES, function.variables);
+    map.Append(INSTRUCTIONS, function.instructions);
+    map.Append(LINE_NUMBERS, function.pc_to_line_map_);
+  }
+
+  template <typename MapDeserializer>
+  static void Deserialize(MapDeserializer &map, Type &function)
+  {
+    int32_t num_variables{0};
+    int32_t num_parameters{0};
+
+    map.ExpectKeyGetValue(NAME, function.name);
+    map.ExpectKeyGetValue(ANNOTATIONS, function.annotations);
+    map.ExpectKeyGetValue(NUM_VARIABLES, num_variables);
+    map.ExpectKeyGetValue(NUM_PARAMETERS, num_parameters);
+    map.ExpectKeyGetValue(RETURN_TYPE_ID, function.return_type_id);
+    map.ExpectKeyGetValue(VARIABLES, function.variables);
+    map.ExpectKeyGetValue(INSTRUCTIONS, function.instructions);
+    map.ExpectKeyGetValue(LINE_NUMBERS, function.pc_to_line_map_);
+
+    function.num_variables  = num_variables;
+    function.num_parameters = num_parameters;
+  }
+};
+
+template <typename D>
+struct MapSerializer<vm::Executable, D>
+{
+public:
+  using Type       = vm::Executable;
+  using DriverType = D;
+
+  static uint8_t const NAME         = 1;
+  static uint8_t const STRINGS      = 2;
+  static uint8_t const CONSTANTS    = 3;
+  static uint8_t const TYPES        = 4;
+  static uint8_t const FUNCTIONS    = 5;
+  static uint8_t const FUNCTION_MAP = 6;
+
+  template <typename Constructor>
+  static void Serialize(Constructor &map_constructor, Type const &executable)
+  {
+    auto map = map_constructor(6);
+    map.Append(NAME, executable.name);
+    map.Append(STRINGS, executable.strings);
+    map.Append(CONSTANTS, executable.constants);
+    map.Append(TYPES, executable.types);
+    map.Append(FUNCTIONS, executable.functions);
+    map.Append(FUNCTION_MAP, executable.function_map);
+  }
+
+  template <typename MapDeserializer>
+  static void Deserialize(MapDeserializer &map, Type &executable)
+  {
+    map.ExpectKeyGetValue(NAME, executable.name);
+    map.ExpectKeyGetValue(STRINGS, executable.strings);
+    map.ExpectKeyGetValue(CONSTANTS, executable.constants);
+    map.ExpectKeyGetValue(TYPES, executable.types);
+    map.ExpectKeyGetValue(FUNCTIONS, executable.functions);
+    map.ExpectKeyGetValue(FUNCTION_MAP, executable.function_map);
+    executable.generation.Renew();
+  }
+};
+
+}  // namespace serializers
+}  // namespace fetch
@@ -115,13 +115,60 @@ struct Executable
   {}
   ~Executable() = default;
 
+  /**
+   * A process wide unique stamp for one version of one executable. Copied, assigned and
+   * deserialised executables get a new stamp, as does an executable modified through AddFunction
+   * or AddType. Caches keyed on it (e.g. the threaded code of the VM) therefore never match a
+   * different executable, even one allocated at the same address.
+   */
+  class Generation
+  {
+  public:
+    Generation()
+      : value_{Next()}
+    {}
+    Generation(Generation const & /*other*/)
+      : value_{Next()}
+    {}
+    Generation(Generation && /*other*/) noexcept
+      : value_{Next()}
+    {}
+    ~Generation() = default;
+
+    Generation &operator=(Generation const & /*other*/)
+    {
+      Renew();
+      return *this;
+    }
+    Generation &operator=(Generation && /*other*/) noexcept
+    {
+      Renew();
+      return *this;
+    }
+
+    void Renew()
+    {
+      value_ = Next();
+    }
+    uint64_t value() const
+    {
+      return value_;
+    }
+
+  private:
+    static uint64_t Next();
+
+    uint64_t value_;
+  };
+
   struct Instruction
   {
+    Instruction() = default;
     Instruction(uint16_t opcode__)
       : opcode{opcode__}
     {}
 
-    uint16_t opcode;
+    uint16_t opcode  = 0;
     uint16_t type_id = 0;
     uint16_t index   = 0;
     uint16_t data    = 0;
@@ -130,6 +177,7 @@ struct Executable
 
   struct Variable
   {
+    Variable() = default;
     Variable(std::string name__, TypeId type_id__, uint16_t scope_number__)
       : name{std::move(name__)}
       , type_id{type_id__}
@@ -137,8 +185,8 @@ struct Executable
     {}
 
     std::string name;
-    TypeId      type_id;
-    uint16_t    scope_number;
+    TypeId      type_id      = TypeIds::Unknown;
+    uint16_t    scope_number = 0;
   };
   using VariableArray = std::vector<Variable>;
 
@@ -147,6 +195,7 @@ struct Executable
 
   struct Function
   {
+    Function() = default;
     Function(std::string name__, AnnotationArray annotations__, int num_parameters__,
              TypeId return_type_id__)
       : name{std::move(name__)}
@@ -176,8 +225,8 @@ struct Executable
     std::string      name;
     AnnotationArray  annotations;
     int              num_variables = 0;  // parameters + locals
-    int              num_parameters;
-    TypeId           return_type_id;
+    int              num_parameters = 0;
+    TypeId           return_type_id = TypeIds::Unknown;
     VariableArray    variables;  // parameters + locals
     InstructionArray instructions;
     PcToLineMap      pc_to_line_map_;
@@ -190,12 +239,14 @@ struct Executable
   TypeInfoArray            types;
   FunctionArray            functions;
   FunctionMap              function_map;
+  Generation               generation;
 
   uint16_t AddFunction(Function &function)
   {
     auto const index            = static_cast<uint16_t>(functions.size());
     function_map[function.name] = index;
     functions.push_back(std::move(function));
+    generation.Renew();
     return index;
   }
 
@@ -203,6 +254,7 @@ struct Executable
   {
     auto const index = static_cast<uint16_t>(types.size());
     types.push_back(std::move(type_info));
+    generation.Renew();
     return index;
   }
 
@@ -396,6 +396,21 @@ public:
     return ClassInterface<Type>(this, type_index);
   }
 
+  /// @name Registered Details
+  /// Only populated once the module has been used to set up a compiler. Executables generated
+  /// against one module can only be run by modules with identical type and function tables.
+  /// @{
+  TypeInfoArray const &type_info_array() const
+  {
+    return type_info_array_;
+  }
+
+  FunctionInfoArray const &function_info_array() const
+  {
+    return function_info_array_;
+  }
+  /// @}
+
 private:
   template <typename Estimator, typename Callable>
   void InternalCreateFreeFunction(std::string const &name, Callable callable,
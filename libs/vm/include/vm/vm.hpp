@@ -31,6 +31,7 @@
 #include <functional>
 #include <iostream>
 #include <limits>
+#include <memory>
 #include <sstream>
 #include <stdexcept>
 #include <string>
@@ -232,6 +233,16 @@ public:
   using InputDeviceMap  = std::unordered_map<std::string, std::istream *>;
   using OutputDeviceMap = std::unordered_map<std::string, std::ostream *>;
 
+  /**
+   * The strategy used to dispatch the instructions of an executable. Both modes produce identical
+   * results and charge totals.
+   */
+  enum class ExecutionMode
+  {
+    INTERPRETED,  ///< Decode, charge and dispatch each instruction in turn
+    THREADED      ///< Pre-translate functions into threaded code charged per basic block
+  };
+
   explicit VM(Module *module);
   ~VM() = default;
 
@@ -503,6 +514,9 @@ public:
 
   void UpdateCharges(std::unordered_map<std::string, ChargeAmount> const &);
 
+  ExecutionMode GetExecutionMode() const;
+  void          SetExecutionMode(ExecutionMode mode);
+
 private:
   static const int FRAME_STACK_SIZE = 50;
   static const int STACK_SIZE       = 5000;
@@ -534,6 +548,51 @@ private:
     uint16_t scope_number;
   };
 
+  /// @name Threaded Code
+  /// @{
+  struct ThreadedOp;
+  struct ThreadedDispatch;
+
+  using ThreadedHandler = void (*)(VM *, ThreadedOp const &);
+
+  /**
+   * A single entry in the threaded code. Superinstructions cover several consecutive instructions
+   * starting at `pc`.
+   */
+  struct ThreadedOp
+  {
+    ThreadedHandler                handler;
+    Executable::Instruction const *instruction;
+    uint16_t                       pc;
+  };
+
+  /**
+   * A straight line sequence of instructions, only the last of which can transfer control or
+   * incur dynamic charges. The static charge of the whole block is applied on entry.
+   */
+  struct ThreadedBlock
+  {
+    uint32_t     first_op;
+    uint32_t     num_ops;
+    uint16_t     begin_pc;
+    uint16_t     end_pc;
+    ChargeAmount charge;
+  };
+
+  struct ThreadedCode
+  {
+    static constexpr uint32_t INVALID_BLOCK = std::numeric_limits<uint32_t>::max();
+
+    std::vector<ThreadedOp>    ops;
+    std::vector<ThreadedBlock> blocks;
+    std::vector<uint32_t>      block_index;    ///< Map from pc to the block starting at it
+    std::vector<ChargeAmount>  prefix_charge;  ///< Static charge of all instructions before pc
+  };
+
+  using ThreadedCodePtr   = std::unique_ptr<ThreadedCode>;
+  using ThreadedCodeArray = std::vector<ThreadedCodePtr>;
+  /// @}
+
   template <typename T>
   friend struct StackGetter;
   template <typename T>
@@ -576,6 +635,9 @@ private:
   InputDeviceMap                 input_devices_;
   DeserializeConstructorMap      deserialization_constructors_;
   OpcodeInfo *                   current_op_{nullptr};
+  ExecutionMode                  execution_mode_{ExecutionMode::INTERPRETED};
+  ThreadedCodeArray              threaded_code_;
+  uint64_t                       threaded_generation_{0};
 
   /// @name Charges
   /// @{
@@ -590,8 +652,14 @@ private:
   }
 
   bool Execute(std::string &error, Variant &output);
+  void ExecuteInstruction();
+  void ExecuteThreaded();
   void Destruct(uint16_t scope_number);
 
+  ThreadedCode const &GetThreadedCode();
+  void                InvalidateThreadedCode();
+  ThreadedCodePtr     TranslateFunction(Executable::Function const &function) const;
+
   TypeId FindType(std::string const &name) const
   {
     auto it = type_info_map_.find(name);
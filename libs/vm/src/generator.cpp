@@ -19,6 +19,7 @@
 #include "vm/generator.hpp"
 #include "vm/vm.hpp"
 
+#include <atomic>
 #include <cstddef>
 #include <cstdint>
 #include <cstdlib>
@@ -30,6 +31,12 @@
 namespace fetch {
 namespace vm {
 
+uint64_t Executable::Generation::Next()
+{
+  static std::atomic<uint64_t> next{1};
+  return next.fetch_add(1, std::memory_order_relaxed);
+}
+
 Generator::Generator()
 {
   vm_               = nullptr;
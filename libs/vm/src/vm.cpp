@@ -218,37 +218,17 @@ bool VM::Execute(std::string &error, Variant &output)
   error_.clear();
   error.clear();
 
-  do
+  if (execution_mode_ == ExecutionMode::THREADED)
   {
-    instruction_pc_ = pc_;
-    instruction_    = &function_->instructions[pc_++];
-
-    current_op_ = &opcode_info_array_[instruction_->opcode];
-
-    assert(instruction_->opcode < opcode_info_array_.size());
-
-    if (!current_op_->handler)
-    {
-      RuntimeError("unknown opcode");
-      break;
-    }
-
-    assert(static_cast<bool>(current_op_->handler));
-
-    // update the charge total
-    charge_total_ += current_op_->static_charge;
-
-    // check for charge limit being reached
-    if (charge_limit_ && (charge_total_ >= charge_limit_))
+    ExecuteThreaded();
+  }
+  else
+  {
+    do
     {
-      RuntimeError("Charge limit exceeded");
-      break;
-    }
-
-    // execute the handler for the op code
-    current_op_->handler(this);
-
-  } while (!stop_);
+      ExecuteInstruction();
+    } while (!stop_);
+  }
 
   bool const ok = !HasError();
 
@@ -283,6 +263,37 @@ bool VM::Execute(std::string &error, Variant &output)
   return false;
 }
 
+void VM::ExecuteInstruction()
+{
+  instruction_pc_ = pc_;
+  instruction_    = &function_->instructions[pc_++];
+
+  current_op_ = &opcode_info_array_[instruction_->opcode];
+
+  assert(instruction_->opcode < opcode_info_array_.size());
+
+  if (!current_op_->handler)
+  {
+    RuntimeError("unknown opcode");
+    return;
+  }
+
+  assert(static_cast<bool>(current_op_->handler));
+
+  // update the charge total
+  charge_total_ += current_op_->static_charge;
+
+  // check for charge limit being reached
+  if (charge_limit_ && (charge_total_ >= charge_limit_))
+  {
+    RuntimeError("Charge limit exceeded");
+    return;
+  }
+
+  // execute the handler for the op code
+  current_op_->handler(this);
+}
+
 void VM::RuntimeError(std::string const &message)
 {
   uint16_t const    line = function_->FindLineNumber(instruction_pc_);
@@ -343,6 +354,19 @@ void VM::UpdateCharges(std::unordered_map<std::string, ChargeAmount> const &opco
       opcode_to_update->static_charge = entry.second;
     }
   }
+
+  // the block charges of the threaded code are derived from the static charges
+  InvalidateThreadedCode();
+}
+
+VM::ExecutionMode VM::GetExecutionMode() const
+{
+  return execution_mode_;
+}
+
+void VM::SetExecutionMode(ExecutionMode mode)
+{
+  execution_mode_ = mode;
 }
 
 }  // namespace vm
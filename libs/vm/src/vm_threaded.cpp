@@ -0,0 +1,612 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "vm/vm.hpp"
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace fetch {
+namespace vm {
+
+constexpr uint32_t VM::ThreadedCode::INVALID_BLOCK;
+
+namespace {
+
+using Instruction = Executable::Instruction;
+
+/**
+ * Determine if the instruction's index field is the target of a jump
+ *
+ * @param opcode The opcode of the instruction
+ * @return true if the instruction is a (possibly conditional) jump, otherwise false
+ */
+bool IsJump(uint16_t opcode)
+{
+  switch (opcode)
+  {
+  case Opcodes::Jump:
+  case Opcodes::JumpIfFalse:
+  case Opcodes::JumpIfTrue:
+  case Opcodes::JumpIfFalseOrPop:
+  case Opcodes::JumpIfTrueOrPop:
+  case Opcodes::Break:
+  case Opcodes::Continue:
+  case Opcodes::ForRangeIterate:
+    return true;
+  default:
+    return false;
+  }
+}
+
+/**
+ * Determine if the instruction must be the last in its basic block, either because it can transfer
+ * control or because its handler can add to the charge total
+ *
+ * @param opcode The opcode of the instruction
+ * @return true if the instruction ends a basic block, otherwise false
+ */
+bool IsTerminator(uint16_t opcode)
+{
+  switch (opcode)
+  {
+  case Opcodes::Return:
+  case Opcodes::ReturnValue:
+  case Opcodes::InvokeUserDefinedFreeFunction:
+    return true;
+  default:
+    return IsJump(opcode) || (opcode >= Opcodes::NumReserved);
+  }
+}
+
+bool IsLoad(uint16_t opcode)
+{
+  return (opcode == Opcodes::PushVariable) || (opcode == Opcodes::PushConstant);
+}
+
+}  // namespace
+
+/**
+ * The handlers which make up the threaded code. Sequences of handlers are instantiated as
+ * superinstructions so that common instruction patterns are executed with a single dispatch.
+ */
+struct VM::ThreadedDispatch
+{
+  using OpHandler = void (VM::*)();
+
+  template <OpHandler Handler>
+  static bool Run(VM *vm, Instruction const *&instruction, uint16_t &pc)
+  {
+    vm->instruction_pc_ = pc;
+    vm->instruction_    = instruction++;
+    vm->pc_             = ++pc;
+
+    (vm->*Handler)();
+
+    return !vm->stop_;
+  }
+
+  template <OpHandler... Handlers>
+  static void Execute(VM *vm, ThreadedOp const &op)
+  {
+    Instruction const *instruction = op.instruction;
+    uint16_t           pc          = op.pc;
+
+    // run each of the handlers in turn, stopping at the first error
+    bool running = true;
+    using Expand = int[];
+    (void)Expand{0, (running = running && Run<Handlers>(vm, instruction, pc), 0)...};
+  }
+
+  static void ExecuteOpcode(VM *vm, ThreadedOp const &op)
+  {
+    vm->instruction_pc_ = op.pc;
+    vm->instruction_    = op.instruction;
+    vm->pc_             = static_cast<uint16_t>(op.pc + 1u);
+    vm->current_op_     = &vm->opcode_info_array_[op.instruction->opcode];
+
+    vm->current_op_->handler(vm);
+  }
+
+  static void ExecuteUnknown(VM *vm, ThreadedOp const &op)
+  {
+    vm->instruction_pc_ = op.pc;
+    vm->instruction_    = op.instruction;
+    vm->pc_             = static_cast<uint16_t>(op.pc + 1u);
+
+    vm->RuntimeError("unknown opcode");
+  }
+
+  static ThreadedHandler Single(uint16_t opcode);
+
+  template <OpHandler... Prefix>
+  static ThreadedHandler ArithmeticStore(uint16_t arithmetic, uint16_t store);
+
+  template <OpHandler Jump, OpHandler... Prefix>
+  static ThreadedHandler CompareJump(uint16_t compare);
+
+  template <OpHandler... Prefix>
+  static ThreadedHandler CompareJump(uint16_t compare, uint16_t jump);
+
+  template <OpHandler Operand>
+  static ThreadedHandler LoadLoad(Instruction const *instructions, std::size_t available,
+                                  std::size_t &length);
+
+  static ThreadedHandler Select(Instruction const *instructions, std::size_t available,
+                                std::size_t &length);
+};
+
+VM::ThreadedHandler VM::ThreadedDispatch::Single(uint16_t opcode)
+{
+  switch (opcode)
+  {
+  case Opcodes::VariableDeclare:
+    return &Execute<&VM::Handler__VariableDeclare>;
+  case Opcodes::VariableDeclareAssign:
+    return &Execute<&VM::Handler__VariableDeclareAssign>;
+  case Opcodes::PushNull:
+    return &Execute<&VM::Handler__PushNull>;
+  case Opcodes::PushFalse:
+    return &Execute<&VM::Handler__PushFalse>;
+  case Opcodes::PushTrue:
+    return &Execute<&VM::Handler__PushTrue>;
+  case Opcodes::PushString:
+    return &Execute<&VM::Handler__PushString>;
+  case Opcodes::PushConstant:
+    return &Execute<&VM::Handler__PushConstant>;
+  case Opcodes::PushVariable:
+    return &Execute<&VM::Handler__PushVariable>;
+  case Opcodes::PopToVariable:
+    return &Execute<&VM::Handler__PopToVariable>;
+  case Opcodes::Inc:
+    return &Execute<&VM::Handler__Inc>;
+  case Opcodes::Dec:
+    return &Execute<&VM::Handler__Dec>;
+  case Opcodes::Duplicate:
+    return &Execute<&VM::Handler__Duplicate>;
+  case Opcodes::DuplicateInsert:
+    return &Execute<&VM::Handler__DuplicateInsert>;
+  case Opcodes::Discard:
+    return &Execute<&VM::Handler__Discard>;
+  case Opcodes::Destruct:
+    return &Execute<&VM::Handler__Destruct>;
+  case Opcodes::Break:
+    return &Execute<&VM::Handler__Break>;
+  case Opcodes::Continue:
+    return &Execute<&VM::Handler__Continue>;
+  case Opcodes::Jump:
+    return &Execute<&VM::Handler__Jump>;
+  case Opcodes::JumpIfFalse:
+    return &Execute<&VM::Handler__JumpIfFalse>;
+  case Opcodes::JumpIfTrue:
+    return &Execute<&VM::Handler__JumpIfTrue>;
+  case Opcodes::Return:
+  case Opcodes::ReturnValue:
+    return &Execute<&VM::Handler__Return>;
+  case Opcodes::ForRangeInit:
+    return &Execute<&VM::Handler__ForRangeInit>;
+  case Opcodes::ForRangeIterate:
+    return &Execute<&VM::Handler__ForRangeIterate>;
+  case Opcodes::ForRangeTerminate:
+    return &Execute<&VM::Handler__ForRangeTerminate>;
+  case Opcodes::InvokeUserDefinedFreeFunction:
+    return &Execute<&VM::Handler__InvokeUserDefinedFreeFunction>;
+  case Opcodes::VariablePrefixInc:
+    return &Execute<&VM::Handler__VariablePrefixInc>;
+  case Opcodes::VariablePrefixDec:
+    return &Execute<&VM::Handler__VariablePrefixDec>;
+  case Opcodes::VariablePostfixInc:
+    return &Execute<&VM::Handler__VariablePostfixInc>;
+  case Opcodes::VariablePostfixDec:
+    return &Execute<&VM::Handler__VariablePostfixDec>;
+  case Opcodes::JumpIfFalseOrPop:
+    return &Execute<&VM::Handler__JumpIfFalseOrPop>;
+  case Opcodes::JumpIfTrueOrPop:
+    return &Execute<&VM::Handler__JumpIfTrueOrPop>;
+  case Opcodes::Not:
+    return &Execute<&VM::Handler__Not>;
+  case Opcodes::PrimitiveEqual:
+    return &Execute<&VM::Handler__PrimitiveEqual>;
+  case Opcodes::ObjectEqual:
+    return &Execute<&VM::Handler__ObjectEqual>;
+  case Opcodes::PrimitiveNotEqual:
+    return &Execute<&VM::Handler__PrimitiveNotEqual>;
+  case Opcodes::ObjectNotEqual:
+    return &Execute<&VM::Handler__ObjectNotEqual>;
+  case Opcodes::PrimitiveLessThan:
+    return &Execute<&VM::Handler__PrimitiveLessThan>;
+  case Opcodes::ObjectLessThan:
+    return &Execute<&VM::Handler__ObjectLessThan>;
+  case Opcodes::PrimitiveLessThanOrEqual:
+    return &Execute<&VM::Handler__PrimitiveLessThanOrEqual>;
+  case Opcodes::ObjectLessThanOrEqual:
+    return &Execute<&VM::Handler__ObjectLessThanOrEqual>;
+  case Opcodes::PrimitiveGreaterThan:
+    return &Execute<&VM::Handler__PrimitiveGreaterThan>;
+  case Opcodes::ObjectGreaterThan:
+    return &Execute<&VM::Handler__ObjectGreaterThan>;
+  case Opcodes::PrimitiveGreaterThanOrEqual:
+    return &Execute<&VM::Handler__PrimitiveGreaterThanOrEqual>;
+  case Opcodes::ObjectGreaterThanOrEqual:
+    return &Execute<&VM::Handler__ObjectGreaterThanOrEqual>;
+  case Opcodes::PrimitiveNegate:
+    return &Execute<&VM::Handler__PrimitiveNegate>;
+  case Opcodes::ObjectNegate:
+    return &Execute<&VM::Handler__ObjectNegate>;
+  case Opcodes::PrimitiveAdd:
+    return &Execute<&VM::Handler__PrimitiveAdd>;
+  case Opcodes::ObjectAdd:
+    return &Execute<&VM::Handler__ObjectAdd>;
+  case Opcodes::ObjectLeftAdd:
+    return &Execute<&VM::Handler__ObjectLeftAdd>;
+  case Opcodes::ObjectRightAdd:
+    return &Execute<&VM::Handler__ObjectRightAdd>;
+  case Opcodes::VariablePrimitiveInplaceAdd:
+    return &Execute<&VM::Handler__VariablePrimitiveInplaceAdd>;
+  case Opcodes::VariableObjectInplaceAdd:
+    return &Execute<&VM::Handler__VariableObjectInplaceAdd>;
+  case Opcodes::VariableObjectInplaceRightAdd:
+    return &Execute<&VM::Handler__VariableObjectInplaceRightAdd>;
+  case Opcodes::PrimitiveSubtract:
+    return &Execute<&VM::Handler__PrimitiveSubtract>;
+  case Opcodes::ObjectSubtract:
+    return &Execute<&VM::Handler__ObjectSubtract>;
+  case Opcodes::ObjectLeftSubtract:
+    return &Execute<&VM::Handler__ObjectLeftSubtract>;
+  case Opcodes::ObjectRightSubtract:
+    return &Execute<&VM::Handler__ObjectRightSubtract>;
+  case Opcodes::VariablePrimitiveInplaceSubtract:
+    return &Execute<&VM::Handler__VariablePrimitiveInplaceSubtract>;
+  case Opcodes::VariableObjectInplaceSubtract:
+    return &Execute<&VM::Handler__VariableObjectInplaceSubtract>;
+  case Opcodes::VariableObjectInplaceRightSubtract:
+    return &Execute<&VM::Handler__VariableObjectInplaceRightSubtract>;
+  case Opcodes::PrimitiveMultiply:
+    return &Execute<&VM::Handler__PrimitiveMultiply>;
+  case Opcodes::ObjectMultiply:
+    return &Execute<&VM::Handler__ObjectMultiply>;
+  case Opcodes::ObjectLeftMultiply:
+    return &Execute<&VM::Handler__ObjectLeftMultiply>;
+  case Opcodes::ObjectRightMultiply:
+    return &Execute<&VM::Handler__ObjectRightMultiply>;
+  case Opcodes::VariablePrimitiveInplaceMultiply:
+    return &Execute<&VM::Handler__VariablePrimitiveInplaceMultiply>;
+  case Opcodes::VariableObjectInplaceMultiply:
+    return &Execute<&VM::Handler__VariableObjectInplaceMultiply>;
+  case Opcodes::VariableObjectInplaceRightMultiply:
+    return &Execute<&VM::Handler__VariableObjectInplaceRightMultiply>;
+  case Opcodes::PrimitiveDivide:
+    return &Execute<&VM::Handler__PrimitiveDivide>;
+  case Opcodes::ObjectDivide:
+    return &Execute<&VM::Handler__ObjectDivide>;
+  case Opcodes::ObjectLeftDivide:
+    return &Execute<&VM::Handler__ObjectLeftDivide>;
+  case Opcodes::ObjectRightDivide:
+    return &Execute<&VM::Handler__ObjectRightDivide>;
+  case Opcodes::VariablePrimitiveInplaceDivide:
+    return &Execute<&VM::Handler__VariablePrimitiveInplaceDivide>;
+  case Opcodes::VariableObjectInplaceDivide:
+    return &Execute<&VM::Handler__VariableObjectInplaceDivide>;
+  case Opcodes::VariableObjectInplaceRightDivide:
+    return &Execute<&VM::Handler__VariableObjectInplaceRightDivide>;
+  case Opcodes::PrimitiveModulo:
+    return &Execute<&VM::Handler__PrimitiveModulo>;
+  case Opcodes::VariablePrimitiveInplaceModulo:
+    return &Execute<&VM::Handler__VariablePrimitiveInplaceModulo>;
+  case Opcodes::InitialiseArray:
+    return &Execute<&VM::Handler__InitialiseArray>;
+  default:
+    // module functions are dispatched through the opcode table
+    return &ExecuteOpcode;
+  }
+}
+
+// <prefix> PrimitiveAdd|PrimitiveSubtract|PrimitiveMultiply PopToVariable
+template <VM::ThreadedDispatch::OpHandler... Prefix>
+VM::ThreadedHandler VM::ThreadedDispatch::ArithmeticStore(uint16_t arithmetic, uint16_t store)
+{
+  if (store != Opcodes::PopToVariable)
+  {
+    return nullptr;
+  }
+
+  switch (arithmetic)
+  {
+  case Opcodes::PrimitiveAdd:
+    return &Execute<Prefix..., &VM::Handler__PrimitiveAdd, &VM::Handler__PopToVariable>;
+  case Opcodes::PrimitiveSubtract:
+    return &Execute<Prefix..., &VM::Handler__PrimitiveSubtract, &VM::Handler__PopToVariable>;
+  case Opcodes::PrimitiveMultiply:
+    return &Execute<Prefix..., &VM::Handler__PrimitiveMultiply, &VM::Handler__PopToVariable>;
+  default:
+    return nullptr;
+  }
+}
+
+// <prefix> Primitive<comparison> Jump
+template <VM::ThreadedDispatch::OpHandler Jump, VM::ThreadedDispatch::OpHandler... Prefix>
+VM::ThreadedHandler VM::ThreadedDispatch::CompareJump(uint16_t compare)
+{
+  switch (compare)
+  {
+  case Opcodes::PrimitiveEqual:
+    return &Execute<Prefix..., &VM::Handler__PrimitiveEqual, Jump>;
+  case Opcodes::PrimitiveNotEqual:
+    return &Execute<Prefix..., &VM::Handler__PrimitiveNotEqual, Jump>;
+  case Opcodes::PrimitiveLessThan:
+    return &Execute<Prefix..., &VM::Handler__PrimitiveLessThan, Jump>;
+  case Opcodes::PrimitiveLessThanOrEqual:
+    return &Execute<Prefix..., &VM::Handler__PrimitiveLessThanOrEqual, Jump>;
+  case Opcodes::PrimitiveGreaterThan:
+    return &Execute<Prefix..., &VM::Handler__PrimitiveGreaterThan, Jump>;
+  case Opcodes::PrimitiveGreaterThanOrEqual:
+    return &Execute<Prefix..., &VM::Handler__PrimitiveGreaterThanOrEqual, Jump>;
+  default:
+    return nullptr;
+  }
+}
+
+// <prefix> Primitive<comparison> JumpIfFalse|JumpIfTrue
+template <VM::ThreadedDispatch::OpHandler... Prefix>
+VM::ThreadedHandler VM::ThreadedDispatch::CompareJump(uint16_t compare, uint16_t jump)
+{
+  switch (jump)
+  {
+  case Opcodes::JumpIfFalse:
+    return CompareJump<&VM::Handler__JumpIfFalse, Prefix...>(compare);
+  case Opcodes::JumpIfTrue:
+    return CompareJump<&VM::Handler__JumpIfTrue, Prefix...>(compare);
+  default:
+    return nullptr;
+  }
+}
+
+// PushVariable PushVariable|PushConstant [<arithmetic> PopToVariable | <comparison> <jump>]
+template <VM::ThreadedDispatch::OpHandler Operand>
+VM::ThreadedHandler VM::ThreadedDispatch::LoadLoad(Instruction const *instructions,
+                                                   std::size_t available, std::size_t &length)
+{
+  if (available >= 4)
+  {
+    ThreadedHandler handler = ArithmeticStore<&VM::Handler__PushVariable, Operand>(
+        instructions[2].opcode, instructions[3].opcode);
+
+    if (!handler)
+    {
+      handler = CompareJump<&VM::Handler__PushVariable, Operand>(instructions[2].opcode,
+                                                                 instructions[3].opcode);
+    }
+
+    if (handler)
+    {
+      length = 4;
+      return handler;
+    }
+  }
+
+  length = 2;
+  return &Execute<&VM::Handler__PushVariable, Operand>;
+}
+
+/**
+ * Select the handler for the instructions at the current position, fusing them into a
+ * superinstruction where possible
+ *
+ * @param instructions The instructions starting at the current position
+ * @param available The number of instructions remaining in the basic block
+ * @param length The output number of instructions covered by the handler
+ * @return The selected handler
+ */
+VM::ThreadedHandler VM::ThreadedDispatch::Select(Instruction const *instructions,
+                                                 std::size_t available, std::size_t &length)
+{
+  uint16_t const opcode = instructions[0].opcode;
+  uint16_t const next   = (available >= 2) ? instructions[1].opcode : Opcodes::Unknown;
+
+  if ((opcode == Opcodes::PushVariable) && IsLoad(next))
+  {
+    if (next == Opcodes::PushVariable)
+    {
+      return LoadLoad<&VM::Handler__PushVariable>(instructions, available, length);
+    }
+
+    return LoadLoad<&VM::Handler__PushConstant>(instructions, available, length);
+  }
+
+  ThreadedHandler handler = ArithmeticStore<>(opcode, next);
+  if (!handler)
+  {
+    handler = CompareJump<>(opcode, next);
+  }
+
+  if (handler)
+  {
+    length = 2;
+    return handler;
+  }
+
+  length = 1;
+  return Single(opcode);
+}
+
+/**
+ * Translate a function into threaded code. The function is split into basic blocks and the
+ * instructions of each block are mapped to (possibly fused) direct handlers.
+ *
+ * @param function The function to translate
+ * @return The threaded code for the function
+ */
+VM::ThreadedCodePtr VM::TranslateFunction(Executable::Function const &function) const
+{
+  auto const &instructions     = function.instructions;
+  auto const  num_instructions = instructions.size();
+
+  auto code = std::make_unique<ThreadedCode>();
+  code->block_index.assign(num_instructions + 1, ThreadedCode::INVALID_BLOCK);
+  code->prefix_charge.assign(num_instructions + 1, 0);
+
+  // determine the static charge of each instruction and where each basic block starts
+  std::vector<bool> leader(num_instructions + 1, false);
+  std::vector<bool> known(num_instructions, false);
+  leader[0] = true;
+
+  for (std::size_t pc = 0; pc < num_instructions; ++pc)
+  {
+    auto const &   instruction = instructions[pc];
+    uint16_t const opcode      = instruction.opcode;
+
+    known[pc] = (opcode < opcode_info_array_.size()) &&
+                static_cast<bool>(opcode_info_array_[opcode].handler);
+
+    ChargeAmount const charge = known[pc] ? opcode_info_array_[opcode].static_charge : 0;
+    code->prefix_charge[pc + 1] = code->prefix_charge[pc] + charge;
+
+    if (!known[pc] || IsTerminator(opcode))
+    {
+      leader[pc + 1] = true;
+    }
+
+    if (IsJump(opcode) && (instruction.index <= num_instructions))
+    {
+      leader[instruction.index] = true;
+    }
+  }
+
+  // build the blocks
+  std::size_t pc = 0;
+  while (pc < num_instructions)
+  {
+    std::size_t end = pc + 1;
+    while ((end < num_instructions) && !leader[end])
+    {
+      ++end;
+    }
+
+    ThreadedBlock block{};
+    block.first_op = static_cast<uint32_t>(code->ops.size());
+    block.begin_pc = static_cast<uint16_t>(pc);
+    block.end_pc   = static_cast<uint16_t>(end);
+    block.charge   = code->prefix_charge[end] - code->prefix_charge[pc];
+
+    code->block_index[pc] = static_cast<uint32_t>(code->blocks.size());
+
+    while (pc < end)
+    {
+      std::size_t     length  = 1;
+      ThreadedHandler handler = known[pc]
+                                    ? ThreadedDispatch::Select(&instructions[pc], end - pc, length)
+                                    : &ThreadedDispatch::ExecuteUnknown;
+
+      code->ops.push_back(ThreadedOp{handler, &instructions[pc], static_cast<uint16_t>(pc)});
+      pc += length;
+    }
+
+    block.num_ops = static_cast<uint32_t>(code->ops.size()) - block.first_op;
+    code->blocks.push_back(block);
+  }
+
+  return code;
+}
+
+/**
+ * Lookup (translating if necessary) the threaded code for the current function. Functions are
+ * translated on first use and the translation is reused for as long as the executable is.
+ *
+ * @return The threaded code
+ */
+VM::ThreadedCode const &VM::GetThreadedCode()
+{
+  auto const index = static_cast<std::size_t>(function_ - executable_->functions.data());
+  assert(index < threaded_code_.size());
+
+  auto &code = threaded_code_[index];
+  if (!code)
+  {
+    code = TranslateFunction(*function_);
+  }
+
+  return *code;
+}
+
+/**
+ * Execute the current function as threaded code. The static charge for each basic block is
+ * applied on entry to the block. Blocks which could reach the charge limit are single stepped
+ * so that the charge limit is detected at exactly the same instruction as in interpreted mode.
+ */
+void VM::ExecuteThreaded()
+{
+  // the translated code is kept between executions of the same version of the same executable
+  if ((executable_->generation.value() != threaded_generation_) ||
+      (threaded_code_.size() != executable_->functions.size()))
+  {
+    InvalidateThreadedCode();
+    threaded_code_.resize(executable_->functions.size());
+    threaded_generation_ = executable_->generation.value();
+  }
+
+  do
+  {
+    ThreadedCode const &code = GetThreadedCode();
+
+    assert(pc_ < code.block_index.size());
+    assert(code.block_index[pc_] != ThreadedCode::INVALID_BLOCK);
+    ThreadedBlock const &block = code.blocks[code.block_index[pc_]];
+
+    if (charge_limit_ && ((charge_total_ + block.charge) >= charge_limit_))
+    {
+      for (uint16_t pc = block.begin_pc; (pc < block.end_pc) && !stop_; ++pc)
+      {
+        ExecuteInstruction();
+      }
+
+      continue;
+    }
+
+    charge_total_ += block.charge;
+
+    ThreadedOp const *op  = &code.ops[block.first_op];
+    ThreadedOp const *end = op + block.num_ops;
+    for (; op != end; ++op)
+    {
+      op->handler(this, *op);
+
+      if (stop_)
+      {
+        // remove the charge for the instructions of the block which were not executed
+        charge_total_ -=
+            code.prefix_charge[block.end_pc] - code.prefix_charge[instruction_pc_ + 1u];
+        break;
+      }
+    }
+  } while (!stop_);
+}
+
+/**
+ * Discard all the translated code, for example because the static charges have changed
+ */
+void VM::InvalidateThreadedCode()
+{
+  threaded_code_.clear();
+  threaded_generation_ = 0;
+}
+
+}  // namespace vm
+}  // namespace fetch
@@ -25,6 +25,7 @@
 namespace fetch {
 namespace vm {
 
+class Compiler;
 class Module;
 struct Executable;
 
@@ -77,6 +78,22 @@ public:
   static std::vector<std::string> Compile(std::shared_ptr<fetch::vm::Module> const &module,
                                           std::string const &                       source,
                                           fetch::vm::Executable &                   executable);
+
+  /**
+   * Compile a source file with a compiler which has already been set up from the module, producing
+   * an executable
+   *
+   * @param: module The module which the compiler was constructed from
+   * @param: compiler The compiler to reuse
+   * @param: source The raw source to compile
+   * @param: executable executable to fill
+   *
+   * @return: Vector of strings which represent errors found during compilation
+   */
+  static std::vector<std::string> Compile(std::shared_ptr<fetch::vm::Module> const &module,
+                                          fetch::vm::Compiler &                     compiler,
+                                          std::string const &                       source,
+                                          fetch::vm::Executable &                   executable);
 };
 
 }  // namespace vm_modules
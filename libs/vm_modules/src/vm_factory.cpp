@@ -44,14 +44,20 @@ namespace vm_modules {
 VMFactory::Errors VMFactory::Compile(std::shared_ptr<Module> const &module,
                                      std::string const &source, Executable &executable)
 {
-  std::vector<std::string> errors;
-
   // generate the compiler from the module
-  auto compiler = std::make_shared<Compiler>(module.get());
-  IR   ir;
+  Compiler compiler{module.get()};
+
+  return Compile(module, compiler, source, executable);
+}
+
+VMFactory::Errors VMFactory::Compile(std::shared_ptr<Module> const &module, Compiler &compiler,
+                                     std::string const &source, Executable &executable)
+{
+  std::vector<std::string> errors;
+  IR                       ir;
 
   // compile the source
-  bool const compiled = compiler->Compile(source, "default", ir, errors);
+  bool const compiled = compiler.Compile(source, "default", ir, errors);
 
   if (!compiled)
   {
@@ -0,0 +1,218 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "vm_test_toolkit.hpp"
+
+#include "gmock/gmock.h"
+
+#include <cstddef>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+using ExecutionMode = VM::ExecutionMode;
+
+struct ExecutionResult
+{
+  bool         success;
+  std::string  stdout;
+  ChargeAmount charge;
+};
+
+ExecutionResult RunInMode(char const *text, ExecutionMode mode,
+                          ChargeAmount charge_limit = std::numeric_limits<ChargeAmount>::max())
+{
+  std::stringstream stdout;
+  VmTestToolkit     toolkit{&stdout};
+
+  EXPECT_TRUE(toolkit.Compile(text));
+  toolkit.vm_->SetExecutionMode(mode);
+
+  bool const success = toolkit.Run(nullptr, charge_limit);
+
+  return {success, stdout.str(), toolkit.vm_->GetChargeTotal()};
+}
+
+// Runs the program twice on the same VM, updating the static charges in between
+std::vector<ExecutionResult> RunTwiceInMode(char const *text, ExecutionMode mode)
+{
+  std::stringstream stdout;
+  VmTestToolkit     toolkit{&stdout};
+
+  EXPECT_TRUE(toolkit.Compile(text));
+  toolkit.vm_->SetExecutionMode(mode);
+
+  std::vector<ExecutionResult> results;
+
+  bool success = toolkit.Run();
+  results.push_back({success, stdout.str(), toolkit.vm_->GetChargeTotal()});
+
+  toolkit.vm_->UpdateCharges({{"PrimitiveModulo", 1000}});
+
+  success = toolkit.Run();
+  results.push_back({success, stdout.str(), toolkit.vm_->GetChargeTotal()});
+
+  return results;
+}
+
+void ExpectIdenticalExecution(char const *text, ChargeAmount charge_limit)
+{
+  auto const interpreted = RunInMode(text, ExecutionMode::INTERPRETED, charge_limit);
+  auto const threaded    = RunInMode(text, ExecutionMode::THREADED, charge_limit);
+
+  EXPECT_EQ(interpreted.success, threaded.success) << "charge limit: " << charge_limit;
+  EXPECT_EQ(interpreted.stdout, threaded.stdout) << "charge limit: " << charge_limit;
+  EXPECT_EQ(interpreted.charge, threaded.charge) << "charge limit: " << charge_limit;
+}
+
+char const *LOOPS_AND_CALLS = R"(
+  function fib(n : Int64) : Int64
+    if (n < 2i64)
+      return n;
+    endif
+    return fib(n - 1i64) + fib(n - 2i64);
+  endfunction
+
+  function main()
+    var total = 0i64;
+    var i = 0i64;
+    while (i < 100i64)
+      var a = i * 3i64;
+      total = total + a;
+      if (i % 7i64 == 0i64)
+        total = total - 1i64;
+      endif
+      i = i + 1i64;
+    endwhile
+
+    for (j in 0:20)
+      if (j == 5)
+        continue;
+      endif
+      if (j > 15)
+        break;
+      endif
+      total += fib(5i64);
+    endfor
+
+    if ((total > 5i64) && (i < 10i64 || i > 3i64))
+      total = total + 1i64;
+    endif
+
+    print(total);
+  endfunction
+)";
+
+TEST(VmExecutionModeTests, threaded_mode_matches_interpreted_output_and_charge)
+{
+  auto const interpreted = RunInMode(LOOPS_AND_CALLS, ExecutionMode::INTERPRETED);
+  auto const threaded    = RunInMode(LOOPS_AND_CALLS, ExecutionMode::THREADED);
+
+  ASSERT_TRUE(interpreted.success);
+  ASSERT_TRUE(threaded.success);
+  EXPECT_EQ(interpreted.stdout, threaded.stdout);
+  EXPECT_EQ(interpreted.charge, threaded.charge);
+}
+
+TEST(VmExecutionModeTests, threaded_mode_reaches_charge_limit_at_the_same_instruction)
+{
+  auto const total = RunInMode(LOOPS_AND_CALLS, ExecutionMode::INTERPRETED).charge;
+
+  for (ChargeAmount limit : {ChargeAmount{1}, ChargeAmount{2}, ChargeAmount{7}, ChargeAmount{100},
+                             total / 3, total / 2, total - 1, total, total + 1})
+  {
+    ExpectIdenticalExecution(LOOPS_AND_CALLS, limit);
+  }
+}
+
+TEST(VmExecutionModeTests, threaded_mode_matches_interpreted_charge_on_runtime_error)
+{
+  static char const *TEXT = R"(
+    function main()
+      var x = 0i64;
+      var y = 10i64;
+      while (x < 50i64)
+        x = x + 1i64;
+      endwhile
+      print(x / (y - 10i64));
+    endfunction
+  )";
+
+  auto const interpreted = RunInMode(TEXT, ExecutionMode::INTERPRETED);
+  auto const threaded    = RunInMode(TEXT, ExecutionMode::THREADED);
+
+  EXPECT_FALSE(interpreted.success);
+  EXPECT_FALSE(threaded.success);
+  EXPECT_EQ(interpreted.stdout, threaded.stdout);
+  EXPECT_EQ(interpreted.charge, threaded.charge);
+}
+
+TEST(VmExecutionModeTests, threaded_code_is_reused_and_retranslated_when_charges_change)
+{
+  auto const interpreted = RunTwiceInMode(LOOPS_AND_CALLS, ExecutionMode::INTERPRETED);
+  auto const threaded    = RunTwiceInMode(LOOPS_AND_CALLS, ExecutionMode::THREADED);
+
+  ASSERT_EQ(interpreted.size(), threaded.size());
+  for (std::size_t i = 0; i < interpreted.size(); ++i)
+  {
+    EXPECT_TRUE(threaded[i].success);
+    EXPECT_EQ(interpreted[i].stdout, threaded[i].stdout);
+    EXPECT_EQ(interpreted[i].charge, threaded[i].charge);
+  }
+
+  // the updated charge must have been applied to the second run
+  EXPECT_GT(threaded[1].charge, 2 * threaded[0].charge);
+}
+
+TEST(VmExecutionModeTests, threaded_code_is_not_reused_for_a_regenerated_executable)
+{
+  // programs of exactly the same shape, differing only in a single opcode
+  static char const *ADD = R"(
+    function main()
+      print(7i64 + 3i64);
+    endfunction
+  )";
+  static char const *SUB = R"(
+    function main()
+      print(7i64 - 3i64);
+    endfunction
+  )";
+
+  std::stringstream stdout;
+  VmTestToolkit     toolkit{&stdout};
+
+  ASSERT_TRUE(toolkit.Compile(ADD));
+  toolkit.vm_->SetExecutionMode(ExecutionMode::THREADED);
+  ASSERT_TRUE(toolkit.Run());
+
+  // regenerate the other program into the same executable object, i.e. at the same address
+  IR                       ir{};
+  std::vector<std::string> errors{};
+  ASSERT_TRUE(toolkit.compiler_->Compile(SUB, "default", ir, errors));
+  ASSERT_TRUE(toolkit.vm_->GenerateExecutable(ir, "default_ir", *toolkit.executable_, errors));
+  ASSERT_TRUE(toolkit.Run());
+
+  auto const expected = RunInMode(ADD, ExecutionMode::INTERPRETED).stdout +
+                        RunInMode(SUB, ExecutionMode::INTERPRETED).stdout;
+  EXPECT_EQ(expected, stdout.str());
+}
+
+}  // namespace